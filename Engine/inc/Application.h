@@ -7,6 +7,8 @@
 class RenderDevice;
 class RenderWindow;
 class ProgressWindow;
+class JobSystem;
+class AssetCache;
 
 class Application : public Object
 {
@@ -31,6 +33,13 @@ public:
     // Get the render device associated with this application.
     RenderDevice& GetRenderDevice();
 
+    // Get the job system that is used to execute engine tasks in parallel
+    // (for example, decoding textures while a scene is loaded).
+    JobSystem& GetJobSystem();
+
+    // Get the cache that stores the processed assets (for example, imported scenes).
+    AssetCache& GetAssetCache();
+
     // Get the module handle for this instance of the application.
     // TODO: This should be abstracted away into a specific Application class.
     HINSTANCE GetModuleHandle() const;
@@ -108,6 +117,8 @@ private:
     HINSTANCE m_hInstance;
 
     RenderDevice*   m_pRenderDevice;
+    JobSystem*      m_pJobSystem;
+    AssetCache*     m_pAssetCache;
 
     typedef std::map<std::string, RenderWindow*> WindowMap;
     WindowMap m_Windows;
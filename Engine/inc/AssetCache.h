@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * A content addressed cache for processed assets.
+ * Processed assets are stored in a shared cache directory. The name of a
+ * cached file is a key that is computed from the contents of the source
+ * files and the settings that were used to process them (see ContentHash).
+ * Copying or checking out a source file doesn't change its contents so the
+ * processed asset is still found in the cache. Modifying a source file or
+ * changing the processing settings produces a new key.
+ */
+
+class JobSystem;
+
+class AssetCache
+{
+public:
+    typedef uint64_t Key;
+
+    // @param cacheDirectory The directory that stores the processed assets.
+    // It is created if it does not exist.
+    // @param jobSystem Used to hash files in parallel.
+    AssetCache( const std::wstring& cacheDirectory, JobSystem& jobSystem );
+
+    const std::wstring& GetCacheDirectory() const;
+
+    // Compute the hash of the contents of a file.
+    // The file is hashed in chunks of 1 MB: the hash of a file is the hash of its size and
+    // the hashes of its chunks (so it is not the XXH64 hash of the whole file).
+    // Returns false if the file could not be read.
+    static bool HashFile( const std::wstring& fileName, Key& hash );
+
+    // Compute the hashes of several files in parallel.
+    // The chunks of all of the files are hashed in parallel, so large files are
+    // hashed by several threads. The hashes are the same as the hashes of HashFile.
+    // Files that could not be read get a hash of 0.
+    void HashFiles( const std::vector<std::wstring>& fileNames, std::vector<Key>& hashes ) const;
+
+    // The file name of a processed asset in the cache.
+    // @param extension The file extension of the processed asset (without the dot).
+    std::wstring GetCachedFileName( Key key, const std::string& extension ) const;
+
+    // Returns true if a processed asset with this key exists in the cache.
+    bool Contains( Key key, const std::string& extension ) const;
+
+private:
+    std::wstring m_CacheDirectory;
+    JobSystem& m_JobSystem;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <ShaderParameterID.h>
+
+class Shader;
+class ConstantBuffer;
+class Texture;
+class SamplerState;
+class StructuredBuffer;
+
+/**
+ * A set of shader parameters (constant buffers, textures, samplers and
+ * structured buffers) that are assigned to a shader with a single call.
+ * Parameters are identified by their interned ShaderParameterID so applying
+ * the group to a shader only does array lookups.
+ * Parameters that are not defined by the shader are skipped, so the same
+ * group can be applied to every shader that shares (some of) the resources.
+ */
+class BindGroup
+{
+public:
+    // Set a parameter of the group (replaces the resource if the parameter is already in the group).
+    void Set( const ShaderParameterID& id, std::shared_ptr<ConstantBuffer> constantBuffer );
+    void Set( const ShaderParameterID& id, std::shared_ptr<Texture> texture );
+    void Set( const ShaderParameterID& id, std::shared_ptr<SamplerState> sampler );
+    void Set( const ShaderParameterID& id, std::shared_ptr<StructuredBuffer> structuredBuffer );
+
+    // Remove all parameters from the group.
+    void Clear();
+
+    // Assign the parameters of the group to the shader parameters.
+    // The parameters are bound the next time the shader is bound.
+    void Apply( const Shader& shader ) const;
+    // Assign the parameters to the shader and bind them immediately.
+    void Bind( const Shader& shader ) const;
+
+private:
+    struct Entry
+    {
+        ShaderParameterID ID;
+        std::shared_ptr<ConstantBuffer> pConstantBuffer;
+        std::shared_ptr<Texture> pTexture;
+        std::shared_ptr<SamplerState> pSampler;
+        std::shared_ptr<StructuredBuffer> pStructuredBuffer;
+    };
+
+    // Find the entry for the parameter (or add a new entry).
+    Entry& GetEntry( const ShaderParameterID& id );
+
+    typedef std::vector<Entry> EntryList;
+    EntryList m_Entries;
+};
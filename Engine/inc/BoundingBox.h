@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * An axis-aligned bounding box.
+ */
+class BoundingBox
+{
+public:
+    // Create an invalid (empty) bounding box.
+    BoundingBox();
+    BoundingBox( const glm::vec3& min, const glm::vec3& max );
+
+    const glm::vec3& GetMin() const;
+    const glm::vec3& GetMax() const;
+
+    glm::vec3 GetCenter() const;
+    // Half the size of the box along each axis.
+    glm::vec3 GetExtents() const;
+
+    // Get one of the 8 corners of the box.
+    // Bit 0 of the index selects the x coordinate, bit 1 the y coordinate and bit 2 the z coordinate.
+    glm::vec3 GetCorner( uint32_t index ) const;
+
+    // Valid if min <= max on all axes.
+    bool IsValid() const;
+
+    /**
+     * Enlarge this bounding box so that it contains the point.
+     */
+    void Enlarge( const glm::vec3& point );
+    /**
+     * Enlarge this bounding box so that it contains another bounding box.
+     */
+    void Enlarge( const BoundingBox& other );
+
+private:
+    glm::vec3   m_Min;
+    glm::vec3   m_Max;
+};
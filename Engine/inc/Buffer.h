@@ -28,6 +28,14 @@ public:
     // Buffers must be the same size in bytes.
     virtual void Copy( std::shared_ptr<Buffer> other ) = 0;
 
+    // Replace count elements of the buffer, starting at firstElement, with new data
+    // (for example, index data that is generated on the CPU every frame).
+    // Only vertex and index buffers support this.
+    virtual void SetElements( const void* data, size_t firstElement, size_t count )
+    {
+        ReportError( "Buffer::SetElements: Not supported by this buffer type." );
+    }
+
 	// Is this an index buffer or an attribute/vertex buffer?
 	virtual BufferType GetType() const = 0;
 	// How many elements does this buffer contain?
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Object.h"
+
+/**
+ * Records rendering commands on a worker thread so they can be submitted
+ * to the GPU later (in DirectX 11 this is a deferred context).
+ *
+ * Between Begin and End, every command that is issued on the calling thread
+ * (state changes, buffer updates, draw calls and dispatches) is recorded into
+ * the command list instead of being sent to the GPU. Only one command list can
+ * be recorded per thread at a time, but multiple threads can record their own
+ * command lists at the same time.
+ *
+ * Recorded command lists are submitted with Execute on the thread that
+ * created the render device. Command lists are executed in the order
+ * Execute is called, regardless of the order they were recorded in.
+ * A command list starts from the default state, so everything a command
+ * list uses (pipeline state, render targets, buffers) has to be bound
+ * in the command list itself.
+ */
+class CommandList : public Object
+{
+public:
+    typedef Object base;
+
+    CommandList();
+    virtual ~CommandList();
+
+    // Start recording commands on the calling thread.
+    void Begin();
+    // Stop recording commands.
+    void End();
+
+    // Submit the recorded commands to the GPU.
+    // A command list must be recorded again before it can be executed again.
+    virtual void Execute() = 0;
+
+    bool IsRecording() const;
+
+    // The command list that is recording on the calling thread (nullptr if none).
+    static CommandList* GetRecording();
+
+protected:
+    // Called when the command list starts and stops recording on the calling thread.
+    virtual void OnBegin() = 0;
+    virtual void OnEnd() = 0;
+
+private:
+    bool m_bIsRecording;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Object.h"
+
+#include <deque>
+
+class Shader;
+class ShaderParameterID;
+
+/**
+ * Suballocates the constant buffer data of a frame from a single large buffer.
+ * Instead of mapping a small constant buffer with WRITE_DISCARD for every draw
+ * call, the data of each draw call is appended to the ring buffer and bound
+ * with an offset into the ring buffer. Allocations are aligned to 256 bytes
+ * (the granularity of constant buffer offsets).
+ *
+ * The space that is used by a frame is reused after the GPU has finished the
+ * frame (which is tracked with a fence per frame). The fences are polled once
+ * per frame in EndFrame without flushing the commands to the GPU. The CPU only
+ * waits for the GPU when the ring buffer is actually full, and only for as many
+ * frames as are needed to make room for the allocation. If the current frame
+ * alone fills the ring buffer, the ring buffer is renamed (the driver allocates
+ * new memory for the buffer) and the allocator starts over at the beginning of the new buffer.
+ *
+ * Data can only be allocated on the thread that owns the render device and
+ * not while a command list is recording (command lists use their own buffers).
+ */
+class ConstantBufferRing : public Object
+{
+public:
+    typedef Object base;
+
+    // The alignment of an allocation in bytes.
+    static const uint32_t Alignment = 256;
+    // The maximum number of fences that are in flight at the same time.
+    // If all fences are in use when a frame ends, the data of the frame is retired
+    // with the fence of the next frame (EndFrame never waits for the GPU).
+    static const uint32_t MaxFramesInFlight = 3;
+
+    // A range of the ring buffer.
+    struct Allocation
+    {
+        Allocation()
+            : Offset( 0 )
+            , Size( 0 )
+        {}
+
+        // Offset of the allocation from the start of the ring buffer in bytes.
+        uint32_t Offset;
+        // Size of the allocation in bytes (a multiple of the alignment).
+        uint32_t Size;
+
+        bool IsValid() const
+        {
+            return Size > 0;
+        }
+    };
+
+    ConstantBufferRing( uint32_t size );
+    virtual ~ConstantBufferRing();
+
+    // Copy the data to the ring buffer.
+    // The allocation can be bound until the end of the frame.
+    template<typename T>
+    Allocation Allocate( const T& data );
+    Allocation Allocate( const void* data, size_t size );
+
+    // Bind an allocation to a constant buffer parameter of a shader.
+    // Returns false if the shader does not have the parameter.
+    virtual bool Bind( const Allocation& allocation, const Shader& shader, const ShaderParameterID& id ) = 0;
+
+    // Should be called once per frame after all of the commands of the frame have been submitted.
+    // Releases the space of the frames that the GPU has finished.
+    void EndFrame();
+
+    // The size of the ring buffer in bytes.
+    uint32_t GetSize() const;
+
+    // Log the number of allocations per frame.
+    void Report( const std::string& deviceName ) const;
+
+protected:
+    // Copy the data of an allocation to the ring buffer.
+    // @param discard The contents of the buffer are still used by the GPU.
+    // The buffer must be renamed before the data is written.
+    virtual void Write( uint32_t offset, const void* data, size_t size, bool discard ) = 0;
+
+    // Signal a fence when the GPU has finished the commands that were submitted so far.
+    // Fences are numbered consecutively and at most MaxFramesInFlight fences are in flight,
+    // so fence % MaxFramesInFlight can be used to select the fence object.
+    virtual void InsertFence( uint64_t fence ) = 0;
+    // Returns true if the GPU has signaled the fence.
+    // Must not flush the commands to the GPU (this is polled once per frame).
+    virtual bool IsFenceComplete( uint64_t fence ) = 0;
+    // Wait until the GPU has signaled the fence (only called when the ring buffer is full).
+    virtual void WaitForFence( uint64_t fence ) = 0;
+
+    // The number of frames that have been ended.
+    uint64_t GetFrame() const;
+
+private:
+    // Release the space of the frames the GPU has finished.
+    void RetireFrames();
+
+    struct FrameInFlight
+    {
+        uint64_t Fence;
+        // The number of bytes that were used by the frame (including the padding at the end of the ring buffer).
+        uint32_t Size;
+    };
+    typedef std::deque<FrameInFlight> FrameList;
+    FrameList m_FramesInFlight;
+
+    uint32_t m_Size;
+    // The offset of the next allocation.
+    uint32_t m_Head;
+    // The number of bytes used by the current frame and the frames in flight.
+    uint32_t m_Used;
+    // The number of bytes used by the current frame.
+    uint32_t m_FrameUsed;
+
+    uint64_t m_Frame;
+    // The number of fences that have been inserted.
+    uint64_t m_NumFences;
+
+    // Statistics
+    uint64_t m_NumAllocations;
+    uint64_t m_NumBytes;
+    // The number of times the CPU waited for the GPU because the ring buffer was full.
+    uint64_t m_NumWaits;
+    // The number of times the buffer was renamed because the current frame did not fit in it.
+    uint64_t m_NumDiscards;
+};
+
+#include "ConstantBufferRing.inl"
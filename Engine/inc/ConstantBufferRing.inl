@@ -0,0 +1,6 @@
+
+template< typename T >
+ConstantBufferRing::Allocation ConstantBufferRing::Allocate( const T& data )
+{
+    return Allocate( &data, sizeof( T ) );
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * A fast 64-bit non-cryptographic hash function (XXH64).
+ * The hash can be computed in a single call or incrementally
+ * by calling Update several times (for example, to hash a file in chunks).
+ * Both produce the same result for the same sequence of bytes.
+ */
+class ContentHash
+{
+public:
+    explicit ContentHash( uint64_t seed = 0 );
+
+    // Add bytes to the hash.
+    void Update( const void* data, size_t size );
+
+    // Add a string to the hash (including its length so that
+    // consecutive strings can't produce the same sequence of bytes).
+    void Update( const std::string& str );
+    void Update( const std::wstring& str );
+
+    // Returns the hash of all of the bytes that were added so far.
+    // More bytes can be added after calling this function.
+    uint64_t GetHash() const;
+
+    // Compute the hash of a block of memory.
+    static uint64_t Hash( const void* data, size_t size, uint64_t seed = 0 );
+
+private:
+    uint64_t m_Seed;
+    uint64_t m_TotalSize;
+    // The accumulators for the 32-byte stripes.
+    uint64_t m_Accumulators[4];
+    // Bytes that don't fill a complete stripe yet.
+    uint8_t m_Buffer[32];
+    uint32_t m_BufferSize;
+};
@@ -33,6 +33,12 @@ public:
      */
     void AddDependency( const std::wstring& dependencyFile );
 
+    /**
+     * Get the paths of the base file and all of its dependencies.
+     * The paths are not relative to the dependency file.
+     */
+    std::vector<std::wstring> GetDependencies();
+
     /**
      * Check to see if the base file or any of the dependencies have changed
      * on disk.
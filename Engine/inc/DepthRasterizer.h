@@ -0,0 +1,71 @@
+#pragma once
+
+class BoundingBox;
+
+/**
+ * A low resolution software depth rasterizer that is used for occlusion culling.
+ * Occluder triangles are rasterized (4 pixels at a time using SSE) into a small depth
+ * buffer. After all occluders have been rasterized, a hierarchical depth buffer is built
+ * where each texel stores the farthest depth of the texels in the level below.
+ * Bounding boxes can then be tested against the hierarchical depth buffer to determine
+ * if they are (potentially) visible.
+ * The rasterizer does not depend on the graphics API and can be used without a GPU.
+ */
+class DepthRasterizer
+{
+public:
+    // The width must be a multiple of 4.
+    DepthRasterizer( uint32_t width = 256, uint32_t height = 128 );
+
+    uint32_t GetWidth() const;
+    uint32_t GetHeight() const;
+    uint32_t GetNumLevels() const;
+
+    // Clear the depth buffer to the far value.
+    void Clear();
+
+    // Rasterize a list of indexed triangles into the depth buffer.
+    // @param modelViewProjection Transforms the positions into clip space.
+    // @param positions The vertex positions of the triangles.
+    // @param indices 3 indices per triangle.
+    // @param numIndices The number of indices in the index array.
+    void RasterizeTriangles( const glm::mat4& modelViewProjection, const glm::vec3* positions, const uint32_t* indices, uint32_t numIndices );
+
+    // Build the hierarchical depth buffer.
+    // Must be called after all occluders have been rasterized and before testing for visibility.
+    void BuildHierarchy();
+
+    // Returns true if the bounding box is (potentially) visible.
+    // Boxes that are completely outside of the view are not visible.
+    // @param modelViewProjection Transforms the bounding box into clip space.
+    // @param boundingBox The bounding box to test (in object space).
+    bool IsVisible( const glm::mat4& modelViewProjection, const BoundingBox& boundingBox ) const;
+
+    // Returns true if a point is behind the occluder in its texel of the depth buffer.
+    // Points that are behind the camera or outside of the view are not occluded.
+    // @param viewProjection Transforms the point into clip space.
+    // @param point The point to test (in world space).
+    bool IsPointOccluded( const glm::mat4& viewProjection, const glm::vec3& point ) const;
+
+    // Get the depth value of a texel in one of the levels of the hierarchical depth buffer.
+    float GetDepth( uint32_t x, uint32_t y, uint32_t level = 0 ) const;
+
+private:
+    // Rasterize a single triangle in clip space.
+    void RasterizeTriangle( const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2 );
+    // Rasterize a single triangle in screen space (x, y in pixels, z is the depth).
+    void RasterizeScreenTriangle( const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2 );
+
+    glm::vec3 ClipToScreen( const glm::vec4& clipPosition ) const;
+
+    struct DepthLevel
+    {
+        uint32_t Width;
+        uint32_t Height;
+        std::vector<float> Depth;
+    };
+    typedef std::vector<DepthLevel> DepthLevelList;
+
+    // Level 0 is the full resolution depth buffer.
+    DepthLevelList m_Levels;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <map>
+#include <deque>
+
+/**
+ * A range of descriptors that was allocated from a DescriptorAllocator or a TransientDescriptorRing.
+ * The allocators only work with the offsets of the descriptors in their pages,
+ * the heap of the page converts the offset to a CPU or GPU descriptor handle.
+ */
+struct DescriptorAllocation
+{
+    DescriptorAllocation()
+        : Page( 0 )
+        , Offset( 0 )
+        , Count( 0 )
+    {}
+
+    DescriptorAllocation( uint32_t page, uint32_t offset, uint32_t count )
+        : Page( page )
+        , Offset( offset )
+        , Count( count )
+    {}
+
+    // An allocation that failed (or a default constructed allocation) has no descriptors.
+    bool IsValid() const
+    {
+        return Count != 0;
+    }
+
+    uint32_t Page;
+    uint32_t Offset;
+    uint32_t Count;
+};
+
+/**
+ * The heap that descriptor pages are created in.
+ * The DirectX 12 implementation creates a descriptor heap for every page.
+ * Any other implementation (for example, one that only counts the pages)
+ * can be used to test the allocators without a device.
+ */
+class DescriptorPageHeap
+{
+public:
+    virtual ~DescriptorPageHeap() {}
+
+    // Create a page of numDescriptors descriptors.
+    // Pages are numbered in the order they are created (starting at 0).
+    virtual void CreatePage( uint32_t numDescriptors ) = 0;
+};
+
+/**
+ * Allocates ranges of descriptors that are used for more than one frame
+ * (for example, the views of textures and buffers).
+ * Descriptors are allocated from pages of a fixed size. Each page keeps a list of its free ranges
+ * sorted by offset (to merge a freed range with its neighbours) and by size (to find the
+ * smallest free range that fits). A new page is created when none of the pages has a large enough free range.
+ * Freed descriptors can still be used by command lists that are executing on the GPU,
+ * so they are only returned to their page when the fence value of the frame they were freed in is completed.
+ * The allocator is not thread-safe.
+ */
+class DescriptorAllocator
+{
+public:
+    DescriptorAllocator( DescriptorPageHeap& heap, uint32_t descriptorsPerPage = 1024 );
+    virtual ~DescriptorAllocator();
+
+    // Allocate count consecutive descriptors (count can't be larger than the number of descriptors per page).
+    DescriptorAllocation Allocate( uint32_t count = 1 );
+
+    // Free the descriptors when the GPU has completed fenceValue.
+    // Fence values must not decrease between calls.
+    void Free( const DescriptorAllocation& allocation, uint64_t fenceValue );
+
+    // Return the descriptors that were freed before completedFenceValue to their pages.
+    void ReleaseStaleDescriptors( uint64_t completedFenceValue );
+
+    uint32_t GetDescriptorsPerPage() const;
+    uint32_t GetNumPages() const;
+    // The number of descriptors that can be allocated without creating a new page.
+    uint32_t GetNumFreeDescriptors() const;
+    // The number of descriptors that are waiting for their fence value to be completed.
+    uint32_t GetNumStaleDescriptors() const;
+
+private:
+    struct FreeRange;
+    // Offset -> free range.
+    typedef std::map<uint32_t, FreeRange> FreeListByOffset;
+    // Size -> free range.
+    typedef std::multimap<uint32_t, FreeListByOffset::iterator> FreeListBySize;
+
+    struct FreeRange
+    {
+        uint32_t Size;
+        FreeListBySize::iterator BySize;
+    };
+
+    // The free lists refer to each other with iterators,
+    // so the pages are allocated separately (and never moved).
+    struct Page
+    {
+        FreeListByOffset FreeByOffset;
+        FreeListBySize FreeBySize;
+        uint32_t NumFreeDescriptors;
+    };
+    typedef std::vector< std::unique_ptr<Page> > PageList;
+
+    struct StaleAllocation
+    {
+        DescriptorAllocation Allocation;
+        uint64_t FenceValue;
+    };
+    typedef std::deque<StaleAllocation> StaleAllocationList;
+
+    void CreatePage();
+    // Add a free range to a page and merge it with the free ranges before and after it.
+    void AddFreeRange( Page& page, uint32_t offset, uint32_t size );
+    void RemoveFreeRange( Page& page, FreeListByOffset::iterator iter );
+
+    DescriptorPageHeap& m_Heap;
+    uint32_t m_DescriptorsPerPage;
+
+    PageList m_Pages;
+    StaleAllocationList m_StaleAllocations;
+    uint32_t m_NumFreeDescriptors;
+    uint32_t m_NumStaleDescriptors;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+class Mesh;
+class PipelineState;
+class RenderQueue;
+
+// A render queue that is filled by the DrawListBuilder (for example, the render queue of a pass).
+// The draw list selects the meshes that are added to its render queue
+// and draws the sorted render queue when it is rendered.
+class DrawList
+{
+public:
+    virtual ~DrawList() {}
+
+    // Returns true if the mesh should be added to the render queue.
+    // This function may be called from multiple threads at the same time.
+    virtual bool FilterMesh( Mesh& mesh, const glm::mat4& modelViewProjection ) = 0;
+
+    // The pipeline state that is used to sort the render items.
+    virtual std::shared_ptr<PipelineState> GetPipelineState() const = 0;
+
+    // The render queue that is filled by the draw list builder.
+    virtual std::shared_ptr<RenderQueue> GetRenderQueue() const = 0;
+
+    // Called with true when the render queue has been filled and sorted for the current frame.
+    virtual void SetRenderQueueBuilt( bool renderQueueBuilt ) = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Visitor.h>
+
+#include <RenderQueue.h>
+
+class Scene;
+class SceneNode;
+class Mesh;
+class Camera;
+class DrawList;
+class JobSystem;
+class LodSelector;
+
+// Builds the render queues of several draw lists (for example, the passes of a render technique) in parallel.
+// The scene graph is flattened into a list of nodes which is split into batches.
+// The batches are processed by the threads of the job system. For each node in a batch,
+// the per object matrices are computed and the meshes of the node are filtered by each
+// of the draw lists. The resulting render items are written to per-batch arenas which are merged
+// in batch order so the result does not depend on the number of threads.
+// Finally the render queues are sorted (in parallel) and the draw lists only have to
+// submit the sorted draw calls when they are rendered.
+// The draw list builder doesn't use the render device, so it can be used without a GPU.
+class DrawListBuilder : public Visitor
+{
+public:
+    typedef Visitor base;
+
+    // @param jobSystem The job system of the application (it must outlive the draw list builder).
+    DrawListBuilder( std::shared_ptr<Scene> scene, JobSystem& jobSystem );
+    virtual ~DrawListBuilder();
+
+    // Add a draw list whose render queue should be built by this draw list builder.
+    // The draw list must have a render queue and it must render the same scene.
+    void AddDrawList( std::shared_ptr<DrawList> drawList );
+
+    // Select the level of detail of each mesh once for all draw lists.
+    void SetLodSelector( std::shared_ptr<LodSelector> lodSelector );
+
+    // Build the render queues of the draw lists for the current frame.
+    // Must be called before the draw lists are rendered.
+    void Build( Camera& camera );
+
+    // The number of nodes in the flattened scene graph.
+    uint32_t GetNumNodes() const;
+
+    // Inherited from Visitor
+    virtual void Visit( Scene& scene );
+    virtual void Visit( SceneNode& node );
+    virtual void Visit( Mesh& mesh );
+
+private:
+    // A scene node in the flattened scene graph.
+    struct FlatNode
+    {
+        SceneNode* Node;
+        // Range in the mesh list.
+        uint32_t FirstMesh;
+        uint32_t NumMeshes;
+    };
+    typedef std::vector<FlatNode> FlatNodeList;
+    typedef std::vector<Mesh*> MeshList;
+
+    // A render item with its view depth.
+    struct DrawPacket
+    {
+        RenderQueue::RenderItem RenderItem;
+        float ViewDepth;
+    };
+    typedef std::vector<DrawPacket> DrawPacketList;
+
+    // The draw packets that are produced by a single batch, one list per draw list.
+    typedef std::vector<DrawPacketList> BatchArena;
+    typedef std::vector<BatchArena> BatchArenaList;
+
+    typedef std::vector< std::shared_ptr<DrawList> > DrawListList;
+
+    void BuildBatch( uint32_t batchIndex, uint32_t begin, uint32_t end, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix );
+
+    std::shared_ptr<Scene> m_Scene;
+    JobSystem& m_JobSystem;
+
+    DrawListList m_DrawLists;
+    std::shared_ptr<LodSelector> m_LodSelector;
+
+    FlatNodeList m_Nodes;
+    MeshList m_Meshes;
+
+    BatchArenaList m_BatchArenas;
+};
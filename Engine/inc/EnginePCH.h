@@ -72,6 +72,8 @@
 #include <atomic>
 #include <mutex>
 #include <thread>
+#include <condition_variable>
+#include <functional>
 
 // BOOST
 #include <boost/uuid/uuid.hpp>
@@ -24,20 +24,20 @@ public:
     // Add a callback to the the list
     // Returns the connection object that can be used to disconnect the 
     // subscriber from the signal.
-    ConnectionType operator += ( typename const FunctionType& callback ) const
+    ConnectionType operator += ( const FunctionType& callback ) const
     {
         return m_Callbacks.connect( callback );
     }
 
     // Remove a callback from the list
-    void operator -= ( typename const FunctionType& callback ) const
+    void operator -= ( const FunctionType& callback ) const
     {
         assert(false);
         // TODO: This isn't working yet.. Getting a compiler error:
         // Error	1	error C2666: 'boost::operator ==' : 4 overloads have similar conversions signal_template.hpp
         // WORKAROUND: Use the connection object returned when the subscriber was initially connected
         // to disconnect the subscriber.
-        m_Callbacks.disconnect<FunctionType>( callback );
+        m_Callbacks.template disconnect<FunctionType>( callback );
     }
 
     void operator -= ( ConnectionType& con )
@@ -50,7 +50,7 @@ public:
     }
 
     // Invoke this event with the argument
-    void operator()( typename ArgumentType& argument )
+    void operator()( ArgumentType& argument )
     {
         m_Callbacks( argument );
     }
@@ -240,7 +240,7 @@ public:
         , State( state )
         , ButtonID( buttonID )
     {
-        memcpy_s( ButtonStates, sizeof( ButtonStates ), buttonStates, sizeof(buttonStates) );
+        std::copy( buttonStates, buttonStates + 32, ButtonStates );
     }
 
     // The ID of the joystick that triggered this event.
@@ -281,7 +281,7 @@ public:
         , Angle( povAngle )
         , Direction( povDirection )
     {
-        memcpy_s( ButtonStates, sizeof( ButtonStates ), buttonStates, sizeof( buttonStates ) );
+        std::copy( buttonStates, buttonStates + 32, ButtonStates );
     }
 
     // The ID of the joystick that triggered this event.
@@ -324,7 +324,7 @@ public:
         , ChangedAxis( changedAxis )
         , Axis( axis )
     {
-        memcpy_s( ButtonStates, sizeof( ButtonStates ), buttonStates, sizeof( buttonStates ) );
+        std::copy( buttonStates, buttonStates + 32, ButtonStates );
     }
 
     // The ID of the joystick that triggered this event.
@@ -380,7 +380,7 @@ class RenderEventArgs : public EventArgs
 {
 public:
     typedef EventArgs base;
-    RenderEventArgs( const Object& caller, float fDeltaTime, float fTotalTime, uint64_t frameCounter, Camera* camera = nullptr, PipelineState* pipelineState = nullptr )
+    RenderEventArgs( const Object& caller, float fDeltaTime, float fTotalTime, uint64_t frameCounter, ::Camera* camera = nullptr, ::PipelineState* pipelineState = nullptr )
         : base( caller )
         , ElapsedTime( fDeltaTime )
         , TotalTime( fTotalTime )
@@ -392,8 +392,8 @@ public:
     float ElapsedTime;
     float TotalTime;
     int64_t FrameCounter;
-    Camera* Camera;
-    PipelineState* PipelineState;
+    ::Camera* Camera;
+    ::PipelineState* PipelineState;
 };
 typedef Delegate<RenderEventArgs> RenderEvent;
 
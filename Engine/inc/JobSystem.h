@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * A simple job system that executes parallel loops on a pool of worker threads.
+ * The thread that calls ParallelFor also executes batches of the loop and
+ * blocks until all of the batches have been executed.
+ * Several threads can execute parallel loops at the same time and a batch can start
+ * a nested parallel loop. Each loop keeps its own counters, the worker threads pick
+ * batches from any loop that has batches left and the calling thread only
+ * executes batches of its own loop (so it never waits for an unrelated loop).
+ */
+class JobSystem
+{
+public:
+    // @param begin The first index of the batch.
+    // @param end One past the last index of the batch.
+    // @param threadIndex The index of the thread that executes the batch in [0, GetMaxThreads()).
+    // The calling thread uses index 0, unless it is a worker thread of the same job system
+    // (a nested loop) in which case it keeps its own index. Threads that execute batches of the same
+    // loop at the same time never have the same index, so the index can select per-thread storage.
+    typedef std::function<void( uint32_t begin, uint32_t end, uint32_t threadIndex )> ParallelForFunction;
+
+    // Create a job system.
+    // @param numWorkerThreads The number of worker threads to create. If 0, one worker
+    // thread is created for each hardware thread (excluding the calling thread).
+    JobSystem( uint32_t numWorkerThreads = 0 );
+    ~JobSystem();
+
+    // The maximum number of threads that can execute a parallel loop (including the calling thread).
+    uint32_t GetMaxThreads() const;
+
+    // Limit the number of threads that are used to execute a parallel loop (including the calling thread).
+    // The limit is applied to each loop, loops that run at the same time can use different threads.
+    // This can be used to measure how well an algorithm scales with the number of threads.
+    void SetNumThreads( uint32_t numThreads );
+    uint32_t GetNumThreads() const;
+
+    // Execute a function for the range [0, count) in batches of batchSize.
+    // The batches are executed in parallel and the function returns when all
+    // of the batches have been executed. Can be called from any thread, including
+    // from a batch of another parallel loop.
+    void ParallelFor( uint32_t count, uint32_t batchSize, const ParallelForFunction& function );
+
+private:
+    // A parallel loop. Lives on the stack of the thread that calls ParallelFor.
+    struct Job
+    {
+        const ParallelForFunction* Function;
+        uint32_t Count;
+        uint32_t BatchSize;
+        uint32_t NumBatches;
+        std::atomic<uint32_t> NextBatch;
+        // The number of worker threads that can execute batches of the loop.
+        uint32_t MaxWorkers;
+        // The number of worker threads that are executing batches of the loop (guarded by m_Mutex).
+        uint32_t NumActiveWorkers;
+    };
+    typedef std::vector<Job*> JobList;
+
+    void WorkerThread( uint32_t threadIndex );
+    // Find a loop that has batches left and can use another worker thread (m_Mutex must be locked).
+    Job* FindJob();
+    static void ExecuteBatches( Job& job, uint32_t threadIndex );
+
+    typedef std::vector<std::thread> ThreadList;
+    ThreadList m_WorkerThreads;
+    uint32_t m_NumThreads;
+
+    // The parallel loops that have batches that were not started.
+    JobList m_Jobs;
+    bool m_Quit;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_JobAvailable;
+    std::condition_variable m_JobFinished;
+};
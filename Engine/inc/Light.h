@@ -2,7 +2,7 @@
 
 #include <cstdint>
 
-__declspec( align( 16 ) ) struct Light
+struct alignas( 16 ) Light
 {
     enum class LightType : uint32_t
     {
@@ -68,7 +68,7 @@ __declspec( align( 16 ) ) struct Light
     glm::vec2   m_Padding;
     //--------------------------------------------------------------(16 bytes )
     //--------------------------------------------------------------( 16 * 7 = 112 bytes )
-    Light::Light()
+    Light()
         : m_PositionWS( 0, 0, 0, 1 )
         , m_DirectionWS( 0, 0, -1, 0 )
         , m_PositionVS( 0, 0, 0, 1 )
@@ -81,4 +81,22 @@ __declspec( align( 16 ) ) struct Light
         , m_Selected( false )
         , m_Type( LightType::Point )
     {}
+
+    /**
+     * The bounding sphere (center and radius) of the volume that is used to render the light (see LightsPass).
+     * The arrow of a directional light is unit length and the cone of a spot light
+     * is within the length of its side from the apex.
+     */
+    glm::vec4 GetBoundingSphere() const
+    {
+        switch ( m_Type )
+        {
+        case LightType::Spot:
+            return glm::vec4( glm::vec3( m_PositionWS ), m_Range / glm::max( glm::cos( glm::radians( m_SpotlightAngle ) ), 1e-3f ) );
+        case LightType::Directional:
+            return glm::vec4( glm::vec3( m_PositionWS ), 1.0f );
+        default:
+            return glm::vec4( glm::vec3( m_PositionWS ), m_Range );
+        }
+    }
 };
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+class Mesh;
+class Camera;
+
+// Selects the level of detail of the meshes in the scene based on their size on screen.
+// The geometric error of each level of detail is projected onto the screen and the
+// coarsest level of detail with an error below the threshold (in pixels) is selected.
+// To avoid popping when the distance to a mesh changes slightly, a mesh only switches
+// to a coarser level of detail if the error is well below the threshold (hysteresis).
+// The same LOD selector should be shared by all passes that render the scene so that
+// the same level of detail is used in every pass (the depth prepass must match the shading passes).
+class LodSelector
+{
+public:
+    LodSelector( float errorThreshold = 1.0f, float hysteresis = 0.25f );
+    virtual ~LodSelector();
+
+    // If disabled, the full detail mesh is always selected.
+    void SetEnabled( bool enabled );
+    bool IsEnabled() const;
+
+    // The maximum error of the selected level of detail in pixels.
+    void SetErrorThreshold( float errorThreshold );
+    float GetErrorThreshold() const;
+
+    // Switch to a coarser level of detail only if its error is below (1 - hysteresis) * threshold.
+    void SetHysteresis( float hysteresis );
+    float GetHysteresis() const;
+
+    // Update the projection of the camera. This should be called once per frame
+    // before the levels of detail are selected.
+    void Update( Camera& camera );
+
+    // Select the level of detail of a mesh.
+    // This function may be called from multiple threads at the same time.
+    // @param modelView The matrix that transforms the mesh to view space.
+    // @param currentLod The level of detail that was selected for the mesh in the previous frame.
+    uint32_t SelectLod( const Mesh& mesh, const glm::mat4& modelView, uint32_t currentLod ) const;
+
+private:
+    bool m_Enabled;
+    float m_ErrorThreshold;
+    float m_Hysteresis;
+    // Converts an object space error at a view distance of 1 to pixels.
+    float m_ProjectionScale;
+};
@@ -32,6 +32,11 @@ public:
 
     virtual void Bind( std::weak_ptr<Shader> pShader ) const;
 
+    // Update the constant buffer if the material properties have changed.
+    // Bind updates the constant buffer if necessary, but a material that is
+    // bound on multiple threads (while recording command lists) must be updated first.
+    void Update();
+
     const glm::vec4& GetDiffuseColor() const;
     void SetDiffuseColor( const glm::vec4& diffuse );
 
@@ -67,6 +72,10 @@ public:
 
     std::shared_ptr<Texture> GetTexture( TextureType ID ) const;
     void SetTexture( TextureType type, std::shared_ptr<Texture> texture );
+    // Bind a texture to a texture slot without enabling it in the material properties
+    // (the shaders will not sample it). This is used to bind a placeholder texture
+    // while the actual texture is still loading.
+    void SetPlaceholderTexture( TextureType type, std::shared_ptr<Texture> texture );
 
     // This material defines a transparent material 
     // if the opacity value is < 1, or there is an opacity map, or the diffuse texture has an alpha channel.
@@ -76,7 +85,7 @@ private:
     // If the material properties have changed, update the contents of the constant buffer.
     void UpdateConstantBuffer();
 
-    __declspec( align( 16 ) ) struct MaterialProperties
+    struct alignas( 16 ) MaterialProperties
     {
         MaterialProperties()
             : m_GlobalAmbient( 0.1f, 0.1f, 0.15f, 1 )
@@ -2,6 +2,7 @@
 
 #include <Object.h>
 #include <BufferBinding.h>
+#include <BoundingBox.h>
 
 class Buffer;
 class Shader;
@@ -9,6 +10,38 @@ class Material;
 class RenderEventArgs;
 class Visitor;
 
+// A simplified copy of the mesh geometry that is rasterized on the CPU
+// to occlude other meshes in the scene.
+struct OccluderGeometry
+{
+    std::vector<glm::vec3> Positions;
+    std::vector<uint32_t> Indices;
+};
+
+// A cluster of triangles of the full detail mesh that is culled as a unit.
+struct Meshlet
+{
+    // The triangles of the meshlet are a range of MeshletGeometry::Indices.
+    uint32_t FirstIndex;
+    uint32_t NumIndices;
+    // The bounding sphere (in object space).
+    glm::vec3 Center;
+    float Radius;
+    // The normal cone. The meshlet is back facing if
+    // dot( Center - viewPosition, ConeAxis ) >= ConeCutoff * length( Center - viewPosition ) + Radius.
+    // A cutoff of 1 means the meshlet is never back facing.
+    glm::vec3 ConeAxis;
+    float ConeCutoff;
+};
+
+// The meshlets of a mesh and a CPU copy of the indices of the full detail mesh
+// that are used to build a compacted index buffer of the visible meshlets.
+struct MeshletGeometry
+{
+    std::vector<Meshlet> Meshlets;
+    std::vector<uint32_t> Indices;
+};
+
 // A mesh contains the geometry and materials required to render this mesh.
 class Mesh : public Object
 {
@@ -16,11 +49,53 @@ public:
 	// Adds a buffer to this mesh with a particular semantic (HLSL) or register ID (GLSL).
 	virtual void AddVertexBuffer( const BufferBinding& binding, std::shared_ptr<Buffer> buffer ) = 0;
     virtual void SetIndexBuffer( std::shared_ptr<Buffer> buffer ) = 0;
+    // Set a single vertex buffer that contains all of the vertex attributes in the quantized
+    // vertex format. The positions are stored relative to quantizationBounds.
+    // This buffer is used instead of the other vertex buffers if the vertex shader
+    // was compiled for interleaved vertices (QUANTIZED_VERTICES).
+    virtual void SetQuantizedVertexBuffer( std::shared_ptr<Buffer> buffer, const BoundingBox& quantizationBounds ) = 0;
+
+    // Add a level of detail to the mesh. A level of detail is a range of the index buffer.
+    // Levels of detail must be added from the most to the least detailed.
+    // If no levels of detail are added, the whole mesh is the only level of detail.
+    // @param error The geometric error of the level of detail (in object space).
+    virtual void AddLod( uint32_t firstIndex, uint32_t numIndices, float error ) = 0;
+    virtual uint32_t GetNumLods() const = 0;
+    virtual float GetLodError( uint32_t lod ) const = 0;
+    // The number of triangles that are drawn for a level of detail.
+    virtual uint32_t GetNumTriangles( uint32_t lod = 0 ) const = 0;
 
     virtual void SetMaterial( std::shared_ptr<Material> material ) = 0;
     virtual std::shared_ptr<Material> GetMaterial() const = 0;
 
+    // The object space bounding box of the mesh.
+    virtual void SetBoundingBox( const BoundingBox& boundingBox ) = 0;
+    virtual const BoundingBox& GetBoundingBox() const = 0;
+
+    // If the mesh was chosen as an occluder, this is the geometry that is used
+    // for software occlusion culling (nullptr otherwise).
+    virtual void SetOccluderGeometry( std::shared_ptr<const OccluderGeometry> occluderGeometry ) = 0;
+    virtual std::shared_ptr<const OccluderGeometry> GetOccluderGeometry() const = 0;
+
+    // The meshlets that are used for cluster culling (nullptr if the mesh was not split into meshlets).
+    virtual void SetMeshletGeometry( std::shared_ptr<const MeshletGeometry> meshletGeometry ) = 0;
+    virtual std::shared_ptr<const MeshletGeometry> GetMeshletGeometry() const = 0;
+
 	virtual void Render( RenderEventArgs& renderEventArgs ) = 0;
 
+    // Render is equivalent to calling BindBuffers, BindMaterial and Draw.
+    // These can be called separately to avoid rebinding the buffers or the material
+    // when consecutive draw calls use the same mesh or the same material.
+    // Bind the vertex and index buffers to the pipeline state in the render event args.
+    virtual void BindBuffers( RenderEventArgs& renderEventArgs ) = 0;
+    // Bind the material to the shaders of the pipeline state in the render event args.
+    virtual void BindMaterial( RenderEventArgs& renderEventArgs ) = 0;
+    // Issue the draw call. The buffers must already be bound.
+    // If instanceCount is greater than 1, an instanced draw call is issued.
+    virtual void Draw( RenderEventArgs& renderEventArgs, uint32_t instanceCount = 1, uint32_t lod = 0 ) = 0;
+    // Draw a range of the index buffer that is currently bound instead of the index buffer of the mesh
+    // (for example, a compacted index buffer of the visible meshlets). The vertex buffers must already be bound.
+    virtual void DrawIndexRange( RenderEventArgs& renderEventArgs, uint32_t firstIndex, uint32_t numIndices ) = 0;
+
     virtual void Accept( Visitor& visitor ) = 0;
 };
\ No newline at end of file
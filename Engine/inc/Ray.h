@@ -2,6 +2,8 @@
 #pragma once
 
 class Material;
+class RaycastHit;
+struct Light;
 
 class Ray
 {
@@ -12,6 +14,25 @@ public:
 	// Gets a point that is distance units along the ray.
 	glm::vec3 GetPointOnRay( float distance ) const;
 
+	// Intersect the ray with a sphere.
+	// If the ray starts inside the sphere, the far intersection point is returned.
+	// Returns true if the sphere was hit (and fills in the hit result).
+	bool IntersectSphere( const glm::vec3& center, float radius, RaycastHit& hit ) const;
+
+	// Intersect the ray with a solid cone (including the base of the cone).
+	// @param apex The apex (tip) of the cone.
+	// @param axis The normalized direction from the apex to the base of the cone.
+	// @param height The distance from the apex to the base of the cone.
+	// @param angle The half angle of the cone (in degrees).
+	// Returns true if the cone was hit (and fills in the hit result).
+	bool IntersectCone( const glm::vec3& apex, const glm::vec3& axis, float height, float angle, RaycastHit& hit ) const;
+
+	// Intersect the ray with the volumes that are used to render lights: a sphere for point lights,
+	// a cone for spot lights and the bounding sphere of a unit length arrow for directional lights.
+	// The lights are rejected with their bounding spheres first (boundingSpheres[i] is lights[i].GetBoundingSphere()).
+	// Returns true if a light was hit (and fills in the closest hit with the index of the light).
+	bool IntersectLights( const Light* lights, const glm::vec4* boundingSpheres, uint32_t numLights, RaycastHit& hit ) const;
+
 	// The origin of the ray in 3D space.
 	glm::vec3 m_Origin;
 	// The normalized direction of the ray in 3D space.
@@ -3,9 +3,19 @@
  * RaycastHit structure is used to return the result of a Raycast
  */
 
+class Material;
+
 class RaycastHit
 {
 public:
+	RaycastHit()
+		: Point( 0 )
+		, Normal( 0 )
+		, Distance( 0 )
+		, pMaterial( nullptr )
+		, Index( (uint32_t)-1 )
+	{}
+
 	// The point in 3D space where the ray hit the geometry.
 	glm::vec3 Point;
 	// The surface normal where the ray hit the geometry.
@@ -16,4 +26,8 @@ public:
 	// A pointer to the material that was hit (if one was, NULL otherwise)
 	Material* pMaterial;
 
+	// The index of the object that was hit (for example, the index
+	// of a light in the lights array). (uint32_t)-1 if not set.
+	uint32_t Index;
+
 };
\ No newline at end of file
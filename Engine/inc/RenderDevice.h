@@ -5,6 +5,7 @@
 #include "Texture.h"
 #include "Query.h"
 #include "CPUAccess.h"
+#include "ResourceHandle.h"
 
 class RenderWindow;
 class Buffer;
@@ -17,6 +18,10 @@ class SamplerState;
 class Material;
 class PipelineState;
 class RenderTarget;
+class ConstantBufferRing;
+class CommandList;
+class ResourceStateTracker;
+struct StateCacheStatistics;
 // class Query;
 
 /**
@@ -57,31 +62,31 @@ public:
     // The plane will be centered at the origin.
     // @param size The size of the plane.
     // @param N Surface normal to the plane.
-    virtual std::shared_ptr<Scene> CreatePlane( float size, const glm::vec3& N = glm::vec3( 0, 1, 0 ) ) = 0;
+    virtual std::shared_ptr<Scene> CreatePlane( float size, const glm::vec3& N = glm::vec3( 0, 1, 0 ) );
     
     // Create a screen-space quad that can be used to render full-screen post-process effects to the screen.
     // By default, the quad will have clip-space coordinates and can be used with a pass-through vertex shader
     // to render full-screen post-process effects. If you want more control over the area of the screen the quad covers, 
     // you can specify your own screen coordinates and supply an appropriate orthographic projection matrix to align the 
     // screen quad appropriately.
-    virtual std::shared_ptr<Scene> CreateScreenQuad( float left = -1.0f, float right = 1.0f, float bottom = -1.0f, float top = 1.0f, float z = 0.0f ) = 0;
+    virtual std::shared_ptr<Scene> CreateScreenQuad( float left = -1.0f, float right = 1.0f, float bottom = -1.0f, float top = 1.0f, float z = 0.0f );
 
     // Create a sphere in 3D
     // @param radius Radius of the sphere.
     // @param tesselation The amount of tessellation to apply to the sphere. Default tessellation is 4.
-    virtual std::shared_ptr<Scene> CreateSphere( float radius, float tesselation = 4 ) = 0;
+    virtual std::shared_ptr<Scene> CreateSphere( float radius, float tesselation = 4 );
     
     // Create a cube in 3D.
     // The cube will be centered at the origin.
     // @param size The length of each edge of the cube.
-    virtual std::shared_ptr<Scene> CreateCube( float size ) = 0;
+    virtual std::shared_ptr<Scene> CreateCube( float size );
     
     // Create a cylinder that is aligned to a particular axis.
     // @param baseRadius The radius of the base (bottom) of the cylinder.
     // @param apexRadius The radius of the apex (top) of the cylinder.
     // @param height The height of the sphere along the axis of the cylinder.
     // @param axis The axis to align the cylinder. Default to the global Y axis.
-    virtual std::shared_ptr<Scene> CreateCylinder( float baseRadius, float apexRadius, float height, const glm::vec3& axis = glm::vec3( 0, 1, 0 ) ) = 0;
+    virtual std::shared_ptr<Scene> CreateCylinder( float baseRadius, float apexRadius, float height, const glm::vec3& axis = glm::vec3( 0, 1, 0 ) );
     
     // Create a cone.
     // Cones are always aligned to (0, 1, 0) with the base of the cone 
@@ -89,21 +94,21 @@ public:
     // A cone is just a cylinder with an apex radius of 0.
     // @param baseRadius The radius of the base of the cone.
     // @param height The height of the cone.
-    virtual std::shared_ptr<Scene> CreateCone( float baseRadius, float height ) = 0;
+    virtual std::shared_ptr<Scene> CreateCone( float baseRadius, float height );
     
     // Create a 3D arrow.
     // Arrows can be used to represent the direction an object or light is pointing.
     // @param tail The tail (begin point) of the arrow.
     // @param head The head (end point) of the arrow.
     // @param radius The radius of the body of the arrow.
-    virtual std::shared_ptr<Scene> CreateArrow( const glm::vec3& tail = glm::vec3( 0, 0, 0), const glm::vec3& head = glm::vec3( 0, 0, 1 ), float radius = 0.05f ) = 0;
+    virtual std::shared_ptr<Scene> CreateArrow( const glm::vec3& tail = glm::vec3( 0, 0, 0), const glm::vec3& head = glm::vec3( 0, 0, 1 ), float radius = 0.05f );
 
     // Create a 3D axis with X, -X, Y, -Y, Z, -Z axes.
     // Primarily used to debug an object's position and direction in 3D space.
     // The axis is aligned to 0,0,0 and the global X, Y, Z axes.
     // @param radius is the radius of the axis arms.
     // @param length is the length is the length of each axis arm.
-    virtual std::shared_ptr<Scene> CreateAxis( float radius = 0.05f, float length = 0.5f ) = 0;
+    virtual std::shared_ptr<Scene> CreateAxis( float radius = 0.05f, float length = 0.5f );
 
     virtual void DestroyScene( std::shared_ptr<Scene> scene ) = 0;
 
@@ -150,10 +155,46 @@ public:
 
     virtual std::shared_ptr<Buffer> CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride ) = 0;
     virtual std::shared_ptr<Buffer> CreateDoubleVertexBuffer( const double* data, unsigned int count, unsigned int stride ) = 0;
+    virtual std::shared_ptr<Buffer> CreateUShortIndexBuffer( const unsigned short* data, unsigned int count ) = 0;
     virtual std::shared_ptr<Buffer> CreateUIntIndexBuffer( const unsigned int* data, unsigned int sizeInBytes ) = 0;
     virtual std::shared_ptr<ConstantBuffer> CreateConstantBuffer( const void* data, size_t size ) = 0;
     virtual std::shared_ptr<StructuredBuffer> CreateStructuredBuffer( void* data, unsigned int count, unsigned int stride, CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false ) = 0;
 
+    // The ring buffer that per draw constant buffer data is allocated from.
+    // Returns nullptr if the device does not support binding a range of a constant buffer
+    // (use a ConstantBuffer per draw instead).
+    virtual ConstantBufferRing* GetConstantBufferRing();
+
+    // Create a command list that records commands on a worker thread.
+    // Returns nullptr if the device can only issue commands on the thread that created it
+    // (render on the calling thread instead).
+    virtual std::shared_ptr<CommandList> CreateCommandList();
+    virtual void DestroyCommandList( std::shared_ptr<CommandList> commandList );
+
+    // The tracker that passes declare the resources they read and write with before they are rendered
+    // (buffers and textures are identified by their Buffer or Texture pointer).
+    // Returns nullptr if the device does not transition resources between states
+    // (the driver tracks the states of the resources).
+    virtual ResourceStateTracker* GetResourceStateTracker();
+    // Transition the resources that were declared since the previous call in one batch.
+    virtual void FlushResourceTransitions();
+
+    // The state changes that were issued to the graphics API and the state changes that were skipped
+    // by the state cache in the last frame that was presented (reset every frame).
+    // Returns nullptr if the device does not cache state.
+    virtual const StateCacheStatistics* GetStateCacheStatistics() const;
+
+    // Buffers (of any kind) and textures are also identified by generational handles.
+    // A handle becomes stale when its resource is destroyed: the resource of a stale handle is nullptr
+    // and destroying a stale handle does nothing (even if another resource reuses its slot).
+    virtual ResourceHandle GetBufferHandle( std::shared_ptr<Buffer> buffer ) const = 0;
+    virtual std::shared_ptr<Buffer> GetBuffer( ResourceHandle handle ) const = 0;
+    virtual void DestroyBuffer( ResourceHandle handle ) = 0;
+
+    virtual ResourceHandle GetTextureHandle( std::shared_ptr<Texture> texture ) const = 0;
+    virtual std::shared_ptr<Texture> GetTexture( ResourceHandle handle ) const = 0;
+    virtual void DestroyTexture( ResourceHandle handle ) = 0;
+
 protected: 
     virtual void OnLoadingProgress( ProgressEventArgs& e );
 };
@@ -12,20 +12,22 @@ std::shared_ptr<Buffer> RenderDevice::CreateVertexBuffer< std::vector<glm::vec4>
 
 // Template specializations for index buffers.
 template<>
+std::shared_ptr<Buffer> RenderDevice::CreateIndexBuffer< std::vector<unsigned short> >( const std::vector<unsigned short>& data );
+template<>
 std::shared_ptr<Buffer> RenderDevice::CreateIndexBuffer< std::vector<unsigned int> >( const std::vector<unsigned int>& data );
 
 // Non-specialized template methods.
 template< typename T >
 std::shared_ptr<Buffer> RenderDevice::CreateVertexBuffer( const T& data )
 {
-    BOOST_STATIC_ASSERT_MSG( false, "This function must be specialized." );
+    BOOST_STATIC_ASSERT_MSG( sizeof( T ) == 0, "This function must be specialized." );
     return NULL;
 }
 
 template<typename T>
 std::shared_ptr<Buffer> RenderDevice::CreateIndexBuffer( const T& data )
 {
-    BOOST_STATIC_ASSERT_MSG( false, "This function must be specialized." );
+    BOOST_STATIC_ASSERT_MSG( sizeof( T ) == 0, "This function must be specialized." );
     return NULL;
 }
 
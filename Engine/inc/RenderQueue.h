@@ -0,0 +1,95 @@
+#pragma once
+
+class Mesh;
+class Material;
+class PipelineState;
+
+// A render queue collects the meshes that are rendered by a pass so that they can be
+// sorted before they are drawn. Each render item gets a 64-bit sort key that is built
+// from the pipeline state, the material, the mesh (and its level of detail) and the view depth of the item.
+// Sorting the keys groups draw calls that share the same state (which minimizes the
+// number of state changes) and orders the draw calls by depth.
+class RenderQueue
+{
+public:
+    enum class SortOrder
+    {
+        // Sort by state (pipeline, material, mesh) then front-to-back by depth.
+        // Used for opaque geometry.
+        FrontToBack,
+        // Sort back-to-front by depth then by state.
+        // Used for transparent geometry.
+        BackToFront,
+    };
+
+    struct RenderItem
+    {
+        ::Mesh* Mesh;
+        glm::mat4 ModelViewProjection;
+        glm::mat4 ModelView;
+        // The level of detail of the mesh that is drawn.
+        uint32_t Lod;
+    };
+    typedef std::vector<RenderItem> RenderItemList;
+
+    RenderQueue( SortOrder sortOrder = SortOrder::FrontToBack );
+    virtual ~RenderQueue();
+
+    SortOrder GetSortOrder() const;
+
+    // If sorting is disabled, the render items are drawn in the order they are pushed to the queue.
+    void SetSortingEnabled( bool enabled );
+    bool IsSortingEnabled() const;
+
+    // Remove all render items from the queue.
+    void Clear();
+
+    // Add a mesh to the render queue.
+    // The view depth used to sort the item is computed from the center of the mesh's bounding box.
+    void Push( PipelineState* pipeline, Mesh& mesh, const glm::mat4& modelViewProjection, const glm::mat4& modelView, uint32_t lod = 0 );
+    // Add a render item with a precomputed view depth to the render queue.
+    void Push( PipelineState* pipeline, const RenderItem& renderItem, float viewDepth );
+
+    // Reserve memory for a number of render items.
+    void Reserve( size_t numRenderItems );
+
+    // Compute the view depth that is used to sort a mesh (the depth of the center of the mesh's bounding box).
+    static float GetViewDepth( const Mesh& mesh, const glm::mat4& modelView );
+
+    // Sort the render items in the queue.
+    void Sort();
+
+    // Get the number of render items in the queue.
+    size_t GetSize() const;
+    // Get a render item in sorted order (Sort must be called first).
+    const RenderItem& GetRenderItem( size_t index ) const;
+
+protected:
+    // Build a 64-bit sort key.
+    uint64_t MakeSortKey( uint32_t pipelineID, uint32_t materialID, uint32_t meshID, uint32_t lod, float viewDepth ) const;
+
+    // Map pointers to small integer IDs that can be packed into the sort keys.
+    uint32_t GetID( const void* pointer );
+
+private:
+    struct SortEntry
+    {
+        uint64_t SortKey;
+        uint32_t Index;
+    };
+    typedef std::vector<SortEntry> SortEntryList;
+
+    // LSD radix sort of the sort entries (8 bits per pass).
+    void RadixSort();
+
+    SortOrder m_SortOrder;
+    bool m_SortingEnabled;
+
+    RenderItemList m_RenderItems;
+    SortEntryList m_SortEntries;
+    // Temporary buffer used by the radix sort.
+    SortEntryList m_SortEntriesTemp;
+
+    typedef std::unordered_map<const void*, uint32_t> IDMap;
+    IDMap m_IDs;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+/**
+ * A generational handle to an object in a SlotMap.
+ * The index identifies the slot and the generation identifies the object
+ * that occupied the slot when the handle was created. When the object is removed,
+ * the generation of the slot is incremented so that all handles to the object become stale
+ * (even if the slot is reused for another object).
+ * A default constructed handle (generation 0) is invalid.
+ */
+struct ResourceHandle
+{
+    ResourceHandle()
+        : Index( 0 )
+        , Generation( 0 )
+    {}
+
+    ResourceHandle( uint32_t index, uint32_t generation )
+        : Index( index )
+        , Generation( generation )
+    {}
+
+    // Returns false for a default constructed handle.
+    // A valid handle can still be stale (check with SlotMap::Contains).
+    bool IsValid() const
+    {
+        return Generation != 0;
+    }
+
+    bool operator==( const ResourceHandle& rhs ) const
+    {
+        return Index == rhs.Index && Generation == rhs.Generation;
+    }
+
+    bool operator!=( const ResourceHandle& rhs ) const
+    {
+        return !( *this == rhs );
+    }
+
+    uint32_t Index;
+    uint32_t Generation;
+};
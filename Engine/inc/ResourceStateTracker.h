@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * The ways a resource can be accessed by the GPU.
+ * The read states can be combined (a resource can be read as a shader resource
+ * and as the source of a copy without a transition between them).
+ * A resource that is written is only in the single state it is written in.
+ */
+enum class ResourceState : uint32_t
+{
+    Common = 0,
+    // Read states.
+    VertexBuffer = 1 << 0,
+    IndexBuffer = 1 << 1,
+    ConstantBuffer = 1 << 2,
+    ShaderResource = 1 << 3,
+    CopySource = 1 << 4,
+    DepthRead = 1 << 5,
+    // Write states.
+    RenderTarget = 1 << 6,
+    UnorderedAccess = 1 << 7,
+    DepthWrite = 1 << 8,
+    CopyDest = 1 << 9,
+};
+
+/**
+ * Tracks the states of the resources that are accessed by the passes of a frame.
+ * Before a pass is executed, it declares the resources it reads and writes.
+ * Flushing the declarations computes the smallest batch of transitions that puts
+ * every declared resource in the state the pass needs:
+ *  - A resource that is already in the declared state is not transitioned.
+ *  - A resource that is read in several states in the same pass is transitioned once
+ *    to the combination of these states.
+ *  - A resource that is read keeps the read states it is already in, so passes that
+ *    read it in any of these states later don't need a transition either.
+ *  - A resource that is written as an unordered access view by consecutive passes is not
+ *    transitioned, but a UAV barrier is added so the writes of the previous pass are finished.
+ * The tracker does not use a graphics API. Resources are identified by an opaque pointer
+ * (for example the Texture or Buffer object) and the device translates the transitions
+ * to the barriers of its API (or ignores them if the driver tracks the resource states).
+ * States are tracked per resource (not per subresource).
+ * The tracker is not thread-safe.
+ */
+class ResourceStateTracker
+{
+public:
+    struct Transition
+    {
+        const void* Resource;
+        ResourceState StateBefore;
+        ResourceState StateAfter;
+
+        // A UAV barrier does not change the state of the resource.
+        bool IsUAVBarrier() const
+        {
+            return StateBefore == ResourceState::UnorderedAccess && StateAfter == ResourceState::UnorderedAccess;
+        }
+    };
+    typedef std::vector<Transition> TransitionList;
+
+    ResourceStateTracker();
+    virtual ~ResourceStateTracker();
+
+    // Set the state of a resource without a transition
+    // (for example the state a resource is created in).
+    // Resources that are not known to the tracker are in the Common state.
+    void SetState( const void* resource, ResourceState state );
+    ResourceState GetState( const void* resource ) const;
+    // Stop tracking a resource (for example when it is destroyed).
+    void RemoveResource( const void* resource );
+    // Stop tracking all resources (and discard the declarations that were not flushed).
+    void Clear();
+
+    // Declare that the next pass reads resource in a read state.
+    // A resource can be read in several states by the same pass.
+    void Read( const void* resource, ResourceState state );
+    // Declare that the next pass writes resource in a write state.
+    // A resource can only be written in one state by a pass and it can't also be read by the pass.
+    void Write( const void* resource, ResourceState state );
+    // Returns true if the resource was declared since the previous flush.
+    bool IsDeclared( const void* resource ) const;
+
+    // Compute the transitions for the resources that were declared since the previous flush
+    // and update the states of the resources. The transitions are valid until the next flush.
+    const TransitionList& Flush();
+
+    // The number of resources that are tracked.
+    size_t GetNumResources() const;
+    // The number of resources that were declared and didn't need a transition.
+    uint64_t GetNumSkippedTransitions() const;
+    // The number of transitions (including UAV barriers) that were returned by Flush.
+    uint64_t GetNumTransitions() const;
+
+private:
+    struct Access
+    {
+        const void* Resource;
+        ResourceState State;
+        bool Write;
+    };
+    typedef std::vector<Access> AccessList;
+    // The index of the declaration of a resource in the list of declarations.
+    typedef std::unordered_map<const void*, size_t> AccessMap;
+    typedef std::unordered_map<const void*, ResourceState> StateMap;
+
+    StateMap m_States;
+
+    // The resources that were declared since the previous flush (in the order they were declared).
+    AccessList m_Accesses;
+    AccessMap m_AccessIndices;
+
+    TransitionList m_Transitions;
+
+    uint64_t m_NumSkippedTransitions;
+    uint64_t m_NumTransitions;
+};
@@ -13,8 +13,16 @@ class Scene : public Object
 public:
     /**
      * Load a scene from a file on disc.
+     * 
+     * @param fileName The scene file to load.
+     * @param streamTextures If true, this function returns as soon as the scene graph and the meshes
+     * have been created. The textures are loaded in the background and assigned to the materials
+     * in UpdateStreaming. Until then, the materials use a placeholder texture.
+     * @param quantizeVertices If true, the vertex attributes of each mesh are stored in a single
+     * interleaved vertex buffer with quantized positions, normals, tangents and texture coordinates.
+     * These meshes must be rendered with vertex shaders that are compiled with QUANTIZED_VERTICES.
      */
-    virtual bool LoadFromFile( const std::wstring& fileName ) = 0;
+    virtual bool LoadFromFile( const std::wstring& fileName, bool streamTextures = false, bool quantizeVertices = false ) = 0;
     /**
      * Load a scene from a string.
      * The scene can be preloaded into a byte array and the 
@@ -28,9 +36,19 @@ public:
 
     virtual std::shared_ptr<SceneNode> GetRootNode() const = 0;
 
+    /**
+     * Assign the textures that have been loaded in the background to the materials
+     * and prioritize the remaining textures by the on-screen size of the meshes that use them.
+     * This must be called once per frame on the render thread.
+     */
+    virtual void UpdateStreaming( const Camera& camera ) = 0;
+    // Returns true while there are textures that are still being loaded in the background.
+    virtual bool IsStreaming() const = 0;
+
     virtual void Accept( Visitor& visitor ) = 0;
 
     // Register for the progress callback to be notified of scene loading progress.
+    // When textures are streamed, this event is raised on the streaming thread.
     ProgressEvent LoadingProgress;
 
 protected:
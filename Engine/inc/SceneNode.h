@@ -65,6 +65,14 @@ public:
     void AddMesh( std::shared_ptr<Mesh> mesh );
     void RemoveMesh( std::shared_ptr<Mesh> mesh );
 
+    /**
+     * The level of detail that was last selected for a mesh of this node
+     * (the meshes are indexed in the order they are visited).
+     * This is used to apply hysteresis when the level of detail changes.
+     */
+    uint32_t GetMeshLod( size_t meshIndex ) const;
+    void SetMeshLod( size_t meshIndex, uint32_t lod );
+
     /**
      * Render meshes associated with this scene node.
      * This method will traverse it's children.
@@ -96,6 +104,8 @@ private:
     NodeList m_Children;
     NodeNameMap m_ChildrenByName;
     MeshList m_Meshes;
+    // The selected level of detail of each mesh.
+    std::vector<uint32_t> m_MeshLods;
 
     
 };
\ No newline at end of file
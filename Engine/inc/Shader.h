@@ -1,5 +1,6 @@
 #pragma once
 #include <Object.h>
+#include <ShaderParameterID.h>
 
 class ShaderParameter;
 class ConstantBuffer;
@@ -69,6 +70,21 @@ public:
         return GetShaderParameterByName( name );
     }
 
+    /**
+     * Get a reference to a parameter defined in the shader by its interned ID.
+     * Shaders that store their parameters in a table indexed by the ID
+     * override this to avoid the string lookup of GetShaderParameterByName.
+     * @return The ShaderParameter or an invalid shader parameter if the shader does not define it.
+     */
+    virtual ShaderParameter& GetShaderParameter( const ShaderParameterID& id ) const
+    {
+        return GetShaderParameterByName( id.GetName() );
+    }
+    virtual ShaderParameter& operator[]( const ShaderParameterID& id ) const
+    {
+        return GetShaderParameter( id );
+    }
+
  //   /**
  //    * Gets a pointer to a constant buffer defined in the shader.
  //    */
@@ -27,6 +27,12 @@ public:
     template <typename T>
     std::shared_ptr<T> Get() const;
 
+    // Bind a resource to the slot of the parameter without assigning it to the parameter.
+    // The parameter itself is not modified, so the parameters of a shared shader can be
+    // bound to different resources on multiple threads (for example while recording command lists).
+    template <typename T>
+    void BindResource( std::shared_ptr<T> value );
+
     // Get the type of the stored parameter.
     virtual Type GetType() const = 0;
 
@@ -43,6 +49,9 @@ protected:
     virtual void SetSampler( std::shared_ptr<SamplerState> sampler ) = 0;
     virtual void SetStructuredBuffer( std::shared_ptr<StructuredBuffer> rwBuffer ) = 0;
 
+    virtual void BindConstantBuffer( ConstantBuffer& constantBuffer ) = 0;
+    virtual void BindStructuredBuffer( StructuredBuffer& buffer ) = 0;
+
 private:
 };
 
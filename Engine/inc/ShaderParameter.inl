@@ -10,8 +10,21 @@ void ShaderParameter::Set<SamplerState>( std::shared_ptr<SamplerState> value );
 template<>
 void ShaderParameter::Set<StructuredBuffer>( std::shared_ptr<StructuredBuffer> value );
 
+template<>
+void ShaderParameter::BindResource<ConstantBuffer>( std::shared_ptr<ConstantBuffer> value );
+
+template<>
+void ShaderParameter::BindResource<StructuredBuffer>( std::shared_ptr<StructuredBuffer> value );
+
 template<typename T>
 void ShaderParameter::Set( std::shared_ptr<T> value )
 {
-    BOOST_STATIC_ASSERT_MSG( false, "This function must be specialized.");
+    // The condition depends on T so it is only evaluated if this template is instantiated.
+    BOOST_STATIC_ASSERT_MSG( sizeof( T ) == 0, "This function must be specialized." );
+}
+
+template<typename T>
+void ShaderParameter::BindResource( std::shared_ptr<T> value )
+{
+    BOOST_STATIC_ASSERT_MSG( sizeof( T ) == 0, "This function must be specialized." );
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * An interned shader parameter name.
+ * Every name is assigned a unique (dense) index the first time it is interned,
+ * so shaders can find their parameters in a flat array instead of comparing
+ * strings. Create the ID once (for example as a static variable) and reuse it
+ * every frame; constructing an ID from a name takes a lock and a map lookup.
+ */
+class ShaderParameterID
+{
+public:
+    // An invalid ID.
+    ShaderParameterID();
+    explicit ShaderParameterID( const std::string& name );
+
+    // The index of the name in the intern table.
+    uint32_t GetIndex() const;
+    const std::string& GetName() const;
+
+    bool IsValid() const;
+
+    bool operator==( const ShaderParameterID& other ) const;
+    bool operator!=( const ShaderParameterID& other ) const;
+
+    // The number of names that have been interned so far.
+    static uint32_t GetNumIDs();
+
+private:
+    uint32_t m_Index;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ResourceHandle.h"
+
+/**
+ * A slot map stores objects in a vector of slots and hands out generational handles.
+ * Inserting and removing objects is O(1): removed slots are kept in a free list
+ * and are reused by the next insertion. Looking up a handle is a single index into the
+ * vector and a comparison of the generation, so stale handles (handles to removed objects)
+ * are detected instead of returning the object that reused the slot.
+ * The slots are never released, so the memory of the slot map is
+ * proportional to the maximum number of objects that were stored at the same time.
+ */
+template< typename T >
+class SlotMap
+{
+public:
+    SlotMap();
+
+    // Insert an object and return its handle.
+    ResourceHandle Insert( const T& value );
+    ResourceHandle Insert( T&& value );
+
+    // Remove the object of the handle. The object in the slot is replaced with a default constructed object.
+    // Returns false if the handle is stale (the object has already been removed).
+    bool Remove( ResourceHandle handle );
+
+    // Returns nullptr if the handle is stale.
+    T* Get( ResourceHandle handle );
+    const T* Get( ResourceHandle handle ) const;
+
+    bool Contains( ResourceHandle handle ) const;
+
+    // The number of objects in the slot map.
+    size_t GetSize() const;
+    // The number of slots (the maximum number of objects that were stored at the same time).
+    size_t GetCapacity() const;
+
+    // Reserve memory for a number of slots.
+    void Reserve( size_t numSlots );
+
+    // Remove all of the objects. All existing handles become stale.
+    void Clear();
+
+private:
+    struct Slot
+    {
+        T Value;
+        // Incremented when the object in the slot is removed.
+        uint32_t Generation;
+        // The index of the next free slot (only used if the slot isn't occupied).
+        uint32_t NextFree;
+        bool Occupied;
+    };
+    typedef std::vector<Slot> SlotList;
+
+    // Returns the index of a free slot (the slot is added to the end of the slot list if there are no free slots).
+    uint32_t AllocateSlot();
+    void FreeSlot( uint32_t index );
+
+    // The end of the free list.
+    static const uint32_t InvalidIndex = 0xffffffff;
+
+    SlotList m_Slots;
+    uint32_t m_FirstFree;
+    size_t m_Size;
+};
+
+#include "SlotMap.inl"
@@ -0,0 +1,122 @@
+template< typename T >
+SlotMap<T>::SlotMap()
+    : m_FirstFree( InvalidIndex )
+    , m_Size( 0 )
+{}
+
+template< typename T >
+ResourceHandle SlotMap<T>::Insert( const T& value )
+{
+    return Insert( T( value ) );
+}
+
+template< typename T >
+ResourceHandle SlotMap<T>::Insert( T&& value )
+{
+    uint32_t index = AllocateSlot();
+    Slot& slot = m_Slots[index];
+    slot.Value = std::move( value );
+    slot.Occupied = true;
+    ++m_Size;
+
+    return ResourceHandle( index, slot.Generation );
+}
+
+template< typename T >
+bool SlotMap<T>::Remove( ResourceHandle handle )
+{
+    if ( !Contains( handle ) ) return false;
+
+    FreeSlot( handle.Index );
+    return true;
+}
+
+template< typename T >
+T* SlotMap<T>::Get( ResourceHandle handle )
+{
+    return Contains( handle ) ? &m_Slots[handle.Index].Value : nullptr;
+}
+
+template< typename T >
+const T* SlotMap<T>::Get( ResourceHandle handle ) const
+{
+    return Contains( handle ) ? &m_Slots[handle.Index].Value : nullptr;
+}
+
+template< typename T >
+bool SlotMap<T>::Contains( ResourceHandle handle ) const
+{
+    return handle.Index < m_Slots.size() && m_Slots[handle.Index].Occupied && m_Slots[handle.Index].Generation == handle.Generation;
+}
+
+template< typename T >
+size_t SlotMap<T>::GetSize() const
+{
+    return m_Size;
+}
+
+template< typename T >
+size_t SlotMap<T>::GetCapacity() const
+{
+    return m_Slots.size();
+}
+
+template< typename T >
+void SlotMap<T>::Reserve( size_t numSlots )
+{
+    m_Slots.reserve( numSlots );
+}
+
+template< typename T >
+void SlotMap<T>::Clear()
+{
+    // The slots are freed in reverse order so they are reused from the start of the slot list.
+    for ( size_t i = m_Slots.size(); i > 0; --i )
+    {
+        if ( m_Slots[i - 1].Occupied )
+        {
+            FreeSlot( (uint32_t)( i - 1 ) );
+        }
+    }
+}
+
+template< typename T >
+uint32_t SlotMap<T>::AllocateSlot()
+{
+    if ( m_FirstFree != InvalidIndex )
+    {
+        uint32_t index = m_FirstFree;
+        m_FirstFree = m_Slots[index].NextFree;
+        return index;
+    }
+
+    if ( m_Slots.size() >= InvalidIndex )
+    {
+        ReportError( "Slot map is full." );
+    }
+
+    Slot slot;
+    // Generation 0 is reserved for invalid handles.
+    slot.Generation = 1;
+    slot.NextFree = InvalidIndex;
+    slot.Occupied = false;
+    m_Slots.push_back( std::move( slot ) );
+
+    return (uint32_t)( m_Slots.size() - 1 );
+}
+
+template< typename T >
+void SlotMap<T>::FreeSlot( uint32_t index )
+{
+    Slot& slot = m_Slots[index];
+    // Release the object now (not when the slot is reused).
+    slot.Value = T();
+    slot.Occupied = false;
+    if ( ++slot.Generation == 0 )
+    {
+        slot.Generation = 1;
+    }
+    slot.NextFree = m_FirstFree;
+    m_FirstFree = index;
+    --m_Size;
+}
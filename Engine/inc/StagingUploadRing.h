@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+
+/**
+ * Batches the uploads of data from the CPU to resources on the GPU.
+ * The data of an upload is copied to a ring of staging memory that the CPU can write
+ * and the GPU can read (the persistently mapped memory of an upload heap,
+ * or system memory for a device without a GPU). Instead of copying each upload to its
+ * resource when it is made, the uploads are queued and flushed as a single batch of copy regions.
+ * Uploads to consecutive ranges of the same resource that are also consecutive in
+ * the staging memory (for example pixels that are plotted in the same row) are merged into one region.
+ * At the end of a frame, the position of the ring is recorded with the fence value
+ * that the GPU signals when it has finished the copies of the frame. The staging memory
+ * of the frame is retired when the fence value is completed.
+ * An upload never wraps around the end of the ring (the memory at the end of the ring is skipped instead).
+ * The ring is not thread-safe.
+ */
+class StagingUploadRing
+{
+public:
+    // A copy from the staging memory to a range of a resource.
+    struct CopyRegion
+    {
+        const void* Destination;
+        size_t DestinationOffset;
+        // The offset of the data in the staging memory.
+        size_t SourceOffset;
+        size_t Size;
+    };
+    typedef std::vector<CopyRegion> CopyRegionList;
+
+    // @param pMemory The staging memory (owned by the caller and valid for the lifetime of the ring).
+    // @param size The size of the staging memory in bytes.
+    StagingUploadRing( void* pMemory, size_t size );
+    virtual ~StagingUploadRing();
+
+    // Copy size bytes of data to the staging memory and queue a copy to destination at destinationOffset.
+    // The data is placed in the staging memory at a multiple of alignment.
+    // Returns false if the ring is full (retire the completed frames or wait for the GPU).
+    bool Upload( const void* destination, size_t destinationOffset, const void* data, size_t size, size_t alignment = 1 );
+
+    // The uploads that were queued since the previous flush. Uploads to the same destination
+    // keep their order (a later upload to the same range overwrites an earlier upload),
+    // uploads to different destinations are grouped by destination.
+    // The regions are valid until the next flush.
+    const CopyRegionList& Flush();
+    // Are there uploads that were not flushed?
+    bool HasPendingUploads() const;
+
+    // End the current frame. The staging memory of the frame is retired when fenceValue is completed.
+    // The uploads of the frame must be flushed first. Fence values must not decrease between calls.
+    void EndFrame( uint64_t fenceValue );
+
+    // Retire the staging memory of all frames that ended with a fence value up to completedFenceValue.
+    void Retire( uint64_t completedFenceValue );
+
+    // The staging memory at an offset of a copy region.
+    const uint8_t* GetData( size_t offset ) const;
+
+    size_t GetSize() const;
+    // The number of bytes that have been allocated and not retired (including skipped bytes).
+    size_t GetUsedSize() const;
+
+private:
+    struct Frame
+    {
+        uint64_t FenceValue;
+        // The position of the ring at the end of the frame.
+        uint64_t End;
+    };
+    typedef std::deque<Frame> FrameList;
+
+    uint8_t* m_pMemory;
+    size_t m_Size;
+
+    // The positions only increase. The offset in the ring is the position modulo the size of the ring.
+    // The position of the next upload.
+    uint64_t m_Head;
+    // The position of the oldest byte that has not been retired.
+    uint64_t m_Tail;
+
+    // The frames that have ended but have not been retired.
+    FrameList m_Frames;
+
+    // The uploads that have not been flushed (in the order they were made).
+    CopyRegionList m_PendingUploads;
+    CopyRegionList m_CopyRegions;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+/**
+ * Counts the state changes that a render device issued to the graphics API
+ * and the state changes that were skipped because the state was already bound.
+ * Used by the state caches of the render devices.
+ * The counters of the last frame can be queried with RenderDevice::GetStateCacheStatistics.
+ */
+struct StateCacheStatistics
+{
+    // The kinds of state that are cached.
+    enum class State
+    {
+        Shader,
+        InputLayout,
+        ConstantBuffer,
+        ShaderResource,
+        Sampler,
+        UnorderedAccess,
+        VertexBuffer,
+        IndexBuffer,
+        PrimitiveTopology,
+        BlendState,
+        RasterizerState,
+        Viewports,
+        ScissorRects,
+        DepthStencilState,
+        RenderTargets,
+        NumStates
+    };
+
+    StateCacheStatistics();
+
+    // Set all counters to 0.
+    void Reset();
+
+    // Count a state change.
+    // Returns true if the value differs from the cached value (the cached value is updated)
+    // or false if the state change is redundant and can be skipped.
+    template<typename T>
+    bool Update( State state, T& cachedValue, const T& value );
+
+    // Add the counters of another state cache (for example the state cache of a command list).
+    // The number of frames is not added.
+    void Add( const StateCacheStatistics& other );
+
+    // Count a state change that is always issued.
+    void Issue( State state );
+    // Count a state change that was skipped.
+    void Skip( State state );
+
+    // Total number of state changes issued (or skipped) of all kinds.
+    uint64_t GetNumIssued() const;
+    uint64_t GetNumSkipped() const;
+
+    // Log the number of issued and skipped state changes averaged over the number of frames.
+    void Report( const std::string& deviceName ) const;
+
+    // The number of frames the counters were counted in.
+    uint64_t Frames;
+
+    uint64_t Issued[(size_t)State::NumStates];
+    uint64_t Skipped[(size_t)State::NumStates];
+};
+
+template<typename T>
+bool StateCacheStatistics::Update( State state, T& cachedValue, const T& value )
+{
+    if ( cachedValue == value )
+    {
+        Skip( state );
+        return false;
+    }
+
+    cachedValue = value;
+    Issue( state );
+    return true;
+}
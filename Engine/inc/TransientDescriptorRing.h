@@ -0,0 +1,58 @@
+#pragma once
+
+#include "DescriptorAllocator.h"
+
+#include <deque>
+
+/**
+ * A ring of descriptors that are only used for a single frame
+ * (for example, the descriptor tables that are copied to a shader visible heap before a draw call).
+ * Descriptors are allocated linearly from a single page (the ring needs a heap of its own,
+ * so the allocations are always in page 0). At the end of a frame, the position of the ring
+ * is recorded with the fence value that the GPU signals when it has finished the frame.
+ * The descriptors of the frame are retired when the fence value is completed.
+ * A range of descriptors never wraps around the end of the ring
+ * (the descriptors at the end of the ring are skipped instead).
+ * The ring is not thread-safe.
+ */
+class TransientDescriptorRing
+{
+public:
+    TransientDescriptorRing( DescriptorPageHeap& heap, uint32_t numDescriptors );
+    virtual ~TransientDescriptorRing();
+
+    // Allocate count consecutive descriptors for the current frame.
+    // Returns an invalid allocation if the ring is full (retire the completed frames or wait for the GPU).
+    DescriptorAllocation Allocate( uint32_t count = 1 );
+
+    // End the current frame. The descriptors of the frame are retired when fenceValue is completed.
+    // Fence values must not decrease between calls.
+    void EndFrame( uint64_t fenceValue );
+
+    // Retire the descriptors of all frames that ended with a fence value up to completedFenceValue.
+    void Retire( uint64_t completedFenceValue );
+
+    uint32_t GetNumDescriptors() const;
+    // The number of descriptors that have been allocated and not retired (including skipped descriptors).
+    uint32_t GetNumUsedDescriptors() const;
+
+private:
+    struct Frame
+    {
+        uint64_t FenceValue;
+        // The position of the ring at the end of the frame.
+        uint64_t End;
+    };
+    typedef std::deque<Frame> FrameList;
+
+    uint32_t m_NumDescriptors;
+
+    // The positions only increase. The offset in the ring is the position modulo the number of descriptors.
+    // The position of the next allocation.
+    uint64_t m_Head;
+    // The position of the oldest descriptor that has not been retired.
+    uint64_t m_Tail;
+
+    // The frames that have ended but have not been retired.
+    FrameList m_Frames;
+};
@@ -6,9 +6,13 @@
 #include <Application.h>
 #include <Camera.h>
 #include <ProgressWindow.h>
+#include <JobSystem.h>
+#include <AssetCache.h>
 
 #include "DX11/RenderDeviceDX11.h"
 #include "DX11/RenderWindowDX11.h"
+#include "Null/RenderDeviceNull.h"
+#include "Null/RenderWindowNull.h"
 #if defined(_WIN32_WINNT_WIN10) 
 #   include "DX12/RenderDeviceDX12.h"
 #   include "DX12/RenderWindowDX12.h"
@@ -17,6 +21,8 @@
 
 #define RENDER_WINDOW_CLASS_NAME "RenderWindowClass"
 #define PROGRESS_WINDOW_CLASS_NAME "ProgressWindowClass"
+// The asset cache directory (relative to the folder that contains the executable).
+#define ASSET_CACHE_DIRECTORY L"../Cache"
 
 float g_GameDeltaTime = 0.0f;
 float g_ApplicationTime = 0.0f;
@@ -36,6 +42,29 @@ static void FreeImageErrorHandler( FREE_IMAGE_FORMAT fif, const char* message )
     ReportError( message );
 }
 
+// Returns true if the null render device was requested on the command line (-null or --null-device).
+// The null device doesn't use the GPU so it can be used to measure the CPU cost of the renderer.
+static bool UseNullRenderDevice()
+{
+    bool useNullDevice = false;
+
+    int numArgs;
+    LPWSTR* commandLineArguments = CommandLineToArgvW( GetCommandLineW(), &numArgs );
+    if ( commandLineArguments )
+    {
+        for ( int i = 0; i < numArgs; i++ )
+        {
+            if ( wcscmp( commandLineArguments[i], L"-null" ) == 0 || wcscmp( commandLineArguments[i], L"--null-device" ) == 0 )
+            {
+                useNullDevice = true;
+            }
+        }
+        LocalFree( commandLineArguments );
+    }
+
+    return useNullDevice;
+}
+
 Application::Application()
 : m_bIsInitialized( false )
 , m_bIsRunning( false )
@@ -105,7 +134,20 @@ Application::Application()
         ReportError( "Failed to register the progress window class." );
     }
 
+    m_pJobSystem = new JobSystem();
+
+    // The current directory can't be used for the asset cache because it may change after the application is created.
+    WCHAR moduleFileName[MAX_PATH];
+    DWORD moduleFileNameLength = ::GetModuleFileNameW( m_hInstance, moduleFileName, MAX_PATH );
+    fs::path modulePath = ( moduleFileNameLength > 0 && moduleFileNameLength < MAX_PATH ) ? fs::path( moduleFileName ).parent_path() : fs::current_path();
+    m_pAssetCache = new AssetCache( ( modulePath / ASSET_CACHE_DIRECTORY ).wstring(), *m_pJobSystem );
+
     // Create Render device.
+    if ( UseNullRenderDevice() )
+    {
+        m_pRenderDevice = new RenderDeviceNull();
+    }
+    else
 #if defined(_WIN32_WINNT_WIN10) && 0
     try
     {
@@ -161,6 +203,8 @@ Application::~Application()
     }
 
     delete m_pRenderDevice;
+    delete m_pAssetCache;
+    delete m_pJobSystem;
 
     gs_pApplicationInstance = nullptr;
 }
@@ -172,6 +216,22 @@ HINSTANCE Application::GetModuleHandle() const
 
 RenderWindow& Application::CreateRenderWindow( const std::string& windowName, int windowWidth, int windowHeight, bool vSync )
 {
+    // The null device doesn't present anything so its render window doesn't need a native window.
+    // The window is still rendered every frame, but it doesn't receive any input events.
+    if ( RenderDeviceNull* pNullDevice = dynamic_cast<RenderDeviceNull*>( m_pRenderDevice ) )
+    {
+        RenderWindow* pRenderWindow = new RenderWindowNull( *this, *pNullDevice, windowName, windowWidth, windowHeight, vSync );
+        m_Windows.insert( WindowMap::value_type( windowName, pRenderWindow ) );
+
+        if ( m_bIsRunning )
+        {
+            EventArgs eventArgs( *this );
+            pRenderWindow->OnInitialize( eventArgs );
+        }
+
+        return *pRenderWindow;
+    }
+
     int screenWidth = GetSystemMetrics( SM_CXSCREEN );
     int screenHeight = GetSystemMetrics( SM_CYSCREEN );
 
@@ -291,6 +351,18 @@ RenderDevice& Application::GetRenderDevice()
     return *m_pRenderDevice;
 }
 
+JobSystem& Application::GetJobSystem()
+{
+    assert( m_pJobSystem );
+    return *m_pJobSystem;
+}
+
+AssetCache& Application::GetAssetCache()
+{
+    assert( m_pAssetCache );
+    return *m_pAssetCache;
+}
+
 // Convert the message ID into a MouseButton ID
 static MouseButtonEventArgs::MouseButton DecodeMouseButton( UINT messageID )
 {
@@ -789,14 +861,14 @@ void Application::CheckFileChanges()
                 case FILE_ACTION_RENAMED_NEW_NAME:
                     fileAction = FileChangeEventArgs::FileAction::RenameNew;
                     break;
-                default:
+                default:
                     break;
                 }
 
                 FileChangeEventArgs fileChangedEventArgs( *this, fileAction, fileName );
                 OnFileChange( fileChangedEventArgs );
             }
-        default:
+        default:
             break;
         }
 
@@ -0,0 +1,169 @@
+#include <EnginePCH.h>
+
+#include <ContentHash.h>
+#include <JobSystem.h>
+
+#include <AssetCache.h>
+
+// The size of the chunks that files are hashed in (see AssetCache::HashFile).
+#define HASH_CHUNK_SIZE ( 1024 * 1024 )
+
+AssetCache::AssetCache( const std::wstring& cacheDirectory, JobSystem& jobSystem )
+    : m_CacheDirectory( cacheDirectory )
+    , m_JobSystem( jobSystem )
+{
+    boost::system::error_code errorCode;
+    fs::create_directories( fs::path( m_CacheDirectory ), errorCode );
+    if ( errorCode )
+    {
+        // Processed assets can't be saved, but they can still be loaded from their source files.
+        OutputDebugStringA( ( "Failed to create the asset cache directory: " + errorCode.message() + "\n" ).c_str() );
+    }
+}
+
+const std::wstring& AssetCache::GetCacheDirectory() const
+{
+    return m_CacheDirectory;
+}
+
+// Read and hash a chunk of a file.
+// Returns false if the chunk could not be read completely.
+static bool HashChunk( fs::ifstream& file, uint64_t size, std::vector<char>& buffer, AssetCache::Key& hash )
+{
+    file.read( buffer.data(), static_cast<std::streamsize>( size ) );
+    if ( static_cast<uint64_t>( file.gcount() ) != size )
+    {
+        return false;
+    }
+
+    hash = ContentHash::Hash( buffer.data(), static_cast<size_t>( size ) );
+    return true;
+}
+
+// The size of a chunk of a file.
+static uint64_t GetChunkSize( uint64_t fileSize, uint64_t chunkIndex )
+{
+    return std::min<uint64_t>( HASH_CHUNK_SIZE, fileSize - chunkIndex * HASH_CHUNK_SIZE );
+}
+
+static uint64_t GetNumChunks( uint64_t fileSize )
+{
+    return ( fileSize + HASH_CHUNK_SIZE - 1 ) / HASH_CHUNK_SIZE;
+}
+
+// The hash of a file is the hash of its size and the hashes of its chunks.
+static AssetCache::Key CombineChunkHashes( uint64_t fileSize, const std::vector<AssetCache::Key>& chunkHashes )
+{
+    ContentHash contentHash;
+    contentHash.Update( &fileSize, sizeof( fileSize ) );
+    contentHash.Update( chunkHashes.data(), chunkHashes.size() * sizeof( AssetCache::Key ) );
+    return contentHash.GetHash();
+}
+
+bool AssetCache::HashFile( const std::wstring& fileName, Key& hash )
+{
+    boost::system::error_code errorCode;
+    uint64_t fileSize = fs::file_size( fs::path( fileName ), errorCode );
+    fs::ifstream file( fs::path( fileName ), std::ios::in | std::ios::binary );
+    if ( errorCode || !file.is_open() )
+    {
+        return false;
+    }
+
+    std::vector<char> buffer( HASH_CHUNK_SIZE );
+    std::vector<Key> chunkHashes( GetNumChunks( fileSize ) );
+
+    for ( uint64_t i = 0; i < chunkHashes.size(); ++i )
+    {
+        if ( !HashChunk( file, GetChunkSize( fileSize, i ), buffer, chunkHashes[i] ) )
+        {
+            return false;
+        }
+    }
+
+    hash = CombineChunkHashes( fileSize, chunkHashes );
+    return true;
+}
+
+void AssetCache::HashFiles( const std::vector<std::wstring>& fileNames, std::vector<Key>& hashes ) const
+{
+    hashes.assign( fileNames.size(), 0 );
+
+    // A chunk of one of the files.
+    struct Chunk
+    {
+        uint32_t FileIndex;
+        uint64_t Index;
+    };
+
+    std::vector<uint64_t> fileSizes( fileNames.size(), 0 );
+    std::vector< std::vector<Key> > chunkHashes( fileNames.size() );
+    // The chunks that could not be read (one flag per chunk, so the chunks of a file can be hashed in parallel).
+    std::vector< std::vector<uint8_t> > chunkFailed( fileNames.size() );
+    std::vector<Chunk> chunks;
+
+    for ( uint32_t i = 0; i < fileNames.size(); ++i )
+    {
+        boost::system::error_code errorCode;
+        fileSizes[i] = fs::file_size( fs::path( fileNames[i] ), errorCode );
+        if ( errorCode )
+        {
+            chunkFailed[i].push_back( 1 );
+            continue;
+        }
+
+        uint64_t numChunks = GetNumChunks( fileSizes[i] );
+        chunkHashes[i].resize( numChunks );
+        chunkFailed[i].resize( numChunks, 0 );
+        for ( uint64_t chunk = 0; chunk < numChunks; ++chunk )
+        {
+            chunks.push_back( { i, chunk } );
+        }
+    }
+
+    // Every thread reads its chunks into its own buffer.
+    std::vector< std::vector<char> > buffers( m_JobSystem.GetMaxThreads() );
+
+    m_JobSystem.ParallelFor( static_cast<uint32_t>( chunks.size() ), 1, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        std::vector<char>& buffer = buffers[threadIndex];
+        buffer.resize( HASH_CHUNK_SIZE );
+
+        for ( uint32_t i = begin; i < end; ++i )
+        {
+            const Chunk& chunk = chunks[i];
+            uint64_t fileSize = fileSizes[chunk.FileIndex];
+
+            const std::wstring& fileName = fileNames[chunk.FileIndex];
+            fs::ifstream file( fs::path( fileName ), std::ios::in | std::ios::binary );
+            file.seekg( static_cast<std::streamoff>( chunk.Index * HASH_CHUNK_SIZE ) );
+            if ( !file || !HashChunk( file, GetChunkSize( fileSize, chunk.Index ), buffer, chunkHashes[chunk.FileIndex][chunk.Index] ) )
+            {
+                chunkFailed[chunk.FileIndex][chunk.Index] = 1;
+            }
+        }
+    } );
+
+    for ( uint32_t i = 0; i < fileNames.size(); ++i )
+    {
+        if ( std::find( chunkFailed[i].begin(), chunkFailed[i].end(), 1 ) == chunkFailed[i].end() )
+        {
+            hashes[i] = CombineChunkHashes( fileSizes[i], chunkHashes[i] );
+        }
+    }
+}
+
+std::wstring AssetCache::GetCachedFileName( Key key, const std::string& extension ) const
+{
+    wchar_t keyString[17];
+    std::swprintf( keyString, 17, L"%016llx", static_cast<unsigned long long>( key ) );
+
+    std::wstring fileName = keyString + ( L"." + std::wstring( extension.begin(), extension.end() ) );
+    return ( fs::path( m_CacheDirectory ) / fileName ).wstring();
+}
+
+bool AssetCache::Contains( Key key, const std::string& extension ) const
+{
+    fs::path cachedFile( GetCachedFileName( key, extension ) );
+    return fs::exists( cachedFile ) && fs::is_regular_file( cachedFile );
+}
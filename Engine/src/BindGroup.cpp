@@ -0,0 +1,92 @@
+#include <EnginePCH.h>
+
+#include <BindGroup.h>
+#include <Shader.h>
+#include <ShaderParameter.h>
+
+BindGroup::Entry& BindGroup::GetEntry( const ShaderParameterID& id )
+{
+    // Bind groups only contain a few parameters; a linear search is fine.
+    for ( Entry& entry : m_Entries )
+    {
+        if ( entry.ID == id )
+        {
+            entry = Entry();
+            entry.ID = id;
+            return entry;
+        }
+    }
+
+    m_Entries.push_back( Entry() );
+    m_Entries.back().ID = id;
+
+    return m_Entries.back();
+}
+
+void BindGroup::Set( const ShaderParameterID& id, std::shared_ptr<ConstantBuffer> constantBuffer )
+{
+    GetEntry( id ).pConstantBuffer = constantBuffer;
+}
+
+void BindGroup::Set( const ShaderParameterID& id, std::shared_ptr<Texture> texture )
+{
+    GetEntry( id ).pTexture = texture;
+}
+
+void BindGroup::Set( const ShaderParameterID& id, std::shared_ptr<SamplerState> sampler )
+{
+    GetEntry( id ).pSampler = sampler;
+}
+
+void BindGroup::Set( const ShaderParameterID& id, std::shared_ptr<StructuredBuffer> structuredBuffer )
+{
+    GetEntry( id ).pStructuredBuffer = structuredBuffer;
+}
+
+void BindGroup::Clear()
+{
+    m_Entries.clear();
+}
+
+void BindGroup::Apply( const Shader& shader ) const
+{
+    for ( const Entry& entry : m_Entries )
+    {
+        ShaderParameter& parameter = shader.GetShaderParameter( entry.ID );
+        if ( !parameter.IsValid() )
+        {
+            continue;
+        }
+
+        if ( entry.pConstantBuffer )
+        {
+            parameter.Set( entry.pConstantBuffer );
+        }
+        else if ( entry.pTexture )
+        {
+            parameter.Set( entry.pTexture );
+        }
+        else if ( entry.pSampler )
+        {
+            parameter.Set( entry.pSampler );
+        }
+        else if ( entry.pStructuredBuffer )
+        {
+            parameter.Set( entry.pStructuredBuffer );
+        }
+    }
+}
+
+void BindGroup::Bind( const Shader& shader ) const
+{
+    Apply( shader );
+
+    for ( const Entry& entry : m_Entries )
+    {
+        ShaderParameter& parameter = shader.GetShaderParameter( entry.ID );
+        if ( parameter.IsValid() )
+        {
+            parameter.Bind();
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#include <EnginePCH.h>
+#include <BoundingBox.h>
+
+BoundingBox::BoundingBox()
+    : m_Min( std::numeric_limits<float>::max() )
+    , m_Max( -std::numeric_limits<float>::max() )
+{}
+
+BoundingBox::BoundingBox( const glm::vec3& min, const glm::vec3& max )
+    : m_Min( min )
+    , m_Max( max )
+{}
+
+const glm::vec3& BoundingBox::GetMin() const
+{
+    return m_Min;
+}
+
+const glm::vec3& BoundingBox::GetMax() const
+{
+    return m_Max;
+}
+
+glm::vec3 BoundingBox::GetCenter() const
+{
+    return ( m_Min + m_Max ) * 0.5f;
+}
+
+glm::vec3 BoundingBox::GetExtents() const
+{
+    return ( m_Max - m_Min ) * 0.5f;
+}
+
+glm::vec3 BoundingBox::GetCorner( uint32_t index ) const
+{
+    return glm::vec3( ( index & 1 ) ? m_Max.x : m_Min.x,
+                      ( index & 2 ) ? m_Max.y : m_Min.y,
+                      ( index & 4 ) ? m_Max.z : m_Min.z );
+}
+
+bool BoundingBox::IsValid() const
+{
+    return m_Min.x <= m_Max.x && m_Min.y <= m_Max.y && m_Min.z <= m_Max.z;
+}
+
+void BoundingBox::Enlarge( const glm::vec3& point )
+{
+    m_Min = glm::min( m_Min, point );
+    m_Max = glm::max( m_Max, point );
+}
+
+void BoundingBox::Enlarge( const BoundingBox& other )
+{
+    if ( !other.IsValid() ) return;
+
+    m_Min = glm::min( m_Min, other.m_Min );
+    m_Max = glm::max( m_Max, other.m_Max );
+}
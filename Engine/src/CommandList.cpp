@@ -0,0 +1,56 @@
+#include <EnginePCH.h>
+
+#include <CommandList.h>
+
+// The command list that is recording on this thread.
+static thread_local CommandList* gs_pRecordingCommandList = nullptr;
+
+CommandList::CommandList()
+    : m_bIsRecording( false )
+{}
+
+CommandList::~CommandList()
+{}
+
+void CommandList::Begin()
+{
+    if ( gs_pRecordingCommandList != nullptr )
+    {
+        ReportError( "Another command list is already recording on this thread." );
+        return;
+    }
+    if ( m_bIsRecording )
+    {
+        ReportError( "The command list is already recording on another thread." );
+        return;
+    }
+
+    gs_pRecordingCommandList = this;
+    m_bIsRecording = true;
+
+    OnBegin();
+}
+
+void CommandList::End()
+{
+    if ( gs_pRecordingCommandList != this )
+    {
+        ReportError( "The command list is not recording on this thread." );
+        return;
+    }
+
+    OnEnd();
+
+    m_bIsRecording = false;
+    gs_pRecordingCommandList = nullptr;
+}
+
+bool CommandList::IsRecording() const
+{
+    return m_bIsRecording;
+}
+
+CommandList* CommandList::GetRecording()
+{
+    return gs_pRecordingCommandList;
+}
@@ -0,0 +1,132 @@
+#include <EnginePCH.h>
+
+#include <CommandList.h>
+#include <ConstantBufferRing.h>
+
+ConstantBufferRing::ConstantBufferRing( uint32_t size )
+    : m_Size( ( size / Alignment ) * Alignment )
+    , m_Head( 0 )
+    , m_Used( 0 )
+    , m_FrameUsed( 0 )
+    , m_Frame( 0 )
+    , m_NumFences( 0 )
+    , m_NumAllocations( 0 )
+    , m_NumBytes( 0 )
+    , m_NumWaits( 0 )
+    , m_NumDiscards( 0 )
+{}
+
+ConstantBufferRing::~ConstantBufferRing()
+{}
+
+ConstantBufferRing::Allocation ConstantBufferRing::Allocate( const void* data, size_t size )
+{
+    uint32_t alignedSize = (uint32_t)( ( size + Alignment - 1 ) / Alignment ) * Alignment;
+    if ( CommandList::GetRecording() != nullptr )
+    {
+        ReportError( "The constant buffer ring can not be used while a command list is recording." );
+        return Allocation();
+    }
+    if ( alignedSize == 0 || alignedSize > m_Size )
+    {
+        ReportError( "Constant buffer data does not fit in the ring buffer." );
+        return Allocation();
+    }
+
+    // Allocations are never split at the end of the ring buffer.
+    bool wrap = ( m_Head + alignedSize > m_Size );
+    uint32_t padding = wrap ? m_Size - m_Head : 0;
+
+    // The ring buffer is full. Wait for the GPU to finish the oldest frames until there is enough room.
+    while ( m_Used + padding + alignedSize > m_Size && !m_FramesInFlight.empty() )
+    {
+        WaitForFence( m_FramesInFlight.front().Fence );
+        m_Used -= m_FramesInFlight.front().Size;
+        m_FramesInFlight.pop_front();
+        ++m_NumWaits;
+    }
+
+    bool discard = false;
+    if ( m_Used + padding + alignedSize > m_Size )
+    {
+        // The current frame uses the rest of the buffer.
+        // Rename the buffer and start over at the beginning of the new buffer.
+        m_Used = 0;
+        m_FrameUsed = 0;
+        padding = 0;
+        wrap = true;
+        discard = true;
+        ++m_NumDiscards;
+    }
+
+    if ( wrap )
+    {
+        m_Head = 0;
+    }
+
+    Allocation allocation;
+    allocation.Offset = m_Head;
+    allocation.Size = alignedSize;
+
+    Write( allocation.Offset, data, size, discard );
+
+    m_Head += alignedSize;
+    m_Used += padding + alignedSize;
+    m_FrameUsed += padding + alignedSize;
+
+    ++m_NumAllocations;
+    m_NumBytes += alignedSize;
+
+    return allocation;
+}
+
+void ConstantBufferRing::EndFrame()
+{
+    RetireFrames();
+
+    // If all of the fences are still in use, the data of this frame is
+    // retired with the fence of the next frame instead of waiting for the GPU.
+    if ( m_FramesInFlight.size() < MaxFramesInFlight )
+    {
+        FrameInFlight frame;
+        frame.Fence = m_NumFences++;
+        frame.Size = m_FrameUsed;
+
+        InsertFence( frame.Fence );
+        m_FramesInFlight.push_back( frame );
+
+        m_FrameUsed = 0;
+    }
+
+    ++m_Frame;
+}
+
+void ConstantBufferRing::RetireFrames()
+{
+    while ( !m_FramesInFlight.empty() && IsFenceComplete( m_FramesInFlight.front().Fence ) )
+    {
+        m_Used -= m_FramesInFlight.front().Size;
+        m_FramesInFlight.pop_front();
+    }
+}
+
+uint32_t ConstantBufferRing::GetSize() const
+{
+    return m_Size;
+}
+
+uint64_t ConstantBufferRing::GetFrame() const
+{
+    return m_Frame;
+}
+
+void ConstantBufferRing::Report( const std::string& deviceName ) const
+{
+    double frames = (double)std::max<uint64_t>( m_Frame, 1 );
+
+    std::stringstream ss;
+    ss << deviceName << " constant buffer ring (" << m_Size / 1024 << " KB, " << m_Frame << " frames): "
+        << m_NumAllocations / frames << " allocations per frame, " << m_NumBytes / frames / 1024.0 << " KB per frame, "
+        << m_NumWaits << " waits, " << m_NumDiscards << " discards" << std::endl;
+    OutputDebugStringA( ss.str().c_str() );
+}
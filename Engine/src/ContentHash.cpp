@@ -0,0 +1,182 @@
+#include <EnginePCH.h>
+
+#include <ContentHash.h>
+
+// The primes that are used by the XXH64 algorithm.
+static const uint64_t PRIME64_1 = 11400714785074694791ULL;
+static const uint64_t PRIME64_2 = 14029467366897019727ULL;
+static const uint64_t PRIME64_3 = 1609587929392839161ULL;
+static const uint64_t PRIME64_4 = 9650029242287828579ULL;
+static const uint64_t PRIME64_5 = 2870177450012600261ULL;
+
+static inline uint64_t RotateLeft( uint64_t x, int r )
+{
+    return ( x << r ) | ( x >> ( 64 - r ) );
+}
+
+// Unaligned little-endian reads.
+static inline uint64_t Read64( const uint8_t* p )
+{
+    uint64_t value;
+    memcpy( &value, p, sizeof( value ) );
+    return value;
+}
+
+static inline uint32_t Read32( const uint8_t* p )
+{
+    uint32_t value;
+    memcpy( &value, p, sizeof( value ) );
+    return value;
+}
+
+static inline uint64_t Round( uint64_t accumulator, uint64_t input )
+{
+    accumulator += input * PRIME64_2;
+    accumulator = RotateLeft( accumulator, 31 );
+    return accumulator * PRIME64_1;
+}
+
+static inline uint64_t MergeRound( uint64_t accumulator, uint64_t value )
+{
+    accumulator ^= Round( 0, value );
+    return accumulator * PRIME64_1 + PRIME64_4;
+}
+
+ContentHash::ContentHash( uint64_t seed )
+    : m_Seed( seed )
+    , m_TotalSize( 0 )
+    , m_BufferSize( 0 )
+{
+    m_Accumulators[0] = seed + PRIME64_1 + PRIME64_2;
+    m_Accumulators[1] = seed + PRIME64_2;
+    m_Accumulators[2] = seed;
+    m_Accumulators[3] = seed - PRIME64_1;
+}
+
+void ContentHash::Update( const void* data, size_t size )
+{
+    const uint8_t* p = static_cast<const uint8_t*>( data );
+    const uint8_t* end = p + size;
+
+    m_TotalSize += size;
+
+    // Complete the stripe that was started by a previous update.
+    if ( m_BufferSize > 0 )
+    {
+        size_t count = std::min<size_t>( sizeof( m_Buffer ) - m_BufferSize, size );
+        memcpy( m_Buffer + m_BufferSize, p, count );
+        m_BufferSize += static_cast<uint32_t>( count );
+        p += count;
+
+        if ( m_BufferSize < sizeof( m_Buffer ) ) return;
+
+        for ( int i = 0; i < 4; ++i )
+        {
+            m_Accumulators[i] = Round( m_Accumulators[i], Read64( m_Buffer + i * 8 ) );
+        }
+        m_BufferSize = 0;
+    }
+
+    // Process complete stripes directly from the input.
+    uint64_t v1 = m_Accumulators[0];
+    uint64_t v2 = m_Accumulators[1];
+    uint64_t v3 = m_Accumulators[2];
+    uint64_t v4 = m_Accumulators[3];
+
+    while ( end - p >= 32 )
+    {
+        v1 = Round( v1, Read64( p ) );
+        v2 = Round( v2, Read64( p + 8 ) );
+        v3 = Round( v3, Read64( p + 16 ) );
+        v4 = Round( v4, Read64( p + 24 ) );
+        p += 32;
+    }
+
+    m_Accumulators[0] = v1;
+    m_Accumulators[1] = v2;
+    m_Accumulators[2] = v3;
+    m_Accumulators[3] = v4;
+
+    // Keep the remaining bytes for the next update.
+    if ( p < end )
+    {
+        m_BufferSize = static_cast<uint32_t>( end - p );
+        memcpy( m_Buffer, p, m_BufferSize );
+    }
+}
+
+void ContentHash::Update( const std::string& str )
+{
+    uint64_t length = str.size();
+    Update( &length, sizeof( length ) );
+    Update( str.data(), str.size() );
+}
+
+void ContentHash::Update( const std::wstring& str )
+{
+    uint64_t length = str.size();
+    Update( &length, sizeof( length ) );
+    Update( str.data(), str.size() * sizeof( wchar_t ) );
+}
+
+uint64_t ContentHash::GetHash() const
+{
+    uint64_t hash;
+
+    if ( m_TotalSize >= 32 )
+    {
+        const uint64_t* v = m_Accumulators;
+        hash = RotateLeft( v[0], 1 ) + RotateLeft( v[1], 7 ) + RotateLeft( v[2], 12 ) + RotateLeft( v[3], 18 );
+        hash = MergeRound( hash, v[0] );
+        hash = MergeRound( hash, v[1] );
+        hash = MergeRound( hash, v[2] );
+        hash = MergeRound( hash, v[3] );
+    }
+    else
+    {
+        hash = m_Seed + PRIME64_5;
+    }
+
+    hash += m_TotalSize;
+
+    // Process the remaining bytes.
+    const uint8_t* p = m_Buffer;
+    const uint8_t* end = m_Buffer + m_BufferSize;
+
+    while ( end - p >= 8 )
+    {
+        hash ^= Round( 0, Read64( p ) );
+        hash = RotateLeft( hash, 27 ) * PRIME64_1 + PRIME64_4;
+        p += 8;
+    }
+
+    if ( end - p >= 4 )
+    {
+        hash ^= static_cast<uint64_t>( Read32( p ) ) * PRIME64_1;
+        hash = RotateLeft( hash, 23 ) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+
+    while ( p < end )
+    {
+        hash ^= static_cast<uint64_t>( *p ) * PRIME64_5;
+        hash = RotateLeft( hash, 11 ) * PRIME64_1;
+        ++p;
+    }
+
+    // Final avalanche.
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+uint64_t ContentHash::Hash( const void* data, size_t size, uint64_t seed )
+{
+    ContentHash contentHash( seed );
+    contentHash.Update( data, size );
+    return contentHash.GetHash();
+}
@@ -1,9 +1,13 @@
 #include <EnginePCH.h>
 
+#include "StateCacheDX11.h"
+#include "StateObjectCacheDX11.h"
 #include "BlendStateDX11.h"
 
 BlendStateDX11::BlendStateDX11( ID3D11Device2* pDevice )
     : m_pDevice( pDevice )
+    , m_pStateCache( nullptr )
+    , m_pStateObjectCache( nullptr )
     , m_bAlphaToCoverageEnabled( false )
     , m_bIndependentBlendEnabled( false )
     , m_SampleMask( 0xffffffff )
@@ -13,6 +17,8 @@ BlendStateDX11::BlendStateDX11( ID3D11Device2* pDevice )
     if ( m_pDevice )
     {
         m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+        m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
+        m_pStateObjectCache = StateObjectCacheDX11::Get( m_pDevice.Get() );
     }
 
     m_BlendModes.resize( 8, BlendMode() );
@@ -21,6 +27,8 @@ BlendStateDX11::BlendStateDX11( ID3D11Device2* pDevice )
 BlendStateDX11::BlendStateDX11( const BlendStateDX11& copy )
     : m_pDevice( copy.m_pDevice )
     , m_pDeviceContext( copy.m_pDeviceContext )
+    , m_pStateCache( copy.m_pStateCache )
+    , m_pStateObjectCache( copy.m_pStateObjectCache )
     , m_BlendModes( copy.m_BlendModes )
     , m_bAlphaToCoverageEnabled( copy.m_bAlphaToCoverageEnabled )
     , m_bIndependentBlendEnabled( copy.m_bIndependentBlendEnabled )
@@ -300,38 +308,54 @@ D3D11_LOGIC_OP BlendStateDX11::TranslateLogicOperator( LogicOperator logicOp ) c
     return result;
 }
 
+D3D11_BLEND_DESC1 BlendStateDX11::GetBlendDesc() const
+{
+    // The description is compared bytewise by the state object cache.
+    D3D11_BLEND_DESC1 blendDesc;
+    ZeroMemory( &blendDesc, sizeof( blendDesc ) );
+
+    blendDesc.AlphaToCoverageEnable = m_bAlphaToCoverageEnabled;
+    blendDesc.IndependentBlendEnable = m_bIndependentBlendEnabled;
+    for ( unsigned int i = 0; i < 8 && i < m_BlendModes.size(); i++ )
+    {
+        D3D11_RENDER_TARGET_BLEND_DESC1& rtBlendDesc = blendDesc.RenderTarget[i];
+        const BlendMode& blendMode = m_BlendModes[i];
+
+        rtBlendDesc.BlendEnable = blendMode.BlendEnabled;
+        rtBlendDesc.LogicOpEnable = blendMode.LogicOpEnabled;
+        rtBlendDesc.SrcBlend = TranslateBlendFactor( blendMode.SrcFactor );
+        rtBlendDesc.DestBlend = TranslateBlendFactor( blendMode.DstFactor );
+        rtBlendDesc.BlendOp = TranslateBlendOp( blendMode.BlendOp );
+        rtBlendDesc.SrcBlendAlpha = TranslateBlendFactor( blendMode.SrcAlphaFactor );
+        rtBlendDesc.DestBlendAlpha = TranslateBlendFactor( blendMode.DstAlphaFactor );
+        rtBlendDesc.BlendOpAlpha = TranslateBlendOp( blendMode.AlphaOp );
+        rtBlendDesc.LogicOp = TranslateLogicOperator( blendMode.LogicOp );
+        rtBlendDesc.RenderTargetWriteMask = TranslateWriteMask( blendMode.WriteRed, blendMode.WriteGreen, blendMode.WriteBlue, blendMode.WriteAlpha );
+    }
+
+    return blendDesc;
+}
+
+bool BlendStateDX11::IsDirty() const
+{
+    return m_bDirty;
+}
+
+void BlendStateDX11::SetBlendStateObject( ID3D11BlendState1* pBlendState )
+{
+    m_pBlendState = pBlendState;
+    m_bDirty = false;
+}
+
 void BlendStateDX11::Bind()
 {
     if ( m_bDirty )
     {
-        // (Re)create the blend state object.
-        D3D11_BLEND_DESC1 blendDesc;
-
-        blendDesc.AlphaToCoverageEnable = m_bAlphaToCoverageEnabled;
-        blendDesc.IndependentBlendEnable = m_bIndependentBlendEnabled;
-        for ( unsigned int i = 0; i < 8 && i < m_BlendModes.size(); i++ )
-        {
-            D3D11_RENDER_TARGET_BLEND_DESC1& rtBlendDesc = blendDesc.RenderTarget[i];
-            BlendMode& blendMode = m_BlendModes[i];
-
-            rtBlendDesc.BlendEnable = blendMode.BlendEnabled;
-            rtBlendDesc.LogicOpEnable = blendMode.LogicOpEnabled;
-            rtBlendDesc.SrcBlend = TranslateBlendFactor( blendMode.SrcFactor );
-            rtBlendDesc.DestBlend = TranslateBlendFactor( blendMode.DstFactor );
-            rtBlendDesc.BlendOp = TranslateBlendOp( blendMode.BlendOp );
-            rtBlendDesc.SrcBlendAlpha = TranslateBlendFactor( blendMode.SrcAlphaFactor );
-            rtBlendDesc.DestBlendAlpha = TranslateBlendFactor( blendMode.DstAlphaFactor );
-            rtBlendDesc.BlendOpAlpha = TranslateBlendOp( blendMode.AlphaOp );
-            rtBlendDesc.LogicOp = TranslateLogicOperator( blendMode.LogicOp );
-            rtBlendDesc.RenderTargetWriteMask = TranslateWriteMask( blendMode.WriteRed, blendMode.WriteGreen, blendMode.WriteBlue, blendMode.WriteAlpha );
-        }
-
-        m_pDevice->CreateBlendState1( &blendDesc, &m_pBlendState );
-
-        m_bDirty = false;
+        // Blend states with the same description share the same blend state object.
+        D3D11_BLEND_DESC1 blendDesc = GetBlendDesc();
+        SetBlendStateObject( m_pStateObjectCache->GetBlendState( blendDesc ) );
     }
 
     // Now activate the blend state:
-    m_pDeviceContext->OMSetBlendState( m_pBlendState.Get(), glm::value_ptr( m_ConstBlendFactor ), m_SampleMask );
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetBlendState( m_pBlendState.Get(), glm::value_ptr( m_ConstBlendFactor ), m_SampleMask );
 }
-
@@ -2,6 +2,9 @@
 
 #include <BlendState.h>
 
+class StateCacheDX11;
+class StateObjectCacheDX11;
+
 class BlendStateDX11 : public BlendState
 {
 public:
@@ -66,6 +69,13 @@ public:
     // Can only be bound by the pipeline state.
     virtual void Bind();
 
+    // The description of the blend state object (used by the pipeline state to find its state objects).
+    D3D11_BLEND_DESC1 GetBlendDesc() const;
+    // Returns true if the blend state object must be looked up again.
+    bool IsDirty() const;
+    // Set the blend state object that was found for the current description.
+    void SetBlendStateObject( ID3D11BlendState1* pBlendState );
+
 protected:
 
     D3D11_BLEND TranslateBlendFactor( BlendState::BlendFactor blendFactor ) const;
@@ -76,6 +86,8 @@ protected:
 private:
     Microsoft::WRL::ComPtr< ID3D11Device2 > m_pDevice;
     Microsoft::WRL::ComPtr< ID3D11DeviceContext2 > m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
+    StateObjectCacheDX11* m_pStateObjectCache;
     Microsoft::WRL::ComPtr< ID3D11BlendState1 > m_pBlendState;
 
     typedef std::vector<BlendMode> BlendModeList;
@@ -89,6 +101,6 @@ private:
 
     glm::vec4 m_ConstBlendFactor;
 
-    // Set to true if we need to recreate the blend state object.
+    // Set to true if we need to look up the blend state object.
     bool m_bDirty;
 };
\ No newline at end of file
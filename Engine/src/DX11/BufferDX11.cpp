@@ -1,10 +1,12 @@
 #include <EnginePCH.h>
 
+#include "StateCacheDX11.h"
 #include "BufferDX11.h"
 
 BufferDX11::BufferDX11( ID3D11Device2* pDevice, UINT bindFlags, const void* data, size_t count, UINT stride )
     : m_pDevice( pDevice )
     , m_pDeviceContext( NULL )
+    , m_pStateCache( NULL )
     , m_pBuffer( NULL )
     , m_uiStride( stride )
     , m_BindFlags( bindFlags )
@@ -31,6 +33,7 @@ BufferDX11::BufferDX11( ID3D11Device2* pDevice, UINT bindFlags, const void* data
     }
 
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 }
 
 BufferDX11::~BufferDX11()
@@ -38,20 +41,18 @@ BufferDX11::~BufferDX11()
 
 bool BufferDX11::Bind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
-    assert( m_pDeviceContext );
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
 
-    ID3D11Buffer* buffers[] = { m_pBuffer.Get() };
-    UINT offsets[] = { 0 };
-    UINT strides[] = { m_uiStride };
+    assert( m_pDeviceContext );
 
     switch ( m_BindFlags )
     {
     case D3D11_BIND_VERTEX_BUFFER:
-        m_pDeviceContext->IASetVertexBuffers( id, 1, buffers, strides, offsets );
+        pStateCache->SetVertexBuffer( id, m_pBuffer.Get(), m_uiStride, 0 );
         m_bIsBound = true;
         break;
     case D3D11_BIND_INDEX_BUFFER:
-        m_pDeviceContext->IASetIndexBuffer( m_pBuffer.Get(), DXGI_FORMAT_R32_UINT, 0 );
+        pStateCache->SetIndexBuffer( m_pBuffer.Get(), ( m_uiStride == sizeof( uint16_t ) ) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, 0 );
         m_bIsBound = true;
         break;
     default:
@@ -65,16 +66,16 @@ bool BufferDX11::Bind( unsigned int id, Shader::ShaderType shaderType, ShaderPar
 
 void BufferDX11::UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
-    ID3D11Buffer* buffers[] = { nullptr };
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
 
     switch ( m_BindFlags )
     {
     case D3D11_BIND_VERTEX_BUFFER:
-        m_pDeviceContext->IASetVertexBuffers( id, 1, buffers, nullptr, nullptr );
+        pStateCache->SetVertexBuffer( id, nullptr, 0, 0 );
         m_bIsBound = true;
         break;
     case D3D11_BIND_INDEX_BUFFER:
-        m_pDeviceContext->IASetIndexBuffer(nullptr, DXGI_FORMAT_UNKNOWN, 0 );
+        pStateCache->SetIndexBuffer( nullptr, DXGI_FORMAT_UNKNOWN, 0 );
         m_bIsBound = true;
         break;
     default:
@@ -86,12 +87,14 @@ void BufferDX11::UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderP
 
 void BufferDX11::Copy( std::shared_ptr<Buffer> other )
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     std::shared_ptr<BufferDX11> srcBuffer = std::dynamic_pointer_cast<BufferDX11>( other );
 
     if ( srcBuffer && srcBuffer.get() != this &&
          m_uiCount * m_uiStride == srcBuffer->m_uiCount * srcBuffer->m_uiStride )
     {
-        m_pDeviceContext->CopyResource( m_pBuffer.Get(), srcBuffer->m_pBuffer.Get() );
+        pDeviceContext->CopyResource( m_pBuffer.Get(), srcBuffer->m_pBuffer.Get() );
     }
     else
     {
@@ -99,6 +102,21 @@ void BufferDX11::Copy( std::shared_ptr<Buffer> other )
     }
 }
 
+void BufferDX11::SetElements( const void* data, size_t firstElement, size_t count )
+{
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
+    if ( firstElement + count > m_uiCount )
+    {
+        ReportError( "Buffer is too small." );
+    }
+    if ( count == 0 ) return;
+
+    // Only update the part of the buffer that changed.
+    D3D11_BOX box = { (UINT)firstElement * m_uiStride, 0, 0, (UINT)( firstElement + count ) * m_uiStride, 1, 1 };
+    pDeviceContext->UpdateSubresource( m_pBuffer.Get(), 0, &box, data, 0, 0 );
+}
+
 Buffer::BufferType BufferDX11::GetType() const
 {
     switch ( m_BindFlags )
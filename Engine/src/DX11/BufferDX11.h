@@ -2,6 +2,8 @@
 
 #include <Buffer.h>
 
+class StateCacheDX11;
+
 class BufferDX11 : public Buffer
 {
 public:
@@ -16,6 +18,9 @@ public:
     // Buffers must be the same size (in bytes).
     virtual void Copy( std::shared_ptr<Buffer> other );
 
+    // Replace count elements of this buffer, starting at firstElement.
+    virtual void SetElements( const void* data, size_t firstElement, size_t count );
+
     // Is this an index buffer or an attribute/vertex buffer?
     virtual BufferType GetType() const;
     // How many elements does this buffer contain?
@@ -24,6 +29,7 @@ public:
 private:
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
     Microsoft::WRL::ComPtr<ID3D11Buffer> m_pBuffer;
 
     // The stride of the vertex buffer in bytes.
@@ -0,0 +1,63 @@
+#include <EnginePCH.h>
+
+#include "StateCacheDX11.h"
+#include "CommandListDX11.h"
+
+CommandListDX11::CommandListDX11( ID3D11Device2* pDevice )
+    : m_pDevice( pDevice )
+{
+    m_pDevice->GetImmediateContext2( &m_pImmediateContext );
+
+    if ( FAILED( m_pDevice->CreateDeferredContext2( 0, &m_pDeferredContext ) ) )
+    {
+        ReportError( "Failed to create deferred context." );
+    }
+
+    m_pStateCache.reset( new StateCacheDX11( m_pDeferredContext.Get() ) );
+}
+
+CommandListDX11::~CommandListDX11()
+{
+    m_pStateCache.reset();
+}
+
+void CommandListDX11::OnBegin()
+{
+    if ( m_pCommandList )
+    {
+        ReportError( "The command list is recorded again before it was executed." );
+    }
+
+    // FinishCommandList clears the state of the deferred context.
+    m_pStateCache->Reset();
+
+    StateCacheDX11::SetRecording( m_pStateCache.get() );
+}
+
+void CommandListDX11::OnEnd()
+{
+    StateCacheDX11::SetRecording( nullptr );
+
+    if ( FAILED( m_pDeferredContext->FinishCommandList( FALSE, &m_pCommandList ) ) )
+    {
+        ReportError( "Failed to finish command list." );
+    }
+}
+
+void CommandListDX11::Execute()
+{
+    if ( IsRecording() || !m_pCommandList )
+    {
+        ReportError( "The command list has not been recorded." );
+        return;
+    }
+
+    m_pImmediateContext->ExecuteCommandList( m_pCommandList.Get(), FALSE );
+    m_pCommandList.Reset();
+
+    // The state of the immediate context is cleared after the command list is executed.
+    StateCacheDX11* pStateCache = StateCacheDX11::Get( m_pImmediateContext.Get() );
+    pStateCache->Reset();
+    pStateCache->GetStatistics().Add( m_pStateCache->GetStatistics() );
+    m_pStateCache->GetStatistics().Reset();
+}
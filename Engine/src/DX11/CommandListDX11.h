@@ -0,0 +1,38 @@
+#pragma once
+
+#include <CommandList.h>
+
+class StateCacheDX11;
+
+/**
+ * Records commands into a deferred context of a DirectX 11 device.
+ * The deferred context has its own state cache. While the command list is
+ * recording, the resources that bind state or issue commands on the recording
+ * thread use the state cache (and the deferred context) of the command list.
+ * Executing the command list clears the state of the immediate context (and
+ * resets its state cache), which is cheaper than saving and restoring it.
+ */
+class CommandListDX11 : public CommandList
+{
+public:
+    typedef CommandList base;
+
+    CommandListDX11( ID3D11Device2* pDevice );
+    virtual ~CommandListDX11();
+
+    virtual void Execute();
+
+protected:
+    virtual void OnBegin();
+    virtual void OnEnd();
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pImmediateContext;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeferredContext;
+
+    std::unique_ptr<StateCacheDX11> m_pStateCache;
+
+    // The commands that were recorded since the command list was last executed.
+    Microsoft::WRL::ComPtr<ID3D11CommandList> m_pCommandList;
+};
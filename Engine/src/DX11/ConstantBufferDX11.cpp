@@ -1,5 +1,6 @@
 #include <EnginePCH.h>
 
+#include "StateCacheDX11.h"
 #include "ConstantBufferDX11.h"
 
 ConstantBufferDX11::ConstantBufferDX11( ID3D11Device2* pDevice, size_t size )
@@ -22,6 +23,7 @@ ConstantBufferDX11::ConstantBufferDX11( ID3D11Device2* pDevice, size_t size )
     }
 
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 }
 
 ConstantBufferDX11::~ConstantBufferDX11()
@@ -29,11 +31,13 @@ ConstantBufferDX11::~ConstantBufferDX11()
 
 void ConstantBufferDX11::Set( const void* data, size_t size )
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     assert( size == m_BufferSize );
 
     D3D11_MAPPED_SUBRESOURCE mappedResource;
 
-    if ( FAILED( m_pDeviceContext->Map( m_pBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource ) ) )
+    if ( FAILED( pDeviceContext->Map( m_pBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource ) ) )
     {
         ReportError( "Failed to map constant buffer." );
         return;
@@ -41,17 +45,19 @@ void ConstantBufferDX11::Set( const void* data, size_t size )
 
     memcpy( mappedResource.pData, data, m_BufferSize );
 
-    m_pDeviceContext->Unmap( m_pBuffer.Get(), 0 );
+    pDeviceContext->Unmap( m_pBuffer.Get(), 0 );
 }
 
 void ConstantBufferDX11::Copy( std::shared_ptr<ConstantBuffer> other )
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     std::shared_ptr<ConstantBufferDX11> srcBuffer = std::dynamic_pointer_cast<ConstantBufferDX11>( other );
 
     if ( srcBuffer && srcBuffer.get() != this &&
          m_BufferSize == srcBuffer->m_BufferSize )
     {
-        m_pDeviceContext->CopyResource( m_pBuffer.Get(), srcBuffer->m_pBuffer.Get() );
+        pDeviceContext->CopyResource( m_pBuffer.Get(), srcBuffer->m_pBuffer.Get() );
     }
     else
     {
@@ -66,63 +72,17 @@ void ConstantBufferDX11::Copy( std::shared_ptr<Buffer> other )
 
 bool ConstantBufferDX11::Bind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
-    bool result = true;
-
-    ID3D11Buffer* pBuffers[] = { m_pBuffer.Get() };
-
-    switch ( shaderType )
+    if ( shaderType == Shader::UnknownShaderType )
     {
-    case Shader::VertexShader:
-        m_pDeviceContext->VSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::TessellationControlShader:
-        m_pDeviceContext->HSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::TessellationEvaluationShader:
-        m_pDeviceContext->DSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::GeometryShader:
-        m_pDeviceContext->GSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::PixelShader:
-        m_pDeviceContext->PSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::ComputeShader:
-        m_pDeviceContext->CSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    default:
-        result = false;
-        break;
+        return false;
     }
 
-    return result;
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetConstantBuffer( shaderType, id, m_pBuffer.Get() );
+
+    return true;
 }
 
 void ConstantBufferDX11::UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
-    ID3D11Buffer* pBuffers[] = { nullptr };
-
-    switch ( shaderType )
-    {
-    case Shader::VertexShader:
-        m_pDeviceContext->VSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::TessellationControlShader:
-        m_pDeviceContext->HSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::TessellationEvaluationShader:
-        m_pDeviceContext->DSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::GeometryShader:
-        m_pDeviceContext->GSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::PixelShader:
-        m_pDeviceContext->PSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    case Shader::ComputeShader:
-        m_pDeviceContext->CSSetConstantBuffers( id, 1, pBuffers );
-        break;
-    default:
-        break;
-    }
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetConstantBuffer( shaderType, id, nullptr );
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <ConstantBuffer.h>
 
+class StateCacheDX11;
+
 class ConstantBufferDX11 : public ConstantBuffer
 {
 public:
@@ -20,6 +22,7 @@ protected:
 private:
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
     Microsoft::WRL::ComPtr<ID3D11Buffer> m_pBuffer;
 
     size_t  m_BufferSize;
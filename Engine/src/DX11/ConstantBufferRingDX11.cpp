@@ -0,0 +1,109 @@
+#include <EnginePCH.h>
+
+#include <Shader.h>
+
+#include "ShaderParameterDX11.h"
+#include "StateCacheDX11.h"
+#include "ConstantBufferRingDX11.h"
+
+ConstantBufferRingDX11::ConstantBufferRingDX11( ID3D11Device2* pDevice, uint32_t size )
+    : base( size )
+    , m_pDevice( pDevice )
+{
+    D3D11_BUFFER_DESC bufferDesc;
+    ZeroMemory( &bufferDesc, sizeof( D3D11_BUFFER_DESC ) );
+
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.ByteWidth = GetSize();
+    bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    bufferDesc.MiscFlags = 0;
+    bufferDesc.StructureByteStride = 0;
+
+    if ( FAILED( m_pDevice->CreateBuffer( &bufferDesc, nullptr, &m_pBuffer ) ) )
+    {
+        ReportError( "Failed to create constant buffer ring." );
+    }
+
+    D3D11_QUERY_DESC queryDesc;
+    queryDesc.Query = D3D11_QUERY_EVENT;
+    queryDesc.MiscFlags = 0;
+
+    for ( UINT i = 0; i < MaxFramesInFlight; ++i )
+    {
+        if ( FAILED( m_pDevice->CreateQuery( &queryDesc, &m_Fences[i] ) ) )
+        {
+            ReportError( "Failed to create fence for the constant buffer ring." );
+        }
+    }
+
+    m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
+}
+
+ConstantBufferRingDX11::~ConstantBufferRingDX11()
+{}
+
+bool ConstantBufferRingDX11::IsSupported( ID3D11Device2* pDevice )
+{
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options;
+    if ( FAILED( pDevice->CheckFeatureSupport( D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof( options ) ) ) )
+    {
+        return false;
+    }
+
+    return options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+}
+
+void ConstantBufferRingDX11::Write( uint32_t offset, const void* data, size_t size, bool discard )
+{
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+
+    // Writing with NO_OVERWRITE promises the driver that none of the data the GPU is using is overwritten.
+    if ( FAILED( m_pDeviceContext->Map( m_pBuffer.Get(), 0, discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mappedResource ) ) )
+    {
+        ReportError( "Failed to map constant buffer ring." );
+        return;
+    }
+
+    memcpy( (uint8_t*)mappedResource.pData + offset, data, size );
+
+    m_pDeviceContext->Unmap( m_pBuffer.Get(), 0 );
+}
+
+bool ConstantBufferRingDX11::Bind( const Allocation& allocation, const Shader& shader, const ShaderParameterID& id )
+{
+    ShaderParameterDX11& parameter = static_cast<ShaderParameterDX11&>( shader.GetShaderParameter( id ) );
+    if ( !parameter.IsValid() || !allocation.IsValid() )
+    {
+        return false;
+    }
+
+    // Offsets and sizes are specified in shader constants (16 bytes).
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetConstantBuffer( parameter.GetShaderType(), parameter.GetSlotID(), m_pBuffer.Get(), allocation.Offset / 16, allocation.Size / 16 );
+
+    return true;
+}
+
+void ConstantBufferRingDX11::InsertFence( uint64_t fence )
+{
+    m_pDeviceContext->End( m_Fences[fence % MaxFramesInFlight].Get() );
+}
+
+bool ConstantBufferRingDX11::IsFenceComplete( uint64_t fence )
+{
+    // Polling the query must not flush the command buffer (the frame is flushed by Present).
+    BOOL complete = FALSE;
+    return m_pDeviceContext->GetData( m_Fences[fence % MaxFramesInFlight].Get(), &complete, sizeof( complete ), D3D11_ASYNC_GETDATA_DONOTFLUSH ) == S_OK && complete;
+}
+
+void ConstantBufferRingDX11::WaitForFence( uint64_t fence )
+{
+    // DirectX 11 can't block on an event query. Without the DONOTFLUSH flag, the commands
+    // before the query are flushed to the GPU so the query is guaranteed to complete.
+    BOOL complete = FALSE;
+    while ( m_pDeviceContext->GetData( m_Fences[fence % MaxFramesInFlight].Get(), &complete, sizeof( complete ), 0 ) != S_OK || !complete )
+    {
+        std::this_thread::yield();
+    }
+}
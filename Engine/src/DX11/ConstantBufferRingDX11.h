@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ConstantBufferRing.h>
+
+class StateCacheDX11;
+
+/**
+ * The constant buffer ring of the DirectX 11 render device.
+ * Requires DirectX 11.1 support for constant buffer offsets (*SetConstantBuffers1)
+ * and for mapping dynamic constant buffers with D3D11_MAP_WRITE_NO_OVERWRITE.
+ */
+class ConstantBufferRingDX11 : public ConstantBufferRing
+{
+public:
+    typedef ConstantBufferRing base;
+
+    ConstantBufferRingDX11( ID3D11Device2* pDevice, uint32_t size );
+    virtual ~ConstantBufferRingDX11();
+
+    // Returns true if the device supports constant buffer offsets.
+    static bool IsSupported( ID3D11Device2* pDevice );
+
+    virtual bool Bind( const Allocation& allocation, const Shader& shader, const ShaderParameterID& id );
+
+protected:
+    virtual void Write( uint32_t offset, const void* data, size_t size, bool discard );
+
+    virtual void InsertFence( uint64_t fence );
+    virtual bool IsFenceComplete( uint64_t fence );
+    virtual void WaitForFence( uint64_t fence );
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_pBuffer;
+
+    // An event query per fence in flight.
+    Microsoft::WRL::ComPtr<ID3D11Query> m_Fences[MaxFramesInFlight];
+};
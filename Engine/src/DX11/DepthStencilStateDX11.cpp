@@ -1,5 +1,7 @@
 #include <EnginePCH.h>
 
+#include "StateCacheDX11.h"
+#include "StateObjectCacheDX11.h"
 #include "DepthStencilStateDX11.h"
 
 DepthStencilStateDX11::DepthStencilStateDX11( ID3D11Device2* pDevice )
@@ -8,11 +10,15 @@ DepthStencilStateDX11::DepthStencilStateDX11( ID3D11Device2* pDevice )
 {
     assert( pDevice );
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
+    m_pStateObjectCache = StateObjectCacheDX11::Get( m_pDevice.Get() );
 }
 
 DepthStencilStateDX11::DepthStencilStateDX11( const DepthStencilStateDX11& copy )
     : m_pDevice( copy.m_pDevice )
     , m_pDeviceContext( copy.m_pDeviceContext )
+    , m_pStateCache( copy.m_pStateCache )
+    , m_pStateObjectCache( copy.m_pStateObjectCache )
     , m_DepthMode( copy.m_DepthMode )
     , m_StencilMode( copy.m_StencilMode )
     , m_bDirty( true )
@@ -29,6 +35,8 @@ const DepthStencilStateDX11& DepthStencilStateDX11::operator=( const DepthStenci
     {
         m_pDevice = other.m_pDevice;
         m_pDeviceContext = other.m_pDeviceContext;
+        m_pStateCache = other.m_pStateCache;
+        m_pStateObjectCache = other.m_pStateObjectCache;
         m_DepthMode = other.m_DepthMode;
         m_StencilMode = other.m_StencilMode;
         m_bDirty = true;
@@ -169,7 +177,9 @@ D3D11_DEPTH_STENCILOP_DESC DepthStencilStateDX11::TranslateFaceOperation( FaceOp
 
 D3D11_DEPTH_STENCIL_DESC DepthStencilStateDX11::TranslateDepthStencilState( const DepthMode& depthMode, const StencilMode& stencilMode ) const
 {
+    // The description is compared bytewise by the state object cache.
     D3D11_DEPTH_STENCIL_DESC result;
+    ZeroMemory( &result, sizeof( result ) );
 
     result.DepthEnable = depthMode.DepthEnable;
     result.DepthWriteMask = TranslateDepthWriteMask( depthMode.DepthWriteMask );
@@ -183,19 +193,30 @@ D3D11_DEPTH_STENCIL_DESC DepthStencilStateDX11::TranslateDepthStencilState( cons
     return result;
 }
 
+D3D11_DEPTH_STENCIL_DESC DepthStencilStateDX11::GetDepthStencilDesc() const
+{
+    return TranslateDepthStencilState( m_DepthMode, m_StencilMode );
+}
+
+bool DepthStencilStateDX11::IsDirty() const
+{
+    return m_bDirty;
+}
+
+void DepthStencilStateDX11::SetDepthStencilStateObject( ID3D11DepthStencilState* pDepthStencilState )
+{
+    m_pDepthStencilState = pDepthStencilState;
+    m_bDirty = false;
+}
+
 void DepthStencilStateDX11::Bind()
 {
     if ( m_bDirty )
     {
-        D3D11_DEPTH_STENCIL_DESC depthStencilDesc = TranslateDepthStencilState( m_DepthMode, m_StencilMode );
-
-        if ( FAILED( m_pDevice->CreateDepthStencilState( &depthStencilDesc, &m_pDepthStencilState ) ) )
-        {
-            ReportError( "Failed to create depth stencil state." );
-        }
-
-        m_bDirty = false;
+        // Depth-stencil states with the same description share the same depth-stencil state object.
+        D3D11_DEPTH_STENCIL_DESC depthStencilDesc = GetDepthStencilDesc();
+        SetDepthStencilStateObject( m_pStateObjectCache->GetDepthStencilState( depthStencilDesc ) );
     }
 
-    m_pDeviceContext->OMSetDepthStencilState( m_pDepthStencilState.Get(), m_StencilMode.StencilReference );
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetDepthStencilState( m_pDepthStencilState.Get(), m_StencilMode.StencilReference );
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include <DepthStencilState.h>
 
+class StateCacheDX11;
+class StateObjectCacheDX11;
+
 class DepthStencilStateDX11 : public DepthStencilState
 {
 public:
@@ -20,6 +23,13 @@ public:
 
     // Can only be called by the pipeline state.
     void Bind();
+
+    // The description of the depth-stencil state object (used by the pipeline state to find its state objects).
+    D3D11_DEPTH_STENCIL_DESC GetDepthStencilDesc() const;
+    // Returns true if the depth-stencil state object must be looked up again.
+    bool IsDirty() const;
+    // Set the depth-stencil state object that was found for the current description.
+    void SetDepthStencilStateObject( ID3D11DepthStencilState* pDepthStencilState );
 protected:
     
     D3D11_DEPTH_WRITE_MASK TranslateDepthWriteMask( DepthWrite depthWrite ) const;
@@ -31,6 +41,8 @@ protected:
 private:
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
+    StateObjectCacheDX11* m_pStateObjectCache;
     Microsoft::WRL::ComPtr<ID3D11DepthStencilState> m_pDepthStencilState;
 
     DepthMode m_DepthMode;
@@ -5,11 +5,24 @@
 #include <Visitor.h>
 
 #include "BufferDX11.h"
+#include "ConstantBufferDX11.h"
 #include "ShaderDX11.h"
 #include "PipelineStateDX11.h"
+#include "StateCacheDX11.h"
 
 #include "MeshDX11.h"
 
+static const ShaderParameterID gs_QuantizedMeshID( "QuantizedMesh" );
+
+// The layout must match the QuantizedMesh constant buffer in CommonInclude.hlsl.
+struct QuantizationParameters
+{
+    glm::vec3 BoundsMin;
+    float Padding0;
+    glm::vec3 BoundsSize;
+    float Padding1;
+};
+
 MeshDX11::MeshDX11( ID3D11Device2* pDevice )
 	: m_pDevice( pDevice )
 	, m_pIndexBuffer( nullptr )
@@ -17,6 +30,7 @@ MeshDX11::MeshDX11( ID3D11Device2* pDevice )
     , m_pDeviceContext( nullptr )
 {
 	m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 }
 
 MeshDX11::~MeshDX11()
@@ -32,6 +46,54 @@ void MeshDX11::SetIndexBuffer( std::shared_ptr<Buffer> buffer )
     m_pIndexBuffer = buffer;
 }
 
+void MeshDX11::SetQuantizedVertexBuffer( std::shared_ptr<Buffer> buffer, const BoundingBox& quantizationBounds )
+{
+    m_pQuantizedVertexBuffer = buffer;
+
+    QuantizationParameters parameters = {};
+    parameters.BoundsMin = quantizationBounds.GetMin();
+    parameters.BoundsSize = quantizationBounds.GetMax() - quantizationBounds.GetMin();
+
+    if ( !m_pQuantizationParameters )
+    {
+        m_pQuantizationParameters = std::make_shared<ConstantBufferDX11>( m_pDevice.Get(), sizeof( QuantizationParameters ) );
+    }
+    m_pQuantizationParameters->Set( parameters );
+}
+
+void MeshDX11::AddLod( uint32_t firstIndex, uint32_t numIndices, float error )
+{
+    Lod lod = { firstIndex, numIndices, error };
+    m_Lods.push_back( lod );
+}
+
+uint32_t MeshDX11::GetNumLods() const
+{
+    return std::max<uint32_t>( static_cast<uint32_t>( m_Lods.size() ), 1 );
+}
+
+float MeshDX11::GetLodError( uint32_t lod ) const
+{
+    return ( lod < m_Lods.size() ) ? m_Lods[lod].Error : 0.0f;
+}
+
+uint32_t MeshDX11::GetNumTriangles( uint32_t lod ) const
+{
+    if ( lod < m_Lods.size() )
+    {
+        return m_Lods[lod].NumIndices / 3;
+    }
+    if ( m_pIndexBuffer )
+    {
+        return m_pIndexBuffer->GetElementCount() / 3;
+    }
+    if ( m_pQuantizedVertexBuffer )
+    {
+        return m_pQuantizedVertexBuffer->GetElementCount() / 3;
+    }
+    return m_VertexBuffers.empty() ? 0 : m_VertexBuffers.begin()->second->GetElementCount() / 3;
+}
+
 void MeshDX11::SetMaterial( std::shared_ptr<Material> material )
 {
     m_pMaterial = material;
@@ -42,21 +104,71 @@ std::shared_ptr<Material> MeshDX11::GetMaterial() const
     return m_pMaterial;
 }
 
+void MeshDX11::SetBoundingBox( const BoundingBox& boundingBox )
+{
+    m_BoundingBox = boundingBox;
+}
+
+const BoundingBox& MeshDX11::GetBoundingBox() const
+{
+    return m_BoundingBox;
+}
+
+void MeshDX11::SetOccluderGeometry( std::shared_ptr<const OccluderGeometry> occluderGeometry )
+{
+    m_pOccluderGeometry = occluderGeometry;
+}
+
+std::shared_ptr<const OccluderGeometry> MeshDX11::GetOccluderGeometry() const
+{
+    return m_pOccluderGeometry;
+}
+
+void MeshDX11::SetMeshletGeometry( std::shared_ptr<const MeshletGeometry> meshletGeometry )
+{
+    m_pMeshletGeometry = meshletGeometry;
+}
+
+std::shared_ptr<const MeshletGeometry> MeshDX11::GetMeshletGeometry() const
+{
+    return m_pMeshletGeometry;
+}
+
 void MeshDX11::Render( RenderEventArgs& renderArgs )
 {
-    std::shared_ptr<ShaderDX11> pVS;
+    BindBuffers( renderArgs );
+    BindMaterial( renderArgs );
+    Draw( renderArgs );
 
-    // Clone this mesh's material in case we want to override the 
-    // shaders in the mesh's default material.
-    //Material material( *m_pMaterial );
+	if ( m_pIndexBuffer != NULL )
+	{
+		m_pIndexBuffer->UnBind( 0, Shader::VertexShader, ShaderParameter::Type::Buffer );
+	}
+}
 
+void MeshDX11::BindBuffers( RenderEventArgs& renderArgs )
+{
     // Use the vertex shader to convert the buffer semantics to slot ID's
     PipelineState* pipeline = renderArgs.PipelineState;
     if ( pipeline )
     {
-        pVS = std::dynamic_pointer_cast<ShaderDX11>( pipeline->GetShader( Shader::VertexShader ) );
+        std::shared_ptr<ShaderDX11> pVS = std::dynamic_pointer_cast<ShaderDX11>( pipeline->GetShader( Shader::VertexShader ) );
+
+        if ( pVS && pVS->HasInterleavedVertices() )
+        {
+            if ( m_pQuantizedVertexBuffer )
+            {
+                // All of the vertex attributes are read from slot 0.
+                m_pQuantizedVertexBuffer->Bind( 0, Shader::VertexShader, ShaderParameter::Type::Buffer );
 
-        if ( pVS )
+                ShaderParameter& quantizationParameter = pVS->GetShaderParameter( gs_QuantizedMeshID );
+                if ( quantizationParameter.IsValid() )
+                {
+                    quantizationParameter.BindResource<ConstantBuffer>( m_pQuantizationParameters );
+                }
+            }
+        }
+        else if ( pVS )
         {
             for ( BufferMap::value_type buffer : m_VertexBuffers )
             {
@@ -69,49 +181,80 @@ void MeshDX11::Render( RenderEventArgs& renderArgs )
                 }
             }
         }
+    }
 
-        if ( m_pMaterial )
+	if ( m_pIndexBuffer != NULL )
+	{
+        // Meshes are drawn as triangle lists, which don't use a strip cut (primitive restart) index.
+		m_pIndexBuffer->Bind( 0, Shader::VertexShader, ShaderParameter::Type::Buffer );
+	}
+}
+
+void MeshDX11::BindMaterial( RenderEventArgs& renderArgs )
+{
+    PipelineState* pipeline = renderArgs.PipelineState;
+    if ( pipeline && m_pMaterial )
+    {
+        for ( auto shader : pipeline->GetShaders() )
         {
-            for ( auto shader : pipeline->GetShaders() )
-            {
-                m_pMaterial->Bind( shader.second );
-            }
+            m_pMaterial->Bind( shader.second );
         }
     }
+}
+
+void MeshDX11::Draw( RenderEventArgs& renderArgs, uint32_t instanceCount, uint32_t lod )
+{
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
+    ID3D11DeviceContext2* pDeviceContext = pStateCache->GetDeviceContext();
 
 	// TODO: The primitive topology should be a parameter.
     // Or we have to have index buffers/vertex buffers for each primitive type...
-	m_pDeviceContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+	pStateCache->SetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
 
 	if ( m_pIndexBuffer != NULL )
 	{
-        // TOOD: Primitive reset?
-		m_pIndexBuffer->Bind( 0, Shader::VertexShader, ShaderParameter::Type::Buffer );
-		m_pDeviceContext->DrawIndexed( m_pIndexBuffer->GetElementCount(), 0, 0 );
-		m_pIndexBuffer->UnBind( 0, Shader::VertexShader, ShaderParameter::Type::Buffer );
+        // Without levels of detail, the whole index buffer is drawn.
+        UINT startIndex = 0;
+        UINT indexCount = m_pIndexBuffer->GetElementCount();
+        if ( !m_Lods.empty() )
+        {
+            const Lod& drawLod = m_Lods[std::min<size_t>( lod, m_Lods.size() - 1 )];
+            startIndex = drawLod.FirstIndex;
+            indexCount = drawLod.NumIndices;
+        }
+
+        if ( instanceCount > 1 )
+        {
+            pDeviceContext->DrawIndexedInstanced( indexCount, instanceCount, startIndex, 0, 0 );
+        }
+        else
+        {
+            pDeviceContext->DrawIndexed( indexCount, startIndex, 0 );
+        }
 	}
 	else
 	{
 		// We assume we have at least one vertex buffer.
 		// If not, then why are we rendering this mesh?
-		UINT vertexCount = (*m_VertexBuffers.begin()).second->GetElementCount();
-		m_pDeviceContext->Draw( vertexCount, 0 );
-	}
-
-    if ( pVS )
-    {
-        for ( BufferMap::value_type buffer : m_VertexBuffers )
+		UINT vertexCount = m_pQuantizedVertexBuffer ? m_pQuantizedVertexBuffer->GetElementCount() : (*m_VertexBuffers.begin()).second->GetElementCount();
+        if ( instanceCount > 1 )
         {
-            BufferBinding binding = buffer.first;
-            if ( pVS->HasSemantic( binding ) )
-            {
-                UINT slotID = pVS->GetSlotIDBySemantic( binding );
-                // Bind the vertex buffer to a particular slot ID.
-                buffer.second->Bind( slotID, Shader::VertexShader, ShaderParameter::Type::Buffer );
-            }
+            pDeviceContext->DrawInstanced( vertexCount, instanceCount, 0, 0 );
         }
-    }
+        else
+        {
+            pDeviceContext->Draw( vertexCount, 0 );
+        }
+	}
+}
+
+void MeshDX11::DrawIndexRange( RenderEventArgs& renderArgs, uint32_t firstIndex, uint32_t numIndices )
+{
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
+    ID3D11DeviceContext2* pDeviceContext = pStateCache->GetDeviceContext();
 
+    pStateCache->SetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+    pDeviceContext->DrawIndexed( numIndices, firstIndex, 0 );
 }
 
 void MeshDX11::Accept( Visitor& visitor )
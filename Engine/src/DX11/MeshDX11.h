@@ -2,6 +2,9 @@
 
 #include <Mesh.h>
 
+class ConstantBuffer;
+class StateCacheDX11;
+
 class MeshDX11 : public Mesh
 {
 public:
@@ -10,21 +13,60 @@ public:
 
 	virtual void AddVertexBuffer( const BufferBinding& binding, std::shared_ptr<Buffer> buffer );
     virtual void SetIndexBuffer( std::shared_ptr<Buffer> buffer );
+    virtual void SetQuantizedVertexBuffer( std::shared_ptr<Buffer> buffer, const BoundingBox& quantizationBounds );
+
+    virtual void AddLod( uint32_t firstIndex, uint32_t numIndices, float error );
+    virtual uint32_t GetNumLods() const;
+    virtual float GetLodError( uint32_t lod ) const;
+    virtual uint32_t GetNumTriangles( uint32_t lod = 0 ) const;
 
     virtual void SetMaterial( std::shared_ptr<Material> material );
     virtual std::shared_ptr<Material> GetMaterial() const;
 
+    virtual void SetBoundingBox( const BoundingBox& boundingBox );
+    virtual const BoundingBox& GetBoundingBox() const;
+
+    virtual void SetOccluderGeometry( std::shared_ptr<const OccluderGeometry> occluderGeometry );
+    virtual std::shared_ptr<const OccluderGeometry> GetOccluderGeometry() const;
+
+    virtual void SetMeshletGeometry( std::shared_ptr<const MeshletGeometry> meshletGeometry );
+    virtual std::shared_ptr<const MeshletGeometry> GetMeshletGeometry() const;
+
 	virtual void Render( RenderEventArgs& renderArgs );
 
+    virtual void BindBuffers( RenderEventArgs& renderArgs );
+    virtual void BindMaterial( RenderEventArgs& renderArgs );
+    virtual void Draw( RenderEventArgs& renderArgs, uint32_t instanceCount = 1, uint32_t lod = 0 );
+    virtual void DrawIndexRange( RenderEventArgs& renderArgs, uint32_t firstIndex, uint32_t numIndices );
+
     virtual void Accept( Visitor& visitor );
 
 private:
 	typedef std::map<BufferBinding, std::shared_ptr<Buffer> > BufferMap;
 	BufferMap m_VertexBuffers;
 
+    // All vertex attributes interleaved in the quantized vertex format.
+    std::shared_ptr<Buffer> m_pQuantizedVertexBuffer;
+    // Used by the vertex shader to restore the positions of the quantized vertices.
+    std::shared_ptr<ConstantBuffer> m_pQuantizationParameters;
+
     std::shared_ptr<Buffer> m_pIndexBuffer;
     std::shared_ptr<Material> m_pMaterial;
 
+    struct Lod
+    {
+        uint32_t FirstIndex;
+        uint32_t NumIndices;
+        float Error;
+    };
+    typedef std::vector<Lod> LodList;
+    LodList m_Lods;
+
+    BoundingBox m_BoundingBox;
+    std::shared_ptr<const OccluderGeometry> m_pOccluderGeometry;
+    std::shared_ptr<const MeshletGeometry> m_pMeshletGeometry;
+
 	Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
 	Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
 };
\ No newline at end of file
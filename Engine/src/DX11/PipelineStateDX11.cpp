@@ -1,5 +1,6 @@
 #include <EnginePCH.h>
 
+#include "StateObjectCacheDX11.h"
 #include "PipelineStateDX11.h"
 
 PipelineStateDX11::PipelineStateDX11( ID3D11Device2* pDevice )
@@ -9,6 +10,7 @@ PipelineStateDX11::PipelineStateDX11( ID3D11Device2* pDevice )
     , m_DepthStencilState( pDevice )
 {
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateObjectCache = StateObjectCacheDX11::Get( m_pDevice.Get() );
 }
 
 PipelineStateDX11::~PipelineStateDX11()
@@ -77,6 +79,23 @@ std::shared_ptr<RenderTarget> PipelineStateDX11::GetRenderTarget() const
     return m_RenderTarget;
 }
 
+void PipelineStateDX11::UpdateStateObjects()
+{
+    // The description is compared bytewise by the state object cache.
+    PipelineDescDX11 pipelineDesc;
+    ZeroMemory( &pipelineDesc, sizeof( pipelineDesc ) );
+
+    pipelineDesc.BlendDesc = m_BlendState.GetBlendDesc();
+    pipelineDesc.RasterizerDesc = m_RasterizerState.GetRasterizerDesc();
+    pipelineDesc.DepthStencilDesc = m_DepthStencilState.GetDepthStencilDesc();
+
+    const PipelineObjectDX11& pipeline = m_pStateObjectCache->GetPipeline( pipelineDesc );
+
+    m_BlendState.SetBlendStateObject( pipeline.BlendState.Get() );
+    m_RasterizerState.SetRasterizerStateObject( pipeline.RasterizerState.Get() );
+    m_DepthStencilState.SetDepthStencilStateObject( pipeline.DepthStencilState.Get() );
+}
+
 void PipelineStateDX11::Bind()
 {
     if ( m_RenderTarget )
@@ -84,6 +103,11 @@ void PipelineStateDX11::Bind()
         m_RenderTarget->Bind();
     }
 
+    if ( m_BlendState.IsDirty() || m_RasterizerState.IsDirty() || m_DepthStencilState.IsDirty() )
+    {
+        UpdateStateObjects();
+    }
+
     m_BlendState.Bind();
     m_RasterizerState.Bind();
     m_DepthStencilState.Bind();
@@ -6,6 +6,8 @@
 #include "RasterizerStateDX11.h"
 #include "DepthStencilStateDX11.h"
 
+class StateObjectCacheDX11;
+
 class PipelineStateDX11 : public PipelineState
 {
 public:
@@ -31,10 +33,13 @@ public:
     virtual void Bind();
     virtual void UnBind();
 protected:
+    // Look up the state objects of the pipeline description in the state object cache.
+    void UpdateStateObjects();
 
 private:
     Microsoft::WRL::ComPtr< ID3D11Device2 > m_pDevice;
     Microsoft::WRL::ComPtr< ID3D11DeviceContext2> m_pDeviceContext;
+    StateObjectCacheDX11* m_pStateObjectCache;
 
     ShaderMap m_Shaders;
 
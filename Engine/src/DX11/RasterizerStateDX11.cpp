@@ -1,5 +1,7 @@
 #include <EnginePCH.h>
 
+#include "StateCacheDX11.h"
+#include "StateObjectCacheDX11.h"
 #include "RasterizerStateDX11.h"
 
 RasterizerStateDX11::RasterizerStateDX11( ID3D11Device2* pDevice )
@@ -22,6 +24,8 @@ RasterizerStateDX11::RasterizerStateDX11( ID3D11Device2* pDevice )
     , m_ScissorRectsDirty( true )
 {
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
+    m_pStateObjectCache = StateObjectCacheDX11::Get( m_pDevice.Get() );
 
     m_Viewports.resize( 8, Viewport() );
     m_ScissorRects.resize( 8, Rect() );
@@ -30,6 +34,8 @@ RasterizerStateDX11::RasterizerStateDX11( ID3D11Device2* pDevice )
 RasterizerStateDX11::RasterizerStateDX11( const RasterizerStateDX11& copy )
     : m_pDevice( copy.m_pDevice )
     , m_pDeviceContext( copy.m_pDeviceContext )
+    , m_pStateCache( copy.m_pStateCache )
+    , m_pStateObjectCache( copy.m_pStateObjectCache )
     , m_d3dRects( copy.m_d3dRects )
     , m_d3dViewports( copy.m_d3dViewports )
     , m_FrontFaceFillMode( copy.m_FrontFaceFillMode )
@@ -349,30 +355,45 @@ std::vector<D3D11_VIEWPORT> RasterizerStateDX11::TranslateViewports( const std::
 }
 
 // Can only be invoked by the pipeline state
+D3D11_RASTERIZER_DESC1 RasterizerStateDX11::GetRasterizerDesc() const
+{
+    // The description is compared bytewise by the state object cache.
+    D3D11_RASTERIZER_DESC1 rasterizerDesc;
+    ZeroMemory( &rasterizerDesc, sizeof( rasterizerDesc ) );
+
+    rasterizerDesc.FillMode = TranslateFillMode( m_FrontFaceFillMode );
+    rasterizerDesc.CullMode = TranslateCullMode( m_CullMode );
+    rasterizerDesc.FrontCounterClockwise = TranslateFrontFace( m_FrontFace );
+    rasterizerDesc.DepthBias = ( m_DepthBias < 0.0f ) ? static_cast<INT>( m_DepthBias - 0.5f ) : static_cast<INT>( m_DepthBias + 0.5f );
+    rasterizerDesc.DepthBiasClamp = m_BiasClamp;
+    rasterizerDesc.SlopeScaledDepthBias = m_SlopeBias;
+    rasterizerDesc.DepthClipEnable = m_DepthClipEnabled;
+    rasterizerDesc.ScissorEnable = m_ScissorEnabled;
+    rasterizerDesc.MultisampleEnable = m_MultisampleEnabled;
+    rasterizerDesc.AntialiasedLineEnable = m_AntialiasedLineEnabled;
+    rasterizerDesc.ForcedSampleCount = m_ForcedSampleCount;
+
+    return rasterizerDesc;
+}
+
+bool RasterizerStateDX11::IsDirty() const
+{
+    return m_StateDirty;
+}
+
+void RasterizerStateDX11::SetRasterizerStateObject( ID3D11RasterizerState1* pRasterizerState )
+{
+    m_pRasterizerState = pRasterizerState;
+    m_StateDirty = false;
+}
+
 void RasterizerStateDX11::Bind()
 {
     if ( m_StateDirty )
     {
-        D3D11_RASTERIZER_DESC1 rasterizerDesc = {};
-
-        rasterizerDesc.FillMode = TranslateFillMode( m_FrontFaceFillMode );
-        rasterizerDesc.CullMode = TranslateCullMode( m_CullMode );
-        rasterizerDesc.FrontCounterClockwise = TranslateFrontFace( m_FrontFace );
-        rasterizerDesc.DepthBias = ( m_DepthBias < 0.0f ) ? static_cast<INT>( m_DepthBias - 0.5f ) : static_cast<INT>( m_DepthBias + 0.5f );
-        rasterizerDesc.DepthBiasClamp = m_BiasClamp;
-        rasterizerDesc.SlopeScaledDepthBias = m_SlopeBias;
-        rasterizerDesc.DepthClipEnable = m_DepthClipEnabled;
-        rasterizerDesc.ScissorEnable = m_ScissorEnabled;
-        rasterizerDesc.MultisampleEnable = m_MultisampleEnabled;
-        rasterizerDesc.AntialiasedLineEnable = m_AntialiasedLineEnabled;
-        rasterizerDesc.ForcedSampleCount = m_ForcedSampleCount;
-
-        if ( FAILED( m_pDevice->CreateRasterizerState1( &rasterizerDesc, &m_pRasterizerState ) ) )
-        {
-            ReportError( "Failed to create rasterizer state." );
-        }
-
-        m_StateDirty = false;
+        // Rasterizer states with the same description share the same rasterizer state object.
+        D3D11_RASTERIZER_DESC1 rasterizerDesc = GetRasterizerDesc();
+        SetRasterizerStateObject( m_pStateObjectCache->GetRasterizerState( rasterizerDesc ) );
     }
 
     if ( m_ScissorRectsDirty )
@@ -387,7 +408,8 @@ void RasterizerStateDX11::Bind()
         m_ViewportsDirty = false;
     }
 
-    m_pDeviceContext->RSSetViewports( (UINT)m_d3dViewports.size(), m_d3dViewports.data() );
-    m_pDeviceContext->RSSetScissorRects( (UINT)m_d3dRects.size(), m_d3dRects.data() );
-    m_pDeviceContext->RSSetState( m_pRasterizerState.Get() );
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
+    pStateCache->SetViewports( (UINT)m_d3dViewports.size(), m_d3dViewports.data() );
+    pStateCache->SetScissorRects( (UINT)m_d3dRects.size(), m_d3dRects.data() );
+    pStateCache->SetRasterizerState( m_pRasterizerState.Get() );
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 
 #include <RasterizerState.h>
 
+class StateCacheDX11;
+class StateObjectCacheDX11;
+
 class RasterizerStateDX11 : public RasterizerState
 {
 public:
@@ -55,6 +58,13 @@ public:
 
     // Can only be invoked by the pipeline state
     virtual void Bind();
+
+    // The description of the rasterizer state object (used by the pipeline state to find its state objects).
+    D3D11_RASTERIZER_DESC1 GetRasterizerDesc() const;
+    // Returns true if the rasterizer state object must be looked up again.
+    bool IsDirty() const;
+    // Set the rasterizer state object that was found for the current description.
+    void SetRasterizerStateObject( ID3D11RasterizerState1* pRasterizerState );
 protected:
     
     D3D11_FILL_MODE TranslateFillMode( FillMode fillMode ) const;
@@ -67,6 +77,8 @@ protected:
 private:
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
+    StateObjectCacheDX11* m_pStateObjectCache;
     Microsoft::WRL::ComPtr<ID3D11RasterizerState1> m_pRasterizerState;
 
     std::vector<D3D11_RECT> m_d3dRects;
@@ -99,7 +111,7 @@ private:
     typedef std::vector<Viewport> ViewportList;
     ViewportList m_Viewports;
 
-    // Set to true when the rasterizer state needs to be recreated.
+    // Set to true when the rasterizer state object needs to be looked up.
     bool m_StateDirty;
     bool m_ViewportsDirty;
     bool m_ScissorRectsDirty;
@@ -4,6 +4,8 @@
 
 #include <Application.h>
 #include <Material.h>
+#include <JobSystem.h>
+#include <HighResolutionTimer.h>
 
 #include "BufferDX11.h"
 #include "ConstantBufferDX11.h"
@@ -16,9 +18,16 @@
 #include "SamplerStateDX11.h"
 #include "PipelineStateDX11.h"
 #include "QueryDX11.h"
+#include "CommandListDX11.h"
+#include "StateCacheDX11.h"
+#include "StateObjectCacheDX11.h"
+#include "ConstantBufferRingDX11.h"
 
 #include "RenderDeviceDX11.h"
 
+// The size of the constant buffer ring in bytes.
+#define CONSTANT_BUFFER_RING_SIZE ( 16 * 1024 * 1024 )
+
 using Microsoft::WRL::ComPtr;
 
 RenderDeviceDX11::RenderDeviceDX11( Application& app )
@@ -35,15 +44,28 @@ RenderDeviceDX11::~RenderDeviceDX11()
 {
     TwTerminate();
 
-    m_Materials.clear();
-    m_Scenes.clear();
-    m_Meshes.clear();
-    m_Buffers.clear();
-    m_Shaders.clear();
-    m_Textures.clear();
-    m_Samplers.clear();
-    m_Pipelines.clear();
-    m_Queries.clear();
+    m_Materials.Clear();
+    m_Scenes.Clear();
+    m_Meshes.Clear();
+    m_Buffers.Clear();
+    m_Shaders.Clear();
+    m_Textures.Clear();
+    m_Samplers.Clear();
+    m_Pipelines.Clear();
+    m_Queries.Clear();
+    m_CommandLists.Clear();
+
+    if ( m_pConstantBufferRing )
+    {
+        m_pConstantBufferRing->Report( m_DeviceName );
+        m_pConstantBufferRing.reset();
+    }
+
+    m_pStateCache->GetTotalStatistics().Report( m_DeviceName );
+    m_pStateCache.reset();
+
+    m_pStateObjectCache->Report( m_DeviceName );
+    m_pStateObjectCache.reset();
 
 #if defined(_DEBUG)
     if ( m_pDebugLayer )
@@ -98,6 +120,15 @@ void RenderDeviceDX11::CreateDevice( HINSTANCE hInstance )
     // Now get the immediate device context.
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
 
+    // The state cache must exist before any resources are created.
+    m_pStateCache.reset( new StateCacheDX11( m_pDeviceContext.Get() ) );
+    m_pStateObjectCache.reset( new StateObjectCacheDX11( m_pDevice.Get() ) );
+
+    if ( ConstantBufferRingDX11::IsSupported( m_pDevice.Get() ) )
+    {
+        m_pConstantBufferRing.reset( new ConstantBufferRingDX11( m_pDevice.Get(), CONSTANT_BUFFER_RING_SIZE ) );
+    }
+
     if ( SUCCEEDED( m_pDevice.Get()->QueryInterface<ID3D11Debug>( &m_pDebugLayer ) ) )
     {
         ComPtr<ID3D11InfoQueue> d3dInfoQueue;
@@ -161,11 +192,26 @@ Microsoft::WRL::ComPtr<ID3D11DeviceContext2> RenderDeviceDX11::GetDeviceContext(
     return m_pDeviceContext;
 }
 
+StateCacheDX11& RenderDeviceDX11::GetStateCache() const
+{
+    return *m_pStateCache;
+}
+
+ConstantBufferRing* RenderDeviceDX11::GetConstantBufferRing()
+{
+    return m_pConstantBufferRing.get();
+}
+
+const StateCacheStatistics* RenderDeviceDX11::GetStateCacheStatistics() const
+{
+    return &m_pStateCache->GetFrameStatistics();
+}
+
 
 std::shared_ptr<Buffer> RenderDeviceDX11::CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride )
 {
     std::shared_ptr<Buffer> buffer = std::make_shared<BufferDX11>( m_pDevice.Get(), D3D11_BIND_VERTEX_BUFFER, data, count, stride );
-    m_Buffers.push_back( buffer );
+    m_Buffers.Add( buffer );
 
     return buffer;
 }
@@ -173,7 +219,23 @@ std::shared_ptr<Buffer> RenderDeviceDX11::CreateFloatVertexBuffer( const float*
 std::shared_ptr <Buffer> RenderDeviceDX11::CreateDoubleVertexBuffer( const double* data, unsigned int count, unsigned int stride )
 {
     std::shared_ptr<Buffer> buffer = std::make_shared<BufferDX11>( m_pDevice.Get(), D3D11_BIND_VERTEX_BUFFER, data, count, stride );
-    m_Buffers.push_back( buffer );
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+std::shared_ptr<Buffer> RenderDeviceDX11::CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride )
+{
+    std::shared_ptr<Buffer> buffer = std::make_shared<BufferDX11>( m_pDevice.Get(), D3D11_BIND_VERTEX_BUFFER, data, count, stride );
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+std::shared_ptr<Buffer> RenderDeviceDX11::CreateUShortIndexBuffer( const unsigned short* data, unsigned int count )
+{
+    std::shared_ptr<Buffer> buffer = std::make_shared<BufferDX11>( m_pDevice.Get(), D3D11_BIND_INDEX_BUFFER, data, count, (UINT)sizeof( unsigned short ) );
+    m_Buffers.Add( buffer );
 
     return buffer;
 }
@@ -181,18 +243,29 @@ std::shared_ptr <Buffer> RenderDeviceDX11::CreateDoubleVertexBuffer( const doubl
 std::shared_ptr<Buffer> RenderDeviceDX11::CreateUIntIndexBuffer( const unsigned int* data, unsigned int count )
 {
     std::shared_ptr <Buffer> buffer = std::make_shared<BufferDX11>( m_pDevice.Get(), D3D11_BIND_INDEX_BUFFER, data, count, (UINT)sizeof( unsigned int ) );
-    m_Buffers.push_back( buffer );
+    m_Buffers.Add( buffer );
 
     return buffer;
 }
 
 void RenderDeviceDX11::DestroyBuffer( std::shared_ptr<Buffer> buffer )
 {
-    BufferList::iterator iter = std::find( m_Buffers.begin(), m_Buffers.end(), buffer );
-    if ( iter != m_Buffers.end() )
-    {
-        m_Buffers.erase( iter );
-    }
+    m_Buffers.Remove( buffer );
+}
+
+void RenderDeviceDX11::DestroyBuffer( ResourceHandle handle )
+{
+    m_Buffers.Remove( handle );
+}
+
+ResourceHandle RenderDeviceDX11::GetBufferHandle( std::shared_ptr<Buffer> buffer ) const
+{
+    return m_Buffers.GetHandle( buffer );
+}
+
+std::shared_ptr<Buffer> RenderDeviceDX11::GetBuffer( ResourceHandle handle ) const
+{
+    return m_Buffers.Get( handle );
 }
 
 void RenderDeviceDX11::DestroyVertexBuffer( std::shared_ptr<Buffer> buffer )
@@ -214,7 +287,7 @@ std::shared_ptr<ConstantBuffer> RenderDeviceDX11::CreateConstantBuffer( const vo
         buffer->Set( data, size );
     }
 
-    m_Buffers.push_back( buffer );
+    m_Buffers.Add( buffer );
 
     return buffer;
 }
@@ -227,7 +300,7 @@ void RenderDeviceDX11::DestroyConstantBuffer( std::shared_ptr<ConstantBuffer> bu
 std::shared_ptr<StructuredBuffer> RenderDeviceDX11::CreateStructuredBuffer( void* data, unsigned int count, unsigned int stride, CPUAccess cpuAccess, bool gpuWrite )
 {
     std::shared_ptr<StructuredBuffer> buffer = std::make_shared<StructuredBufferDX11>( m_pDevice.Get(), 0, data, count, stride, cpuAccess, gpuWrite );
-    m_Buffers.push_back( buffer );
+    m_Buffers.Add( buffer );
 
     return buffer;
 }
@@ -240,18 +313,14 @@ void RenderDeviceDX11::DestroyStructuredBuffer( std::shared_ptr<StructuredBuffer
 std::shared_ptr<Mesh> RenderDeviceDX11::CreateMesh()
 {
     std::shared_ptr<Mesh> mesh = std::make_shared<MeshDX11>( m_pDevice.Get() );
-    m_Meshes.push_back( mesh );
+    m_Meshes.Add( mesh );
 
     return mesh;
 }
 
 void RenderDeviceDX11::DestroyMesh( std::shared_ptr<Mesh> mesh )
 {
-    MeshList::iterator iter = std::find( m_Meshes.begin(), m_Meshes.end(), mesh );
-    if ( iter != m_Meshes.end() )
-    {
-        m_Meshes.erase( iter );
-    }
+    m_Meshes.Remove( mesh );
 }
 
 std::shared_ptr<Scene> RenderDeviceDX11::CreateScene()
@@ -259,410 +328,139 @@ std::shared_ptr<Scene> RenderDeviceDX11::CreateScene()
     std::shared_ptr<Scene> scene = std::make_shared<SceneDX11>( *this );
     scene->LoadingProgress += boost::bind( &RenderDeviceDX11::OnLoadingProgress, this, _1 );
 
-    m_Scenes.push_back( scene );
+    m_Scenes.Add( scene );
 
     return scene;
 }
 
-// GLM's own quaternion from two vector constructor does not handle cases 
-// where the vectors may be pointing in opposite directions.
-// This method handles the cases where the u and v vectors are opposites.
-// source: http://lolengine.net/blog/2014/02/24/quaternion-from-two-vectors-final
-// accessed: 26/05/2015
-inline glm::quat RotationFromTwoVectors( const glm::vec3& u, const glm::vec3& v )
+void RenderDeviceDX11::DestroyScene( std::shared_ptr<Scene> scene )
 {
-    float normUV = glm::sqrt( glm::dot( u, u ) * glm::dot( v, v ) );
-    float real = normUV + glm::dot( u, v );
-
-    glm::vec3 vec;
-
-    if ( real < 1.e-6f * normUV )
-    {
-        /* If u and v are exactly opposite, rotate 180 degrees
-         * around an arbitrary orthogonal axis. Axis normalisation
-         * can happen later, when we normalise the quaternion. 
-         */
-        real = 0.0f;
-        vec = ( glm::abs( u.x ) > abs( u.z ) ) ? glm::vec3( -u.y, u.x, 0.0f ) : glm::vec3( 0.0f, -u.z, u.y );
-    }
-    else
-    {
-        /* Otherwise, build quaternion the standard way. */
-        vec = glm::cross( u, v );
-    }
-
-    return glm::normalize( glm::quat( real, vec ) );
+    m_Scenes.Remove( scene );
 }
 
-std::shared_ptr<Scene> RenderDeviceDX11::CreatePlane( float size, const glm::vec3& N )
+std::shared_ptr<Shader> RenderDeviceDX11::CreateShader()
 {
-    float halfSize = size * 0.5f;
-    glm::vec3 p[4];
-    // Crate the 4 points of the plane aligned to the X,Z plane.
-    // Vertex winding is assuming a right-handed coordinate system 
-    // (counter-clockwise winding order for front-facing polygons)
-    p[0] = glm::vec3(  halfSize, 0,  halfSize );
-    p[1] = glm::vec3( -halfSize, 0,  halfSize );
-    p[2] = glm::vec3( -halfSize, 0, -halfSize );
-    p[3] = glm::vec3(  halfSize, 0, -halfSize );
-
-    // Rotate the plane vertices in the direction of the surface normal.
-    glm::quat rot = RotationFromTwoVectors( glm::vec3( 0, 1, 0 ), N );
-
-    for ( int i = 0; i < 4; i++ )
-    {
-        p[i] = rot * p[i];
-    }
-
-    // Now create the plane polygon from the transformed vertices.
-    std::shared_ptr<Scene> scene = CreateScene();
-
-    std::stringstream ss;
-
-    // Create a white diffuse material for the plane.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
-
-    // Create a 4-point polygon
-    ss << "p 4" << std::endl;
-    for ( int i = 0; i < 4; i++ )
-    {
-        ss << p[i].x << " " << p[i].y << " " << p[i].z << std::endl;
-    }
-
-    if ( scene->LoadFromString( ss.str(), "nff" ) )
-    {
-        return scene;
-    }
+    std::shared_ptr<Shader> pShader = std::make_shared<ShaderDX11>( m_pDevice.Get() );
+    m_Shaders.Add( pShader );
 
-    // An error occurred while loading the scene.
-    DestroyScene( scene );
-    return nullptr;
+    return pShader;
 }
 
-std::shared_ptr<Scene> RenderDeviceDX11::CreateScreenQuad( float left, float right, float bottom, float top, float z )
+void RenderDeviceDX11::DestroyShader( std::shared_ptr<Shader> shader )
 {
-    glm::vec3 p[4]; // Vertex position
-    glm::vec3 n[4]; // Vertex normal (required for texture patch polygons)
-    glm::vec2 t[4]; // Texture coordinates
-    // Winding order is assumed to be right-handed. Front-facing polygons have
-    // a counter-clockwise winding order.
-    // Assimp flips the winding order of vertices.. Don't ask me why. To account for this,
-    // the vertices are loaded in reverse order :)
-    p[0] = glm::vec3( right, bottom, z );   n[0] = glm::vec3( 0, 0, 1 );    t[0] = glm::vec2( 1, 0 );
-    p[1] = glm::vec3( left, bottom, z );    n[1] = glm::vec3( 0, 0, 1 );    t[1] = glm::vec2( 0, 0 );
-    p[2] = glm::vec3( left, top, z );       n[2] = glm::vec3( 0, 0, 1 );    t[2] = glm::vec2( 0, 1 );
-    p[3] = glm::vec3( right, top, z );      n[3] = glm::vec3( 0, 0, 1 );    t[3] = glm::vec2( 1, 1 );
-
-    // Now create the quad.
-    std::shared_ptr<Scene> scene = CreateScene();
-
-    std::stringstream ss;
-
-    // Create a white diffuse material for the quad.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
-
-    // Create a 4-point textured polygon patch
-    ss << "tpp 4" << std::endl;
-    for ( int i = 0; i < 4; i++ )
-    {
-        // px py pz nx ny nz tu tv
-        ss << p[i].x << " " << p[i].y << " " << p[i].z << " " << n[i].x << " " << n[i].y << " " << n[i].z << " " << t[i].x << " " << t[i].y << std::endl;
-    }
-
-    if ( scene->LoadFromString( ss.str(), "nff" ) )
-    {
-        return scene;
-    }
-
-    // An error occurred while loading the scene.
-    DestroyScene( scene );
-    return nullptr;
-
+    m_Shaders.Remove( shader );
 }
 
-std::shared_ptr<Scene> RenderDeviceDX11::CreateSphere( float radius, float tesselation )
+std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture( const std::wstring& fileName )
 {
-    std::shared_ptr<Scene> scene = CreateScene();
-    std::stringstream ss;
-    // Create a white diffuse material for the sphere.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
-
-    // tess tesselation
-    ss << "tess " << tesselation << std::endl;
-    // s x y z radius
-    ss << "s 0 0 0 " << radius << std::endl;
-
-    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    TextureMap::iterator iter = m_TexturesByName.find( fileName );
+    if ( iter != m_TexturesByName.end() )
     {
-        return scene;
+        return iter->second;
     }
 
-    // An error occurred while loading the scene.
-    DestroyScene( scene );
-    return nullptr;
-}
-
-std::shared_ptr<Scene> RenderDeviceDX11::CreateCube( float size )
-{
-    std::shared_ptr<Scene> scene = CreateScene();
-    std::stringstream ss;
-
-    // Create a white diffuse material for the cube.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
-
-    // hex x y z size
-    ss << "hex 0 0 0 " << size;
+    std::shared_ptr<Texture> texture = std::make_shared<TextureDX11>( m_pDevice.Get() );
+    texture->LoadTexture2D( fileName );
 
-    if ( scene->LoadFromString( ss.str(), "nff" ) )
-    {
-        return scene;
-    }
+    m_Textures.Add( texture );
+    m_TexturesByName.insert( TextureMap::value_type( fileName, texture ) );
+    m_TextureNames.insert( TextureNameMap::value_type( texture.get(), fileName ) );
 
-    // An error occurred while loading the scene.
-    DestroyScene( scene );
-    return nullptr;
+    return texture;
 }
 
-std::shared_ptr<Scene> RenderDeviceDX11::CreateCylinder( float baseRadius, float apexRadius, float height, const glm::vec3& axis )
+void RenderDeviceDX11::CreateTextures( const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages, std::vector< std::shared_ptr<Texture> >& textures )
 {
-    std::shared_ptr<Scene> scene = CreateScene();
-    std::stringstream ss;
-
-    // Create a white diffuse material for the cylinder.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
+    HighResolutionTimer timer;
 
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 0 " << baseRadius << std::endl;
-
-    glm::vec3 apex = axis * height;
-    // apex.x apex.y apex.z apexRadius
-    ss << apex.x << " " << apex.y << " " << apex.z << " " << apexRadius << std::endl;
-
-    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    // Find the textures that have not been loaded yet.
+    // Duplicate requests for the same file are only decoded once.
+    std::vector<std::wstring> decodeFileNames;
+    std::vector<TextureUsage> decodeUsages;
+    std::map<std::wstring, size_t> decodeIndices;
+    for ( size_t i = 0; i < fileNames.size(); ++i )
     {
-        return scene;
+        const std::wstring& fileName = fileNames[i];
+        if ( m_TexturesByName.find( fileName ) == m_TexturesByName.end() &&
+             decodeIndices.insert( std::make_pair( fileName, decodeFileNames.size() ) ).second )
+        {
+            decodeFileNames.push_back( fileName );
+            decodeUsages.push_back( i < usages.size() ? usages[i] : TextureUsage::Color );
+        }
     }
 
-    // An error occurred while loading the scene.
-    DestroyScene( scene );
-    return nullptr;
-}
-
-std::shared_ptr <Scene> RenderDeviceDX11::CreateCone( float baseRadius, float height )
-{
-    // A cone is just a cylinder with a 0 size apex.
-    return CreateCylinder( baseRadius, 0, height );
-}
-
-std::shared_ptr<Scene> RenderDeviceDX11::CreateArrow( const glm::vec3& tail, const glm::vec3& head, float radius )
-{
-    std::shared_ptr<Scene> scene = CreateScene();
-    std::stringstream ss;
-
-    glm::vec3 dir = head - tail;
-    glm::vec3 apex = head + ( dir * 0.5f );
-
-    // Create a white diffuse material for the arrow.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
+    // Decode, compress and store the images in parallel.
+    JobSystem& jobSystem = Application::Get().GetJobSystem();
+    std::vector< std::unique_ptr<TextureDX11::ImageData> > images;
+    TextureDX11::ProcessingStatistics statistics;
+    TextureDX11::ProcessImages( jobSystem, decodeFileNames, decodeUsages, images, &statistics );
+    timer.Tick();
 
-    // Create a cylinder for the arrow body.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << tail.x << " " << tail.y << " " << tail.z << " " << radius << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << head.x << " " << head.y << " " << head.z << " " << radius << std::endl;
-
-    // Create a cone for the arrow head.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << head.x << " " << head.y << " " << head.z << " " << radius * 2.0f << std::endl;
-
-    // apex.x apex.y apex.z apexRadius
-    ss << apex.x << " " << apex.y << " " << apex.z << " 0" << std::endl;
-
-    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    // Create the textures on this thread (the device context is not thread safe).
+    size_t numCached = 0, uncompressedBytes = 0, textureBytes = 0;
+    for ( size_t i = 0; i < decodeFileNames.size(); ++i )
     {
-        return scene;
+        numCached += images[i]->FromCache ? 1 : 0;
+        if ( !images[i]->Mipmaps.Levels.empty() )
+        {
+            uncompressedBytes += GetUncompressedSize( images[i]->Mipmaps );
+            textureBytes += images[i]->Mipmaps.Data.size();
+        }
+        CreateTexture( *images[i] );
+        // Release the decoded image as soon as possible.
+        images[i].reset();
     }
 
-    // An error occurred while loading the scene.
-    DestroyScene( scene );
-    return nullptr;
+    timer.Tick();
+    double uploadTime = timer.ElapsedMilliSeconds();
 
-}
+    textures.clear();
+    for ( const std::wstring& fileName : fileNames )
+    {
+        textures.push_back( m_TexturesByName[fileName] );
+    }
 
-std::shared_ptr<Scene> RenderDeviceDX11::CreateAxis( float radius, float length )
-{
-    std::shared_ptr<Scene> scene = CreateScene();
     std::stringstream ss;
-
-    // Create a red material for the +X axis.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 0 0 1 0 0 0 0" << std::endl;
-
-    // Create a cylinder aligned to the +X axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 0 " << radius << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << length << " 0 0 " << radius << std::endl;
-
-    // Create a cone for the +X axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << length << " 0 0 " << radius * 2.0f << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << length * 1.5f << " 0 0 0" << std::endl;
-
-    // Create a green material for the +Y axis.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 0 1 0 1 0 0 0 0" << std::endl;
-
-    // Create a cylinder aligned to the +Y axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 0 " << radius << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << "0 " << length << " 0 " << radius << std::endl;
-
-    // Create a cone for the +Y axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 " << length << " 0 " << radius * 2.0f << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << "0 " << length * 1.5f << " 0 0" << std::endl;
-
-    // Create a blue material for the +Z axis.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 0 0 1 1 0 0 0 0" << std::endl;
-
-    // Create a cylinder aligned to the +Z axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 0 " << radius << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << "0 0 " << length << " " << radius << std::endl;
-
-    // Create a cone for the +Z axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 " << length << " " << radius * 2.0f << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << "0 0 " << length * 1.5f << " 0" << std::endl;
-
-    // Create a cyan material for the -X axis.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 0 1 1 1 0 0 0 0" << std::endl;
-
-    // Create a cylinder aligned to the -X axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 0 " << radius << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << -length << " 0 0 " << radius << std::endl;
-
-    // Create a cone for the -X axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << -length << " 0 0 " << radius * 2.0f << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << -length * 1.5f << " 0 0 0" << std::endl;
-
-    // Create a yellow material for the -Y axis.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 0 1 1 0 0 0 0" << std::endl;
-
-    // Create a cylinder aligned to the -Y axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 0 " << radius << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << "0 " << -length << " 0 " << radius << std::endl;
-
-    // Create a cone for the -Y axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 " << -length << " 0 0" << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << "0 " << -length * 1.5f << " 0 " << radius * 2.0f << std::endl;
-
-    // Create a magenta material for the -Z axis.
-    // f red green blue Kd Ks Shine transmittance indexOfRefraction
-    ss << "f 1 1 0 1 0 0 0 0" << std::endl;
-
-    // Create a cylinder aligned to the -Z axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 0 " << radius << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << "0 0 " << -length << " " << radius << std::endl;
-
-    // Create a cone for the -Z axis.
-    ss << "c" << std::endl;
-    // base.x base.y base.z baseRadius
-    ss << "0 0 " << -length << " " << radius * 2.0f << std::endl;
-    // apex.x apex.y apex.z apexRadius
-    ss << "0 0 " << -length * 1.5f << " 0" << std::endl;
-
-    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    ss << "Loaded " << decodeFileNames.size() << " textures (" << fileNames.size() - decodeFileNames.size() << " reused, " << numCached << " from the asset cache): "
+        << statistics.DecodeTime << " ms decode (" << jobSystem.GetNumThreads() << " threads), " << statistics.CompressionTime << " ms compression, "
+        << statistics.StoreTime << " ms store, " << uploadTime << " ms upload" << std::endl;
+    if ( statistics.NumCompressed > 0 )
     {
-        return scene;
+        ss << "Compressed " << statistics.NumCompressed << " textures: " << statistics.CompressedSourceBytes / ( 1024.0 * 1024.0 ) << " MB at "
+            << ( statistics.CompressedSourceBytes / ( 1024.0 * 1024.0 ) ) / glm::max( statistics.CompressionTime / 1000.0, 1e-6 ) << " MB/s" << std::endl;
     }
-
-    // An error occurred while loading the scene.
-    DestroyScene( scene );
-    return nullptr;
-
+    ss << "Texture memory: " << uncompressedBytes / ( 1024.0 * 1024.0 ) << " MB uncompressed -> " << textureBytes / ( 1024.0 * 1024.0 ) << " MB ("
+        << ( uncompressedBytes - textureBytes ) / ( 1024.0 * 1024.0 ) << " MB saved)" << std::endl;
+    OutputDebugStringA( ss.str().c_str() );
 }
 
-void RenderDeviceDX11::DestroyScene( std::shared_ptr<Scene> scene )
+std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture( TextureDX11::ImageData& image )
 {
-    SceneList::iterator iter = std::find( m_Scenes.begin(), m_Scenes.end(), scene );
-    if ( iter != m_Scenes.end() )
+    TextureMap::iterator iter = m_TexturesByName.find( image.FileName );
+    if ( iter != m_TexturesByName.end() )
     {
-        m_Scenes.erase( iter );
+        return iter->second;
     }
-}
 
-std::shared_ptr<Shader> RenderDeviceDX11::CreateShader()
-{
-    std::shared_ptr<Shader> pShader = std::make_shared<ShaderDX11>( m_pDevice.Get() );
-    m_Shaders.push_back( pShader );
+    std::shared_ptr<TextureDX11> texture = std::make_shared<TextureDX11>( m_pDevice.Get() );
+    texture->LoadTexture2D( image );
 
-    return pShader;
-}
+    m_Textures.Add( texture );
+    m_TexturesByName.insert( TextureMap::value_type( image.FileName, texture ) );
+    m_TextureNames.insert( TextureNameMap::value_type( texture.get(), image.FileName ) );
 
-void RenderDeviceDX11::DestroyShader( std::shared_ptr<Shader> shader )
-{
-    ShaderList::iterator iter = std::find( m_Shaders.begin(), m_Shaders.end(), shader );
-    if ( iter != m_Shaders.end() )
-    {
-        m_Shaders.erase( iter );
-    }
+    return texture;
 }
 
-std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture( const std::wstring& fileName )
+std::shared_ptr<Texture> RenderDeviceDX11::FindTexture( const std::wstring& fileName ) const
 {
-    TextureMap::iterator iter = m_TexturesByName.find( fileName );
+    TextureMap::const_iterator iter = m_TexturesByName.find( fileName );
     if ( iter != m_TexturesByName.end() )
     {
         return iter->second;
     }
 
-    std::shared_ptr<Texture> texture = std::make_shared<TextureDX11>( m_pDevice.Get() );
-    texture->LoadTexture2D( fileName );
-
-    m_Textures.push_back( texture );
-    m_TexturesByName.insert( TextureMap::value_type(fileName, texture ) );
-
-    return texture;
+    return nullptr;
 }
 
 std::shared_ptr<Texture> RenderDeviceDX11::CreateTextureCube( const std::wstring& fileName )
@@ -676,8 +474,9 @@ std::shared_ptr<Texture> RenderDeviceDX11::CreateTextureCube( const std::wstring
     std::shared_ptr<Texture> texture = std::make_shared<TextureDX11>( m_pDevice.Get() );
     texture->LoadTextureCube( fileName );
 
-    m_Textures.push_back( texture );
+    m_Textures.Add( texture );
     m_TexturesByName.insert( TextureMap::value_type( fileName, texture ) );
+    m_TextureNames.insert( TextureNameMap::value_type( texture.get(), fileName ) );
 
     return texture;
 
@@ -687,7 +486,7 @@ std::shared_ptr<Texture> RenderDeviceDX11::CreateTextureCube( const std::wstring
 std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture1D( uint16_t width, uint16_t slices, const Texture::TextureFormat& format, CPUAccess cpuAccess, bool gpuWrite )
 {
     std::shared_ptr<Texture> texture = std::make_shared<TextureDX11>( m_pDevice.Get(), width, slices, format, cpuAccess, gpuWrite );
-    m_Textures.push_back( texture );
+    m_Textures.Add( texture );
 
     return texture;
 }
@@ -695,7 +494,7 @@ std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture1D( uint16_t width, uint
 std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture2D( uint16_t width, uint16_t height, uint16_t slices, const Texture::TextureFormat& format, CPUAccess cpuAccess, bool gpuWrite )
 {
     std::shared_ptr<Texture> texture = std::make_shared<TextureDX11>( m_pDevice.Get(), width, height, slices, format, cpuAccess, gpuWrite );
-    m_Textures.push_back( texture );
+    m_Textures.Add( texture );
 
     return texture;
 }
@@ -703,7 +502,7 @@ std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture2D( uint16_t width, uint
 std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture3D( uint16_t width, uint16_t height, uint16_t depth, const Texture::TextureFormat& format, CPUAccess cpuAccess, bool gpuWrite )
 {
     std::shared_ptr<Texture> texture = std::make_shared<TextureDX11>( TextureDX11::Tex3d, m_pDevice.Get(), width, height, depth, format, cpuAccess, gpuWrite );
-    m_Textures.push_back( texture );
+    m_Textures.Add( texture );
 
     return texture;
 }
@@ -711,7 +510,7 @@ std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture3D( uint16_t width, uint
 std::shared_ptr<Texture> RenderDeviceDX11::CreateTextureCube( uint16_t size, uint16_t numCubes, const Texture::TextureFormat& format, CPUAccess cpuAccess, bool gpuWrite )
 {
     std::shared_ptr<Texture> texture = std::make_shared<TextureDX11>( TextureDX11::Cube, m_pDevice.Get(), size, numCubes, format, cpuAccess, gpuWrite );
-    m_Textures.push_back( texture );
+    m_Textures.Add( texture );
 
     return texture;
 }
@@ -719,7 +518,7 @@ std::shared_ptr<Texture> RenderDeviceDX11::CreateTextureCube( uint16_t size, uin
 std::shared_ptr<Texture> RenderDeviceDX11::CreateTexture()
 {
     std::shared_ptr<Texture> texture = std::make_shared<TextureDX11>( m_pDevice.Get() );
-    m_Textures.push_back( texture );
+    m_Textures.Add( texture );
     
     return texture;
 }
@@ -731,101 +530,110 @@ std::shared_ptr<Texture> RenderDeviceDX11::GetDefaultTexture() const
 
 void RenderDeviceDX11::DestroyTexture( std::shared_ptr<Texture> texture )
 {
-    TextureList::iterator iter = std::find( m_Textures.begin(), m_Textures.end(), texture );
-    if ( iter != m_Textures.end() )
+    m_Textures.Remove( texture );
+
+    TextureNameMap::iterator iter = m_TextureNames.find( texture.get() );
+    if ( iter != m_TextureNames.end() )
     {
-        m_Textures.erase( iter );
+        m_TexturesByName.erase( iter->second );
+        m_TextureNames.erase( iter );
     }
+}
 
-    TextureMap::iterator iter2 = std::find_if( m_TexturesByName.begin(), m_TexturesByName.end(), [=] ( TextureMap::value_type val ) { return ( val.second == texture ); } );
-    if ( iter2 != m_TexturesByName.end() )
+void RenderDeviceDX11::DestroyTexture( ResourceHandle handle )
+{
+    std::shared_ptr<Texture> texture = m_Textures.Get( handle );
+    if ( texture )
     {
-        m_TexturesByName.erase( iter2 );
+        DestroyTexture( texture );
     }
 }
 
+ResourceHandle RenderDeviceDX11::GetTextureHandle( std::shared_ptr<Texture> texture ) const
+{
+    return m_Textures.GetHandle( texture );
+}
+
+std::shared_ptr<Texture> RenderDeviceDX11::GetTexture( ResourceHandle handle ) const
+{
+    return m_Textures.Get( handle );
+}
+
 std::shared_ptr<RenderTarget> RenderDeviceDX11::CreateRenderTarget()
 {
     std::shared_ptr<RenderTargetDX11> renderTarget = std::make_shared<RenderTargetDX11>( m_pDevice.Get() );
-    m_RenderTargets.push_back( renderTarget );
+    m_RenderTargets.Add( renderTarget );
 
     return renderTarget;
 }
 
 void RenderDeviceDX11::DestroyRenderTarget( std::shared_ptr<RenderTarget> renderTarget )
 {
-    RenderTargetList::iterator iter = std::find( m_RenderTargets.begin(), m_RenderTargets.end(), renderTarget );
-    if ( iter != m_RenderTargets.end() )
-    {
-        m_RenderTargets.erase( iter );
-    }
+    m_RenderTargets.Remove( renderTarget );
 }
 
 std::shared_ptr<SamplerState> RenderDeviceDX11::CreateSamplerState()
 {
     std::shared_ptr<SamplerState> sampler = std::make_shared<SamplerStateDX11>( m_pDevice.Get() );
-    m_Samplers.push_back( sampler );
+    m_Samplers.Add( sampler );
 
     return sampler;
 }
 
 void RenderDeviceDX11::DestroySampler( std::shared_ptr<SamplerState> sampler )
 {
-    SamplerList::iterator iter = std::find( m_Samplers.begin(), m_Samplers.end(), sampler );
-    if ( iter != m_Samplers.end() )
-    {
-        m_Samplers.erase( iter );
-    }
+    m_Samplers.Remove( sampler );
 }
 
 std::shared_ptr<Material> RenderDeviceDX11::CreateMaterial()
 {
     std::shared_ptr<Material> pMaterial = std::make_shared<Material>( *this );
-    m_Materials.push_back( pMaterial );
+    m_Materials.Add( pMaterial );
     return pMaterial;
 }
 
 void RenderDeviceDX11::DestroyMaterial( std::shared_ptr<Material> material )
 {
-    MaterialList::iterator iter = std::find( m_Materials.begin(), m_Materials.end(), material );
-    if ( iter != m_Materials.end() )
-    {
-        m_Materials.erase( iter );
-    }
+    m_Materials.Remove( material );
 }
 
 std::shared_ptr<PipelineState> RenderDeviceDX11::CreatePipelineState()
 {
     std::shared_ptr<PipelineState> pPipeline = std::make_shared<PipelineStateDX11>( m_pDevice.Get() );
-    m_Pipelines.push_back( pPipeline );
+    m_Pipelines.Add( pPipeline );
     
     return pPipeline;
 }
 
 void RenderDeviceDX11::DestoryPipelineState( std::shared_ptr<PipelineState> pipeline )
 {
-    PipelineList::iterator iter = std::find( m_Pipelines.begin(), m_Pipelines.end(), pipeline );
-    if ( iter != m_Pipelines.end() )
-    {
-        m_Pipelines.erase( iter );
-    }
+    m_Pipelines.Remove( pipeline );
 }
 
 std::shared_ptr<Query> RenderDeviceDX11::CreateQuery( Query::QueryType queryType, uint8_t numBuffers )
 {
     std::shared_ptr<Query> query = std::make_shared<QueryDX11>( m_pDevice.Get(), queryType, numBuffers );
-    m_Queries.push_back( query );
+    m_Queries.Add( query );
 
     return query;
 }
 
 void RenderDeviceDX11::DestoryQuery( std::shared_ptr<Query> query )
 {
-    QueryList::iterator iter = std::find( m_Queries.begin(), m_Queries.end(), query );
-    if ( iter != m_Queries.end() )
-    {
-        m_Queries.erase( iter );
-    }
+    m_Queries.Remove( query );
+}
+
+std::shared_ptr<CommandList> RenderDeviceDX11::CreateCommandList()
+{
+    std::shared_ptr<CommandList> commandList = std::make_shared<CommandListDX11>( m_pDevice.Get() );
+    m_CommandLists.Add( commandList );
+
+    return commandList;
+}
+
+void RenderDeviceDX11::DestroyCommandList( std::shared_ptr<CommandList> commandList )
+{
+    m_CommandLists.Remove( commandList );
 }
 
 void RenderDeviceDX11::OnInitialize( EventArgs& e )
@@ -2,8 +2,15 @@
 
 #include <RenderDevice.h>
 
+#include "../ResourceRegistry.h"
+
+#include "TextureDX11.h"
+
 class Application;
 class Material;
+class StateCacheDX11;
+class StateObjectCacheDX11;
+class ConstantBufferRingDX11;
 
 class RenderDeviceDX11 : public RenderDevice
 {
@@ -18,9 +25,13 @@ public:
     // Inherited from RenderDevice
     virtual std::shared_ptr<Buffer> CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride );
     virtual std::shared_ptr<Buffer> CreateDoubleVertexBuffer( const double* data, unsigned int count, unsigned int stride );
+    virtual std::shared_ptr<Buffer> CreateUShortIndexBuffer( const unsigned short* data, unsigned int count );
     virtual std::shared_ptr<Buffer> CreateUIntIndexBuffer( const unsigned int* data, unsigned int count );
     virtual std::shared_ptr<ConstantBuffer> CreateConstantBuffer( const void* data, size_t size );
     virtual std::shared_ptr<StructuredBuffer> CreateStructuredBuffer( void* data, unsigned int count, unsigned int stride, CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
+    // Create a vertex buffer that contains several interleaved vertex attributes.
+    // @param stride The size of a vertex in bytes.
+    std::shared_ptr<Buffer> CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride );
 
     virtual void DestroyBuffer( std::shared_ptr<Buffer> buffer );
     virtual void DestroyVertexBuffer( std::shared_ptr<Buffer> buffer );
@@ -32,14 +43,6 @@ public:
     virtual void DestroyShader( std::shared_ptr<Shader> shader );
 
     virtual std::shared_ptr<Scene> CreateScene();
-    virtual std::shared_ptr<Scene> CreatePlane( float size, const glm::vec3& N = glm::vec3( 0, 1, 0 ) );
-    virtual std::shared_ptr<Scene> CreateScreenQuad( float left = -1.0f, float right = 1.0f, float bottom = -1.0f, float top = 1.0f, float z = 0.0f );
-    virtual std::shared_ptr<Scene> CreateSphere( float radius, float tesselation = 4 );
-    virtual std::shared_ptr<Scene> CreateCube( float size );
-    virtual std::shared_ptr<Scene> CreateCylinder( float baseRadius, float apexRadius, float height, const glm::vec3& axis = glm::vec3( 0, 1, 0 ) );
-    virtual std::shared_ptr<Scene> CreateCone( float baseRadius, float height );
-    virtual std::shared_ptr<Scene> CreateArrow( const glm::vec3& tail = glm::vec3( 0, 0, 0 ), const glm::vec3& head = glm::vec3( 0, 0, 1 ), float radius = 0.05f );
-    virtual std::shared_ptr<Scene> CreateAxis( float radius = 0.05f, float length = 0.5f );
     virtual void DestroyScene( std::shared_ptr<Scene> scene );
 
     virtual std::shared_ptr<Mesh> CreateMesh();
@@ -48,6 +51,19 @@ public:
     virtual std::shared_ptr<Texture> CreateTexture( const std::wstring& fileName );
     virtual std::shared_ptr<Texture> CreateTextureCube( const std::wstring& fileName );
 
+    // Load several 2D textures at once.
+    // The images are decoded in parallel and the textures are created on the calling thread.
+    // Each file is only loaded once, even if it is requested several times.
+    // @param usages How each texture is used (in the same order as the file names).
+    // @param textures Receives a texture for each file name (in the same order).
+    void CreateTextures( const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages, std::vector< std::shared_ptr<Texture> >& textures );
+    // Create a 2D texture from an image that was decoded with TextureDX11::DecodeImage.
+    // Must be called on the render thread. The decoded image is released.
+    // If the file has already been loaded, the existing texture is returned.
+    std::shared_ptr<Texture> CreateTexture( TextureDX11::ImageData& image );
+    // Returns the texture that was loaded from a file (or nullptr if it hasn't been loaded).
+    std::shared_ptr<Texture> FindTexture( const std::wstring& fileName ) const;
+
     virtual std::shared_ptr<Texture> CreateTexture1D( uint16_t width, uint16_t slices = 1, const Texture::TextureFormat& format = Texture::TextureFormat(), CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
     virtual std::shared_ptr<Texture> CreateTexture2D( uint16_t width, uint16_t height, uint16_t slices = 1, const Texture::TextureFormat& format = Texture::TextureFormat(), CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
     virtual std::shared_ptr<Texture> CreateTexture3D( uint16_t width, uint16_t height, uint16_t depth, const Texture::TextureFormat& format = Texture::TextureFormat(), CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
@@ -73,9 +89,26 @@ public:
     virtual std::shared_ptr<PipelineState> CreatePipelineState();
     virtual void DestoryPipelineState( std::shared_ptr<PipelineState> pipeline );
 
+    virtual ConstantBufferRing* GetConstantBufferRing();
+
+    virtual std::shared_ptr<CommandList> CreateCommandList();
+    virtual void DestroyCommandList( std::shared_ptr<CommandList> commandList );
+
+    virtual const StateCacheStatistics* GetStateCacheStatistics() const;
+
+    virtual ResourceHandle GetBufferHandle( std::shared_ptr<Buffer> buffer ) const;
+    virtual std::shared_ptr<Buffer> GetBuffer( ResourceHandle handle ) const;
+    virtual void DestroyBuffer( ResourceHandle handle );
+
+    virtual ResourceHandle GetTextureHandle( std::shared_ptr<Texture> texture ) const;
+    virtual std::shared_ptr<Texture> GetTexture( ResourceHandle handle ) const;
+    virtual void DestroyTexture( ResourceHandle handle );
+
     // Specific to RenderDeviceDX11
     Microsoft::WRL::ComPtr<ID3D11Device2> GetDevice() const;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> GetDeviceContext() const;
+    // The state cache of the immediate device context.
+    StateCacheDX11& GetStateCache() const;
 
 protected:
     virtual void CreateDevice( HINSTANCE hInstance );
@@ -88,43 +121,55 @@ private:
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11Debug> m_pDebugLayer;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    // All state changes of the immediate context go through the state cache.
+    std::unique_ptr<StateCacheDX11> m_pStateCache;
+    // All state objects (blend, rasterizer, depth-stencil, sampler) are created by the state object cache.
+    std::unique_ptr<StateObjectCacheDX11> m_pStateObjectCache;
+    // Only created if the device supports constant buffer offsets.
+    std::unique_ptr<ConstantBufferRingDX11> m_pConstantBufferRing;
 
     // The name of the graphics device used for rendering.
     std::string m_DeviceName;
 
-    typedef std::vector< std::shared_ptr<Scene> > SceneList;
-    SceneList m_Scenes;
+    typedef ResourceRegistry<Scene> SceneRegistry;
+    SceneRegistry m_Scenes;
 
-    typedef std::vector< std::shared_ptr<Buffer> > BufferList;
-    BufferList m_Buffers;
+    typedef ResourceRegistry<Buffer> BufferRegistry;
+    BufferRegistry m_Buffers;
 
-    typedef std::vector< std::shared_ptr<Mesh> > MeshList;
-    MeshList m_Meshes;
+    typedef ResourceRegistry<Mesh> MeshRegistry;
+    MeshRegistry m_Meshes;
 
-    typedef std::vector< std::shared_ptr<Shader> > ShaderList;
-    ShaderList m_Shaders;
+    typedef ResourceRegistry<Shader> ShaderRegistry;
+    ShaderRegistry m_Shaders;
 
-    typedef std::vector< std::shared_ptr<Texture> > TextureList;
+    typedef ResourceRegistry<Texture> TextureRegistry;
     typedef std::map< std::wstring, std::shared_ptr<Texture> > TextureMap;
-    TextureList m_Textures;
+    // The file names of the textures in the texture map (to remove a texture from the map without searching it).
+    typedef std::unordered_map< const Texture*, std::wstring > TextureNameMap;
+    TextureRegistry m_Textures;
     TextureMap m_TexturesByName;
+    TextureNameMap m_TextureNames;
 
-    typedef std::vector< std::shared_ptr<RenderTarget> > RenderTargetList;
-    RenderTargetList m_RenderTargets;
+    typedef ResourceRegistry<RenderTarget> RenderTargetRegistry;
+    RenderTargetRegistry m_RenderTargets;
 
     std::shared_ptr<Texture> m_pDefaultTexture;
 
-    typedef std::vector< std::shared_ptr<SamplerState> > SamplerList;
-    SamplerList m_Samplers;
+    typedef ResourceRegistry<SamplerState> SamplerRegistry;
+    SamplerRegistry m_Samplers;
+
+    typedef ResourceRegistry<Material> MaterialRegistry;
+    MaterialRegistry m_Materials;
 
-    typedef std::vector< std::shared_ptr<Material> > MaterialList;
-    MaterialList m_Materials;
+    typedef ResourceRegistry<PipelineState> PipelineRegistry;
+    PipelineRegistry m_Pipelines;
 
-    typedef std::vector< std::shared_ptr<PipelineState> > PipelineList;
-    PipelineList m_Pipelines;
+    typedef ResourceRegistry<Query> QueryRegistry;
+    QueryRegistry m_Queries;
 
-    typedef std::vector< std::shared_ptr<Query> > QueryList;
-    QueryList m_Queries;
+    typedef ResourceRegistry<CommandList> CommandListRegistry;
+    CommandListRegistry m_CommandLists;
 
     std::shared_ptr<PipelineState> m_pDefaultPipeline;
 
@@ -2,6 +2,7 @@
 
 #include "TextureDX11.h"
 #include "StructuredBufferDX11.h"
+#include "StateCacheDX11.h"
 
 #include "RenderTargetDX11.h"
 
@@ -12,6 +13,7 @@ RenderTargetDX11::RenderTargetDX11( ID3D11Device2* pDevice )
     , m_bCheckValidity( false )
 {
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
     m_Textures.resize( (size_t)RenderTarget::AttachmentPoint::NumAttachmentPoints + 1 );
     m_StructuredBuffers.resize( 8 );
 }
@@ -149,12 +151,12 @@ void RenderTargetDX11::Bind()
         depthStencilView = depthStencilTexture->GetDepthStencilView();
     }
 
-    m_pDeviceContext->OMSetRenderTargetsAndUnorderedAccessViews( numRTVs, renderTargetViews, depthStencilView, uavStartSlot, numUAVs, uavViews, nullptr );
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetRenderTargets( numRTVs, renderTargetViews, depthStencilView, uavStartSlot, numUAVs, uavViews );
 }
 
 void RenderTargetDX11::UnBind()
 {
-    m_pDeviceContext->OMSetRenderTargetsAndUnorderedAccessViews( 0, nullptr, nullptr, 0, 0, nullptr, nullptr );
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetRenderTargets( 0, nullptr, nullptr, 0, 0, nullptr );
 }
 
 bool RenderTargetDX11::IsValid() const
@@ -4,6 +4,7 @@
 
 class TextureDX11;
 class StructuredBufferDX11;
+class StateCacheDX11;
 
 class RenderTargetDX11 : public RenderTarget
 {
@@ -29,6 +30,7 @@ protected:
 private:
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
     
     typedef std::vector< std::shared_ptr<TextureDX11> > TextureList;
     TextureList m_Textures;
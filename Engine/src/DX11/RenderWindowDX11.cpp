@@ -5,11 +5,13 @@
 #include <Camera.h>
 #include <Rect.h>
 #include <Material.h>
+#include <ConstantBufferRing.h>
 
 #include "RenderDeviceDX11.h"
 #include "RenderWindowDX11.h"
 #include "RenderTargetDX11.h"
 #include "TextureDX11.h"
+#include "StateCacheDX11.h"
 
 RenderWindowDX11::RenderWindowDX11( Application& app, HWND hWnd, RenderDeviceDX11& device, const std::string& windowName, int windowWidth, int windowHeight, bool vSync )
     : RenderWindow( app, windowName, windowWidth, windowHeight, vSync )
@@ -38,6 +40,13 @@ RenderWindowDX11::RenderWindowDX11( Application& app, HWND hWnd, RenderDeviceDX1
     // Create a render target for the back buffer and depth/stencil buffers.
     m_RenderTarget = std::dynamic_pointer_cast<RenderTargetDX11>( m_Device.CreateRenderTarget() );
 
+    D3D_FEATURE_LEVEL featureLevel = m_pDevice->GetFeatureLevel();
+    UINT stateFlags = ( m_pDevice->GetCreationFlags() & D3D11_CREATE_DEVICE_SINGLETHREADED ) ? D3D11_1_CREATE_DEVICE_CONTEXT_STATE_SINGLETHREADED : 0;
+    if ( FAILED( m_pDevice->CreateDeviceContextState( stateFlags, &featureLevel, 1, D3D11_SDK_VERSION, __uuidof( ID3D11Device1 ), nullptr, &m_pTweakBarState ) ) )
+    {
+        ReportError( "Failed to create the device context state for AntTweakBar." );
+    }
+
     // Create the device and swap chain before the window is shown.
     CreateSwapChain();
 }
@@ -210,7 +219,7 @@ void RenderWindowDX11::ResizeSwapChainBuffers( uint32_t width, uint32_t height )
     height = glm::max<uint32_t>( height, 1 );
 
     //// Make sure we're not referencing the render targets when the window is resized.
-    m_pDeviceContext->OMSetRenderTargets( 0, nullptr, nullptr );
+    m_Device.GetStateCache().SetRenderTargets( 0, nullptr, nullptr, 0, 0, nullptr );
 
     // Release the current render target views and texture resources.
     m_pBackBuffer.Reset();
@@ -232,16 +241,39 @@ void RenderWindowDX11::ResizeSwapChainBuffers( uint32_t width, uint32_t height )
 
 void RenderWindowDX11::Present()
 {
-    // The application can leave the render targets unbound.
-    // Bind the render window's default render target before 
-    // drawing AntTweakBar.
-    m_RenderTarget->Bind();
+    std::shared_ptr<TextureDX11> colorBuffer = std::dynamic_pointer_cast<TextureDX11>( m_RenderTarget->GetTexture( RenderTarget::AttachmentPoint::Color0 ) );
+    std::shared_ptr<TextureDX11> depthStencilBuffer = std::dynamic_pointer_cast<TextureDX11>( m_RenderTarget->GetTexture( RenderTarget::AttachmentPoint::DepthStencil ) );
+
+    // AntTweakBar changes the state of the device context without going through the state cache.
+    // Draw it with its own device context state and swap the state of the application back afterwards,
+    // so the state cache still matches the device context and nothing has to be bound again next frame.
+    Microsoft::WRL::ComPtr<ID3DDeviceContextState> pApplicationState;
+    m_pDeviceContext->SwapDeviceContextState( m_pTweakBarState.Get(), &pApplicationState );
+
+    // Draw the AntTweakBar to the render window's default render target.
+    // The state cache doesn't shadow this state, so the render target is bound directly.
+    if ( colorBuffer )
+    {
+        ID3D11RenderTargetView* pRenderTargetView = colorBuffer->GetRenderTargetView();
+        m_pDeviceContext->OMSetRenderTargets( 1, &pRenderTargetView, depthStencilBuffer ? depthStencilBuffer->GetDepthStencilView() : nullptr );
 
-    // Draw the AntTweakBar
-    TwDraw();
+        D3D11_VIEWPORT viewport = { 0.0f, 0.0f, (FLOAT)colorBuffer->GetWidth(), (FLOAT)colorBuffer->GetHeight(), 0.0f, 1.0f };
+        m_pDeviceContext->RSSetViewports( 1, &viewport );
+
+        TwDraw();
+    }
+
+    m_pDeviceContext->SwapDeviceContextState( pApplicationState.Get(), nullptr );
+
+    StateCacheDX11& stateCache = m_Device.GetStateCache();
+    stateCache.EndFrame();
+
+    if ( ConstantBufferRing* pConstantBufferRing = m_Device.GetConstantBufferRing() )
+    {
+        pConstantBufferRing->EndFrame();
+    }
 
     // Copy the render target's color buffer to the swap chain's back buffer.
-    std::shared_ptr<TextureDX11> colorBuffer = std::dynamic_pointer_cast<TextureDX11>( m_RenderTarget->GetTexture( RenderTarget::AttachmentPoint::Color0 ) );
     if ( colorBuffer )
     {
         m_pDeviceContext->CopyResource( m_pBackBuffer.Get(), colorBuffer->GetTextureResource() );
@@ -47,6 +47,9 @@ private:
 	Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
 	Microsoft::WRL::ComPtr<IDXGISwapChain2> m_pSwapChain;
     Microsoft::WRL::ComPtr<ID3D11Texture2D> m_pBackBuffer;
+    // AntTweakBar draws with its own device context state, so it doesn't change
+    // the state of the application (and the state cache that shadows it).
+    Microsoft::WRL::ComPtr<ID3DDeviceContextState> m_pTweakBarState;
 
     std::shared_ptr<RenderTargetDX11> m_RenderTarget;
 
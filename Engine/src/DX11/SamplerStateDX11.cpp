@@ -1,10 +1,14 @@
 #include <EnginePCH.h>
 
+#include "StateCacheDX11.h"
+#include "StateObjectCacheDX11.h"
 #include "SamplerStateDX11.h"
 
 SamplerStateDX11::SamplerStateDX11( ID3D11Device2* pDevice )
     : m_pDevice( pDevice )
     , m_pDeviceContext( nullptr )
+    , m_pStateCache( nullptr )
+    , m_pStateObjectCache( nullptr )
     , m_pSamplerState( nullptr )
     , m_MinFilter( MinFilter::MinNearest )
     , m_MagFilter( MagFilter::MagNearest )
@@ -24,6 +28,8 @@ SamplerStateDX11::SamplerStateDX11( ID3D11Device2* pDevice )
     if ( m_pDevice )
     {
         m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+        m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
+        m_pStateObjectCache = StateObjectCacheDX11::Get( m_pDevice.Get() );
     }
 }
 
@@ -253,7 +259,10 @@ void SamplerStateDX11::Bind( uint32_t ID, Shader::ShaderType shaderType, ShaderP
 {
     if ( m_bIsDirty || m_pSamplerState == nullptr )
     {
+        // Samplers with the same description share the same sampler state object.
+        // The description is compared bytewise by the state object cache.
         D3D11_SAMPLER_DESC samplerDesc;
+        ZeroMemory( &samplerDesc, sizeof( samplerDesc ) );
         samplerDesc.Filter = TranslateFilter();
         samplerDesc.AddressU = TranslateWrapMode( m_WrapModeU );
         samplerDesc.AddressV = TranslateWrapMode( m_WrapModeV );
@@ -268,60 +277,16 @@ void SamplerStateDX11::Bind( uint32_t ID, Shader::ShaderType shaderType, ShaderP
         samplerDesc.MinLOD = m_fMinLOD;
         samplerDesc.MaxLOD = m_fMaxLOD;
 
-        m_pDevice->CreateSamplerState( &samplerDesc, &m_pSamplerState );
+        m_pSamplerState = m_pStateObjectCache->GetSamplerState( samplerDesc );
 
         m_bIsDirty = false;
     }
 
-    ID3D11SamplerState* pSamplers[] = { m_pSamplerState.Get() };
-
-    switch ( shaderType )
-    {
-    case Shader::VertexShader:
-        m_pDeviceContext->VSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::TessellationControlShader:
-        m_pDeviceContext->HSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::TessellationEvaluationShader:
-        m_pDeviceContext->DSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::GeometryShader:
-        m_pDeviceContext->GSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::PixelShader:
-        m_pDeviceContext->PSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::ComputeShader:
-        m_pDeviceContext->CSSetSamplers( ID, 1, pSamplers );
-        break;
-    }
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetSampler( shaderType, ID, m_pSamplerState.Get() );
 }
 
 void SamplerStateDX11::UnBind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
-    ID3D11SamplerState* pSamplers[] = { nullptr };
-
-    switch ( shaderType )
-    {
-    case Shader::VertexShader:
-        m_pDeviceContext->VSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::TessellationControlShader:
-        m_pDeviceContext->HSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::TessellationEvaluationShader:
-        m_pDeviceContext->DSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::GeometryShader:
-        m_pDeviceContext->GSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::PixelShader:
-        m_pDeviceContext->PSSetSamplers( ID, 1, pSamplers );
-        break;
-    case Shader::ComputeShader:
-        m_pDeviceContext->CSSetSamplers( ID, 1, pSamplers );
-        break;
-    }
+    StateCacheDX11::GetCurrent( m_pStateCache )->SetSampler( shaderType, ID, nullptr );
 }
 
@@ -3,6 +3,9 @@
 #include <SamplerState.h>
 #include <ShaderParameter.h>
 
+class StateCacheDX11;
+class StateObjectCacheDX11;
+
 class SamplerStateDX11 : public SamplerState
 {
 public:
@@ -48,6 +51,8 @@ protected:
 private:
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
+    StateObjectCacheDX11* m_pStateObjectCache;
     Microsoft::WRL::ComPtr<ID3D11SamplerState> m_pSamplerState;
 
     MinFilter m_MinFilter;
@@ -66,6 +71,6 @@ private:
     bool        m_bIsAnisotropicFilteringEnabled;
     uint8_t     m_AnisotropicFiltering;
 
-    // Set to true if the sampler state needs to be recreated.
+    // Set to true if the sampler state object needs to be looked up.
     bool        m_bIsDirty;
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <Texture.h>
 
 #include "RenderDeviceDX11.h"
+#include "TextureStreamerDX11.h"
 
 #include "SceneDX11.h"
 
@@ -21,6 +22,16 @@ std::shared_ptr<Buffer> SceneDX11::CreateFloatVertexBuffer( const float* data, u
     return m_Device.CreateFloatVertexBuffer( data, count, stride );
 }
 
+std::shared_ptr<Buffer> SceneDX11::CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride ) const
+{
+    return m_Device.CreateInterleavedVertexBuffer( data, count, stride );
+}
+
+std::shared_ptr<Buffer> SceneDX11::CreateUShortIndexBuffer( const unsigned short* data, unsigned int count ) const
+{
+    return m_Device.CreateUShortIndexBuffer( data, count );
+}
+
 std::shared_ptr<Buffer> SceneDX11::CreateUIntIndexBuffer( const unsigned int* data, unsigned int count ) const
 {
     return m_Device.CreateUIntIndexBuffer( data, count );
@@ -41,6 +52,11 @@ std::shared_ptr<Texture> SceneDX11::CreateTexture( const std::wstring& fileName
     return m_Device.CreateTexture( fileName );
 }
 
+void SceneDX11::CreateTextures( const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages, std::vector< std::shared_ptr<Texture> >& textures ) const
+{
+    m_Device.CreateTextures( fileNames, usages, textures );
+}
+
 std::shared_ptr<Texture> SceneDX11::CreateTexture2D( uint16_t width, uint16_t height )
 {
     return m_Device.CreateTexture2D( width, height );
@@ -49,4 +65,39 @@ std::shared_ptr<Texture> SceneDX11::CreateTexture2D( uint16_t width, uint16_t he
 std::shared_ptr<Texture> SceneDX11::GetDefaultTexture()
 {
     return m_Device.GetDefaultTexture();
+}
+
+void SceneDX11::StreamTextures( const TexturePriorityMap& textures, const TextureUsageMap& usages )
+{
+    if ( !m_pTextureStreamer )
+    {
+        m_pTextureStreamer.reset( new TextureStreamerDX11( m_Device, *this ) );
+        m_pTextureStreamer->LoadingProgress += boost::bind( &SceneDX11::OnLoadingProgress, this, _1 );
+    }
+
+    m_pTextureStreamer->Enqueue( textures, usages );
+}
+
+void SceneDX11::SetStreamingPriorities( const TexturePriorityMap& priorities )
+{
+    if ( m_pTextureStreamer )
+    {
+        m_pTextureStreamer->SetPriorities( priorities );
+    }
+}
+
+void SceneDX11::UpdateStreamedTextures( TextureMap& loadedTextures )
+{
+    if ( m_pTextureStreamer )
+    {
+        m_pTextureStreamer->Update( loadedTextures );
+    }
+}
+
+void SceneDX11::CancelStreaming()
+{
+    if ( m_pTextureStreamer )
+    {
+        m_pTextureStreamer->Cancel();
+    }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "../SceneBase.h"
 
 class RenderDeviceDX11;
+class TextureStreamerDX11;
 
 class SceneDX11 : public SceneBase
 {
@@ -11,16 +12,26 @@ public:
     virtual ~SceneDX11();
 protected:
     virtual std::shared_ptr<Buffer> CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride ) const;
+    virtual std::shared_ptr<Buffer> CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride ) const;
+    virtual std::shared_ptr<Buffer> CreateUShortIndexBuffer( const unsigned short* data, unsigned int count ) const;
     virtual std::shared_ptr<Buffer> CreateUIntIndexBuffer( const unsigned int* data, unsigned int count ) const;
 
     virtual std::shared_ptr<Mesh> CreateMesh() const;
     virtual std::shared_ptr<Material> CreateMaterial() const;
     virtual std::shared_ptr<Texture> CreateTexture( const std::wstring& fileName ) const;
+    virtual void CreateTextures( const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages, std::vector< std::shared_ptr<Texture> >& textures ) const;
     virtual std::shared_ptr<Texture> CreateTexture2D( uint16_t width, uint16_t height );
     virtual std::shared_ptr<Texture> GetDefaultTexture();
 
+    virtual void StreamTextures( const TexturePriorityMap& textures, const TextureUsageMap& usages );
+    virtual void SetStreamingPriorities( const TexturePriorityMap& priorities );
+    virtual void UpdateStreamedTextures( TextureMap& loadedTextures );
+    virtual void CancelStreaming();
+
 private:
     RenderDeviceDX11& m_Device;
+    // Only created if the scene is loaded with texture streaming.
+    std::unique_ptr<TextureStreamerDX11> m_pTextureStreamer;
 
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pContext;
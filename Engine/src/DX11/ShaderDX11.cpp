@@ -6,6 +6,7 @@
 #include <Timer.h>
 
 #include "ShaderParameterDX11.h"
+#include "StateCacheDX11.h"
 #include "ShaderDX11.h"
 
 // This parameter will be returned if an invalid shader parameter is requested.
@@ -14,12 +15,18 @@ static ShaderParameterDX11 gs_InvalidShaderParameter;
 // Forward declarations
 DXGI_FORMAT GetDXGIFormat( const D3D11_SIGNATURE_PARAMETER_DESC& paramDesc );
 
+// If a vertex shader is compiled with this macro, its inputs are read from
+// a single vertex buffer that contains the interleaved vertex attributes.
+#define INTERLEAVED_VERTICES_MACRO "QUANTIZED_VERTICES"
+
 ShaderDX11::ShaderDX11( ID3D11Device2* pDevice )
     : m_ShaderType( UnknownShaderType )
     , m_pDevice( pDevice )
+    , m_bInterleavedVertices( false )
     , m_bFileChanged ( false )
 {
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 
     m_Connections.push_back( m_DependencyTracker.FileChanged += boost::bind( &ShaderDX11::OnFileChanged, this, _1 ) );
 }
@@ -40,6 +47,7 @@ void ShaderDX11::Destroy()
     m_pInputLayout.Reset();
 
     m_ShaderParameters.clear();
+    m_ParameterTable.clear();
     m_InputSemantics.clear();
 }
 
@@ -282,6 +290,7 @@ bool ShaderDX11::LoadShaderFromString( ShaderType shaderType, const std::string&
     }
 
     m_InputSemantics.clear();
+    m_bInterleavedVertices = ( shaderType == VertexShader ) && ( shaderMacros.find( INTERLEAVED_VERTICES_MACRO ) != shaderMacros.end() );
 
     UINT numInputParameters = shaderDescription.InputParameters;
     std::vector<D3D11_INPUT_ELEMENT_DESC> inputElements;
@@ -292,9 +301,14 @@ bool ShaderDX11::LoadShaderFromString( ShaderType shaderType, const std::string&
 
         pReflector->GetInputParameterDesc( i, &parameterSignature );
 
+        // System values (like SV_InstanceID) are not stored in the interleaved vertices.
+        if ( m_bInterleavedVertices && parameterSignature.SystemValueType != D3D_NAME_UNDEFINED ) continue;
+
         inputElement.SemanticName = parameterSignature.SemanticName;
         inputElement.SemanticIndex = parameterSignature.SemanticIndex;
-        inputElement.InputSlot = i; // TODO: If using interleaved arrays, then the input slot should be 0.  If using packed arrays, the input slot will vary.
+        // Interleaved vertex attributes are read from slot 0 in the order they are declared in the shader.
+        // Otherwise, every attribute is read from its own vertex buffer.
+        inputElement.InputSlot = m_bInterleavedVertices ? 0 : i;
         inputElement.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
         inputElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA; // TODO: Figure out how to deal with per-instance data? .. Don't. Just use structured buffers to store per-instance data and use the SV_InstanceID as an index in the structured buffer.
         inputElement.InstanceDataStepRate = 0;
@@ -304,7 +318,7 @@ bool ShaderDX11::LoadShaderFromString( ShaderType shaderType, const std::string&
 
         inputElements.push_back( inputElement );
 
-        m_InputSemantics.insert( SemanticMap::value_type( BufferBinding( inputElement.SemanticName, inputElement.SemanticIndex ), i ) );
+        m_InputSemantics.insert( SemanticMap::value_type( BufferBinding( inputElement.SemanticName, inputElement.SemanticIndex ), inputElement.InputSlot ) );
     }
 
     if ( inputElements.size() > 0 )
@@ -362,6 +376,17 @@ bool ShaderDX11::LoadShaderFromString( ShaderType shaderType, const std::string&
         }
     }
 
+    // Build the lookup table for the interned parameter IDs.
+    for ( auto shaderParameter : m_ShaderParameters )
+    {
+        ShaderParameterID id( shaderParameter.first );
+        if ( id.GetIndex() >= m_ParameterTable.size() )
+        {
+            m_ParameterTable.resize( id.GetIndex() + 1, nullptr );
+        }
+        m_ParameterTable[id.GetIndex()] = shaderParameter.second.get();
+    }
+
     return true;
 }
 
@@ -417,6 +442,16 @@ ShaderParameter& ShaderDX11::GetShaderParameterByName( const std::string& name )
     return gs_InvalidShaderParameter;
 }
 
+ShaderParameter& ShaderDX11::GetShaderParameter( const ShaderParameterID& id ) const
+{
+    if ( id.GetIndex() < m_ParameterTable.size() && m_ParameterTable[id.GetIndex()] )
+    {
+        return *m_ParameterTable[id.GetIndex()];
+    }
+
+    return gs_InvalidShaderParameter;
+}
+
 bool ShaderDX11::HasSemantic( const BufferBinding& binding ) const
 {
     SemanticMap::const_iterator iter = m_InputSemantics.find( binding );
@@ -435,6 +470,11 @@ UINT ShaderDX11::GetSlotIDBySemantic( const BufferBinding& binding ) const
     return (UINT)-1;
 }
 
+bool ShaderDX11::HasInterleavedVertices() const
+{
+    return m_bInterleavedVertices;
+}
+
 void ShaderDX11::OnFileChanged( FileChangeEventArgs& e )
 {
     m_bFileChanged = true;
@@ -442,6 +482,8 @@ void ShaderDX11::OnFileChanged( FileChangeEventArgs& e )
 
 void ShaderDX11::Bind()
 {
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
+
     if ( m_bFileChanged && m_DependencyTracker.IsStale() )
     {
         MutexLock lock( m_Mutex );
@@ -458,33 +500,35 @@ void ShaderDX11::Bind()
 
     if ( m_pVertexShader )
     {
-        m_pDeviceContext->IASetInputLayout( m_pInputLayout.Get() );
-        m_pDeviceContext->VSSetShader( m_pVertexShader.Get(), nullptr, 0 );
+        pStateCache->SetInputLayout( m_pInputLayout.Get() );
+        pStateCache->SetShader( VertexShader, m_pVertexShader.Get() );
     }
     else if ( m_pHullShader )
     {
-        m_pDeviceContext->HSSetShader( m_pHullShader.Get(), nullptr, 0 );
+        pStateCache->SetShader( TessellationControlShader, m_pHullShader.Get() );
     }
     else if ( m_pDomainShader )
     {
-        m_pDeviceContext->DSSetShader( m_pDomainShader.Get(), nullptr, 0 );
+        pStateCache->SetShader( TessellationEvaluationShader, m_pDomainShader.Get() );
     }
     else if ( m_pGeometryShader )
     {
-        m_pDeviceContext->GSSetShader( m_pGeometryShader.Get(), nullptr, 0 );
+        pStateCache->SetShader( GeometryShader, m_pGeometryShader.Get() );
     }
     else if ( m_pPixelShader )
     {
-        m_pDeviceContext->PSSetShader( m_pPixelShader.Get(), nullptr, 0 );
+        pStateCache->SetShader( PixelShader, m_pPixelShader.Get() );
     }
     else if ( m_pComputeShader )
     {
-        m_pDeviceContext->CSSetShader( m_pComputeShader.Get(), nullptr, 0 );
+        pStateCache->SetShader( ComputeShader, m_pComputeShader.Get() );
     }
 }
 
 void ShaderDX11::UnBind()
 {
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
+
     for ( ParameterMap::value_type value : m_ShaderParameters )
     {
         value.second->UnBind();
@@ -492,36 +536,38 @@ void ShaderDX11::UnBind()
 
     if ( m_pVertexShader )
     {
-        m_pDeviceContext->IASetInputLayout( nullptr );
-        m_pDeviceContext->VSSetShader( nullptr, nullptr, 0 );
+        pStateCache->SetInputLayout( nullptr );
+        pStateCache->SetShader( VertexShader, nullptr );
     }
     else if ( m_pHullShader )
     {
-        m_pDeviceContext->HSSetShader( nullptr, nullptr, 0 );
+        pStateCache->SetShader( TessellationControlShader, nullptr );
     }
     else if ( m_pDomainShader )
     {
-        m_pDeviceContext->DSSetShader( nullptr, nullptr, 0 );
+        pStateCache->SetShader( TessellationEvaluationShader, nullptr );
     }
     else if ( m_pGeometryShader )
     {
-        m_pDeviceContext->GSSetShader( nullptr, nullptr, 0 );
+        pStateCache->SetShader( GeometryShader, nullptr );
     }
     else if ( m_pPixelShader )
     {
-        m_pDeviceContext->PSSetShader( nullptr, nullptr, 0 );
+        pStateCache->SetShader( PixelShader, nullptr );
     }
     else if ( m_pComputeShader )
     {
-        m_pDeviceContext->CSSetShader( nullptr, nullptr, 0 );
+        pStateCache->SetShader( ComputeShader, nullptr );
     }
 }
 
 void ShaderDX11::Dispatch( const glm::uvec3& numGroups )
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     if ( m_pDeviceContext && m_pComputeShader )
     {
-        m_pDeviceContext->Dispatch( numGroups.x, numGroups.y, numGroups.z );
+        pDeviceContext->Dispatch( numGroups.x, numGroups.y, numGroups.z );
     }
 }
 
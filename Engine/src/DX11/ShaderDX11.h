@@ -5,6 +5,7 @@
 #include <DependencyTracker.h>
 
 class ShaderParameterDX11;
+class StateCacheDX11;
 
 class ShaderDX11 : public Shader
 {
@@ -22,6 +23,7 @@ public:
 
     //virtual UINT GetConstantBufferIndex( const std::string& name );
     virtual ShaderParameter& GetShaderParameterByName( const std::string& name ) const;
+    virtual ShaderParameter& GetShaderParameter( const ShaderParameterID& id ) const;
 
     //virtual ConstantBuffer* GetConstantBufferByName( const std::string& name ); 
     
@@ -31,6 +33,9 @@ public:
     // Check to see if this shader supports a given semantic.
     bool HasSemantic( const BufferBinding& binding ) const;
     UINT GetSlotIDBySemantic( const BufferBinding& binding ) const;
+    // Returns true if the vertex shader reads all vertex attributes from a single
+    // interleaved vertex buffer in slot 0 (the shader was compiled with QUANTIZED_VERTICES).
+    bool HasInterleavedVertices() const;
 
     virtual void Bind();
     virtual void UnBind();
@@ -47,6 +52,7 @@ private:
 	ShaderType	m_ShaderType;
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
     Microsoft::WRL::ComPtr<ID3D11VertexShader> m_pVertexShader;
     Microsoft::WRL::ComPtr<ID3D11HullShader> m_pHullShader;
     Microsoft::WRL::ComPtr<ID3D11DomainShader> m_pDomainShader;
@@ -60,10 +66,14 @@ private:
 
     typedef std::map<std::string, std::shared_ptr<ShaderParameterDX11> > ParameterMap;
     ParameterMap m_ShaderParameters;
+    // The shader parameters indexed by their interned ShaderParameterID.
+    // Entries for IDs that are not used by this shader are null.
+    std::vector<ShaderParameterDX11*> m_ParameterTable;
 
     // A map to convert a vertex attribute semantic to a slot.
     typedef std::map<BufferBinding, UINT> SemanticMap;
     SemanticMap m_InputSemantics;
+    bool m_bInterleavedVertices;
 
     // Parameters necessary to reload the shader at runtime if it is modified on disc.
     ShaderMacros m_ShaderMacros;
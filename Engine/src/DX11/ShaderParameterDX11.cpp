@@ -49,6 +49,16 @@ ShaderParameter::Type ShaderParameterDX11::GetType() const
     return m_ParameterType;
 }
 
+UINT ShaderParameterDX11::GetSlotID() const
+{
+    return m_uiSlotID;
+}
+
+Shader::ShaderType ShaderParameterDX11::GetShaderType() const
+{
+    return m_ShaderType;
+}
+
 void ShaderParameterDX11::Bind()
 {
     if ( std::shared_ptr<ConstantBuffer> constantBuffer = m_pConstantBuffer.lock() )
@@ -69,6 +79,16 @@ void ShaderParameterDX11::Bind()
     }
 }
 
+void ShaderParameterDX11::BindConstantBuffer( ConstantBuffer& constantBuffer )
+{
+    constantBuffer.Bind( m_uiSlotID, m_ShaderType, Type::Buffer );
+}
+
+void ShaderParameterDX11::BindStructuredBuffer( StructuredBuffer& buffer )
+{
+    buffer.Bind( m_uiSlotID, m_ShaderType, Type::Buffer );
+}
+
 void ShaderParameterDX11::UnBind()
 {
     if ( std::shared_ptr<ConstantBuffer> constantBuffer = m_pConstantBuffer.lock() )
@@ -22,6 +22,10 @@ public:
     // Get the type of the stored parameter.
     virtual Type GetType() const;
 
+    // The slot and the shader stage the parameter is bound to.
+    UINT GetSlotID() const;
+    Shader::ShaderType GetShaderType() const;
+
     // Bind the shader parameter to a specific slot for the given shader type.
     virtual void Bind();
     virtual void UnBind();
@@ -33,6 +37,9 @@ protected:
     virtual void SetSampler( std::shared_ptr<SamplerState> sampler );
     virtual void SetStructuredBuffer( std::shared_ptr<StructuredBuffer> rwBuffer );
 
+    virtual void BindConstantBuffer( ConstantBuffer& constantBuffer );
+    virtual void BindStructuredBuffer( StructuredBuffer& buffer );
+
 private:
     std::string m_Name;
 
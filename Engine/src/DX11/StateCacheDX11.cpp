@@ -0,0 +1,519 @@
+#include <EnginePCH.h>
+
+#include "StateCacheDX11.h"
+
+using Microsoft::WRL::ComPtr;
+
+typedef StateCacheStatistics::State State;
+
+// The state cache of the command list that is recording on this thread.
+static thread_local StateCacheDX11* gs_pRecordingStateCache = nullptr;
+
+StateCacheDX11::StateCacheDX11( ID3D11DeviceContext2* pDeviceContext )
+    : m_pDeviceContext( pDeviceContext )
+{
+    StateCacheDX11* pStateCache = this;
+    if ( FAILED( m_pDeviceContext->SetPrivateData( __uuidof( StateCacheDX11 ), sizeof( pStateCache ), &pStateCache ) ) )
+    {
+        ReportError( "Failed to attach the state cache to the device context." );
+    }
+
+    Reset();
+}
+
+StateCacheDX11::~StateCacheDX11()
+{
+    m_pDeviceContext->SetPrivateData( __uuidof( StateCacheDX11 ), 0, nullptr );
+}
+
+StateCacheDX11* StateCacheDX11::Get( ID3D11DeviceContext* pDeviceContext )
+{
+    StateCacheDX11* pStateCache = nullptr;
+    UINT dataSize = sizeof( pStateCache );
+
+    if ( FAILED( pDeviceContext->GetPrivateData( __uuidof( StateCacheDX11 ), &dataSize, &pStateCache ) ) || pStateCache == nullptr )
+    {
+        ReportError( "No state cache is attached to the device context." );
+    }
+
+    return pStateCache;
+}
+
+StateCacheDX11* StateCacheDX11::GetCurrent( StateCacheDX11* pImmediate )
+{
+    return gs_pRecordingStateCache ? gs_pRecordingStateCache : pImmediate;
+}
+
+void StateCacheDX11::SetRecording( StateCacheDX11* pStateCache )
+{
+    gs_pRecordingStateCache = pStateCache;
+}
+
+ID3D11DeviceContext2* StateCacheDX11::GetDeviceContext() const
+{
+    return m_pDeviceContext.Get();
+}
+
+bool StateCacheDX11::IsValidStage( Shader::ShaderType shaderType )
+{
+    return shaderType >= Shader::VertexShader && shaderType <= Shader::ComputeShader;
+}
+
+UINT StateCacheDX11::GetStage( Shader::ShaderType shaderType )
+{
+    return shaderType - Shader::VertexShader;
+}
+
+void StateCacheDX11::SetShader( Shader::ShaderType shaderType, ID3D11DeviceChild* pShader )
+{
+    if ( !IsValidStage( shaderType ) ) return;
+
+    if ( !Update( State::Shader, m_Shaders[GetStage( shaderType )], pShader ) ) return;
+
+    switch ( shaderType )
+    {
+    case Shader::VertexShader:
+        m_pDeviceContext->VSSetShader( static_cast<ID3D11VertexShader*>( pShader ), nullptr, 0 );
+        break;
+    case Shader::TessellationControlShader:
+        m_pDeviceContext->HSSetShader( static_cast<ID3D11HullShader*>( pShader ), nullptr, 0 );
+        break;
+    case Shader::TessellationEvaluationShader:
+        m_pDeviceContext->DSSetShader( static_cast<ID3D11DomainShader*>( pShader ), nullptr, 0 );
+        break;
+    case Shader::GeometryShader:
+        m_pDeviceContext->GSSetShader( static_cast<ID3D11GeometryShader*>( pShader ), nullptr, 0 );
+        break;
+    case Shader::PixelShader:
+        m_pDeviceContext->PSSetShader( static_cast<ID3D11PixelShader*>( pShader ), nullptr, 0 );
+        break;
+    case Shader::ComputeShader:
+        m_pDeviceContext->CSSetShader( static_cast<ID3D11ComputeShader*>( pShader ), nullptr, 0 );
+        break;
+    default:
+        break;
+    }
+}
+
+void StateCacheDX11::SetInputLayout( ID3D11InputLayout* pInputLayout )
+{
+    if ( Update( State::InputLayout, m_pInputLayout, pInputLayout ) )
+    {
+        m_pDeviceContext->IASetInputLayout( pInputLayout );
+    }
+}
+
+void StateCacheDX11::SetConstantBuffer( Shader::ShaderType shaderType, UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant, UINT numConstants )
+{
+    if ( !IsValidStage( shaderType ) ) return;
+
+    assert( slot < D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT );
+
+    UINT stage = GetStage( shaderType );
+    ConstantBufferRange& range = m_ConstantBufferRanges[stage][slot];
+    if ( m_ConstantBuffers[stage][slot].Get() == pBuffer && range.FirstConstant == firstConstant && range.NumConstants == numConstants )
+    {
+        m_Statistics.Skip( State::ConstantBuffer );
+        return;
+    }
+
+    m_ConstantBuffers[stage][slot] = pBuffer;
+    range.FirstConstant = firstConstant;
+    range.NumConstants = numConstants;
+    m_Statistics.Issue( State::ConstantBuffer );
+
+    ID3D11Buffer* pBuffers[] = { pBuffer };
+
+    if ( numConstants > 0 )
+    {
+        switch ( shaderType )
+        {
+        case Shader::VertexShader:
+            m_pDeviceContext->VSSetConstantBuffers1( slot, 1, pBuffers, &firstConstant, &numConstants );
+            break;
+        case Shader::TessellationControlShader:
+            m_pDeviceContext->HSSetConstantBuffers1( slot, 1, pBuffers, &firstConstant, &numConstants );
+            break;
+        case Shader::TessellationEvaluationShader:
+            m_pDeviceContext->DSSetConstantBuffers1( slot, 1, pBuffers, &firstConstant, &numConstants );
+            break;
+        case Shader::GeometryShader:
+            m_pDeviceContext->GSSetConstantBuffers1( slot, 1, pBuffers, &firstConstant, &numConstants );
+            break;
+        case Shader::PixelShader:
+            m_pDeviceContext->PSSetConstantBuffers1( slot, 1, pBuffers, &firstConstant, &numConstants );
+            break;
+        case Shader::ComputeShader:
+            m_pDeviceContext->CSSetConstantBuffers1( slot, 1, pBuffers, &firstConstant, &numConstants );
+            break;
+        default:
+            break;
+        }
+        return;
+    }
+
+    switch ( shaderType )
+    {
+    case Shader::VertexShader:
+        m_pDeviceContext->VSSetConstantBuffers( slot, 1, pBuffers );
+        break;
+    case Shader::TessellationControlShader:
+        m_pDeviceContext->HSSetConstantBuffers( slot, 1, pBuffers );
+        break;
+    case Shader::TessellationEvaluationShader:
+        m_pDeviceContext->DSSetConstantBuffers( slot, 1, pBuffers );
+        break;
+    case Shader::GeometryShader:
+        m_pDeviceContext->GSSetConstantBuffers( slot, 1, pBuffers );
+        break;
+    case Shader::PixelShader:
+        m_pDeviceContext->PSSetConstantBuffers( slot, 1, pBuffers );
+        break;
+    case Shader::ComputeShader:
+        m_pDeviceContext->CSSetConstantBuffers( slot, 1, pBuffers );
+        break;
+    default:
+        break;
+    }
+}
+
+void StateCacheDX11::SetShaderResource( Shader::ShaderType shaderType, UINT slot, ID3D11ShaderResourceView* pShaderResourceView )
+{
+    if ( !IsValidStage( shaderType ) ) return;
+
+    assert( slot < D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT );
+
+    UINT stage = GetStage( shaderType );
+    if ( m_ValidShaderResourceViews[stage][slot] )
+    {
+        if ( !Update( State::ShaderResource, m_ShaderResourceViews[stage][slot], pShaderResourceView ) ) return;
+    }
+    else
+    {
+        m_ShaderResourceViews[stage][slot] = pShaderResourceView;
+        m_ValidShaderResourceViews[stage][slot] = true;
+        m_Statistics.Issue( State::ShaderResource );
+    }
+
+    ID3D11ShaderResourceView* srv[] = { pShaderResourceView };
+
+    switch ( shaderType )
+    {
+    case Shader::VertexShader:
+        m_pDeviceContext->VSSetShaderResources( slot, 1, srv );
+        break;
+    case Shader::TessellationControlShader:
+        m_pDeviceContext->HSSetShaderResources( slot, 1, srv );
+        break;
+    case Shader::TessellationEvaluationShader:
+        m_pDeviceContext->DSSetShaderResources( slot, 1, srv );
+        break;
+    case Shader::GeometryShader:
+        m_pDeviceContext->GSSetShaderResources( slot, 1, srv );
+        break;
+    case Shader::PixelShader:
+        m_pDeviceContext->PSSetShaderResources( slot, 1, srv );
+        break;
+    case Shader::ComputeShader:
+        m_pDeviceContext->CSSetShaderResources( slot, 1, srv );
+        break;
+    default:
+        break;
+    }
+}
+
+void StateCacheDX11::SetSampler( Shader::ShaderType shaderType, UINT slot, ID3D11SamplerState* pSamplerState )
+{
+    if ( !IsValidStage( shaderType ) ) return;
+
+    assert( slot < D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT );
+
+    if ( !Update( State::Sampler, m_SamplerStates[GetStage( shaderType )][slot], pSamplerState ) ) return;
+
+    ID3D11SamplerState* pSamplers[] = { pSamplerState };
+
+    switch ( shaderType )
+    {
+    case Shader::VertexShader:
+        m_pDeviceContext->VSSetSamplers( slot, 1, pSamplers );
+        break;
+    case Shader::TessellationControlShader:
+        m_pDeviceContext->HSSetSamplers( slot, 1, pSamplers );
+        break;
+    case Shader::TessellationEvaluationShader:
+        m_pDeviceContext->DSSetSamplers( slot, 1, pSamplers );
+        break;
+    case Shader::GeometryShader:
+        m_pDeviceContext->GSSetSamplers( slot, 1, pSamplers );
+        break;
+    case Shader::PixelShader:
+        m_pDeviceContext->PSSetSamplers( slot, 1, pSamplers );
+        break;
+    case Shader::ComputeShader:
+        m_pDeviceContext->CSSetSamplers( slot, 1, pSamplers );
+        break;
+    default:
+        break;
+    }
+}
+
+void StateCacheDX11::SetUnorderedAccessView( UINT slot, ID3D11UnorderedAccessView* pUnorderedAccessView )
+{
+    // Unordered access views of the compute shader stage are always set.
+    // They are only bound around dispatches and binding them unbinds
+    // the shader resource views of the same resource.
+    m_Statistics.Issue( State::UnorderedAccess );
+
+    ID3D11UnorderedAccessView* uav[] = { pUnorderedAccessView };
+    m_pDeviceContext->CSSetUnorderedAccessViews( slot, 1, uav, nullptr );
+
+    if ( pUnorderedAccessView )
+    {
+        InvalidateShaderResources();
+    }
+}
+
+void StateCacheDX11::SetVertexBuffer( UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset )
+{
+    assert( slot < D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT );
+
+    VertexBufferBinding& binding = m_VertexBuffers[slot];
+    if ( binding.Buffer.Get() == pBuffer && binding.Stride == stride && binding.Offset == offset )
+    {
+        m_Statistics.Skip( State::VertexBuffer );
+        return;
+    }
+
+    binding.Buffer = pBuffer;
+    binding.Stride = stride;
+    binding.Offset = offset;
+    m_Statistics.Issue( State::VertexBuffer );
+
+    ID3D11Buffer* buffers[] = { pBuffer };
+    m_pDeviceContext->IASetVertexBuffers( slot, 1, buffers, &stride, &offset );
+}
+
+void StateCacheDX11::SetIndexBuffer( ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset )
+{
+    if ( m_pIndexBuffer.Get() == pBuffer && m_IndexFormat == format && m_IndexOffset == offset )
+    {
+        m_Statistics.Skip( State::IndexBuffer );
+        return;
+    }
+
+    m_pIndexBuffer = pBuffer;
+    m_IndexFormat = format;
+    m_IndexOffset = offset;
+    m_Statistics.Issue( State::IndexBuffer );
+
+    m_pDeviceContext->IASetIndexBuffer( pBuffer, format, offset );
+}
+
+void StateCacheDX11::SetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY primitiveTopology )
+{
+    if ( m_Statistics.Update( State::PrimitiveTopology, m_PrimitiveTopology, primitiveTopology ) )
+    {
+        m_pDeviceContext->IASetPrimitiveTopology( primitiveTopology );
+    }
+}
+
+void StateCacheDX11::SetBlendState( ID3D11BlendState* pBlendState, const FLOAT blendFactor[4], UINT sampleMask )
+{
+    if ( m_pBlendState.Get() == pBlendState && memcmp( m_BlendFactor, blendFactor, sizeof( m_BlendFactor ) ) == 0 && m_SampleMask == sampleMask )
+    {
+        m_Statistics.Skip( State::BlendState );
+        return;
+    }
+
+    m_pBlendState = pBlendState;
+    memcpy( m_BlendFactor, blendFactor, sizeof( m_BlendFactor ) );
+    m_SampleMask = sampleMask;
+    m_Statistics.Issue( State::BlendState );
+
+    m_pDeviceContext->OMSetBlendState( pBlendState, blendFactor, sampleMask );
+}
+
+void StateCacheDX11::SetRasterizerState( ID3D11RasterizerState* pRasterizerState )
+{
+    if ( Update( State::RasterizerState, m_pRasterizerState, pRasterizerState ) )
+    {
+        m_pDeviceContext->RSSetState( pRasterizerState );
+    }
+}
+
+void StateCacheDX11::SetViewports( UINT numViewports, const D3D11_VIEWPORT* pViewports )
+{
+    if ( m_Viewports.size() == numViewports && ( numViewports == 0 || memcmp( m_Viewports.data(), pViewports, numViewports * sizeof( D3D11_VIEWPORT ) ) == 0 ) )
+    {
+        m_Statistics.Skip( State::Viewports );
+        return;
+    }
+
+    m_Viewports.assign( pViewports, pViewports + numViewports );
+    m_Statistics.Issue( State::Viewports );
+
+    m_pDeviceContext->RSSetViewports( numViewports, pViewports );
+}
+
+void StateCacheDX11::SetScissorRects( UINT numRects, const D3D11_RECT* pRects )
+{
+    if ( m_ScissorRects.size() == numRects && ( numRects == 0 || memcmp( m_ScissorRects.data(), pRects, numRects * sizeof( D3D11_RECT ) ) == 0 ) )
+    {
+        m_Statistics.Skip( State::ScissorRects );
+        return;
+    }
+
+    m_ScissorRects.assign( pRects, pRects + numRects );
+    m_Statistics.Issue( State::ScissorRects );
+
+    m_pDeviceContext->RSSetScissorRects( numRects, pRects );
+}
+
+void StateCacheDX11::SetDepthStencilState( ID3D11DepthStencilState* pDepthStencilState, UINT stencilRef )
+{
+    if ( m_pDepthStencilState.Get() == pDepthStencilState && m_StencilRef == stencilRef )
+    {
+        m_Statistics.Skip( State::DepthStencilState );
+        return;
+    }
+
+    m_pDepthStencilState = pDepthStencilState;
+    m_StencilRef = stencilRef;
+    m_Statistics.Issue( State::DepthStencilState );
+
+    m_pDeviceContext->OMSetDepthStencilState( pDepthStencilState, stencilRef );
+}
+
+void StateCacheDX11::SetRenderTargets( UINT numRTVs, ID3D11RenderTargetView* const* ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView,
+                                       UINT uavStartSlot, UINT numUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews )
+{
+    bool isBound = m_RenderTargetViews.size() == numRTVs &&
+        m_pDepthStencilView.Get() == pDepthStencilView &&
+        m_UnorderedAccessViews.size() == numUAVs &&
+        ( numUAVs == 0 || m_UAVStartSlot == uavStartSlot );
+
+    for ( UINT i = 0; isBound && i < numRTVs; ++i )
+    {
+        isBound = m_RenderTargetViews[i].Get() == ppRenderTargetViews[i];
+    }
+    for ( UINT i = 0; isBound && i < numUAVs; ++i )
+    {
+        isBound = m_UnorderedAccessViews[i].Get() == ppUnorderedAccessViews[i];
+    }
+
+    if ( isBound )
+    {
+        m_Statistics.Skip( State::RenderTargets );
+        return;
+    }
+
+    m_RenderTargetViews.assign( ppRenderTargetViews, ppRenderTargetViews + numRTVs );
+    m_pDepthStencilView = pDepthStencilView;
+    m_UAVStartSlot = uavStartSlot;
+    m_UnorderedAccessViews.assign( ppUnorderedAccessViews, ppUnorderedAccessViews + numUAVs );
+    m_Statistics.Issue( State::RenderTargets );
+
+    m_pDeviceContext->OMSetRenderTargetsAndUnorderedAccessViews( numRTVs, ppRenderTargetViews, pDepthStencilView, uavStartSlot, numUAVs, ppUnorderedAccessViews, nullptr );
+
+    InvalidateShaderResources();
+}
+
+void StateCacheDX11::InvalidateShaderResources()
+{
+    for ( UINT stage = 0; stage < NumStages; ++stage )
+    {
+        m_ValidShaderResourceViews[stage].reset();
+    }
+}
+
+void StateCacheDX11::Reset()
+{
+    m_pDeviceContext->ClearState();
+
+    // Set the cached state to the default state of the device context.
+    for ( UINT stage = 0; stage < NumStages; ++stage )
+    {
+        m_Shaders[stage].Reset();
+
+        for ( ComPtr<ID3D11Buffer>& pBuffer : m_ConstantBuffers[stage] )
+        {
+            pBuffer.Reset();
+        }
+        for ( ConstantBufferRange& range : m_ConstantBufferRanges[stage] )
+        {
+            range.FirstConstant = 0;
+            range.NumConstants = 0;
+        }
+        for ( ComPtr<ID3D11ShaderResourceView>& pShaderResourceView : m_ShaderResourceViews[stage] )
+        {
+            pShaderResourceView.Reset();
+        }
+        for ( ComPtr<ID3D11SamplerState>& pSamplerState : m_SamplerStates[stage] )
+        {
+            pSamplerState.Reset();
+        }
+        m_ValidShaderResourceViews[stage].set();
+    }
+
+    m_pInputLayout.Reset();
+
+    for ( VertexBufferBinding& binding : m_VertexBuffers )
+    {
+        binding.Buffer.Reset();
+        binding.Stride = 0;
+        binding.Offset = 0;
+    }
+
+    m_pIndexBuffer.Reset();
+    m_IndexFormat = DXGI_FORMAT_UNKNOWN;
+    m_IndexOffset = 0;
+
+    m_PrimitiveTopology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+    m_pBlendState.Reset();
+    m_BlendFactor[0] = m_BlendFactor[1] = m_BlendFactor[2] = m_BlendFactor[3] = 1.0f;
+    m_SampleMask = 0xffffffff;
+
+    m_pRasterizerState.Reset();
+    m_Viewports.clear();
+    m_ScissorRects.clear();
+
+    m_pDepthStencilState.Reset();
+    m_StencilRef = 0;
+
+    m_RenderTargetViews.clear();
+    m_pDepthStencilView.Reset();
+    m_UAVStartSlot = 0;
+    m_UnorderedAccessViews.clear();
+}
+
+void StateCacheDX11::EndFrame()
+{
+    m_Statistics.Frames = 1;
+    m_FrameStatistics = m_Statistics;
+
+    m_TotalStatistics.Add( m_Statistics );
+    ++m_TotalStatistics.Frames;
+
+    m_Statistics.Reset();
+}
+
+const StateCacheStatistics& StateCacheDX11::GetStatistics() const
+{
+    return m_Statistics;
+}
+
+StateCacheStatistics& StateCacheDX11::GetStatistics()
+{
+    return m_Statistics;
+}
+
+const StateCacheStatistics& StateCacheDX11::GetFrameStatistics() const
+{
+    return m_FrameStatistics;
+}
+
+const StateCacheStatistics& StateCacheDX11::GetTotalStatistics() const
+{
+    return m_TotalStatistics;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Shader.h>
+
+#include <bitset>
+
+#include <StateCacheStatistics.h>
+
+/**
+ * Shadows the state of a DirectX 11 device context and skips the state changes
+ * that would set a state that is already bound.
+ * The state cache is attached to the immediate device context (using the
+ * private data of the device context) so that every object that binds state
+ * can query it from the device context it already holds.
+ * All state changes on the device context must go through the state cache
+ * otherwise the shadowed state is out of sync with the device context.
+ *
+ * Each command list has a state cache for its deferred context. While a command
+ * list is recording, the objects that bind state use the state cache (and the
+ * device context) of the command list that is recording on the calling thread.
+ */
+class __declspec( uuid( "5F1E2A4C-8B3D-4E6A-9C7F-1D2B3A4C5E6F" ) ) StateCacheDX11
+{
+public:
+    StateCacheDX11( ID3D11DeviceContext2* pDeviceContext );
+    ~StateCacheDX11();
+
+    // Get the state cache that is attached to a device context.
+    static StateCacheDX11* Get( ID3D11DeviceContext* pDeviceContext );
+
+    // The state cache of the command list that is recording on the calling thread
+    // or pImmediate if no command list is recording on the calling thread.
+    static StateCacheDX11* GetCurrent( StateCacheDX11* pImmediate );
+    // Record the commands of the calling thread with a state cache (nullptr to stop recording).
+    static void SetRecording( StateCacheDX11* pStateCache );
+
+    // The device context the state cache issues the state changes to.
+    ID3D11DeviceContext2* GetDeviceContext() const;
+
+    void SetShader( Shader::ShaderType shaderType, ID3D11DeviceChild* pShader );
+    void SetInputLayout( ID3D11InputLayout* pInputLayout );
+
+    // Bind a range of a constant buffer if numConstants is not 0 (requires DirectX 11.1).
+    // The first constant and the number of constants are specified in shader constants (16 bytes).
+    void SetConstantBuffer( Shader::ShaderType shaderType, UINT slot, ID3D11Buffer* pBuffer, UINT firstConstant = 0, UINT numConstants = 0 );
+    void SetShaderResource( Shader::ShaderType shaderType, UINT slot, ID3D11ShaderResourceView* pShaderResourceView );
+    void SetSampler( Shader::ShaderType shaderType, UINT slot, ID3D11SamplerState* pSamplerState );
+    // Bind an unordered access view to the compute shader stage.
+    void SetUnorderedAccessView( UINT slot, ID3D11UnorderedAccessView* pUnorderedAccessView );
+
+    void SetVertexBuffer( UINT slot, ID3D11Buffer* pBuffer, UINT stride, UINT offset );
+    void SetIndexBuffer( ID3D11Buffer* pBuffer, DXGI_FORMAT format, UINT offset );
+    void SetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY primitiveTopology );
+
+    void SetBlendState( ID3D11BlendState* pBlendState, const FLOAT blendFactor[4], UINT sampleMask );
+    void SetRasterizerState( ID3D11RasterizerState* pRasterizerState );
+    void SetViewports( UINT numViewports, const D3D11_VIEWPORT* pViewports );
+    void SetScissorRects( UINT numRects, const D3D11_RECT* pRects );
+    void SetDepthStencilState( ID3D11DepthStencilState* pDepthStencilState, UINT stencilRef );
+
+    void SetRenderTargets( UINT numRTVs, ID3D11RenderTargetView* const* ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView,
+                           UINT uavStartSlot, UINT numUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews );
+
+    // Clear the state of the device context and the state cache.
+    // Should be called after third-party code has changed the state of the device context.
+    void Reset();
+
+    // Should be called once per frame.
+    // The counters of the frame become the counters of the last frame and are added to the totals.
+    void EndFrame();
+
+    // The counters of the frame that is being rendered.
+    const StateCacheStatistics& GetStatistics() const;
+    StateCacheStatistics& GetStatistics();
+    // The counters of the last frame that was ended.
+    const StateCacheStatistics& GetFrameStatistics() const;
+    // The counters of all frames that were ended.
+    const StateCacheStatistics& GetTotalStatistics() const;
+
+private:
+    // Mark all bound shader resource views as unknown.
+    // The runtime unbinds a shader resource view (without notifying the state cache)
+    // when its resource is bound as an output (render target, depth-stencil, or unordered access view).
+    void InvalidateShaderResources();
+
+    // Update a cached pointer. Returns true if the state change must be issued.
+    template<typename T>
+    bool Update( StateCacheStatistics::State state, Microsoft::WRL::ComPtr<T>& cachedValue, T* value );
+
+    static bool IsValidStage( Shader::ShaderType shaderType );
+    // Index of a shader stage in the per-stage arrays.
+    static UINT GetStage( Shader::ShaderType shaderType );
+
+    static const UINT NumStages = 6;
+
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+
+    StateCacheStatistics m_Statistics;
+    StateCacheStatistics m_FrameStatistics;
+    StateCacheStatistics m_TotalStatistics;
+
+    // The cache holds a reference to the bound objects so the address of
+    // a bound object cannot be reused by a new object.
+    Microsoft::WRL::ComPtr<ID3D11DeviceChild> m_Shaders[NumStages];
+    Microsoft::WRL::ComPtr<ID3D11InputLayout> m_pInputLayout;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_ConstantBuffers[NumStages][D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+    // The bound range of the constant buffers (0 constants if the whole buffer is bound).
+    struct ConstantBufferRange
+    {
+        UINT FirstConstant;
+        UINT NumConstants;
+    };
+    ConstantBufferRange m_ConstantBufferRanges[NumStages][D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_ShaderResourceViews[NumStages][D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT];
+    Microsoft::WRL::ComPtr<ID3D11SamplerState> m_SamplerStates[NumStages][D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT];
+    // Shader resource slots that are not valid must be set even if the cached view matches.
+    std::bitset<D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT> m_ValidShaderResourceViews[NumStages];
+
+    struct VertexBufferBinding
+    {
+        Microsoft::WRL::ComPtr<ID3D11Buffer> Buffer;
+        UINT Stride;
+        UINT Offset;
+    };
+    VertexBufferBinding m_VertexBuffers[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_pIndexBuffer;
+    DXGI_FORMAT m_IndexFormat;
+    UINT m_IndexOffset;
+
+    D3D11_PRIMITIVE_TOPOLOGY m_PrimitiveTopology;
+
+    Microsoft::WRL::ComPtr<ID3D11BlendState> m_pBlendState;
+    FLOAT m_BlendFactor[4];
+    UINT m_SampleMask;
+
+    Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_pRasterizerState;
+    std::vector<D3D11_VIEWPORT> m_Viewports;
+    std::vector<D3D11_RECT> m_ScissorRects;
+
+    Microsoft::WRL::ComPtr<ID3D11DepthStencilState> m_pDepthStencilState;
+    UINT m_StencilRef;
+
+    std::vector< Microsoft::WRL::ComPtr<ID3D11RenderTargetView> > m_RenderTargetViews;
+    Microsoft::WRL::ComPtr<ID3D11DepthStencilView> m_pDepthStencilView;
+    UINT m_UAVStartSlot;
+    std::vector< Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> > m_UnorderedAccessViews;
+};
+
+template<typename T>
+bool StateCacheDX11::Update( StateCacheStatistics::State state, Microsoft::WRL::ComPtr<T>& cachedValue, T* value )
+{
+    if ( cachedValue.Get() == value )
+    {
+        m_Statistics.Skip( state );
+        return false;
+    }
+
+    cachedValue = value;
+    m_Statistics.Issue( state );
+    return true;
+}
@@ -0,0 +1,110 @@
+#include <EnginePCH.h>
+
+#include "StateObjectCacheDX11.h"
+
+using Microsoft::WRL::ComPtr;
+
+StateObjectCacheDX11::StateObjectCacheDX11( ID3D11Device2* pDevice )
+    : m_pDevice( pDevice )
+{
+    StateObjectCacheDX11* pStateObjectCache = this;
+    if ( FAILED( m_pDevice->SetPrivateData( __uuidof( StateObjectCacheDX11 ), sizeof( pStateObjectCache ), &pStateObjectCache ) ) )
+    {
+        ReportError( "Failed to attach the state object cache to the device." );
+    }
+}
+
+StateObjectCacheDX11::~StateObjectCacheDX11()
+{
+    m_pDevice->SetPrivateData( __uuidof( StateObjectCacheDX11 ), 0, nullptr );
+}
+
+StateObjectCacheDX11* StateObjectCacheDX11::Get( ID3D11Device* pDevice )
+{
+    StateObjectCacheDX11* pStateObjectCache = nullptr;
+    UINT dataSize = sizeof( pStateObjectCache );
+
+    if ( FAILED( pDevice->GetPrivateData( __uuidof( StateObjectCacheDX11 ), &dataSize, &pStateObjectCache ) ) || pStateObjectCache == nullptr )
+    {
+        ReportError( "No state object cache is attached to the device." );
+    }
+
+    return pStateObjectCache;
+}
+
+ID3D11BlendState1* StateObjectCacheDX11::GetBlendState( const D3D11_BLEND_DESC1& blendDesc )
+{
+    return m_BlendStates.GetOrCreate( blendDesc, [this]( const D3D11_BLEND_DESC1& desc )
+    {
+        ComPtr<ID3D11BlendState1> pBlendState;
+        if ( FAILED( m_pDevice->CreateBlendState1( &desc, &pBlendState ) ) )
+        {
+            ReportError( "Failed to create blend state." );
+        }
+        return pBlendState;
+    } ).Get();
+}
+
+ID3D11RasterizerState1* StateObjectCacheDX11::GetRasterizerState( const D3D11_RASTERIZER_DESC1& rasterizerDesc )
+{
+    return m_RasterizerStates.GetOrCreate( rasterizerDesc, [this]( const D3D11_RASTERIZER_DESC1& desc )
+    {
+        ComPtr<ID3D11RasterizerState1> pRasterizerState;
+        if ( FAILED( m_pDevice->CreateRasterizerState1( &desc, &pRasterizerState ) ) )
+        {
+            ReportError( "Failed to create rasterizer state." );
+        }
+        return pRasterizerState;
+    } ).Get();
+}
+
+ID3D11DepthStencilState* StateObjectCacheDX11::GetDepthStencilState( const D3D11_DEPTH_STENCIL_DESC& depthStencilDesc )
+{
+    return m_DepthStencilStates.GetOrCreate( depthStencilDesc, [this]( const D3D11_DEPTH_STENCIL_DESC& desc )
+    {
+        ComPtr<ID3D11DepthStencilState> pDepthStencilState;
+        if ( FAILED( m_pDevice->CreateDepthStencilState( &desc, &pDepthStencilState ) ) )
+        {
+            ReportError( "Failed to create depth stencil state." );
+        }
+        return pDepthStencilState;
+    } ).Get();
+}
+
+ID3D11SamplerState* StateObjectCacheDX11::GetSamplerState( const D3D11_SAMPLER_DESC& samplerDesc )
+{
+    return m_SamplerStates.GetOrCreate( samplerDesc, [this]( const D3D11_SAMPLER_DESC& desc )
+    {
+        ComPtr<ID3D11SamplerState> pSamplerState;
+        if ( FAILED( m_pDevice->CreateSamplerState( &desc, &pSamplerState ) ) )
+        {
+            ReportError( "Failed to create sampler state." );
+        }
+        return pSamplerState;
+    } ).Get();
+}
+
+const PipelineObjectDX11& StateObjectCacheDX11::GetPipeline( const PipelineDescDX11& pipelineDesc )
+{
+    return m_Pipelines.GetOrCreate( pipelineDesc, [this]( const PipelineDescDX11& desc )
+    {
+        // The state objects are shared with the blend, rasterizer and depth-stencil states with the same description.
+        PipelineObjectDX11 pipeline;
+        pipeline.BlendState = GetBlendState( desc.BlendDesc );
+        pipeline.RasterizerState = GetRasterizerState( desc.RasterizerDesc );
+        pipeline.DepthStencilState = GetDepthStencilState( desc.DepthStencilDesc );
+        return pipeline;
+    } );
+}
+
+void StateObjectCacheDX11::Report( const std::string& deviceName ) const
+{
+    std::stringstream ss;
+    ss << deviceName << " state object cache:" << std::endl;
+    m_BlendStates.Report( ss, "BlendState" );
+    m_RasterizerStates.Report( ss, "RasterizerState" );
+    m_DepthStencilStates.Report( ss, "DepthStencilState" );
+    m_SamplerStates.Report( ss, "SamplerState" );
+    m_Pipelines.Report( ss, "Pipeline" );
+    OutputDebugStringA( ss.str().c_str() );
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../StateObjectCache.h"
+
+/**
+ * The description of the fixed function state of a pipeline.
+ * The shaders are not part of the description: DirectX 11 binds them separately,
+ * so pipelines that only differ in their shaders share the same state objects.
+ * Must be zero-initialized before it is filled in.
+ */
+struct PipelineDescDX11
+{
+    D3D11_BLEND_DESC1 BlendDesc;
+    D3D11_RASTERIZER_DESC1 RasterizerDesc;
+    D3D11_DEPTH_STENCIL_DESC DepthStencilDesc;
+};
+
+/**
+ * The state objects that are shared by all pipelines with the same description.
+ */
+struct PipelineObjectDX11
+{
+    Microsoft::WRL::ComPtr<ID3D11BlendState1> BlendState;
+    Microsoft::WRL::ComPtr<ID3D11RasterizerState1> RasterizerState;
+    Microsoft::WRL::ComPtr<ID3D11DepthStencilState> DepthStencilState;
+};
+
+/**
+ * Creates the immutable state objects of a DirectX 11 device.
+ * Each unique description is only created once and is shared by every
+ * blend, rasterizer, depth-stencil, sampler and pipeline state that uses it,
+ * so (re)creating a state with a known description is a lookup.
+ * The cache is attached to the device (using the private data of the device)
+ * so every state can query it from the device it already holds.
+ * States may be created and bound on any thread (for example by the command lists
+ * that are recorded by the job system), so every cache has a lock.
+ */
+class __declspec( uuid( "8C3B6E1D-2A4F-4B7C-9D5E-6F1A2B3C4D5E" ) ) StateObjectCacheDX11
+{
+public:
+    StateObjectCacheDX11( ID3D11Device2* pDevice );
+    ~StateObjectCacheDX11();
+
+    // Get the state object cache that is attached to a device.
+    static StateObjectCacheDX11* Get( ID3D11Device* pDevice );
+
+    ID3D11BlendState1* GetBlendState( const D3D11_BLEND_DESC1& blendDesc );
+    ID3D11RasterizerState1* GetRasterizerState( const D3D11_RASTERIZER_DESC1& rasterizerDesc );
+    ID3D11DepthStencilState* GetDepthStencilState( const D3D11_DEPTH_STENCIL_DESC& depthStencilDesc );
+    ID3D11SamplerState* GetSamplerState( const D3D11_SAMPLER_DESC& samplerDesc );
+
+    const PipelineObjectDX11& GetPipeline( const PipelineDescDX11& pipelineDesc );
+
+    // Log the number of unique objects and the cache hits and misses.
+    void Report( const std::string& deviceName ) const;
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
+
+    StateObjectCache< D3D11_BLEND_DESC1, Microsoft::WRL::ComPtr<ID3D11BlendState1> > m_BlendStates;
+    StateObjectCache< D3D11_RASTERIZER_DESC1, Microsoft::WRL::ComPtr<ID3D11RasterizerState1> > m_RasterizerStates;
+    StateObjectCache< D3D11_DEPTH_STENCIL_DESC, Microsoft::WRL::ComPtr<ID3D11DepthStencilState> > m_DepthStencilStates;
+    StateObjectCache< D3D11_SAMPLER_DESC, Microsoft::WRL::ComPtr<ID3D11SamplerState> > m_SamplerStates;
+    StateObjectCache< PipelineDescDX11, PipelineObjectDX11 > m_Pipelines;
+};
@@ -2,6 +2,7 @@
 
 #include <Shader.h>
 
+#include "StateCacheDX11.h"
 #include "StructuredBufferDX11.h"
 
 StructuredBufferDX11::StructuredBufferDX11( ID3D11Device2* pDevice, UINT bindFlags, const void* data, size_t count, UINT stride, CPUAccess cpuAccess, bool bUAV )
@@ -99,6 +100,7 @@ StructuredBufferDX11::StructuredBufferDX11( ID3D11Device2* pDevice, UINT bindFla
     }
 
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 }
 
 StructuredBufferDX11::~StructuredBufferDX11()
@@ -106,6 +108,8 @@ StructuredBufferDX11::~StructuredBufferDX11()
 
 bool StructuredBufferDX11::Bind( unsigned int ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
+
     assert( m_pDeviceContext );
 
     if ( m_bIsDirty )
@@ -116,39 +120,11 @@ bool StructuredBufferDX11::Bind( unsigned int ID, Shader::ShaderType shaderType,
 
     if ( parameterType == ShaderParameter::Type::Buffer && m_pSRV )
     {
-        ID3D11ShaderResourceView* srv[] = { m_pSRV.Get() };
-
-        switch ( shaderType )
-        {
-        case Shader::VertexShader:
-            m_pDeviceContext->VSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::TessellationControlShader:
-            m_pDeviceContext->HSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::TessellationEvaluationShader:
-            m_pDeviceContext->DSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::GeometryShader:
-            m_pDeviceContext->GSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::PixelShader:
-            m_pDeviceContext->PSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::ComputeShader:
-            m_pDeviceContext->CSSetShaderResources( ID, 1, srv );
-            break;
-        }
+        pStateCache->SetShaderResource( shaderType, ID, m_pSRV.Get() );
     }
-    else if ( parameterType == ShaderParameter::Type::RWBuffer && m_pUAV )
+    else if ( parameterType == ShaderParameter::Type::RWBuffer && m_pUAV && shaderType == Shader::ComputeShader )
     {
-        ID3D11UnorderedAccessView* uav[] = { m_pUAV.Get() };
-        switch ( shaderType )
-        {
-        case Shader::ComputeShader:
-            m_pDeviceContext->CSSetUnorderedAccessViews( ID, 1, uav, nullptr );
-            break;
-        }
+        pStateCache->SetUnorderedAccessView( ID, m_pUAV.Get() );
     }
 
     return true;
@@ -156,43 +132,16 @@ bool StructuredBufferDX11::Bind( unsigned int ID, Shader::ShaderType shaderType,
 
 void StructuredBufferDX11::UnBind( unsigned int ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
-    ID3D11UnorderedAccessView* uav[] = { nullptr };
-    ID3D11ShaderResourceView* srv[] = { nullptr };
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
 
     if ( parameterType == ShaderParameter::Type::Buffer )
     {
-        switch ( shaderType )
-        {
-        case Shader::VertexShader:
-            m_pDeviceContext->VSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::TessellationControlShader:
-            m_pDeviceContext->HSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::TessellationEvaluationShader:
-            m_pDeviceContext->DSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::GeometryShader:
-            m_pDeviceContext->GSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::PixelShader:
-            m_pDeviceContext->PSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::ComputeShader:
-            m_pDeviceContext->CSSetShaderResources( ID, 1, srv );
-            break;
-        }
+        pStateCache->SetShaderResource( shaderType, ID, nullptr );
     }
-    else if ( parameterType == ShaderParameter::Type::RWBuffer )
+    else if ( parameterType == ShaderParameter::Type::RWBuffer && shaderType == Shader::ComputeShader )
     {
-        switch ( shaderType )
-        {
-        case Shader::ComputeShader:
-            m_pDeviceContext->CSSetUnorderedAccessViews( ID, 1, uav, nullptr );
-            break;
-        }
+        pStateCache->SetUnorderedAccessView( ID, nullptr );
     }
-
 }
 
 void StructuredBufferDX11::SetData( void* data, size_t elementSize, size_t offset, size_t numElements )
@@ -206,12 +155,14 @@ void StructuredBufferDX11::SetData( void* data, size_t elementSize, size_t offse
 
 void StructuredBufferDX11::Commit()
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     if ( m_bIsDirty && m_bDynamic && m_pBuffer )
     {
         D3D11_MAPPED_SUBRESOURCE mappedResource;
         // Copy the contents of the data buffer to the GPU.
 
-        if ( FAILED( m_pDeviceContext->Map( m_pBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource ) ) )
+        if ( FAILED( pDeviceContext->Map( m_pBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource ) ) )
         {
             ReportError( "Failed to map subresource." );
         }
@@ -219,7 +170,7 @@ void StructuredBufferDX11::Commit()
         size_t sizeInBytes = m_Data.size();
         memcpy_s( mappedResource.pData, sizeInBytes, m_Data.data(), sizeInBytes );
 
-        m_pDeviceContext->Unmap( m_pBuffer.Get(), 0 );
+        pDeviceContext->Unmap( m_pBuffer.Get(), 0 );
 
         m_bIsDirty = false;
     }
@@ -227,6 +178,8 @@ void StructuredBufferDX11::Commit()
 
 void StructuredBufferDX11::Copy( std::shared_ptr<StructuredBuffer> other )
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     std::shared_ptr<StructuredBufferDX11> srcBuffer = std::dynamic_pointer_cast<StructuredBufferDX11>( other );
 
     if ( srcBuffer->m_bIsDirty )
@@ -238,7 +191,7 @@ void StructuredBufferDX11::Copy( std::shared_ptr<StructuredBuffer> other )
     if ( srcBuffer && srcBuffer.get() != this &&
          m_uiCount * m_uiStride == srcBuffer->m_uiCount * srcBuffer->m_uiStride )
     {
-        m_pDeviceContext->CopyResource( m_pBuffer.Get(), srcBuffer->m_pBuffer.Get() );
+        pDeviceContext->CopyResource( m_pBuffer.Get(), srcBuffer->m_pBuffer.Get() );
     }
     else
     {
@@ -268,10 +221,12 @@ void StructuredBufferDX11::Copy( std::shared_ptr<Buffer> other )
 
 void StructuredBufferDX11::Clear()
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     if ( m_pUAV )
     {
         FLOAT clearColor[4] = { 0, 0, 0, 0 };
-        m_pDeviceContext->ClearUnorderedAccessViewFloat( m_pUAV.Get(), clearColor );
+        pDeviceContext->ClearUnorderedAccessViewFloat( m_pUAV.Get(), clearColor );
     }
 }
 
@@ -3,6 +3,8 @@
 #include <StructuredBuffer.h>
 #include <CPUAccess.h>
 
+class StateCacheDX11;
+
 class StructuredBufferDX11 : public StructuredBuffer
 {
 public:
@@ -39,6 +41,7 @@ protected:
 private:
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
     Microsoft::WRL::ComPtr<ID3D11Buffer> m_pBuffer;
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_pSRV;
     Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_pUAV;
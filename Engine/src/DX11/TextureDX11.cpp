@@ -1,7 +1,25 @@
 #include <EnginePCH.h>
+#include <Application.h>
+#include <AssetCache.h>
+#include <ContentHash.h>
+#include <JobSystem.h>
+#include <HighResolutionTimer.h>
 #include <Timer.h>
+#include "StateCacheDX11.h"
 #include "TextureDX11.h"
 
+// The file extension of processed textures in the asset cache.
+#define TEXTURE_CACHE_EXTENSION "dds"
+// Changing the version invalidates all of the processed textures in the asset cache.
+#define TEXTURE_CACHE_VERSION 2
+// The filter that is used to generate the mipmaps of imported textures.
+#define TEXTURE_MIP_FILTER MipFilter::Kaiser
+// The alpha test reference value (see Material::AlphaThreshold).
+// The coverage of alpha tested textures is preserved for this value.
+#define TEXTURE_ALPHA_REFERENCE 0.1f
+// The number of rows of 4x4 blocks that are compressed per job.
+#define COMPRESSION_BATCH_SIZE 16
+
 static void ReportAndThrowTextureFormatError( const Texture::TextureFormat& format, const std::string& file, int line, const std::string& function, const std::string& message )
 {
     std::stringstream ss;
@@ -53,8 +71,8 @@ static void ReportAndThrowTextureFormatError( const Texture::TextureFormat& form
     case Texture::Type::SignedInteger:
         ss << "SignedInteger" << std::endl;
         break;
-    default:
-        ss << "Unknown" << std::endl;
+    default:
+        ss << "Unknown" << std::endl;
         break;
     }
 
@@ -91,10 +109,12 @@ TextureDX11::TextureDX11( ID3D11Device2* pDevice )
     , m_BPP( 0 )
     , m_Pitch( 0 )
     , m_bIsTransparent( false )
+    , m_TextureUsage( TextureUsage::Color )
     , m_bFileChanged( false )
     , m_bIsDirty( false )
 {
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 
     m_Connections.push_back( m_DependencyTracker.FileChanged += boost::bind( &TextureDX11::OnFileChanged, this, _1 ) );
 }
@@ -110,10 +130,12 @@ TextureDX11::TextureDX11( ID3D11Device2* pDevice, uint16_t width, uint16_t slice
     , m_BPP( 0 )
     , m_Pitch( 0 )
     , m_bIsTransparent( false )
+    , m_TextureUsage( TextureUsage::Color )
     , m_bFileChanged( false )
     , m_bIsDirty( false )
 {
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 
     m_Connections.push_back( m_DependencyTracker.FileChanged += boost::bind( &TextureDX11::OnFileChanged, this, _1 ) );
 
@@ -194,10 +216,12 @@ TextureDX11::TextureDX11( ID3D11Device2* pDevice, uint16_t width, uint16_t heigh
     , m_CPUAccess( cpuAccess )
     , m_bGenerateMipmaps( false )
     , m_bIsTransparent( true )
+    , m_TextureUsage( TextureUsage::Color )
     , m_bFileChanged( false )
     , m_bIsDirty( false )
 {
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 
     m_Connections.push_back( m_DependencyTracker.FileChanged += boost::bind( &TextureDX11::OnFileChanged, this, _1 ) );
 
@@ -269,6 +293,7 @@ TextureDX11::TextureDX11( Tex3DCtor, ID3D11Device2* pDevice, uint16_t width, uin
     : m_bFileChanged( false )
 {
     m_pDevice->GetImmediateContext2( &m_pDeviceContext );
+    m_pStateCache = StateCacheDX11::Get( m_pDeviceContext.Get() );
 
     m_Connections.push_back( m_DependencyTracker.FileChanged += boost::bind( &TextureDX11::OnFileChanged, this, _1 ) );
 
@@ -433,26 +458,78 @@ void PrintMetaData( FREE_IMAGE_MDMODEL model, FIBITMAP* dib )
     }
 }
 
-bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
+TextureDX11::ImageData::ImageData()
+    : Bitmap( nullptr )
+    , Usage( TextureUsage::Color )
+    , Format( DXGI_FORMAT_UNKNOWN )
+    , BPP( 0 )
+    , CompressedFormat( DXGI_FORMAT_UNKNOWN )
+    , IsTransparent( false )
+    , FromCache( false )
+{}
+
+TextureDX11::ImageData::~ImageData()
+{
+    if ( Bitmap )
+    {
+        FreeImage_Unload( Bitmap );
+    }
+}
+
+bool TextureDX11::ImageData::IsValid() const
+{
+    return Bitmap != nullptr || !Mipmaps.Levels.empty();
+}
+
+size_t TextureDX11::ImageData::GetMemorySize() const
+{
+    return ( Bitmap ? FreeImage_GetMemorySize( Bitmap ) : 0 ) + Mipmaps.Data.size();
+}
+
+bool TextureDX11::DecodeImage( const std::wstring& fileName, ImageData& image, TextureUsage usage )
 {
     fs::path filePath( fileName );
+    image.FileName = fileName;
+    image.Usage = usage;
+
     if ( !fs::exists( filePath ) || !fs::is_regular_file( filePath ) )
     {
-        ReportError( "Could not load texture: " + filePath.string() );
+        image.Error = "Could not load texture: " + filePath.string();
         return false;
     }
 
-    m_TextureFileName = fileName;
-    m_DependencyTracker = DependencyTracker( fileName );
-    // Try to load the dependency file for the texture asset.
-    if ( !m_DependencyTracker.Load() )
+    // The processed texture is stored in the asset cache. Its key is the hash of the
+    // contents of the image file, the way the texture is used and the processing settings.
+    AssetCache& assetCache = Application::Get().GetAssetCache();
+    AssetCache::Key sourceHash = 0;
+    AssetCache::HashFile( fileName, sourceHash );
+
+    ContentHash cacheKey;
+    const uint32_t version = TEXTURE_CACHE_VERSION;
+    const MipFilter mipFilter = TEXTURE_MIP_FILTER;
+    const float alphaReference = TEXTURE_ALPHA_REFERENCE;
+    cacheKey.Update( &version, sizeof( version ) );
+    cacheKey.Update( &usage, sizeof( usage ) );
+    cacheKey.Update( &mipFilter, sizeof( mipFilter ) );
+    cacheKey.Update( &alphaReference, sizeof( alphaReference ) );
+    cacheKey.Update( &sourceHash, sizeof( sourceHash ) );
+
+    std::wstring cacheFileName = assetCache.GetCachedFileName( cacheKey.GetHash(), TEXTURE_CACHE_EXTENSION );
+
+    if ( sourceHash != 0 && assetCache.Contains( cacheKey.GetHash(), TEXTURE_CACHE_EXTENSION ) )
     {
-        // If loading failed, likely, the dependency tracker file
-        // does not exist. Save the default dependency tracker.
-        m_DependencyTracker.Save();
-    }
+        // If the cached texture can't be read, the image is decoded again.
+        if ( LoadDDS( cacheFileName, image.Mipmaps ) )
+        {
+            image.Format = image.Mipmaps.Format;
+            image.BPP = static_cast<uint8_t>( image.Mipmaps.SourceBitsPerPixel );
+            image.IsTransparent = image.Mipmaps.IsTransparent;
+            image.FromCache = true;
+            return true;
+        }
 
-    m_DependencyTracker.SetLastLoadTime();
+        image.Mipmaps = TextureImage();
+    }
 
     // Try to determine the file type from the image file.
     FREE_IMAGE_FORMAT fif = FreeImage_GetFileTypeU( filePath.c_str() );
@@ -463,30 +540,25 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
 
     if ( fif == FIF_UNKNOWN || !FreeImage_FIFSupportsReading( fif ) )
     {
-        ReportError( "Unknow file format: " + filePath.string() );
+        image.Error = "Unknow file format: " + filePath.string();
         return false;
     }
 
     FIBITMAP* dib = FreeImage_LoadU( fif, filePath.c_str() );
     if ( dib == nullptr || FreeImage_HasPixels( dib ) == FALSE )
     {
-        ReportError( "Failed to load image: " + filePath.string() );
+        image.Error = "Failed to load image: " + filePath.string();
         return false;
     }
 
-    //// Check to see if we need to flip the image
-    //for ( int model = 0; model < FIMD_EXIF_RAW + 1; model++ )
-    //{
-    //    PrintMetaData( (FREE_IMAGE_MDMODEL)model, dib );
-    //}
-
-    m_BPP = FreeImage_GetBPP( dib );
+    image.Bitmap = dib;
+    image.BPP = FreeImage_GetBPP( dib );
     FREE_IMAGE_TYPE imageType = FreeImage_GetImageType( dib );
 
     // Check to see if the texture has an alpha channel.
-    m_bIsTransparent = ( FreeImage_IsTransparent( dib ) == TRUE );
+    image.IsTransparent = ( FreeImage_IsTransparent( dib ) == TRUE );
 
-    switch ( m_BPP )
+    switch ( image.BPP )
     {
     case 8:
     {
@@ -494,12 +566,7 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
         {
         case FIT_BITMAP:
         {
-            m_TextureResourceFormat = DXGI_FORMAT_R8_UNORM;
-        }
-        break;
-        default:
-        {
-            ReportError( "Unknown image format." );
+            image.Format = DXGI_FORMAT_R8_UNORM;
         }
         break;
         }
@@ -511,22 +578,17 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
         {
         case FIT_BITMAP:
         {
-            m_TextureResourceFormat = DXGI_FORMAT_R8G8_UNORM;
+            image.Format = DXGI_FORMAT_R8G8_UNORM;
         }
         break;
         case FIT_UINT16:
         {
-            m_TextureResourceFormat = DXGI_FORMAT_R16_UINT;
+            image.Format = DXGI_FORMAT_R16_UINT;
         }
         break;
         case FIT_INT16:
         {
-            m_TextureResourceFormat = DXGI_FORMAT_R16_SINT;
-        }
-        break;
-        default:
-        {
-            ReportError( "Unknown image format." );
+            image.Format = DXGI_FORMAT_R16_SINT;
         }
         break;
         }
@@ -539,30 +601,25 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
         case FIT_BITMAP:
         {
 #if FREEIMAGE_COLORORDER == FREEIMAGE_COLORORDER_BGR
-            m_TextureResourceFormat = DXGI_FORMAT_B8G8R8A8_UNORM;
+            image.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
 #else
-            m_TextureResourceFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+            image.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 #endif
         }
         break;
         case FIT_FLOAT:
         {
-            m_TextureResourceFormat = DXGI_FORMAT_R32_FLOAT;
+            image.Format = DXGI_FORMAT_R32_FLOAT;
         }
         break;
         case FIT_INT32:
         {
-            m_TextureResourceFormat = DXGI_FORMAT_R32_SINT;
+            image.Format = DXGI_FORMAT_R32_SINT;
         }
         break;
         case FIT_UINT32:
         {
-            m_TextureResourceFormat = DXGI_FORMAT_R32_UINT;
-        }
-        break;
-        default:
-        {
-            ReportError( "Unknown image format." );
+            image.Format = DXGI_FORMAT_R32_UINT;
         }
         break;
         }
@@ -575,25 +632,220 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
         // Unload the original image.
         FreeImage_Unload( dib );
 
-        dib = dib32;
+        image.Bitmap = dib32;
 
         // Update pixel bit depth (should be 32 now if it wasn't before).
-        m_BPP = FreeImage_GetBPP( dib );
+        image.BPP = FreeImage_GetBPP( dib32 );
 
 #if FREEIMAGE_COLORORDER == FREEIMAGE_COLORORDER_BGR
-        m_TextureResourceFormat = DXGI_FORMAT_B8G8R8A8_UNORM;
+        image.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
 #else
-        m_TextureResourceFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+        image.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 #endif
     }
     break;
     }
 
+    if ( image.Format == DXGI_FORMAT_UNKNOWN )
+    {
+        image.Error = "Unknown image format: " + filePath.string();
+        return false;
+    }
+
+    // Generate the mipmaps. They are compressed and stored in the asset cache by CompressImage.
+    // Formats that are not supported keep the decoded image and generate the mipmaps on the GPU.
+    if ( CanGenerateMipmaps( image.Format ) )
+    {
+        GenerateMipmaps( FreeImage_GetBits( image.Bitmap ), FreeImage_GetWidth( image.Bitmap ), FreeImage_GetHeight( image.Bitmap ),
+                         FreeImage_GetPitch( image.Bitmap ), image.Format, image.IsTransparent, usage, mipFilter, alphaReference, image.Mipmaps );
+
+        FreeImage_Unload( image.Bitmap );
+        image.Bitmap = nullptr;
+
+        image.CompressedFormat = GetCompressedFormat( image.Mipmaps, usage );
+        if ( sourceHash != 0 )
+        {
+            image.CacheFileName = cacheFileName;
+        }
+    }
+
+    return true;
+}
+
+void TextureDX11::CompressImage( ImageData& image )
+{
+    if ( image.CompressedFormat != DXGI_FORMAT_UNKNOWN )
+    {
+        TextureImage compressedImage;
+        CompressTexture( image.Mipmaps, image.CompressedFormat, compressedImage );
+
+        image.Mipmaps = std::move( compressedImage );
+        image.Format = image.CompressedFormat;
+        image.CompressedFormat = DXGI_FORMAT_UNKNOWN;
+    }
+
+    if ( !image.CacheFileName.empty() )
+    {
+        if ( !SaveDDS( image.CacheFileName, image.Mipmaps ) )
+        {
+            std::stringstream ss;
+            ss << "Failed to store texture in the asset cache: " << ConvertString( image.FileName ) << std::endl;
+            OutputDebugStringA( ss.str().c_str() );
+        }
+        image.CacheFileName.clear();
+    }
+}
+
+void TextureDX11::ProcessImages( JobSystem& jobSystem, const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages,
+                                 std::vector< std::unique_ptr<ImageData> >& images, ProcessingStatistics* statistics )
+{
+    HighResolutionTimer timer;
+
+    // Decode the images in parallel.
+    images.resize( fileNames.size() );
+    jobSystem.ParallelFor( (uint32_t)fileNames.size(), 1, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        for ( uint32_t i = begin; i < end; ++i )
+        {
+            images[i].reset( new ImageData() );
+            try
+            {
+                DecodeImage( fileNames[i], *images[i], i < usages.size() ? usages[i] : TextureUsage::Color );
+            }
+            catch ( std::exception* e )
+            {
+                // ReportError throws a pointer to the exception.
+                // Errors are reported when the texture is created.
+                images[i]->Error = e->what();
+                delete e;
+            }
+            catch ( const std::exception& e )
+            {
+                images[i]->Error = e.what();
+            }
+        }
+    } );
+
+    timer.Tick();
+    double decodeTime = timer.ElapsedMilliSeconds();
+
+    // Compress the images that were not loaded from the asset cache.
+    // The rows of blocks of all images are compressed in parallel.
+    std::vector<TextureImage> compressedImages( images.size() );
+    // The first row of each image in the combined list of rows.
+    std::vector<uint32_t> firstRows( images.size() + 1, 0 );
+    size_t numCompressed = 0, compressedSourceBytes = 0;
+    for ( size_t i = 0; i < images.size(); ++i )
+    {
+        ImageData& image = *images[i];
+        uint32_t numRows = 0;
+        if ( image.CompressedFormat != DXGI_FORMAT_UNKNOWN )
+        {
+            numRows = PrepareCompression( image.Mipmaps, image.CompressedFormat, compressedImages[i] );
+            compressedSourceBytes += image.Mipmaps.Data.size();
+            ++numCompressed;
+        }
+        firstRows[i + 1] = firstRows[i] + numRows;
+    }
+
+    jobSystem.ParallelFor( firstRows.back(), COMPRESSION_BATCH_SIZE, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        // Find the image of the first row of the batch (a batch can contain rows of several images).
+        size_t i = std::upper_bound( firstRows.begin(), firstRows.end(), begin ) - firstRows.begin() - 1;
+        for ( ; begin < end; ++i )
+        {
+            uint32_t imageEnd = std::min( end, firstRows[i + 1] );
+            if ( imageEnd > begin )
+            {
+                CompressBlockRows( images[i]->Mipmaps, compressedImages[i], begin - firstRows[i], imageEnd - firstRows[i] );
+                begin = imageEnd;
+            }
+        }
+    } );
+
+    for ( size_t i = 0; i < images.size(); ++i )
+    {
+        ImageData& image = *images[i];
+        if ( image.CompressedFormat != DXGI_FORMAT_UNKNOWN )
+        {
+            image.Mipmaps = std::move( compressedImages[i] );
+            image.Format = image.CompressedFormat;
+            image.CompressedFormat = DXGI_FORMAT_UNKNOWN;
+        }
+    }
+
+    timer.Tick();
+    double compressionTime = timer.ElapsedMilliSeconds();
+
+    // Store the processed images in the asset cache.
+    jobSystem.ParallelFor( (uint32_t)images.size(), 1, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        for ( uint32_t i = begin; i < end; ++i )
+        {
+            CompressImage( *images[i] );
+        }
+    } );
+
+    timer.Tick();
+
+    if ( statistics )
+    {
+        statistics->DecodeTime = decodeTime;
+        statistics->CompressionTime = compressionTime;
+        statistics->StoreTime = timer.ElapsedMilliSeconds();
+        statistics->NumCompressed = numCompressed;
+        statistics->CompressedSourceBytes = compressedSourceBytes;
+    }
+}
+
+bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
+{
+    ImageData image;
+    if ( !DecodeImage( fileName, image, m_TextureUsage ) )
+    {
+        ReportError( image.Error );
+        return false;
+    }
+    CompressImage( image );
+
+    return LoadTexture2D( image );
+}
+
+bool TextureDX11::LoadTexture2D( ImageData& image )
+{
+    if ( !image.IsValid() )
+    {
+        ReportError( image.Error );
+        return false;
+    }
+
+    m_TextureFileName = image.FileName;
+    m_TextureUsage = image.Usage;
+    m_DependencyTracker = DependencyTracker( image.FileName );
+    // Try to load the dependency file for the texture asset.
+    if ( !m_DependencyTracker.Load() )
+    {
+        // If loading failed, likely, the dependency tracker file
+        // does not exist. Save the default dependency tracker.
+        m_DependencyTracker.Save();
+    }
+
+    m_DependencyTracker.SetLastLoadTime();
+
+    FIBITMAP* dib = image.Bitmap;
+    const TextureImage& mipmaps = image.Mipmaps;
+    // Use the mip chain that was generated on the CPU if there is one.
+    const bool hasMipmaps = !mipmaps.Levels.empty();
+
+    m_BPP = image.BPP;
+    m_bIsTransparent = image.IsTransparent;
+    m_TextureResourceFormat = image.Format;
+
     m_TextureDimension = Texture::Dimension::Texture2D;
-    m_TextureWidth = FreeImage_GetWidth( dib );
-    m_TextureHeight = FreeImage_GetHeight( dib );
+    m_TextureWidth = hasMipmaps ? mipmaps.Levels[0].Width : FreeImage_GetWidth( dib );
+    m_TextureHeight = hasMipmaps ? mipmaps.Levels[0].Height : FreeImage_GetHeight( dib );
     m_NumSlices = 1;
-    m_Pitch = FreeImage_GetPitch( dib );
+    m_Pitch = hasMipmaps ? mipmaps.Levels[0].RowPitch : FreeImage_GetPitch( dib );
 
     m_ShaderResourceViewFormat = m_RenderTargetViewFormat = m_TextureResourceFormat;
     m_SampleDesc = GetSupportedSampleCount( m_TextureResourceFormat, 1 );
@@ -611,14 +863,16 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
     m_ShaderResourceViewFormatSupport = m_RenderTargetViewFormatSupport = m_TextureResourceFormatSupport;
 
     // Can mipmaps be automatically generated for this texture format?
-    m_bGenerateMipmaps = !m_bDynamic && ( m_ShaderResourceViewFormatSupport & D3D11_FORMAT_SUPPORT_MIP_AUTOGEN ) != 0;
+    // Not needed if the mipmaps have already been generated on the CPU.
+    m_bGenerateMipmaps = !hasMipmaps && !m_bDynamic && ( m_ShaderResourceViewFormatSupport & D3D11_FORMAT_SUPPORT_MIP_AUTOGEN ) != 0;
+    UINT mipLevels = hasMipmaps ? static_cast<UINT>( mipmaps.Levels.size() ) : 1;
 
     // Load the texture data into a GPU texture.
     D3D11_TEXTURE2D_DESC textureDesc = { 0 };
 
     textureDesc.Width = m_TextureWidth;
     textureDesc.Height = m_TextureHeight;
-    textureDesc.MipLevels = m_bGenerateMipmaps ? 0 : 1;
+    textureDesc.MipLevels = m_bGenerateMipmaps ? 0 : mipLevels;
     textureDesc.ArraySize = m_NumSlices;
     textureDesc.Format = m_TextureResourceFormat;
     textureDesc.SampleDesc.Count = 1;
@@ -635,14 +889,18 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
     textureDesc.CPUAccessFlags = 0;
     textureDesc.MiscFlags = m_bGenerateMipmaps ? D3D11_RESOURCE_MISC_GENERATE_MIPS : 0;
 
-    BYTE* textureData = FreeImage_GetBits( dib );
+    const BYTE* textureData = hasMipmaps ? mipmaps.Data.data() : FreeImage_GetBits( dib );
 
-    D3D11_SUBRESOURCE_DATA subresourceData;
-    subresourceData.pSysMem = textureData;
-    subresourceData.SysMemPitch = m_Pitch;
-    subresourceData.SysMemSlicePitch = 0;
+    // The initial data of each mip level.
+    std::vector<D3D11_SUBRESOURCE_DATA> subresourceData( mipLevels );
+    for ( UINT level = 0; level < mipLevels; ++level )
+    {
+        subresourceData[level].pSysMem = hasMipmaps ? textureData + mipmaps.Levels[level].Offset : textureData;
+        subresourceData[level].SysMemPitch = hasMipmaps ? mipmaps.Levels[level].RowPitch : m_Pitch;
+        subresourceData[level].SysMemSlicePitch = 0;
+    }
 
-    if ( FAILED( m_pDevice->CreateTexture2D( &textureDesc, m_bGenerateMipmaps ? nullptr : &subresourceData, &m_pTexture2D ) ) )
+    if ( FAILED( m_pDevice->CreateTexture2D( &textureDesc, m_bGenerateMipmaps ? nullptr : subresourceData.data(), &m_pTexture2D ) ) )
     {
         ReportError( "Failed to create texture." );
         return false;
@@ -653,7 +911,7 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
 
     resourceViewDesc.Format = m_ShaderResourceViewFormat;
     resourceViewDesc.ViewDimension = D3D_SRV_DIMENSION_TEXTURE2D;
-    resourceViewDesc.Texture2D.MipLevels = m_bGenerateMipmaps ? -1 : 1;
+    resourceViewDesc.Texture2D.MipLevels = m_bGenerateMipmaps ? -1 : mipLevels;
     resourceViewDesc.Texture2D.MostDetailedMip = 0;
 
     if ( FAILED( m_pDevice->CreateShaderResourceView( m_pTexture2D.Get(), &resourceViewDesc, &m_pShaderResourceView ) ) )
@@ -672,7 +930,12 @@ bool TextureDX11::LoadTexture2D( const std::wstring& fileName )
     m_bIsDirty = false;
 
     // Unload the texture (it should now be on the GPU anyways).
-    FreeImage_Unload( dib );
+    if ( dib )
+    {
+        FreeImage_Unload( dib );
+        image.Bitmap = nullptr;
+    }
+    image.Mipmaps = TextureImage();
 
     return true;
 }
@@ -1238,6 +1501,8 @@ void TextureDX11::FetchPixel( glm::ivec2 coord, uint8_t*& pixel, size_t size )
 
 void TextureDX11::Copy( std::shared_ptr<Texture> other )
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     std::shared_ptr<TextureDX11> srcTexture = std::dynamic_pointer_cast<TextureDX11>( other );
 
     if ( srcTexture && srcTexture.get() != this )
@@ -1250,15 +1515,15 @@ void TextureDX11::Copy( std::shared_ptr<Texture> other )
             {
             case Dimension::Texture1D:
             case Dimension::Texture1DArray:
-                m_pDeviceContext->CopyResource( m_pTexture1D.Get(), srcTexture->m_pTexture1D.Get() );
+                pDeviceContext->CopyResource( m_pTexture1D.Get(), srcTexture->m_pTexture1D.Get() );
                 break;
             case Texture::Dimension::Texture2D:
             case Texture::Dimension::Texture2DArray:
-                m_pDeviceContext->CopyResource( m_pTexture2D.Get(), srcTexture->m_pTexture2D.Get() );
+                pDeviceContext->CopyResource( m_pTexture2D.Get(), srcTexture->m_pTexture2D.Get() );
                 break;
             case Texture::Dimension::Texture3D:
             case Texture::Dimension::TextureCube:
-                m_pDeviceContext->CopyResource( m_pTexture3D.Get(), srcTexture->m_pTexture3D.Get() );
+                pDeviceContext->CopyResource( m_pTexture3D.Get(), srcTexture->m_pTexture3D.Get() );
                 break;
             }
         }
@@ -1286,9 +1551,11 @@ void TextureDX11::Copy( std::shared_ptr<Texture> other )
 
 void TextureDX11::Clear( ClearFlags clearFlags, const glm::vec4& color, float depth, uint8_t stencil )
 {
+    ID3D11DeviceContext2* pDeviceContext = StateCacheDX11::GetCurrent( m_pStateCache )->GetDeviceContext();
+
     if ( m_pRenderTargetView && ( (int)clearFlags & (int)ClearFlags::Color ) != 0 )
     {
-        m_pDeviceContext->ClearRenderTargetView( m_pRenderTargetView.Get(), glm::value_ptr( color ) );
+        pDeviceContext->ClearRenderTargetView( m_pRenderTargetView.Get(), glm::value_ptr( color ) );
     }
 
     {
@@ -1297,7 +1564,7 @@ void TextureDX11::Clear( ClearFlags clearFlags, const glm::vec4& color, float de
         flags |= ( (int)clearFlags & (int)ClearFlags::Stencil ) != 0 ? D3D11_CLEAR_STENCIL : 0;
         if ( m_pDepthStencilView && flags > 0 )
         {
-            m_pDeviceContext->ClearDepthStencilView( m_pDepthStencilView.Get(), flags, depth, stencil );
+            pDeviceContext->ClearDepthStencilView( m_pDepthStencilView.Get(), flags, depth, stencil );
         }
     }
 }
@@ -1309,6 +1576,8 @@ void TextureDX11::OnFileChanged( FileChangeEventArgs& e )
 
 void TextureDX11::Bind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
+
     if ( m_bFileChanged )
     {
         MutexLock lock( m_Mutex );
@@ -1352,81 +1621,27 @@ void TextureDX11::Bind( uint32_t ID, Shader::ShaderType shaderType, ShaderParame
         m_bIsDirty = false;
     }
 
-    ID3D11ShaderResourceView* srv[] = { m_pShaderResourceView.Get() };
-    ID3D11UnorderedAccessView* uav[] = { m_pUnorderedAccessView.Get() };
-
     if ( parameterType == ShaderParameter::Type::Texture && m_pShaderResourceView )
     {
-        switch ( shaderType )
-        {
-        case Shader::VertexShader:
-            m_pDeviceContext->VSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::TessellationControlShader:
-            m_pDeviceContext->HSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::TessellationEvaluationShader:
-            m_pDeviceContext->DSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::GeometryShader:
-            m_pDeviceContext->GSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::PixelShader:
-            m_pDeviceContext->PSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::ComputeShader:
-            m_pDeviceContext->CSSetShaderResources( ID, 1, srv );
-            break;
-        }
+        pStateCache->SetShaderResource( shaderType, ID, m_pShaderResourceView.Get() );
     }
-    else if ( parameterType == ShaderParameter::Type::RWTexture && m_pUnorderedAccessView )
+    else if ( parameterType == ShaderParameter::Type::RWTexture && m_pUnorderedAccessView && shaderType == Shader::ComputeShader )
     {
-        switch ( shaderType )
-        {
-        case Shader::ComputeShader:
-            m_pDeviceContext->CSSetUnorderedAccessViews( ID, 1, uav, nullptr );
-            break;
-        }
+        pStateCache->SetUnorderedAccessView( ID, m_pUnorderedAccessView.Get() );
     }
 
 }
 void TextureDX11::UnBind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
 {
-    ID3D11ShaderResourceView* srv[] = { nullptr };
-    ID3D11UnorderedAccessView* uav[] = { nullptr };
+    StateCacheDX11* pStateCache = StateCacheDX11::GetCurrent( m_pStateCache );
 
     if ( parameterType == ShaderParameter::Type::Texture )
     {
-        switch ( shaderType )
-        {
-        case Shader::VertexShader:
-            m_pDeviceContext->VSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::TessellationControlShader:
-            m_pDeviceContext->HSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::TessellationEvaluationShader:
-            m_pDeviceContext->DSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::GeometryShader:
-            m_pDeviceContext->GSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::PixelShader:
-            m_pDeviceContext->PSSetShaderResources( ID, 1, srv );
-            break;
-        case Shader::ComputeShader:
-            m_pDeviceContext->CSSetShaderResources( ID, 1, srv );
-            break;
-        }
+        pStateCache->SetShaderResource( shaderType, ID, nullptr );
     }
-    else if ( parameterType == ShaderParameter::Type::RWTexture )
+    else if ( parameterType == ShaderParameter::Type::RWTexture && shaderType == Shader::ComputeShader )
     {
-        switch ( shaderType )
-        {
-        case Shader::ComputeShader:
-            m_pDeviceContext->CSSetUnorderedAccessViews( ID, 1, uav, nullptr );
-            break;
-        }
+        pStateCache->SetUnorderedAccessView( ID, nullptr );
     }
 }
 
@@ -1867,8 +2082,8 @@ DXGI_FORMAT TextureDX11::TranslateFormat( const TextureFormat& format )
                 // Non-normalized format. May result in unintended behavior.
                 result = DXGI_FORMAT_R32G32B32_SINT;
                 break;
-            default:
-                ReportTextureFormatError( format, "Unknown texture format." );
+            default:
+                ReportTextureFormatError( format, "Unknown texture format." );
                 break;
             }
             break;
@@ -8,6 +8,11 @@
 #include <Texture.h>
 #include <CPUAccess.h>
 
+#include "../TextureProcessing.h"
+
+class StateCacheDX11;
+class JobSystem;
+
 class TextureDX11 : public Texture, public std::enable_shared_from_this<TextureDX11>
 {
 public:
@@ -37,11 +42,86 @@ public:
 
     virtual ~TextureDX11();
 
+    /**
+     * The CPU side of loading a texture from a file.
+     * Decoding an image does not access the device so it can be done on any thread.
+     */
+    struct ImageData
+    {
+        ImageData();
+        ~ImageData();
+
+        // Returns true if the image has been decoded (and not yet unloaded).
+        bool IsValid() const;
+        // The number of bytes of CPU memory used by the decoded image.
+        size_t GetMemorySize() const;
+
+        std::wstring FileName;
+        // The decoded image. Unloaded when the texture is created.
+        // Not used if the mip chain of the image has been generated.
+        FIBITMAP* Bitmap;
+        // The full mip chain of the image (if it could be generated on the CPU).
+        TextureImage Mipmaps;
+        TextureUsage Usage;
+        DXGI_FORMAT Format;
+        // The block compressed format the mip chain still has to be compressed to
+        // (DXGI_FORMAT_UNKNOWN if it is already compressed or can't be compressed).
+        DXGI_FORMAT CompressedFormat;
+        // The number of bits per pixel of the decoded image (before compression).
+        uint8_t BPP;
+        bool IsTransparent;
+        // True if the mip chain was loaded from the asset cache.
+        bool FromCache;
+        // The file in the asset cache that stores the processed image (empty if it is already stored).
+        std::wstring CacheFileName;
+        // The reason why decoding the image failed.
+        std::string Error;
+
+    private:
+        ImageData( const ImageData& );
+        ImageData& operator=( const ImageData& );
+    };
+
+    // Decode an image file. Returns false (and sets image.Error) if the image could not be decoded.
+    // The mip chain of 8-bit images is generated on the CPU (depending on how the texture is used)
+    // and stored in the asset cache so it only has to be generated the first time the image is loaded.
+    static bool DecodeImage( const std::wstring& fileName, ImageData& image, TextureUsage usage = TextureUsage::Color );
+    // Compress the mip chain of a decoded image (unless its blocks have already been compressed
+    // with CompressBlockRows, for example in parallel) and store it in the asset cache.
+    // Like DecodeImage, this can be done on any thread.
+    static void CompressImage( ImageData& image );
+
+    // Statistics of a batch of images that was processed by ProcessImages.
+    struct ProcessingStatistics
+    {
+        // The time spent in each stage (in milliseconds).
+        double DecodeTime;
+        double CompressionTime;
+        double StoreTime;
+        // The number of images that were compressed and the size of their uncompressed mip chains.
+        size_t NumCompressed;
+        size_t CompressedSourceBytes;
+    };
+
+    // Decode a batch of images, compress them and store them in the asset cache on the worker threads
+    // of a job system. The images (and their mip chains) are decoded in parallel and then the rows of blocks
+    // of all images are compressed in parallel, so a single large image does not keep the other threads waiting.
+    // Errors are stored in the images (nothing is thrown). Can be called on any thread.
+    // @param usages The usage of each image (images without a usage are color textures).
+    static void ProcessImages( JobSystem& jobSystem, const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages,
+                               std::vector< std::unique_ptr<ImageData> >& images, ProcessingStatistics* statistics = nullptr );
+
     /**
      * Load a 2D texture from a file path.
      */
     virtual bool LoadTexture2D( const std::wstring& fileName );
 
+    /**
+     * Create a 2D texture from a decoded image.
+     * This must be called on the thread that owns the device context.
+     */
+    bool LoadTexture2D( ImageData& image );
+
     /**
      * Load a cubemap texture from a file path.
      */
@@ -164,6 +244,7 @@ private:
 
     Microsoft::WRL::ComPtr<ID3D11Device2> m_pDevice;
     Microsoft::WRL::ComPtr<ID3D11DeviceContext2> m_pDeviceContext;
+    StateCacheDX11* m_pStateCache;
     Microsoft::WRL::ComPtr<ID3D11Texture1D> m_pTexture1D;
     Microsoft::WRL::ComPtr<ID3D11Texture2D> m_pTexture2D;
     Microsoft::WRL::ComPtr<ID3D11Texture3D> m_pTexture3D;
@@ -222,6 +303,8 @@ private:
     ColorBuffer m_Buffer;
 
     std::wstring m_TextureFileName;
+    // How the texture is used (needed to reload the texture when the file changes).
+    TextureUsage m_TextureUsage;
     DependencyTracker m_DependencyTracker;
     Event::ScopedConnections m_Connections;
 
@@ -0,0 +1,241 @@
+#include <EnginePCH.h>
+
+#include <Application.h>
+#include <JobSystem.h>
+#include <Texture.h>
+
+#include "RenderDeviceDX11.h"
+
+#include "TextureStreamerDX11.h"
+
+// The maximum amount of memory used by decoded images that are waiting to be uploaded.
+#define MAX_DECODED_IMAGE_BYTES ( 64 * 1024 * 1024 )
+// The maximum amount of image data that is uploaded per frame.
+// At least one image is uploaded per frame (even if it is larger than this).
+#define MAX_UPLOAD_BYTES_PER_FRAME ( 16 * 1024 * 1024 )
+
+TextureStreamerDX11::TextureStreamerDX11( RenderDeviceDX11& device, const Object& caller )
+    : m_Device( device )
+    , m_Caller( caller )
+    , m_DecodedBytes( 0 )
+    , m_NumRequested( 0 )
+    , m_NumDecoded( 0 )
+    , m_Generation( 0 )
+    , m_bQuit( false )
+{
+    m_Thread = std::thread( &TextureStreamerDX11::StreamingThread, this );
+}
+
+TextureStreamerDX11::~TextureStreamerDX11()
+{
+    MutexLock lock( m_Mutex );
+    m_bQuit = true;
+    lock.unlock();
+
+    m_WorkAvailable.notify_all();
+    m_Thread.join();
+}
+
+void TextureStreamerDX11::Enqueue( const PriorityMap& textures, const UsageMap& usages )
+{
+    MutexLock lock( m_Mutex );
+
+    // Start a new batch for the progress events if the previous batch is done.
+    if ( m_NumDecoded == m_NumRequested )
+    {
+        m_NumRequested = 0;
+        m_NumDecoded = 0;
+    }
+
+    for ( PriorityMap::const_iterator iter = textures.begin(); iter != textures.end(); ++iter )
+    {
+        std::shared_ptr<Texture> texture = m_Device.FindTexture( iter->first );
+        if ( texture )
+        {
+            // No need to decode textures that are already loaded.
+            m_ResidentTextures[iter->first] = texture;
+        }
+        else if ( m_PendingTextures.insert( *iter ).second )
+        {
+            ++m_NumRequested;
+        }
+        else
+        {
+            float& priority = m_PendingTextures[iter->first];
+            priority = std::max( priority, iter->second );
+        }
+    }
+
+    for ( UsageMap::const_iterator iter = usages.begin(); iter != usages.end(); ++iter )
+    {
+        if ( m_PendingTextures.find( iter->first ) != m_PendingTextures.end() )
+        {
+            m_TextureUsages[iter->first] = iter->second;
+        }
+    }
+
+    lock.unlock();
+    m_WorkAvailable.notify_one();
+}
+
+void TextureStreamerDX11::SetPriorities( const PriorityMap& priorities )
+{
+    MutexLock lock( m_Mutex );
+
+    for ( PriorityMap::const_iterator iter = priorities.begin(); iter != priorities.end(); ++iter )
+    {
+        PriorityMap::iterator pending = m_PendingTextures.find( iter->first );
+        if ( pending != m_PendingTextures.end() )
+        {
+            pending->second = iter->second;
+        }
+    }
+}
+
+void TextureStreamerDX11::Update( TextureMap& loadedTextures )
+{
+    DecodedImageQueue images;
+    ProgressQueue progressEvents;
+    size_t uploadBytes = 0;
+
+    MutexLock lock( m_Mutex );
+
+    progressEvents.swap( m_ProgressEvents );
+
+    loadedTextures.insert( m_ResidentTextures.begin(), m_ResidentTextures.end() );
+    m_ResidentTextures.clear();
+
+    // Take as many images from the queue as fit in the upload budget for this frame.
+    DecodedImageQueue::iterator iter = m_DecodedImages.begin();
+    while ( iter != m_DecodedImages.end() && ( images.empty() || uploadBytes + iter->Size <= MAX_UPLOAD_BYTES_PER_FRAME ) )
+    {
+        uploadBytes += iter->Size;
+        images.push_back( std::move( *iter ) );
+        ++iter;
+    }
+    m_DecodedImages.erase( m_DecodedImages.begin(), iter );
+    uint32_t generation = m_Generation;
+
+    lock.unlock();
+
+    for ( DecodedImage& decodedImage : images )
+    {
+        TextureDX11::ImageData& image = *decodedImage.Image;
+        if ( image.IsValid() )
+        {
+            loadedTextures[image.FileName] = m_Device.CreateTexture( image );
+        }
+        else
+        {
+            // Don't throw on the render thread. The material keeps its placeholder texture.
+            std::stringstream ss;
+            ss << "Failed to stream texture: " << image.Error << std::endl;
+            OutputDebugStringA( ss.str().c_str() );
+
+            loadedTextures[image.FileName] = nullptr;
+        }
+        // Release the decoded image as soon as possible.
+        decodedImage.Image.reset();
+    }
+
+    lock.lock();
+    // The queue was reset if the streamer was cancelled in the meantime.
+    if ( generation == m_Generation )
+    {
+        m_DecodedBytes -= uploadBytes;
+    }
+    lock.unlock();
+
+    // There is room in the queue again.
+    m_WorkAvailable.notify_one();
+
+    // The progress events are raised on this thread because the handlers update the user interface.
+    for ( const PendingProgress& progress : progressEvents )
+    {
+        ProgressEventArgs progressEventArgs( m_Caller, progress.FileName, progress.Progress );
+        LoadingProgress( progressEventArgs );
+    }
+}
+
+void TextureStreamerDX11::Cancel()
+{
+    MutexLock lock( m_Mutex );
+
+    m_PendingTextures.clear();
+    m_TextureUsages.clear();
+    m_DecodedImages.clear();
+    m_ProgressEvents.clear();
+    m_ResidentTextures.clear();
+    m_DecodedBytes = 0;
+    m_NumRequested = 0;
+    m_NumDecoded = 0;
+    ++m_Generation;
+}
+
+void TextureStreamerDX11::StreamingThread()
+{
+    JobSystem& jobSystem = Application::Get().GetJobSystem();
+
+    MutexLock lock( m_Mutex );
+
+    while ( true )
+    {
+        m_WorkAvailable.wait( lock, [this]()
+        {
+            return m_bQuit || ( !m_PendingTextures.empty() && m_DecodedBytes < MAX_DECODED_IMAGE_BYTES );
+        } );
+
+        if ( m_bQuit ) break;
+
+        // Take the textures with the highest priority, one for each thread of the job system.
+        std::vector<std::wstring> fileNames;
+        std::vector<TextureUsage> usages;
+        while ( !m_PendingTextures.empty() && fileNames.size() < jobSystem.GetNumThreads() )
+        {
+            PriorityMap::iterator next = std::max_element( m_PendingTextures.begin(), m_PendingTextures.end(), []( const PriorityMap::value_type& a, const PriorityMap::value_type& b )
+            {
+                return a.second < b.second;
+            } );
+
+            fileNames.push_back( next->first );
+            m_PendingTextures.erase( next );
+
+            TextureUsage usage = TextureUsage::Color;
+            UsageMap::iterator usageIter = m_TextureUsages.find( fileNames.back() );
+            if ( usageIter != m_TextureUsages.end() )
+            {
+                usage = usageIter->second;
+                m_TextureUsages.erase( usageIter );
+            }
+            usages.push_back( usage );
+        }
+        uint32_t generation = m_Generation;
+
+        lock.unlock();
+
+        // The images of the batch are decoded and their blocks are compressed in parallel.
+        // This thread executes batches of the loops as well.
+        std::vector< std::unique_ptr<TextureDX11::ImageData> > images;
+        TextureDX11::ProcessImages( jobSystem, fileNames, usages, images );
+
+        lock.lock();
+
+        // Discard the images if the streamer was cancelled while they were being decoded.
+        if ( generation != m_Generation ) continue;
+
+        for ( std::unique_ptr<TextureDX11::ImageData>& image : images )
+        {
+            PendingProgress progress;
+            progress.FileName = image->FileName;
+            progress.Progress = static_cast<float>( ++m_NumDecoded ) / static_cast<float>( m_NumRequested );
+            m_ProgressEvents.push_back( progress );
+
+            DecodedImage decodedImage;
+            decodedImage.Size = image->GetMemorySize();
+            decodedImage.Image = std::move( image );
+
+            m_DecodedBytes += decodedImage.Size;
+            m_DecodedImages.push_back( std::move( decodedImage ) );
+        }
+    }
+}
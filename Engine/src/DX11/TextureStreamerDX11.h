@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * Loads 2D textures in the background.
+ * A streaming thread takes batches of the textures with the highest priority and
+ * decodes, compresses and stores them on the job system of the application
+ * (see TextureDX11::ProcessImages). The textures are created on the render thread
+ * in Update (the device context is not thread safe).
+ * Decoded images wait in a queue until they are uploaded. The streaming thread stops
+ * decoding when the queue exceeds its memory budget, so the amount of memory
+ * used by the streamer stays bounded no matter how many textures are requested
+ * (the queue can exceed the budget by at most one batch).
+ */
+
+#include <Events.h>
+
+#include "TextureDX11.h"
+
+class RenderDeviceDX11;
+class Texture;
+
+class TextureStreamerDX11
+{
+public:
+    // Maps texture file names to their loading priority.
+    typedef std::map<std::wstring, float> PriorityMap;
+    // Maps texture file names to the way they are used (see DecodeImage).
+    typedef std::map<std::wstring, TextureUsage> UsageMap;
+    typedef std::map<std::wstring, std::shared_ptr<Texture> > TextureMap;
+
+    // The caller is the sender of the LoadingProgress events.
+    TextureStreamerDX11( RenderDeviceDX11& device, const Object& caller );
+    ~TextureStreamerDX11();
+
+    // Queue textures to be loaded. Textures with a higher priority are loaded first.
+    // Textures that are not in the usage map are loaded as color textures.
+    void Enqueue( const PriorityMap& textures, const UsageMap& usages );
+    // Change the priority of textures that are still waiting to be decoded.
+    // Textures that are not queued are ignored.
+    void SetPriorities( const PriorityMap& priorities );
+    // Create the textures that have been decoded since the last update
+    // and raise the LoadingProgress events of the decoded images.
+    // Textures that failed to load are returned as nullptr.
+    // Must be called on the render thread.
+    void Update( TextureMap& loadedTextures );
+    // Discard all textures that have not been loaded yet.
+    void Cancel();
+
+    // Raised in Update (on the render thread) for each image that has been decoded.
+    ProgressEvent LoadingProgress;
+
+private:
+    typedef std::unique_lock<std::mutex> MutexLock;
+
+    struct DecodedImage
+    {
+        std::unique_ptr<TextureDX11::ImageData> Image;
+        // The amount of memory used by the decoded image (in bytes).
+        size_t Size;
+    };
+    typedef std::vector<DecodedImage> DecodedImageQueue;
+
+    // The progress of an image that was decoded on the streaming thread.
+    struct PendingProgress
+    {
+        std::wstring FileName;
+        float Progress;
+    };
+    typedef std::vector<PendingProgress> ProgressQueue;
+
+    void StreamingThread();
+
+    RenderDeviceDX11& m_Device;
+    const Object& m_Caller;
+
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkAvailable;
+
+    // Textures that are waiting to be decoded.
+    PriorityMap m_PendingTextures;
+    UsageMap m_TextureUsages;
+    // Images that are waiting to be uploaded.
+    DecodedImageQueue m_DecodedImages;
+    size_t m_DecodedBytes;
+    // Progress events that have not been raised yet.
+    ProgressQueue m_ProgressEvents;
+    // Requested textures that were already loaded by the render device.
+    TextureMap m_ResidentTextures;
+
+    // Used to report the progress of the current batch of textures.
+    uint32_t m_NumRequested;
+    uint32_t m_NumDecoded;
+
+    // Incremented when the queue is cancelled so images
+    // that are being decoded at that moment are discarded.
+    uint32_t m_Generation;
+    bool m_bQuit;
+};
@@ -9,7 +9,7 @@ DescriptorHandleDX12<HandleType>::DescriptorHandleDX12()
     : m_Increment( 0 )
 {}
 
-DescriptorHeapDX12::DescriptorHeapDX12( ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count )
+DescriptorHeapDX12::DescriptorHeapDX12( ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count, bool shaderVisible )
     : m_Type( type )
     , m_Size( count )
 {
@@ -18,7 +18,7 @@ DescriptorHeapDX12::DescriptorHeapDX12( ID3D12Device* pDevice, D3D12_DESCRIPTOR_
     D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
     heapDesc.NumDescriptors = m_Size;
     heapDesc.Type = m_Type;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+    heapDesc.Flags = shaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 
     if ( FAILED( pDevice->CreateDescriptorHeap( &heapDesc, __uuidof( ID3D12DescriptorHeap ), &m_pHeap ) ) )
     {
@@ -30,6 +30,21 @@ DescriptorHeapDX12::DescriptorHeapDX12( ID3D12Device* pDevice, D3D12_DESCRIPTOR_
     m_GPUHandle = GPUDescriptorHandleDX12( m_pHeap->GetGPUDescriptorHandleForHeapStart(), m_Increment );
 }
 
+D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapDX12::GetType() const
+{
+    return m_Type;
+}
+
+UINT DescriptorHeapDX12::GetSize() const
+{
+    return m_Size;
+}
+
+Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> DescriptorHeapDX12::GetHeap() const
+{
+    return m_pHeap;
+}
+
 CPUDescriptorHandleDX12& DescriptorHeapDX12::GetCPUHandle()
 {
     return m_CPUHandle;
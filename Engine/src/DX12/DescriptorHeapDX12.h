@@ -75,10 +75,17 @@ public:
      * @param[in] pDevice   D3D12Device pointer that will be used to create the descriptor heap.
      * @param[in] type      The type of descriptor heap to create.
      * @param[in] count     The number of descriptors that this heap can store. Default is 1.
+     * @param[in] shaderVisible Create a heap that can be bound to a command list
+     *                      (only for CBV/SRV/UAV and sampler heaps). Default is false.
      *
      * @see https://msdn.microsoft.com/en-us/library/dn859379(v=vs.85).aspx
      */
-    DescriptorHeapDX12( ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count = 1 );
+    DescriptorHeapDX12( ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT count = 1, bool shaderVisible = false );
+
+    D3D12_DESCRIPTOR_HEAP_TYPE GetType() const;
+    // The number of descriptors in the heap.
+    UINT GetSize() const;
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> GetHeap() const;
 
     /**
      * Get the CPU descriptor heap handle.
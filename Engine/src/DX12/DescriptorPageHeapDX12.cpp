@@ -0,0 +1,42 @@
+#include <EnginePCH.h>
+
+#include "DescriptorPageHeapDX12.h"
+
+DescriptorPageHeapDX12::DescriptorPageHeapDX12( ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_TYPE type, bool shaderVisible )
+    : m_pDevice( pDevice )
+    , m_Type( type )
+    , m_bShaderVisible( shaderVisible )
+{}
+
+DescriptorPageHeapDX12::~DescriptorPageHeapDX12()
+{}
+
+void DescriptorPageHeapDX12::CreatePage( uint32_t numDescriptors )
+{
+    m_Pages.push_back( std::make_shared<DescriptorHeapDX12>( m_pDevice.Get(), m_Type, numDescriptors, m_bShaderVisible ) );
+}
+
+CPUDescriptorHandleDX12 DescriptorPageHeapDX12::GetCPUHandle( const DescriptorAllocation& allocation ) const
+{
+    return GetPage( allocation.Page )->GetCPUHandleStart() + allocation.Offset;
+}
+
+GPUDescriptorHandleDX12 DescriptorPageHeapDX12::GetGPUHandle( const DescriptorAllocation& allocation ) const
+{
+    if ( !m_bShaderVisible )
+    {
+        ReportError( "Descriptors that are not shader visible don't have a GPU handle." );
+    }
+
+    return GetPage( allocation.Page )->GetGPUHandleStart() + allocation.Offset;
+}
+
+std::shared_ptr<DescriptorHeapDX12> DescriptorPageHeapDX12::GetPage( uint32_t page ) const
+{
+    if ( page >= m_Pages.size() )
+    {
+        ReportError( "Invalid descriptor page." );
+    }
+
+    return m_Pages[page];
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <DescriptorAllocator.h>
+
+#include "DescriptorHeapDX12.h"
+
+/**
+ * Creates a descriptor heap for every page of a DescriptorAllocator or a TransientDescriptorRing
+ * and converts the allocated descriptors to CPU and GPU descriptor handles.
+ * Persistent descriptors are allocated from heaps that are not shader visible
+ * and copied to the shader visible heap of a TransientDescriptorRing before they are used.
+ */
+class DescriptorPageHeapDX12 : public DescriptorPageHeap
+{
+public:
+    DescriptorPageHeapDX12( ID3D12Device* pDevice, D3D12_DESCRIPTOR_HEAP_TYPE type, bool shaderVisible = false );
+    virtual ~DescriptorPageHeapDX12();
+
+    // Inherited from DescriptorPageHeap
+    virtual void CreatePage( uint32_t numDescriptors );
+
+    // The handle of the first descriptor of the allocation.
+    CPUDescriptorHandleDX12 GetCPUHandle( const DescriptorAllocation& allocation ) const;
+    // Only valid for a shader visible heap.
+    GPUDescriptorHandleDX12 GetGPUHandle( const DescriptorAllocation& allocation ) const;
+
+    std::shared_ptr<DescriptorHeapDX12> GetPage( uint32_t page ) const;
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12Device> m_pDevice;
+    D3D12_DESCRIPTOR_HEAP_TYPE m_Type;
+    bool m_bShaderVisible;
+
+    typedef std::vector< std::shared_ptr<DescriptorHeapDX12> > PageList;
+    PageList m_Pages;
+};
@@ -73,6 +73,19 @@ void DependencyTracker::AddDependency( const std::wstring& dependencyFile )
     }
 }
 
+std::vector<std::wstring> DependencyTracker::GetDependencies()
+{
+    MutexLock lock( m_Mutex );
+
+    std::vector<std::wstring> dependencies;
+    for ( const std::wstring& dependency : m_Dependencies )
+    {
+        dependencies.push_back( ( m_ParentPath / dependency ).wstring() );
+    }
+
+    return dependencies;
+}
+
 void DependencyTracker::OnFileChanged( FileChangeEventArgs& e )
 {
     MutexLock lock( m_Mutex );
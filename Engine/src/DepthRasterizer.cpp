@@ -0,0 +1,320 @@
+#include <EnginePCH.h>
+
+#include <BoundingBox.h>
+#include <DepthRasterizer.h>
+
+#include <emmintrin.h>
+
+// Triangles are clipped against this plane (w = NEAR_CLIP_W) before the perspective divide.
+#define NEAR_CLIP_W 1e-3f
+// Value that is used to clear the depth buffer.
+#define FAR_DEPTH std::numeric_limits<float>::max()
+
+DepthRasterizer::DepthRasterizer( uint32_t width, uint32_t height )
+{
+    assert( width > 0 && ( width % 4 ) == 0 );
+    assert( height > 0 );
+
+    // Allocate all of the levels of the hierarchical depth buffer.
+    // Each level is (rounded up) half the size of the previous level.
+    uint32_t levelWidth = width;
+    uint32_t levelHeight = height;
+    while ( true )
+    {
+        DepthLevel level;
+        level.Width = levelWidth;
+        level.Height = levelHeight;
+        level.Depth.resize( levelWidth * levelHeight, FAR_DEPTH );
+        m_Levels.push_back( level );
+
+        if ( levelWidth == 1 && levelHeight == 1 ) break;
+
+        levelWidth = std::max<uint32_t>( 1, ( levelWidth + 1 ) / 2 );
+        levelHeight = std::max<uint32_t>( 1, ( levelHeight + 1 ) / 2 );
+    }
+}
+
+uint32_t DepthRasterizer::GetWidth() const
+{
+    return m_Levels[0].Width;
+}
+
+uint32_t DepthRasterizer::GetHeight() const
+{
+    return m_Levels[0].Height;
+}
+
+uint32_t DepthRasterizer::GetNumLevels() const
+{
+    return static_cast<uint32_t>( m_Levels.size() );
+}
+
+void DepthRasterizer::Clear()
+{
+    for ( DepthLevel& level : m_Levels )
+    {
+        std::fill( level.Depth.begin(), level.Depth.end(), FAR_DEPTH );
+    }
+}
+
+glm::vec3 DepthRasterizer::ClipToScreen( const glm::vec4& clipPosition ) const
+{
+    float invW = 1.0f / clipPosition.w;
+    return glm::vec3( ( clipPosition.x * invW * 0.5f + 0.5f ) * m_Levels[0].Width,
+                      ( 0.5f - clipPosition.y * invW * 0.5f ) * m_Levels[0].Height,
+                      clipPosition.z * invW );
+}
+
+void DepthRasterizer::RasterizeTriangles( const glm::mat4& modelViewProjection, const glm::vec3* positions, const uint32_t* indices, uint32_t numIndices )
+{
+    for ( uint32_t i = 0; i + 2 < numIndices; i += 3 )
+    {
+        glm::vec4 v0 = modelViewProjection * glm::vec4( positions[indices[i + 0]], 1 );
+        glm::vec4 v1 = modelViewProjection * glm::vec4( positions[indices[i + 1]], 1 );
+        glm::vec4 v2 = modelViewProjection * glm::vec4( positions[indices[i + 2]], 1 );
+
+        RasterizeTriangle( v0, v1, v2 );
+    }
+}
+
+void DepthRasterizer::RasterizeTriangle( const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2 )
+{
+    // Trivially reject triangles that are completely outside one of the side planes of the view frustum.
+    if ( ( v0.x > v0.w && v1.x > v1.w && v2.x > v2.w ) ||
+         ( v0.x < -v0.w && v1.x < -v1.w && v2.x < -v2.w ) ||
+         ( v0.y > v0.w && v1.y > v1.w && v2.y > v2.w ) ||
+         ( v0.y < -v0.w && v1.y < -v1.w && v2.y < -v2.w ) )
+    {
+        return;
+    }
+
+    const glm::vec4 in[3] = { v0, v1, v2 };
+    bool inside[3] = { v0.w >= NEAR_CLIP_W, v1.w >= NEAR_CLIP_W, v2.w >= NEAR_CLIP_W };
+
+    if ( inside[0] && inside[1] && inside[2] )
+    {
+        RasterizeScreenTriangle( ClipToScreen( v0 ), ClipToScreen( v1 ), ClipToScreen( v2 ) );
+        return;
+    }
+
+    // Clip the triangle against the near plane.
+    // Clipping a triangle against a single plane produces at most 4 vertices.
+    glm::vec4 clipped[4];
+    uint32_t numClipped = 0;
+    for ( uint32_t i = 0; i < 3; ++i )
+    {
+        uint32_t j = ( i + 1 ) % 3;
+        if ( inside[i] )
+        {
+            clipped[numClipped++] = in[i];
+        }
+        if ( inside[i] != inside[j] )
+        {
+            float t = ( NEAR_CLIP_W - in[i].w ) / ( in[j].w - in[i].w );
+            clipped[numClipped++] = glm::mix( in[i], in[j], t );
+        }
+    }
+
+    if ( numClipped < 3 ) return;
+
+    glm::vec3 p0 = ClipToScreen( clipped[0] );
+    glm::vec3 p1 = ClipToScreen( clipped[1] );
+    glm::vec3 p2 = ClipToScreen( clipped[2] );
+    RasterizeScreenTriangle( p0, p1, p2 );
+    if ( numClipped == 4 )
+    {
+        RasterizeScreenTriangle( p0, p2, ClipToScreen( clipped[3] ) );
+    }
+}
+
+void DepthRasterizer::RasterizeScreenTriangle( const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2 )
+{
+    DepthLevel& level = m_Levels[0];
+
+    // Twice the signed area of the triangle.
+    float area = ( p1.x - p0.x ) * ( p2.y - p0.y ) - ( p1.y - p0.y ) * ( p2.x - p0.x );
+    if ( area == 0.0f ) return;
+
+    // Occluders are rendered double sided. Make sure the winding order is consistent.
+    const glm::vec3& a = p0;
+    const glm::vec3& b = ( area > 0.0f ) ? p1 : p2;
+    const glm::vec3& c = ( area > 0.0f ) ? p2 : p1;
+    area = glm::abs( area );
+
+    // Compute the bounding rectangle of the triangle (clamped to the screen).
+    float minX = glm::min( a.x, glm::min( b.x, c.x ) );
+    float maxX = glm::max( a.x, glm::max( b.x, c.x ) );
+    float minY = glm::min( a.y, glm::min( b.y, c.y ) );
+    float maxY = glm::max( a.y, glm::max( b.y, c.y ) );
+
+    if ( maxX < 0.0f || maxY < 0.0f || minX >= level.Width || minY >= level.Height ) return;
+
+    int32_t x0 = glm::max( 0, static_cast<int32_t>( minX ) ) & ~3; // Align to 4 pixels.
+    int32_t x1 = glm::min( static_cast<int32_t>( level.Width ) - 1, static_cast<int32_t>( maxX ) );
+    int32_t y0 = glm::max( 0, static_cast<int32_t>( minY ) );
+    int32_t y1 = glm::min( static_cast<int32_t>( level.Height ) - 1, static_cast<int32_t>( maxY ) );
+
+    // Edge functions E(x,y) = A*x + B*y + C for the edges (a,b), (b,c) and (c,a).
+    // A pixel is inside the triangle if all edge functions are >= 0.
+    float A0 = a.y - b.y, B0 = b.x - a.x, C0 = -( A0 * a.x + B0 * a.y );
+    float A1 = b.y - c.y, B1 = c.x - b.x, C1 = -( A1 * b.x + B1 * b.y );
+    float A2 = c.y - a.y, B2 = a.x - c.x, C2 = -( A2 * c.x + B2 * c.y );
+
+    // The depth is linear in screen space. The barycentric weight of a vertex is the
+    // edge function of the opposite edge divided by the area of the triangle.
+    float invArea = 1.0f / area;
+    float zA = ( A1 * a.z + A2 * b.z + A0 * c.z ) * invArea;
+    float zB = ( B1 * a.z + B2 * b.z + B0 * c.z ) * invArea;
+    float zC = ( C1 * a.z + C2 * b.z + C0 * c.z ) * invArea;
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 pixelOffsets = _mm_set_ps( 3.5f, 2.5f, 1.5f, 0.5f );
+
+    const __m128 vA0 = _mm_set1_ps( A0 ), vA1 = _mm_set1_ps( A1 ), vA2 = _mm_set1_ps( A2 );
+    const __m128 vzA = _mm_set1_ps( zA );
+
+    for ( int32_t y = y0; y <= y1; ++y )
+    {
+        float py = y + 0.5f;
+        __m128 rowE0 = _mm_set1_ps( B0 * py + C0 );
+        __m128 rowE1 = _mm_set1_ps( B1 * py + C1 );
+        __m128 rowE2 = _mm_set1_ps( B2 * py + C2 );
+        __m128 rowZ = _mm_set1_ps( zB * py + zC );
+
+        float* depthRow = &level.Depth[y * level.Width];
+
+        for ( int32_t x = x0; x <= x1; x += 4 )
+        {
+            __m128 px = _mm_add_ps( _mm_set1_ps( static_cast<float>( x ) ), pixelOffsets );
+
+            __m128 e0 = _mm_add_ps( _mm_mul_ps( vA0, px ), rowE0 );
+            __m128 e1 = _mm_add_ps( _mm_mul_ps( vA1, px ), rowE1 );
+            __m128 e2 = _mm_add_ps( _mm_mul_ps( vA2, px ), rowE2 );
+
+            __m128 mask = _mm_and_ps( _mm_and_ps( _mm_cmpge_ps( e0, zero ), _mm_cmpge_ps( e1, zero ) ), _mm_cmpge_ps( e2, zero ) );
+            if ( _mm_movemask_ps( mask ) == 0 ) continue;
+
+            __m128 z = _mm_add_ps( _mm_mul_ps( vzA, px ), rowZ );
+            __m128 oldDepth = _mm_loadu_ps( depthRow + x );
+            __m128 newDepth = _mm_min_ps( oldDepth, z );
+
+            _mm_storeu_ps( depthRow + x, _mm_or_ps( _mm_and_ps( mask, newDepth ), _mm_andnot_ps( mask, oldDepth ) ) );
+        }
+    }
+}
+
+void DepthRasterizer::BuildHierarchy()
+{
+    for ( size_t i = 1; i < m_Levels.size(); ++i )
+    {
+        const DepthLevel& src = m_Levels[i - 1];
+        DepthLevel& dst = m_Levels[i];
+
+        for ( uint32_t y = 0; y < dst.Height; ++y )
+        {
+            uint32_t sy0 = glm::min( y * 2, src.Height - 1 );
+            uint32_t sy1 = glm::min( y * 2 + 1, src.Height - 1 );
+
+            for ( uint32_t x = 0; x < dst.Width; ++x )
+            {
+                uint32_t sx0 = glm::min( x * 2, src.Width - 1 );
+                uint32_t sx1 = glm::min( x * 2 + 1, src.Width - 1 );
+
+                // Store the farthest depth value so that the test is conservative.
+                dst.Depth[y * dst.Width + x] = glm::max( glm::max( src.Depth[sy0 * src.Width + sx0], src.Depth[sy0 * src.Width + sx1] ),
+                                                         glm::max( src.Depth[sy1 * src.Width + sx0], src.Depth[sy1 * src.Width + sx1] ) );
+            }
+        }
+    }
+}
+
+bool DepthRasterizer::IsVisible( const glm::mat4& modelViewProjection, const BoundingBox& boundingBox ) const
+{
+    if ( !boundingBox.IsValid() ) return true;
+
+    const DepthLevel& level0 = m_Levels[0];
+
+    glm::vec3 screenMin( std::numeric_limits<float>::max() );
+    glm::vec3 screenMax( -std::numeric_limits<float>::max() );
+    uint32_t numBehind = 0;
+
+    for ( uint32_t i = 0; i < 8; ++i )
+    {
+        glm::vec4 clipPosition = modelViewProjection * glm::vec4( boundingBox.GetCorner( i ), 1 );
+
+        if ( clipPosition.w < NEAR_CLIP_W )
+        {
+            ++numBehind;
+            continue;
+        }
+
+        glm::vec3 screenPosition = ClipToScreen( clipPosition );
+        screenMin = glm::min( screenMin, screenPosition );
+        screenMax = glm::max( screenMax, screenPosition );
+    }
+
+    // The box is completely behind the camera.
+    if ( numBehind == 8 ) return false;
+    // If the box intersects the near plane, we can't say anything about its visibility.
+    if ( numBehind > 0 ) return true;
+
+    // The box is completely outside of the view.
+    if ( screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= level0.Width || screenMin.y >= level0.Height )
+    {
+        return false;
+    }
+
+    int32_t x0 = glm::max( 0, static_cast<int32_t>( screenMin.x ) );
+    int32_t x1 = glm::min( static_cast<int32_t>( level0.Width ) - 1, static_cast<int32_t>( screenMax.x ) );
+    int32_t y0 = glm::max( 0, static_cast<int32_t>( screenMin.y ) );
+    int32_t y1 = glm::min( static_cast<int32_t>( level0.Height ) - 1, static_cast<int32_t>( screenMax.y ) );
+
+    // Choose the level of the hierarchical depth buffer where the
+    // rectangle covers at most 2x2 texels.
+    uint32_t levelIndex = 0;
+    while ( levelIndex + 1 < m_Levels.size() && ( ( x1 >> levelIndex ) - ( x0 >> levelIndex ) > 1 || ( y1 >> levelIndex ) - ( y0 >> levelIndex ) > 1 ) )
+    {
+        ++levelIndex;
+    }
+
+    const DepthLevel& level = m_Levels[levelIndex];
+    for ( int32_t y = y0 >> levelIndex; y <= ( y1 >> levelIndex ); ++y )
+    {
+        for ( int32_t x = x0 >> levelIndex; x <= ( x1 >> levelIndex ); ++x )
+        {
+            // The nearest point of the box is in front of the farthest occluder in this texel.
+            if ( screenMin.z <= level.Depth[y * level.Width + x] )
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool DepthRasterizer::IsPointOccluded( const glm::mat4& viewProjection, const glm::vec3& point ) const
+{
+    glm::vec4 clipPosition = viewProjection * glm::vec4( point, 1 );
+    if ( clipPosition.w < NEAR_CLIP_W ) return false;
+
+    const DepthLevel& level0 = m_Levels[0];
+    glm::vec3 screenPosition = ClipToScreen( clipPosition );
+    if ( screenPosition.x < 0.0f || screenPosition.y < 0.0f || screenPosition.x >= level0.Width || screenPosition.y >= level0.Height )
+    {
+        return false;
+    }
+
+    uint32_t x = static_cast<uint32_t>( screenPosition.x );
+    uint32_t y = static_cast<uint32_t>( screenPosition.y );
+    return screenPosition.z > level0.Depth[y * level0.Width + x];
+}
+
+float DepthRasterizer::GetDepth( uint32_t x, uint32_t y, uint32_t level ) const
+{
+    assert( level < m_Levels.size() );
+    const DepthLevel& depthLevel = m_Levels[level];
+    assert( x < depthLevel.Width && y < depthLevel.Height );
+
+    return depthLevel.Depth[y * depthLevel.Width + x];
+}
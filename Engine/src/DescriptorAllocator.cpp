@@ -0,0 +1,160 @@
+#include <EnginePCH.h>
+
+#include <DescriptorAllocator.h>
+
+DescriptorAllocator::DescriptorAllocator( DescriptorPageHeap& heap, uint32_t descriptorsPerPage )
+    : m_Heap( heap )
+    , m_DescriptorsPerPage( descriptorsPerPage )
+    , m_NumFreeDescriptors( 0 )
+    , m_NumStaleDescriptors( 0 )
+{
+    if ( m_DescriptorsPerPage == 0 )
+    {
+        ReportError( "The descriptor pages must contain at least one descriptor." );
+    }
+}
+
+DescriptorAllocator::~DescriptorAllocator()
+{}
+
+DescriptorAllocation DescriptorAllocator::Allocate( uint32_t count )
+{
+    if ( count == 0 || count > m_DescriptorsPerPage )
+    {
+        ReportError( "Can't allocate more descriptors than the size of a descriptor page." );
+        return DescriptorAllocation();
+    }
+
+    // Take the smallest free range that fits from the first page that has one.
+    for ( size_t i = 0; i <= m_Pages.size(); ++i )
+    {
+        if ( i == m_Pages.size() )
+        {
+            CreatePage();
+        }
+
+        Page& page = *m_Pages[i];
+        if ( page.NumFreeDescriptors < count ) continue;
+
+        FreeListBySize::iterator bySize = page.FreeBySize.lower_bound( count );
+        if ( bySize == page.FreeBySize.end() ) continue;
+
+        FreeListByOffset::iterator byOffset = bySize->second;
+        uint32_t offset = byOffset->first;
+        uint32_t size = byOffset->second.Size;
+
+        RemoveFreeRange( page, byOffset );
+        // The rest of the range stays free.
+        if ( size > count )
+        {
+            AddFreeRange( page, offset + count, size - count );
+        }
+
+        page.NumFreeDescriptors -= count;
+        m_NumFreeDescriptors -= count;
+
+        return DescriptorAllocation( (uint32_t)i, offset, count );
+    }
+
+    return DescriptorAllocation();
+}
+
+void DescriptorAllocator::Free( const DescriptorAllocation& allocation, uint64_t fenceValue )
+{
+    if ( !allocation.IsValid() ) return;
+
+    if ( allocation.Page >= m_Pages.size() || allocation.Offset + allocation.Count > m_DescriptorsPerPage )
+    {
+        ReportError( "The descriptors were not allocated by this allocator." );
+        return;
+    }
+
+    StaleAllocation staleAllocation;
+    staleAllocation.Allocation = allocation;
+    staleAllocation.FenceValue = fenceValue;
+    m_StaleAllocations.push_back( staleAllocation );
+
+    m_NumStaleDescriptors += allocation.Count;
+}
+
+void DescriptorAllocator::ReleaseStaleDescriptors( uint64_t completedFenceValue )
+{
+    while ( !m_StaleAllocations.empty() && m_StaleAllocations.front().FenceValue <= completedFenceValue )
+    {
+        const DescriptorAllocation& allocation = m_StaleAllocations.front().Allocation;
+        Page& page = *m_Pages[allocation.Page];
+
+        AddFreeRange( page, allocation.Offset, allocation.Count );
+        page.NumFreeDescriptors += allocation.Count;
+        m_NumFreeDescriptors += allocation.Count;
+        m_NumStaleDescriptors -= allocation.Count;
+
+        m_StaleAllocations.pop_front();
+    }
+}
+
+uint32_t DescriptorAllocator::GetDescriptorsPerPage() const
+{
+    return m_DescriptorsPerPage;
+}
+
+uint32_t DescriptorAllocator::GetNumPages() const
+{
+    return (uint32_t)m_Pages.size();
+}
+
+uint32_t DescriptorAllocator::GetNumFreeDescriptors() const
+{
+    return m_NumFreeDescriptors;
+}
+
+uint32_t DescriptorAllocator::GetNumStaleDescriptors() const
+{
+    return m_NumStaleDescriptors;
+}
+
+void DescriptorAllocator::CreatePage()
+{
+    m_Heap.CreatePage( m_DescriptorsPerPage );
+
+    m_Pages.push_back( std::unique_ptr<Page>( new Page() ) );
+    Page& page = *m_Pages.back();
+    page.NumFreeDescriptors = m_DescriptorsPerPage;
+    AddFreeRange( page, 0, m_DescriptorsPerPage );
+
+    m_NumFreeDescriptors += m_DescriptorsPerPage;
+}
+
+void DescriptorAllocator::AddFreeRange( Page& page, uint32_t offset, uint32_t size )
+{
+    // The first free range after the new range.
+    FreeListByOffset::iterator next = page.FreeByOffset.lower_bound( offset );
+
+    if ( next != page.FreeByOffset.begin() )
+    {
+        FreeListByOffset::iterator previous = std::prev( next );
+        if ( previous->first + previous->second.Size == offset )
+        {
+            offset = previous->first;
+            size += previous->second.Size;
+            RemoveFreeRange( page, previous );
+        }
+    }
+
+    if ( next != page.FreeByOffset.end() && offset + size == next->first )
+    {
+        size += next->second.Size;
+        RemoveFreeRange( page, next );
+    }
+
+    FreeRange freeRange;
+    freeRange.Size = size;
+    FreeListByOffset::iterator byOffset = page.FreeByOffset.insert( FreeListByOffset::value_type( offset, freeRange ) ).first;
+    byOffset->second.BySize = page.FreeBySize.insert( FreeListBySize::value_type( size, byOffset ) );
+}
+
+void DescriptorAllocator::RemoveFreeRange( Page& page, FreeListByOffset::iterator iter )
+{
+    page.FreeBySize.erase( iter->second.BySize );
+    page.FreeByOffset.erase( iter );
+}
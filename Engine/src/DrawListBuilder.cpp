@@ -0,0 +1,165 @@
+#include <EnginePCH.h>
+
+#include <Scene.h>
+#include <SceneNode.h>
+#include <Mesh.h>
+#include <Camera.h>
+#include <PipelineState.h>
+#include <JobSystem.h>
+#include <LodSelector.h>
+#include <DrawList.h>
+
+#include <DrawListBuilder.h>
+
+// The number of scene nodes that are processed per batch.
+// The batch size must not depend on the number of threads
+// so that the render queues are merged in the same order.
+#define NODES_PER_BATCH 256
+
+DrawListBuilder::DrawListBuilder( std::shared_ptr<Scene> scene, JobSystem& jobSystem )
+    : m_Scene( scene )
+    , m_JobSystem( jobSystem )
+{}
+
+DrawListBuilder::~DrawListBuilder()
+{}
+
+void DrawListBuilder::AddDrawList( std::shared_ptr<DrawList> drawList )
+{
+    assert( drawList && drawList->GetRenderQueue() );
+    m_DrawLists.push_back( drawList );
+}
+
+void DrawListBuilder::SetLodSelector( std::shared_ptr<LodSelector> lodSelector )
+{
+    m_LodSelector = lodSelector;
+}
+
+uint32_t DrawListBuilder::GetNumNodes() const
+{
+    return static_cast<uint32_t>( m_Nodes.size() );
+}
+
+void DrawListBuilder::Build( Camera& camera )
+{
+    // Flatten the scene graph.
+    m_Nodes.clear();
+    m_Meshes.clear();
+    if ( m_Scene )
+    {
+        m_Scene->Accept( *this );
+    }
+
+    const uint32_t numNodes = static_cast<uint32_t>( m_Nodes.size() );
+    const uint32_t numBatches = ( numNodes + NODES_PER_BATCH - 1 ) / NODES_PER_BATCH;
+    const size_t numDrawLists = m_DrawLists.size();
+
+    // The arenas are reused between frames to avoid reallocating memory.
+    if ( m_BatchArenas.size() < numBatches )
+    {
+        m_BatchArenas.resize( numBatches );
+    }
+    for ( uint32_t i = 0; i < numBatches; ++i )
+    {
+        m_BatchArenas[i].resize( numDrawLists );
+    }
+
+    glm::mat4 viewMatrix = camera.GetViewMatrix();
+    glm::mat4 projectionMatrix = camera.GetProjectionMatrix();
+
+    m_JobSystem.ParallelFor( numNodes, NODES_PER_BATCH, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        BuildBatch( begin / NODES_PER_BATCH, begin, end, viewMatrix, projectionMatrix );
+    } );
+
+    // Merge the arenas into the render queues of the draw lists (in batch order)
+    // and sort the render queues. Each draw list can be merged and sorted independently.
+    m_JobSystem.ParallelFor( static_cast<uint32_t>( numDrawLists ), 1, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        for ( uint32_t drawListIndex = begin; drawListIndex < end; ++drawListIndex )
+        {
+            DrawList& drawList = *m_DrawLists[drawListIndex];
+            RenderQueue& renderQueue = *drawList.GetRenderQueue();
+            PipelineState* pipeline = drawList.GetPipelineState().get();
+
+            size_t numRenderItems = 0;
+            for ( uint32_t batchIndex = 0; batchIndex < numBatches; ++batchIndex )
+            {
+                numRenderItems += m_BatchArenas[batchIndex][drawListIndex].size();
+            }
+
+            renderQueue.Clear();
+            renderQueue.Reserve( numRenderItems );
+            for ( uint32_t batchIndex = 0; batchIndex < numBatches; ++batchIndex )
+            {
+                for ( const DrawPacket& drawPacket : m_BatchArenas[batchIndex][drawListIndex] )
+                {
+                    renderQueue.Push( pipeline, drawPacket.RenderItem, drawPacket.ViewDepth );
+                }
+            }
+            renderQueue.Sort();
+
+            drawList.SetRenderQueueBuilt( true );
+        }
+    } );
+}
+
+void DrawListBuilder::BuildBatch( uint32_t batchIndex, uint32_t begin, uint32_t end, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix )
+{
+    BatchArena& arena = m_BatchArenas[batchIndex];
+    for ( DrawPacketList& drawPackets : arena )
+    {
+        drawPackets.clear();
+    }
+
+    for ( uint32_t nodeIndex = begin; nodeIndex < end; ++nodeIndex )
+    {
+        const FlatNode& flatNode = m_Nodes[nodeIndex];
+        if ( flatNode.NumMeshes == 0 ) continue;
+
+        DrawPacket drawPacket;
+        drawPacket.RenderItem.ModelView = viewMatrix * flatNode.Node->GetWorldTransfom();
+        drawPacket.RenderItem.ModelViewProjection = projectionMatrix * drawPacket.RenderItem.ModelView;
+
+        for ( uint32_t meshIndex = flatNode.FirstMesh; meshIndex < flatNode.FirstMesh + flatNode.NumMeshes; ++meshIndex )
+        {
+            Mesh& mesh = *m_Meshes[meshIndex];
+            drawPacket.RenderItem.Mesh = &mesh;
+            drawPacket.RenderItem.Lod = 0;
+            drawPacket.ViewDepth = RenderQueue::GetViewDepth( mesh, drawPacket.RenderItem.ModelView );
+
+            // Each node is processed by a single thread so the LOD of the node's meshes can be updated here.
+            if ( m_LodSelector )
+            {
+                uint32_t nodeMeshIndex = meshIndex - flatNode.FirstMesh;
+                drawPacket.RenderItem.Lod = m_LodSelector->SelectLod( mesh, drawPacket.RenderItem.ModelView, flatNode.Node->GetMeshLod( nodeMeshIndex ) );
+                flatNode.Node->SetMeshLod( nodeMeshIndex, drawPacket.RenderItem.Lod );
+            }
+
+            for ( size_t drawListIndex = 0; drawListIndex < m_DrawLists.size(); ++drawListIndex )
+            {
+                if ( m_DrawLists[drawListIndex]->FilterMesh( mesh, drawPacket.RenderItem.ModelViewProjection ) )
+                {
+                    arena[drawListIndex].push_back( drawPacket );
+                }
+            }
+        }
+    }
+}
+
+void DrawListBuilder::Visit( Scene& scene )
+{}
+
+void DrawListBuilder::Visit( SceneNode& node )
+{
+    FlatNode flatNode = { &node, static_cast<uint32_t>( m_Meshes.size() ), 0 };
+    m_Nodes.push_back( flatNode );
+}
+
+void DrawListBuilder::Visit( Mesh& mesh )
+{
+    // Meshes are visited directly after the node they belong to.
+    assert( !m_Nodes.empty() );
+    m_Meshes.push_back( &mesh );
+    m_Nodes.back().NumMeshes += 1;
+}
@@ -12,23 +12,37 @@ public:
     double GetElapsedTimeInMicroSeconds();
 
 private:
+#if defined(_WIN32)
     LARGE_INTEGER t0, t1;
     LARGE_INTEGER frequency;
+#else
+    // The performance counter is only available on Windows.
+    std::chrono::high_resolution_clock::time_point t0, t1;
+#endif
     double elapsedTime;
 };
 
 HighResolutionTimerImpl::HighResolutionTimerImpl()
 : elapsedTime(0)
 {
+#if defined(_WIN32)
     QueryPerformanceFrequency(&frequency);
     QueryPerformanceCounter(&t0);
+#else
+    t0 = std::chrono::high_resolution_clock::now();
+#endif
 }
 
 void HighResolutionTimerImpl::Tick()
 {
+#if defined(_WIN32)
     QueryPerformanceCounter(&t1);
     // Compute the value in microseconds (1 second = 1,000,000 microseconds)
     elapsedTime = ( t1.QuadPart - t0.QuadPart ) * ( 1000000.0 / frequency.QuadPart );
+#else
+    t1 = std::chrono::high_resolution_clock::now();
+    elapsedTime = std::chrono::duration<double, std::micro>( t1 - t0 ).count();
+#endif
 
     t0 = t1;
 }
@@ -0,0 +1,149 @@
+#include <EnginePCH.h>
+
+#include <JobSystem.h>
+
+// The job system and the index of the worker thread that is running on this thread
+// (nullptr if the thread is not a worker thread).
+static thread_local const JobSystem* t_pJobSystem = nullptr;
+static thread_local uint32_t t_ThreadIndex = 0;
+
+JobSystem::JobSystem( uint32_t numWorkerThreads )
+    : m_Quit( false )
+{
+    if ( numWorkerThreads == 0 )
+    {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        numWorkerThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    for ( uint32_t i = 0; i < numWorkerThreads; ++i )
+    {
+        m_WorkerThreads.push_back( std::thread( &JobSystem::WorkerThread, this, i + 1 ) );
+    }
+
+    m_NumThreads = GetMaxThreads();
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::unique_lock<std::mutex> lock( m_Mutex );
+        m_Quit = true;
+    }
+    m_JobAvailable.notify_all();
+
+    for ( std::thread& thread : m_WorkerThreads )
+    {
+        thread.join();
+    }
+}
+
+uint32_t JobSystem::GetMaxThreads() const
+{
+    return static_cast<uint32_t>( m_WorkerThreads.size() ) + 1;
+}
+
+void JobSystem::SetNumThreads( uint32_t numThreads )
+{
+    m_NumThreads = glm::clamp<uint32_t>( numThreads, 1, GetMaxThreads() );
+}
+
+uint32_t JobSystem::GetNumThreads() const
+{
+    return m_NumThreads;
+}
+
+void JobSystem::ParallelFor( uint32_t count, uint32_t batchSize, const ParallelForFunction& function )
+{
+    if ( count == 0 ) return;
+
+    // A worker thread that starts a nested loop keeps its own index.
+    uint32_t threadIndex = ( t_pJobSystem == this ) ? t_ThreadIndex : 0;
+
+    batchSize = std::max<uint32_t>( batchSize, 1 );
+    uint32_t numBatches = ( count + batchSize - 1 ) / batchSize;
+    uint32_t numWorkers = std::min( m_NumThreads - 1, numBatches - 1 );
+
+    if ( numWorkers == 0 )
+    {
+        // Nothing to gain from waking up the worker threads.
+        for ( uint32_t begin = 0; begin < count; begin += batchSize )
+        {
+            function( begin, std::min( begin + batchSize, count ), threadIndex );
+        }
+        return;
+    }
+
+    Job job;
+    job.Function = &function;
+    job.Count = count;
+    job.BatchSize = batchSize;
+    job.NumBatches = numBatches;
+    job.NextBatch = 0;
+    job.MaxWorkers = numWorkers;
+    job.NumActiveWorkers = 0;
+
+    {
+        std::unique_lock<std::mutex> lock( m_Mutex );
+        m_Jobs.push_back( &job );
+    }
+    m_JobAvailable.notify_all();
+
+    // The calling thread also executes batches (only of its own loop).
+    ExecuteBatches( job, threadIndex );
+
+    // All batches have been started. Wait for the worker threads to finish their batches.
+    std::unique_lock<std::mutex> lock( m_Mutex );
+    m_Jobs.erase( std::find( m_Jobs.begin(), m_Jobs.end(), &job ) );
+    m_JobFinished.wait( lock, [&]() { return job.NumActiveWorkers == 0; } );
+}
+
+JobSystem::Job* JobSystem::FindJob()
+{
+    for ( Job* job : m_Jobs )
+    {
+        if ( job->NumActiveWorkers < job->MaxWorkers && job->NextBatch < job->NumBatches )
+        {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::ExecuteBatches( Job& job, uint32_t threadIndex )
+{
+    uint32_t batch;
+    while ( ( batch = job.NextBatch++ ) < job.NumBatches )
+    {
+        uint32_t begin = batch * job.BatchSize;
+        uint32_t end = std::min( begin + job.BatchSize, job.Count );
+        ( *job.Function )( begin, end, threadIndex );
+    }
+}
+
+void JobSystem::WorkerThread( uint32_t threadIndex )
+{
+    t_pJobSystem = this;
+    t_ThreadIndex = threadIndex;
+
+    std::unique_lock<std::mutex> lock( m_Mutex );
+    while ( true )
+    {
+        Job* job = nullptr;
+        m_JobAvailable.wait( lock, [&]() { return m_Quit || ( job = FindJob() ) != nullptr; } );
+
+        if ( m_Quit ) break;
+
+        ++job->NumActiveWorkers;
+        lock.unlock();
+
+        ExecuteBatches( *job, threadIndex );
+
+        lock.lock();
+        // The job is owned by the calling thread and can be destroyed as soon as it is finished.
+        if ( --job->NumActiveWorkers == 0 )
+        {
+            m_JobFinished.notify_all();
+        }
+    }
+}
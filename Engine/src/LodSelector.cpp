@@ -0,0 +1,88 @@
+#include <EnginePCH.h>
+
+#include <Mesh.h>
+#include <Camera.h>
+#include <BoundingBox.h>
+
+#include <LodSelector.h>
+
+// The minimum view distance that is used to project the error of a mesh
+// (for meshes that intersect the near plane).
+#define MIN_LOD_DISTANCE 0.01f
+
+LodSelector::LodSelector( float errorThreshold, float hysteresis )
+    : m_Enabled( true )
+    , m_ErrorThreshold( errorThreshold )
+    , m_Hysteresis( hysteresis )
+    , m_ProjectionScale( 0.0f )
+{}
+
+LodSelector::~LodSelector()
+{}
+
+void LodSelector::SetEnabled( bool enabled )
+{
+    m_Enabled = enabled;
+}
+
+bool LodSelector::IsEnabled() const
+{
+    return m_Enabled;
+}
+
+void LodSelector::SetErrorThreshold( float errorThreshold )
+{
+    m_ErrorThreshold = errorThreshold;
+}
+
+float LodSelector::GetErrorThreshold() const
+{
+    return m_ErrorThreshold;
+}
+
+void LodSelector::SetHysteresis( float hysteresis )
+{
+    m_Hysteresis = hysteresis;
+}
+
+float LodSelector::GetHysteresis() const
+{
+    return m_Hysteresis;
+}
+
+void LodSelector::Update( Camera& camera )
+{
+    // The vertical scale of the projection matrix is 1 / tan( fov / 2 ).
+    m_ProjectionScale = camera.GetProjectionMatrix()[1][1] * camera.GetViewport().Height * 0.5f;
+}
+
+uint32_t LodSelector::SelectLod( const Mesh& mesh, const glm::mat4& modelView, uint32_t currentLod ) const
+{
+    uint32_t numLods = mesh.GetNumLods();
+    if ( !m_Enabled || numLods <= 1 ) return 0;
+
+    currentLod = std::min( currentLod, numLods - 1 );
+
+    // The distance from the camera to the bounding sphere of the mesh.
+    const BoundingBox& boundingBox = mesh.GetBoundingBox();
+    float scale = glm::length( glm::vec3( modelView[0] ) );
+    glm::vec3 center = glm::vec3( modelView * glm::vec4( boundingBox.GetCenter(), 1 ) );
+    float radius = glm::length( boundingBox.GetExtents() ) * scale;
+    float distance = std::max( glm::length( center ) - radius, MIN_LOD_DISTANCE );
+
+    float pixelsPerUnit = m_ProjectionScale * scale / distance;
+
+    // The errors increase with the level of detail.
+    uint32_t lod = 0;
+    uint32_t coarserLod = 0;
+    for ( uint32_t i = 1; i < numLods; ++i )
+    {
+        float error = mesh.GetLodError( i ) * pixelsPerUnit;
+        if ( error <= m_ErrorThreshold ) lod = i;
+        if ( error <= m_ErrorThreshold * ( 1.0f - m_Hysteresis ) ) coarserLod = i;
+    }
+
+    // Switch to a more detailed level immediately but only
+    // switch to a coarser level if the error is well below the threshold.
+    return ( lod < currentLod ) ? lod : std::max( coarserLod, currentLod );
+}
@@ -8,6 +8,8 @@
 
 #include <Material.h>
 
+static const ShaderParameterID gs_MaterialID( "Material" );
+
 Material::Material( RenderDevice& renderDevice )
     : m_RenderDevice( renderDevice )
     , m_Dirty( false )
@@ -40,13 +42,8 @@ void Material::Bind( std::weak_ptr<Shader> wpShader ) const
     std::shared_ptr<Shader> pShader = wpShader.lock();
     if ( !pShader ) return;
 
-    if ( m_Dirty )
-    {
-        // Make sure the constant buffer associated to this material is updated.
-        Material* _this = const_cast<Material*>( this );
-        _this->UpdateConstantBuffer();
-        _this->m_Dirty = false;
-    }
+    // Make sure the constant buffer associated to this material is updated.
+    const_cast<Material*>( this )->Update();
 
     // OOPS.. Dangerous. Just blindly set all textures associated to this material.
     // Maybe I should check the names of the textures in the shader before doing this?
@@ -59,14 +56,12 @@ void Material::Bind( std::weak_ptr<Shader> wpShader ) const
     }
 
     // If the shader has a parameter called "Material".
-    ShaderParameter& materialParameter = pShader->GetShaderParameterByName( "Material" );
+    ShaderParameter& materialParameter = pShader->GetShaderParameter( gs_MaterialID );
     if ( materialParameter.IsValid() )
     {
-        // Assign this material's constant buffer to it.
-        materialParameter.Set<ConstantBuffer>( m_pConstantBuffer );
-        // If the shader parameter is modified, they have to be 
-        // rebound to update the rendering pipeline.
-        materialParameter.Bind();
+        // Bind this material's constant buffer to it (without assigning it to the
+        // parameter, so the same shader can be bound with different materials on multiple threads).
+        materialParameter.BindResource<ConstantBuffer>( m_pConstantBuffer );
     }
 }
 
@@ -240,6 +235,11 @@ void Material::SetTexture( TextureType type, std::shared_ptr<Texture> texture )
     m_Dirty = true;
 }
 
+void Material::SetPlaceholderTexture( TextureType type, std::shared_ptr<Texture> texture )
+{
+    m_Textures[type] = texture;
+}
+
 bool Material::IsTransparent() const
 {
     return ( m_pProperties->m_Opacity < 1.0f ||
@@ -248,6 +248,15 @@ bool Material::IsTransparent() const
              m_pProperties->m_AlphaThreshold <= 0.0f ); // Objects with an alpha threshold > 0 should be drawn in the opaque pass.
 }
 
+void Material::Update()
+{
+    if ( m_Dirty )
+    {
+        UpdateConstantBuffer();
+        m_Dirty = false;
+    }
+}
+
 void Material::UpdateConstantBuffer()
 {
     if ( m_pConstantBuffer )
@@ -0,0 +1,621 @@
+#include <EnginePCH.h>
+
+#include "MeshOptimizer.h"
+
+// The size of the simulated vertex cache that is used to score the vertices.
+#define VERTEX_CACHE_SIZE 32
+// Vertices with more active triangles than this all get the same valence score.
+#define MAX_VALENCE 32
+
+// The tuning parameters suggested by Tom Forsyth.
+#define CACHE_DECAY_POWER 1.5f
+#define LAST_TRIANGLE_SCORE 0.75f
+#define VALENCE_BOOST_SCALE 2.0f
+#define VALENCE_BOOST_POWER 0.5f
+
+// At most 1/MAX_COLLAPSE_RATIO of the triangles are removed in each simplification pass.
+#define MAX_COLLAPSE_RATIO 8
+
+static const uint32_t INVALID_INDEX = 0xffffffff;
+
+// The score of a vertex depends on its position in the cache (-1 if it is not in the cache)
+// and the number of triangles that still have to be emitted that use this vertex.
+struct VertexScoreTable
+{
+    VertexScoreTable()
+    {
+        for ( int i = 0; i < VERTEX_CACHE_SIZE; ++i )
+        {
+            if ( i < 3 )
+            {
+                // The vertices of the last triangle get a fixed score so that the next
+                // triangle does not share an edge with it (which would produce long strips).
+                CachePositionScores[i] = LAST_TRIANGLE_SCORE;
+            }
+            else
+            {
+                const float scale = 1.0f / ( VERTEX_CACHE_SIZE - 3 );
+                CachePositionScores[i] = powf( 1.0f - ( i - 3 ) * scale, CACHE_DECAY_POWER );
+            }
+        }
+
+        ValenceScores[0] = 0.0f;
+        for ( int i = 1; i <= MAX_VALENCE; ++i )
+        {
+            // Vertices with few remaining triangles get a boost so that they are removed from the mesh
+            // as soon as possible (instead of leaving lone triangles that need the vertex again later).
+            ValenceScores[i] = VALENCE_BOOST_SCALE * powf( static_cast<float>( i ), -VALENCE_BOOST_POWER );
+        }
+    }
+
+    float GetScore( int32_t cachePosition, uint32_t numActiveTriangles ) const
+    {
+        // Vertices without any remaining triangles are never used again.
+        if ( numActiveTriangles == 0 ) return -1.0f;
+
+        float score = ( cachePosition >= 0 ) ? CachePositionScores[cachePosition] : 0.0f;
+        return score + ValenceScores[std::min<uint32_t>( numActiveTriangles, MAX_VALENCE )];
+    }
+
+    float CachePositionScores[VERTEX_CACHE_SIZE];
+    float ValenceScores[MAX_VALENCE + 1];
+};
+
+void OptimizeVertexCache( uint32_t* indices, size_t numIndices, uint32_t numVertices )
+{
+    static const VertexScoreTable scoreTable;
+
+    size_t numTriangles = numIndices / 3;
+    if ( numTriangles == 0 ) return;
+
+    // Build the list of triangles that use each vertex.
+    std::vector<uint32_t> activeTriangles( numVertices, 0 );
+    for ( size_t i = 0; i < numIndices; ++i )
+    {
+        assert( indices[i] < numVertices );
+        ++activeTriangles[indices[i]];
+    }
+
+    std::vector<uint32_t> adjacencyOffsets( numVertices );
+    uint32_t offset = 0;
+    for ( uint32_t v = 0; v < numVertices; ++v )
+    {
+        adjacencyOffsets[v] = offset;
+        offset += activeTriangles[v];
+    }
+
+    std::vector<uint32_t> adjacency( numIndices );
+    std::vector<uint32_t> adjacencyCounts( numVertices, 0 );
+    for ( size_t i = 0; i < numIndices; ++i )
+    {
+        uint32_t v = indices[i];
+        adjacency[adjacencyOffsets[v] + adjacencyCounts[v]++] = static_cast<uint32_t>( i / 3 );
+    }
+
+    // Compute the initial scores.
+    std::vector<int32_t> cachePositions( numVertices, -1 );
+    std::vector<float> vertexScores( numVertices );
+    for ( uint32_t v = 0; v < numVertices; ++v )
+    {
+        vertexScores[v] = scoreTable.GetScore( -1, activeTriangles[v] );
+    }
+
+    std::vector<float> triangleScores( numTriangles );
+    std::vector<bool> emitted( numTriangles, false );
+    for ( size_t t = 0; t < numTriangles; ++t )
+    {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+    }
+
+    // Start with the triangle with the highest score.
+    size_t bestTriangle = std::max_element( triangleScores.begin(), triangleScores.end() ) - triangleScores.begin();
+    // Used to find the next triangle if none of the triangles in the cache can be emitted.
+    size_t nextTriangle = 0;
+
+    std::vector<uint32_t> output;
+    output.reserve( numTriangles * 3 );
+
+    // The cache temporarily holds 3 more vertices while it is updated.
+    uint32_t cache[VERTEX_CACHE_SIZE + 3];
+    uint32_t cacheSize = 0;
+
+    while ( bestTriangle != INVALID_INDEX )
+    {
+        const uint32_t* triangle = indices + bestTriangle * 3;
+        emitted[bestTriangle] = true;
+
+        // Emit the triangle and remove it from the lists of active triangles of its vertices.
+        for ( int k = 0; k < 3; ++k )
+        {
+            uint32_t v = triangle[k];
+            output.push_back( v );
+
+            uint32_t* begin = adjacency.data() + adjacencyOffsets[v];
+            uint32_t* end = begin + activeTriangles[v];
+            uint32_t* iter = std::find( begin, end, static_cast<uint32_t>( bestTriangle ) );
+            assert( iter != end );
+            std::swap( *iter, *( end - 1 ) );
+            --activeTriangles[v];
+        }
+
+        // The vertices of the triangle move to the front of the cache.
+        uint32_t newCache[VERTEX_CACHE_SIZE + 3];
+        uint32_t newCacheSize = 0;
+        for ( int k = 0; k < 3; ++k )
+        {
+            // Degenerate triangles can use the same vertex more than once.
+            if ( std::find( newCache, newCache + newCacheSize, triangle[k] ) == newCache + newCacheSize )
+            {
+                newCache[newCacheSize++] = triangle[k];
+            }
+        }
+        for ( uint32_t i = 0; i < cacheSize; ++i )
+        {
+            if ( cache[i] != triangle[0] && cache[i] != triangle[1] && cache[i] != triangle[2] )
+            {
+                newCache[newCacheSize++] = cache[i];
+            }
+        }
+
+        // Update the scores of the vertices whose position in the cache changed
+        // (including the ones that were pushed out of the cache) and their triangles.
+        for ( uint32_t i = 0; i < newCacheSize; ++i )
+        {
+            uint32_t v = newCache[i];
+            cachePositions[v] = ( i < VERTEX_CACHE_SIZE ) ? static_cast<int32_t>( i ) : -1;
+
+            float score = scoreTable.GetScore( cachePositions[v], activeTriangles[v] );
+            float delta = score - vertexScores[v];
+            vertexScores[v] = score;
+
+            const uint32_t* adjacent = adjacency.data() + adjacencyOffsets[v];
+            for ( uint32_t j = 0; j < activeTriangles[v]; ++j )
+            {
+                triangleScores[adjacent[j]] += delta;
+            }
+        }
+
+        cacheSize = std::min<uint32_t>( newCacheSize, VERTEX_CACHE_SIZE );
+        std::copy( newCache, newCache + cacheSize, cache );
+
+        // The next triangle is the one with the highest score that uses a vertex in the cache.
+        bestTriangle = INVALID_INDEX;
+        float bestScore = -std::numeric_limits<float>::max();
+        for ( uint32_t i = 0; i < cacheSize; ++i )
+        {
+            uint32_t v = cache[i];
+            const uint32_t* adjacent = adjacency.data() + adjacencyOffsets[v];
+            for ( uint32_t j = 0; j < activeTriangles[v]; ++j )
+            {
+                if ( triangleScores[adjacent[j]] > bestScore )
+                {
+                    bestScore = triangleScores[adjacent[j]];
+                    bestTriangle = adjacent[j];
+                }
+            }
+        }
+
+        // If none of the vertices in the cache have any triangles left, continue with any remaining triangle.
+        if ( bestTriangle == INVALID_INDEX )
+        {
+            while ( nextTriangle < numTriangles && emitted[nextTriangle] )
+            {
+                ++nextTriangle;
+            }
+            if ( nextTriangle < numTriangles )
+            {
+                bestTriangle = nextTriangle;
+            }
+        }
+    }
+
+    assert( output.size() == numTriangles * 3 );
+    std::copy( output.begin(), output.end(), indices );
+}
+
+void OptimizeVertexFetch( uint32_t* indices, size_t numIndices, uint32_t numVertices, std::vector<uint32_t>& remap )
+{
+    remap.assign( numVertices, INVALID_INDEX );
+    uint32_t nextVertex = 0;
+
+    for ( size_t i = 0; i < numIndices; ++i )
+    {
+        uint32_t& v = indices[i];
+        if ( remap[v] == INVALID_INDEX )
+        {
+            remap[v] = nextVertex++;
+        }
+        v = remap[v];
+    }
+
+    // Keep the vertices that are not used by any triangle.
+    for ( uint32_t v = 0; v < numVertices; ++v )
+    {
+        if ( remap[v] == INVALID_INDEX )
+        {
+            remap[v] = nextVertex++;
+        }
+    }
+}
+
+VertexCacheStatistics AnalyzeVertexCache( const uint32_t* indices, size_t numIndices, uint32_t numVertices, uint32_t cacheSize )
+{
+    VertexCacheStatistics statistics = {};
+
+    // A vertex is in the cache if it was one of the last cacheSize vertices that were added to the cache.
+    std::vector<uint32_t> timestamps( numVertices, 0 );
+    uint32_t time = cacheSize + 1;
+
+    for ( size_t i = 0; i < numIndices; ++i )
+    {
+        uint32_t v = indices[i];
+        if ( time - timestamps[v] > cacheSize )
+        {
+            timestamps[v] = time++;
+            ++statistics.VerticesTransformed;
+        }
+    }
+
+    size_t numTriangles = numIndices / 3;
+    statistics.ACMR = numTriangles > 0 ? static_cast<float>( statistics.VerticesTransformed ) / numTriangles : 0.0f;
+    statistics.ATVR = numVertices > 0 ? static_cast<float>( statistics.VerticesTransformed ) / numVertices : 0.0f;
+
+    return statistics;
+}
+
+// The squared distance to a set of planes stored as a symmetric 4x4 matrix (upper triangle).
+struct Quadric
+{
+    double a00, a01, a02, a03;
+    double a11, a12, a13;
+    double a22, a23;
+    double a33;
+};
+
+static void AddPlane( Quadric& q, const glm::dvec4& p )
+{
+    q.a00 += p.x * p.x; q.a01 += p.x * p.y; q.a02 += p.x * p.z; q.a03 += p.x * p.w;
+    q.a11 += p.y * p.y; q.a12 += p.y * p.z; q.a13 += p.y * p.w;
+    q.a22 += p.z * p.z; q.a23 += p.z * p.w;
+    q.a33 += p.w * p.w;
+}
+
+static void AddQuadric( Quadric& q, const Quadric& r )
+{
+    q.a00 += r.a00; q.a01 += r.a01; q.a02 += r.a02; q.a03 += r.a03;
+    q.a11 += r.a11; q.a12 += r.a12; q.a13 += r.a13;
+    q.a22 += r.a22; q.a23 += r.a23;
+    q.a33 += r.a33;
+}
+
+// Returns the sum of the squared distances of the point to the planes of the quadric.
+static double EvaluateQuadric( const Quadric& q, const glm::vec3& v )
+{
+    double x = v.x, y = v.y, z = v.z;
+    double error = q.a00 * x * x + 2.0 * q.a01 * x * y + 2.0 * q.a02 * x * z + 2.0 * q.a03 * x +
+                   q.a11 * y * y + 2.0 * q.a12 * y * z + 2.0 * q.a13 * y +
+                   q.a22 * z * z + 2.0 * q.a23 * z +
+                   q.a33;
+    // Rounding errors can produce (very small) negative values.
+    return std::max( error, 0.0 );
+}
+
+float SimplifyMesh( const uint32_t* indices, size_t numIndices, const glm::vec3* positions, uint32_t numVertices, size_t targetIndexCount, std::vector<uint32_t>& result )
+{
+    result.assign( indices, indices + numIndices );
+    if ( numIndices <= targetIndexCount ) return 0.0f;
+
+    // Vertices at the same position (for example, at texture seams) are collapsed onto the same position id.
+    std::vector<uint32_t> positionIds( numVertices );
+    {
+        std::vector<uint32_t> sortedVertices( numVertices );
+        for ( uint32_t v = 0; v < numVertices; ++v ) sortedVertices[v] = v;
+
+        auto lessPosition = [&]( uint32_t a, uint32_t b )
+        {
+            const glm::vec3& pa = positions[a];
+            const glm::vec3& pb = positions[b];
+            return ( pa.x != pb.x ) ? pa.x < pb.x : ( pa.y != pb.y ) ? pa.y < pb.y : pa.z < pb.z;
+        };
+        std::sort( sortedVertices.begin(), sortedVertices.end(), lessPosition );
+
+        for ( uint32_t i = 0; i < numVertices; ++i )
+        {
+            uint32_t v = sortedVertices[i];
+            bool samePosition = i > 0 && positions[sortedVertices[i - 1]] == positions[v];
+            positionIds[v] = samePosition ? positionIds[sortedVertices[i - 1]] : v;
+        }
+    }
+
+    // Lock the vertices on attribute seams and on the open borders of the mesh.
+    std::vector<bool> locked( numVertices, false );
+    {
+        std::vector<uint32_t> numVerticesAtPosition( numVertices, 0 );
+        for ( uint32_t v = 0; v < numVertices; ++v )
+        {
+            ++numVerticesAtPosition[positionIds[v]];
+        }
+
+        // An edge is on the border if it is used by a single triangle.
+        std::vector<uint64_t> edges;
+        edges.reserve( numIndices );
+        for ( size_t i = 0; i < numIndices; i += 3 )
+        {
+            for ( int k = 0; k < 3; ++k )
+            {
+                uint64_t a = positionIds[indices[i + k]];
+                uint64_t b = positionIds[indices[i + ( k + 1 ) % 3]];
+                edges.push_back( ( std::min( a, b ) << 32 ) | std::max( a, b ) );
+            }
+        }
+        std::sort( edges.begin(), edges.end() );
+
+        std::vector<bool> lockedPosition( numVertices, false );
+        for ( size_t i = 0; i < edges.size(); )
+        {
+            size_t j = i + 1;
+            while ( j < edges.size() && edges[j] == edges[i] ) ++j;
+            if ( j - i == 1 )
+            {
+                lockedPosition[edges[i] >> 32] = true;
+                lockedPosition[edges[i] & 0xffffffff] = true;
+            }
+            i = j;
+        }
+
+        for ( uint32_t v = 0; v < numVertices; ++v )
+        {
+            locked[v] = lockedPosition[positionIds[v]] || numVerticesAtPosition[positionIds[v]] > 1;
+        }
+    }
+
+    // The quadric of a vertex is the sum of the planes of its triangles.
+    std::vector<Quadric> quadrics( numVertices, Quadric() );
+    for ( size_t i = 0; i < numIndices; i += 3 )
+    {
+        const glm::vec3& p0 = positions[indices[i]];
+        glm::vec3 normal = glm::cross( positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0 );
+        float length = glm::length( normal );
+        if ( length <= 0.0f ) continue;
+
+        normal /= length;
+        glm::dvec4 plane( normal, -glm::dot( normal, p0 ) );
+        for ( int k = 0; k < 3; ++k )
+        {
+            AddPlane( quadrics[indices[i + k]], plane );
+        }
+    }
+
+    struct Collapse
+    {
+        uint32_t From;
+        uint32_t To;
+        double Cost;
+    };
+    std::vector<Collapse> collapses;
+
+    std::vector<uint32_t> adjacencyOffsets( numVertices + 1 );
+    std::vector<uint32_t> adjacency;
+    std::vector<uint32_t> remap( numVertices );
+    std::vector<bool> touched( numVertices );
+
+    double maxError = 0.0;
+
+    // Each pass collapses a set of independent edges (no two collapses share a triangle).
+    while ( result.size() > targetIndexCount )
+    {
+        const size_t numTriangles = result.size() / 3;
+
+        // The triangles that use each vertex.
+        std::fill( adjacencyOffsets.begin(), adjacencyOffsets.end(), 0 );
+        for ( uint32_t v : result )
+        {
+            ++adjacencyOffsets[v + 1];
+        }
+        for ( uint32_t v = 0; v < numVertices; ++v )
+        {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        adjacency.resize( result.size() );
+        {
+            std::vector<uint32_t> fill( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+            for ( size_t i = 0; i < result.size(); ++i )
+            {
+                adjacency[fill[result[i]]++] = static_cast<uint32_t>( i / 3 );
+            }
+        }
+
+        // Collapsing a vertex onto the other vertex of an edge moves it to that vertex's position.
+        collapses.clear();
+        for ( size_t i = 0; i < result.size(); i += 3 )
+        {
+            for ( int k = 0; k < 3; ++k )
+            {
+                uint32_t a = result[i + k];
+                uint32_t b = result[i + ( k + 1 ) % 3];
+                double cost = EvaluateQuadric( quadrics[a], positions[b] ) + EvaluateQuadric( quadrics[b], positions[b] );
+                if ( !locked[a] ) collapses.push_back( { a, b, cost } );
+
+                cost = EvaluateQuadric( quadrics[a], positions[a] ) + EvaluateQuadric( quadrics[b], positions[a] );
+                if ( !locked[b] ) collapses.push_back( { b, a, cost } );
+            }
+        }
+        std::sort( collapses.begin(), collapses.end(), []( const Collapse& a, const Collapse& b )
+        {
+            return a.Cost < b.Cost;
+        } );
+
+        for ( uint32_t v = 0; v < numVertices; ++v ) remap[v] = v;
+        std::fill( touched.begin(), touched.end(), false );
+
+        // Collapsing an edge removes the two triangles that share the edge.
+        // Only the cheapest collapses are done in each pass because the costs
+        // of the remaining edges change once their neighbors are collapsed.
+        size_t trianglesToRemove = std::min( numTriangles - targetIndexCount / 3, std::max<size_t>( numTriangles / MAX_COLLAPSE_RATIO, 2 ) );
+        size_t trianglesRemoved = 0;
+
+        for ( const Collapse& collapse : collapses )
+        {
+            if ( trianglesRemoved >= trianglesToRemove ) break;
+            if ( touched[collapse.From] || touched[collapse.To] ) continue;
+
+            // Don't collapse the edge if one of the remaining triangles would flip over.
+            bool flipped = false;
+            const glm::vec3& target = positions[collapse.To];
+            for ( uint32_t j = adjacencyOffsets[collapse.From]; j < adjacencyOffsets[collapse.From + 1] && !flipped; ++j )
+            {
+                const uint32_t* triangle = &result[adjacency[j] * 3];
+                if ( triangle[0] == collapse.To || triangle[1] == collapse.To || triangle[2] == collapse.To ) continue;
+
+                glm::vec3 p[3] = { positions[triangle[0]], positions[triangle[1]], positions[triangle[2]] };
+                glm::vec3 normalBefore = glm::cross( p[1] - p[0], p[2] - p[0] );
+                for ( int k = 0; k < 3; ++k )
+                {
+                    if ( triangle[k] == collapse.From ) p[k] = target;
+                }
+                glm::vec3 normalAfter = glm::cross( p[1] - p[0], p[2] - p[0] );
+                flipped = glm::dot( normalBefore, normalAfter ) <= 0.0f;
+            }
+            if ( flipped ) continue;
+
+            remap[collapse.From] = collapse.To;
+            AddQuadric( quadrics[collapse.To], quadrics[collapse.From] );
+            maxError = std::max( maxError, collapse.Cost );
+            trianglesRemoved += 2;
+
+            // The triangles around the collapsed vertex have changed so their vertices
+            // can't be used by any other collapses in this pass.
+            touched[collapse.From] = touched[collapse.To] = true;
+            for ( uint32_t j = adjacencyOffsets[collapse.From]; j < adjacencyOffsets[collapse.From + 1]; ++j )
+            {
+                const uint32_t* triangle = &result[adjacency[j] * 3];
+                touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = true;
+            }
+        }
+
+        if ( trianglesRemoved == 0 ) break;
+
+        // Remove the triangles that became degenerate.
+        size_t numResultIndices = 0;
+        for ( size_t i = 0; i < result.size(); i += 3 )
+        {
+            uint32_t a = remap[result[i]];
+            uint32_t b = remap[result[i + 1]];
+            uint32_t c = remap[result[i + 2]];
+            if ( a != b && b != c && c != a )
+            {
+                result[numResultIndices++] = a;
+                result[numResultIndices++] = b;
+                result[numResultIndices++] = c;
+            }
+        }
+        result.resize( numResultIndices );
+    }
+
+    return static_cast<float>( sqrt( maxError ) );
+}
+
+// Compute the bounding sphere and the normal cone of a meshlet.
+// See: "Optimizing the Graphics Pipeline with Compute" (Wihlidal, 2016).
+static void ComputeMeshletBounds( const uint32_t* indices, const glm::vec3* positions, MeshletInfo& meshlet )
+{
+    const uint32_t* triangles = indices + meshlet.FirstIndex;
+
+    glm::vec3 boundsMin = positions[triangles[0]];
+    glm::vec3 boundsMax = boundsMin;
+    glm::vec3 normalSum( 0 );
+    for ( uint32_t i = 0; i < meshlet.NumIndices; i += 3 )
+    {
+        const glm::vec3& p0 = positions[triangles[i]];
+        const glm::vec3& p1 = positions[triangles[i + 1]];
+        const glm::vec3& p2 = positions[triangles[i + 2]];
+        boundsMin = glm::min( boundsMin, glm::min( p0, glm::min( p1, p2 ) ) );
+        boundsMax = glm::max( boundsMax, glm::max( p0, glm::max( p1, p2 ) ) );
+
+        glm::vec3 normal = glm::cross( p1 - p0, p2 - p0 );
+        float length = glm::length( normal );
+        if ( length > 0.0f ) normalSum += normal / length;
+    }
+
+    meshlet.Center = ( boundsMin + boundsMax ) * 0.5f;
+    meshlet.Radius = 0.0f;
+    for ( uint32_t i = 0; i < meshlet.NumIndices; ++i )
+    {
+        meshlet.Radius = std::max( meshlet.Radius, glm::distance( meshlet.Center, positions[triangles[i]] ) );
+    }
+
+    // The cone axis is the average normal and the cone angle is the largest angle between the axis and any normal.
+    meshlet.ConeAxis = glm::vec3( 0 );
+    meshlet.ConeCutoff = 1.0f;
+
+    float axisLength = glm::length( normalSum );
+    if ( axisLength <= 0.0f ) return;
+
+    glm::vec3 axis = normalSum / axisLength;
+    float minDot = 1.0f;
+    for ( uint32_t i = 0; i < meshlet.NumIndices; i += 3 )
+    {
+        const glm::vec3& p0 = positions[triangles[i]];
+        glm::vec3 normal = glm::cross( positions[triangles[i + 1]] - p0, positions[triangles[i + 2]] - p0 );
+        float length = glm::length( normal );
+        if ( length > 0.0f ) minDot = std::min( minDot, glm::dot( axis, normal / length ) );
+    }
+
+    // If the normals are spread over more than a hemisphere, the meshlet can't be back facing.
+    if ( minDot <= 0.0f ) return;
+
+    meshlet.ConeAxis = axis;
+    // sin( angle ) = cos( angle + 90 degrees ) of the cone that contains the normals.
+    meshlet.ConeCutoff = sqrtf( 1.0f - minDot * minDot );
+}
+
+void BuildMeshlets( const uint32_t* indices, size_t numIndices, const glm::vec3* positions, uint32_t numVertices, uint32_t maxVertices, uint32_t maxTriangles, std::vector<MeshletInfo>& meshlets )
+{
+    meshlets.clear();
+    if ( numIndices == 0 ) return;
+
+    // The meshlet that last used each vertex.
+    std::vector<uint32_t> vertexMeshlet( numVertices, INVALID_INDEX );
+
+    MeshletInfo meshlet = {};
+    uint32_t meshletIndex = 0;
+
+    for ( size_t i = 0; i + 2 < numIndices; i += 3 )
+    {
+        const uint32_t* triangle = indices + i;
+
+        uint32_t numNewVertices = 0;
+        for ( int k = 0; k < 3; ++k )
+        {
+            bool duplicate = ( k > 0 && triangle[k] == triangle[0] ) || ( k > 1 && triangle[k] == triangle[1] );
+            if ( !duplicate && vertexMeshlet[triangle[k]] != meshletIndex ) ++numNewVertices;
+        }
+
+        if ( meshlet.NumVertices + numNewVertices > maxVertices || meshlet.NumIndices / 3 + 1 > maxTriangles )
+        {
+            ComputeMeshletBounds( indices, positions, meshlet );
+            meshlets.push_back( meshlet );
+
+            // All vertices of the triangle are new in the next meshlet.
+            ++meshletIndex;
+            meshlet = {};
+            meshlet.FirstIndex = static_cast<uint32_t>( i );
+            numNewVertices = 0;
+            for ( int k = 0; k < 3; ++k )
+            {
+                bool duplicate = ( k > 0 && triangle[k] == triangle[0] ) || ( k > 1 && triangle[k] == triangle[1] );
+                if ( !duplicate ) ++numNewVertices;
+            }
+        }
+
+        for ( int k = 0; k < 3; ++k )
+        {
+            vertexMeshlet[triangle[k]] = meshletIndex;
+        }
+        meshlet.NumVertices += numNewVertices;
+        meshlet.NumIndices += 3;
+    }
+
+    ComputeMeshletBounds( indices, positions, meshlet );
+    meshlets.push_back( meshlet );
+}
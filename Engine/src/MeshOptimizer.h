@@ -0,0 +1,69 @@
+#pragma once
+
+/**
+ * Functions to optimize the index and vertex order of triangle meshes for the GPU.
+ * The triangles are reordered to improve the hit rate of the post-transform vertex
+ * cache (so fewer vertices are shaded more than once) and the vertices are reordered
+ * in the order they are referenced by the triangles (so vertex fetches are more coherent).
+ * Meshes can also be simplified (for levels of detail) and split into meshlets (for cluster culling).
+ * All functions operate on indexed triangle lists.
+ */
+
+// The results of simulating the post-transform vertex cache for an index buffer.
+struct VertexCacheStatistics
+{
+    // The number of times the vertex shader is invoked.
+    uint32_t VerticesTransformed;
+    // Average cache miss ratio: the number of transformed vertices per triangle.
+    // 3 is the worst case, about 0.5 is the best case for large regular meshes.
+    float ACMR;
+    // Average transform to vertex ratio: the number of times each vertex is transformed.
+    // 1 is the best case.
+    float ATVR;
+};
+
+// A cluster of triangles that is small enough to be culled as a unit.
+struct MeshletInfo
+{
+    // The triangles of the meshlet are a range of the index buffer.
+    uint32_t FirstIndex;
+    uint32_t NumIndices;
+    // The number of unique vertices that are used by the triangles.
+    uint32_t NumVertices;
+    // The bounding sphere of the triangles.
+    glm::vec3 Center;
+    float Radius;
+    // The cone that contains the normals of all triangles. The meshlet is back facing if
+    // dot( Center - viewPosition, ConeAxis ) >= ConeCutoff * length( Center - viewPosition ) + Radius.
+    // Meshlets whose normals are spread too far have a cutoff of 1 and are never back facing.
+    glm::vec3 ConeAxis;
+    float ConeCutoff;
+};
+
+// Reorder the triangles to improve the hit rate of the post-transform vertex cache.
+// See: "Linear-Speed Vertex Cache Optimisation" (Tom Forsyth, 2006).
+void OptimizeVertexCache( uint32_t* indices, size_t numIndices, uint32_t numVertices );
+
+// Compute a new order for the vertices in which they are first referenced by the indices.
+// The indices are updated to refer to the new vertex order. Unreferenced vertices are moved to the end.
+// @param remap Receives the new position of each of the original vertices.
+void OptimizeVertexFetch( uint32_t* indices, size_t numIndices, uint32_t numVertices, std::vector<uint32_t>& remap );
+
+// Reduce the number of triangles of a mesh by collapsing edges in the order of the smallest
+// quadric error until the target index count is reached or no more edges can be collapsed.
+// The simplified mesh uses the same vertices as the original mesh so it can share the vertex buffer.
+// Vertices on open borders and attribute seams (several vertices at the same position) are never
+// moved so that the mesh does not tear apart.
+// See: "Surface Simplification Using Quadric Error Metrics" (Garland and Heckbert, 1997).
+// @param positions The positions of the vertices.
+// @param result Receives the indices of the simplified mesh.
+// @return The geometric error of the simplified mesh (in the same units as the positions).
+float SimplifyMesh( const uint32_t* indices, size_t numIndices, const glm::vec3* positions, uint32_t numVertices, size_t targetIndexCount, std::vector<uint32_t>& result );
+
+// Split the triangles of a mesh into meshlets in the order of the index buffer.
+// A new meshlet is started whenever the next triangle would exceed the vertex or triangle limit
+// so the index buffer should be optimized for the vertex cache first (which keeps neighboring triangles together).
+void BuildMeshlets( const uint32_t* indices, size_t numIndices, const glm::vec3* positions, uint32_t numVertices, uint32_t maxVertices, uint32_t maxTriangles, std::vector<MeshletInfo>& meshlets );
+
+// Simulate a FIFO post-transform vertex cache with the given number of entries.
+VertexCacheStatistics AnalyzeVertexCache( const uint32_t* indices, size_t numIndices, uint32_t numVertices, uint32_t cacheSize = 16 );
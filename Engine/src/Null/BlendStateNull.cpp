@@ -0,0 +1,93 @@
+#include <EnginePCH.h>
+
+#include "BlendStateNull.h"
+
+BlendStateNull::BlendStateNull()
+    : m_bAlphaToCoverageEnabled( false )
+    , m_bIndependentBlendEnabled( false )
+    , m_SampleMask( 0xffffffff )
+    , m_ConstBlendFactor( 1 )
+{
+    m_BlendModes.resize( 8, BlendMode() );
+}
+
+BlendStateNull::BlendStateNull( const BlendStateNull& copy )
+    : m_BlendModes( copy.m_BlendModes )
+    , m_bAlphaToCoverageEnabled( copy.m_bAlphaToCoverageEnabled )
+    , m_bIndependentBlendEnabled( copy.m_bIndependentBlendEnabled )
+    , m_SampleMask( copy.m_SampleMask )
+    , m_ConstBlendFactor( copy.m_ConstBlendFactor )
+{}
+
+BlendStateNull::~BlendStateNull()
+{}
+
+const BlendStateNull& BlendStateNull::operator=( const BlendStateNull& other )
+{
+    // Avoid copy to self..
+    if ( this != &other )
+    {
+        m_BlendModes = other.m_BlendModes;
+        m_bAlphaToCoverageEnabled = other.m_bAlphaToCoverageEnabled;
+        m_bIndependentBlendEnabled = other.m_bIndependentBlendEnabled;
+        m_SampleMask = other.m_SampleMask;
+        m_ConstBlendFactor = other.m_ConstBlendFactor;
+    }
+
+    return *this;
+}
+
+void BlendStateNull::SetBlendMode( const BlendState::BlendMode& blendMode )
+{
+    m_BlendModes[0] = blendMode;
+}
+
+void BlendStateNull::SetBlendModes( const std::vector<BlendMode>& blendModes )
+{
+    m_BlendModes = blendModes;
+}
+
+const std::vector<BlendState::BlendMode>& BlendStateNull::GetBlendModes() const
+{
+    return m_BlendModes;
+}
+
+void BlendStateNull::SetConstBlendFactor( const glm::vec4& constantBlendFactor )
+{
+    m_ConstBlendFactor = constantBlendFactor;
+}
+
+const glm::vec4& BlendStateNull::GetConstBlendFactor() const
+{
+    return m_ConstBlendFactor;
+}
+
+void BlendStateNull::SetSampleMask( uint32_t sampleMask )
+{
+    m_SampleMask = sampleMask;
+}
+
+uint32_t BlendStateNull::GetSampleMask() const
+{
+    return m_SampleMask;
+}
+
+void BlendStateNull::SetAlphaCoverage( bool enabled )
+{
+    m_bAlphaToCoverageEnabled = enabled;
+}
+
+bool BlendStateNull::GetAlphaCoverage() const
+{
+    return m_bAlphaToCoverageEnabled;
+}
+
+void BlendStateNull::SetIndependentBlend( bool enabled )
+{
+    m_bIndependentBlendEnabled = enabled;
+}
+
+bool BlendStateNull::GetIndependentBlend() const
+{
+    return m_bIndependentBlendEnabled;
+}
@@ -0,0 +1,100 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "UploadQueueNull.h"
+#include "BufferNull.h"
+
+BufferNull::BufferNull( RenderCountersNull& counters, UploadQueueNull& uploadQueue, BufferType type, const void* data, size_t count, unsigned int stride )
+    : m_Counters( counters )
+    , m_UploadQueue( uploadQueue )
+    , m_BufferType( type )
+    , m_uiStride( stride )
+    , m_uiCount( (unsigned int)count )
+{
+    m_Data.resize( count * stride );
+    if ( data && !m_Data.empty() )
+    {
+        memcpy( m_Data.data(), data, m_Data.size() );
+    }
+
+    ++m_Counters.BufferUpdates;
+    m_Counters.BytesUploaded += m_Data.size();
+}
+
+BufferNull::~BufferNull()
+{}
+
+bool BufferNull::Bind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    ++counters.VertexBufferBinds;
+
+    if ( m_BufferType == IndexBuffer )
+    {
+        counters.StateCache.SetIndexBuffer( this );
+    }
+    else
+    {
+        counters.StateCache.SetVertexBuffer( id, this );
+    }
+
+    return true;
+}
+
+void BufferNull::UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    if ( m_BufferType == IndexBuffer )
+    {
+        counters.StateCache.SetIndexBuffer( nullptr );
+    }
+    else
+    {
+        counters.StateCache.SetVertexBuffer( id, nullptr );
+    }
+}
+
+void BufferNull::Copy( std::shared_ptr<Buffer> other )
+{
+    std::shared_ptr<BufferNull> srcBuffer = std::dynamic_pointer_cast<BufferNull>( other );
+
+    if ( srcBuffer && srcBuffer.get() != this &&
+         m_Data.size() == srcBuffer->m_Data.size() )
+    {
+        m_Data = srcBuffer->m_Data;
+        ++RenderCountersNull::GetCurrent( m_Counters ).Copies;
+    }
+    else
+    {
+        ReportError( "Source buffer is not compatible with this buffer." );
+    }
+}
+
+void BufferNull::SetElements( const void* data, size_t firstElement, size_t count )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    if ( firstElement + count > m_uiCount )
+    {
+        ReportError( "Buffer is too small." );
+    }
+    if ( count == 0 ) return;
+
+    memcpy( m_Data.data() + firstElement * m_uiStride, data, count * m_uiStride );
+    m_UploadQueue.Upload( this, firstElement * m_uiStride, data, count * m_uiStride );
+
+    ++counters.BufferUpdates;
+    counters.BytesUploaded += count * m_uiStride;
+}
+
+Buffer::BufferType BufferNull::GetType() const
+{
+    return m_BufferType;
+}
+
+unsigned int BufferNull::GetElementCount() const
+{
+    return m_uiCount;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Buffer.h>
+
+struct RenderCountersNull;
+class UploadQueueNull;
+
+// A vertex or index buffer that is stored in system memory.
+class BufferNull : public Buffer
+{
+public:
+    BufferNull( RenderCountersNull& counters, UploadQueueNull& uploadQueue, BufferType type, const void* data, size_t count, unsigned int stride );
+    ~BufferNull();
+
+    // Bind the buffer to a particular attribute ID or slot
+    virtual bool Bind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType );
+    virtual void UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType );
+
+    // Copy the contents of another buffer into this one.
+    // Buffers must be the same size (in bytes).
+    virtual void Copy( std::shared_ptr<Buffer> other );
+
+    // Replace count elements of this buffer, starting at firstElement.
+    virtual void SetElements( const void* data, size_t firstElement, size_t count );
+
+    // Is this an index buffer or an attribute/vertex buffer?
+    virtual BufferType GetType() const;
+    // How many elements does this buffer contain?
+    virtual unsigned int GetElementCount() const;
+
+private:
+    RenderCountersNull& m_Counters;
+    // The updates of the resource are staged in the upload queue of the device.
+    UploadQueueNull& m_UploadQueue;
+
+    std::vector<uint8_t> m_Data;
+
+    BufferType m_BufferType;
+    // The stride of the vertex buffer in bytes.
+    unsigned int m_uiStride;
+    // The number of elements in this buffer.
+    unsigned int m_uiCount;
+};
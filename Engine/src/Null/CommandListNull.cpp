@@ -0,0 +1,58 @@
+#include <EnginePCH.h>
+
+#include "CommandListNull.h"
+
+CommandListNull::CommandListNull( RenderCountersNull& deviceCounters )
+    : m_DeviceCounters( deviceCounters )
+    , m_DeviceThreadID( std::this_thread::get_id() )
+    , m_bIsRecorded( false )
+{}
+
+CommandListNull::~CommandListNull()
+{}
+
+void CommandListNull::OnBegin()
+{
+    if ( m_bIsRecorded )
+    {
+        ReportError( "The command list is recorded again before it was executed." );
+    }
+
+    // A command list starts from the default state.
+    m_Counters.Reset();
+    m_Counters.StateCache.Reset();
+    m_Counters.StateCache.GetStatistics().Reset();
+
+    RenderCountersNull::SetRecording( &m_Counters );
+}
+
+void CommandListNull::OnEnd()
+{
+    RenderCountersNull::SetRecording( nullptr );
+    m_bIsRecorded = true;
+}
+
+void CommandListNull::Execute()
+{
+    if ( std::this_thread::get_id() != m_DeviceThreadID )
+    {
+        ReportError( "Command lists must be executed on the thread that owns the render device." );
+    }
+    if ( IsRecording() )
+    {
+        ReportError( "The command list is executed while it is still recording." );
+    }
+    if ( !m_bIsRecorded )
+    {
+        ReportError( "The command list is executed before it was recorded." );
+    }
+
+    ++m_Counters.CommandLists;
+    m_DeviceCounters.Add( m_Counters );
+
+    // Like the immediate context of a DirectX 11 device, the state of
+    // the device is cleared after a command list is executed.
+    m_DeviceCounters.StateCache.Reset();
+
+    m_bIsRecorded = false;
+}
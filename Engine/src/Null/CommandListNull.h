@@ -0,0 +1,37 @@
+#pragma once
+
+#include <CommandList.h>
+
+#include "RenderCountersNull.h"
+
+/**
+ * A command list of the null render device.
+ * The calls that are recorded into the command list are counted separately
+ * and added to the counters of the device when the command list is executed,
+ * so recording on multiple threads can be measured without a GPU.
+ * The command list checks that it is used the same way a DirectX 11 command list
+ * must be used: it is recorded once before each execution and it is only
+ * executed on the thread that created it (the thread that owns the device).
+ */
+class CommandListNull : public CommandList
+{
+public:
+    typedef CommandList base;
+
+    CommandListNull( RenderCountersNull& deviceCounters );
+    virtual ~CommandListNull();
+
+    virtual void Execute();
+
+protected:
+    virtual void OnBegin();
+    virtual void OnEnd();
+
+private:
+    RenderCountersNull& m_DeviceCounters;
+    // The calls that were recorded since the command list was last executed.
+    RenderCountersNull m_Counters;
+
+    std::thread::id m_DeviceThreadID;
+    bool m_bIsRecorded;
+};
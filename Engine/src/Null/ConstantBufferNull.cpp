@@ -0,0 +1,59 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "ConstantBufferNull.h"
+
+ConstantBufferNull::ConstantBufferNull( RenderCountersNull& counters, size_t size )
+    : m_Counters( counters )
+    , m_Data( size, 0 )
+{}
+
+ConstantBufferNull::~ConstantBufferNull()
+{}
+
+void ConstantBufferNull::Set( const void* data, size_t size )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    assert( size == m_Data.size() );
+
+    memcpy( m_Data.data(), data, m_Data.size() );
+
+    ++counters.BufferUpdates;
+    counters.BytesUploaded += m_Data.size();
+}
+
+void ConstantBufferNull::Copy( std::shared_ptr<ConstantBuffer> other )
+{
+    std::shared_ptr<ConstantBufferNull> srcBuffer = std::dynamic_pointer_cast<ConstantBufferNull>( other );
+
+    if ( srcBuffer && srcBuffer.get() != this &&
+         m_Data.size() == srcBuffer->m_Data.size() )
+    {
+        m_Data = srcBuffer->m_Data;
+        ++RenderCountersNull::GetCurrent( m_Counters ).Copies;
+    }
+    else
+    {
+        ReportError( "Source buffer is not compatible with this buffer." );
+    }
+}
+
+void ConstantBufferNull::Copy( std::shared_ptr<Buffer> other )
+{
+    Copy( std::dynamic_pointer_cast<ConstantBuffer>( other ) );
+}
+
+bool ConstantBufferNull::Bind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    ++counters.ConstantBufferBinds;
+    counters.StateCache.SetConstantBuffer( shaderType, id, this );
+    return true;
+}
+
+void ConstantBufferNull::UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull::GetCurrent( m_Counters ).StateCache.SetConstantBuffer( shaderType, id, nullptr );
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <ConstantBuffer.h>
+
+struct RenderCountersNull;
+
+class ConstantBufferNull : public ConstantBuffer
+{
+public:
+    ConstantBufferNull( RenderCountersNull& counters, size_t size );
+    virtual ~ConstantBufferNull();
+
+    virtual bool Bind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType );
+    virtual void UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType );
+
+    virtual void Copy( std::shared_ptr<ConstantBuffer> other );
+
+protected:
+    virtual void Copy( std::shared_ptr<Buffer> other );
+    void Set( const void* data, size_t size );
+
+private:
+    RenderCountersNull& m_Counters;
+
+    std::vector<uint8_t> m_Data;
+};
@@ -0,0 +1,62 @@
+#include <EnginePCH.h>
+
+#include <Shader.h>
+
+#include "RenderCountersNull.h"
+#include "ShaderParameterNull.h"
+#include "ConstantBufferRingNull.h"
+
+// The number of frames the simulated GPU lags behind the CPU.
+#define GPU_FRAME_LATENCY 2
+
+ConstantBufferRingNull::ConstantBufferRingNull( RenderCountersNull& counters, uint32_t size )
+    : base( size )
+    , m_Counters( counters )
+    , m_Data( GetSize(), 0 )
+{
+    memset( m_FenceFrames, 0, sizeof( m_FenceFrames ) );
+}
+
+ConstantBufferRingNull::~ConstantBufferRingNull()
+{}
+
+void ConstantBufferRingNull::Write( uint32_t offset, const void* data, size_t size, bool discard )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    memcpy( m_Data.data() + offset, data, size );
+
+    ++counters.BufferUpdates;
+    counters.BytesUploaded += size;
+}
+
+bool ConstantBufferRingNull::Bind( const Allocation& allocation, const Shader& shader, const ShaderParameterID& id )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    ShaderParameterNull& parameter = static_cast<ShaderParameterNull&>( shader.GetShaderParameter( id ) );
+    if ( !parameter.IsValid() || !allocation.IsValid() )
+    {
+        return false;
+    }
+
+    ++counters.ConstantBufferBinds;
+    counters.StateCache.SetConstantBuffer( parameter.GetShaderType(), parameter.GetSlotID(), this, allocation.Offset );
+
+    return true;
+}
+
+void ConstantBufferRingNull::InsertFence( uint64_t fence )
+{
+    m_FenceFrames[fence % MaxFramesInFlight] = GetFrame();
+}
+
+bool ConstantBufferRingNull::IsFenceComplete( uint64_t fence )
+{
+    return m_FenceFrames[fence % MaxFramesInFlight] + GPU_FRAME_LATENCY <= GetFrame();
+}
+
+void ConstantBufferRingNull::WaitForFence( uint64_t fence )
+{
+    // The simulated GPU finishes the frame immediately.
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ConstantBufferRing.h>
+
+struct RenderCountersNull;
+
+/**
+ * The constant buffer ring of the null render device.
+ * The GPU is simulated to finish a frame a fixed number of frames after
+ * the frame has ended, so the number of times a ring buffer of a given
+ * size would be renamed can be measured without a GPU.
+ */
+class ConstantBufferRingNull : public ConstantBufferRing
+{
+public:
+    typedef ConstantBufferRing base;
+
+    ConstantBufferRingNull( RenderCountersNull& counters, uint32_t size );
+    virtual ~ConstantBufferRingNull();
+
+    virtual bool Bind( const Allocation& allocation, const Shader& shader, const ShaderParameterID& id );
+
+protected:
+    virtual void Write( uint32_t offset, const void* data, size_t size, bool discard );
+
+    virtual void InsertFence( uint64_t fence );
+    virtual bool IsFenceComplete( uint64_t fence );
+    virtual void WaitForFence( uint64_t fence );
+
+private:
+    RenderCountersNull& m_Counters;
+
+    // The frame in which each fence in flight was inserted.
+    uint64_t m_FenceFrames[MaxFramesInFlight];
+
+    // The contents of the ring buffer.
+    std::vector<uint8_t> m_Data;
+};
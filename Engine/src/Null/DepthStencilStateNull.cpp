@@ -0,0 +1,45 @@
+#include <EnginePCH.h>
+
+#include "DepthStencilStateNull.h"
+
+DepthStencilStateNull::DepthStencilStateNull()
+{}
+
+DepthStencilStateNull::DepthStencilStateNull( const DepthStencilStateNull& copy )
+    : m_DepthMode( copy.m_DepthMode )
+    , m_StencilMode( copy.m_StencilMode )
+{}
+
+DepthStencilStateNull::~DepthStencilStateNull()
+{}
+
+const DepthStencilStateNull& DepthStencilStateNull::operator=( const DepthStencilStateNull& other )
+{
+    if ( this != &other )
+    {
+        m_DepthMode = other.m_DepthMode;
+        m_StencilMode = other.m_StencilMode;
+    }
+
+    return *this;
+}
+
+void DepthStencilStateNull::SetDepthMode( const DepthMode& depthMode )
+{
+    m_DepthMode = depthMode;
+}
+
+const DepthStencilState::DepthMode& DepthStencilStateNull::GetDepthMode() const
+{
+    return m_DepthMode;
+}
+
+void DepthStencilStateNull::SetStencilMode( const StencilMode& stencilMode )
+{
+    m_StencilMode = stencilMode;
+}
+
+const DepthStencilState::StencilMode& DepthStencilStateNull::GetStencilMode() const
+{
+    return m_StencilMode;
+}
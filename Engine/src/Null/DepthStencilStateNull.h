@@ -0,0 +1,24 @@
+#pragma once
+
+#include <DepthStencilState.h>
+
+class DepthStencilStateNull : public DepthStencilState
+{
+public:
+    DepthStencilStateNull();
+    DepthStencilStateNull( const DepthStencilStateNull& copy );
+
+    virtual ~DepthStencilStateNull();
+
+    const DepthStencilStateNull& operator=( const DepthStencilStateNull& other );
+
+    virtual void SetDepthMode( const DepthMode& depthMode );
+    virtual const DepthMode& GetDepthMode() const;
+
+    virtual void SetStencilMode( const StencilMode& stencilMode );
+    virtual const StencilMode& GetStencilMode() const;
+
+private:
+    DepthMode m_DepthMode;
+    StencilMode m_StencilMode;
+};
@@ -0,0 +1,218 @@
+#include <EnginePCH.h>
+
+#include <Material.h>
+#include <Events.h>
+#include <Visitor.h>
+#include <PipelineState.h>
+
+#include "RenderCountersNull.h"
+#include "ConstantBufferNull.h"
+#include "ShaderNull.h"
+
+#include "MeshNull.h"
+
+static const ShaderParameterID gs_QuantizedMeshID( "QuantizedMesh" );
+
+// The layout must match the QuantizedMesh constant buffer in CommonInclude.hlsl.
+struct QuantizationParameters
+{
+    glm::vec3 BoundsMin;
+    float Padding0;
+    glm::vec3 BoundsSize;
+    float Padding1;
+};
+
+MeshNull::MeshNull( RenderCountersNull& counters )
+    : m_Counters( counters )
+    , m_pIndexBuffer( nullptr )
+    , m_pMaterial( nullptr )
+{}
+
+MeshNull::~MeshNull()
+{}
+
+void MeshNull::AddVertexBuffer( const BufferBinding& binding, std::shared_ptr<Buffer> buffer )
+{
+    m_VertexBuffers[binding] = buffer;
+}
+
+void MeshNull::SetIndexBuffer( std::shared_ptr<Buffer> buffer )
+{
+    m_pIndexBuffer = buffer;
+}
+
+void MeshNull::SetQuantizedVertexBuffer( std::shared_ptr<Buffer> buffer, const BoundingBox& quantizationBounds )
+{
+    m_pQuantizedVertexBuffer = buffer;
+
+    QuantizationParameters parameters = {};
+    parameters.BoundsMin = quantizationBounds.GetMin();
+    parameters.BoundsSize = quantizationBounds.GetMax() - quantizationBounds.GetMin();
+
+    if ( !m_pQuantizationParameters )
+    {
+        m_pQuantizationParameters = std::make_shared<ConstantBufferNull>( m_Counters, sizeof( QuantizationParameters ) );
+    }
+    m_pQuantizationParameters->Set( parameters );
+}
+
+void MeshNull::AddLod( uint32_t firstIndex, uint32_t numIndices, float error )
+{
+    Lod lod = { firstIndex, numIndices, error };
+    m_Lods.push_back( lod );
+}
+
+uint32_t MeshNull::GetNumLods() const
+{
+    return std::max<uint32_t>( static_cast<uint32_t>( m_Lods.size() ), 1 );
+}
+
+float MeshNull::GetLodError( uint32_t lod ) const
+{
+    return ( lod < m_Lods.size() ) ? m_Lods[lod].Error : 0.0f;
+}
+
+uint32_t MeshNull::GetNumTriangles( uint32_t lod ) const
+{
+    if ( lod < m_Lods.size() )
+    {
+        return m_Lods[lod].NumIndices / 3;
+    }
+    if ( m_pIndexBuffer )
+    {
+        return m_pIndexBuffer->GetElementCount() / 3;
+    }
+    if ( m_pQuantizedVertexBuffer )
+    {
+        return m_pQuantizedVertexBuffer->GetElementCount() / 3;
+    }
+    return m_VertexBuffers.empty() ? 0 : m_VertexBuffers.begin()->second->GetElementCount() / 3;
+}
+
+void MeshNull::SetMaterial( std::shared_ptr<Material> material )
+{
+    m_pMaterial = material;
+}
+
+std::shared_ptr<Material> MeshNull::GetMaterial() const
+{
+    return m_pMaterial;
+}
+
+void MeshNull::SetBoundingBox( const BoundingBox& boundingBox )
+{
+    m_BoundingBox = boundingBox;
+}
+
+const BoundingBox& MeshNull::GetBoundingBox() const
+{
+    return m_BoundingBox;
+}
+
+void MeshNull::SetOccluderGeometry( std::shared_ptr<const OccluderGeometry> occluderGeometry )
+{
+    m_pOccluderGeometry = occluderGeometry;
+}
+
+std::shared_ptr<const OccluderGeometry> MeshNull::GetOccluderGeometry() const
+{
+    return m_pOccluderGeometry;
+}
+
+void MeshNull::SetMeshletGeometry( std::shared_ptr<const MeshletGeometry> meshletGeometry )
+{
+    m_pMeshletGeometry = meshletGeometry;
+}
+
+std::shared_ptr<const MeshletGeometry> MeshNull::GetMeshletGeometry() const
+{
+    return m_pMeshletGeometry;
+}
+
+void MeshNull::Render( RenderEventArgs& renderArgs )
+{
+    BindBuffers( renderArgs );
+    BindMaterial( renderArgs );
+    Draw( renderArgs );
+}
+
+void MeshNull::BindBuffers( RenderEventArgs& renderArgs )
+{
+    PipelineState* pipeline = renderArgs.PipelineState;
+    if ( pipeline )
+    {
+        std::shared_ptr<ShaderNull> pVS = std::dynamic_pointer_cast<ShaderNull>( pipeline->GetShader( Shader::VertexShader ) );
+
+        if ( pVS && pVS->HasInterleavedVertices() )
+        {
+            if ( m_pQuantizedVertexBuffer )
+            {
+                m_pQuantizedVertexBuffer->Bind( 0, Shader::VertexShader, ShaderParameter::Type::Buffer );
+
+                ShaderParameter& quantizationParameter = pVS->GetShaderParameter( gs_QuantizedMeshID );
+                quantizationParameter.BindResource<ConstantBuffer>( m_pQuantizationParameters );
+            }
+        }
+        else if ( pVS )
+        {
+            // Without an input signature, the vertex buffers are bound to consecutive slots.
+            unsigned int slotID = 0;
+            for ( BufferMap::value_type buffer : m_VertexBuffers )
+            {
+                buffer.second->Bind( slotID++, Shader::VertexShader, ShaderParameter::Type::Buffer );
+            }
+        }
+    }
+
+    if ( m_pIndexBuffer != NULL )
+    {
+        m_pIndexBuffer->Bind( 0, Shader::VertexShader, ShaderParameter::Type::Buffer );
+    }
+}
+
+void MeshNull::BindMaterial( RenderEventArgs& renderArgs )
+{
+    PipelineState* pipeline = renderArgs.PipelineState;
+    if ( pipeline && m_pMaterial )
+    {
+        for ( auto shader : pipeline->GetShaders() )
+        {
+            m_pMaterial->Bind( shader.second );
+        }
+    }
+}
+
+void MeshNull::Draw( RenderEventArgs& renderArgs, uint32_t instanceCount, uint32_t lod )
+{
+    if ( m_pIndexBuffer != NULL )
+    {
+        // Without levels of detail, the whole index buffer is drawn.
+        uint32_t indexCount = m_pIndexBuffer->GetElementCount();
+        if ( !m_Lods.empty() )
+        {
+            indexCount = m_Lods[std::min<size_t>( lod, m_Lods.size() - 1 )].NumIndices;
+        }
+
+        CountDraw( indexCount, instanceCount );
+    }
+    else if ( m_pQuantizedVertexBuffer || !m_VertexBuffers.empty() )
+    {
+        uint32_t vertexCount = m_pQuantizedVertexBuffer ? m_pQuantizedVertexBuffer->GetElementCount() : ( *m_VertexBuffers.begin() ).second->GetElementCount();
+        CountDraw( vertexCount, instanceCount );
+    }
+}
+
+void MeshNull::DrawIndexRange( RenderEventArgs& renderArgs, uint32_t firstIndex, uint32_t numIndices )
+{
+    CountDraw( numIndices, 1 );
+}
+
+void MeshNull::CountDraw( uint32_t numIndices, uint32_t instanceCount )
+{
+    RenderCountersNull::GetCurrent( m_Counters ).CountDraw( this, numIndices, instanceCount );
+}
+
+void MeshNull::Accept( Visitor& visitor )
+{
+    visitor.Visit( *this );
+}
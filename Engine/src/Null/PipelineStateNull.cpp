@@ -0,0 +1,117 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "PipelineStateNull.h"
+
+PipelineStateNull::PipelineStateNull( RenderCountersNull& counters )
+    : m_Counters( counters )
+{}
+
+PipelineStateNull::~PipelineStateNull()
+{
+
+}
+
+void PipelineStateNull::SetShader( Shader::ShaderType type, std::shared_ptr<Shader> pShader )
+{
+    m_Shaders[type] = pShader;
+}
+
+std::shared_ptr<Shader> PipelineStateNull::GetShader( Shader::ShaderType type ) const
+{
+    ShaderMap::const_iterator iter = m_Shaders.find( type );
+    if ( iter != m_Shaders.end() )
+    {
+        return iter->second;
+    }
+
+    return nullptr;
+}
+
+const PipelineState::ShaderMap& PipelineStateNull::GetShaders() const
+{
+    return m_Shaders;
+}
+
+void PipelineStateNull::SetBlendState( const BlendState& blendState )
+{
+    m_BlendState = dynamic_cast<const BlendStateNull&>( blendState );
+}
+
+BlendState& PipelineStateNull::GetBlendState()
+{
+    return m_BlendState;
+}
+
+void PipelineStateNull::SetRasterizerState( const RasterizerState& rasterizerState )
+{
+    m_RasterizerState = dynamic_cast<const RasterizerStateNull&>( rasterizerState );
+}
+
+RasterizerState& PipelineStateNull::GetRasterizerState() 
+{
+    return m_RasterizerState;
+}
+
+void PipelineStateNull::SetDepthStencilState( const DepthStencilState& depthStencilState )
+{
+    m_DepthStencilState = dynamic_cast<const DepthStencilStateNull&>( depthStencilState );
+}
+
+DepthStencilState& PipelineStateNull::GetDepthStencilState()
+{
+    return m_DepthStencilState;
+}
+
+void PipelineStateNull::SetRenderTarget( std::shared_ptr<RenderTarget> renderTarget )
+{
+    m_RenderTarget = renderTarget;
+}
+
+std::shared_ptr<RenderTarget> PipelineStateNull::GetRenderTarget() const
+{
+    return m_RenderTarget;
+}
+
+void PipelineStateNull::Bind()
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    if ( m_RenderTarget )
+    {
+        m_RenderTarget->Bind();
+    }
+
+    ++counters.PipelineBinds;
+
+    // The state objects are identified by their address.
+    counters.StateCache.SetBlendState( &m_BlendState );
+    counters.StateCache.SetRasterizerState( &m_RasterizerState );
+    counters.StateCache.SetDepthStencilState( &m_DepthStencilState );
+
+    for ( auto shader : m_Shaders )
+    {
+        std::shared_ptr<Shader> pShader = shader.second;
+        if ( pShader )
+        {
+            pShader->Bind();
+        }
+    }
+}
+
+void PipelineStateNull::UnBind()
+{
+    if ( m_RenderTarget )
+    {
+        m_RenderTarget->UnBind();
+    }
+
+    for ( auto shader : m_Shaders )
+    {
+        std::shared_ptr<Shader> pShader = shader.second;
+        if ( pShader )
+        {
+            pShader->UnBind();
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <PipelineState.h>
+
+#include "BlendStateNull.h"
+#include "RasterizerStateNull.h"
+#include "DepthStencilStateNull.h"
+
+struct RenderCountersNull;
+
+class PipelineStateNull : public PipelineState
+{
+public:
+    PipelineStateNull( RenderCountersNull& counters );
+    virtual ~PipelineStateNull();
+
+    virtual void SetShader( Shader::ShaderType type, std::shared_ptr<Shader> pShader );
+    virtual std::shared_ptr<Shader> GetShader( Shader::ShaderType type ) const;
+    virtual const ShaderMap& GetShaders() const;
+
+    virtual void SetBlendState( const BlendState& blendState );
+    virtual BlendState& GetBlendState();
+
+    virtual void SetRasterizerState( const RasterizerState& rasterizerState );
+    virtual RasterizerState& GetRasterizerState();
+
+    virtual void SetDepthStencilState( const DepthStencilState& depthStencilState );
+    virtual DepthStencilState& GetDepthStencilState();
+
+    virtual void SetRenderTarget( std::shared_ptr<RenderTarget> renderTarget );
+    virtual std::shared_ptr<RenderTarget> GetRenderTarget() const;
+
+    virtual void Bind();
+    virtual void UnBind();
+protected:
+
+private:
+    RenderCountersNull& m_Counters;
+
+    ShaderMap m_Shaders;
+
+    BlendStateNull m_BlendState;
+    RasterizerStateNull m_RasterizerState;
+    DepthStencilStateNull m_DepthStencilState;
+    std::shared_ptr<RenderTarget> m_RenderTarget;
+};
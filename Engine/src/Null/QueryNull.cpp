@@ -0,0 +1,72 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "QueryNull.h"
+
+QueryNull::QueryNull( RenderCountersNull& counters, QueryType queryType, uint8_t numBuffers )
+    : m_Counters( counters )
+    , m_QueryType( queryType )
+    , m_NumBuffers( glm::max<uint8_t>( numBuffers, 1 ) )
+{
+    m_ElapsedTime.resize( m_NumBuffers, 0.0 );
+}
+
+QueryNull::~QueryNull()
+{}
+
+void QueryNull::Begin( int64_t frame )
+{
+    int buffer = frame % m_NumBuffers;
+    m_ElapsedTime[buffer] = 0.0;
+    m_Timer.Tick();
+
+    ++RenderCountersNull::GetCurrent( m_Counters ).Queries;
+}
+
+void QueryNull::End( int64_t frame )
+{
+    int buffer = frame % m_NumBuffers;
+    m_Timer.Tick();
+    m_ElapsedTime[buffer] = m_Timer.ElapsedSeconds();
+}
+
+bool QueryNull::QueryResultAvailable( int64_t frame )
+{
+    return true;
+}
+
+Query::QueryResult QueryNull::GetQueryResult( int64_t frame )
+{
+    QueryResult result = {};
+    int buffer = ( frame - 1L ) % m_NumBuffers;
+
+    if ( buffer >= 0 )
+    {
+        switch ( m_QueryType )
+        {
+        case QueryType::Timer:
+            result.ElapsedTime = m_ElapsedTime[buffer];
+            break;
+        case QueryType::CountSamples:
+            result.NumSamples = 0;
+            break;
+        case QueryType::CountSamplesPredicate:
+            result.AnySamples = false;
+            break;
+        case QueryType::CountPrimitives:
+            result.PrimitivesGenerated = 0;
+            break;
+        case QueryType::CountTransformFeedbackPrimitives:
+            result.TransformFeedbackPrimitives = 0;
+            break;
+        }
+        result.IsValid = true;
+    }
+
+    return result;
+}
+
+uint8_t QueryNull::GetBufferCount() const
+{
+    return m_NumBuffers;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Query.h>
+#include <HighResolutionTimer.h>
+
+struct RenderCountersNull;
+
+// Without a GPU, timer queries measure the time the CPU spends between Begin and End.
+// All other query types return valid (zero) results.
+class QueryNull : public Query
+{
+public:
+
+    QueryNull( RenderCountersNull& counters, QueryType queryType, uint8_t numBuffers );
+    virtual ~QueryNull();
+
+    virtual void Begin( int64_t frame = 0L );
+    virtual void End( int64_t frame = 0L );
+    virtual bool QueryResultAvailable( int64_t frame = 0L );
+    virtual QueryResult GetQueryResult( int64_t frame = 0L );
+    virtual uint8_t GetBufferCount() const;
+
+private:
+    RenderCountersNull& m_Counters;
+
+    HighResolutionTimer m_Timer;
+    // The elapsed time (in seconds) of each buffered query.
+    std::vector<double> m_ElapsedTime;
+
+    QueryType m_QueryType;
+    uint8_t m_NumBuffers;
+};
@@ -0,0 +1,212 @@
+#include <EnginePCH.h>
+
+#include "RasterizerStateNull.h"
+
+RasterizerStateNull::RasterizerStateNull()
+    : m_FrontFaceFillMode( FillMode::Solid )
+    , m_BackFaceFillMode( FillMode::Solid )
+    , m_CullMode( CullMode::Back )
+    , m_FrontFace( FrontFace::CounterClockwise )
+    , m_DepthBias( 0.0f )
+    , m_SlopeBias( 0.0f )
+    , m_BiasClamp( 0.0f )
+    , m_DepthClipEnabled( true )
+    , m_ScissorEnabled( false )
+    , m_MultisampleEnabled( false )
+    , m_AntialiasedLineEnabled( false )
+    , m_ConservativeRasterization( false )
+    , m_ForcedSampleCount( 0 )
+{
+    m_Viewports.resize( 8, Viewport() );
+    m_ScissorRects.resize( 8, Rect() );
+}
+
+RasterizerStateNull::RasterizerStateNull( const RasterizerStateNull& copy )
+    : m_FrontFaceFillMode( copy.m_FrontFaceFillMode )
+    , m_BackFaceFillMode( copy.m_BackFaceFillMode )
+    , m_CullMode( copy.m_CullMode )
+    , m_FrontFace( copy.m_FrontFace )
+    , m_DepthBias( copy.m_DepthBias )
+    , m_SlopeBias( copy.m_SlopeBias )
+    , m_BiasClamp( copy.m_BiasClamp )
+    , m_DepthClipEnabled( copy.m_DepthClipEnabled )
+    , m_ScissorEnabled( copy.m_ScissorEnabled )
+    , m_MultisampleEnabled( copy.m_MultisampleEnabled )
+    , m_AntialiasedLineEnabled( copy.m_AntialiasedLineEnabled )
+    , m_ConservativeRasterization( copy.m_ConservativeRasterization )
+    , m_ForcedSampleCount( copy.m_ForcedSampleCount )
+    , m_ScissorRects( copy.m_ScissorRects )
+    , m_Viewports( copy.m_Viewports )
+{}
+
+RasterizerStateNull::~RasterizerStateNull()
+{}
+
+const RasterizerStateNull& RasterizerStateNull::operator=( const RasterizerStateNull& other )
+{
+    // avoid copy to self.
+    if ( this != &other )
+    {
+        m_FrontFaceFillMode = other.m_FrontFaceFillMode;
+        m_BackFaceFillMode = other.m_BackFaceFillMode;
+
+        m_CullMode = other.m_CullMode;
+
+        m_FrontFace = other.m_FrontFace;
+
+        m_DepthBias = other.m_DepthBias;
+        m_SlopeBias = other.m_SlopeBias;
+        m_BiasClamp = other.m_BiasClamp;
+
+        m_DepthClipEnabled = other.m_DepthClipEnabled;
+        m_ScissorEnabled = other.m_ScissorEnabled;
+
+        m_MultisampleEnabled = other.m_MultisampleEnabled;
+        m_AntialiasedLineEnabled = other.m_AntialiasedLineEnabled;
+
+        m_ConservativeRasterization = other.m_ConservativeRasterization;
+
+        m_ForcedSampleCount = other.m_ForcedSampleCount;
+
+        m_ScissorRects = other.m_ScissorRects;
+        m_Viewports = other.m_Viewports;
+    }
+
+    return *this;
+}
+
+void RasterizerStateNull::SetFillMode( FillMode frontFace, FillMode backFace )
+{
+    m_FrontFaceFillMode = frontFace;
+    m_BackFaceFillMode = backFace;
+}
+
+void RasterizerStateNull::GetFillMode( FillMode& frontFace, FillMode& backFace ) const
+{
+    frontFace = m_FrontFaceFillMode;
+    backFace = m_BackFaceFillMode;
+}
+
+void RasterizerStateNull::SetCullMode( CullMode cullMode )
+{
+    m_CullMode = cullMode;
+}
+
+RasterizerState::CullMode RasterizerStateNull::GetCullMode() const
+{
+    return m_CullMode;
+}
+
+void RasterizerStateNull::SetFrontFacing( FrontFace frontFace )
+{
+    m_FrontFace = frontFace;
+}
+
+RasterizerState::FrontFace RasterizerStateNull::GetFrontFacing() const
+{
+    return m_FrontFace;
+}
+
+void RasterizerStateNull::SetDepthBias( float depthBias, float slopeBias, float biasClamp )
+{
+    m_DepthBias = depthBias;
+    m_SlopeBias = slopeBias;
+    m_BiasClamp = biasClamp;
+}
+
+void RasterizerStateNull::GetDepthBias( float& depthBias, float& slopeBias, float& biasClamp ) const
+{
+    depthBias = m_DepthBias;
+    slopeBias = m_SlopeBias;
+    biasClamp = m_BiasClamp;
+}
+
+void RasterizerStateNull::SetDepthClipEnabled( bool depthClipEnabled )
+{
+    m_DepthClipEnabled = depthClipEnabled;
+}
+
+bool RasterizerStateNull::GetDepthClipEnabled() const
+{
+    return m_DepthClipEnabled;
+}
+
+void RasterizerStateNull::SetViewport( const Viewport& viewport )
+{
+    m_Viewports[0] = viewport;
+}
+
+void RasterizerStateNull::SetViewports( const std::vector<Viewport>& viewports )
+{
+    m_Viewports = viewports;
+}
+
+const std::vector<Viewport>& RasterizerStateNull::GetViewports()
+{
+    return m_Viewports;
+}
+
+void RasterizerStateNull::SetScissorEnabled( bool scissorEnable )
+{
+    m_ScissorEnabled = scissorEnable;
+}
+
+bool RasterizerStateNull::GetScissorEnabled() const
+{
+    return m_ScissorEnabled;
+}
+
+void RasterizerStateNull::SetScissorRect( const Rect& rect )
+{
+    m_ScissorRects[0] = rect;
+}
+
+void RasterizerStateNull::SetScissorRects( const std::vector<Rect>& rects )
+{
+    m_ScissorRects = rects;
+}
+
+const std::vector<Rect>& RasterizerStateNull::GetScissorRects() const
+{
+    return m_ScissorRects;
+}
+
+void RasterizerStateNull::SetMultisampleEnabled( bool multisampleEnabled )
+{
+    m_MultisampleEnabled = multisampleEnabled;
+}
+
+bool RasterizerStateNull::GetMultisampleEnabled() const
+{
+    return m_MultisampleEnabled;
+}
+
+void RasterizerStateNull::SetAntialiasedLineEnable( bool antialiasedLineEnabled )
+{
+    m_AntialiasedLineEnabled = antialiasedLineEnabled;
+}
+
+bool RasterizerStateNull::GetAntialiasedLineEnable() const
+{
+    return m_AntialiasedLineEnabled;
+}
+
+void RasterizerStateNull::SetForcedSampleCount( uint8_t sampleCount )
+{
+    m_ForcedSampleCount = sampleCount;
+}
+
+uint8_t RasterizerStateNull::GetForcedSampleCount()
+{
+    return m_ForcedSampleCount;
+}
+
+void RasterizerStateNull::SetConservativeRasterizationEnabled( bool conservativeRasterizationEnabled )
+{
+    m_ConservativeRasterization = conservativeRasterizationEnabled;
+}
+
+bool RasterizerStateNull::GetConservativeRasterizationEnabled() const
+{
+    return m_ConservativeRasterization;
+}
@@ -0,0 +1,137 @@
+#include <EnginePCH.h>
+
+#include <ContentHash.h>
+
+#include "RenderCountersNull.h"
+
+// The multiplier of the draw order hash (an odd 64-bit prime).
+static const uint64_t DrawOrderPrime = 0x100000001B3ull;
+
+// The counters of the command list that is recording on this thread.
+static thread_local RenderCountersNull* gs_pRecordingCounters = nullptr;
+
+RenderCountersNull::RenderCountersNull()
+{
+    Reset();
+}
+
+void RenderCountersNull::Reset()
+{
+    Frames = 0;
+    DrawCalls = 0;
+    DrawOrderHash = 0;
+    Triangles = 0;
+    Dispatches = 0;
+    PipelineBinds = 0;
+    RenderTargetBinds = 0;
+    ShaderBinds = 0;
+    VertexBufferBinds = 0;
+    ConstantBufferBinds = 0;
+    StructuredBufferBinds = 0;
+    TextureBinds = 0;
+    SamplerBinds = 0;
+    BufferUpdates = 0;
+    BytesUploaded = 0;
+    StagingCopies = 0;
+    StagingStalls = 0;
+    ResourceTransitions = 0;
+    TransitionBatches = 0;
+    Clears = 0;
+    Copies = 0;
+    Queries = 0;
+    CommandLists = 0;
+}
+
+void RenderCountersNull::Report() const
+{
+    // Resources that are created before the first frame are counted in the first frame.
+    double frames = (double)std::max<uint64_t>( Frames, 1 );
+
+    std::stringstream ss;
+    ss << "Null render device: " << Frames << " frames" << std::endl;
+    ss << "Per frame: " << DrawCalls / frames << " draw calls, " << Triangles / frames << " triangles, " << Dispatches / frames << " dispatches" << std::endl;
+    ss << "Binds per frame: " << PipelineBinds / frames << " pipelines, " << RenderTargetBinds / frames << " render targets, "
+        << ShaderBinds / frames << " shaders, " << VertexBufferBinds / frames << " vertex/index buffers, "
+        << ConstantBufferBinds / frames << " constant buffers, " << StructuredBufferBinds / frames << " structured buffers, "
+        << TextureBinds / frames << " textures, " << SamplerBinds / frames << " samplers" << std::endl;
+    ss << "Updates per frame: " << BufferUpdates / frames << " buffers (" << BytesUploaded / frames / 1024.0 << " KB), "
+        << Clears / frames << " clears, " << Copies / frames << " copies, " << Queries / frames << " queries" << std::endl;
+    ss << "Staging per frame: " << StagingCopies / frames << " copies, " << StagingStalls / frames << " stalls" << std::endl;
+    ss << "Resource transitions per frame: " << ResourceTransitions / frames << " (in " << TransitionBatches / frames << " batches)" << std::endl;
+    if ( CommandLists > 0 )
+    {
+        ss << "Command lists per frame: " << CommandLists / frames << std::endl;
+    }
+    // Rendering the same frames with and without command lists must give the same hash.
+    ss << "Draw order hash: " << std::hex << DrawOrderHash << std::dec << std::endl;
+    OutputDebugStringA( ss.str().c_str() );
+
+    StateCache.GetTotalStatistics().Report( "Null render device" );
+}
+
+void RenderCountersNull::Add( const RenderCountersNull& other )
+{
+    // The draw order hash is a polynomial of the hashes of the draw calls,
+    // so appending the draw calls of the other counters multiplies this hash
+    // by DrawOrderPrime to the power of the number of appended draw calls.
+    uint64_t scale = 1;
+    uint64_t base = DrawOrderPrime;
+    for ( uint64_t exponent = other.DrawCalls; exponent > 0; exponent >>= 1 )
+    {
+        if ( exponent & 1 )
+        {
+            scale *= base;
+        }
+        base *= base;
+    }
+    DrawOrderHash = DrawOrderHash * scale + other.DrawOrderHash;
+
+    DrawCalls += other.DrawCalls;
+    Triangles += other.Triangles;
+    Dispatches += other.Dispatches;
+    PipelineBinds += other.PipelineBinds;
+    RenderTargetBinds += other.RenderTargetBinds;
+    ShaderBinds += other.ShaderBinds;
+    VertexBufferBinds += other.VertexBufferBinds;
+    ConstantBufferBinds += other.ConstantBufferBinds;
+    StructuredBufferBinds += other.StructuredBufferBinds;
+    TextureBinds += other.TextureBinds;
+    SamplerBinds += other.SamplerBinds;
+    BufferUpdates += other.BufferUpdates;
+    BytesUploaded += other.BytesUploaded;
+    StagingCopies += other.StagingCopies;
+    StagingStalls += other.StagingStalls;
+    ResourceTransitions += other.ResourceTransitions;
+    TransitionBatches += other.TransitionBatches;
+    Clears += other.Clears;
+    Copies += other.Copies;
+    Queries += other.Queries;
+    CommandLists += other.CommandLists;
+
+    StateCache.GetStatistics().Add( other.StateCache.GetStatistics() );
+}
+
+void RenderCountersNull::CountDraw( const void* pMesh, uint32_t numIndices, uint32_t instanceCount )
+{
+    struct DrawCall
+    {
+        const void* Mesh;
+        uint32_t NumIndices;
+        uint32_t InstanceCount;
+    } drawCall = { pMesh, numIndices, instanceCount };
+
+    DrawOrderHash = DrawOrderHash * DrawOrderPrime + ContentHash::Hash( &drawCall, sizeof( drawCall ) );
+
+    ++DrawCalls;
+    Triangles += (uint64_t)( numIndices / 3 ) * std::max<uint32_t>( instanceCount, 1 );
+}
+
+RenderCountersNull& RenderCountersNull::GetCurrent( RenderCountersNull& deviceCounters )
+{
+    return gs_pRecordingCounters ? *gs_pRecordingCounters : deviceCounters;
+}
+
+void RenderCountersNull::SetRecording( RenderCountersNull* pCounters )
+{
+    gs_pRecordingCounters = pCounters;
+}
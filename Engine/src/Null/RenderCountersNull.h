@@ -0,0 +1,79 @@
+#pragma once
+
+#include "StateCacheNull.h"
+
+/**
+ * The calls that were made to the resources of the null render device.
+ * A real render device would submit each of these calls to the GPU,
+ * so the counters show how much work the renderer submits per frame
+ * without having to run on a machine with a GPU.
+ * Each command list counts the calls that are recorded into it and adds
+ * its counters to the counters of the device when it is executed.
+ */
+struct RenderCountersNull
+{
+    RenderCountersNull();
+
+    // Set all counters to 0.
+    void Reset();
+
+    // Log the counters averaged over the number of presented frames.
+    void Report() const;
+
+    // Add the counters of a command list (the number of frames is not added).
+    void Add( const RenderCountersNull& other );
+
+    // Count a draw call and add it to the draw order hash.
+    void CountDraw( const void* pMesh, uint32_t numIndices, uint32_t instanceCount );
+
+    // The counters of the command list that is recording on the calling thread
+    // or deviceCounters if no command list is recording on the calling thread.
+    static RenderCountersNull& GetCurrent( RenderCountersNull& deviceCounters );
+    // Count the calls of the calling thread with the counters of a command list (nullptr to stop recording).
+    static void SetRecording( RenderCountersNull* pCounters );
+
+    // The number of times a render window was presented.
+    uint64_t Frames;
+
+    uint64_t DrawCalls;
+    // A hash of the sequence of draw calls. Recording draw calls into command lists
+    // on multiple threads and executing the command lists in order produces the same
+    // hash as issuing the same draw calls in the same order on a single thread.
+    uint64_t DrawOrderHash;
+    // The number of triangles of all draw calls (instances are counted separately).
+    uint64_t Triangles;
+    uint64_t Dispatches;
+
+    uint64_t PipelineBinds;
+    uint64_t RenderTargetBinds;
+    uint64_t ShaderBinds;
+    // Vertex and index buffers.
+    uint64_t VertexBufferBinds;
+    uint64_t ConstantBufferBinds;
+    uint64_t StructuredBufferBinds;
+    uint64_t TextureBinds;
+    uint64_t SamplerBinds;
+
+    // Updates of the contents of buffers and the number of bytes that were copied.
+    uint64_t BufferUpdates;
+    uint64_t BytesUploaded;
+    // The copies from the staging ring to the buffers and textures that were updated
+    // (updates of consecutive ranges of a resource are copied at once).
+    uint64_t StagingCopies;
+    // The number of times the staging ring was full and the CPU had to wait for the GPU.
+    uint64_t StagingStalls;
+
+    // The transitions (including UAV barriers) between the states of the resources that are
+    // accessed by the passes and the number of batches they were issued in.
+    uint64_t ResourceTransitions;
+    uint64_t TransitionBatches;
+
+    uint64_t Clears;
+    uint64_t Copies;
+    uint64_t Queries;
+    // The number of command lists that were executed.
+    uint64_t CommandLists;
+
+    // The bindings above that a real device would issue or skip.
+    StateCacheNull StateCache;
+};
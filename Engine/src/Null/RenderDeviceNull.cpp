@@ -0,0 +1,480 @@
+#include <EnginePCH.h>
+
+#include <Material.h>
+
+#include "BufferNull.h"
+#include "ConstantBufferNull.h"
+#include "StructuredBufferNull.h"
+#include "RenderTargetNull.h"
+#include "MeshNull.h"
+#if !defined(ENGINE_NO_IMPORTERS)
+#include "SceneNull.h"
+#endif
+#include "ShaderNull.h"
+#include "TextureNull.h"
+#include "SamplerStateNull.h"
+#include "PipelineStateNull.h"
+#include "QueryNull.h"
+#include "CommandListNull.h"
+#include "ConstantBufferRingNull.h"
+#include "UploadQueueNull.h"
+
+#include "RenderDeviceNull.h"
+
+// The size of the constant buffer ring in bytes (the same size as the DirectX 11 device).
+#define CONSTANT_BUFFER_RING_SIZE ( 16 * 1024 * 1024 )
+// The size of the staging memory that the updates of buffers and textures are uploaded from in bytes.
+#define STAGING_RING_SIZE ( 16 * 1024 * 1024 )
+
+RenderDeviceNull::RenderDeviceNull()
+    : m_DeviceName( "Null Device" )
+{
+    m_pConstantBufferRing.reset( new ConstantBufferRingNull( m_Counters, CONSTANT_BUFFER_RING_SIZE ) );
+    m_pUploadQueue.reset( new UploadQueueNull( m_Counters, STAGING_RING_SIZE ) );
+
+    // Nothing is loaded from disk so the default resources don't have to wait for the application to be initialized.
+    LoadDefaultResources();
+}
+
+RenderDeviceNull::~RenderDeviceNull()
+{
+    m_Counters.Report();
+    m_pConstantBufferRing->Report( m_DeviceName );
+
+    m_Materials.Clear();
+    m_Scenes.Clear();
+    m_Meshes.Clear();
+    m_Buffers.Clear();
+    m_Shaders.Clear();
+    m_Textures.Clear();
+    m_Samplers.Clear();
+    m_Pipelines.Clear();
+    m_Queries.Clear();
+    m_CommandLists.Clear();
+    m_StateTracker.Clear();
+}
+
+const std::string& RenderDeviceNull::GetDeviceName() const
+{
+    return m_DeviceName;
+}
+
+RenderCountersNull& RenderDeviceNull::GetCounters()
+{
+    return m_Counters;
+}
+
+const RenderCountersNull& RenderDeviceNull::GetCounters() const
+{
+    return m_Counters;
+}
+
+ConstantBufferRing* RenderDeviceNull::GetConstantBufferRing()
+{
+    return m_pConstantBufferRing.get();
+}
+
+UploadQueueNull& RenderDeviceNull::GetUploadQueue()
+{
+    return *m_pUploadQueue;
+}
+
+void RenderDeviceNull::EndFrame()
+{
+    ++m_Counters.Frames;
+
+    // The DirectX 11 state cache is reset after every frame.
+    m_Counters.StateCache.Reset();
+    m_Counters.StateCache.EndFrame();
+
+    m_pConstantBufferRing->EndFrame();
+    m_pUploadQueue->EndFrame();
+}
+
+ResourceStateTracker* RenderDeviceNull::GetResourceStateTracker()
+{
+    return &m_StateTracker;
+}
+
+const StateCacheStatistics* RenderDeviceNull::GetStateCacheStatistics() const
+{
+    return &m_Counters.StateCache.GetFrameStatistics();
+}
+
+void RenderDeviceNull::FlushResourceTransitions()
+{
+    const ResourceStateTracker::TransitionList& transitions = m_StateTracker.Flush();
+    if ( !transitions.empty() )
+    {
+        m_Counters.ResourceTransitions += transitions.size();
+        ++m_Counters.TransitionBatches;
+    }
+}
+
+std::shared_ptr<Buffer> RenderDeviceNull::CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride )
+{
+    std::shared_ptr<Buffer> buffer = std::make_shared<BufferNull>( m_Counters, *m_pUploadQueue, Buffer::VertexBuffer, data, count, stride );
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+std::shared_ptr<Buffer> RenderDeviceNull::CreateDoubleVertexBuffer( const double* data, unsigned int count, unsigned int stride )
+{
+    std::shared_ptr<Buffer> buffer = std::make_shared<BufferNull>( m_Counters, *m_pUploadQueue, Buffer::VertexBuffer, data, count, stride );
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+std::shared_ptr<Buffer> RenderDeviceNull::CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride )
+{
+    std::shared_ptr<Buffer> buffer = std::make_shared<BufferNull>( m_Counters, *m_pUploadQueue, Buffer::VertexBuffer, data, count, stride );
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+std::shared_ptr<Buffer> RenderDeviceNull::CreateUShortIndexBuffer( const unsigned short* data, unsigned int count )
+{
+    std::shared_ptr<Buffer> buffer = std::make_shared<BufferNull>( m_Counters, *m_pUploadQueue, Buffer::IndexBuffer, data, count, (unsigned int)sizeof( unsigned short ) );
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+std::shared_ptr<Buffer> RenderDeviceNull::CreateUIntIndexBuffer( const unsigned int* data, unsigned int count )
+{
+    std::shared_ptr<Buffer> buffer = std::make_shared<BufferNull>( m_Counters, *m_pUploadQueue, Buffer::IndexBuffer, data, count, (unsigned int)sizeof( unsigned int ) );
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+void RenderDeviceNull::DestroyBuffer( std::shared_ptr<Buffer> buffer )
+{
+    m_Buffers.Remove( buffer );
+    m_StateTracker.RemoveResource( buffer.get() );
+}
+
+void RenderDeviceNull::DestroyBuffer( ResourceHandle handle )
+{
+    std::shared_ptr<Buffer> buffer = m_Buffers.Get( handle );
+    if ( buffer )
+    {
+        DestroyBuffer( buffer );
+    }
+}
+
+ResourceHandle RenderDeviceNull::GetBufferHandle( std::shared_ptr<Buffer> buffer ) const
+{
+    return m_Buffers.GetHandle( buffer );
+}
+
+std::shared_ptr<Buffer> RenderDeviceNull::GetBuffer( ResourceHandle handle ) const
+{
+    return m_Buffers.Get( handle );
+}
+
+void RenderDeviceNull::DestroyVertexBuffer( std::shared_ptr<Buffer> buffer )
+{
+    DestroyBuffer( buffer );
+}
+
+void RenderDeviceNull::DestroyIndexBuffer( std::shared_ptr<Buffer> buffer )
+{
+    DestroyBuffer( buffer );
+}
+
+std::shared_ptr<ConstantBuffer> RenderDeviceNull::CreateConstantBuffer( const void* data, size_t size )
+{
+    std::shared_ptr<ConstantBuffer> buffer = std::make_shared<ConstantBufferNull>( m_Counters, size );
+
+    if ( data )
+    {
+        buffer->Set( data, size );
+    }
+
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+void RenderDeviceNull::DestroyConstantBuffer( std::shared_ptr<ConstantBuffer> buffer )
+{
+    DestroyBuffer( buffer );
+}
+
+std::shared_ptr<StructuredBuffer> RenderDeviceNull::CreateStructuredBuffer( void* data, unsigned int count, unsigned int stride, CPUAccess cpuAccess, bool gpuWrite )
+{
+    std::shared_ptr<StructuredBuffer> buffer = std::make_shared<StructuredBufferNull>( m_Counters, *m_pUploadQueue, data, count, stride );
+    m_Buffers.Add( buffer );
+
+    return buffer;
+}
+
+void RenderDeviceNull::DestroyStructuredBuffer( std::shared_ptr<StructuredBuffer> buffer )
+{
+    DestroyBuffer( buffer );
+}
+
+std::shared_ptr<Mesh> RenderDeviceNull::CreateMesh()
+{
+    std::shared_ptr<Mesh> mesh = std::make_shared<MeshNull>( m_Counters );
+    m_Meshes.Add( mesh );
+
+    return mesh;
+}
+
+void RenderDeviceNull::DestroyMesh( std::shared_ptr<Mesh> mesh )
+{
+    m_Meshes.Remove( mesh );
+}
+
+std::shared_ptr<Scene> RenderDeviceNull::CreateScene()
+{
+#if defined(ENGINE_NO_IMPORTERS)
+    ReportError( "Scenes can't be created without Assimp." );
+    return nullptr;
+#else
+    std::shared_ptr<Scene> scene = std::make_shared<SceneNull>( *this );
+    scene->LoadingProgress += boost::bind( &RenderDeviceNull::OnLoadingProgress, this, _1 );
+
+    m_Scenes.Add( scene );
+
+    return scene;
+#endif
+}
+
+void RenderDeviceNull::DestroyScene( std::shared_ptr<Scene> scene )
+{
+    m_Scenes.Remove( scene );
+}
+
+std::shared_ptr<Shader> RenderDeviceNull::CreateShader()
+{
+    std::shared_ptr<Shader> pShader = std::make_shared<ShaderNull>( m_Counters );
+    m_Shaders.Add( pShader );
+
+    return pShader;
+}
+
+void RenderDeviceNull::DestroyShader( std::shared_ptr<Shader> shader )
+{
+    m_Shaders.Remove( shader );
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::CreateTexture( const std::wstring& fileName )
+{
+    TextureMap::iterator iter = m_TexturesByName.find( fileName );
+    if ( iter != m_TexturesByName.end() )
+    {
+        return iter->second;
+    }
+
+    std::shared_ptr<Texture> texture = std::make_shared<TextureNull>( m_Counters, *m_pUploadQueue );
+    texture->LoadTexture2D( fileName );
+
+    m_Textures.Add( texture );
+    m_TexturesByName.insert( TextureMap::value_type( fileName, texture ) );
+    m_TextureNames.insert( TextureNameMap::value_type( texture.get(), fileName ) );
+
+    return texture;
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::CreateTextureCube( const std::wstring& fileName )
+{
+    TextureMap::iterator iter = m_TexturesByName.find( fileName );
+    if ( iter != m_TexturesByName.end() )
+    {
+        return iter->second;
+    }
+
+    std::shared_ptr<Texture> texture = std::make_shared<TextureNull>( m_Counters, *m_pUploadQueue );
+    texture->LoadTextureCube( fileName );
+
+    m_Textures.Add( texture );
+    m_TexturesByName.insert( TextureMap::value_type( fileName, texture ) );
+    m_TextureNames.insert( TextureNameMap::value_type( texture.get(), fileName ) );
+
+    return texture;
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::CreateTexture1D( uint16_t width, uint16_t slices, const Texture::TextureFormat& format, CPUAccess cpuAccess, bool gpuWrite )
+{
+    Texture::Dimension dimension = ( slices > 1 ) ? Texture::Dimension::Texture1DArray : Texture::Dimension::Texture1D;
+    std::shared_ptr<Texture> texture = std::make_shared<TextureNull>( m_Counters, *m_pUploadQueue, dimension, width, 1, slices, format, cpuAccess );
+    m_Textures.Add( texture );
+
+    return texture;
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::CreateTexture2D( uint16_t width, uint16_t height, uint16_t slices, const Texture::TextureFormat& format, CPUAccess cpuAccess, bool gpuWrite )
+{
+    Texture::Dimension dimension = ( slices > 1 ) ? Texture::Dimension::Texture2DArray : Texture::Dimension::Texture2D;
+    std::shared_ptr<Texture> texture = std::make_shared<TextureNull>( m_Counters, *m_pUploadQueue, dimension, width, height, slices, format, cpuAccess );
+    m_Textures.Add( texture );
+
+    return texture;
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::CreateTexture3D( uint16_t width, uint16_t height, uint16_t depth, const Texture::TextureFormat& format, CPUAccess cpuAccess, bool gpuWrite )
+{
+    std::shared_ptr<Texture> texture = std::make_shared<TextureNull>( m_Counters, *m_pUploadQueue, Texture::Dimension::Texture3D, width, height, depth, format, cpuAccess );
+    m_Textures.Add( texture );
+
+    return texture;
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::CreateTextureCube( uint16_t size, uint16_t numCubes, const Texture::TextureFormat& format, CPUAccess cpuAccess, bool gpuWrite )
+{
+    // Each cube has 6 faces.
+    std::shared_ptr<Texture> texture = std::make_shared<TextureNull>( m_Counters, *m_pUploadQueue, Texture::Dimension::TextureCube, size, size, numCubes * 6, format, cpuAccess );
+    m_Textures.Add( texture );
+
+    return texture;
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::CreateTexture()
+{
+    std::shared_ptr<Texture> texture = std::make_shared<TextureNull>( m_Counters, *m_pUploadQueue );
+    m_Textures.Add( texture );
+
+    return texture;
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::GetDefaultTexture() const
+{
+    return m_pDefaultTexture;
+}
+
+void RenderDeviceNull::DestroyTexture( std::shared_ptr<Texture> texture )
+{
+    m_Textures.Remove( texture );
+    m_StateTracker.RemoveResource( texture.get() );
+
+    TextureNameMap::iterator iter = m_TextureNames.find( texture.get() );
+    if ( iter != m_TextureNames.end() )
+    {
+        m_TexturesByName.erase( iter->second );
+        m_TextureNames.erase( iter );
+    }
+}
+
+void RenderDeviceNull::DestroyTexture( ResourceHandle handle )
+{
+    std::shared_ptr<Texture> texture = m_Textures.Get( handle );
+    if ( texture )
+    {
+        DestroyTexture( texture );
+    }
+}
+
+ResourceHandle RenderDeviceNull::GetTextureHandle( std::shared_ptr<Texture> texture ) const
+{
+    return m_Textures.GetHandle( texture );
+}
+
+std::shared_ptr<Texture> RenderDeviceNull::GetTexture( ResourceHandle handle ) const
+{
+    return m_Textures.Get( handle );
+}
+
+std::shared_ptr<RenderTarget> RenderDeviceNull::CreateRenderTarget()
+{
+    std::shared_ptr<RenderTargetNull> renderTarget = std::make_shared<RenderTargetNull>( m_Counters );
+    m_RenderTargets.Add( renderTarget );
+
+    return renderTarget;
+}
+
+void RenderDeviceNull::DestroyRenderTarget( std::shared_ptr<RenderTarget> renderTarget )
+{
+    m_RenderTargets.Remove( renderTarget );
+}
+
+std::shared_ptr<SamplerState> RenderDeviceNull::CreateSamplerState()
+{
+    std::shared_ptr<SamplerState> sampler = std::make_shared<SamplerStateNull>( m_Counters );
+    m_Samplers.Add( sampler );
+
+    return sampler;
+}
+
+void RenderDeviceNull::DestroySampler( std::shared_ptr<SamplerState> sampler )
+{
+    m_Samplers.Remove( sampler );
+}
+
+std::shared_ptr<Material> RenderDeviceNull::CreateMaterial()
+{
+    std::shared_ptr<Material> pMaterial = std::make_shared<Material>( *this );
+    m_Materials.Add( pMaterial );
+    return pMaterial;
+}
+
+void RenderDeviceNull::DestroyMaterial( std::shared_ptr<Material> material )
+{
+    m_Materials.Remove( material );
+}
+
+std::shared_ptr<PipelineState> RenderDeviceNull::CreatePipelineState()
+{
+    std::shared_ptr<PipelineState> pPipeline = std::make_shared<PipelineStateNull>( m_Counters );
+    m_Pipelines.Add( pPipeline );
+
+    return pPipeline;
+}
+
+void RenderDeviceNull::DestoryPipelineState( std::shared_ptr<PipelineState> pipeline )
+{
+    m_Pipelines.Remove( pipeline );
+}
+
+std::shared_ptr<Query> RenderDeviceNull::CreateQuery( Query::QueryType queryType, uint8_t numBuffers )
+{
+    std::shared_ptr<Query> query = std::make_shared<QueryNull>( m_Counters, queryType, numBuffers );
+    m_Queries.Add( query );
+
+    return query;
+}
+
+void RenderDeviceNull::DestoryQuery( std::shared_ptr<Query> query )
+{
+    m_Queries.Remove( query );
+}
+
+std::shared_ptr<CommandList> RenderDeviceNull::CreateCommandList()
+{
+    std::shared_ptr<CommandList> commandList = std::make_shared<CommandListNull>( m_Counters );
+    m_CommandLists.Add( commandList );
+
+    return commandList;
+}
+
+void RenderDeviceNull::DestroyCommandList( std::shared_ptr<CommandList> commandList )
+{
+    m_CommandLists.Remove( commandList );
+}
+
+void RenderDeviceNull::OnLoadingProgress( ProgressEventArgs& e )
+{
+    base::OnLoadingProgress( e );
+}
+
+void RenderDeviceNull::LoadDefaultResources()
+{
+    // The null shaders are never compiled so the source of the default shader is not needed.
+    std::shared_ptr<Shader> pDefaultVertexShader = CreateShader();
+    pDefaultVertexShader->LoadShaderFromString( Shader::VertexShader, std::string(), L"DefaultShader.hlsl", Shader::ShaderMacros(), "VS_main", "vs_4_0" );
+
+    std::shared_ptr<Shader> pDefaultPixelShader = CreateShader();
+    pDefaultPixelShader->LoadShaderFromString( Shader::PixelShader, std::string(), L"DefaultShader.hlsl", Shader::ShaderMacros(), "PS_main", "ps_4_0" );
+
+    m_pDefaultTexture = CreateTexture2D( 1, 1, 1, Texture::TextureFormat() );
+
+    m_pDefaultPipeline = CreatePipelineState();
+
+    m_pDefaultPipeline->SetShader( Shader::VertexShader, pDefaultVertexShader );
+    m_pDefaultPipeline->SetShader( Shader::PixelShader, pDefaultPixelShader );
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <RenderDevice.h>
+#include <ResourceStateTracker.h>
+
+#include "../ResourceRegistry.h"
+
+#include "RenderCountersNull.h"
+
+class Material;
+class ConstantBufferRingNull;
+class UploadQueueNull;
+
+/**
+ * A render device that does not use a graphics API.
+ * Resources keep their data in system memory and shaders are never compiled.
+ * Instead of submitting commands to a GPU, the resources count the calls that
+ * are made to them (see RenderCountersNull) so the CPU side of the renderer
+ * can be run and profiled on machines without a GPU.
+ */
+class RenderDeviceNull : public RenderDevice
+{
+public:
+    typedef RenderDevice base;
+
+    RenderDeviceNull();
+    virtual ~RenderDeviceNull();
+
+    virtual const std::string& GetDeviceName() const;
+
+    // Inherited from RenderDevice
+    virtual std::shared_ptr<Buffer> CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride );
+    virtual std::shared_ptr<Buffer> CreateDoubleVertexBuffer( const double* data, unsigned int count, unsigned int stride );
+    virtual std::shared_ptr<Buffer> CreateUShortIndexBuffer( const unsigned short* data, unsigned int count );
+    virtual std::shared_ptr<Buffer> CreateUIntIndexBuffer( const unsigned int* data, unsigned int count );
+    virtual std::shared_ptr<ConstantBuffer> CreateConstantBuffer( const void* data, size_t size );
+    virtual std::shared_ptr<StructuredBuffer> CreateStructuredBuffer( void* data, unsigned int count, unsigned int stride, CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
+    // Create a vertex buffer that contains several interleaved vertex attributes.
+    // @param stride The size of a vertex in bytes.
+    std::shared_ptr<Buffer> CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride );
+
+    virtual void DestroyBuffer( std::shared_ptr<Buffer> buffer );
+    virtual void DestroyVertexBuffer( std::shared_ptr<Buffer> buffer );
+    virtual void DestroyIndexBuffer( std::shared_ptr<Buffer> buffer );
+    virtual void DestroyConstantBuffer( std::shared_ptr<ConstantBuffer> buffer );
+    virtual void DestroyStructuredBuffer( std::shared_ptr<StructuredBuffer> buffer );
+
+    virtual std::shared_ptr<Shader> CreateShader();
+    virtual void DestroyShader( std::shared_ptr<Shader> shader );
+
+    virtual std::shared_ptr<Scene> CreateScene();
+    virtual void DestroyScene( std::shared_ptr<Scene> scene );
+
+    virtual std::shared_ptr<Mesh> CreateMesh();
+    virtual void DestroyMesh( std::shared_ptr<Mesh> mesh );
+
+    virtual std::shared_ptr<Texture> CreateTexture( const std::wstring& fileName );
+    virtual std::shared_ptr<Texture> CreateTextureCube( const std::wstring& fileName );
+
+    virtual std::shared_ptr<Texture> CreateTexture1D( uint16_t width, uint16_t slices = 1, const Texture::TextureFormat& format = Texture::TextureFormat(), CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
+    virtual std::shared_ptr<Texture> CreateTexture2D( uint16_t width, uint16_t height, uint16_t slices = 1, const Texture::TextureFormat& format = Texture::TextureFormat(), CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
+    virtual std::shared_ptr<Texture> CreateTexture3D( uint16_t width, uint16_t height, uint16_t depth, const Texture::TextureFormat& format = Texture::TextureFormat(), CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
+    virtual std::shared_ptr<Texture> CreateTextureCube( uint16_t size, uint16_t numCubes = 1, const Texture::TextureFormat& format = Texture::TextureFormat(), CPUAccess cpuAccess = CPUAccess::None, bool gpuWrite = false );
+    virtual std::shared_ptr<Texture> CreateTexture();
+    virtual std::shared_ptr<Texture> GetDefaultTexture() const;
+
+    virtual void DestroyTexture( std::shared_ptr<Texture> texture );
+
+    virtual std::shared_ptr<Query> CreateQuery( Query::QueryType queryType = Query::QueryType::Timer, uint8_t numBuffers = 3 );
+    virtual void DestoryQuery( std::shared_ptr<Query> query );
+
+    // Create a render target
+    virtual std::shared_ptr<RenderTarget> CreateRenderTarget();
+    virtual void DestroyRenderTarget( std::shared_ptr<RenderTarget> renderTarget );
+
+    virtual std::shared_ptr<SamplerState> CreateSamplerState();
+    virtual void DestroySampler( std::shared_ptr<SamplerState> sampler );
+
+    virtual std::shared_ptr<Material> CreateMaterial();
+    virtual void DestroyMaterial( std::shared_ptr<Material> Material );
+
+    virtual std::shared_ptr<PipelineState> CreatePipelineState();
+    virtual void DestoryPipelineState( std::shared_ptr<PipelineState> pipeline );
+
+    virtual ConstantBufferRing* GetConstantBufferRing();
+
+    virtual std::shared_ptr<CommandList> CreateCommandList();
+    virtual void DestroyCommandList( std::shared_ptr<CommandList> commandList );
+
+    virtual ResourceStateTracker* GetResourceStateTracker();
+    // Count the transitions of the declared resources (the resources keep their data in system memory).
+    virtual void FlushResourceTransitions();
+
+    // The state changes of the last frame that was ended with EndFrame.
+    virtual const StateCacheStatistics* GetStateCacheStatistics() const;
+
+    virtual ResourceHandle GetBufferHandle( std::shared_ptr<Buffer> buffer ) const;
+    virtual std::shared_ptr<Buffer> GetBuffer( ResourceHandle handle ) const;
+    virtual void DestroyBuffer( ResourceHandle handle );
+
+    virtual ResourceHandle GetTextureHandle( std::shared_ptr<Texture> texture ) const;
+    virtual std::shared_ptr<Texture> GetTexture( ResourceHandle handle ) const;
+    virtual void DestroyTexture( ResourceHandle handle );
+
+    // Specific to RenderDeviceNull
+    // The calls that were made to the resources of this device.
+    RenderCountersNull& GetCounters();
+    const RenderCountersNull& GetCounters() const;
+    // The queue that the updates of buffers and textures are staged in.
+    UploadQueueNull& GetUploadQueue();
+    // End the frame (when the render window is presented). The staged uploads are flushed
+    // and the frames the simulated GPU has finished are retired.
+    void EndFrame();
+
+protected:
+    virtual void OnLoadingProgress( ProgressEventArgs& e );
+
+private:
+    // The name of the device.
+    std::string m_DeviceName;
+
+    RenderCountersNull m_Counters;
+
+    std::unique_ptr<ConstantBufferRingNull> m_pConstantBufferRing;
+    std::unique_ptr<UploadQueueNull> m_pUploadQueue;
+
+    ResourceStateTracker m_StateTracker;
+
+    typedef ResourceRegistry<Scene> SceneRegistry;
+    SceneRegistry m_Scenes;
+
+    typedef ResourceRegistry<Buffer> BufferRegistry;
+    BufferRegistry m_Buffers;
+
+    typedef ResourceRegistry<Mesh> MeshRegistry;
+    MeshRegistry m_Meshes;
+
+    typedef ResourceRegistry<Shader> ShaderRegistry;
+    ShaderRegistry m_Shaders;
+
+    typedef ResourceRegistry<Texture> TextureRegistry;
+    typedef std::map< std::wstring, std::shared_ptr<Texture> > TextureMap;
+    // The file names of the textures in the texture map (to remove a texture from the map without searching it).
+    typedef std::unordered_map< const Texture*, std::wstring > TextureNameMap;
+    TextureRegistry m_Textures;
+    TextureMap m_TexturesByName;
+    TextureNameMap m_TextureNames;
+
+    typedef ResourceRegistry<RenderTarget> RenderTargetRegistry;
+    RenderTargetRegistry m_RenderTargets;
+
+    std::shared_ptr<Texture> m_pDefaultTexture;
+
+    typedef ResourceRegistry<SamplerState> SamplerRegistry;
+    SamplerRegistry m_Samplers;
+
+    typedef ResourceRegistry<Material> MaterialRegistry;
+    MaterialRegistry m_Materials;
+
+    typedef ResourceRegistry<PipelineState> PipelineRegistry;
+    PipelineRegistry m_Pipelines;
+
+    typedef ResourceRegistry<Query> QueryRegistry;
+    QueryRegistry m_Queries;
+
+    typedef ResourceRegistry<CommandList> CommandListRegistry;
+    CommandListRegistry m_CommandLists;
+
+    std::shared_ptr<PipelineState> m_pDefaultPipeline;
+
+    void LoadDefaultResources();
+};
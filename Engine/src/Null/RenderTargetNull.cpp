@@ -0,0 +1,150 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "TextureNull.h"
+#include "StructuredBufferNull.h"
+
+#include "RenderTargetNull.h"
+
+RenderTargetNull::RenderTargetNull( RenderCountersNull& counters )
+    : m_Counters( counters )
+    , m_Width( 0 )
+    , m_Height( 0 )
+    , m_bCheckValidity( false )
+{
+    m_Textures.resize( (size_t)RenderTarget::AttachmentPoint::NumAttachmentPoints + 1 );
+    m_StructuredBuffers.resize( 8 );
+}
+
+RenderTargetNull::~RenderTargetNull()
+{
+
+}
+
+void RenderTargetNull::AttachTexture( AttachmentPoint attachment, std::shared_ptr<Texture> texture )
+{
+    std::shared_ptr<TextureNull> textureNull = std::dynamic_pointer_cast<TextureNull>( texture );    
+    m_Textures[(uint8_t)attachment] = textureNull;
+
+    // Next time the render target is "bound", check that it is valid.
+    m_bCheckValidity = true;
+}
+
+std::shared_ptr<Texture> RenderTargetNull::GetTexture( AttachmentPoint attachment )
+{
+    return m_Textures[(uint8_t)attachment];
+}
+
+
+void RenderTargetNull::Clear( AttachmentPoint attachment, ClearFlags clearFlags, const glm::vec4& color, float depth, uint8_t stencil )
+{
+    std::shared_ptr<TextureNull> texture = m_Textures[(uint8_t)attachment];
+    if ( texture )
+    {
+        texture->Clear( clearFlags, color, depth, stencil );
+    }
+}
+
+void RenderTargetNull::Clear( ClearFlags clearFlags, const glm::vec4& color, float depth, uint8_t stencil )
+{
+    for ( uint8_t i = 0; i < (uint8_t)AttachmentPoint::NumAttachmentPoints; ++i )
+    {
+        Clear( (AttachmentPoint)i, clearFlags, color, depth, stencil );
+    }
+}
+
+void RenderTargetNull::GenerateMipMaps()
+{
+    for ( auto texture : m_Textures )
+    {
+        if ( texture )
+        {
+            texture->GenerateMipMaps();
+        }
+    }
+}
+
+void RenderTargetNull::AttachStructuredBuffer( uint8_t slot, std::shared_ptr<StructuredBuffer> rwBuffer )
+{
+    std::shared_ptr<StructuredBufferNull> rwbufferNull = std::dynamic_pointer_cast<StructuredBufferNull>( rwBuffer );
+    m_StructuredBuffers[slot] = rwbufferNull;
+
+    // Next time the render target is "bound", check that it is valid.
+    m_bCheckValidity = true;
+}
+
+std::shared_ptr<StructuredBuffer> RenderTargetNull::GetStructuredBuffer( uint8_t slot )
+{
+    if ( slot < m_StructuredBuffers.size() )
+    {
+        return m_StructuredBuffers[slot];
+    }
+    return std::shared_ptr<StructuredBuffer>();
+}
+
+
+void RenderTargetNull::Resize( uint16_t width, uint16_t height )
+{
+    if ( m_Width != width || m_Height != height )
+    {
+        m_Width = glm::max<uint16_t>( width, 1 );
+        m_Height = glm::max<uint16_t>( height, 1 );
+        // Resize the attached textures.
+        for ( auto texture : m_Textures )
+        {
+            if ( texture )
+            {
+                texture->Resize( m_Width, m_Height );
+            }
+        }
+    }
+}
+
+void RenderTargetNull::Bind()
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    if ( m_bCheckValidity )
+    {
+        if ( !IsValid() )
+        {
+            ReportError( "Invalid render target." );
+        }
+        m_bCheckValidity = false;
+    }
+
+    ++counters.RenderTargetBinds;
+    counters.StateCache.SetRenderTarget( this );
+}
+
+void RenderTargetNull::UnBind()
+{
+    RenderCountersNull::GetCurrent( m_Counters ).StateCache.SetRenderTarget( nullptr );
+}
+
+bool RenderTargetNull::IsValid() const
+{
+    int width = -1;
+    int height = -1;
+
+    for ( auto texture : m_Textures )
+    {
+        if ( texture )
+        {
+            if ( width == -1 || height == -1 )
+            {
+                width = texture->GetWidth();
+                height = texture->GetHeight();
+            }
+            else
+            {
+                if ( texture->GetWidth() != width || texture->GetHeight() != height )
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
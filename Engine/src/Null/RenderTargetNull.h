@@ -0,0 +1,43 @@
+#pragma once
+
+#include <RenderTarget.h>
+
+struct RenderCountersNull;
+class TextureNull;
+class StructuredBufferNull;
+
+class RenderTargetNull : public RenderTarget
+{
+public:
+    RenderTargetNull( RenderCountersNull& counters );
+    virtual ~RenderTargetNull();
+
+    virtual void AttachTexture( AttachmentPoint attachment, std::shared_ptr<Texture> texture );
+    virtual std::shared_ptr<Texture> GetTexture( AttachmentPoint attachment );
+    virtual void Clear( AttachmentPoint attachemnt, ClearFlags clearFlags = ClearFlags::All, const glm::vec4& color = glm::vec4( 0 ), float depth = 1.0f, uint8_t stencil = 0 );
+    virtual void Clear( ClearFlags clearFlags = ClearFlags::All, const glm::vec4& color = glm::vec4( 0 ), float depth = 1.0f, uint8_t stencil = 0 );
+    virtual void GenerateMipMaps();
+    virtual void AttachStructuredBuffer( uint8_t slot, std::shared_ptr<StructuredBuffer> rwBuffer );
+    virtual std::shared_ptr<StructuredBuffer> GetStructuredBuffer( uint8_t slot );
+    virtual void Resize( uint16_t width, uint16_t height );
+    virtual void Bind();
+    virtual void UnBind();
+    virtual bool IsValid() const;
+
+private:
+    RenderCountersNull& m_Counters;
+
+    typedef std::vector< std::shared_ptr<TextureNull> > TextureList;
+    TextureList m_Textures;
+
+    typedef std::vector< std::shared_ptr<StructuredBufferNull> > StructuredBufferList;
+    StructuredBufferList m_StructuredBuffers;
+
+    // The width in pixels of textures associated to this render target.
+    uint16_t m_Width;
+    // The height in pixels of textures associated to this render target.
+    uint16_t m_Height;
+
+    // Check to see if the render target is valid.
+    bool m_bCheckValidity;
+};
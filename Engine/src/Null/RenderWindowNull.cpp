@@ -0,0 +1,81 @@
+#include <EnginePCH.h>
+
+#include <Application.h>
+
+#include "RenderDeviceNull.h"
+#include "RenderTargetNull.h"
+#include "RenderWindowNull.h"
+
+RenderWindowNull::RenderWindowNull( Application& app, RenderDeviceNull& device, const std::string& windowName, int windowWidth, int windowHeight, bool vSync )
+    : RenderWindow( app, windowName, windowWidth, windowHeight, vSync )
+    , m_Device( device )
+    , m_bResizePending( false )
+{
+    m_RenderTarget = std::dynamic_pointer_cast<RenderTargetNull>( m_Device.CreateRenderTarget() );
+
+    // Depth/stencil buffer
+    Texture::TextureFormat depthStencilTextureFormat(
+        Texture::Components::DepthStencil,
+        Texture::Type::UnsignedNormalized,
+        1,
+        0, 0, 0, 0, 24, 8 );
+    std::shared_ptr<Texture> depthStencilTexture = m_Device.CreateTexture2D( windowWidth, windowHeight, 1, depthStencilTextureFormat );
+
+    // Color buffer (Color0)
+    Texture::TextureFormat colorTextureFormat(
+        Texture::Components::RGBA,
+        Texture::Type::UnsignedNormalized,
+        1,
+        8, 8, 8, 8, 0, 0 );
+    std::shared_ptr<Texture> colorTexture = m_Device.CreateTexture2D( windowWidth, windowHeight, 1, colorTextureFormat );
+
+    m_RenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color0, colorTexture );
+    m_RenderTarget->AttachTexture( RenderTarget::AttachmentPoint::DepthStencil, depthStencilTexture );
+}
+
+RenderWindowNull::~RenderWindowNull()
+{}
+
+void RenderWindowNull::ShowWindow()
+{
+    base::ShowWindow();
+}
+
+void RenderWindowNull::HideWindow()
+{
+    base::HideWindow();
+}
+
+void RenderWindowNull::CloseWindow()
+{
+    base::CloseWindow();
+}
+
+void RenderWindowNull::Present()
+{
+    m_Device.EndFrame();
+}
+
+std::shared_ptr<RenderTarget> RenderWindowNull::GetRenderTarget()
+{
+    return m_RenderTarget;
+}
+
+void RenderWindowNull::OnPreRender( RenderEventArgs& e )
+{
+    if ( m_bResizePending )
+    {
+        m_RenderTarget->Resize( GetWindowWidth(), GetWindowHeight() );
+        m_bResizePending = false;
+    }
+    m_RenderTarget->Bind();
+
+    base::OnPreRender( e );
+}
+
+void RenderWindowNull::OnResize( ResizeEventArgs& e )
+{
+    base::OnResize( e );
+    // The render target will be resized the next time OnPreRender is invoked.
+    m_bResizePending = true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <RenderWindow.h>
+
+class RenderDeviceNull;
+class RenderTargetNull;
+
+// A render window without a swap chain or a native window.
+// The window's render target is only used to count the calls of the renderer.
+class RenderWindowNull : public RenderWindow
+{
+public:
+    typedef RenderWindow base;
+
+    RenderWindowNull( Application& app, RenderDeviceNull& device, const std::string& windowName, int windowWidth, int windowHeight, bool vSync );
+    virtual ~RenderWindowNull();
+
+    virtual void ShowWindow();
+    virtual void HideWindow();
+    virtual void CloseWindow();
+
+    virtual void Present();
+
+    virtual std::shared_ptr<RenderTarget> GetRenderTarget();
+
+protected:
+    virtual void OnPreRender( RenderEventArgs& e );
+    virtual void OnResize( ResizeEventArgs& e );
+
+private:
+    RenderDeviceNull& m_Device;
+
+    std::shared_ptr<RenderTargetNull> m_RenderTarget;
+
+    // Resize the render target before the next frame is rendered.
+    bool m_bResizePending;
+};
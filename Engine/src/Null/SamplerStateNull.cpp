@@ -0,0 +1,134 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "SamplerStateNull.h"
+
+SamplerStateNull::SamplerStateNull( RenderCountersNull& counters )
+    : m_Counters( counters )
+    , m_MinFilter( MinFilter::MinNearest )
+    , m_MagFilter( MagFilter::MagNearest )
+    , m_MipFilter( MipFilter::MipNearest )
+    , m_WrapModeU( WrapMode::Repeat )
+    , m_WrapModeV( WrapMode::Repeat )
+    , m_WrapModeW( WrapMode::Repeat )
+    , m_CompareFunc( CompareFunc::Always )
+    , m_fLODBias( 0.0f )
+    , m_fMinLOD( 0.0f )
+    , m_fMaxLOD( FLT_MAX )
+    , m_bIsAnisotropicFilteringEnabled( false )
+    , m_AnisotropicFiltering( 1 )
+{}
+
+SamplerStateNull::~SamplerStateNull()
+{}
+
+void SamplerStateNull::SetFilter( MinFilter minFilter, MagFilter magFilter, MipFilter mipFilter )
+{
+    m_MinFilter = minFilter;
+    m_MagFilter = magFilter;
+    m_MipFilter = mipFilter;
+}
+
+void SamplerStateNull::GetFilter( MinFilter& minFilter, MagFilter& magFilter, MipFilter& mipFilter ) const
+{
+    minFilter = m_MinFilter;
+    magFilter = m_MagFilter;
+    mipFilter = m_MipFilter;
+}
+
+void SamplerStateNull::SetWrapMode( WrapMode u, WrapMode v, WrapMode w )
+{
+    m_WrapModeU = u;
+    m_WrapModeV = v;
+    m_WrapModeW = w;
+}
+
+void SamplerStateNull::GetWrapMode( WrapMode& u, WrapMode& v, WrapMode& w ) const
+{
+    u = m_WrapModeU;
+    v = m_WrapModeV;
+    w = m_WrapModeW;
+}
+
+void SamplerStateNull::SetCompareFunction( CompareFunc compareFunc )
+{
+    m_CompareFunc = compareFunc;
+}
+
+SamplerState::CompareFunc SamplerStateNull::GetCompareFunc() const
+{
+    return m_CompareFunc;
+}
+
+void SamplerStateNull::SetLODBias( float lodBias )
+{
+    m_fLODBias = lodBias;
+}
+
+float SamplerStateNull::GetLODBias() const
+{
+    return m_fLODBias;
+}
+
+void SamplerStateNull::SetMinLOD( float minLOD )
+{
+    m_fMinLOD = minLOD;
+}
+
+float SamplerStateNull::GetMinLOD() const
+{
+    return m_fMinLOD;
+}
+
+void SamplerStateNull::SetMaxLOD( float maxLOD )
+{
+    m_fMaxLOD = maxLOD;
+}
+
+float SamplerStateNull::GetMaxLOD() const
+{
+    return m_fMaxLOD;
+}
+
+void SamplerStateNull::SetBorderColor( const glm::vec4& borderColor )
+{
+    m_BorderColor = borderColor;
+}
+
+glm::vec4 SamplerStateNull::GetBorderColor() const
+{
+    return m_BorderColor;
+}
+
+void SamplerStateNull::EnableAnisotropicFiltering( bool enabled )
+{
+    m_bIsAnisotropicFilteringEnabled = enabled;
+}
+
+bool SamplerStateNull::IsAnisotropicFilteringEnabled() const
+{
+    return m_bIsAnisotropicFilteringEnabled;
+}
+
+void SamplerStateNull::SetMaxAnisotropy( uint8_t maxAnisotropy )
+{
+    m_AnisotropicFiltering = glm::clamp<uint8_t>( maxAnisotropy, 1, 16 );
+}
+
+uint8_t SamplerStateNull::GetMaxAnisotropy() const
+{
+    return m_AnisotropicFiltering;
+}
+
+void SamplerStateNull::Bind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    ++counters.SamplerBinds;
+    counters.StateCache.SetSampler( shaderType, ID, this );
+}
+
+void SamplerStateNull::UnBind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull::GetCurrent( m_Counters ).StateCache.SetSampler( shaderType, ID, nullptr );
+}
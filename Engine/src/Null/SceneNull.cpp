@@ -0,0 +1,91 @@
+#include <EnginePCH.h>
+
+#include <Texture.h>
+
+#include "RenderDeviceNull.h"
+
+#include "SceneNull.h"
+
+SceneNull::SceneNull( RenderDeviceNull& device )
+    : m_Device( device )
+{}
+
+SceneNull::~SceneNull()
+{}
+
+std::shared_ptr<Buffer> SceneNull::CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride ) const
+{
+    return m_Device.CreateFloatVertexBuffer( data, count, stride );
+}
+
+std::shared_ptr<Buffer> SceneNull::CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride ) const
+{
+    return m_Device.CreateInterleavedVertexBuffer( data, count, stride );
+}
+
+std::shared_ptr<Buffer> SceneNull::CreateUShortIndexBuffer( const unsigned short* data, unsigned int count ) const
+{
+    return m_Device.CreateUShortIndexBuffer( data, count );
+}
+
+std::shared_ptr<Buffer> SceneNull::CreateUIntIndexBuffer( const unsigned int* data, unsigned int count ) const
+{
+    return m_Device.CreateUIntIndexBuffer( data, count );
+}
+
+std::shared_ptr<Mesh> SceneNull::CreateMesh() const
+{
+    return m_Device.CreateMesh();
+}
+
+std::shared_ptr<Material> SceneNull::CreateMaterial() const
+{
+    return m_Device.CreateMaterial();
+}
+
+std::shared_ptr<Texture> SceneNull::CreateTexture( const std::wstring& fileName ) const
+{
+    return m_Device.CreateTexture( fileName );
+}
+
+void SceneNull::CreateTextures( const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages, std::vector< std::shared_ptr<Texture> >& textures ) const
+{
+    // Only the image headers are read so there is nothing to gain from loading the textures in parallel.
+    textures.clear();
+    for ( const std::wstring& fileName : fileNames )
+    {
+        textures.push_back( m_Device.CreateTexture( fileName ) );
+    }
+}
+
+std::shared_ptr<Texture> SceneNull::CreateTexture2D( uint16_t width, uint16_t height )
+{
+    return m_Device.CreateTexture2D( width, height );
+}
+
+std::shared_ptr<Texture> SceneNull::GetDefaultTexture()
+{
+    return m_Device.GetDefaultTexture();
+}
+
+void SceneNull::StreamTextures( const TexturePriorityMap& textures, const TextureUsageMap& usages )
+{
+    m_StreamedTextures.insert( textures.begin(), textures.end() );
+}
+
+void SceneNull::SetStreamingPriorities( const TexturePriorityMap& priorities )
+{}
+
+void SceneNull::UpdateStreamedTextures( TextureMap& loadedTextures )
+{
+    for ( TexturePriorityMap::value_type texture : m_StreamedTextures )
+    {
+        loadedTextures[texture.first] = m_Device.CreateTexture( texture.first );
+    }
+    m_StreamedTextures.clear();
+}
+
+void SceneNull::CancelStreaming()
+{
+    m_StreamedTextures.clear();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../SceneBase.h"
+
+class RenderDeviceNull;
+
+class SceneNull : public SceneBase
+{
+public:
+    SceneNull( RenderDeviceNull& device );
+    virtual ~SceneNull();
+protected:
+    virtual std::shared_ptr<Buffer> CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride ) const;
+    virtual std::shared_ptr<Buffer> CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride ) const;
+    virtual std::shared_ptr<Buffer> CreateUShortIndexBuffer( const unsigned short* data, unsigned int count ) const;
+    virtual std::shared_ptr<Buffer> CreateUIntIndexBuffer( const unsigned int* data, unsigned int count ) const;
+
+    virtual std::shared_ptr<Mesh> CreateMesh() const;
+    virtual std::shared_ptr<Material> CreateMaterial() const;
+    virtual std::shared_ptr<Texture> CreateTexture( const std::wstring& fileName ) const;
+    virtual void CreateTextures( const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages, std::vector< std::shared_ptr<Texture> >& textures ) const;
+    virtual std::shared_ptr<Texture> CreateTexture2D( uint16_t width, uint16_t height );
+    virtual std::shared_ptr<Texture> GetDefaultTexture();
+
+    // Streamed textures are loaded the next time the streamed textures are updated.
+    virtual void StreamTextures( const TexturePriorityMap& textures, const TextureUsageMap& usages );
+    virtual void SetStreamingPriorities( const TexturePriorityMap& priorities );
+    virtual void UpdateStreamedTextures( TextureMap& loadedTextures );
+    virtual void CancelStreaming();
+
+private:
+    RenderDeviceNull& m_Device;
+
+    // The textures that were queued for streaming.
+    TexturePriorityMap m_StreamedTextures;
+};
@@ -0,0 +1,152 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "ShaderParameterNull.h"
+#include "ShaderNull.h"
+
+ShaderNull::ShaderNull( RenderCountersNull& counters )
+    : m_Counters( counters )
+    , m_ShaderType( UnknownShaderType )
+    , m_bInterleavedVertices( false )
+{}
+
+ShaderNull::~ShaderNull()
+{}
+
+Shader::ShaderType ShaderNull::GetType() const
+{
+    return m_ShaderType;
+}
+
+bool ShaderNull::LoadShaderFromString( ShaderType shaderType, const std::string& source, const std::wstring& sourceFileName, const ShaderMacros& shaderMacros, const std::string& entryPoint, const std::string& profile )
+{
+    m_ShaderType = shaderType;
+    m_bInterleavedVertices = ( shaderType == VertexShader && shaderMacros.find( "QUANTIZED_VERTICES" ) != shaderMacros.end() );
+    MutexLock lock( m_Mutex );
+    m_ShaderParameters.clear();
+    m_ParameterTable.clear();
+
+    return true;
+}
+
+bool ShaderNull::LoadShaderFromFile( ShaderType shaderType, const std::wstring& fileName, const ShaderMacros& shaderMacros, const std::string& entryPoint, const std::string& profile )
+{
+    fs::path filePath( fileName );
+    if ( !fs::exists( filePath ) || !fs::is_regular_file( filePath ) )
+    {
+        ReportError( "Shader file not found: " + filePath.string() );
+        return false;
+    }
+
+    return LoadShaderFromString( shaderType, std::string(), fileName, shaderMacros, entryPoint, profile );
+}
+
+ShaderParameter& ShaderNull::GetShaderParameterByName( const std::string& name ) const
+{
+    MutexLock lock( m_Mutex );
+
+    ParameterMap::iterator iter = m_ShaderParameters.find( name );
+    if ( iter == m_ShaderParameters.end() )
+    {
+        // Parameters are assigned to consecutive slots in the order they are queried.
+        uint32_t slotID = static_cast<uint32_t>( m_ShaderParameters.size() );
+        iter = m_ShaderParameters.insert( ParameterMap::value_type( name, std::make_shared<ShaderParameterNull>( name, slotID, m_ShaderType ) ) ).first;
+    }
+
+    return *( iter->second );
+}
+
+ShaderParameter& ShaderNull::GetShaderParameter( const ShaderParameterID& id ) const
+{
+    if ( !id.IsValid() )
+    {
+        return GetShaderParameterByName( id.GetName() );
+    }
+
+    MutexLock lock( m_Mutex );
+
+    if ( id.GetIndex() >= m_ParameterTable.size() )
+    {
+        m_ParameterTable.resize( id.GetIndex() + 1, nullptr );
+    }
+
+    ShaderParameterNull*& shaderParameter = m_ParameterTable[id.GetIndex()];
+    if ( shaderParameter == nullptr )
+    {
+        // Parameters are created the first time they are queried (by name or by ID).
+        shaderParameter = static_cast<ShaderParameterNull*>( &GetShaderParameterByName( id.GetName() ) );
+    }
+
+    return *shaderParameter;
+}
+
+std::string ShaderNull::GetLatestProfile( ShaderType type )
+{
+    switch ( type )
+    {
+    case VertexShader:
+        return "vs_5_0";
+    case TessellationControlShader:
+        return "hs_5_0";
+    case TessellationEvaluationShader:
+        return "ds_5_0";
+    case GeometryShader:
+        return "gs_5_0";
+    case PixelShader:
+        return "ps_5_0";
+    case ComputeShader:
+        return "cs_5_0";
+    }
+
+    return "";
+}
+
+bool ShaderNull::HasInterleavedVertices() const
+{
+    return m_bInterleavedVertices;
+}
+
+void ShaderNull::Bind()
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    MutexLock lock( m_Mutex );
+    for ( ParameterMap::value_type value : m_ShaderParameters )
+    {
+        value.second->Bind();
+    }
+
+    ++counters.ShaderBinds;
+
+    // A vertex shader has its own input layout.
+    if ( m_ShaderType == VertexShader )
+    {
+        counters.StateCache.SetInputLayout( this );
+    }
+    counters.StateCache.SetShader( m_ShaderType, this );
+}
+
+void ShaderNull::UnBind()
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    MutexLock lock( m_Mutex );
+    for ( ParameterMap::value_type value : m_ShaderParameters )
+    {
+        value.second->UnBind();
+    }
+
+    if ( m_ShaderType == VertexShader )
+    {
+        counters.StateCache.SetInputLayout( nullptr );
+    }
+    counters.StateCache.SetShader( m_ShaderType, nullptr );
+}
+
+void ShaderNull::Dispatch( const glm::uvec3& numGroups )
+{
+    if ( m_ShaderType == ComputeShader )
+    {
+        ++RenderCountersNull::GetCurrent( m_Counters ).Dispatches;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Shader.h>
+
+struct RenderCountersNull;
+class ShaderParameterNull;
+
+// A shader that is never compiled.
+// Shader parameters are created on demand when they are queried by name
+// so every parameter the render passes use is available.
+class ShaderNull : public Shader
+{
+public:
+    typedef Shader base;
+
+    ShaderNull( RenderCountersNull& counters );
+    virtual ~ShaderNull();
+
+    virtual ShaderType GetType() const;
+
+    // Shader loading
+    virtual bool LoadShaderFromString( ShaderType type, const std::string& source, const std::wstring& sourceFileName, const ShaderMacros& shaderMacros, const std::string& entryPoint, const std::string& profile );
+    virtual bool LoadShaderFromFile( ShaderType type, const std::wstring& fileName, const ShaderMacros& shaderMacros, const std::string& entryPoint, const std::string& profile );
+
+    virtual ShaderParameter& GetShaderParameterByName( const std::string& name ) const;
+    virtual ShaderParameter& GetShaderParameter( const ShaderParameterID& id ) const;
+
+    // Query for the latest supported shader profile
+    virtual std::string GetLatestProfile( ShaderType type );
+
+    // Returns true if the vertex shader was loaded with the QUANTIZED_VERTICES macro.
+    bool HasInterleavedVertices() const;
+
+    virtual void Bind();
+    virtual void UnBind();
+
+    virtual void Dispatch( const glm::uvec3& numGroups );
+
+private:
+    RenderCountersNull& m_Counters;
+
+    ShaderType m_ShaderType;
+    bool m_bInterleavedVertices;
+
+    typedef std::map<std::string, std::shared_ptr<ShaderParameterNull> > ParameterMap;
+    mutable ParameterMap m_ShaderParameters;
+    // The shader parameters indexed by their interned ShaderParameterID.
+    mutable std::vector<ShaderParameterNull*> m_ParameterTable;
+
+    // Parameters may be created while command lists are recorded on multiple threads.
+    typedef std::unique_lock<std::recursive_mutex> MutexLock;
+    mutable std::recursive_mutex m_Mutex;
+};
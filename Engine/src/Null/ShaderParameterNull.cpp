@@ -0,0 +1,109 @@
+#include <EnginePCH.h>
+
+#include <ConstantBuffer.h>
+#include <Texture.h>
+#include <SamplerState.h>
+#include <StructuredBuffer.h>
+
+#include "ShaderParameterNull.h"
+
+ShaderParameterNull::ShaderParameterNull( const std::string& name, uint32_t slotID, Shader::ShaderType shaderType )
+    : m_Name( name )
+    , m_uiSlotID( slotID )
+    , m_ShaderType( shaderType )
+    , m_ParameterType( Type::Buffer )
+{}
+
+void ShaderParameterNull::SetConstantBuffer( std::shared_ptr<ConstantBuffer> buffer )
+{
+    m_pConstantBuffer = buffer;
+    m_ParameterType = Type::Buffer;
+}
+
+void ShaderParameterNull::SetTexture( std::shared_ptr<Texture> texture )
+{
+    m_pTexture = texture;
+    m_ParameterType = Type::Texture;
+}
+
+void ShaderParameterNull::SetSampler( std::shared_ptr<SamplerState> sampler )
+{
+    m_pSamplerState = sampler;
+    m_ParameterType = Type::Sampler;
+}
+
+void ShaderParameterNull::SetStructuredBuffer( std::shared_ptr<StructuredBuffer> rwBuffer )
+{
+    m_pStructuredBuffer = rwBuffer;
+    m_ParameterType = Type::Buffer;
+}
+
+bool ShaderParameterNull::IsValid() const
+{
+    return m_ParameterType != ShaderParameter::Type::Invalid;
+}
+
+ShaderParameter::Type ShaderParameterNull::GetType() const
+{
+    return m_ParameterType;
+}
+
+uint32_t ShaderParameterNull::GetSlotID() const
+{
+    return m_uiSlotID;
+}
+
+Shader::ShaderType ShaderParameterNull::GetShaderType() const
+{
+    return m_ShaderType;
+}
+
+void ShaderParameterNull::Bind()
+{
+    if ( std::shared_ptr<ConstantBuffer> constantBuffer = m_pConstantBuffer.lock() )
+    {
+        constantBuffer->Bind( m_uiSlotID, m_ShaderType, m_ParameterType );
+    }
+    if ( std::shared_ptr<Texture> texture = m_pTexture.lock() )
+    {
+        texture->Bind( m_uiSlotID, m_ShaderType, m_ParameterType );
+    }
+    if ( std::shared_ptr<SamplerState> samplerState = m_pSamplerState.lock() )
+    {
+        samplerState->Bind( m_uiSlotID, m_ShaderType, m_ParameterType );
+    }
+    if ( std::shared_ptr<StructuredBuffer> buffer = m_pStructuredBuffer.lock() )
+    {
+        buffer->Bind( m_uiSlotID, m_ShaderType, m_ParameterType );
+    }
+}
+
+void ShaderParameterNull::BindConstantBuffer( ConstantBuffer& constantBuffer )
+{
+    constantBuffer.Bind( m_uiSlotID, m_ShaderType, Type::Buffer );
+}
+
+void ShaderParameterNull::BindStructuredBuffer( StructuredBuffer& buffer )
+{
+    buffer.Bind( m_uiSlotID, m_ShaderType, Type::Buffer );
+}
+
+void ShaderParameterNull::UnBind()
+{
+    if ( std::shared_ptr<ConstantBuffer> constantBuffer = m_pConstantBuffer.lock() )
+    {
+        constantBuffer->UnBind( m_uiSlotID, m_ShaderType, m_ParameterType );
+    }
+    if ( std::shared_ptr<Texture> texture = m_pTexture.lock() )
+    {
+        texture->UnBind( m_uiSlotID, m_ShaderType, m_ParameterType );
+    }
+    if ( std::shared_ptr<SamplerState> samplerState = m_pSamplerState.lock() )
+    {
+        samplerState->UnBind( m_uiSlotID, m_ShaderType, m_ParameterType );
+    }
+    if ( std::shared_ptr<StructuredBuffer> buffer = m_pStructuredBuffer.lock() )
+    {
+        buffer->UnBind( m_uiSlotID, m_ShaderType, m_ParameterType );
+    }
+}
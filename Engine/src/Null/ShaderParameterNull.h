@@ -0,0 +1,51 @@
+#pragma once
+
+#include <ShaderParameter.h>
+#include <Shader.h>
+
+// A shader parameter of a shader that is never compiled.
+// The parameter is valid as soon as a resource is assigned to it so that
+// the render passes can set and bind their parameters as usual.
+class ShaderParameterNull : public ShaderParameter
+{
+public:
+    typedef ShaderParameter base;
+
+    ShaderParameterNull( const std::string& name, uint32_t slotID, Shader::ShaderType shaderType );
+
+    bool IsValid() const;
+
+    // Get the type of the stored parameter.
+    virtual Type GetType() const;
+
+    // The slot and the shader stage the parameter is bound to.
+    uint32_t GetSlotID() const;
+    Shader::ShaderType GetShaderType() const;
+
+    // Bind the shader parameter to a specific slot for the given shader type.
+    virtual void Bind();
+    virtual void UnBind();
+
+protected:
+
+    virtual void SetConstantBuffer( std::shared_ptr<ConstantBuffer> buffer );
+    virtual void SetTexture( std::shared_ptr<Texture> texture );
+    virtual void SetSampler( std::shared_ptr<SamplerState> sampler );
+    virtual void SetStructuredBuffer( std::shared_ptr<StructuredBuffer> rwBuffer );
+
+    virtual void BindConstantBuffer( ConstantBuffer& constantBuffer );
+    virtual void BindStructuredBuffer( StructuredBuffer& buffer );
+
+private:
+    std::string m_Name;
+
+    // Shader parameter does not take ownership of these types.
+    std::weak_ptr<Texture> m_pTexture;
+    std::weak_ptr<SamplerState> m_pSamplerState;
+    std::weak_ptr<ConstantBuffer> m_pConstantBuffer;
+    std::weak_ptr<StructuredBuffer> m_pStructuredBuffer;
+
+    uint32_t m_uiSlotID;
+    Shader::ShaderType m_ShaderType;
+    Type m_ParameterType;
+};
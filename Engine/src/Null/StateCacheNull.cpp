@@ -0,0 +1,186 @@
+#include <EnginePCH.h>
+
+#include "StateCacheNull.h"
+
+typedef StateCacheStatistics::State State;
+
+StateCacheNull::StateCacheNull()
+{
+    Reset();
+}
+
+bool StateCacheNull::IsValidStage( Shader::ShaderType shaderType )
+{
+    return shaderType >= Shader::VertexShader && shaderType <= Shader::ComputeShader;
+}
+
+uint32_t StateCacheNull::GetStage( Shader::ShaderType shaderType )
+{
+    return shaderType - Shader::VertexShader;
+}
+
+void StateCacheNull::SetShader( Shader::ShaderType shaderType, const void* pShader )
+{
+    if ( !IsValidStage( shaderType ) ) return;
+
+    m_Statistics.Update( State::Shader, m_Shaders[GetStage( shaderType )], pShader );
+}
+
+void StateCacheNull::SetInputLayout( const void* pInputLayout )
+{
+    m_Statistics.Update( State::InputLayout, m_pInputLayout, pInputLayout );
+}
+
+void StateCacheNull::SetConstantBuffer( Shader::ShaderType shaderType, uint32_t slot, const void* pBuffer, uint32_t offset )
+{
+    if ( !IsValidStage( shaderType ) ) return;
+
+    assert( slot < NumConstantBufferSlots );
+
+    uint32_t stage = GetStage( shaderType );
+    if ( m_ConstantBuffers[stage][slot] == pBuffer && m_ConstantBufferOffsets[stage][slot] == offset )
+    {
+        m_Statistics.Skip( State::ConstantBuffer );
+        return;
+    }
+
+    m_ConstantBuffers[stage][slot] = pBuffer;
+    m_ConstantBufferOffsets[stage][slot] = offset;
+    m_Statistics.Issue( State::ConstantBuffer );
+}
+
+void StateCacheNull::SetShaderResource( Shader::ShaderType shaderType, uint32_t slot, const void* pResource )
+{
+    if ( !IsValidStage( shaderType ) ) return;
+
+    assert( slot < NumShaderResourceSlots );
+
+    uint32_t stage = GetStage( shaderType );
+    if ( m_ValidShaderResources[stage][slot] )
+    {
+        m_Statistics.Update( State::ShaderResource, m_ShaderResources[stage][slot], pResource );
+    }
+    else
+    {
+        m_ShaderResources[stage][slot] = pResource;
+        m_ValidShaderResources[stage][slot] = true;
+        m_Statistics.Issue( State::ShaderResource );
+    }
+}
+
+void StateCacheNull::SetSampler( Shader::ShaderType shaderType, uint32_t slot, const void* pSampler )
+{
+    if ( !IsValidStage( shaderType ) ) return;
+
+    assert( slot < NumSamplerSlots );
+
+    m_Statistics.Update( State::Sampler, m_Samplers[GetStage( shaderType )][slot], pSampler );
+}
+
+void StateCacheNull::SetUnorderedAccessView( uint32_t slot, const void* pResource )
+{
+    // Like the DirectX 11 state cache, unordered access views are always set.
+    m_Statistics.Issue( State::UnorderedAccess );
+
+    if ( pResource )
+    {
+        InvalidateShaderResources();
+    }
+}
+
+void StateCacheNull::SetVertexBuffer( uint32_t slot, const void* pBuffer )
+{
+    assert( slot < NumVertexBufferSlots );
+
+    m_Statistics.Update( State::VertexBuffer, m_VertexBuffers[slot], pBuffer );
+}
+
+void StateCacheNull::SetIndexBuffer( const void* pBuffer )
+{
+    m_Statistics.Update( State::IndexBuffer, m_pIndexBuffer, pBuffer );
+}
+
+void StateCacheNull::SetBlendState( const void* pBlendState )
+{
+    m_Statistics.Update( State::BlendState, m_pBlendState, pBlendState );
+}
+
+void StateCacheNull::SetRasterizerState( const void* pRasterizerState )
+{
+    m_Statistics.Update( State::RasterizerState, m_pRasterizerState, pRasterizerState );
+}
+
+void StateCacheNull::SetDepthStencilState( const void* pDepthStencilState )
+{
+    m_Statistics.Update( State::DepthStencilState, m_pDepthStencilState, pDepthStencilState );
+}
+
+void StateCacheNull::SetRenderTarget( const void* pRenderTarget )
+{
+    if ( m_Statistics.Update( State::RenderTargets, m_pRenderTarget, pRenderTarget ) )
+    {
+        InvalidateShaderResources();
+    }
+}
+
+void StateCacheNull::InvalidateShaderResources()
+{
+    for ( uint32_t stage = 0; stage < NumStages; ++stage )
+    {
+        m_ValidShaderResources[stage].reset();
+    }
+}
+
+void StateCacheNull::Reset()
+{
+    for ( uint32_t stage = 0; stage < NumStages; ++stage )
+    {
+        m_Shaders[stage] = nullptr;
+        std::fill_n( m_ConstantBuffers[stage], NumConstantBufferSlots, nullptr );
+        std::fill_n( m_ConstantBufferOffsets[stage], NumConstantBufferSlots, 0 );
+        std::fill_n( m_ShaderResources[stage], NumShaderResourceSlots, nullptr );
+        std::fill_n( m_Samplers[stage], NumSamplerSlots, nullptr );
+        m_ValidShaderResources[stage].set();
+    }
+
+    m_pInputLayout = nullptr;
+    std::fill_n( m_VertexBuffers, NumVertexBufferSlots, nullptr );
+    m_pIndexBuffer = nullptr;
+
+    m_pBlendState = nullptr;
+    m_pRasterizerState = nullptr;
+    m_pDepthStencilState = nullptr;
+
+    m_pRenderTarget = nullptr;
+}
+
+void StateCacheNull::EndFrame()
+{
+    m_Statistics.Frames = 1;
+    m_FrameStatistics = m_Statistics;
+
+    m_TotalStatistics.Add( m_Statistics );
+    ++m_TotalStatistics.Frames;
+
+    m_Statistics.Reset();
+}
+
+const StateCacheStatistics& StateCacheNull::GetStatistics() const
+{
+    return m_Statistics;
+}
+
+StateCacheStatistics& StateCacheNull::GetStatistics()
+{
+    return m_Statistics;
+}
+
+const StateCacheStatistics& StateCacheNull::GetFrameStatistics() const
+{
+    return m_FrameStatistics;
+}
+
+const StateCacheStatistics& StateCacheNull::GetTotalStatistics() const
+{
+    return m_TotalStatistics;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Shader.h>
+
+#include <bitset>
+
+#include <StateCacheStatistics.h>
+
+/**
+ * Shadows the bindings of the null render device the same way the
+ * DirectX 11 state cache shadows the state of the device context, so the
+ * number of state changes that a real device would issue (or skip) can be
+ * measured without a GPU.
+ * Bound objects are identified by their address.
+ */
+class StateCacheNull
+{
+public:
+    StateCacheNull();
+
+    void SetShader( Shader::ShaderType shaderType, const void* pShader );
+    void SetInputLayout( const void* pInputLayout );
+
+    // The offset is used to bind a range of a constant buffer ring.
+    void SetConstantBuffer( Shader::ShaderType shaderType, uint32_t slot, const void* pBuffer, uint32_t offset = 0 );
+    void SetShaderResource( Shader::ShaderType shaderType, uint32_t slot, const void* pResource );
+    void SetSampler( Shader::ShaderType shaderType, uint32_t slot, const void* pSampler );
+    // Bind an unordered access view to the compute shader stage.
+    void SetUnorderedAccessView( uint32_t slot, const void* pResource );
+
+    void SetVertexBuffer( uint32_t slot, const void* pBuffer );
+    void SetIndexBuffer( const void* pBuffer );
+
+    void SetBlendState( const void* pBlendState );
+    void SetRasterizerState( const void* pRasterizerState );
+    void SetDepthStencilState( const void* pDepthStencilState );
+
+    void SetRenderTarget( const void* pRenderTarget );
+
+    // Forget all bindings.
+    void Reset();
+
+    // Should be called once per frame.
+    // The counters of the frame become the counters of the last frame and are added to the totals.
+    void EndFrame();
+
+    // The counters of the frame that is being rendered.
+    const StateCacheStatistics& GetStatistics() const;
+    StateCacheStatistics& GetStatistics();
+    // The counters of the last frame that was ended.
+    const StateCacheStatistics& GetFrameStatistics() const;
+    // The counters of all frames that were ended.
+    const StateCacheStatistics& GetTotalStatistics() const;
+
+private:
+    // The DirectX 11 state cache has to forget the bound shader resources
+    // when the render targets change. The null state cache does the same
+    // so both report the same number of state changes.
+    void InvalidateShaderResources();
+
+    static bool IsValidStage( Shader::ShaderType shaderType );
+    // Index of a shader stage in the per-stage arrays.
+    static uint32_t GetStage( Shader::ShaderType shaderType );
+
+    // The same limits as DirectX 11.
+    static const uint32_t NumStages = 6;
+    static const uint32_t NumConstantBufferSlots = 14;
+    static const uint32_t NumShaderResourceSlots = 128;
+    static const uint32_t NumSamplerSlots = 16;
+    static const uint32_t NumVertexBufferSlots = 32;
+
+    StateCacheStatistics m_Statistics;
+    StateCacheStatistics m_FrameStatistics;
+    StateCacheStatistics m_TotalStatistics;
+
+    const void* m_Shaders[NumStages];
+    const void* m_pInputLayout;
+
+    const void* m_ConstantBuffers[NumStages][NumConstantBufferSlots];
+    uint32_t m_ConstantBufferOffsets[NumStages][NumConstantBufferSlots];
+    const void* m_ShaderResources[NumStages][NumShaderResourceSlots];
+    const void* m_Samplers[NumStages][NumSamplerSlots];
+    // Shader resource slots that are not valid must be set even if the cached resource matches.
+    std::bitset<NumShaderResourceSlots> m_ValidShaderResources[NumStages];
+
+    const void* m_VertexBuffers[NumVertexBufferSlots];
+    const void* m_pIndexBuffer;
+
+    const void* m_pBlendState;
+    const void* m_pRasterizerState;
+    const void* m_pDepthStencilState;
+
+    const void* m_pRenderTarget;
+};
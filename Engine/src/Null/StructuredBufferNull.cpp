@@ -0,0 +1,106 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "UploadQueueNull.h"
+#include "StructuredBufferNull.h"
+
+StructuredBufferNull::StructuredBufferNull( RenderCountersNull& counters, UploadQueueNull& uploadQueue, const void* data, size_t count, unsigned int stride )
+    : m_Counters( counters )
+    , m_UploadQueue( uploadQueue )
+    , m_uiStride( stride )
+    , m_uiCount( (unsigned int)count )
+{
+    m_Data.resize( count * stride );
+    if ( data && !m_Data.empty() )
+    {
+        memcpy( m_Data.data(), data, m_Data.size() );
+    }
+
+    ++m_Counters.BufferUpdates;
+    m_Counters.BytesUploaded += m_Data.size();
+}
+
+StructuredBufferNull::~StructuredBufferNull()
+{}
+
+bool StructuredBufferNull::Bind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    ++counters.StructuredBufferBinds;
+
+    if ( parameterType == ShaderParameter::Type::Buffer )
+    {
+        counters.StateCache.SetShaderResource( shaderType, id, this );
+    }
+    else if ( parameterType == ShaderParameter::Type::RWBuffer && shaderType == Shader::ComputeShader )
+    {
+        counters.StateCache.SetUnorderedAccessView( id, this );
+    }
+
+    return true;
+}
+
+void StructuredBufferNull::UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    if ( parameterType == ShaderParameter::Type::Buffer )
+    {
+        counters.StateCache.SetShaderResource( shaderType, id, nullptr );
+    }
+    else if ( parameterType == ShaderParameter::Type::RWBuffer && shaderType == Shader::ComputeShader )
+    {
+        counters.StateCache.SetUnorderedAccessView( id, nullptr );
+    }
+}
+
+void StructuredBufferNull::SetData( void* data, size_t elementSize, size_t offset, size_t numElements )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    unsigned char* first = (unsigned char*)data + ( offset * elementSize );
+    unsigned char* last = first + ( numElements * elementSize );
+    m_Data.assign( first, last );
+    m_UploadQueue.Upload( this, 0, m_Data.data(), m_Data.size() );
+
+    ++counters.BufferUpdates;
+    counters.BytesUploaded += m_Data.size();
+}
+
+void StructuredBufferNull::Copy( std::shared_ptr<StructuredBuffer> other )
+{
+    std::shared_ptr<StructuredBufferNull> srcBuffer = std::dynamic_pointer_cast<StructuredBufferNull>( other );
+
+    if ( srcBuffer && srcBuffer.get() != this &&
+         m_uiCount * m_uiStride == srcBuffer->m_uiCount * srcBuffer->m_uiStride )
+    {
+        m_Data = srcBuffer->m_Data;
+        ++RenderCountersNull::GetCurrent( m_Counters ).Copies;
+    }
+    else
+    {
+        ReportError( "Source buffer is not compatible with this buffer." );
+    }
+}
+
+void StructuredBufferNull::Copy( std::shared_ptr<Buffer> other )
+{
+    Copy( std::dynamic_pointer_cast<StructuredBuffer>( other ) );
+}
+
+void StructuredBufferNull::Clear()
+{
+    std::fill( m_Data.begin(), m_Data.end(), 0 );
+    ++RenderCountersNull::GetCurrent( m_Counters ).Clears;
+}
+
+Buffer::BufferType StructuredBufferNull::GetType() const
+{
+    return Buffer::StructuredBuffer;
+}
+
+unsigned int StructuredBufferNull::GetElementCount() const
+{
+    return m_uiCount;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <StructuredBuffer.h>
+
+struct RenderCountersNull;
+class UploadQueueNull;
+
+class StructuredBufferNull : public StructuredBuffer
+{
+public:
+    typedef StructuredBuffer base;
+
+    StructuredBufferNull( RenderCountersNull& counters, UploadQueueNull& uploadQueue, const void* data, size_t count, unsigned int stride );
+    virtual ~StructuredBufferNull();
+
+    // Bind the buffer for rendering.
+    virtual bool Bind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType );
+    // Unbind the buffer for rendering.
+    virtual void UnBind( unsigned int id, Shader::ShaderType shaderType, ShaderParameter::Type parameterType );
+
+    // Is this an index buffer or an attribute/vertex buffer?
+    virtual BufferType GetType() const;
+    // How many elements does this buffer contain?
+    virtual unsigned int GetElementCount() const;
+
+    virtual void Copy( std::shared_ptr<StructuredBuffer> other );
+
+    // Clear the contents of the buffer.
+    virtual void Clear();
+
+protected:
+    virtual void Copy( std::shared_ptr<Buffer> other );
+    virtual void SetData( void* data, size_t elementSize, size_t offset, size_t numElements );
+
+private:
+    RenderCountersNull& m_Counters;
+    // The updates of the resource are staged in the upload queue of the device.
+    UploadQueueNull& m_UploadQueue;
+
+    // The contents of the buffer.
+    std::vector<uint8_t> m_Data;
+
+    // The stride of the buffer in bytes.
+    unsigned int m_uiStride;
+    // The number of elements in this buffer.
+    unsigned int m_uiCount;
+};
@@ -0,0 +1,232 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "UploadQueueNull.h"
+#include "TextureNull.h"
+
+TextureNull::TextureNull( RenderCountersNull& counters, UploadQueueNull& uploadQueue )
+    : m_Counters( counters )
+    , m_UploadQueue( uploadQueue )
+    , m_TextureDimension( Dimension::Texture2D )
+    , m_CPUAccess( CPUAccess::None )
+    , m_TextureWidth( 0 )
+    , m_TextureHeight( 0 )
+    , m_NumSlices( 0 )
+    , m_BPP( 0 )
+    , m_bIsTransparent( false )
+{}
+
+TextureNull::TextureNull( RenderCountersNull& counters, UploadQueueNull& uploadQueue, Dimension dimension, uint16_t width, uint16_t height, uint16_t depth, const TextureFormat& format, CPUAccess cpuAccess )
+    : m_Counters( counters )
+    , m_UploadQueue( uploadQueue )
+    , m_TextureDimension( dimension )
+    , m_TextureFormat( format )
+    , m_CPUAccess( cpuAccess )
+    , m_TextureWidth( glm::max<uint16_t>( width, 1 ) )
+    , m_TextureHeight( glm::max<uint16_t>( height, 1 ) )
+    , m_NumSlices( glm::max<uint16_t>( depth, 1 ) )
+    , m_bIsTransparent( format.AlphaBits > 0 )
+{
+    m_BPP = format.RedBits + format.GreenBits + format.BlueBits + format.AlphaBits + format.DepthBits + format.StencilBits;
+    AllocateBuffer();
+}
+
+TextureNull::~TextureNull()
+{}
+
+bool TextureNull::LoadImageHeader( const std::wstring& fileName )
+{
+    fs::path filePath( fileName );
+
+#if defined(ENGINE_NO_IMPORTERS)
+    ReportError( "Images can't be loaded without FreeImage: " + filePath.string() );
+    return false;
+#else
+
+    // Try to determine the file type from the image file.
+    FREE_IMAGE_FORMAT fif = FreeImage_GetFileTypeU( filePath.c_str() );
+    if ( fif == FIF_UNKNOWN )
+    {
+        fif = FreeImage_GetFIFFromFilenameU( filePath.c_str() );
+    }
+
+    if ( fif == FIF_UNKNOWN || !FreeImage_FIFSupportsReading( fif ) )
+    {
+        ReportError( "Unknow file format: " + filePath.string() );
+        return false;
+    }
+
+    // The pixels are not needed (plugins that can't load the header only load the full image).
+    FIBITMAP* dib = FreeImage_LoadU( fif, filePath.c_str(), FIF_LOAD_NOPIXELS );
+    if ( dib == nullptr )
+    {
+        ReportError( "Failed to load image: " + filePath.string() );
+        return false;
+    }
+
+    m_TextureWidth = static_cast<uint16_t>( FreeImage_GetWidth( dib ) );
+    m_TextureHeight = static_cast<uint16_t>( FreeImage_GetHeight( dib ) );
+    m_NumSlices = 1;
+    m_BPP = static_cast<uint8_t>( FreeImage_GetBPP( dib ) );
+    m_bIsTransparent = ( FreeImage_IsTransparent( dib ) == TRUE );
+    m_TextureFileName = fileName;
+
+    FreeImage_Unload( dib );
+
+    return true;
+#endif
+}
+
+bool TextureNull::LoadTexture2D( const std::wstring& fileName )
+{
+    m_TextureDimension = Dimension::Texture2D;
+    return LoadImageHeader( fileName );
+}
+
+bool TextureNull::LoadTextureCube( const std::wstring& fileName )
+{
+    m_TextureDimension = Dimension::TextureCube;
+    return LoadImageHeader( fileName );
+}
+
+void TextureNull::AllocateBuffer()
+{
+    if ( m_CPUAccess != CPUAccess::None )
+    {
+        m_Buffer.assign( (size_t)m_TextureWidth * m_TextureHeight * m_NumSlices * ( m_BPP / 8 ), 0 );
+    }
+}
+
+void TextureNull::GenerateMipMaps()
+{}
+
+std::shared_ptr<Texture> TextureNull::GetFace( CubeFace face ) const
+{
+    return std::static_pointer_cast<Texture>( std::const_pointer_cast<TextureNull>( shared_from_this() ) );
+}
+
+std::shared_ptr<Texture> TextureNull::GetSlice( unsigned int slice ) const
+{
+    return std::static_pointer_cast<Texture>( std::const_pointer_cast<TextureNull>( shared_from_this() ) );
+}
+
+uint16_t TextureNull::GetWidth() const
+{
+    return m_TextureWidth;
+}
+
+uint16_t TextureNull::GetHeight() const
+{
+    return m_TextureHeight;
+}
+
+uint16_t TextureNull::GetDepth() const
+{
+    return m_NumSlices;
+}
+
+uint8_t TextureNull::GetBPP() const
+{
+    return m_BPP;
+}
+
+bool TextureNull::IsTransparent() const
+{
+    return m_bIsTransparent;
+}
+
+void TextureNull::Resize( uint16_t width, uint16_t height, uint16_t depth )
+{
+    m_TextureWidth = glm::max<uint16_t>( width, 1 );
+    m_TextureHeight = glm::max<uint16_t>( height, 1 );
+    m_NumSlices = glm::max<uint16_t>( depth, 1 );
+
+    AllocateBuffer();
+}
+
+void TextureNull::Plot( glm::ivec2 coord, const uint8_t* pixel, size_t size )
+{
+    assert( m_BPP > 0 && m_BPP % 8 == 0 );
+    assert( coord.s < m_TextureWidth && coord.t < m_TextureHeight && size == ( m_BPP / 8 ) );
+
+    uint8_t bytesPerPixel = ( m_BPP / 8 );
+    uint32_t stride = m_TextureWidth * bytesPerPixel;
+    uint32_t index = ( coord.s * bytesPerPixel ) + ( coord.t * stride );
+
+    for ( unsigned int i = 0; i < size; ++i )
+    {
+        m_Buffer[index + i] = *( pixel + i );
+    }
+
+    // Pixels that are plotted next to each other are copied to the texture at once.
+    m_UploadQueue.Upload( this, index, pixel, size );
+}
+
+void TextureNull::FetchPixel( glm::ivec2 coord, uint8_t*& pixel, size_t size )
+{
+    assert( m_BPP > 0 && m_BPP % 8 == 0 );
+    assert( coord.s < m_TextureWidth && coord.t < m_TextureHeight && size == ( m_BPP / 8 ) );
+
+    uint8_t bytesPerPixel = ( m_BPP / 8 );
+    uint32_t stride = m_TextureWidth * bytesPerPixel;
+    uint32_t index = ( coord.s * bytesPerPixel ) + ( coord.t * stride );
+    pixel = &m_Buffer[index];
+}
+
+void TextureNull::Copy( std::shared_ptr<Texture> other )
+{
+    std::shared_ptr<TextureNull> srcTexture = std::dynamic_pointer_cast<TextureNull>( other );
+
+    if ( srcTexture && srcTexture.get() != this )
+    {
+        if ( m_TextureDimension == srcTexture->m_TextureDimension &&
+             m_TextureWidth == srcTexture->m_TextureWidth &&
+             m_TextureHeight == srcTexture->m_TextureHeight )
+        {
+            if ( m_Buffer.size() == srcTexture->m_Buffer.size() )
+            {
+                m_Buffer = srcTexture->m_Buffer;
+            }
+            ++RenderCountersNull::GetCurrent( m_Counters ).Copies;
+        }
+        else
+        {
+            ReportError( "Incompatible source texture." );
+        }
+    }
+}
+
+void TextureNull::Clear( ClearFlags clearFlags, const glm::vec4& color, float depth, uint8_t stencil )
+{
+    ++RenderCountersNull::GetCurrent( m_Counters ).Clears;
+}
+
+void TextureNull::Bind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    ++counters.TextureBinds;
+
+    if ( parameterType == ShaderParameter::Type::Texture )
+    {
+        counters.StateCache.SetShaderResource( shaderType, ID, this );
+    }
+    else if ( parameterType == ShaderParameter::Type::RWTexture && shaderType == Shader::ComputeShader )
+    {
+        counters.StateCache.SetUnorderedAccessView( ID, this );
+    }
+}
+
+void TextureNull::UnBind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    if ( parameterType == ShaderParameter::Type::Texture )
+    {
+        counters.StateCache.SetShaderResource( shaderType, ID, nullptr );
+    }
+    else if ( parameterType == ShaderParameter::Type::RWTexture && shaderType == Shader::ComputeShader )
+    {
+        counters.StateCache.SetUnorderedAccessView( ID, nullptr );
+    }
+}
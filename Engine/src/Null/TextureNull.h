@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Texture.h>
+#include <CPUAccess.h>
+
+struct RenderCountersNull;
+class UploadQueueNull;
+
+// A texture without any storage on the GPU.
+// Only textures with CPU access store their texels (in system memory) so they can be plotted and fetched.
+// Textures that are loaded from a file only read the image header to get the size of the texture.
+class TextureNull : public Texture, public std::enable_shared_from_this<TextureNull>
+{
+public:
+    typedef Texture base;
+
+    // Create an empty texture (that can be loaded from a file).
+    TextureNull( RenderCountersNull& counters, UploadQueueNull& uploadQueue );
+    TextureNull( RenderCountersNull& counters, UploadQueueNull& uploadQueue, Dimension dimension, uint16_t width, uint16_t height, uint16_t depth, const TextureFormat& format, CPUAccess cpuAccess );
+    virtual ~TextureNull();
+
+    virtual bool LoadTexture2D( const std::wstring& fileName );
+    virtual bool LoadTextureCube( const std::wstring& fileName );
+
+    virtual void GenerateMipMaps();
+
+    virtual std::shared_ptr<Texture> GetFace( CubeFace face ) const;
+    virtual std::shared_ptr<Texture> GetSlice( unsigned int slice ) const;
+
+    virtual uint16_t GetWidth() const;
+    virtual uint16_t GetHeight() const;
+    virtual uint16_t GetDepth() const;
+
+    virtual uint8_t GetBPP() const;
+    virtual bool IsTransparent() const;
+
+    virtual void Resize( uint16_t width, uint16_t height = 0, uint16_t depth = 0 );
+
+    virtual void Copy( std::shared_ptr<Texture> other );
+
+    virtual void Clear( ClearFlags clearFlags = ClearFlags::All, const glm::vec4& color = glm::vec4( 0 ), float depth = 1.0f, uint8_t stencil = 0 );
+
+    virtual void Bind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType );
+    virtual void UnBind( uint32_t ID, Shader::ShaderType shaderType, ShaderParameter::Type parameterType );
+
+protected:
+    virtual void Plot( glm::ivec2 coord, const uint8_t* pixel, size_t size );
+    virtual void FetchPixel( glm::ivec2 coord, uint8_t*& pixel, size_t size );
+
+    // Read the size of an image file without decoding the image.
+    bool LoadImageHeader( const std::wstring& fileName );
+    // Allocate the system memory copy of the texture (if it has CPU access).
+    void AllocateBuffer();
+
+private:
+    RenderCountersNull& m_Counters;
+    // The updates of the resource are staged in the upload queue of the device.
+    UploadQueueNull& m_UploadQueue;
+
+    Dimension m_TextureDimension;
+    TextureFormat m_TextureFormat;
+    CPUAccess m_CPUAccess;
+
+    uint16_t m_TextureWidth;
+    uint16_t m_TextureHeight;
+    // The number of slices of 3D textures and texture arrays.
+    uint16_t m_NumSlices;
+
+    uint8_t m_BPP;
+    bool m_bIsTransparent;
+
+    // The texels of textures with CPU access.
+    std::vector<uint8_t> m_Buffer;
+
+    std::wstring m_TextureFileName;
+};
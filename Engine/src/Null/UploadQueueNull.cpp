@@ -0,0 +1,57 @@
+#include <EnginePCH.h>
+
+#include "RenderCountersNull.h"
+#include "UploadQueueNull.h"
+
+// The number of frames the simulated GPU lags behind the CPU.
+#define GPU_FRAME_LATENCY 2
+
+UploadQueueNull::UploadQueueNull( RenderCountersNull& counters, size_t size )
+    : m_Counters( counters )
+    , m_Memory( size, 0 )
+    , m_Ring( m_Memory.data(), m_Memory.size() )
+    , m_Frame( 0 )
+{}
+
+UploadQueueNull::~UploadQueueNull()
+{}
+
+void UploadQueueNull::Upload( const void* destination, size_t destinationOffset, const void* data, size_t size )
+{
+    RenderCountersNull& counters = RenderCountersNull::GetCurrent( m_Counters );
+
+    std::lock_guard<std::mutex> lock( m_Mutex );
+
+    if ( m_Ring.Upload( destination, destinationOffset, data, size ) ) return;
+
+    // The ring is full: submit the uploads that are staged and wait until the GPU has finished all copies.
+    ++counters.StagingStalls;
+    FlushUploads( counters );
+    m_Ring.EndFrame( m_Frame );
+    m_Ring.Retire( m_Frame );
+
+    if ( !m_Ring.Upload( destination, destinationOffset, data, size ) )
+    {
+        // The data is larger than the ring and is copied without staging it.
+        ++counters.StagingCopies;
+    }
+}
+
+void UploadQueueNull::EndFrame()
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+
+    FlushUploads( m_Counters );
+    m_Ring.EndFrame( m_Frame );
+
+    ++m_Frame;
+    if ( m_Frame >= GPU_FRAME_LATENCY )
+    {
+        m_Ring.Retire( m_Frame - GPU_FRAME_LATENCY );
+    }
+}
+
+void UploadQueueNull::FlushUploads( RenderCountersNull& counters )
+{
+    counters.StagingCopies += m_Ring.Flush().size();
+}
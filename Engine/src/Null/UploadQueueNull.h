@@ -0,0 +1,42 @@
+#pragma once
+
+#include <StagingUploadRing.h>
+
+struct RenderCountersNull;
+
+/**
+ * Stages the updates of the buffers and textures of the null render device
+ * in a StagingUploadRing. The uploads of a frame are flushed as one batch of copies
+ * when the frame is presented. The GPU is simulated to finish the copies of a frame
+ * a fixed number of frames after the frame has ended (like ConstantBufferRingNull),
+ * so the number of copies a real device would issue and the number of times the CPU
+ * would have to wait for the GPU because the staging ring is full can be measured without a GPU.
+ * Resources can be updated by command lists that are recording on worker threads,
+ * so the ring is protected by a mutex.
+ */
+class UploadQueueNull
+{
+public:
+    UploadQueueNull( RenderCountersNull& counters, size_t size );
+    virtual ~UploadQueueNull();
+
+    // Stage size bytes of data that are copied to destination at destinationOffset.
+    void Upload( const void* destination, size_t destinationOffset, const void* data, size_t size );
+
+    // Flush the uploads of the frame and end the frame.
+    void EndFrame();
+
+private:
+    // Count the copies of the uploads that have not been flushed.
+    // The mutex must be locked.
+    void FlushUploads( RenderCountersNull& counters );
+
+    RenderCountersNull& m_Counters;
+
+    // The staging memory of the ring.
+    std::vector<uint8_t> m_Memory;
+    StagingUploadRing m_Ring;
+    std::mutex m_Mutex;
+
+    uint64_t m_Frame;
+};
@@ -1,5 +1,7 @@
 #include <EnginePCH.h>
 #include <Ray.h>
+#include <RaycastHit.h>
+#include <Light.h>
 
 Ray::Ray()
 {}
@@ -12,4 +14,173 @@ Ray::Ray( glm::vec3 origin, glm::vec3 direction )
 glm::vec3 Ray::GetPointOnRay( float distance ) const
 {
 	return m_Origin + ( m_Direction * distance );
-}
\ No newline at end of file
+}
+
+bool Ray::IntersectSphere( const glm::vec3& center, float radius, RaycastHit& hit ) const
+{
+	glm::vec3 m = m_Origin - center;
+	float b = glm::dot( m, m_Direction );
+	float c = glm::dot( m, m ) - ( radius * radius );
+
+	// The ray starts outside of the sphere and points away from it.
+	if ( c > 0.0f && b > 0.0f )
+	{
+		return false;
+	}
+
+	float discriminant = b * b - c;
+	if ( discriminant < 0.0f )
+	{
+		return false;
+	}
+
+	float sqrtDiscriminant = glm::sqrt( discriminant );
+	float t = -b - sqrtDiscriminant;
+	if ( t < 0.0f )
+	{
+		// The ray starts inside the sphere. Use the far intersection point.
+		t = -b + sqrtDiscriminant;
+	}
+
+	hit.Distance = t;
+	hit.Point = GetPointOnRay( t );
+	hit.Normal = ( radius > 0.0f ) ? ( hit.Point - center ) / radius : -m_Direction;
+	hit.pMaterial = nullptr;
+
+	return true;
+}
+
+bool Ray::IntersectCone( const glm::vec3& apex, const glm::vec3& axis, float height, float angle, RaycastHit& hit ) const
+{
+	float cosAngle = glm::cos( glm::radians( angle ) );
+	float cosSqr = cosAngle * cosAngle;
+
+	glm::vec3 co = m_Origin - apex;
+	float dv = glm::dot( m_Direction, axis );
+	float cov = glm::dot( co, axis );
+
+	// Coefficients of the quadratic equation for the (infinite) double cone.
+	float a = dv * dv - cosSqr;
+	float b = 2.0f * ( dv * cov - glm::dot( m_Direction, co ) * cosSqr );
+	float c = cov * cov - glm::dot( co, co ) * cosSqr;
+
+	float tMin = std::numeric_limits<float>::max();
+	glm::vec3 normal;
+
+	float roots[2];
+	int numRoots = 0;
+
+	if ( glm::abs( a ) < 1e-6f )
+	{
+		// The ray is parallel to the surface of the cone.
+		if ( glm::abs( b ) > 1e-6f )
+		{
+			roots[numRoots++] = -c / b;
+		}
+	}
+	else
+	{
+		float discriminant = b * b - 4.0f * a * c;
+		if ( discriminant >= 0.0f )
+		{
+			float sqrtDiscriminant = glm::sqrt( discriminant );
+			roots[numRoots++] = ( -b - sqrtDiscriminant ) / ( 2.0f * a );
+			roots[numRoots++] = ( -b + sqrtDiscriminant ) / ( 2.0f * a );
+		}
+	}
+
+	for ( int i = 0; i < numRoots; ++i )
+	{
+		float t = roots[i];
+		// Only accept hits on the single cone between the apex and the base.
+		float h = cov + t * dv;
+		if ( t >= 0.0f && t < tMin && h >= 0.0f && h <= height )
+		{
+			tMin = t;
+			glm::vec3 v = co + m_Direction * t;
+			// The (outward facing) gradient of the cone surface.
+			normal = ( v * cosSqr ) - ( axis * h );
+		}
+	}
+
+	// Test the base of the cone.
+	if ( glm::abs( dv ) > 1e-6f )
+	{
+		float t = ( height - cov ) / dv;
+		if ( t >= 0.0f && t < tMin )
+		{
+			glm::vec3 v = co + m_Direction * t;
+			float baseRadius = glm::tan( glm::radians( angle ) ) * height;
+			if ( glm::length2( v - axis * height ) <= baseRadius * baseRadius )
+			{
+				tMin = t;
+				normal = axis;
+			}
+		}
+	}
+
+	if ( tMin == std::numeric_limits<float>::max() )
+	{
+		return false;
+	}
+
+	hit.Distance = tMin;
+	hit.Point = GetPointOnRay( tMin );
+	hit.Normal = ( glm::length2( normal ) > 0.0f ) ? glm::normalize( normal ) : -m_Direction;
+	hit.pMaterial = nullptr;
+
+	return true;
+}
+
+bool Ray::IntersectLights( const Light* lights, const glm::vec4* boundingSpheres, uint32_t numLights, RaycastHit& hit ) const
+{
+	bool lightHit = false;
+	RaycastHit lightVolumeHit;
+
+	hit.Distance = std::numeric_limits<float>::max();
+
+	for ( uint32_t i = 0; i < numLights; ++i )
+	{
+		// Reject the light with its bounding sphere before the exact (more expensive) test.
+		// Most lights are far from the ray or farther away than the closest hit so far.
+		// The bounding spheres are tightly packed, so only the lights that pass the test are read.
+		glm::vec3 m = m_Origin - glm::vec3( boundingSpheres[i] );
+		float radius = boundingSpheres[i].w;
+		float b = glm::dot( m, m_Direction );
+		float c = glm::dot( m, m ) - ( radius * radius );
+		// The ray misses the bounding sphere, starts outside of it and points away from it,
+		// or the bounding sphere is completely behind the closest hit.
+		if ( b * b - c < 0.0f || ( c > 0.0f && b > 0.0f ) || -b - radius > hit.Distance )
+		{
+			continue;
+		}
+
+		// Test against the same volumes that are used to render the lights (see LightsPass).
+		const Light& light = lights[i];
+		glm::vec3 positionWS = glm::vec3( light.m_PositionWS );
+		bool volumeHit = false;
+		switch ( light.m_Type )
+		{
+		case Light::LightType::Point:
+			volumeHit = IntersectSphere( positionWS, light.m_Range, lightVolumeHit );
+			break;
+		case Light::LightType::Spot:
+			volumeHit = IntersectCone( positionWS, glm::normalize( glm::vec3( light.m_DirectionWS ) ), light.m_Range, light.m_SpotlightAngle, lightVolumeHit );
+			break;
+		case Light::LightType::Directional:
+			// Directional lights are rendered as a unit length arrow.
+			// Use the bounding sphere of the arrow for picking.
+			volumeHit = IntersectSphere( positionWS + glm::normalize( glm::vec3( light.m_DirectionWS ) ) * 0.5f, 0.5f, lightVolumeHit );
+			break;
+		}
+
+		if ( volumeHit && lightVolumeHit.Distance < hit.Distance )
+		{
+			hit = lightVolumeHit;
+			hit.Index = i;
+			lightHit = true;
+		}
+	}
+
+	return lightHit;
+}
@@ -1,5 +1,6 @@
 #include <EnginePCH.h>
 #include <RenderDevice.h>
+#include <Scene.h>
 
 // Template specializations for vertex buffers.
 template<>
@@ -26,12 +27,402 @@ std::shared_ptr<Buffer> RenderDevice::CreateVertexBuffer< std::vector<glm::vec4>
     return CreateFloatVertexBuffer( glm::value_ptr( data[0] ), (unsigned int)data.size(), sizeof( glm::vec4 ) );
 }
 
+template<>
+std::shared_ptr<Buffer> RenderDevice::CreateIndexBuffer< std::vector<unsigned short> >( const std::vector<unsigned short>& data )
+{
+    return CreateUShortIndexBuffer( &( data[0] ), (unsigned int)data.size() );
+}
+
 template<>
 std::shared_ptr<Buffer> RenderDevice::CreateIndexBuffer< std::vector<unsigned int> >( const std::vector<unsigned int>& data )
 {
     return CreateUIntIndexBuffer( &( data[0] ), (unsigned int)data.size() );
 }
 
+// GLM's own quaternion from two vector constructor does not handle cases 
+// where the vectors may be pointing in opposite directions.
+// This method handles the cases where the u and v vectors are opposites.
+// source: http://lolengine.net/blog/2014/02/24/quaternion-from-two-vectors-final
+// accessed: 26/05/2015
+inline glm::quat RotationFromTwoVectors( const glm::vec3& u, const glm::vec3& v )
+{
+    float normUV = glm::sqrt( glm::dot( u, u ) * glm::dot( v, v ) );
+    float real = normUV + glm::dot( u, v );
+
+    glm::vec3 vec;
+
+    if ( real < 1.e-6f * normUV )
+    {
+        /* If u and v are exactly opposite, rotate 180 degrees
+         * around an arbitrary orthogonal axis. Axis normalisation
+         * can happen later, when we normalise the quaternion. 
+         */
+        real = 0.0f;
+        vec = ( glm::abs( u.x ) > abs( u.z ) ) ? glm::vec3( -u.y, u.x, 0.0f ) : glm::vec3( 0.0f, -u.z, u.y );
+    }
+    else
+    {
+        /* Otherwise, build quaternion the standard way. */
+        vec = glm::cross( u, v );
+    }
+
+    return glm::normalize( glm::quat( real, vec ) );
+}
+
+std::shared_ptr<Scene> RenderDevice::CreatePlane( float size, const glm::vec3& N )
+{
+    float halfSize = size * 0.5f;
+    glm::vec3 p[4];
+    // Crate the 4 points of the plane aligned to the X,Z plane.
+    // Vertex winding is assuming a right-handed coordinate system 
+    // (counter-clockwise winding order for front-facing polygons)
+    p[0] = glm::vec3(  halfSize, 0,  halfSize );
+    p[1] = glm::vec3( -halfSize, 0,  halfSize );
+    p[2] = glm::vec3( -halfSize, 0, -halfSize );
+    p[3] = glm::vec3(  halfSize, 0, -halfSize );
+
+    // Rotate the plane vertices in the direction of the surface normal.
+    glm::quat rot = RotationFromTwoVectors( glm::vec3( 0, 1, 0 ), N );
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        p[i] = rot * p[i];
+    }
+
+    // Now create the plane polygon from the transformed vertices.
+    std::shared_ptr<Scene> scene = CreateScene();
+
+    std::stringstream ss;
+
+    // Create a white diffuse material for the plane.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
+
+    // Create a 4-point polygon
+    ss << "p 4" << std::endl;
+    for ( int i = 0; i < 4; i++ )
+    {
+        ss << p[i].x << " " << p[i].y << " " << p[i].z << std::endl;
+    }
+
+    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    {
+        return scene;
+    }
+
+    // An error occurred while loading the scene.
+    DestroyScene( scene );
+    return nullptr;
+}
+
+std::shared_ptr<Scene> RenderDevice::CreateScreenQuad( float left, float right, float bottom, float top, float z )
+{
+    glm::vec3 p[4]; // Vertex position
+    glm::vec3 n[4]; // Vertex normal (required for texture patch polygons)
+    glm::vec2 t[4]; // Texture coordinates
+    // Winding order is assumed to be right-handed. Front-facing polygons have
+    // a counter-clockwise winding order.
+    // Assimp flips the winding order of vertices.. Don't ask me why. To account for this,
+    // the vertices are loaded in reverse order :)
+    p[0] = glm::vec3( right, bottom, z );   n[0] = glm::vec3( 0, 0, 1 );    t[0] = glm::vec2( 1, 0 );
+    p[1] = glm::vec3( left, bottom, z );    n[1] = glm::vec3( 0, 0, 1 );    t[1] = glm::vec2( 0, 0 );
+    p[2] = glm::vec3( left, top, z );       n[2] = glm::vec3( 0, 0, 1 );    t[2] = glm::vec2( 0, 1 );
+    p[3] = glm::vec3( right, top, z );      n[3] = glm::vec3( 0, 0, 1 );    t[3] = glm::vec2( 1, 1 );
+
+    // Now create the quad.
+    std::shared_ptr<Scene> scene = CreateScene();
+
+    std::stringstream ss;
+
+    // Create a white diffuse material for the quad.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
+
+    // Create a 4-point textured polygon patch
+    ss << "tpp 4" << std::endl;
+    for ( int i = 0; i < 4; i++ )
+    {
+        // px py pz nx ny nz tu tv
+        ss << p[i].x << " " << p[i].y << " " << p[i].z << " " << n[i].x << " " << n[i].y << " " << n[i].z << " " << t[i].x << " " << t[i].y << std::endl;
+    }
+
+    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    {
+        return scene;
+    }
+
+    // An error occurred while loading the scene.
+    DestroyScene( scene );
+    return nullptr;
+
+}
+
+std::shared_ptr<Scene> RenderDevice::CreateSphere( float radius, float tesselation )
+{
+    std::shared_ptr<Scene> scene = CreateScene();
+    std::stringstream ss;
+    // Create a white diffuse material for the sphere.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
+
+    // tess tesselation
+    ss << "tess " << tesselation << std::endl;
+    // s x y z radius
+    ss << "s 0 0 0 " << radius << std::endl;
+
+    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    {
+        return scene;
+    }
+
+    // An error occurred while loading the scene.
+    DestroyScene( scene );
+    return nullptr;
+}
+
+std::shared_ptr<Scene> RenderDevice::CreateCube( float size )
+{
+    std::shared_ptr<Scene> scene = CreateScene();
+    std::stringstream ss;
+
+    // Create a white diffuse material for the cube.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
+
+    // hex x y z size
+    ss << "hex 0 0 0 " << size;
+
+    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    {
+        return scene;
+    }
+
+    // An error occurred while loading the scene.
+    DestroyScene( scene );
+    return nullptr;
+}
+
+std::shared_ptr<Scene> RenderDevice::CreateCylinder( float baseRadius, float apexRadius, float height, const glm::vec3& axis )
+{
+    std::shared_ptr<Scene> scene = CreateScene();
+    std::stringstream ss;
+
+    // Create a white diffuse material for the cylinder.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
+
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 0 " << baseRadius << std::endl;
+
+    glm::vec3 apex = axis * height;
+    // apex.x apex.y apex.z apexRadius
+    ss << apex.x << " " << apex.y << " " << apex.z << " " << apexRadius << std::endl;
+
+    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    {
+        return scene;
+    }
+
+    // An error occurred while loading the scene.
+    DestroyScene( scene );
+    return nullptr;
+}
+
+std::shared_ptr <Scene> RenderDevice::CreateCone( float baseRadius, float height )
+{
+    // A cone is just a cylinder with a 0 size apex.
+    return CreateCylinder( baseRadius, 0, height );
+}
+
+std::shared_ptr<Scene> RenderDevice::CreateArrow( const glm::vec3& tail, const glm::vec3& head, float radius )
+{
+    std::shared_ptr<Scene> scene = CreateScene();
+    std::stringstream ss;
+
+    glm::vec3 dir = head - tail;
+    glm::vec3 apex = head + ( dir * 0.5f );
+
+    // Create a white diffuse material for the arrow.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 1 1 1 0 0 0 0" << std::endl;
+
+    // Create a cylinder for the arrow body.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << tail.x << " " << tail.y << " " << tail.z << " " << radius << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << head.x << " " << head.y << " " << head.z << " " << radius << std::endl;
+
+    // Create a cone for the arrow head.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << head.x << " " << head.y << " " << head.z << " " << radius * 2.0f << std::endl;
+
+    // apex.x apex.y apex.z apexRadius
+    ss << apex.x << " " << apex.y << " " << apex.z << " 0" << std::endl;
+
+    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    {
+        return scene;
+    }
+
+    // An error occurred while loading the scene.
+    DestroyScene( scene );
+    return nullptr;
+
+}
+
+std::shared_ptr<Scene> RenderDevice::CreateAxis( float radius, float length )
+{
+    std::shared_ptr<Scene> scene = CreateScene();
+    std::stringstream ss;
+
+    // Create a red material for the +X axis.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 0 0 1 0 0 0 0" << std::endl;
+
+    // Create a cylinder aligned to the +X axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 0 " << radius << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << length << " 0 0 " << radius << std::endl;
+
+    // Create a cone for the +X axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << length << " 0 0 " << radius * 2.0f << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << length * 1.5f << " 0 0 0" << std::endl;
+
+    // Create a green material for the +Y axis.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 0 1 0 1 0 0 0 0" << std::endl;
+
+    // Create a cylinder aligned to the +Y axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 0 " << radius << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << "0 " << length << " 0 " << radius << std::endl;
+
+    // Create a cone for the +Y axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 " << length << " 0 " << radius * 2.0f << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << "0 " << length * 1.5f << " 0 0" << std::endl;
+
+    // Create a blue material for the +Z axis.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 0 0 1 1 0 0 0 0" << std::endl;
+
+    // Create a cylinder aligned to the +Z axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 0 " << radius << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << "0 0 " << length << " " << radius << std::endl;
+
+    // Create a cone for the +Z axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 " << length << " " << radius * 2.0f << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << "0 0 " << length * 1.5f << " 0" << std::endl;
+
+    // Create a cyan material for the -X axis.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 0 1 1 1 0 0 0 0" << std::endl;
+
+    // Create a cylinder aligned to the -X axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 0 " << radius << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << -length << " 0 0 " << radius << std::endl;
+
+    // Create a cone for the -X axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << -length << " 0 0 " << radius * 2.0f << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << -length * 1.5f << " 0 0 0" << std::endl;
+
+    // Create a yellow material for the -Y axis.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 0 1 1 0 0 0 0" << std::endl;
+
+    // Create a cylinder aligned to the -Y axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 0 " << radius << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << "0 " << -length << " 0 " << radius << std::endl;
+
+    // Create a cone for the -Y axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 " << -length << " 0 0" << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << "0 " << -length * 1.5f << " 0 " << radius * 2.0f << std::endl;
+
+    // Create a magenta material for the -Z axis.
+    // f red green blue Kd Ks Shine transmittance indexOfRefraction
+    ss << "f 1 1 0 1 0 0 0 0" << std::endl;
+
+    // Create a cylinder aligned to the -Z axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 0 " << radius << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << "0 0 " << -length << " " << radius << std::endl;
+
+    // Create a cone for the -Z axis.
+    ss << "c" << std::endl;
+    // base.x base.y base.z baseRadius
+    ss << "0 0 " << -length << " " << radius * 2.0f << std::endl;
+    // apex.x apex.y apex.z apexRadius
+    ss << "0 0 " << -length * 1.5f << " 0" << std::endl;
+
+    if ( scene->LoadFromString( ss.str(), "nff" ) )
+    {
+        return scene;
+    }
+
+    // An error occurred while loading the scene.
+    DestroyScene( scene );
+    return nullptr;
+
+}
+
+ConstantBufferRing* RenderDevice::GetConstantBufferRing()
+{
+    return nullptr;
+}
+
+std::shared_ptr<CommandList> RenderDevice::CreateCommandList()
+{
+    return nullptr;
+}
+
+void RenderDevice::DestroyCommandList( std::shared_ptr<CommandList> commandList )
+{}
+
+ResourceStateTracker* RenderDevice::GetResourceStateTracker()
+{
+    return nullptr;
+}
+
+void RenderDevice::FlushResourceTransitions()
+{}
+
+const StateCacheStatistics* RenderDevice::GetStateCacheStatistics() const
+{
+    return nullptr;
+}
+
 void RenderDevice::OnLoadingProgress( ProgressEventArgs& e )
 {
     LoadingProgress( e );
@@ -0,0 +1,192 @@
+#include <EnginePCH.h>
+
+#include <Mesh.h>
+#include <Material.h>
+#include <PipelineState.h>
+
+#include <RenderQueue.h>
+
+// The number of bits of each field in the sort key.
+#define PIPELINE_BITS   8
+#define MATERIAL_BITS   16
+#define MESH_BITS       16
+#define LOD_BITS        2
+#define DEPTH_BITS      22
+
+RenderQueue::RenderQueue( SortOrder sortOrder )
+    : m_SortOrder( sortOrder )
+    , m_SortingEnabled( true )
+{}
+
+RenderQueue::~RenderQueue()
+{}
+
+RenderQueue::SortOrder RenderQueue::GetSortOrder() const
+{
+    return m_SortOrder;
+}
+
+void RenderQueue::SetSortingEnabled( bool enabled )
+{
+    m_SortingEnabled = enabled;
+}
+
+bool RenderQueue::IsSortingEnabled() const
+{
+    return m_SortingEnabled;
+}
+
+void RenderQueue::Clear()
+{
+    m_RenderItems.clear();
+    m_SortEntries.clear();
+    m_IDs.clear();
+}
+
+uint32_t RenderQueue::GetID( const void* pointer )
+{
+    // IDs are assigned in the order the objects are first seen.
+    // ID 0 is reserved for null pointers.
+    if ( !pointer ) return 0;
+
+    IDMap::iterator iter = m_IDs.find( pointer );
+    if ( iter == m_IDs.end() )
+    {
+        iter = m_IDs.insert( IDMap::value_type( pointer, static_cast<uint32_t>( m_IDs.size() + 1 ) ) ).first;
+    }
+
+    return iter->second;
+}
+
+uint64_t RenderQueue::MakeSortKey( uint32_t pipelineID, uint32_t materialID, uint32_t meshID, uint32_t lod, float viewDepth ) const
+{
+    // IDs that don't fit in the key wrap around. This does not
+    // affect the correctness of the sort, only the state grouping.
+    uint64_t pipeline = pipelineID & ( ( 1 << PIPELINE_BITS ) - 1 );
+    uint64_t material = materialID & ( ( 1 << MATERIAL_BITS ) - 1 );
+    // The level of detail is part of the mesh so that instances that use the same level of detail are grouped.
+    uint64_t mesh = ( ( meshID << LOD_BITS ) | std::min<uint32_t>( lod, ( 1 << LOD_BITS ) - 1 ) ) & ( ( 1 << ( MESH_BITS + LOD_BITS ) ) - 1 );
+
+    // The bit pattern of a positive IEEE float increases with its value
+    // so the upper bits can be used as a (logarithmically distributed) integer depth.
+    viewDepth = std::max( viewDepth, 0.0f );
+    uint32_t depthBits;
+    memcpy( &depthBits, &viewDepth, sizeof( float ) );
+    uint64_t depth = depthBits >> ( 32 - DEPTH_BITS );
+
+    uint64_t sortKey = 0;
+    switch ( m_SortOrder )
+    {
+    case SortOrder::FrontToBack:
+        sortKey = ( pipeline << ( MATERIAL_BITS + MESH_BITS + LOD_BITS + DEPTH_BITS ) ) |
+                  ( material << ( MESH_BITS + LOD_BITS + DEPTH_BITS ) ) |
+                  ( mesh << DEPTH_BITS ) |
+                  depth;
+        break;
+    case SortOrder::BackToFront:
+        // Invert the depth so that items that are further away are sorted first.
+        depth = ~depth & ( ( 1 << DEPTH_BITS ) - 1 );
+        sortKey = ( depth << ( PIPELINE_BITS + MATERIAL_BITS + MESH_BITS + LOD_BITS ) ) |
+                  ( pipeline << ( MATERIAL_BITS + MESH_BITS + LOD_BITS ) ) |
+                  ( material << ( MESH_BITS + LOD_BITS ) ) |
+                  mesh;
+        break;
+    }
+
+    return sortKey;
+}
+
+float RenderQueue::GetViewDepth( const Mesh& mesh, const glm::mat4& modelView )
+{
+    // The view depth of the center of the mesh (the camera looks down the -Z axis).
+    const BoundingBox& boundingBox = mesh.GetBoundingBox();
+    glm::vec3 center = boundingBox.IsValid() ? boundingBox.GetCenter() : glm::vec3( 0 );
+    return -( modelView * glm::vec4( center, 1 ) ).z;
+}
+
+void RenderQueue::Reserve( size_t numRenderItems )
+{
+    m_RenderItems.reserve( numRenderItems );
+    m_SortEntries.reserve( numRenderItems );
+}
+
+void RenderQueue::Push( PipelineState* pipeline, Mesh& mesh, const glm::mat4& modelViewProjection, const glm::mat4& modelView, uint32_t lod )
+{
+    RenderItem renderItem = { &mesh, modelViewProjection, modelView, lod };
+    Push( pipeline, renderItem, GetViewDepth( mesh, modelView ) );
+}
+
+void RenderQueue::Push( PipelineState* pipeline, const RenderItem& renderItem, float viewDepth )
+{
+    uint32_t pipelineID = GetID( pipeline );
+    uint32_t materialID = GetID( renderItem.Mesh->GetMaterial().get() );
+    uint32_t meshID = GetID( renderItem.Mesh );
+
+    SortEntry sortEntry = { MakeSortKey( pipelineID, materialID, meshID, renderItem.Lod, viewDepth ), static_cast<uint32_t>( m_RenderItems.size() ) };
+
+    m_RenderItems.push_back( renderItem );
+    m_SortEntries.push_back( sortEntry );
+}
+
+void RenderQueue::Sort()
+{
+    if ( m_SortingEnabled && m_SortEntries.size() > 1 )
+    {
+        RadixSort();
+    }
+}
+
+void RenderQueue::RadixSort()
+{
+    const size_t numEntries = m_SortEntries.size();
+    m_SortEntriesTemp.resize( numEntries );
+
+    SortEntry* src = m_SortEntries.data();
+    SortEntry* dst = m_SortEntriesTemp.data();
+
+    for ( uint32_t shift = 0; shift < 64; shift += 8 )
+    {
+        size_t histogram[256] = { 0 };
+        for ( size_t i = 0; i < numEntries; ++i )
+        {
+            ++histogram[( src[i].SortKey >> shift ) & 0xff];
+        }
+
+        // Skip this pass if all keys have the same value for this digit.
+        if ( histogram[( src[0].SortKey >> shift ) & 0xff] == numEntries ) continue;
+
+        // Convert the histogram to offsets (exclusive prefix sum).
+        size_t offset = 0;
+        for ( uint32_t i = 0; i < 256; ++i )
+        {
+            size_t count = histogram[i];
+            histogram[i] = offset;
+            offset += count;
+        }
+
+        // The scatter is stable so the order of the previous passes is preserved.
+        for ( size_t i = 0; i < numEntries; ++i )
+        {
+            dst[histogram[( src[i].SortKey >> shift ) & 0xff]++] = src[i];
+        }
+
+        std::swap( src, dst );
+    }
+
+    // Make sure the sorted entries end up in the sort entries array.
+    if ( src != m_SortEntries.data() )
+    {
+        m_SortEntries.swap( m_SortEntriesTemp );
+    }
+}
+
+size_t RenderQueue::GetSize() const
+{
+    return m_RenderItems.size();
+}
+
+const RenderQueue::RenderItem& RenderQueue::GetRenderItem( size_t index ) const
+{
+    assert( index < m_SortEntries.size() );
+    return m_RenderItems[m_SortEntries[index].Index];
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <SlotMap.h>
+
+#include <unordered_map>
+
+/**
+ * The resources of a render device of a single type.
+ * The resources are stored in a slot map so creating and destroying a resource is O(1)
+ * and resources can be identified by generational handles.
+ * The shared_ptr interface of the render device is kept: the handle of a resource
+ * is found from its address, so it can be destroyed without searching the registry.
+ * Destroying a resource that was already destroyed (or a stale handle) does nothing.
+ */
+template<typename T>
+class ResourceRegistry
+{
+public:
+    typedef std::shared_ptr<T> Pointer;
+
+    // Add a resource to the registry.
+    // If the resource was already added, its existing handle is returned.
+    ResourceHandle Add( Pointer resource );
+
+    // Returns false if the resource is not in the registry.
+    bool Remove( const Pointer& resource );
+    // Returns false if the handle is stale.
+    bool Remove( ResourceHandle handle );
+
+    // Returns nullptr if the handle is stale.
+    Pointer Get( ResourceHandle handle ) const;
+    // Returns an invalid handle if the resource is not in the registry.
+    ResourceHandle GetHandle( const Pointer& resource ) const;
+
+    // The number of resources in the registry.
+    size_t GetSize() const;
+
+    // Release all of the resources. All existing handles become stale.
+    void Clear();
+
+private:
+    typedef std::unordered_map<const T*, ResourceHandle> HandleMap;
+
+    SlotMap<Pointer> m_Resources;
+    HandleMap m_Handles;
+};
+
+template<typename T>
+ResourceHandle ResourceRegistry<T>::Add( Pointer resource )
+{
+    if ( !resource ) return ResourceHandle();
+
+    typename HandleMap::iterator iter = m_Handles.find( resource.get() );
+    if ( iter != m_Handles.end() )
+    {
+        return iter->second;
+    }
+
+    const T* key = resource.get();
+    ResourceHandle handle = m_Resources.Insert( std::move( resource ) );
+    m_Handles.insert( typename HandleMap::value_type( key, handle ) );
+
+    return handle;
+}
+
+template<typename T>
+bool ResourceRegistry<T>::Remove( const Pointer& resource )
+{
+    typename HandleMap::iterator iter = m_Handles.find( resource.get() );
+    if ( iter == m_Handles.end() ) return false;
+
+    ResourceHandle handle = iter->second;
+    // The address of the resource can be reused as soon as it is released by the slot map.
+    m_Handles.erase( iter );
+    m_Resources.Remove( handle );
+
+    return true;
+}
+
+template<typename T>
+bool ResourceRegistry<T>::Remove( ResourceHandle handle )
+{
+    const Pointer* resource = m_Resources.Get( handle );
+    if ( !resource ) return false;
+
+    m_Handles.erase( resource->get() );
+    m_Resources.Remove( handle );
+
+    return true;
+}
+
+template<typename T>
+typename ResourceRegistry<T>::Pointer ResourceRegistry<T>::Get( ResourceHandle handle ) const
+{
+    const Pointer* resource = m_Resources.Get( handle );
+    return resource ? *resource : nullptr;
+}
+
+template<typename T>
+ResourceHandle ResourceRegistry<T>::GetHandle( const Pointer& resource ) const
+{
+    typename HandleMap::const_iterator iter = m_Handles.find( resource.get() );
+    return ( iter != m_Handles.end() ) ? iter->second : ResourceHandle();
+}
+
+template<typename T>
+size_t ResourceRegistry<T>::GetSize() const
+{
+    return m_Resources.GetSize();
+}
+
+template<typename T>
+void ResourceRegistry<T>::Clear()
+{
+    m_Handles.clear();
+    m_Resources.Clear();
+}
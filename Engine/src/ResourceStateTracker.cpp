@@ -0,0 +1,178 @@
+#include <EnginePCH.h>
+
+#include <ResourceStateTracker.h>
+
+static const uint32_t READ_STATES = (uint32_t)ResourceState::VertexBuffer | (uint32_t)ResourceState::IndexBuffer |
+                                    (uint32_t)ResourceState::ConstantBuffer | (uint32_t)ResourceState::ShaderResource |
+                                    (uint32_t)ResourceState::CopySource | (uint32_t)ResourceState::DepthRead;
+
+static bool IsReadState( ResourceState state )
+{
+    return state != ResourceState::Common && ( (uint32_t)state & ~READ_STATES ) == 0;
+}
+
+static bool IsWriteState( ResourceState state )
+{
+    return state == ResourceState::RenderTarget || state == ResourceState::UnorderedAccess ||
+           state == ResourceState::DepthWrite || state == ResourceState::CopyDest;
+}
+
+ResourceStateTracker::ResourceStateTracker()
+    : m_NumSkippedTransitions( 0 )
+    , m_NumTransitions( 0 )
+{}
+
+ResourceStateTracker::~ResourceStateTracker()
+{}
+
+void ResourceStateTracker::SetState( const void* resource, ResourceState state )
+{
+    m_States[resource] = state;
+}
+
+ResourceState ResourceStateTracker::GetState( const void* resource ) const
+{
+    StateMap::const_iterator iter = m_States.find( resource );
+    return iter != m_States.end() ? iter->second : ResourceState::Common;
+}
+
+void ResourceStateTracker::RemoveResource( const void* resource )
+{
+    m_States.erase( resource );
+}
+
+void ResourceStateTracker::Clear()
+{
+    m_States.clear();
+    m_Accesses.clear();
+    m_AccessIndices.clear();
+    m_Transitions.clear();
+}
+
+void ResourceStateTracker::Read( const void* resource, ResourceState state )
+{
+    if ( !IsReadState( state ) )
+    {
+        ReportError( "A resource can only be read in a read state." );
+    }
+
+    AccessMap::iterator iter = m_AccessIndices.find( resource );
+    if ( iter == m_AccessIndices.end() )
+    {
+        m_AccessIndices.insert( AccessMap::value_type( resource, m_Accesses.size() ) );
+        Access access = { resource, state, false };
+        m_Accesses.push_back( access );
+    }
+    else
+    {
+        Access& access = m_Accesses[iter->second];
+        if ( access.Write )
+        {
+            ReportError( "A resource can't be read and written by the same pass." );
+        }
+        access.State = (ResourceState)( (uint32_t)access.State | (uint32_t)state );
+    }
+}
+
+void ResourceStateTracker::Write( const void* resource, ResourceState state )
+{
+    if ( !IsWriteState( state ) )
+    {
+        ReportError( "A resource can only be written in a single write state." );
+    }
+
+    AccessMap::iterator iter = m_AccessIndices.find( resource );
+    if ( iter == m_AccessIndices.end() )
+    {
+        m_AccessIndices.insert( AccessMap::value_type( resource, m_Accesses.size() ) );
+        Access access = { resource, state, true };
+        m_Accesses.push_back( access );
+    }
+    else
+    {
+        const Access& access = m_Accesses[iter->second];
+        if ( !access.Write || access.State != state )
+        {
+            ReportError( "A resource can only be written in a single state by a pass and it can't also be read." );
+        }
+    }
+}
+
+const ResourceStateTracker::TransitionList& ResourceStateTracker::Flush()
+{
+    m_Transitions.clear();
+
+    for ( const Access& access : m_Accesses )
+    {
+        ResourceState& currentState = m_States[access.Resource];
+
+        Transition transition = { access.Resource, currentState, access.State };
+
+        if ( access.Write )
+        {
+            if ( currentState != access.State )
+            {
+                m_Transitions.push_back( transition );
+                currentState = access.State;
+            }
+            else if ( access.State == ResourceState::UnorderedAccess )
+            {
+                m_Transitions.push_back( transition );
+            }
+            else
+            {
+                ++m_NumSkippedTransitions;
+            }
+        }
+        else
+        {
+            if ( IsReadState( currentState ) )
+            {
+                // Keep the read states the resource is already in.
+                ResourceState combinedState = (ResourceState)( (uint32_t)currentState | (uint32_t)access.State );
+                if ( combinedState != currentState )
+                {
+                    transition.StateAfter = combinedState;
+                    m_Transitions.push_back( transition );
+                    currentState = combinedState;
+                }
+                else
+                {
+                    ++m_NumSkippedTransitions;
+                }
+            }
+            else
+            {
+                m_Transitions.push_back( transition );
+                currentState = access.State;
+            }
+        }
+    }
+
+    m_NumTransitions += m_Transitions.size();
+
+    m_Accesses.clear();
+    m_AccessIndices.clear();
+
+    return m_Transitions;
+}
+
+bool ResourceStateTracker::IsDeclared( const void* resource ) const
+{
+    return m_AccessIndices.find( resource ) != m_AccessIndices.end();
+}
+
+size_t ResourceStateTracker::GetNumResources() const
+{
+    return m_States.size();
+}
+
+uint64_t ResourceStateTracker::GetNumSkippedTransitions() const
+{
+    return m_NumSkippedTransitions;
+}
+
+uint64_t ResourceStateTracker::GetNumTransitions() const
+{
+    return m_NumTransitions;
+}
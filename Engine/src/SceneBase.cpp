@@ -1,5 +1,9 @@
 #include <EnginePCH.h>
+#include <Application.h>
 #include <Timer.h>
+#include <HighResolutionTimer.h>
+#include <AssetCache.h>
+#include <ContentHash.h>
 
 #include <assimp/importerdesc.h>
 
@@ -9,11 +13,19 @@
 #include <BufferBinding.h>
 #include <SceneNode.h>
 #include <Visitor.h>
+#include <Camera.h>
 
+#include "VertexQuantization.h"
 #include "SceneBase.h"
 
-#define EXPORT_FORMAT "assbin"
-#define EXPORT_EXTENSION "assbin"
+// The file extension of the native scene cache.
+#define CACHE_EXTENSION "scenecache"
+
+// The maximum number of triangles a single occluder mesh may have.
+// Meshes with more triangles are too expensive to rasterize on the CPU.
+static const uint32_t MAX_OCCLUDER_TRIANGLES = 8192;
+// The maximum number of occluder triangles for the entire scene.
+static const uint32_t MAX_SCENE_OCCLUDER_TRIANGLES = 32768;
 
 // A private class that is registered with Assimp's importer
 // Provides feedback on the loading progress of the scene files.
@@ -41,9 +53,62 @@ private:
     std::wstring m_FileName;
 };
 
+// Estimates the on-screen size of the meshes whose materials are waiting for streamed textures.
+// The size is the projected radius of the bounding sphere of the mesh relative to the height of the screen.
+class StreamingPriorityVisitor : public Visitor
+{
+public:
+    typedef std::map<const Material*, float> MaterialSizeMap;
+
+    StreamingPriorityVisitor( const Camera& camera, MaterialSizeMap& materialSizes )
+        : m_ViewMatrix( camera.GetViewMatrix() )
+        , m_ProjectionMatrix( camera.GetProjectionMatrix() )
+        , m_MaterialSizes( materialSizes )
+    {}
+
+    virtual void Visit( Scene& scene )
+    {}
+
+    virtual void Visit( SceneNode& node )
+    {
+        m_ModelViewMatrix = m_ViewMatrix * node.GetWorldTransfom();
+    }
+
+    virtual void Visit( Mesh& mesh )
+    {
+        MaterialSizeMap::iterator iter = m_MaterialSizes.find( mesh.GetMaterial().get() );
+        const BoundingBox& boundingBox = mesh.GetBoundingBox();
+        if ( iter == m_MaterialSizes.end() || !boundingBox.IsValid() ) return;
+
+        // The bounding sphere of the mesh in view space.
+        glm::vec3 center = glm::vec3( m_ModelViewMatrix * glm::vec4( boundingBox.GetCenter(), 1 ) );
+        float scale = glm::sqrt( glm::max( glm::length2( glm::vec3( m_ModelViewMatrix[0] ) ), glm::max( glm::length2( glm::vec3( m_ModelViewMatrix[1] ) ), glm::length2( glm::vec3( m_ModelViewMatrix[2] ) ) ) ) );
+        float radius = glm::length( boundingBox.GetExtents() ) * scale;
+
+        // Skip meshes that are behind the camera or outside of the view frustum.
+        // The camera looks down the -Z axis.
+        float depth = -center.z;
+        if ( depth + radius < 0.0f ) return;
+        if ( glm::abs( center.x ) - radius > depth / m_ProjectionMatrix[0][0] ||
+             glm::abs( center.y ) - radius > depth / m_ProjectionMatrix[1][1] ) return;
+
+        // Meshes that are closer than their radius cover the entire screen.
+        float size = radius / glm::max( depth, radius ) * m_ProjectionMatrix[1][1];
+        iter->second = glm::max( iter->second, size );
+    }
+
+private:
+    glm::mat4 m_ViewMatrix;
+    glm::mat4 m_ProjectionMatrix;
+    glm::mat4 m_ModelViewMatrix;
+    MaterialSizeMap& m_MaterialSizes;
+};
+
 SceneBase::SceneBase()
     : base()
     , m_pRootNode( nullptr )
+    , m_bStreamTextures( false )
+    , m_bQuantizeVertices( false )
     , m_bFileChanged( false )
 {
     m_Connections.push_back( m_DependencyTracker.FileChanged += boost::bind( &SceneBase::OnFileChanged, this, _1 ) );
@@ -60,8 +125,8 @@ bool SceneBase::LoadFromString( const std::string& sceneStr, const std::string&
 
     importer.SetProgressHandler( new ProgressHandler( *this, L"String" ) );
 
-    importer.SetPropertyFloat( AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, 80.0f );
-    importer.SetPropertyInteger( AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_POINT | aiPrimitiveType_LINE );
+    importer.SetPropertyFloat( AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, IMPORT_SMOOTHING_ANGLE );
+    importer.SetPropertyInteger( AI_CONFIG_PP_SBP_REMOVE, IMPORT_REMOVE_PRIMITIVES );
 
     unsigned int preprocessFlags = aiProcessPreset_TargetRealtime_MaxQuality;
 
@@ -72,37 +137,28 @@ bool SceneBase::LoadFromString( const std::string& sceneStr, const std::string&
         ReportError( importer.GetErrorString() );
         return false;
     }
-    else
-    {
-        // If we have a previously loaded scene, delete it.
-        if ( m_pRootNode )
-        {
-            m_pRootNode.reset();
-        }
-
-        // Import scene materials.
-        for ( unsigned int i = 0; i < scene->mNumMaterials; ++i )
-        {
-            ImportMaterial( *scene->mMaterials[i], fs::current_path() );
-        }
-        // Import meshes
-        for ( unsigned int i = 0; i < scene->mNumMeshes; ++i )
-        {
-            ImportMesh( *scene->mMeshes[i] );
-        }
 
-        m_pRootNode = ImportSceneNode( m_pRootNode, scene->mRootNode );
+    // Convert the scene to the native format (but don't store it on disk).
+    SceneCache sceneCache;
+    if ( !sceneCache.Build( *scene ) )
+    {
+        ReportError( "Failed to convert scene." );
+        return false;
     }
 
+    ImportScene( sceneCache, fs::current_path(), false, false );
+
     return true;
 }
 
-bool SceneBase::LoadFromFile( const std::wstring& fileName )
+bool SceneBase::LoadFromFile( const std::wstring& fileName, bool streamTextures, bool quantizeVertices )
 {
     fs::path filePath( fileName );
     fs::path parentPath;
 
     m_SceneFile = fileName;
+    m_bStreamTextures = streamTextures;
+    m_bQuantizeVertices = quantizeVertices;
 
     // Setup the dependency tracker.
     m_DependencyTracker = DependencyTracker( m_SceneFile );
@@ -121,370 +177,542 @@ bool SceneBase::LoadFromFile( const std::wstring& fileName )
         parentPath = fs::current_path();
     }
 
-    const aiScene* scene;
-    Assimp::Importer importer;
+    HighResolutionTimer loadTimer;
+    SceneCache sceneCache;
+    bool loadedFromCache = false;
+
+    // The imported scene is stored in the asset cache. Its key is the hash of the contents
+    // of the scene file and its dependencies (for example, material libraries) and the import settings.
+    AssetCache& assetCache = Application::Get().GetAssetCache();
+    std::vector<std::wstring> sourceFiles = m_DependencyTracker.GetDependencies();
+    std::vector<AssetCache::Key> sourceHashes;
+    assetCache.HashFiles( sourceFiles, sourceHashes );
 
-    importer.SetProgressHandler( new ProgressHandler( *this, fileName ) );
+    ContentHash cacheKey;
+    const float smoothingAngle = IMPORT_SMOOTHING_ANGLE;
+    const uint32_t removePrimitives = IMPORT_REMOVE_PRIMITIVES;
+    const uint32_t preprocessFlags = IMPORT_PREPROCESS_FLAGS;
+    cacheKey.Update( &smoothingAngle, sizeof( smoothingAngle ) );
+    cacheKey.Update( &removePrimitives, sizeof( removePrimitives ) );
+    cacheKey.Update( &preprocessFlags, sizeof( preprocessFlags ) );
+    cacheKey.Update( sourceHashes.data(), sourceHashes.size() * sizeof( AssetCache::Key ) );
 
-    fs::path exportPath = filePath;
-    exportPath.replace_extension( EXPORT_EXTENSION );
+    std::wstring cacheFileName = assetCache.GetCachedFileName( cacheKey.GetHash(), CACHE_EXTENSION );
 
-    // Force the last load time to be that of the exported scene file. This will ensure that if the original scene file 
-    // or any of its dependencies have been modified, the scene will be re-imported.
-    m_DependencyTracker.SetLastLoadTime( ( fs::exists( exportPath ) && fs::is_regular_file( exportPath ) ) ? fs::last_write_time( exportPath ) : 0 );
+    loadTimer.Tick();
+    double hashTime = loadTimer.ElapsedMilliSeconds();
 
-    if ( fs::exists( exportPath ) && fs::is_regular_file( exportPath ) && !m_DependencyTracker.IsStale()  )
+    if ( assetCache.Contains( cacheKey.GetHash(), CACHE_EXTENSION ) )
     {
-        // If a previously exported file exists, load that instead (scene has already been preprocessed).
-        scene = importer.ReadFile( exportPath.string(), 0 );
+        // If the scene has already been imported, map it into memory.
+        // If the cache is invalid (for example, it was written by an older version) the scene is re-imported.
+        loadedFromCache = sceneCache.Load( cacheFileName );
     }
-    else
+
+    if ( !loadedFromCache )
     {
-        // If no serialized version of the model file exists (or the original model is newer than the serialized version),
-        // reimport the original scene and export it as binary.
-        importer.SetPropertyFloat( AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, 80.0f );
-        importer.SetPropertyInteger( AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_POINT | aiPrimitiveType_LINE );
+        // If the scene (with these import settings) is not in the asset cache,
+        // import the original scene and store it in the native format.
+        Assimp::Importer importer;
 
-        unsigned int preprocessFlags = aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_OptimizeGraph;
-        scene = importer.ReadFile( filePath.string(), preprocessFlags );
+        importer.SetProgressHandler( new ProgressHandler( *this, fileName ) );
+        importer.SetPropertyFloat( AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, smoothingAngle );
+        importer.SetPropertyInteger( AI_CONFIG_PP_SBP_REMOVE, removePrimitives );
 
-        // Update the last load time for the dependency tracker.
-        m_DependencyTracker.SetLastLoadTime();
+        const aiScene* scene = importer.ReadFile( filePath.string(), preprocessFlags );
 
-        if ( scene )
+        if ( !scene )
         {
-            // Now export the preprocessed scene so we can load it faster next time.
-            Assimp::Exporter exporter;
-            exporter.Export( scene, EXPORT_FORMAT, exportPath.string(), preprocessFlags );
+            ReportError( importer.GetErrorString() );
+            return false;
         }
+
+        if ( !sceneCache.Build( *scene ) )
+        {
+            ReportError( "Failed to convert scene file " + filePath.string() );
+            return false;
+        }
+
+        // Now save the preprocessed scene so we can load it faster next time.
+        sceneCache.Save( cacheFileName );
     }
 
-    if ( !scene )
+    // Reload the scene if the scene file or one of its dependencies is modified after this point.
+    m_DependencyTracker.SetLastLoadTime();
+
+    // If we have a previously loaded scene, save the root node's
+    // local transform so it can be restored on reload.
+    glm::mat4 localTransform = m_pRootNode ? m_pRootNode->GetLocalTransform() : glm::mat4( 1 );
+
+    ImportScene( sceneCache, parentPath, streamTextures, quantizeVertices );
+
+    if ( m_pRootNode )
     {
-        ReportError( importer.GetErrorString() );
-        return false;
+        m_pRootNode->SetLocalTransform( localTransform );
     }
-    else
-    {
-        // If we have a previously loaded scene, delete it.
-        glm::mat4 localTransform( 1 );
-        if ( m_pRootNode )
+
+    loadTimer.Tick();
+
+    std::stringstream ss;
+    ss << ( loadedFromCache ? "Loaded scene cache " : "Imported scene " ) << filePath.filename().string() << " in " << hashTime + loadTimer.ElapsedMilliSeconds() << " ms ("
+        << hashTime << " ms to hash " << sourceFiles.size() << " source files)" << std::endl;
+    OutputDebugStringA( ss.str().c_str() );
+
+    return true;
+}
+
+void SceneBase::ImportScene( const SceneCache& sceneCache, fs::path parentPath, bool streamTextures, bool quantizeVertices )
+{
+    const SceneCache::Header& header = sceneCache.GetHeader();
+    HighResolutionTimer timer;
+
+    // Delete the previously loaded assets.
+    m_pRootNode.reset();
+    m_MaterialMap.clear();
+    m_Materials.clear();
+    m_Meshes.clear();
+    m_StreamedTextures.clear();
+    CancelStreaming();
+
+    // Load the textures of all materials at once so they can be decoded in parallel.
+    std::vector<std::wstring> textureFileNames;
+    std::vector<TextureUsage> textureUsages;
+    for ( uint32_t i = 0; i < header.NumMaterials; ++i )
+    {
+        const SceneCache::MaterialRecord& material = sceneCache.GetMaterial( i );
+        for ( uint32_t slot = 0; slot < SceneCache::NumTextureSlots; ++slot )
         {
-            // Save the root nodes local transform
-            // so it can be restored on reload.
-            localTransform = m_pRootNode->GetLocalTransform();
-            m_pRootNode.reset();
+            const char* textureFileName = sceneCache.GetString( material.Textures[slot] );
+            if ( textureFileName )
+            {
+                textureFileNames.push_back( ( parentPath / fs::path( textureFileName ) ).wstring() );
+                textureUsages.push_back( GetTextureUsage( slot ) );
+            }
         }
-        // Delete the previously loaded assets.
-        m_MaterialMap.clear();
-        m_Materials.clear();
-        m_Meshes.clear();
+    }
 
-        // Import scene materials.
-        for ( unsigned int i = 0; i < scene->mNumMaterials; ++i )
+    TextureMap textures;
+    if ( !streamTextures )
+    {
+        std::vector< std::shared_ptr<Texture> > textureList;
+        CreateTextures( textureFileNames, textureUsages, textureList );
+
+        for ( size_t i = 0; i < textureFileNames.size(); ++i )
         {
-            ImportMaterial( *scene->mMaterials[i], parentPath );
+            textures[textureFileNames[i]] = textureList[i];
         }
-        // Import meshes
-        for ( unsigned int i = 0; i < scene->mNumMeshes; ++i )
+    }
+
+    timer.Tick();
+    double texturesTime = timer.ElapsedMilliSeconds();
+
+    // Import scene materials.
+    for ( uint32_t i = 0; i < header.NumMaterials; ++i )
+    {
+        ImportMaterial( sceneCache, sceneCache.GetMaterial( i ), parentPath, textures );
+    }
+    // Import meshes
+    for ( uint32_t i = 0; i < header.NumMeshes; ++i )
+    {
+        ImportMesh( sceneCache, sceneCache.GetMesh( i ), quantizeVertices );
+    }
+
+    if ( quantizeVertices )
+    {
+        // Compare the size of the vertex data and the number of bytes the vertex shader has to fetch per vertex.
+        // The float streams that are fetched are the ones used by the shaders: position, tangent, binormal, normal and the first texture coordinate set.
+        uint64_t floatBytes = 0, floatFetchBytes = 0, numVertices = 0;
+        uint32_t numFloatBuffers = 0;
+        for ( uint32_t i = 0; i < header.NumMeshes; ++i )
         {
-            ImportMesh( *scene->mMeshes[i] );
+            const SceneCache::MeshRecord& mesh = sceneCache.GetMesh( i );
+            for ( uint32_t j = 0; j < mesh.NumStreams; ++j )
+            {
+                const SceneCache::StreamRecord& stream = sceneCache.GetStream( mesh.FirstStream + j );
+                uint64_t streamBytes = (uint64_t)stream.Stride * mesh.NumVertices;
+
+                floatBytes += streamBytes;
+                ++numFloatBuffers;
+                if ( stream.Type != SceneCache::Semantic::Color && ( stream.Type != SceneCache::Semantic::TexCoord || stream.SemanticIndex == 0 ) )
+                {
+                    floatFetchBytes += streamBytes;
+                }
+            }
+            numVertices += mesh.NumVertices;
         }
+        uint64_t quantizedBytes = numVertices * sizeof( QuantizedVertex );
 
-        m_pRootNode = ImportSceneNode( m_pRootNode, scene->mRootNode );
-        m_pRootNode->SetLocalTransform( localTransform );
+        std::stringstream ss;
+        ss << "Quantized vertices: " << numVertices << " vertices, " << floatBytes / 1024 << " KB in " << numFloatBuffers << " float vertex buffers -> "
+            << quantizedBytes / 1024 << " KB in " << header.NumMeshes << " interleaved vertex buffers (" << ( 100.0 * quantizedBytes ) / glm::max<uint64_t>( floatBytes, 1 ) << "%). "
+            << "Fetched per vertex: " << (double)floatFetchBytes / glm::max<uint64_t>( numVertices, 1 ) << " -> " << sizeof( QuantizedVertex ) << " bytes" << std::endl;
+        OutputDebugStringA( ss.str().c_str() );
     }
 
-    return true;
-}
+    if ( streamTextures )
+    {
+        // Until the textures can be prioritized by their on-screen size (see UpdateStreaming),
+        // textures that are used by larger meshes are loaded first.
+        std::vector<float> materialSizes( header.NumMaterials, 0.0f );
+        for ( uint32_t i = 0; i < header.NumMeshes; ++i )
+        {
+            const SceneCache::MeshRecord& mesh = sceneCache.GetMesh( i );
+            materialSizes[mesh.MaterialIndex] = glm::max( materialSizes[mesh.MaterialIndex], glm::length( mesh.BoundsMax - mesh.BoundsMin ) );
+        }
 
-void SceneBase::ImportMaterial( const aiMaterial& material, fs::path parentPath )
-{
-    aiString materialName;
-    aiString aiTexturePath;
-    aiTextureOp aiBlendOperation;
-    float blendFactor;
-    aiColor4D diffuseColor;
-    aiColor4D specularColor;
-    aiColor4D ambientColor;
-    aiColor4D emissiveColor;
-    float opacity;
-    float indexOfRefraction;
-    float reflectivity;
-    float shininess;
-    float bumpIntensity;
-
-    //if ( material.Get( AI_MATKEY_NAME, materialName ) == aiReturn_SUCCESS )
-    //{
-    //    MaterialMap::iterator itr = m_MaterialMap.find( materialName.C_Str() );
-    //    if ( itr != m_MaterialMap.end() )
-    //    {
-    //        // A material with this name already exists in our materials array.
-    //        // Skip it.
-    //        return;
-    //    }
-    //}
+        std::shared_ptr<Texture> pPlaceholderTexture = GetDefaultTexture();
+        TexturePriorityMap priorities;
+        TextureUsageMap usages;
 
-    std::shared_ptr<Material> pMaterial = CreateMaterial();
+        for ( uint32_t i = 0; i < header.NumMaterials; ++i )
+        {
+            const SceneCache::MaterialRecord& material = sceneCache.GetMaterial( i );
+            for ( uint32_t slot = 0; slot < SceneCache::NumTextureSlots; ++slot )
+            {
+                const char* textureFileName = sceneCache.GetString( material.Textures[slot] );
+                if ( !textureFileName ) continue;
 
-    if ( material.Get( AI_MATKEY_COLOR_AMBIENT, ambientColor ) == aiReturn_SUCCESS )
-    {
-        pMaterial->SetAmbientColor( glm::vec4( ambientColor.r, ambientColor.g, ambientColor.b, ambientColor.a ) );
+                // The placeholder is not sampled by the shaders. It only makes sure the slot
+                // is not left bound to a texture of a previously rendered material.
+                // The type of the texture in the height map slot is not known until it is loaded.
+                Material::TextureType textureType = ( slot == SceneCache::HeightMapSlot ) ? Material::TextureType::Normal : static_cast<Material::TextureType>( slot );
+                m_Materials[i]->SetPlaceholderTexture( textureType, pPlaceholderTexture );
+
+                StreamedTexture streamedTexture = { m_Materials[i], slot, ( parentPath / fs::path( textureFileName ) ).wstring() };
+                m_StreamedTextures.push_back( streamedTexture );
+
+                float& priority = priorities[streamedTexture.FileName];
+                priority = glm::max( priority, materialSizes[i] );
+                usages[streamedTexture.FileName] = GetTextureUsage( slot );
+            }
+        }
+
+        StreamTextures( priorities, usages );
     }
-    if ( material.Get( AI_MATKEY_COLOR_EMISSIVE, emissiveColor ) == aiReturn_SUCCESS )
+
+    timer.Tick();
+    double meshesTime = timer.ElapsedMilliSeconds();
+
+    // Choose the meshes that are used for software occlusion culling.
+    SelectOccluders( sceneCache );
+
+    // Import the scene nodes.
+    // Parent nodes are always stored before their children.
+    std::vector< std::shared_ptr<SceneNode> > nodes( header.NumNodes );
+    for ( uint32_t i = 0; i < header.NumNodes; ++i )
     {
-        pMaterial->SetEmissiveColor( glm::vec4( emissiveColor.r, emissiveColor.g, emissiveColor.b, emissiveColor.a ) );
+        const SceneCache::NodeRecord& node = sceneCache.GetNode( i );
+        std::shared_ptr<SceneNode> pParent = ( node.Parent >= 0 ) ? nodes[node.Parent] : nullptr;
+
+        nodes[i] = ImportSceneNode( pParent, sceneCache, node );
+
+        if ( pParent )
+        {
+            pParent->AddChild( nodes[i] );
+        }
     }
-    if ( material.Get( AI_MATKEY_COLOR_DIFFUSE, diffuseColor ) == aiReturn_SUCCESS )
+
+    if ( !nodes.empty() )
     {
-        pMaterial->SetDiffuseColor( glm::vec4( diffuseColor.r, diffuseColor.g, diffuseColor.b, diffuseColor.a ) );
+        m_pRootNode = nodes[0];
     }
-    if ( material.Get( AI_MATKEY_COLOR_SPECULAR, specularColor ) == aiReturn_SUCCESS )
+
+    timer.Tick();
+    double nodesTime = timer.ElapsedMilliSeconds();
+
+    std::stringstream ss;
+    ss << "Scene import: " << texturesTime << " ms textures, " << meshesTime << " ms materials and meshes, " << nodesTime << " ms occluders and nodes" << std::endl;
+    OutputDebugStringA( ss.str().c_str() );
+}
+
+void SceneBase::ImportMaterial( const SceneCache& sceneCache, const SceneCache::MaterialRecord& material, fs::path parentPath, const TextureMap& textures )
+{
+    std::shared_ptr<Material> pMaterial = CreateMaterial();
+
+    if ( material.Properties & SceneCache::AmbientColor )
     {
-        pMaterial->SetSpecularColor( glm::vec4( specularColor.r, specularColor.g, specularColor.b, specularColor.a ) );
+        pMaterial->SetAmbientColor( material.AmbientColor );
     }
-    if ( material.Get( AI_MATKEY_SHININESS, shininess ) == aiReturn_SUCCESS )
+    if ( material.Properties & SceneCache::EmissiveColor )
     {
-        pMaterial->SetSpecularPower( shininess );
+        pMaterial->SetEmissiveColor( material.EmissiveColor );
     }
-    if ( material.Get( AI_MATKEY_OPACITY, opacity ) == aiReturn_SUCCESS )
+    if ( material.Properties & SceneCache::DiffuseColor )
     {
-        pMaterial->SetOpacity( opacity );
+        pMaterial->SetDiffuseColor( material.DiffuseColor );
     }
-    if ( material.Get( AI_MATKEY_REFRACTI, indexOfRefraction ) )
+    if ( material.Properties & SceneCache::SpecularColor )
     {
-        pMaterial->SetIndexOfRefraction( indexOfRefraction );
+        pMaterial->SetSpecularColor( material.SpecularColor );
     }
-    if ( material.Get( AI_MATKEY_REFLECTIVITY, reflectivity ) == aiReturn_SUCCESS )
+    if ( material.Properties & SceneCache::SpecularPower )
     {
-        pMaterial->SetReflectance( glm::float4( reflectivity ) );
+        pMaterial->SetSpecularPower( material.SpecularPower );
     }
-    if ( material.Get( AI_MATKEY_BUMPSCALING, bumpIntensity ) == aiReturn_SUCCESS )
+    if ( material.Properties & SceneCache::Opacity )
     {
-        pMaterial->SetBumpIntensity( bumpIntensity );
+        pMaterial->SetOpacity( material.Opacity );
     }
-
-    // Load ambient textures.
-    if ( material.GetTextureCount( aiTextureType_AMBIENT ) > 0 &&
-         material.GetTexture( aiTextureType_AMBIENT, 0, &aiTexturePath, nullptr, nullptr, &blendFactor, &aiBlendOperation ) == aiReturn_SUCCESS )
+    if ( material.Properties & SceneCache::IndexOfRefraction )
     {
-        fs::path texturePath( aiTexturePath.C_Str() );
-        std::shared_ptr<Texture> pTexture = CreateTexture( ( parentPath / texturePath ).wstring() );
-        pMaterial->SetTexture( Material::TextureType::Ambient, pTexture );
+        pMaterial->SetIndexOfRefraction( material.IndexOfRefraction );
     }
-
-    // Load emissive textures.
-    if ( material.GetTextureCount( aiTextureType_EMISSIVE ) > 0 &&
-         material.GetTexture( aiTextureType_EMISSIVE, 0, &aiTexturePath, nullptr, nullptr, &blendFactor, &aiBlendOperation ) == aiReturn_SUCCESS )
+    if ( material.Properties & SceneCache::Reflectivity )
     {
-        fs::path texturePath( aiTexturePath.C_Str() );
-        std::shared_ptr<Texture> pTexture = CreateTexture( ( parentPath / texturePath ).wstring() );
-        pMaterial->SetTexture( Material::TextureType::Emissive, pTexture );
+        pMaterial->SetReflectance( glm::float4( material.Reflectivity ) );
     }
-
-    // Load diffuse textures.
-    if ( material.GetTextureCount( aiTextureType_DIFFUSE ) > 0 &&
-         material.GetTexture( aiTextureType_DIFFUSE, 0, &aiTexturePath, nullptr, nullptr, &blendFactor, &aiBlendOperation ) == aiReturn_SUCCESS )
+    if ( material.Properties & SceneCache::BumpIntensity )
     {
-        fs::path texturePath( aiTexturePath.C_Str() );
-        std::shared_ptr<Texture> pTexture = CreateTexture( ( parentPath / texturePath ).wstring() );
-        pMaterial->SetTexture( Material::TextureType::Diffuse, pTexture );
+        pMaterial->SetBumpIntensity( material.BumpIntensity );
     }
 
-    // Load specular texture.
-    if ( material.GetTextureCount( aiTextureType_SPECULAR ) > 0 &&
-         material.GetTexture( aiTextureType_SPECULAR, 0, &aiTexturePath, nullptr, nullptr, &blendFactor, &aiBlendOperation ) == aiReturn_SUCCESS )
+    // Load the textures.
+    for ( uint32_t slot = 0; slot < SceneCache::NumTextureSlots; ++slot )
     {
-        fs::path texturePath( aiTexturePath.C_Str() );
-        std::shared_ptr<Texture> pTexture = CreateTexture( ( parentPath / texturePath ).wstring() );
-        pMaterial->SetTexture( Material::TextureType::Specular, pTexture );
-    }
+        const char* textureFileName = sceneCache.GetString( material.Textures[slot] );
+        if ( !textureFileName ) continue;
 
+        fs::path texturePath( textureFileName );
+        TextureMap::const_iterator iter = textures.find( ( parentPath / texturePath ).wstring() );
+        if ( iter == textures.end() ) continue;
 
-    // Load specular power texture.
-    if ( material.GetTextureCount( aiTextureType_SHININESS ) > 0 &&
-         material.GetTexture( aiTextureType_SHININESS, 0, &aiTexturePath, nullptr, nullptr, &blendFactor, &aiBlendOperation ) == aiReturn_SUCCESS )
-    {
-        fs::path texturePath( aiTexturePath.C_Str() );
-        std::shared_ptr<Texture> pTexture = CreateTexture( ( parentPath / texturePath ).wstring() );
-        pMaterial->SetTexture( Material::TextureType::SpecularPower, pTexture );
+        SetMaterialTexture( *pMaterial, slot, iter->second );
     }
 
-    if ( material.GetTextureCount( aiTextureType_OPACITY ) > 0 &&
-         material.GetTexture( aiTextureType_OPACITY, 0, &aiTexturePath, nullptr, nullptr, &blendFactor, &aiBlendOperation ) == aiReturn_SUCCESS )
+    m_Materials.push_back( pMaterial );
+}
+
+TextureUsage SceneBase::GetTextureUsage( uint32_t slot )
+{
+    if ( slot == SceneCache::HeightMapSlot )
     {
-        fs::path texturePath( aiTexturePath.C_Str() );
-        std::shared_ptr<Texture> pTexture = CreateTexture( ( parentPath / texturePath ).wstring() );
-        pMaterial->SetTexture( Material::TextureType::Opacity, pTexture );
+        // The height map slot may contain a normal map (see SetMaterialTexture).
+        // Single channel (bump map) images are filtered as linear data.
+        return TextureUsage::NormalMap;
     }
 
-    // Load normal map texture.
-    if ( material.GetTextureCount( aiTextureType_NORMALS ) > 0 &&
-         material.GetTexture( aiTextureType_NORMALS, 0, &aiTexturePath ) == aiReturn_SUCCESS )
+    switch ( static_cast<Material::TextureType>( slot ) )
     {
-        fs::path texturePath( aiTexturePath.C_Str() );
-        std::shared_ptr<Texture> pTexture = CreateTexture( ( parentPath / texturePath ).wstring() );
-        pMaterial->SetTexture( Material::TextureType::Normal, pTexture );
+    case Material::TextureType::SpecularPower:
+    case Material::TextureType::Bump:
+        return TextureUsage::Linear;
+    case Material::TextureType::Normal:
+        return TextureUsage::NormalMap;
+    case Material::TextureType::Opacity:
+        return TextureUsage::Opacity;
+    default:
+        return TextureUsage::Color;
     }
-    // Load bump map (only if there is no normal map).
-    else if ( material.GetTextureCount( aiTextureType_HEIGHT ) > 0 &&
-         material.GetTexture( aiTextureType_HEIGHT, 0, &aiTexturePath, nullptr, nullptr, &blendFactor ) == aiReturn_SUCCESS )
+}
+
+void SceneBase::SetMaterialTexture( Material& material, uint32_t slot, std::shared_ptr<Texture> texture )
+{
+    Material::TextureType textureType = static_cast<Material::TextureType>( slot );
+    if ( slot == SceneCache::HeightMapSlot )
     {
-        fs::path texturePath( aiTexturePath.C_Str() );
-        std::shared_ptr<Texture> pTexture = CreateTexture( ( parentPath / texturePath ).wstring() );
-        
         // Some materials actually store normal maps in the bump map slot. Assimp can't tell the difference between 
         // these two texture types, so we try to make an assumption about whether the texture is a normal map or a bump
         // map based on its pixel depth. Bump maps are usually 8 BPP (grayscale) and normal maps are usually 24 BPP or higher.
-        Material::TextureType textureType = ( pTexture->GetBPP() >= 24 ) ? Material::TextureType::Normal : Material::TextureType::Bump;
-
-        pMaterial->SetTexture( textureType, pTexture );
+        textureType = ( texture->GetBPP() >= 24 ) ? Material::TextureType::Normal : Material::TextureType::Bump;
     }
 
-    //m_MaterialMap.insert( MaterialMap::value_type( materialName.C_Str(), pMaterial ) );
-    m_Materials.push_back( pMaterial );
+    material.SetTexture( textureType, texture );
 }
 
-void SceneBase::ImportMesh( const aiMesh& mesh )
+void SceneBase::ImportMesh( const SceneCache& sceneCache, const SceneCache::MeshRecord& mesh, bool quantizeVertices )
 {
     std::shared_ptr<Mesh> pMesh = CreateMesh();
 
-    assert( mesh.mMaterialIndex < m_Materials.size() );
-    pMesh->SetMaterial( m_Materials[mesh.mMaterialIndex] );
+    assert( mesh.MaterialIndex < m_Materials.size() );
+    pMesh->SetMaterial( m_Materials[mesh.MaterialIndex] );
 
-    if ( mesh.HasPositions() )
+    if ( quantizeVertices )
     {
-        std::shared_ptr<Buffer> positions = CreateFloatVertexBuffer( &( mesh.mVertices[0].x ), mesh.mNumVertices, sizeof( aiVector3D ) );
-        pMesh->AddVertexBuffer( BufferBinding( "POSITION", 0 ), positions );
-    }
+        // All vertex attributes are interleaved in a single buffer.
+        std::vector<QuantizedVertex> vertices;
+        QuantizeVertices( sceneCache, mesh, vertices );
 
-    if ( mesh.HasNormals() )
-    {
-        std::shared_ptr<Buffer> normals = CreateFloatVertexBuffer( &( mesh.mNormals[0].x ), mesh.mNumVertices, sizeof( aiVector3D ) );
-        pMesh->AddVertexBuffer( BufferBinding( "NORMAL", 0 ), normals );
+        BoundingBox boundingBox( mesh.BoundsMin, mesh.BoundsMax );
+        pMesh->SetQuantizedVertexBuffer( CreateInterleavedVertexBuffer( vertices.data(), mesh.NumVertices, sizeof( QuantizedVertex ) ), boundingBox );
+        pMesh->SetBoundingBox( boundingBox );
     }
-
-    if ( mesh.HasTangentsAndBitangents() )
+    else
     {
-        std::shared_ptr<Buffer> tangents = CreateFloatVertexBuffer( &( mesh.mTangents[0].x ), mesh.mNumVertices, sizeof( aiVector3D ) );
-        pMesh->AddVertexBuffer( BufferBinding( "TANGENT", 0 ), tangents );
-
-        std::shared_ptr<Buffer> bitangents = CreateFloatVertexBuffer( &( mesh.mBitangents[0].x ), mesh.mNumVertices, sizeof( aiVector3D ) );
-        pMesh->AddVertexBuffer( BufferBinding( "BINORMAL", 0 ), bitangents );
-    }
+        // The vertex buffers are created directly from the scene cache.
+        for ( uint32_t i = 0; i < mesh.NumStreams; ++i )
+        {
+            const SceneCache::StreamRecord& stream = sceneCache.GetStream( mesh.FirstStream + i );
+            std::shared_ptr<Buffer> vertexBuffer = CreateFloatVertexBuffer( sceneCache.GetVertices( stream ), mesh.NumVertices, stream.Stride );
 
-    for ( unsigned int i = 0; mesh.HasVertexColors( i ); ++i )
-    {
-        std::shared_ptr<Buffer> colors = CreateFloatVertexBuffer( &( mesh.mColors[i][0].r ), mesh.mNumVertices, sizeof( aiColor4D ) );
-        pMesh->AddVertexBuffer( BufferBinding( "COLOR", i ), colors );
+            switch ( stream.Type )
+            {
+            case SceneCache::Semantic::Position:
+                pMesh->AddVertexBuffer( BufferBinding( "POSITION", stream.SemanticIndex ), vertexBuffer );
+                pMesh->SetBoundingBox( BoundingBox( mesh.BoundsMin, mesh.BoundsMax ) );
+                break;
+            case SceneCache::Semantic::Normal:
+                pMesh->AddVertexBuffer( BufferBinding( "NORMAL", stream.SemanticIndex ), vertexBuffer );
+                break;
+            case SceneCache::Semantic::Tangent:
+                pMesh->AddVertexBuffer( BufferBinding( "TANGENT", stream.SemanticIndex ), vertexBuffer );
+                break;
+            case SceneCache::Semantic::Binormal:
+                pMesh->AddVertexBuffer( BufferBinding( "BINORMAL", stream.SemanticIndex ), vertexBuffer );
+                break;
+            case SceneCache::Semantic::Color:
+                pMesh->AddVertexBuffer( BufferBinding( "COLOR", stream.SemanticIndex ), vertexBuffer );
+                break;
+            case SceneCache::Semantic::TexCoord:
+                pMesh->AddVertexBuffer( BufferBinding( "TEXCOORD", stream.SemanticIndex ), vertexBuffer );
+                break;
+            }
+        }
     }
 
-    for ( unsigned int i = 0; mesh.HasTextureCoords( i ); ++i )
+    if ( mesh.NumIndices > 0 )
     {
-        switch ( mesh.mNumUVComponents[i] )
+        // The index buffer contains the indices of all levels of detail.
+        uint32_t indexCount = sceneCache.GetIndexCount( mesh );
+        std::shared_ptr<Buffer> indexBuffer;
+        if ( mesh.IndexSize == sizeof( uint16_t ) )
         {
-        case 1: // 1-component texture coordinates (U)
-        {
-            std::vector<float> texcoods1D( mesh.mNumVertices );
-            for ( unsigned int j = 0; j < mesh.mNumVertices; ++j )
-            {
-                texcoods1D[j] = mesh.mTextureCoords[i][j].x;
-            }
-            std::shared_ptr<Buffer> texcoords = CreateFloatVertexBuffer( texcoods1D.data(), (unsigned int)texcoods1D.size(), sizeof( float ) );
-            pMesh->AddVertexBuffer( BufferBinding( "TEXCOORD", i ), texcoords );
+            indexBuffer = CreateUShortIndexBuffer( static_cast<const unsigned short*>( sceneCache.GetIndexData( mesh ) ), indexCount );
         }
-        break;
-        case 2: // 2-component texture coordinates (U,V)
+        else
         {
-            std::vector<aiVector2D> texcoods2D( mesh.mNumVertices );
-            for ( unsigned int j = 0; j < mesh.mNumVertices; ++j )
-            {
-                texcoods2D[j] = aiVector2D( mesh.mTextureCoords[i][j].x, mesh.mTextureCoords[i][j].y );
-            }
-            std::shared_ptr<Buffer> texcoords = CreateFloatVertexBuffer( &( texcoods2D[0].x ), (unsigned int)texcoods2D.size(), sizeof( aiVector2D ) );
-            pMesh->AddVertexBuffer( BufferBinding( "TEXCOORD", i ), texcoords );
+            indexBuffer = CreateUIntIndexBuffer( static_cast<const unsigned int*>( sceneCache.GetIndexData( mesh ) ), indexCount );
         }
-        break;
-        case 3: // 3-component texture coordinates (U,V,W)
+        pMesh->SetIndexBuffer( indexBuffer );
+
+        for ( uint32_t i = 0; i < mesh.NumLods; ++i )
         {
-            std::vector<aiVector3D> texcoods3D( mesh.mNumVertices );
-            for ( unsigned int j = 0; j < mesh.mNumVertices; ++j )
-            {
-                texcoods3D[j] = mesh.mTextureCoords[i][j];
-            }
-            std::shared_ptr<Buffer> texcoords = CreateFloatVertexBuffer( &( texcoods3D[0].x ), (unsigned int)texcoods3D.size(), sizeof( aiVector3D ) );
-            pMesh->AddVertexBuffer( BufferBinding( "TEXCOORD", i ), texcoords );
-        }
-        break;
+            pMesh->AddLod( mesh.Lods[i].FirstIndex, mesh.Lods[i].NumIndices, mesh.Lods[i].Error );
         }
     }
 
-    // Extract the index buffer.
-    if ( mesh.HasFaces() )
+    if ( mesh.NumMeshlets > 0 )
     {
-        std::vector<unsigned int> indices;
-        for ( unsigned int i = 0; i < mesh.mNumFaces; ++i )
+        // Cluster culling builds the index buffer of the visible meshlets
+        // from a CPU copy of the indices of the full detail mesh.
+        std::shared_ptr<MeshletGeometry> pMeshletGeometry = std::make_shared<MeshletGeometry>();
+        pMeshletGeometry->Meshlets.resize( mesh.NumMeshlets );
+        for ( uint32_t i = 0; i < mesh.NumMeshlets; ++i )
         {
-            const aiFace& face = mesh.mFaces[i];
-            // Only extract triangular faces
-            if ( face.mNumIndices == 3 )
-            {
-                indices.push_back( face.mIndices[0] );
-                indices.push_back( face.mIndices[1] );
-                indices.push_back( face.mIndices[2] );
-            }
+            const SceneCache::MeshletRecord& record = sceneCache.GetMeshlet( mesh.FirstMeshlet + i );
+            Meshlet& meshlet = pMeshletGeometry->Meshlets[i];
+            meshlet.FirstIndex = record.FirstIndex;
+            meshlet.NumIndices = record.NumIndices;
+            meshlet.Center = record.Center;
+            meshlet.Radius = record.Radius;
+            meshlet.ConeAxis = record.ConeAxis;
+            meshlet.ConeCutoff = record.ConeCutoff;
         }
-        if ( indices.size() > 0 )
+
+        pMeshletGeometry->Indices.resize( mesh.NumIndices );
+        for ( uint32_t i = 0; i < mesh.NumIndices; ++i )
         {
-            std::shared_ptr<Buffer> indexBuffer = CreateUIntIndexBuffer( indices.data(), (unsigned int)indices.size() );
-            pMesh->SetIndexBuffer( indexBuffer );
+            pMeshletGeometry->Indices[i] = sceneCache.GetIndex( mesh, i );
         }
-    }
 
+        pMesh->SetMeshletGeometry( pMeshletGeometry );
+    }
 
     m_Meshes.push_back( pMesh );
 }
 
-std::shared_ptr<SceneNode> SceneBase::ImportSceneNode( std::shared_ptr<SceneNode> parent, aiNode* aiNode )
+void SceneBase::SelectOccluders( const SceneCache& sceneCache )
 {
-    if ( !aiNode )
+    // Good occluders are opaque meshes with a large surface area and few triangles.
+    struct OccluderCandidate
+    {
+        uint32_t MeshIndex;
+        const float* Positions;
+        float SurfaceArea;
+    };
+    std::vector<OccluderCandidate> candidates;
+
+    for ( uint32_t i = 0; i < sceneCache.GetHeader().NumMeshes; ++i )
     {
-        return nullptr;
+        const SceneCache::MeshRecord& mesh = sceneCache.GetMesh( i );
+        std::shared_ptr<Material> pMaterial = m_Materials[mesh.MaterialIndex];
+
+        if ( mesh.NumIndices == 0 || mesh.NumIndices / 3 > MAX_OCCLUDER_TRIANGLES ) continue;
+        if ( pMaterial && pMaterial->IsTransparent() ) continue;
+
+        // Find the positions of the mesh.
+        const float* positions = nullptr;
+        for ( uint32_t j = 0; j < mesh.NumStreams; ++j )
+        {
+            const SceneCache::StreamRecord& stream = sceneCache.GetStream( mesh.FirstStream + j );
+            if ( stream.Type == SceneCache::Semantic::Position && stream.Stride == sizeof( glm::vec3 ) )
+            {
+                positions = sceneCache.GetVertices( stream );
+            }
+        }
+        if ( !positions ) continue;
+
+        const glm::vec3* vertices = reinterpret_cast<const glm::vec3*>( positions );
+
+        float surfaceArea = 0.0f;
+        for ( uint32_t j = 0; j < mesh.NumIndices; j += 3 )
+        {
+            const glm::vec3& v0 = vertices[sceneCache.GetIndex( mesh, j )];
+            glm::vec3 e0 = vertices[sceneCache.GetIndex( mesh, j + 1 )] - v0;
+            glm::vec3 e1 = vertices[sceneCache.GetIndex( mesh, j + 2 )] - v0;
+            surfaceArea += glm::length( glm::cross( e0, e1 ) ) * 0.5f;
+        }
+
+        OccluderCandidate candidate = { i, positions, surfaceArea };
+        candidates.push_back( candidate );
     }
 
-    // Assimp stores its matrices in row-major but GLM uses column-major.
-    // We have to transpose the matrix before using it to construct a glm matrix.
-    aiMatrix4x4 mat = aiNode->mTransformation;
-    glm::mat4 localTransform( mat.a1, mat.b1, mat.c1, mat.d1,
-                              mat.a2, mat.b2, mat.c2, mat.d2,
-                              mat.a3, mat.b3, mat.c3, mat.d3,
-                              mat.a4, mat.b4, mat.c4, mat.d4 );
+    std::sort( candidates.begin(), candidates.end(), []( const OccluderCandidate& a, const OccluderCandidate& b )
+    {
+        return a.SurfaceArea > b.SurfaceArea;
+    } );
+
+    uint32_t numOccluderTriangles = 0;
+    for ( const OccluderCandidate& candidate : candidates )
+    {
+        const SceneCache::MeshRecord& mesh = sceneCache.GetMesh( candidate.MeshIndex );
+        if ( numOccluderTriangles + mesh.NumIndices / 3 > MAX_SCENE_OCCLUDER_TRIANGLES ) continue;
+
+        const glm::vec3* vertices = reinterpret_cast<const glm::vec3*>( candidate.Positions );
+
+        std::shared_ptr<OccluderGeometry> pOccluderGeometry = std::make_shared<OccluderGeometry>();
+        pOccluderGeometry->Positions.assign( vertices, vertices + mesh.NumVertices );
+        pOccluderGeometry->Indices.resize( mesh.NumIndices );
+        for ( uint32_t j = 0; j < mesh.NumIndices; ++j )
+        {
+            pOccluderGeometry->Indices[j] = sceneCache.GetIndex( mesh, j );
+        }
 
-    std::shared_ptr<SceneNode> pNode = std::make_shared<SceneNode>( localTransform );
+        numOccluderTriangles += mesh.NumIndices / 3;
+        m_Meshes[candidate.MeshIndex]->SetOccluderGeometry( pOccluderGeometry );
+    }
+}
+
+std::shared_ptr<SceneNode> SceneBase::ImportSceneNode( std::shared_ptr<SceneNode> parent, const SceneCache& sceneCache, const SceneCache::NodeRecord& node )
+{
+    std::shared_ptr<SceneNode> pNode = std::make_shared<SceneNode>( node.LocalTransform );
     pNode->SetParent( parent );
 
-    std::string nodeName( aiNode->mName.C_Str() );
-    if ( !nodeName.empty() )
+    const char* nodeName = sceneCache.GetString( node.Name );
+    if ( nodeName && nodeName[0] != 0 )
     {
         pNode->SetName( nodeName );
     }
 
     // Add meshes to scene node
-    for ( unsigned int i = 0; i < aiNode->mNumMeshes; ++i )
+    const uint32_t* meshes = sceneCache.GetNodeMeshes( node );
+    for ( uint32_t i = 0; i < node.NumMeshes; ++i )
     {
-        assert( aiNode->mMeshes[i] < m_Meshes.size() );
+        assert( meshes[i] < m_Meshes.size() );
 
-        std::shared_ptr<Mesh> pMesh = m_Meshes[aiNode->mMeshes[i]];
+        std::shared_ptr<Mesh> pMesh = m_Meshes[meshes[i]];
         pNode->AddMesh( pMesh );
     }
 
-    // Recursively Import children
-    for ( unsigned int i = 0; i < aiNode->mNumChildren; ++i )
-    {
-        std::shared_ptr<SceneNode> pChild = ImportSceneNode( pNode, aiNode->mChildren[i] );
-        pNode->AddChild( pChild );
-    }
-
     return pNode;
 }
 
@@ -501,6 +729,76 @@ void SceneBase::Render( RenderEventArgs& args )
     }
 }
 
+void SceneBase::UpdateStreaming( const Camera& camera )
+{
+    MutexLock lock( m_Mutex );
+
+    if ( m_StreamedTextures.empty() ) return;
+
+    // Assign the textures that finished loading to the materials.
+    TextureMap loadedTextures;
+    UpdateStreamedTextures( loadedTextures );
+
+    StreamedTextureList::iterator iter = m_StreamedTextures.begin();
+    while ( !loadedTextures.empty() && iter != m_StreamedTextures.end() )
+    {
+        TextureMap::iterator loadedTexture = loadedTextures.find( iter->FileName );
+        if ( loadedTexture == loadedTextures.end() )
+        {
+            ++iter;
+            continue;
+        }
+
+        // If the texture failed to load, the material keeps the placeholder.
+        if ( loadedTexture->second )
+        {
+            SetMaterialTexture( *iter->pMaterial, iter->Slot, loadedTexture->second );
+
+            // The occluders were selected before the textures were loaded.
+            // A texture with an alpha channel can make a material transparent
+            // and transparent meshes can't be used as occluders.
+            if ( iter->pMaterial->IsTransparent() )
+            {
+                for ( std::shared_ptr<Mesh> pMesh : m_Meshes )
+                {
+                    if ( pMesh->GetMaterial() == iter->pMaterial && pMesh->GetOccluderGeometry() )
+                    {
+                        pMesh->SetOccluderGeometry( nullptr );
+                    }
+                }
+            }
+        }
+
+        iter = m_StreamedTextures.erase( iter );
+    }
+
+    if ( m_StreamedTextures.empty() || !m_pRootNode ) return;
+
+    // Load the textures of the meshes that cover most of the screen first.
+    StreamingPriorityVisitor::MaterialSizeMap materialSizes;
+    for ( const StreamedTexture& streamedTexture : m_StreamedTextures )
+    {
+        materialSizes[streamedTexture.pMaterial.get()] = 0.0f;
+    }
+
+    StreamingPriorityVisitor visitor( camera, materialSizes );
+    m_pRootNode->Accept( visitor );
+
+    TexturePriorityMap priorities;
+    for ( const StreamedTexture& streamedTexture : m_StreamedTextures )
+    {
+        float& priority = priorities[streamedTexture.FileName];
+        priority = glm::max( priority, materialSizes[streamedTexture.pMaterial.get()] );
+    }
+
+    SetStreamingPriorities( priorities );
+}
+
+bool SceneBase::IsStreaming() const
+{
+    return !m_StreamedTextures.empty();
+}
+
 void SceneBase::OnLoadingProgress( ProgressEventArgs& e )
 {
     base::OnLoadingProgress( e );
@@ -521,7 +819,7 @@ void SceneBase::Accept( Visitor& visitor )
         if ( m_DependencyTracker.IsStale() )
         {
             // File modification detected.. Reload the scene file.
-            LoadFromFile( m_SceneFile );
+            LoadFromFile( m_SceneFile, m_bStreamTextures, m_bQuantizeVertices );
         }
         m_bFileChanged = false;
     }
@@ -3,9 +3,8 @@
 #include <Scene.h>
 #include <DependencyTracker.h>
 
-struct aiMaterial;
-struct aiMesh;
-struct aiNode;
+#include "SceneCache.h"
+#include "TextureProcessing.h"
 
 class Material;
 class Buffer;
@@ -16,17 +15,21 @@ class SceneNode;
 
 // A model base class.
 // Implements a basic model loader using Assimp.
+// Imported scenes are cached in the native SceneCache format.
 class SceneBase : public Scene
 {
 public:
     typedef Scene base;
 
-    virtual bool LoadFromFile( const std::wstring& fileName );
+    virtual bool LoadFromFile( const std::wstring& fileName, bool streamTextures = false, bool quantizeVertices = false );
     virtual bool LoadFromString( const std::string& scene, const std::string& format );
     virtual void Render( RenderEventArgs& renderArgs );
 
     virtual std::shared_ptr<SceneNode> GetRootNode() const;
 
+    virtual void UpdateStreaming( const Camera& camera );
+    virtual bool IsStreaming() const;
+
     virtual void Accept( Visitor& visitor );
 
 protected:
@@ -39,15 +42,36 @@ protected:
     virtual void OnFileChanged( FileChangeEventArgs& e );
 
     virtual std::shared_ptr<Buffer> CreateFloatVertexBuffer( const float* data, unsigned int count, unsigned int stride ) const = 0;
+    // @param stride The size of a vertex in bytes.
+    virtual std::shared_ptr<Buffer> CreateInterleavedVertexBuffer( const void* data, unsigned int count, unsigned int stride ) const = 0;
+    virtual std::shared_ptr<Buffer> CreateUShortIndexBuffer( const unsigned short* data, unsigned int count ) const = 0;
     virtual std::shared_ptr<Buffer> CreateUIntIndexBuffer( const unsigned int* data, unsigned int sizeInBytes ) const = 0;
 
     virtual std::shared_ptr<Mesh> CreateMesh() const = 0;
     virtual std::shared_ptr<Material> CreateMaterial() const = 0;
     virtual std::shared_ptr<Texture> CreateTexture( const std::wstring& fileName ) const = 0;
+    // Load several textures at once (in parallel if possible).
+    // @param usages How each texture is used by the materials (in the same order as the file names).
+    virtual void CreateTextures( const std::vector<std::wstring>& fileNames, const std::vector<TextureUsage>& usages, std::vector< std::shared_ptr<Texture> >& textures ) const = 0;
     virtual std::shared_ptr<Texture> CreateTexture2D( uint16_t width, uint16_t height ) = 0;
 
     virtual std::shared_ptr<Texture> GetDefaultTexture() = 0;
 
+    typedef std::map< std::wstring, std::shared_ptr<Texture> > TextureMap;
+    // Maps texture file names to their streaming priority.
+    typedef std::map<std::wstring, float> TexturePriorityMap;
+    // Maps texture file names to the way they are used by the materials.
+    typedef std::map<std::wstring, TextureUsage> TextureUsageMap;
+
+    // Queue textures to be loaded in the background.
+    virtual void StreamTextures( const TexturePriorityMap& textures, const TextureUsageMap& usages ) = 0;
+    // Change the priority of textures that have not been loaded yet.
+    virtual void SetStreamingPriorities( const TexturePriorityMap& priorities ) = 0;
+    // Get the textures that finished loading since the last call (nullptr if loading failed).
+    virtual void UpdateStreamedTextures( TextureMap& loadedTextures ) = 0;
+    // Discard the textures that have not been loaded yet.
+    virtual void CancelStreaming() = 0;
+
 private:
     typedef std::map<std::string, std::shared_ptr<Material> > MaterialMap;
     typedef std::vector< std::shared_ptr<Material> > MaterialList;
@@ -59,9 +83,31 @@ private:
 
     std::shared_ptr<SceneNode> m_pRootNode;
 
-    void ImportMaterial( const aiMaterial& material, fs::path parentPath );
-    void ImportMesh( const aiMesh& mesh );
-    std::shared_ptr<SceneNode> ImportSceneNode( std::shared_ptr<SceneNode> parent, aiNode* aiNode );
+    // Create the materials, meshes and scene nodes from a scene cache.
+    // If streamTextures is true, the textures are loaded in the background.
+    // If quantizeVertices is true, the meshes use the quantized vertex format (see VertexQuantization.h).
+    void ImportScene( const SceneCache& sceneCache, fs::path parentPath, bool streamTextures, bool quantizeVertices );
+    void ImportMaterial( const SceneCache& sceneCache, const SceneCache::MaterialRecord& material, fs::path parentPath, const TextureMap& textures );
+    // How the texture in one of the texture slots of the scene cache is used.
+    static TextureUsage GetTextureUsage( uint32_t slot );
+    // Assign a texture that was loaded from one of the texture slots of the scene cache to a material.
+    void SetMaterialTexture( Material& material, uint32_t slot, std::shared_ptr<Texture> texture );
+    void ImportMesh( const SceneCache& sceneCache, const SceneCache::MeshRecord& mesh, bool quantizeVertices );
+    // Choose which of the imported meshes are used as occluders for software occlusion culling.
+    void SelectOccluders( const SceneCache& sceneCache );
+    std::shared_ptr<SceneNode> ImportSceneNode( std::shared_ptr<SceneNode> parent, const SceneCache& sceneCache, const SceneCache::NodeRecord& node );
+
+    // A material texture that is still being loaded in the background.
+    struct StreamedTexture
+    {
+        std::shared_ptr<Material> pMaterial;
+        uint32_t Slot;
+        std::wstring FileName;
+    };
+    typedef std::vector<StreamedTexture> StreamedTextureList;
+    StreamedTextureList m_StreamedTextures;
+    bool m_bStreamTextures;
+    bool m_bQuantizeVertices;
 
     // Dependency tracker will notify us if we need to reload the scene.
     DependencyTracker m_DependencyTracker;
@@ -0,0 +1,726 @@
+#include <EnginePCH.h>
+
+#include <BoundingBox.h>
+#include <HighResolutionTimer.h>
+#include <Material.h>
+
+#include "MeshOptimizer.h"
+#include "SceneCache.h"
+
+// "SCNC"
+#define SCENE_CACHE_MAGIC 0x434e4353
+// Increment the version whenever the layout of the file changes.
+#define SCENE_CACHE_VERSION 4
+// The alignment of the tables and the vertex and index data in the file.
+#define SCENE_CACHE_ALIGNMENT 16
+
+// Each level of detail has about this fraction of the triangles of the previous level.
+#define LOD_REDUCTION 0.5f
+// A level of detail is only kept if the simplifier could reduce the number of triangles at least to this fraction.
+#define MAX_LOD_RATIO 0.8f
+// Meshes with fewer triangles are not simplified.
+#define MIN_LOD_TRIANGLES 64
+
+static uint64_t Align( uint64_t offset )
+{
+    return ( offset + ( SCENE_CACHE_ALIGNMENT - 1 ) ) & ~(uint64_t)( SCENE_CACHE_ALIGNMENT - 1 );
+}
+
+// Append data to a blob and return the offset (relative to the start of the blob).
+static uint64_t AppendData( std::vector<uint8_t>& blob, const void* data, size_t sizeInBytes )
+{
+    uint64_t offset = Align( blob.size() );
+    blob.resize( offset + sizeInBytes );
+    memcpy( blob.data() + offset, data, sizeInBytes );
+
+    return offset;
+}
+
+// Append a string to the string table and return its offset in the string table.
+static uint32_t AppendString( std::vector<char>& stringTable, const char* str )
+{
+    uint32_t offset = static_cast<uint32_t>( stringTable.size() );
+    stringTable.insert( stringTable.end(), str, str + strlen( str ) + 1 );
+
+    return offset;
+}
+
+SceneCache::SceneCache()
+    : m_pData( nullptr )
+    , m_Size( 0 )
+    , m_hFile( INVALID_HANDLE_VALUE )
+    , m_hFileMapping( NULL )
+{}
+
+SceneCache::~SceneCache()
+{
+    Close();
+}
+
+bool SceneCache::Load( const std::wstring& fileName )
+{
+    Close();
+
+    m_hFile = CreateFileW( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+    if ( m_hFile == INVALID_HANDLE_VALUE )
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if ( !GetFileSizeEx( m_hFile, &fileSize ) || fileSize.QuadPart < (LONGLONG)sizeof( Header ) )
+    {
+        Close();
+        return false;
+    }
+
+    m_hFileMapping = CreateFileMappingW( m_hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+    if ( m_hFileMapping == NULL )
+    {
+        Close();
+        return false;
+    }
+
+    m_pData = static_cast<const uint8_t*>( MapViewOfFile( m_hFileMapping, FILE_MAP_READ, 0, 0, 0 ) );
+    m_Size = static_cast<uint64_t>( fileSize.QuadPart );
+
+    if ( !m_pData || !Validate() )
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SceneCache::Build( const aiScene& scene )
+{
+    Close();
+
+    std::vector<MaterialRecord> materials;
+    std::vector<MeshRecord> meshes;
+    std::vector<StreamRecord> streams;
+    std::vector<NodeRecord> nodes;
+    std::vector<uint32_t> nodeMeshes;
+    std::vector<char> stringTable;
+    // Vertex and index data. The offsets are relative to the start of the blob
+    // until the final layout of the file is known.
+    std::vector<uint8_t> blob;
+
+    // Materials
+    // Assimp texture types for each texture slot (in the order of Material::TextureType).
+    const aiTextureType textureTypes[NumTextureSlots] =
+    {
+        aiTextureType_AMBIENT,
+        aiTextureType_EMISSIVE,
+        aiTextureType_DIFFUSE,
+        aiTextureType_SPECULAR,
+        aiTextureType_SHININESS,
+        aiTextureType_NORMALS,
+        aiTextureType_NONE,     // Bump maps are loaded from the height map slot.
+        aiTextureType_OPACITY,
+        aiTextureType_HEIGHT,
+    };
+
+    for ( unsigned int i = 0; i < scene.mNumMaterials; ++i )
+    {
+        const aiMaterial& material = *scene.mMaterials[i];
+        MaterialRecord record = {};
+        aiColor4D color;
+
+        if ( material.Get( AI_MATKEY_COLOR_AMBIENT, color ) == aiReturn_SUCCESS )
+        {
+            record.AmbientColor = glm::vec4( color.r, color.g, color.b, color.a );
+            record.Properties |= MaterialProperty::AmbientColor;
+        }
+        if ( material.Get( AI_MATKEY_COLOR_EMISSIVE, color ) == aiReturn_SUCCESS )
+        {
+            record.EmissiveColor = glm::vec4( color.r, color.g, color.b, color.a );
+            record.Properties |= MaterialProperty::EmissiveColor;
+        }
+        if ( material.Get( AI_MATKEY_COLOR_DIFFUSE, color ) == aiReturn_SUCCESS )
+        {
+            record.DiffuseColor = glm::vec4( color.r, color.g, color.b, color.a );
+            record.Properties |= MaterialProperty::DiffuseColor;
+        }
+        if ( material.Get( AI_MATKEY_COLOR_SPECULAR, color ) == aiReturn_SUCCESS )
+        {
+            record.SpecularColor = glm::vec4( color.r, color.g, color.b, color.a );
+            record.Properties |= MaterialProperty::SpecularColor;
+        }
+        if ( material.Get( AI_MATKEY_SHININESS, record.SpecularPower ) == aiReturn_SUCCESS )
+        {
+            record.Properties |= MaterialProperty::SpecularPower;
+        }
+        if ( material.Get( AI_MATKEY_OPACITY, record.Opacity ) == aiReturn_SUCCESS )
+        {
+            record.Properties |= MaterialProperty::Opacity;
+        }
+        if ( material.Get( AI_MATKEY_REFRACTI, record.IndexOfRefraction ) == aiReturn_SUCCESS )
+        {
+            record.Properties |= MaterialProperty::IndexOfRefraction;
+        }
+        if ( material.Get( AI_MATKEY_REFLECTIVITY, record.Reflectivity ) == aiReturn_SUCCESS )
+        {
+            record.Properties |= MaterialProperty::Reflectivity;
+        }
+        if ( material.Get( AI_MATKEY_BUMPSCALING, record.BumpIntensity ) == aiReturn_SUCCESS )
+        {
+            record.Properties |= MaterialProperty::BumpIntensity;
+        }
+
+        for ( uint32_t slot = 0; slot < NumTextureSlots; ++slot )
+        {
+            aiString texturePath;
+            record.Textures[slot] = InvalidString;
+
+            // Only use the height map if there is no normal map.
+            if ( slot == HeightMapSlot && record.Textures[(uint32_t)Material::TextureType::Normal] != InvalidString ) continue;
+
+            if ( textureTypes[slot] != aiTextureType_NONE &&
+                 material.GetTextureCount( textureTypes[slot] ) > 0 &&
+                 material.GetTexture( textureTypes[slot], 0, &texturePath ) == aiReturn_SUCCESS )
+            {
+                record.Textures[slot] = AppendString( stringTable, texturePath.C_Str() );
+            }
+        }
+
+        materials.push_back( record );
+    }
+
+    // Meshes
+    uint64_t totalVerticesTransformedBefore = 0;
+    uint64_t totalVerticesTransformedAfter = 0;
+    uint64_t totalTriangles = 0;
+    uint64_t totalLodTriangles[MaxLods] = {};
+    double simplificationTime = 0.0;
+    std::vector<MeshletRecord> meshlets;
+
+    for ( unsigned int i = 0; i < scene.mNumMeshes; ++i )
+    {
+        const aiMesh& mesh = *scene.mMeshes[i];
+        MeshRecord record = {};
+        record.MaterialIndex = mesh.mMaterialIndex;
+        record.NumVertices = mesh.mNumVertices;
+        record.FirstStream = static_cast<uint32_t>( streams.size() );
+
+        // Only extract triangular faces.
+        std::vector<uint32_t> indices;
+        indices.reserve( mesh.mNumFaces * 3 );
+        for ( unsigned int j = 0; j < mesh.mNumFaces; ++j )
+        {
+            const aiFace& face = mesh.mFaces[j];
+            if ( face.mNumIndices == 3 )
+            {
+                indices.push_back( face.mIndices[0] );
+                indices.push_back( face.mIndices[1] );
+                indices.push_back( face.mIndices[2] );
+            }
+        }
+        record.NumIndices = static_cast<uint32_t>( indices.size() );
+
+        // Reorder the triangles for the post-transform vertex cache and then
+        // reorder the vertices in the order they are used by the triangles.
+        VertexCacheStatistics before = AnalyzeVertexCache( indices.data(), indices.size(), mesh.mNumVertices );
+        OptimizeVertexCache( indices.data(), indices.size(), mesh.mNumVertices );
+        std::vector<uint32_t> remap;
+        OptimizeVertexFetch( indices.data(), indices.size(), mesh.mNumVertices, remap );
+        VertexCacheStatistics after = AnalyzeVertexCache( indices.data(), indices.size(), mesh.mNumVertices );
+
+        if ( record.NumIndices > 0 )
+        {
+            std::stringstream ss;
+            ss << "Mesh " << i << " (" << mesh.mName.C_Str() << "): " << record.NumIndices / 3 << " triangles, " << mesh.mNumVertices << " vertices, "
+               << "ACMR " << before.ACMR << " -> " << after.ACMR << ", ATVR " << before.ATVR << " -> " << after.ATVR << std::endl;
+            OutputDebugStringA( ss.str().c_str() );
+
+            totalVerticesTransformedBefore += before.VerticesTransformed;
+            totalVerticesTransformedAfter += after.VerticesTransformed;
+            totalTriangles += record.NumIndices / 3;
+        }
+
+        std::vector<uint8_t> vertexData;
+        auto addStream = [&]( Semantic semantic, uint32_t semanticIndex, const void* data, uint32_t stride )
+        {
+            // Store the vertices in the optimized order.
+            vertexData.resize( (size_t)stride * mesh.mNumVertices );
+            for ( unsigned int j = 0; j < mesh.mNumVertices; ++j )
+            {
+                memcpy( &vertexData[(size_t)remap[j] * stride], static_cast<const uint8_t*>( data ) + (size_t)j * stride, stride );
+            }
+
+            StreamRecord stream = {};
+            stream.Type = semantic;
+            stream.SemanticIndex = semanticIndex;
+            stream.Stride = stride;
+            stream.Offset = AppendData( blob, vertexData.data(), vertexData.size() );
+            streams.push_back( stream );
+        };
+
+        if ( mesh.HasPositions() )
+        {
+            addStream( Semantic::Position, 0, mesh.mVertices, sizeof( aiVector3D ) );
+
+            BoundingBox boundingBox;
+            for ( unsigned int j = 0; j < mesh.mNumVertices; ++j )
+            {
+                boundingBox.Enlarge( glm::vec3( mesh.mVertices[j].x, mesh.mVertices[j].y, mesh.mVertices[j].z ) );
+            }
+            record.BoundsMin = boundingBox.GetMin();
+            record.BoundsMax = boundingBox.GetMax();
+        }
+
+        if ( mesh.HasNormals() )
+        {
+            addStream( Semantic::Normal, 0, mesh.mNormals, sizeof( aiVector3D ) );
+        }
+
+        if ( mesh.HasTangentsAndBitangents() )
+        {
+            addStream( Semantic::Tangent, 0, mesh.mTangents, sizeof( aiVector3D ) );
+            addStream( Semantic::Binormal, 0, mesh.mBitangents, sizeof( aiVector3D ) );
+        }
+
+        for ( unsigned int j = 0; mesh.HasVertexColors( j ); ++j )
+        {
+            addStream( Semantic::Color, j, mesh.mColors[j], sizeof( aiColor4D ) );
+        }
+
+        for ( unsigned int j = 0; mesh.HasTextureCoords( j ); ++j )
+        {
+            // Only store the components of the texture coordinates that are used.
+            unsigned int numComponents = mesh.mNumUVComponents[j];
+            if ( numComponents < 1 || numComponents > 3 ) continue;
+
+            std::vector<float> texcoords( mesh.mNumVertices * numComponents );
+            for ( unsigned int k = 0; k < mesh.mNumVertices; ++k )
+            {
+                memcpy( &texcoords[k * numComponents], &mesh.mTextureCoords[j][k].x, numComponents * sizeof( float ) );
+            }
+            addStream( Semantic::TexCoord, j, texcoords.data(), numComponents * sizeof( float ) );
+        }
+
+        record.NumStreams = static_cast<uint32_t>( streams.size() ) - record.FirstStream;
+
+        // The positions in the optimized vertex order.
+        std::vector<glm::vec3> positions;
+        if ( mesh.HasPositions() )
+        {
+            positions.resize( mesh.mNumVertices );
+            for ( unsigned int j = 0; j < mesh.mNumVertices; ++j )
+            {
+                positions[remap[j]] = glm::vec3( mesh.mVertices[j].x, mesh.mVertices[j].y, mesh.mVertices[j].z );
+            }
+        }
+
+        // Split the full detail mesh into meshlets. The triangles are already in
+        // vertex cache order so neighboring triangles end up in the same meshlet.
+        record.FirstMeshlet = static_cast<uint32_t>( meshlets.size() );
+        if ( record.NumIndices > 0 && !positions.empty() )
+        {
+            std::vector<MeshletInfo> meshletInfos;
+            BuildMeshlets( indices.data(), record.NumIndices, positions.data(), mesh.mNumVertices, MaxMeshletVertices, MaxMeshletTriangles, meshletInfos );
+
+            for ( const MeshletInfo& info : meshletInfos )
+            {
+                MeshletRecord meshlet = {};
+                meshlet.FirstIndex = info.FirstIndex;
+                meshlet.NumIndices = info.NumIndices;
+                meshlet.Center = info.Center;
+                meshlet.Radius = info.Radius;
+                meshlet.ConeAxis = info.ConeAxis;
+                meshlet.ConeCutoff = info.ConeCutoff;
+                meshlets.push_back( meshlet );
+            }
+        }
+        record.NumMeshlets = static_cast<uint32_t>( meshlets.size() ) - record.FirstMeshlet;
+
+        // Generate the levels of detail. Each level is simplified from the previous level
+        // and appended to the indices of the full detail mesh.
+        if ( record.NumIndices > 0 )
+        {
+            LodRecord& lod = record.Lods[record.NumLods++];
+            lod.FirstIndex = 0;
+            lod.NumIndices = record.NumIndices;
+            lod.Error = 0.0f;
+        }
+
+        if ( record.NumIndices / 3 >= MIN_LOD_TRIANGLES && !positions.empty() )
+        {
+            HighResolutionTimer timer;
+
+            std::vector<uint32_t> lodIndices;
+            while ( record.NumLods < MaxLods )
+            {
+                const LodRecord& previous = record.Lods[record.NumLods - 1];
+                size_t targetIndexCount = static_cast<size_t>( previous.NumIndices / 3 * LOD_REDUCTION ) * 3;
+
+                float error = SimplifyMesh( &indices[previous.FirstIndex], previous.NumIndices, positions.data(), mesh.mNumVertices, targetIndexCount, lodIndices );
+                if ( lodIndices.empty() || lodIndices.size() > previous.NumIndices * MAX_LOD_RATIO ) break;
+
+                OptimizeVertexCache( lodIndices.data(), lodIndices.size(), mesh.mNumVertices );
+
+                LodRecord& lod = record.Lods[record.NumLods++];
+                lod.FirstIndex = static_cast<uint32_t>( indices.size() );
+                lod.NumIndices = static_cast<uint32_t>( lodIndices.size() );
+                // The errors of the levels of detail must increase monotonically.
+                lod.Error = std::max( error, previous.Error );
+
+                indices.insert( indices.end(), lodIndices.begin(), lodIndices.end() );
+            }
+
+            timer.Tick();
+            simplificationTime += timer.ElapsedMilliSeconds();
+        }
+
+        for ( uint32_t j = 0; j < MaxLods; ++j )
+        {
+            // Meshes without a level of detail use the previous level.
+            totalLodTriangles[j] += record.Lods[std::min( j, std::max( record.NumLods, 1u ) - 1 )].NumIndices / 3;
+        }
+
+        // Use 16-bit indices if all of the vertices can be addressed.
+        record.IndexSize = ( mesh.mNumVertices <= 0xffff ) ? sizeof( uint16_t ) : sizeof( uint32_t );
+        if ( !indices.empty() )
+        {
+            if ( record.IndexSize == sizeof( uint16_t ) )
+            {
+                std::vector<uint16_t> shortIndices( indices.begin(), indices.end() );
+                record.IndexOffset = AppendData( blob, shortIndices.data(), shortIndices.size() * sizeof( uint16_t ) );
+            }
+            else
+            {
+                record.IndexOffset = AppendData( blob, indices.data(), indices.size() * sizeof( uint32_t ) );
+            }
+        }
+
+        meshes.push_back( record );
+    }
+
+    if ( totalTriangles > 0 )
+    {
+        std::stringstream ss;
+        ss << "Vertex cache optimization: " << totalTriangles << " triangles, ACMR "
+           << (double)totalVerticesTransformedBefore / totalTriangles << " -> " << (double)totalVerticesTransformedAfter / totalTriangles << std::endl;
+        ss << "Mesh LODs: " << totalLodTriangles[0];
+        for ( uint32_t j = 1; j < MaxLods; ++j )
+        {
+            ss << " / " << totalLodTriangles[j];
+        }
+        ss << " triangles, simplification time: " << simplificationTime << " ms" << std::endl;
+        ss << "Meshlets: " << meshlets.size() << " (" << (double)totalTriangles / std::max<size_t>( meshlets.size(), 1 ) << " triangles per meshlet)" << std::endl;
+        OutputDebugStringA( ss.str().c_str() );
+    }
+
+    // Nodes (parents are always stored before their children).
+    std::function<void( const aiNode*, int32_t )> addNode = [&]( const aiNode* node, int32_t parent )
+    {
+        // Assimp stores its matrices in row-major but GLM uses column-major.
+        const aiMatrix4x4& mat = node->mTransformation;
+        NodeRecord record = {};
+        record.LocalTransform = glm::mat4( mat.a1, mat.b1, mat.c1, mat.d1,
+                                           mat.a2, mat.b2, mat.c2, mat.d2,
+                                           mat.a3, mat.b3, mat.c3, mat.d3,
+                                           mat.a4, mat.b4, mat.c4, mat.d4 );
+        record.Parent = parent;
+        record.Name = ( node->mName.length > 0 ) ? AppendString( stringTable, node->mName.C_Str() ) : InvalidString;
+        record.FirstMesh = static_cast<uint32_t>( nodeMeshes.size() );
+        record.NumMeshes = node->mNumMeshes;
+        nodeMeshes.insert( nodeMeshes.end(), node->mMeshes, node->mMeshes + node->mNumMeshes );
+
+        int32_t index = static_cast<int32_t>( nodes.size() );
+        nodes.push_back( record );
+
+        for ( unsigned int i = 0; i < node->mNumChildren; ++i )
+        {
+            addNode( node->mChildren[i], index );
+        }
+    };
+
+    if ( scene.mRootNode )
+    {
+        addNode( scene.mRootNode, -1 );
+    }
+
+    // Layout the file.
+    Header header = {};
+    header.Magic = SCENE_CACHE_MAGIC;
+    header.Version = SCENE_CACHE_VERSION;
+    header.NumMaterials = static_cast<uint32_t>( materials.size() );
+    header.NumMeshes = static_cast<uint32_t>( meshes.size() );
+    header.NumStreams = static_cast<uint32_t>( streams.size() );
+    header.NumNodes = static_cast<uint32_t>( nodes.size() );
+    header.NumNodeMeshes = static_cast<uint32_t>( nodeMeshes.size() );
+    header.StringTableSize = static_cast<uint32_t>( stringTable.size() );
+    header.NumMeshlets = static_cast<uint32_t>( meshlets.size() );
+
+    header.MaterialTableOffset = Align( sizeof( Header ) );
+    header.MeshTableOffset = Align( header.MaterialTableOffset + materials.size() * sizeof( MaterialRecord ) );
+    header.StreamTableOffset = Align( header.MeshTableOffset + meshes.size() * sizeof( MeshRecord ) );
+    header.MeshletTableOffset = Align( header.StreamTableOffset + streams.size() * sizeof( StreamRecord ) );
+    header.NodeTableOffset = Align( header.MeshletTableOffset + meshlets.size() * sizeof( MeshletRecord ) );
+    header.NodeMeshTableOffset = Align( header.NodeTableOffset + nodes.size() * sizeof( NodeRecord ) );
+    header.StringTableOffset = Align( header.NodeMeshTableOffset + nodeMeshes.size() * sizeof( uint32_t ) );
+    uint64_t blobOffset = Align( header.StringTableOffset + stringTable.size() );
+    header.FileSize = blobOffset + blob.size();
+
+    // Now that the offset of the blob is known, fix the offsets of the vertex and index data.
+    for ( StreamRecord& stream : streams )
+    {
+        stream.Offset += blobOffset;
+    }
+    for ( MeshRecord& mesh : meshes )
+    {
+        if ( mesh.NumIndices > 0 )
+        {
+            mesh.IndexOffset += blobOffset;
+        }
+    }
+
+    m_Image.assign( (size_t)header.FileSize, 0 );
+    memcpy( m_Image.data(), &header, sizeof( Header ) );
+    if ( !materials.empty() ) memcpy( m_Image.data() + header.MaterialTableOffset, materials.data(), materials.size() * sizeof( MaterialRecord ) );
+    if ( !meshes.empty() ) memcpy( m_Image.data() + header.MeshTableOffset, meshes.data(), meshes.size() * sizeof( MeshRecord ) );
+    if ( !streams.empty() ) memcpy( m_Image.data() + header.StreamTableOffset, streams.data(), streams.size() * sizeof( StreamRecord ) );
+    if ( !meshlets.empty() ) memcpy( m_Image.data() + header.MeshletTableOffset, meshlets.data(), meshlets.size() * sizeof( MeshletRecord ) );
+    if ( !nodes.empty() ) memcpy( m_Image.data() + header.NodeTableOffset, nodes.data(), nodes.size() * sizeof( NodeRecord ) );
+    if ( !nodeMeshes.empty() ) memcpy( m_Image.data() + header.NodeMeshTableOffset, nodeMeshes.data(), nodeMeshes.size() * sizeof( uint32_t ) );
+    if ( !stringTable.empty() ) memcpy( m_Image.data() + header.StringTableOffset, stringTable.data(), stringTable.size() );
+    if ( !blob.empty() ) memcpy( m_Image.data() + blobOffset, blob.data(), blob.size() );
+
+    m_pData = m_Image.data();
+    m_Size = header.FileSize;
+
+    if ( !Validate() )
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SceneCache::Save( const std::wstring& fileName ) const
+{
+    if ( !IsValid() ) return false;
+
+    fs::ofstream file( fs::path( fileName ), std::ios::binary | std::ios::trunc );
+    if ( !file.is_open() )
+    {
+        return false;
+    }
+
+    file.write( reinterpret_cast<const char*>( m_pData ), (std::streamsize)m_Size );
+
+    return file.good();
+}
+
+void SceneCache::Close()
+{
+    if ( m_hFileMapping != NULL )
+    {
+        if ( m_pData )
+        {
+            UnmapViewOfFile( m_pData );
+        }
+        CloseHandle( m_hFileMapping );
+        m_hFileMapping = NULL;
+    }
+    if ( m_hFile != INVALID_HANDLE_VALUE )
+    {
+        CloseHandle( m_hFile );
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+
+    m_Image.clear();
+    m_Image.shrink_to_fit();
+
+    m_pData = nullptr;
+    m_Size = 0;
+}
+
+bool SceneCache::IsValid() const
+{
+    return m_pData != nullptr;
+}
+
+bool SceneCache::Validate() const
+{
+    if ( m_Size < sizeof( Header ) ) return false;
+
+    const Header& header = *GetData<Header>( 0 );
+    if ( header.Magic != SCENE_CACHE_MAGIC || header.Version != SCENE_CACHE_VERSION || header.FileSize != m_Size ) return false;
+
+    // Check that a range of bytes is inside the file.
+    auto inFile = [&]( uint64_t offset, uint64_t count, uint64_t size )
+    {
+        return offset <= m_Size && count <= ( m_Size - offset ) / std::max<uint64_t>( size, 1 );
+    };
+
+    if ( !inFile( header.MaterialTableOffset, header.NumMaterials, sizeof( MaterialRecord ) ) ||
+         !inFile( header.MeshTableOffset, header.NumMeshes, sizeof( MeshRecord ) ) ||
+         !inFile( header.StreamTableOffset, header.NumStreams, sizeof( StreamRecord ) ) ||
+         !inFile( header.MeshletTableOffset, header.NumMeshlets, sizeof( MeshletRecord ) ) ||
+         !inFile( header.NodeTableOffset, header.NumNodes, sizeof( NodeRecord ) ) ||
+         !inFile( header.NodeMeshTableOffset, header.NumNodeMeshes, sizeof( uint32_t ) ) ||
+         !inFile( header.StringTableOffset, header.StringTableSize, 1 ) )
+    {
+        return false;
+    }
+
+    // The string table must be null terminated.
+    if ( header.StringTableSize > 0 && m_pData[header.StringTableOffset + header.StringTableSize - 1] != 0 ) return false;
+
+    auto validString = [&]( uint32_t offset )
+    {
+        return offset == InvalidString || offset < header.StringTableSize;
+    };
+
+    for ( uint32_t i = 0; i < header.NumMaterials; ++i )
+    {
+        const MaterialRecord& material = GetMaterial( i );
+        for ( uint32_t slot = 0; slot < NumTextureSlots; ++slot )
+        {
+            if ( !validString( material.Textures[slot] ) ) return false;
+        }
+    }
+
+    for ( uint32_t i = 0; i < header.NumMeshes; ++i )
+    {
+        const MeshRecord& mesh = GetMesh( i );
+        if ( mesh.MaterialIndex >= header.NumMaterials ) return false;
+        if ( mesh.FirstStream > header.NumStreams || mesh.NumStreams > header.NumStreams - mesh.FirstStream ) return false;
+        if ( mesh.NumIndices % 3 != 0 ) return false;
+        if ( mesh.IndexSize != sizeof( uint16_t ) && mesh.IndexSize != sizeof( uint32_t ) ) return false;
+        if ( mesh.NumLods > MaxLods || ( mesh.NumLods > 0 ) != ( mesh.NumIndices > 0 ) ) return false;
+        if ( mesh.NumLods > 0 && ( mesh.Lods[0].FirstIndex != 0 || mesh.Lods[0].NumIndices != mesh.NumIndices ) ) return false;
+        for ( uint32_t j = 0; j < mesh.NumLods; ++j )
+        {
+            const LodRecord& lod = mesh.Lods[j];
+            if ( lod.NumIndices == 0 || lod.NumIndices % 3 != 0 || lod.FirstIndex > UINT32_MAX - lod.NumIndices ) return false;
+        }
+        if ( mesh.NumIndices > 0 && !inFile( mesh.IndexOffset, GetIndexCount( mesh ), mesh.IndexSize ) ) return false;
+
+        if ( mesh.FirstMeshlet > header.NumMeshlets || mesh.NumMeshlets > header.NumMeshlets - mesh.FirstMeshlet ) return false;
+        for ( uint32_t j = 0; j < mesh.NumMeshlets; ++j )
+        {
+            const MeshletRecord& meshlet = GetMeshlet( mesh.FirstMeshlet + j );
+            if ( meshlet.NumIndices == 0 || meshlet.NumIndices % 3 != 0 || meshlet.NumIndices > MaxMeshletTriangles * 3 ) return false;
+            if ( meshlet.FirstIndex > mesh.NumIndices || meshlet.NumIndices > mesh.NumIndices - meshlet.FirstIndex ) return false;
+        }
+
+        for ( uint32_t j = 0; j < mesh.NumStreams; ++j )
+        {
+            const StreamRecord& stream = GetStream( mesh.FirstStream + j );
+            if ( stream.Stride == 0 || stream.Stride % sizeof( float ) != 0 ) return false;
+            if ( !inFile( stream.Offset, mesh.NumVertices, stream.Stride ) ) return false;
+        }
+
+        uint32_t indexCount = GetIndexCount( mesh );
+        for ( uint32_t j = 0; j < indexCount; ++j )
+        {
+            if ( GetIndex( mesh, j ) >= mesh.NumVertices ) return false;
+        }
+    }
+
+    const uint32_t* nodeMeshes = GetData<uint32_t>( header.NodeMeshTableOffset );
+    for ( uint32_t i = 0; i < header.NumNodes; ++i )
+    {
+        const NodeRecord& node = GetNode( i );
+        // Only the first node can be the root node and parents must come before their children.
+        if ( ( i == 0 ) != ( node.Parent < 0 ) || node.Parent >= (int32_t)i ) return false;
+        if ( !validString( node.Name ) ) return false;
+        if ( node.FirstMesh > header.NumNodeMeshes || node.NumMeshes > header.NumNodeMeshes - node.FirstMesh ) return false;
+
+        for ( uint32_t j = 0; j < node.NumMeshes; ++j )
+        {
+            if ( nodeMeshes[node.FirstMesh + j] >= header.NumMeshes ) return false;
+        }
+    }
+
+    return true;
+}
+
+template<typename T>
+const T* SceneCache::GetData( uint64_t offset ) const
+{
+    assert( m_pData && offset <= m_Size );
+    return reinterpret_cast<const T*>( m_pData + offset );
+}
+
+const SceneCache::Header& SceneCache::GetHeader() const
+{
+    return *GetData<Header>( 0 );
+}
+
+const SceneCache::MaterialRecord& SceneCache::GetMaterial( uint32_t index ) const
+{
+    assert( index < GetHeader().NumMaterials );
+    return GetData<MaterialRecord>( GetHeader().MaterialTableOffset )[index];
+}
+
+const SceneCache::MeshRecord& SceneCache::GetMesh( uint32_t index ) const
+{
+    assert( index < GetHeader().NumMeshes );
+    return GetData<MeshRecord>( GetHeader().MeshTableOffset )[index];
+}
+
+const SceneCache::StreamRecord& SceneCache::GetStream( uint32_t index ) const
+{
+    assert( index < GetHeader().NumStreams );
+    return GetData<StreamRecord>( GetHeader().StreamTableOffset )[index];
+}
+
+const SceneCache::MeshletRecord& SceneCache::GetMeshlet( uint32_t index ) const
+{
+    assert( index < GetHeader().NumMeshlets );
+    return GetData<MeshletRecord>( GetHeader().MeshletTableOffset )[index];
+}
+
+const SceneCache::NodeRecord& SceneCache::GetNode( uint32_t index ) const
+{
+    assert( index < GetHeader().NumNodes );
+    return GetData<NodeRecord>( GetHeader().NodeTableOffset )[index];
+}
+
+const uint32_t* SceneCache::GetNodeMeshes( const NodeRecord& node ) const
+{
+    return GetData<uint32_t>( GetHeader().NodeMeshTableOffset ) + node.FirstMesh;
+}
+
+const char* SceneCache::GetString( uint32_t offset ) const
+{
+    if ( offset == InvalidString ) return nullptr;
+
+    return GetData<char>( GetHeader().StringTableOffset ) + offset;
+}
+
+const float* SceneCache::GetVertices( const StreamRecord& stream ) const
+{
+    return GetData<float>( stream.Offset );
+}
+
+uint32_t SceneCache::GetIndexCount( const MeshRecord& mesh ) const
+{
+    uint32_t indexCount = mesh.NumIndices;
+    for ( uint32_t i = 0; i < mesh.NumLods && i < MaxLods; ++i )
+    {
+        indexCount = std::max( indexCount, mesh.Lods[i].FirstIndex + mesh.Lods[i].NumIndices );
+    }
+    return indexCount;
+}
+
+const void* SceneCache::GetIndexData( const MeshRecord& mesh ) const
+{
+    return ( mesh.NumIndices > 0 ) ? GetData<uint8_t>( mesh.IndexOffset ) : nullptr;
+}
+
+uint32_t SceneCache::GetIndex( const MeshRecord& mesh, uint32_t i ) const
+{
+    assert( i < GetIndexCount( mesh ) );
+    if ( mesh.IndexSize == sizeof( uint16_t ) )
+    {
+        return GetData<uint16_t>( mesh.IndexOffset )[i];
+    }
+    return GetData<uint32_t>( mesh.IndexOffset )[i];
+}
@@ -0,0 +1,237 @@
+#pragma once
+/**
+ * The scene cache is the engine's native binary format for preprocessed scenes.
+ * The vertex and index data is stored exactly as it is uploaded to the GPU
+ * (already optimized for the post-transform vertex cache and vertex fetch)
+ * so the file can be memory mapped and the buffers created directly
+ * from the mapped memory without any intermediate copies.
+ *
+ * File layout:
+ *   Header
+ *   Material table   (NumMaterials x MaterialRecord)
+ *   Mesh table       (NumMeshes x MeshRecord)
+ *   Stream table     (NumStreams x StreamRecord)
+ *   Meshlet table    (NumMeshlets x MeshletRecord)
+ *   Node table       (NumNodes x NodeRecord, parents before children)
+ *   Node mesh table  (NumNodeMeshes x uint32_t)
+ *   String table     (null terminated strings)
+ *   Vertex and index data (each blob is aligned to 16 bytes)
+ *
+ * All offsets are in bytes from the start of the file.
+ */
+
+// The settings that are used to import scene files into the scene cache.
+// They are part of the key of an imported scene in the asset cache
+// so changing them causes the scenes to be imported again.
+#define IMPORT_SMOOTHING_ANGLE 80.0f
+#define IMPORT_REMOVE_PRIMITIVES ( aiPrimitiveType_POINT | aiPrimitiveType_LINE )
+#define IMPORT_PREPROCESS_FLAGS ( aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_OptimizeGraph )
+
+struct aiScene;
+
+class SceneCache
+{
+public:
+    // The semantic of a vertex stream.
+    enum class Semantic : uint32_t
+    {
+        Position,
+        Normal,
+        Tangent,
+        Binormal,
+        Color,
+        TexCoord,
+    };
+
+    // Material properties that were defined in the original scene file.
+    enum MaterialProperty : uint32_t
+    {
+        AmbientColor        = 1 << 0,
+        EmissiveColor       = 1 << 1,
+        DiffuseColor        = 1 << 2,
+        SpecularColor       = 1 << 3,
+        SpecularPower       = 1 << 4,
+        Opacity             = 1 << 5,
+        IndexOfRefraction   = 1 << 6,
+        Reflectivity        = 1 << 7,
+        BumpIntensity       = 1 << 8,
+    };
+
+    // The first texture slots of a material match Material::TextureType.
+    // The height map slot can contain either a bump map or a normal map.
+    // Which one it is can only be determined when the texture is loaded.
+    static const uint32_t HeightMapSlot = 8;
+    static const uint32_t NumTextureSlots = 9;
+
+    // Used for missing strings.
+    static const uint32_t InvalidString = 0xffffffff;
+
+    // The maximum number of levels of detail of a mesh (including the full detail mesh).
+    static const uint32_t MaxLods = 4;
+
+    // The limits of a meshlet.
+    static const uint32_t MaxMeshletVertices = 64;
+    static const uint32_t MaxMeshletTriangles = 124;
+
+    struct Header
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t FileSize;
+
+        uint32_t NumMaterials;
+        uint32_t NumMeshes;
+        uint32_t NumStreams;
+        uint32_t NumNodes;
+        uint32_t NumNodeMeshes;
+        uint32_t StringTableSize;
+        uint32_t NumMeshlets;
+        uint32_t Padding;
+
+        uint64_t MaterialTableOffset;
+        uint64_t MeshTableOffset;
+        uint64_t StreamTableOffset;
+        uint64_t MeshletTableOffset;
+        uint64_t NodeTableOffset;
+        uint64_t NodeMeshTableOffset;
+        uint64_t StringTableOffset;
+    };
+
+    struct MaterialRecord
+    {
+        glm::vec4 AmbientColor;
+        glm::vec4 EmissiveColor;
+        glm::vec4 DiffuseColor;
+        glm::vec4 SpecularColor;
+        float SpecularPower;
+        float Opacity;
+        float IndexOfRefraction;
+        float Reflectivity;
+        float BumpIntensity;
+        // A combination of MaterialProperty flags.
+        uint32_t Properties;
+        // Texture file names (relative to the scene file) in the string table.
+        uint32_t Textures[NumTextureSlots];
+        uint32_t Padding;
+    };
+
+    // A level of detail is a range of the index data of a mesh.
+    // All levels of detail of a mesh use the same vertices.
+    struct LodRecord
+    {
+        uint32_t FirstIndex;
+        uint32_t NumIndices;
+        // The geometric error of the simplified mesh (in object space).
+        float Error;
+    };
+
+    // A meshlet is a cluster of triangles of the full detail mesh that is culled as a unit.
+    // The triangles of a meshlet are a range of the indices of the full detail mesh.
+    struct MeshletRecord
+    {
+        uint32_t FirstIndex;
+        uint32_t NumIndices;
+        // The bounding sphere (in object space).
+        glm::vec3 Center;
+        float Radius;
+        // The normal cone. A cutoff of 1 means the meshlet is never back facing.
+        glm::vec3 ConeAxis;
+        float ConeCutoff;
+    };
+
+    struct MeshRecord
+    {
+        uint32_t MaterialIndex;
+        uint32_t NumVertices;
+        // Only triangles are stored so the number of indices is always a multiple of 3.
+        uint32_t NumIndices;
+        uint32_t FirstStream;
+        uint32_t NumStreams;
+        // The size of an index in bytes. Meshes with up to 65535 vertices use 16-bit indices.
+        uint32_t IndexSize;
+        glm::vec3 BoundsMin;
+        glm::vec3 BoundsMax;
+        // 16 or 32-bit indices (see IndexSize). Only valid if NumIndices > 0.
+        // The indices of the full detail mesh are followed by the indices of the other levels of detail.
+        uint64_t IndexOffset;
+        // The first level of detail is the full detail mesh (NumIndices indices).
+        // Meshes without triangles don't have any levels of detail.
+        uint32_t NumLods;
+        LodRecord Lods[MaxLods];
+        // The meshlets of the full detail mesh in the meshlet table.
+        uint32_t FirstMeshlet;
+        uint32_t NumMeshlets;
+        uint32_t Padding;
+    };
+
+    struct StreamRecord
+    {
+        Semantic Type;
+        uint32_t SemanticIndex;
+        // The size of a single vertex (in bytes).
+        uint32_t Stride;
+        uint32_t Padding;
+        uint64_t Offset;
+    };
+
+    struct NodeRecord
+    {
+        glm::mat4 LocalTransform;
+        // The index of the parent node (or -1 for the root node).
+        int32_t Parent;
+        uint32_t Name;
+        uint32_t FirstMesh;
+        uint32_t NumMeshes;
+    };
+
+    SceneCache();
+    ~SceneCache();
+
+    // Memory map a scene cache file.
+    // Returns false if the file does not exist or is not a valid scene cache.
+    bool Load( const std::wstring& fileName );
+    // Convert a preprocessed Assimp scene to the scene cache format (in memory).
+    bool Build( const aiScene& scene );
+    // Write the scene cache to disk.
+    bool Save( const std::wstring& fileName ) const;
+    // Release the memory mapped file or the in-memory scene cache.
+    void Close();
+
+    bool IsValid() const;
+
+    const Header& GetHeader() const;
+    const MaterialRecord& GetMaterial( uint32_t index ) const;
+    const MeshRecord& GetMesh( uint32_t index ) const;
+    const StreamRecord& GetStream( uint32_t index ) const;
+    const MeshletRecord& GetMeshlet( uint32_t index ) const;
+    const NodeRecord& GetNode( uint32_t index ) const;
+    // The indices of the meshes of a node.
+    const uint32_t* GetNodeMeshes( const NodeRecord& node ) const;
+    // Returns nullptr for InvalidString.
+    const char* GetString( uint32_t offset ) const;
+
+    const float* GetVertices( const StreamRecord& stream ) const;
+    // The number of indices of all levels of detail of a mesh.
+    uint32_t GetIndexCount( const MeshRecord& mesh ) const;
+    // The raw index data (IndexSize bytes per index).
+    const void* GetIndexData( const MeshRecord& mesh ) const;
+    // Read a single index (regardless of the index size).
+    uint32_t GetIndex( const MeshRecord& mesh, uint32_t i ) const;
+
+private:
+    // Check that all of the offsets and counts in the file are within the bounds of the file.
+    bool Validate() const;
+
+    template<typename T>
+    const T* GetData( uint64_t offset ) const;
+
+    const uint8_t* m_pData;
+    uint64_t m_Size;
+
+    // The scene cache is stored here if it was built from an Assimp scene.
+    std::vector<uint8_t> m_Image;
+
+    // Handles to the memory mapped file.
+    HANDLE m_hFile;
+    HANDLE m_hFileMapping;
+};
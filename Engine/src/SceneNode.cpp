@@ -154,6 +154,7 @@ void SceneNode::AddMesh( std::shared_ptr<Mesh> mesh )
     if ( iter == m_Meshes.end() )
     {
         m_Meshes.push_back( mesh );
+        m_MeshLods.push_back( 0 );
     }
 }
 
@@ -163,10 +164,24 @@ void SceneNode::RemoveMesh( std::shared_ptr<Mesh> mesh )
     MeshList::iterator iter = std::find( m_Meshes.begin(), m_Meshes.end(), mesh );
     if ( iter != m_Meshes.end() )
     {
+        m_MeshLods.erase( m_MeshLods.begin() + ( iter - m_Meshes.begin() ) );
         m_Meshes.erase( iter );
     }
 }
 
+uint32_t SceneNode::GetMeshLod( size_t meshIndex ) const
+{
+    return ( meshIndex < m_MeshLods.size() ) ? m_MeshLods[meshIndex] : 0;
+}
+
+void SceneNode::SetMeshLod( size_t meshIndex, uint32_t lod )
+{
+    if ( meshIndex < m_MeshLods.size() )
+    {
+        m_MeshLods[meshIndex] = lod;
+    }
+}
+
 void SceneNode::Render( RenderEventArgs& args )
 {
     // First render all my meshes.
@@ -29,3 +29,21 @@ void ShaderParameter::Set<StructuredBuffer>( std::shared_ptr<StructuredBuffer> v
 {
     SetStructuredBuffer( value );
 }
+
+template<>
+void ShaderParameter::BindResource<ConstantBuffer>( std::shared_ptr<ConstantBuffer> value )
+{
+    if ( value )
+    {
+        BindConstantBuffer( *value );
+    }
+}
+
+template<>
+void ShaderParameter::BindResource<StructuredBuffer>( std::shared_ptr<StructuredBuffer> value )
+{
+    if ( value )
+    {
+        BindStructuredBuffer( *value );
+    }
+}
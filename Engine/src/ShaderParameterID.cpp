@@ -0,0 +1,83 @@
+#include <EnginePCH.h>
+
+#include <ShaderParameterID.h>
+
+#define INVALID_INDEX ( (uint32_t)-1 )
+
+// The names are never removed from the intern table.
+struct ShaderParameterNameTable
+{
+    std::mutex Mutex;
+    std::map<std::string, uint32_t> Indices;
+    // Points to the keys of the index map (map nodes are never moved).
+    std::vector<const std::string*> Names;
+};
+
+// Shader parameter IDs are usually static variables, so the table must
+// exist before the first static ID is constructed.
+static ShaderParameterNameTable& GetShaderParameterNameTable()
+{
+    static ShaderParameterNameTable nameTable;
+    return nameTable;
+}
+
+ShaderParameterID::ShaderParameterID()
+    : m_Index( INVALID_INDEX )
+{}
+
+ShaderParameterID::ShaderParameterID( const std::string& name )
+{
+    ShaderParameterNameTable& nameTable = GetShaderParameterNameTable();
+    std::lock_guard<std::mutex> lock( nameTable.Mutex );
+
+    auto iter = nameTable.Indices.find( name );
+    if ( iter == nameTable.Indices.end() )
+    {
+        iter = nameTable.Indices.insert( std::make_pair( name, (uint32_t)nameTable.Names.size() ) ).first;
+        nameTable.Names.push_back( &iter->first );
+    }
+
+    m_Index = iter->second;
+}
+
+uint32_t ShaderParameterID::GetIndex() const
+{
+    return m_Index;
+}
+
+const std::string& ShaderParameterID::GetName() const
+{
+    static const std::string invalidName;
+    if ( !IsValid() )
+    {
+        return invalidName;
+    }
+
+    ShaderParameterNameTable& nameTable = GetShaderParameterNameTable();
+    std::lock_guard<std::mutex> lock( nameTable.Mutex );
+
+    return *nameTable.Names[m_Index];
+}
+
+bool ShaderParameterID::IsValid() const
+{
+    return m_Index != INVALID_INDEX;
+}
+
+bool ShaderParameterID::operator==( const ShaderParameterID& other ) const
+{
+    return m_Index == other.m_Index;
+}
+
+bool ShaderParameterID::operator!=( const ShaderParameterID& other ) const
+{
+    return m_Index != other.m_Index;
+}
+
+uint32_t ShaderParameterID::GetNumIDs()
+{
+    ShaderParameterNameTable& nameTable = GetShaderParameterNameTable();
+    std::lock_guard<std::mutex> lock( nameTable.Mutex );
+
+    return (uint32_t)nameTable.Names.size();
+}
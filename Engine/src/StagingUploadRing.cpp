@@ -0,0 +1,120 @@
+#include <EnginePCH.h>
+
+#include <StagingUploadRing.h>
+
+StagingUploadRing::StagingUploadRing( void* pMemory, size_t size )
+    : m_pMemory( static_cast<uint8_t*>( pMemory ) )
+    , m_Size( size )
+    , m_Head( 0 )
+    , m_Tail( 0 )
+{
+    if ( m_pMemory == nullptr || m_Size == 0 )
+    {
+        ReportError( "The staging ring must have staging memory." );
+    }
+}
+
+StagingUploadRing::~StagingUploadRing()
+{}
+
+bool StagingUploadRing::Upload( const void* destination, size_t destinationOffset, const void* data, size_t size, size_t alignment )
+{
+    if ( size == 0 ) return true;
+    if ( size > m_Size || alignment == 0 ) return false;
+
+    uint64_t head = m_Head;
+    size_t offset = (size_t)( head % m_Size );
+    size_t alignedOffset = ( ( offset + alignment - 1 ) / alignment ) * alignment;
+    // Skip the memory at the end of the ring if the data doesn't fit.
+    if ( alignedOffset + size > m_Size )
+    {
+        head += m_Size - offset;
+        alignedOffset = 0;
+    }
+    else
+    {
+        head += alignedOffset - offset;
+    }
+
+    if ( head + size - m_Tail > m_Size )
+    {
+        return false;
+    }
+
+    memcpy( m_pMemory + alignedOffset, data, size );
+    m_Head = head + size;
+
+    CopyRegion upload = { destination, destinationOffset, alignedOffset, size };
+    m_PendingUploads.push_back( upload );
+
+    return true;
+}
+
+const StagingUploadRing::CopyRegionList& StagingUploadRing::Flush()
+{
+    // Group the uploads by destination. The sort is stable, so the uploads
+    // to the same destination stay in the order they were made.
+    std::stable_sort( m_PendingUploads.begin(), m_PendingUploads.end(), []( const CopyRegion& a, const CopyRegion& b )
+    {
+        return std::less<const void*>()( a.Destination, b.Destination );
+    } );
+
+    m_CopyRegions.clear();
+    for ( const CopyRegion& upload : m_PendingUploads )
+    {
+        if ( !m_CopyRegions.empty() )
+        {
+            CopyRegion& previous = m_CopyRegions.back();
+            if ( previous.Destination == upload.Destination &&
+                 previous.DestinationOffset + previous.Size == upload.DestinationOffset &&
+                 previous.SourceOffset + previous.Size == upload.SourceOffset )
+            {
+                previous.Size += upload.Size;
+                continue;
+            }
+        }
+        m_CopyRegions.push_back( upload );
+    }
+
+    m_PendingUploads.clear();
+
+    return m_CopyRegions;
+}
+
+bool StagingUploadRing::HasPendingUploads() const
+{
+    return !m_PendingUploads.empty();
+}
+
+void StagingUploadRing::EndFrame( uint64_t fenceValue )
+{
+    Frame frame;
+    frame.FenceValue = fenceValue;
+    frame.End = m_Head;
+    m_Frames.push_back( frame );
+}
+
+void StagingUploadRing::Retire( uint64_t completedFenceValue )
+{
+    while ( !m_Frames.empty() && m_Frames.front().FenceValue <= completedFenceValue )
+    {
+        m_Tail = m_Frames.front().End;
+        m_Frames.pop_front();
+    }
+}
+
+const uint8_t* StagingUploadRing::GetData( size_t offset ) const
+{
+    assert( offset < m_Size );
+    return m_pMemory + offset;
+}
+
+size_t StagingUploadRing::GetSize() const
+{
+    return m_Size;
+}
+
+size_t StagingUploadRing::GetUsedSize() const
+{
+    return (size_t)( m_Head - m_Tail );
+}
@@ -0,0 +1,95 @@
+#include <EnginePCH.h>
+
+#include <StateCacheStatistics.h>
+
+static const char* gs_StateNames[] =
+{
+    "Shader",
+    "InputLayout",
+    "ConstantBuffer",
+    "ShaderResource",
+    "Sampler",
+    "UnorderedAccess",
+    "VertexBuffer",
+    "IndexBuffer",
+    "PrimitiveTopology",
+    "BlendState",
+    "RasterizerState",
+    "Viewports",
+    "ScissorRects",
+    "DepthStencilState",
+    "RenderTargets",
+};
+
+static_assert( _countof( gs_StateNames ) == (size_t)StateCacheStatistics::State::NumStates, "Missing state name." );
+
+StateCacheStatistics::StateCacheStatistics()
+{
+    Reset();
+}
+
+void StateCacheStatistics::Reset()
+{
+    Frames = 0;
+    for ( size_t i = 0; i < (size_t)State::NumStates; ++i )
+    {
+        Issued[i] = 0;
+        Skipped[i] = 0;
+    }
+}
+
+void StateCacheStatistics::Add( const StateCacheStatistics& other )
+{
+    for ( size_t i = 0; i < (size_t)State::NumStates; ++i )
+    {
+        Issued[i] += other.Issued[i];
+        Skipped[i] += other.Skipped[i];
+    }
+}
+
+void StateCacheStatistics::Issue( State state )
+{
+    ++Issued[(size_t)state];
+}
+
+void StateCacheStatistics::Skip( State state )
+{
+    ++Skipped[(size_t)state];
+}
+
+uint64_t StateCacheStatistics::GetNumIssued() const
+{
+    uint64_t numIssued = 0;
+    for ( uint64_t issued : Issued )
+    {
+        numIssued += issued;
+    }
+    return numIssued;
+}
+
+uint64_t StateCacheStatistics::GetNumSkipped() const
+{
+    uint64_t numSkipped = 0;
+    for ( uint64_t skipped : Skipped )
+    {
+        numSkipped += skipped;
+    }
+    return numSkipped;
+}
+
+void StateCacheStatistics::Report( const std::string& deviceName ) const
+{
+    double frames = (double)std::max<uint64_t>( Frames, 1 );
+
+    std::stringstream ss;
+    ss << deviceName << " state changes per frame (" << Frames << " frames): "
+        << GetNumIssued() / frames << " issued, " << GetNumSkipped() / frames << " skipped" << std::endl;
+    for ( size_t i = 0; i < (size_t)State::NumStates; ++i )
+    {
+        if ( Issued[i] > 0 || Skipped[i] > 0 )
+        {
+            ss << "    " << gs_StateNames[i] << ": " << Issued[i] / frames << " issued, " << Skipped[i] / frames << " skipped" << std::endl;
+        }
+    }
+    OutputDebugStringA( ss.str().c_str() );
+}
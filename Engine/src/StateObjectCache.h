@@ -0,0 +1,134 @@
+#pragma once
+
+#include <ContentHash.h>
+
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * A hash-keyed cache of immutable state objects (blend, rasterizer,
+ * depth-stencil and sampler states or complete pipeline state objects).
+ * An object is only created the first time its description is requested.
+ * Every request for the same description after that returns the same object.
+ * Descriptions are hashed and compared bytewise, so they must be plain structures
+ * that are zero-initialized (including padding) before they are filled in.
+ * The cache can be used from multiple threads. The returned references stay valid
+ * until the cache is cleared.
+ */
+template<typename Desc, typename Object>
+class StateObjectCache
+{
+public:
+    StateObjectCache();
+
+    // Returns the object that was created for the description or
+    // calls create( desc ) if the description was not requested before.
+    template<typename CreateFunc>
+    const Object& GetOrCreate( const Desc& desc, CreateFunc create );
+
+    // Release all of the cached objects (the counters are not reset).
+    void Clear();
+
+    // The number of unique descriptions in the cache.
+    size_t GetNumObjects() const;
+    // The number of requests that returned a cached object.
+    uint64_t GetNumHits() const;
+    // The number of requests that created a new object.
+    uint64_t GetNumMisses() const;
+
+    // Write the number of objects, hits and misses on a single line.
+    void Report( std::ostream& os, const std::string& name ) const;
+
+private:
+    struct Entry
+    {
+        Desc Description;
+        Object Value;
+    };
+
+    // Descriptions with the same hash are compared to find the right entry.
+    // The entries are allocated separately so references to them stay valid.
+    typedef std::vector< std::unique_ptr<Entry> > EntryList;
+    typedef std::unordered_map<uint64_t, EntryList> EntryMap;
+
+    // Guards the entries and the counters. The create function is called while
+    // the lock is held, so it must not request an object from the same cache.
+    mutable std::mutex m_Mutex;
+
+    EntryMap m_Entries;
+    size_t m_NumObjects;
+    uint64_t m_NumHits;
+    uint64_t m_NumMisses;
+};
+
+template<typename Desc, typename Object>
+StateObjectCache<Desc, Object>::StateObjectCache()
+    : m_NumObjects( 0 )
+    , m_NumHits( 0 )
+    , m_NumMisses( 0 )
+{}
+
+template<typename Desc, typename Object>
+template<typename CreateFunc>
+const Object& StateObjectCache<Desc, Object>::GetOrCreate( const Desc& desc, CreateFunc create )
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+
+    EntryList& entries = m_Entries[ContentHash::Hash( &desc, sizeof( Desc ) )];
+
+    for ( const std::unique_ptr<Entry>& entry : entries )
+    {
+        if ( memcmp( &entry->Description, &desc, sizeof( Desc ) ) == 0 )
+        {
+            ++m_NumHits;
+            return entry->Value;
+        }
+    }
+
+    ++m_NumMisses;
+
+    std::unique_ptr<Entry> entry( new Entry() );
+    memcpy( &entry->Description, &desc, sizeof( Desc ) );
+    entry->Value = create( desc );
+
+    entries.push_back( std::move( entry ) );
+    ++m_NumObjects;
+
+    return entries.back()->Value;
+}
+
+template<typename Desc, typename Object>
+void StateObjectCache<Desc, Object>::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    m_Entries.clear();
+    m_NumObjects = 0;
+}
+
+template<typename Desc, typename Object>
+size_t StateObjectCache<Desc, Object>::GetNumObjects() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    return m_NumObjects;
+}
+
+template<typename Desc, typename Object>
+uint64_t StateObjectCache<Desc, Object>::GetNumHits() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    return m_NumHits;
+}
+
+template<typename Desc, typename Object>
+uint64_t StateObjectCache<Desc, Object>::GetNumMisses() const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    return m_NumMisses;
+}
+
+template<typename Desc, typename Object>
+void StateObjectCache<Desc, Object>::Report( std::ostream& os, const std::string& name ) const
+{
+    std::lock_guard<std::mutex> lock( m_Mutex );
+    os << "    " << name << ": " << m_NumObjects << " objects, " << m_NumHits << " hits, " << m_NumMisses << " misses" << std::endl;
+}
@@ -0,0 +1,910 @@
+#include <EnginePCH.h>
+
+#include "TextureProcessing.h"
+
+#include <xmmintrin.h>
+
+// The width of the Kaiser filter (in destination texels on each side of the center).
+#define KAISER_WIDTH 3.0f
+// The shape of the Kaiser window.
+#define KAISER_ALPHA 4.0f
+// The number of entries of the table that converts linear values to sRGB.
+#define LINEAR_TO_SRGB_TABLE_SIZE 16384
+// The number of iterations of the search for the alpha scale that preserves the coverage.
+#define ALPHA_COVERAGE_ITERATIONS 16
+// The maximum scale that is applied to the alpha channel to preserve the coverage.
+#define MAX_ALPHA_SCALE 4.0f
+
+// DDS file format.
+// See: https://msdn.microsoft.com/en-us/library/windows/desktop/bb943991(v=vs.85).aspx
+#define DDS_MAGIC 0x20534444 // "DDS "
+#define DDS_FOURCC_DX10 0x30315844 // "DX10"
+#define DDSD_CAPS 0x1
+#define DDSD_HEIGHT 0x2
+#define DDSD_WIDTH 0x4
+#define DDSD_PITCH 0x8
+#define DDSD_LINEARSIZE 0x80000
+#define DDSD_PIXELFORMAT 0x1000
+#define DDSD_MIPMAPCOUNT 0x20000
+#define DDPF_FOURCC 0x4
+#define DDSCAPS_COMPLEX 0x8
+#define DDSCAPS_TEXTURE 0x1000
+#define DDSCAPS_MIPMAP 0x400000
+#define DDS_DIMENSION_TEXTURE2D 3
+#define DDS_ALPHA_MODE_STRAIGHT 0x1
+#define DDS_ALPHA_MODE_OPAQUE 0x3
+
+#pragma pack( push, 1 )
+struct DDSPixelFormat
+{
+    uint32_t Size;
+    uint32_t Flags;
+    uint32_t FourCC;
+    uint32_t RGBBitCount;
+    uint32_t RBitMask;
+    uint32_t GBitMask;
+    uint32_t BBitMask;
+    uint32_t ABitMask;
+};
+
+struct DDSHeader
+{
+    uint32_t Size;
+    uint32_t Flags;
+    uint32_t Height;
+    uint32_t Width;
+    uint32_t PitchOrLinearSize;
+    uint32_t Depth;
+    uint32_t MipMapCount;
+    uint32_t Reserved1[11];
+    DDSPixelFormat PixelFormat;
+    uint32_t Caps;
+    uint32_t Caps2;
+    uint32_t Caps3;
+    uint32_t Caps4;
+    uint32_t Reserved2;
+};
+
+struct DDSHeaderDX10
+{
+    uint32_t Format;
+    uint32_t ResourceDimension;
+    uint32_t MiscFlag;
+    uint32_t ArraySize;
+    uint32_t MiscFlags2;
+};
+#pragma pack( pop )
+
+TextureImage::TextureImage()
+    : Format( DXGI_FORMAT_UNKNOWN )
+    , SourceBitsPerPixel( 0 )
+    , IsTransparent( false )
+{}
+
+// Conversion tables between sRGB and linear values.
+struct ColorSpaceTables
+{
+    ColorSpaceTables()
+    {
+        for ( int i = 0; i < 256; ++i )
+        {
+            float c = i / 255.0f;
+            SRGBToLinear[i] = ( c <= 0.04045f ) ? c / 12.92f : powf( ( c + 0.055f ) / 1.055f, 2.4f );
+        }
+        for ( int i = 0; i < LINEAR_TO_SRGB_TABLE_SIZE; ++i )
+        {
+            float c = i / (float)( LINEAR_TO_SRGB_TABLE_SIZE - 1 );
+            float s = ( c <= 0.0031308f ) ? c * 12.92f : 1.055f * powf( c, 1.0f / 2.4f ) - 0.055f;
+            LinearToSRGB[i] = static_cast<uint8_t>( s * 255.0f + 0.5f );
+        }
+    }
+
+    float SRGBToLinear[256];
+    uint8_t LinearToSRGB[LINEAR_TO_SRGB_TABLE_SIZE];
+};
+
+static const ColorSpaceTables& GetColorSpaceTables()
+{
+    static const ColorSpaceTables tables;
+    return tables;
+}
+
+// A texel of the source image that contributes to a destination texel.
+struct FilterTap
+{
+    uint32_t Index;
+    float Weight;
+};
+
+// The taps of each destination texel along one axis.
+struct FilterKernel
+{
+    std::vector<uint32_t> FirstTap;
+    std::vector<FilterTap> Taps;
+};
+
+// Modified Bessel function of the first kind (for the Kaiser window).
+static float BesselI0( float x )
+{
+    float sum = 1.0f;
+    float term = 1.0f;
+    for ( int k = 1; k < 32; ++k )
+    {
+        term *= ( x * 0.5f / k ) * ( x * 0.5f / k );
+        sum += term;
+        if ( term < sum * 1e-8f ) break;
+    }
+    return sum;
+}
+
+static float Sinc( float x )
+{
+    if ( fabsf( x ) < 1e-5f ) return 1.0f;
+    x *= glm::pi<float>();
+    return sinf( x ) / x;
+}
+
+// Compute the filter weights to downsample from srcSize to dstSize texels.
+// Textures are sampled with wrapping so the taps wrap around the edges.
+static void ComputeFilterKernel( uint32_t srcSize, uint32_t dstSize, MipFilter filter, FilterKernel& kernel )
+{
+    kernel.FirstTap.resize( dstSize + 1 );
+    kernel.Taps.clear();
+
+    float scale = (float)srcSize / (float)dstSize;
+    float support = ( filter == MipFilter::Box ) ? scale * 0.5f : scale * KAISER_WIDTH;
+    float windowScale = 1.0f / BesselI0( KAISER_ALPHA );
+
+    for ( uint32_t x = 0; x < dstSize; ++x )
+    {
+        kernel.FirstTap[x] = static_cast<uint32_t>( kernel.Taps.size() );
+
+        float center = ( x + 0.5f ) * scale;
+        int first = static_cast<int>( floorf( center - support ) );
+        int last = static_cast<int>( ceilf( center + support ) );
+
+        float weightSum = 0.0f;
+        for ( int i = first; i < last; ++i )
+        {
+            float weight = 0.0f;
+            if ( filter == MipFilter::Box )
+            {
+                // The overlap of the source texel with the destination texel.
+                weight = std::min( i + 1.0f, center + support ) - std::max( (float)i, center - support );
+            }
+            else
+            {
+                // The distance to the center in destination texels.
+                float t = ( i + 0.5f - center ) / scale;
+                float w = t / KAISER_WIDTH;
+                if ( fabsf( w ) < 1.0f )
+                {
+                    weight = Sinc( t ) * BesselI0( KAISER_ALPHA * sqrtf( 1.0f - w * w ) ) * windowScale;
+                }
+            }
+
+            if ( weight != 0.0f )
+            {
+                FilterTap tap = { static_cast<uint32_t>( ( i % (int)srcSize + (int)srcSize ) % (int)srcSize ), weight };
+                kernel.Taps.push_back( tap );
+                weightSum += weight;
+            }
+        }
+
+        for ( size_t i = kernel.FirstTap[x]; i < kernel.Taps.size(); ++i )
+        {
+            kernel.Taps[i].Weight /= weightSum;
+        }
+    }
+
+    kernel.FirstTap[dstSize] = static_cast<uint32_t>( kernel.Taps.size() );
+}
+
+// Downsample a floating point image with a separable filter.
+// Each texel is processed as a single SSE vector (4 channels).
+static void DownsampleImage( const std::vector<glm::vec4>& src, uint32_t srcWidth, uint32_t srcHeight,
+                             std::vector<glm::vec4>& dst, uint32_t dstWidth, uint32_t dstHeight, MipFilter filter )
+{
+    FilterKernel horizontal, vertical;
+    ComputeFilterKernel( srcWidth, dstWidth, filter, horizontal );
+    ComputeFilterKernel( srcHeight, dstHeight, filter, vertical );
+
+    // Filter the rows.
+    std::vector<glm::vec4> rows( (size_t)dstWidth * srcHeight );
+    for ( uint32_t y = 0; y < srcHeight; ++y )
+    {
+        const glm::vec4* srcRow = &src[(size_t)y * srcWidth];
+        glm::vec4* dstRow = &rows[(size_t)y * dstWidth];
+        for ( uint32_t x = 0; x < dstWidth; ++x )
+        {
+            __m128 sum = _mm_setzero_ps();
+            for ( uint32_t i = horizontal.FirstTap[x]; i < horizontal.FirstTap[x + 1]; ++i )
+            {
+                const FilterTap& tap = horizontal.Taps[i];
+                sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( tap.Weight ), _mm_loadu_ps( &srcRow[tap.Index].x ) ) );
+            }
+            _mm_storeu_ps( &dstRow[x].x, sum );
+        }
+    }
+
+    // Filter the columns (whole rows at a time so the memory is accessed in order).
+    dst.assign( (size_t)dstWidth * dstHeight, glm::vec4( 0 ) );
+    for ( uint32_t y = 0; y < dstHeight; ++y )
+    {
+        glm::vec4* dstRow = &dst[(size_t)y * dstWidth];
+        for ( uint32_t i = vertical.FirstTap[y]; i < vertical.FirstTap[y + 1]; ++i )
+        {
+            const FilterTap& tap = vertical.Taps[i];
+            const glm::vec4* srcRow = &rows[(size_t)tap.Index * dstWidth];
+            __m128 weight = _mm_set1_ps( tap.Weight );
+            for ( uint32_t x = 0; x < dstWidth; ++x )
+            {
+                __m128 sum = _mm_loadu_ps( &dstRow[x].x );
+                _mm_storeu_ps( &dstRow[x].x, _mm_add_ps( sum, _mm_mul_ps( weight, _mm_loadu_ps( &srcRow[x].x ) ) ) );
+            }
+        }
+    }
+}
+
+// The fraction of the texels that pass the alpha test after the alpha channel is scaled.
+static float ComputeAlphaCoverage( const std::vector<glm::vec4>& texels, int channel, float alphaReference, float scale )
+{
+    size_t numCovered = 0;
+    for ( const glm::vec4& texel : texels )
+    {
+        if ( std::min( texel[channel] * scale, 1.0f ) >= alphaReference ) ++numCovered;
+    }
+    return (float)numCovered / (float)std::max<size_t>( texels.size(), 1 );
+}
+
+// Find the scale of the alpha channel of a mip level that gives the same coverage as the first level.
+// See: "Computing Alpha Mipmaps" (Ignacio Castaño, 2010).
+static float FindAlphaScale( const std::vector<glm::vec4>& texels, int channel, float alphaReference, float coverage )
+{
+    float minScale = 0.0f;
+    float maxScale = MAX_ALPHA_SCALE;
+    for ( int i = 0; i < ALPHA_COVERAGE_ITERATIONS; ++i )
+    {
+        float scale = ( minScale + maxScale ) * 0.5f;
+        if ( ComputeAlphaCoverage( texels, channel, alphaReference, scale ) < coverage )
+        {
+            minScale = scale;
+        }
+        else
+        {
+            maxScale = scale;
+        }
+    }
+
+    // The coverage is a step function of the scale so use the side of the step that is closer to the coverage of the first level.
+    float minCoverage = ComputeAlphaCoverage( texels, channel, alphaReference, minScale );
+    float maxCoverage = ComputeAlphaCoverage( texels, channel, alphaReference, maxScale );
+    return ( coverage - minCoverage < maxCoverage - coverage ) ? minScale : maxScale;
+}
+
+bool CanGenerateMipmaps( DXGI_FORMAT format )
+{
+    switch ( format )
+    {
+    case DXGI_FORMAT_R8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+uint32_t GetBitsPerPixel( DXGI_FORMAT format )
+{
+    switch ( format )
+    {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC4_UNORM:
+        return 4;
+    case DXGI_FORMAT_R8_UNORM:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC5_UNORM:
+        return 8;
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+        return 32;
+    default:
+        return 0;
+    }
+}
+
+bool IsCompressed( DXGI_FORMAT format )
+{
+    switch ( format )
+    {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC5_UNORM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+size_t GetUncompressedSize( const TextureImage& image )
+{
+    size_t size = 0;
+    for ( const TextureImage::Level& level : image.Levels )
+    {
+        size += (size_t)level.Width * level.Height * image.SourceBitsPerPixel / 8;
+    }
+    return size;
+}
+
+// Compute the size of a mip level. Returns false if the format is not supported.
+// The rows of compressed formats are rows of 4x4 blocks.
+static bool GetLevelLayout( DXGI_FORMAT format, uint32_t width, uint32_t height, uint32_t& rowPitch, size_t& size )
+{
+    uint32_t bitsPerPixel = GetBitsPerPixel( format );
+    if ( bitsPerPixel == 0 ) return false;
+
+    if ( IsCompressed( format ) )
+    {
+        rowPitch = ( ( width + 3 ) / 4 ) * bitsPerPixel * 2;
+        size = (size_t)rowPitch * ( ( height + 3 ) / 4 );
+    }
+    else
+    {
+        rowPitch = width * bitsPerPixel / 8;
+        size = (size_t)rowPitch * height;
+    }
+    return true;
+}
+
+void GenerateMipmaps( const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t pitch, DXGI_FORMAT format, bool isTransparent,
+                      TextureUsage usage, MipFilter filter, float alphaReference, TextureImage& result )
+{
+    assert( CanGenerateMipmaps( format ) );
+
+    const ColorSpaceTables& tables = GetColorSpaceTables();
+    const uint32_t numChannels = GetBitsPerPixel( format ) / 8;
+    const bool isNormalMap = ( usage == TextureUsage::NormalMap && numChannels >= 3 );
+
+    // The color channels of color textures are stored in sRGB. The alpha channel is always linear.
+    bool isSRGB[4] = {};
+    if ( usage == TextureUsage::Color )
+    {
+        for ( uint32_t c = 0; c < std::min( numChannels, 3u ); ++c ) isSRGB[c] = true;
+    }
+
+    // The channel that is alpha tested (-1 if the coverage doesn't need to be preserved).
+    int alphaChannel = -1;
+    if ( usage == TextureUsage::Opacity )
+    {
+        alphaChannel = 0;
+    }
+    else if ( usage == TextureUsage::Color && isTransparent && numChannels == 4 )
+    {
+        alphaChannel = 3;
+    }
+
+    result.Format = format;
+    result.SourceBitsPerPixel = GetBitsPerPixel( format );
+    result.IsTransparent = isTransparent;
+    result.Levels.clear();
+    result.Data.clear();
+
+    // Compute the layout of the mip chain.
+    uint32_t levelWidth = width;
+    uint32_t levelHeight = height;
+    size_t dataSize = 0;
+    while ( true )
+    {
+        TextureImage::Level level = {};
+        level.Width = levelWidth;
+        level.Height = levelHeight;
+        level.Offset = dataSize;
+        GetLevelLayout( format, levelWidth, levelHeight, level.RowPitch, level.Size );
+        result.Levels.push_back( level );
+        dataSize += level.Size;
+
+        if ( levelWidth == 1 && levelHeight == 1 ) break;
+        levelWidth = std::max( levelWidth / 2, 1u );
+        levelHeight = std::max( levelHeight / 2, 1u );
+    }
+    result.Data.resize( dataSize );
+
+    // The first level is a copy of the image.
+    const TextureImage::Level& firstLevel = result.Levels[0];
+    for ( uint32_t y = 0; y < height; ++y )
+    {
+        memcpy( &result.Data[firstLevel.Offset + (size_t)y * firstLevel.RowPitch], pixels + (size_t)y * pitch, firstLevel.RowPitch );
+    }
+
+    // Convert the first level to linear floating point values.
+    std::vector<glm::vec4> texels( (size_t)width * height, glm::vec4( 0, 0, 0, 1 ) );
+    for ( uint32_t y = 0; y < height; ++y )
+    {
+        const uint8_t* row = pixels + (size_t)y * pitch;
+        for ( uint32_t x = 0; x < width; ++x )
+        {
+            glm::vec4& texel = texels[(size_t)y * width + x];
+            for ( uint32_t c = 0; c < numChannels; ++c )
+            {
+                uint8_t value = row[x * numChannels + c];
+                texel[c] = isSRGB[c] ? tables.SRGBToLinear[value] : value / 255.0f;
+            }
+        }
+    }
+
+    float alphaCoverage = ( alphaChannel >= 0 ) ? ComputeAlphaCoverage( texels, alphaChannel, alphaReference, 1.0f ) : 0.0f;
+
+    // Each level is filtered from the previous level.
+    std::vector<glm::vec4> levelTexels;
+    for ( size_t i = 1; i < result.Levels.size(); ++i )
+    {
+        const TextureImage::Level& previous = result.Levels[i - 1];
+        const TextureImage::Level& level = result.Levels[i];
+        DownsampleImage( texels, previous.Width, previous.Height, levelTexels, level.Width, level.Height, filter );
+        texels.swap( levelTexels );
+
+        if ( isNormalMap )
+        {
+            for ( glm::vec4& texel : texels )
+            {
+                glm::vec3 normal = glm::vec3( texel ) * 2.0f - 1.0f;
+                float length = glm::length( normal );
+                if ( length > 0.0f )
+                {
+                    normal = normal / length * 0.5f + 0.5f;
+                    texel = glm::vec4( normal, texel.w );
+                }
+            }
+        }
+
+        // The alpha channel is only scaled in the stored level so the scale does not accumulate.
+        float alphaScale = ( alphaChannel >= 0 ) ? FindAlphaScale( texels, alphaChannel, alphaReference, alphaCoverage ) : 1.0f;
+
+        // Convert the level back to 8-bit values.
+        for ( uint32_t y = 0; y < level.Height; ++y )
+        {
+            uint8_t* row = &result.Data[level.Offset + (size_t)y * level.RowPitch];
+            for ( uint32_t x = 0; x < level.Width; ++x )
+            {
+                const glm::vec4& texel = texels[(size_t)y * level.Width + x];
+                for ( uint32_t c = 0; c < numChannels; ++c )
+                {
+                    float value = ( (int)c == alphaChannel ) ? texel[c] * alphaScale : texel[c];
+                    value = glm::clamp( value, 0.0f, 1.0f );
+                    row[x * numChannels + c] = isSRGB[c] ? tables.LinearToSRGB[static_cast<int>( value * ( LINEAR_TO_SRGB_TABLE_SIZE - 1 ) + 0.5f )]
+                                                         : static_cast<uint8_t>( value * 255.0f + 0.5f );
+                }
+            }
+        }
+    }
+}
+
+// The number of texels in a compressed block.
+#define BLOCK_TEXELS 16
+// The number of iterations that are used to find the principal axis of the colors of a block.
+#define POWER_ITERATIONS 4
+
+// Read a 4x4 block of texels as RGBA values (texels outside of small mip levels repeat the edge texels).
+static void ReadBlock( const TextureImage& image, const TextureImage::Level& level, uint32_t blockX, uint32_t blockY, uint8_t texels[BLOCK_TEXELS][4] )
+{
+    const uint32_t numChannels = GetBitsPerPixel( image.Format ) / 8;
+    const bool isBGRA = ( image.Format == DXGI_FORMAT_B8G8R8A8_UNORM );
+
+    for ( uint32_t i = 0; i < BLOCK_TEXELS; ++i )
+    {
+        uint32_t x = std::min( blockX * 4 + ( i & 3 ), level.Width - 1 );
+        uint32_t y = std::min( blockY * 4 + ( i >> 2 ), level.Height - 1 );
+        const uint8_t* texel = &image.Data[level.Offset + (size_t)y * level.RowPitch + (size_t)x * numChannels];
+
+        if ( numChannels == 1 )
+        {
+            texels[i][0] = texel[0];
+            texels[i][1] = texels[i][2] = 0;
+            texels[i][3] = 255;
+        }
+        else
+        {
+            texels[i][0] = texel[isBGRA ? 2 : 0];
+            texels[i][1] = texel[1];
+            texels[i][2] = texel[isBGRA ? 0 : 2];
+            texels[i][3] = texel[3];
+        }
+    }
+}
+
+static uint16_t PackColor565( const glm::vec3& color )
+{
+    uint32_t r = static_cast<uint32_t>( glm::clamp( color.r, 0.0f, 255.0f ) * 31.0f / 255.0f + 0.5f );
+    uint32_t g = static_cast<uint32_t>( glm::clamp( color.g, 0.0f, 255.0f ) * 63.0f / 255.0f + 0.5f );
+    uint32_t b = static_cast<uint32_t>( glm::clamp( color.b, 0.0f, 255.0f ) * 31.0f / 255.0f + 0.5f );
+    return static_cast<uint16_t>( ( r << 11 ) | ( g << 5 ) | b );
+}
+
+static glm::vec3 UnpackColor565( uint16_t color )
+{
+    uint32_t r = ( color >> 11 ) & 31;
+    uint32_t g = ( color >> 5 ) & 63;
+    uint32_t b = color & 31;
+    return glm::vec3( ( r << 3 ) | ( r >> 2 ), ( g << 2 ) | ( g >> 4 ), ( b << 3 ) | ( b >> 2 ) );
+}
+
+// Choose the closest of the 4 colors of the palette for each texel.
+// Returns the sum of the squared errors.
+static float ComputeColorIndices( const glm::vec3 colors[BLOCK_TEXELS], uint16_t color0, uint16_t color1, uint32_t& indices )
+{
+    glm::vec3 palette[4];
+    palette[0] = UnpackColor565( color0 );
+    palette[1] = UnpackColor565( color1 );
+    palette[2] = ( palette[0] * 2.0f + palette[1] ) / 3.0f;
+    palette[3] = ( palette[0] + palette[1] * 2.0f ) / 3.0f;
+
+    float error = 0.0f;
+    indices = 0;
+    for ( uint32_t i = 0; i < BLOCK_TEXELS; ++i )
+    {
+        uint32_t bestIndex = 0;
+        float bestDistance = std::numeric_limits<float>::max();
+        for ( uint32_t j = 0; j < 4; ++j )
+        {
+            glm::vec3 delta = colors[i] - palette[j];
+            float distance = glm::dot( delta, delta );
+            if ( distance < bestDistance )
+            {
+                bestDistance = distance;
+                bestIndex = j;
+            }
+        }
+        indices |= bestIndex << ( i * 2 );
+        error += bestDistance;
+    }
+    return error;
+}
+
+// Compress the colors of a block (BC1 in 4 color mode).
+// The end points are the extremes of the colors along their principal axis and
+// are refined once with a least squares fit to the chosen palette indices.
+static void CompressColorBlock( const uint8_t texels[BLOCK_TEXELS][4], uint8_t* block )
+{
+    glm::vec3 colors[BLOCK_TEXELS];
+    glm::vec3 mean( 0 );
+    for ( uint32_t i = 0; i < BLOCK_TEXELS; ++i )
+    {
+        colors[i] = glm::vec3( texels[i][0], texels[i][1], texels[i][2] );
+        mean += colors[i];
+    }
+    mean /= (float)BLOCK_TEXELS;
+
+    // The covariance matrix of the colors.
+    glm::mat3 covariance( 0 );
+    for ( uint32_t i = 0; i < BLOCK_TEXELS; ++i )
+    {
+        glm::vec3 delta = colors[i] - mean;
+        covariance += glm::outerProduct( delta, delta );
+    }
+
+    glm::vec3 axis( 1, 1, 1 );
+    for ( int i = 0; i < POWER_ITERATIONS; ++i )
+    {
+        axis = covariance * axis;
+        float length = glm::length( axis );
+        if ( length < 1e-6f ) break;
+        axis /= length;
+    }
+
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = -std::numeric_limits<float>::max();
+    for ( uint32_t i = 0; i < BLOCK_TEXELS; ++i )
+    {
+        float projection = glm::dot( colors[i] - mean, axis );
+        minProjection = std::min( minProjection, projection );
+        maxProjection = std::max( maxProjection, projection );
+    }
+
+    // Move the end points inside the range of the colors so the interpolated colors are used more.
+    float inset = ( maxProjection - minProjection ) / 16.0f;
+    uint16_t color0 = PackColor565( mean + axis * ( maxProjection - inset ) );
+    uint16_t color1 = PackColor565( mean + axis * ( minProjection + inset ) );
+    uint32_t indices;
+    float error = ComputeColorIndices( colors, color0, color1, indices );
+
+    // Solve for the end points that minimize the error for these indices.
+    static const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    glm::vec3 ax( 0 ), bx( 0 );
+    for ( uint32_t i = 0; i < BLOCK_TEXELS; ++i )
+    {
+        float a = weights[( indices >> ( i * 2 ) ) & 3];
+        float b = 1.0f - a;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        ax += colors[i] * a;
+        bx += colors[i] * b;
+    }
+    float determinant = aa * bb - ab * ab;
+    if ( fabsf( determinant ) > 1e-6f )
+    {
+        uint16_t refinedColor0 = PackColor565( ( ax * bb - bx * ab ) / determinant );
+        uint16_t refinedColor1 = PackColor565( ( bx * aa - ax * ab ) / determinant );
+        uint32_t refinedIndices;
+        float refinedError = ComputeColorIndices( colors, refinedColor0, refinedColor1, refinedIndices );
+        if ( refinedError < error )
+        {
+            color0 = refinedColor0;
+            color1 = refinedColor1;
+            indices = refinedIndices;
+        }
+    }
+
+    // The 4 color mode requires color0 > color1. Swapping the end points swaps indices 0 <-> 1 and 2 <-> 3.
+    if ( color0 < color1 )
+    {
+        std::swap( color0, color1 );
+        indices ^= 0x55555555;
+    }
+    else if ( color0 == color1 )
+    {
+        indices = 0;
+    }
+
+    memcpy( block, &color0, 2 );
+    memcpy( block + 2, &color1, 2 );
+    memcpy( block + 4, &indices, 4 );
+}
+
+// Compress one channel of a block (BC4 in 8 value mode).
+static void CompressChannelBlock( const uint8_t texels[BLOCK_TEXELS][4], uint32_t channel, uint8_t* block )
+{
+    uint8_t minValue = 255, maxValue = 0;
+    for ( uint32_t i = 0; i < BLOCK_TEXELS; ++i )
+    {
+        minValue = std::min( minValue, texels[i][channel] );
+        maxValue = std::max( maxValue, texels[i][channel] );
+    }
+
+    // The palette is value0, value1 and 6 values in between (if value0 > value1).
+    uint8_t palette[8];
+    palette[0] = maxValue;
+    palette[1] = minValue;
+    for ( uint32_t j = 0; j < 6; ++j )
+    {
+        palette[j + 2] = static_cast<uint8_t>( ( ( 6 - j ) * maxValue + ( 1 + j ) * minValue + 3 ) / 7 );
+    }
+
+    uint64_t indices = 0;
+    if ( maxValue > minValue )
+    {
+        for ( uint32_t i = 0; i < BLOCK_TEXELS; ++i )
+        {
+            uint32_t bestIndex = 0;
+            int bestDistance = 256;
+            for ( uint32_t j = 0; j < 8; ++j )
+            {
+                int distance = abs( (int)texels[i][channel] - (int)palette[j] );
+                if ( distance < bestDistance )
+                {
+                    bestDistance = distance;
+                    bestIndex = j;
+                }
+            }
+            indices |= (uint64_t)bestIndex << ( i * 3 );
+        }
+    }
+
+    block[0] = maxValue;
+    block[1] = minValue;
+    for ( uint32_t i = 0; i < 6; ++i )
+    {
+        block[2 + i] = static_cast<uint8_t>( indices >> ( i * 8 ) );
+    }
+}
+
+DXGI_FORMAT GetCompressedFormat( const TextureImage& image, TextureUsage usage )
+{
+    if ( image.Levels.empty() || !CanGenerateMipmaps( image.Format ) ) return DXGI_FORMAT_UNKNOWN;
+
+    // Only the first level of a block compressed texture has to be a multiple of the block size.
+    if ( image.Levels[0].Width % 4 != 0 || image.Levels[0].Height % 4 != 0 ) return DXGI_FORMAT_UNKNOWN;
+
+    if ( GetBitsPerPixel( image.Format ) == 8 ) return DXGI_FORMAT_BC4_UNORM;
+
+    switch ( usage )
+    {
+    case TextureUsage::Color:
+        return image.IsTransparent ? DXGI_FORMAT_BC3_UNORM : DXGI_FORMAT_BC1_UNORM;
+    case TextureUsage::NormalMap:
+        return DXGI_FORMAT_BC5_UNORM;
+    case TextureUsage::Linear:
+    case TextureUsage::Opacity:
+        // The shaders only read the first channel of these textures.
+        return DXGI_FORMAT_BC4_UNORM;
+    default:
+        return DXGI_FORMAT_UNKNOWN;
+    }
+}
+
+uint32_t PrepareCompression( const TextureImage& source, DXGI_FORMAT format, TextureImage& result )
+{
+    assert( IsCompressed( format ) );
+
+    result.Format = format;
+    result.SourceBitsPerPixel = source.SourceBitsPerPixel;
+    result.IsTransparent = source.IsTransparent;
+    result.Levels.clear();
+
+    uint32_t numRows = 0;
+    size_t dataSize = 0;
+    for ( const TextureImage::Level& sourceLevel : source.Levels )
+    {
+        TextureImage::Level level = sourceLevel;
+        level.Offset = dataSize;
+        GetLevelLayout( format, level.Width, level.Height, level.RowPitch, level.Size );
+        result.Levels.push_back( level );
+        dataSize += level.Size;
+        numRows += ( level.Height + 3 ) / 4;
+    }
+    result.Data.resize( dataSize );
+
+    return numRows;
+}
+
+void CompressBlockRows( const TextureImage& source, TextureImage& result, uint32_t begin, uint32_t end )
+{
+    const uint32_t blockSize = GetBitsPerPixel( result.Format ) * 2;
+
+    // Find the mip level of each row.
+    uint32_t firstRow = 0;
+    for ( size_t i = 0; i < result.Levels.size() && begin < end; ++i )
+    {
+        const TextureImage::Level& level = result.Levels[i];
+        uint32_t numRows = ( level.Height + 3 ) / 4;
+        uint32_t numBlocks = ( level.Width + 3 ) / 4;
+
+        for ( ; begin < end && begin < firstRow + numRows; ++begin )
+        {
+            uint32_t blockY = begin - firstRow;
+            uint8_t* row = &result.Data[level.Offset + (size_t)blockY * level.RowPitch];
+
+            for ( uint32_t blockX = 0; blockX < numBlocks; ++blockX )
+            {
+                uint8_t texels[BLOCK_TEXELS][4];
+                ReadBlock( source, source.Levels[i], blockX, blockY, texels );
+
+                uint8_t* block = row + blockX * blockSize;
+                switch ( result.Format )
+                {
+                case DXGI_FORMAT_BC1_UNORM:
+                    CompressColorBlock( texels, block );
+                    break;
+                case DXGI_FORMAT_BC3_UNORM:
+                    CompressChannelBlock( texels, 3, block );
+                    CompressColorBlock( texels, block + 8 );
+                    break;
+                case DXGI_FORMAT_BC4_UNORM:
+                    CompressChannelBlock( texels, 0, block );
+                    break;
+                case DXGI_FORMAT_BC5_UNORM:
+                    CompressChannelBlock( texels, 0, block );
+                    CompressChannelBlock( texels, 1, block + 8 );
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        firstRow += numRows;
+    }
+}
+
+void CompressTexture( const TextureImage& source, DXGI_FORMAT format, TextureImage& result )
+{
+    uint32_t numRows = PrepareCompression( source, format, result );
+    CompressBlockRows( source, result, 0, numRows );
+}
+
+bool SaveDDS( const std::wstring& fileName, const TextureImage& image )
+{
+    if ( image.Levels.empty() ) return false;
+
+    DDSHeader header = {};
+    header.Size = sizeof( DDSHeader );
+    header.Flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT;
+    header.Flags |= IsCompressed( image.Format ) ? DDSD_LINEARSIZE : DDSD_PITCH;
+    header.Width = image.Levels[0].Width;
+    header.Height = image.Levels[0].Height;
+    header.PitchOrLinearSize = IsCompressed( image.Format ) ? static_cast<uint32_t>( image.Levels[0].Size ) : image.Levels[0].RowPitch;
+    // The reserved fields are ignored by other readers. The first one stores the number of
+    // bits per pixel of the source image (which is used to guess the type of some textures).
+    header.Reserved1[0] = image.SourceBitsPerPixel;
+    header.Depth = 1;
+    header.MipMapCount = static_cast<uint32_t>( image.Levels.size() );
+    header.PixelFormat.Size = sizeof( DDSPixelFormat );
+    header.PixelFormat.Flags = DDPF_FOURCC;
+    header.PixelFormat.FourCC = DDS_FOURCC_DX10;
+    header.Caps = DDSCAPS_TEXTURE | ( image.Levels.size() > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0 );
+
+    DDSHeaderDX10 headerDX10 = {};
+    headerDX10.Format = image.Format;
+    headerDX10.ResourceDimension = DDS_DIMENSION_TEXTURE2D;
+    headerDX10.ArraySize = 1;
+    headerDX10.MiscFlags2 = image.IsTransparent ? DDS_ALPHA_MODE_STRAIGHT : DDS_ALPHA_MODE_OPAQUE;
+
+    // Write to a temporary file first and replace the cached file when it is complete.
+    std::wstringstream tempFileName;
+    tempFileName << fileName << L"." << GetCurrentProcessId() << L"." << GetCurrentThreadId() << L".tmp";
+
+    {
+        fs::ofstream file( fs::path( tempFileName.str() ), std::ios::binary | std::ios::trunc );
+        if ( !file.is_open() ) return false;
+
+        uint32_t magic = DDS_MAGIC;
+        file.write( reinterpret_cast<const char*>( &magic ), sizeof( magic ) );
+        file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+        file.write( reinterpret_cast<const char*>( &headerDX10 ), sizeof( headerDX10 ) );
+        file.write( reinterpret_cast<const char*>( image.Data.data() ), (std::streamsize)image.Data.size() );
+
+        if ( !file.good() ) return false;
+    }
+
+    boost::system::error_code errorCode;
+    fs::rename( fs::path( tempFileName.str() ), fs::path( fileName ), errorCode );
+    if ( errorCode )
+    {
+        fs::remove( fs::path( tempFileName.str() ), errorCode );
+        return false;
+    }
+
+    return true;
+}
+
+bool LoadDDS( const std::wstring& fileName, TextureImage& image )
+{
+    fs::ifstream file( fs::path( fileName ), std::ios::binary );
+    if ( !file.is_open() ) return false;
+
+    uint32_t magic = 0;
+    DDSHeader header = {};
+    DDSHeaderDX10 headerDX10 = {};
+    file.read( reinterpret_cast<char*>( &magic ), sizeof( magic ) );
+    file.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+    file.read( reinterpret_cast<char*>( &headerDX10 ), sizeof( headerDX10 ) );
+    if ( !file.good() ) return false;
+
+    // Only the files that are written by SaveDDS are supported.
+    if ( magic != DDS_MAGIC || header.Size != sizeof( DDSHeader ) || header.PixelFormat.FourCC != DDS_FOURCC_DX10 ||
+         headerDX10.ResourceDimension != DDS_DIMENSION_TEXTURE2D || headerDX10.ArraySize != 1 ||
+         header.Width == 0 || header.Height == 0 || header.MipMapCount == 0 || header.MipMapCount > 32 )
+    {
+        return false;
+    }
+
+    image.Format = static_cast<DXGI_FORMAT>( headerDX10.Format );
+    image.SourceBitsPerPixel = header.Reserved1[0];
+    image.IsTransparent = ( headerDX10.MiscFlags2 & 0x7 ) != DDS_ALPHA_MODE_OPAQUE;
+    image.Levels.clear();
+
+    uint32_t levelWidth = header.Width;
+    uint32_t levelHeight = header.Height;
+    size_t dataSize = 0;
+    for ( uint32_t i = 0; i < header.MipMapCount; ++i )
+    {
+        TextureImage::Level level = {};
+        level.Width = levelWidth;
+        level.Height = levelHeight;
+        level.Offset = dataSize;
+        if ( !GetLevelLayout( image.Format, levelWidth, levelHeight, level.RowPitch, level.Size ) ) return false;
+        image.Levels.push_back( level );
+        dataSize += level.Size;
+
+        levelWidth = std::max( levelWidth / 2, 1u );
+        levelHeight = std::max( levelHeight / 2, 1u );
+    }
+
+    image.Data.resize( dataSize );
+    file.read( reinterpret_cast<char*>( image.Data.data() ), (std::streamsize)dataSize );
+
+    return file.gcount() == (std::streamsize)dataSize;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * Functions to process textures when they are imported.
+ * The mipmaps of 8-bit images are generated on the CPU with a separable filter.
+ * Color textures are filtered in linear space (their texels are stored in sRGB),
+ * normal maps are renormalized and the alpha test coverage of cutout textures
+ * is preserved in every mip level (so foliage does not fade out in the distance).
+ * The mip chains are block compressed (BC1, BC3, BC4 or BC5 depending on how the texture is used).
+ * Processed textures are stored as DDS files so they can be uploaded without any processing.
+ */
+
+// How the texels of a texture are used by the shaders.
+enum class TextureUsage : uint32_t
+{
+    // sRGB encoded colors with an optional alpha channel.
+    Color,
+    // Linear data (for example, specular power or bump maps).
+    Linear,
+    // Normals that are encoded in the RGB channels.
+    NormalMap,
+    // Alpha tested opacity in the first channel.
+    Opacity,
+};
+
+// The filter that is used to downsample the mip levels.
+enum class MipFilter : uint32_t
+{
+    // The average of the texels that are covered by the destination texel.
+    Box,
+    // A windowed sinc filter (sharper than the box filter).
+    Kaiser,
+};
+
+// A 2D texture with all of its mip levels.
+struct TextureImage
+{
+    struct Level
+    {
+        uint32_t Width;
+        uint32_t Height;
+        // The size of a row of texels in bytes.
+        uint32_t RowPitch;
+        // The range of the level in Data.
+        size_t Offset;
+        size_t Size;
+    };
+
+    TextureImage();
+
+    DXGI_FORMAT Format;
+    // The number of bits per pixel of the decoded image the texture was created from.
+    // Textures that are block compressed use less memory per pixel.
+    uint32_t SourceBitsPerPixel;
+    // True if the alpha channel of the texture is used.
+    bool IsTransparent;
+    std::vector<Level> Levels;
+    std::vector<uint8_t> Data;
+};
+
+// Returns true if the mipmaps of images with this format can be generated on the CPU.
+bool CanGenerateMipmaps( DXGI_FORMAT format );
+
+// The number of bits per texel of a format that is supported by the texture cache.
+uint32_t GetBitsPerPixel( DXGI_FORMAT format );
+// Returns true if the format is block compressed (4x4 texel blocks).
+bool IsCompressed( DXGI_FORMAT format );
+// The size of the mip chain of an image if it was not compressed.
+size_t GetUncompressedSize( const TextureImage& image );
+
+// Generate the full mip chain of an image down to 1x1.
+// The first level is a copy of the image.
+// @param pitch The size of a row of the image in bytes.
+// @param isTransparent If true, the alpha test coverage of the alpha channel is preserved.
+// @param alphaReference The alpha test reference value that is used by the shaders.
+void GenerateMipmaps( const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t pitch, DXGI_FORMAT format, bool isTransparent,
+                      TextureUsage usage, MipFilter filter, float alphaReference, TextureImage& result );
+
+// Choose the block compressed format for a texture with a generated mip chain.
+// Color textures use BC1 (or BC3 if they are transparent), normal maps use BC5 (the shaders
+// reconstruct the Z component) and single channel data uses BC4 (the first channel).
+// Returns DXGI_FORMAT_UNKNOWN if the texture can't be compressed
+// (the size of the first level must be a multiple of the block size).
+DXGI_FORMAT GetCompressedFormat( const TextureImage& image, TextureUsage usage );
+
+// Prepare the compressed copy of an image. The blocks are compressed with CompressBlockRows.
+// Returns the number of rows of blocks in all mip levels.
+uint32_t PrepareCompression( const TextureImage& source, DXGI_FORMAT format, TextureImage& result );
+// Compress the rows [begin, end) of blocks (counted over all mip levels).
+// Different rows of the same image can be compressed in parallel.
+void CompressBlockRows( const TextureImage& source, TextureImage& result, uint32_t begin, uint32_t end );
+// Compress all of the blocks of an image on the calling thread.
+void CompressTexture( const TextureImage& source, DXGI_FORMAT format, TextureImage& result );
+
+// Write a texture to a DDS file. The file is written to a temporary file first so
+// other threads and processes never see partially written files.
+bool SaveDDS( const std::wstring& fileName, const TextureImage& image );
+// Read a texture from a DDS file that was written by SaveDDS.
+// Returns false if the file does not exist or can't be read.
+bool LoadDDS( const std::wstring& fileName, TextureImage& image );
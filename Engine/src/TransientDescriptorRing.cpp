@@ -0,0 +1,69 @@
+#include <EnginePCH.h>
+
+#include <TransientDescriptorRing.h>
+
+TransientDescriptorRing::TransientDescriptorRing( DescriptorPageHeap& heap, uint32_t numDescriptors )
+    : m_NumDescriptors( numDescriptors )
+    , m_Head( 0 )
+    , m_Tail( 0 )
+{
+    if ( m_NumDescriptors == 0 )
+    {
+        ReportError( "The descriptor ring must contain at least one descriptor." );
+    }
+
+    heap.CreatePage( m_NumDescriptors );
+}
+
+TransientDescriptorRing::~TransientDescriptorRing()
+{}
+
+DescriptorAllocation TransientDescriptorRing::Allocate( uint32_t count )
+{
+    if ( count == 0 || count > m_NumDescriptors ) return DescriptorAllocation();
+
+    uint64_t head = m_Head;
+    uint32_t offset = (uint32_t)( head % m_NumDescriptors );
+    // Skip the descriptors at the end of the ring if the range doesn't fit.
+    if ( offset + count > m_NumDescriptors )
+    {
+        head += m_NumDescriptors - offset;
+        offset = 0;
+    }
+
+    if ( head + count - m_Tail > m_NumDescriptors )
+    {
+        return DescriptorAllocation();
+    }
+
+    m_Head = head + count;
+
+    return DescriptorAllocation( 0, offset, count );
+}
+
+void TransientDescriptorRing::EndFrame( uint64_t fenceValue )
+{
+    Frame frame;
+    frame.FenceValue = fenceValue;
+    frame.End = m_Head;
+    m_Frames.push_back( frame );
+}
+
+void TransientDescriptorRing::Retire( uint64_t completedFenceValue )
+{
+    while ( !m_Frames.empty() && m_Frames.front().FenceValue <= completedFenceValue )
+    {
+        m_Tail = m_Frames.front().End;
+        m_Frames.pop_front();
+    }
+}
+
+uint32_t TransientDescriptorRing::GetNumDescriptors() const
+{
+    return m_NumDescriptors;
+}
+
+uint32_t TransientDescriptorRing::GetNumUsedDescriptors() const
+{
+    return (uint32_t)( m_Head - m_Tail );
+}
@@ -0,0 +1,112 @@
+#include <EnginePCH.h>
+
+#include <glm/gtc/packing.hpp>
+
+#include "VertexQuantization.h"
+
+// Read a vector with up to numComponents components from a vertex stream.
+static glm::vec3 ReadVector( const float* data, uint32_t stride, uint32_t index, uint32_t numComponents )
+{
+    const float* p = reinterpret_cast<const float*>( reinterpret_cast<const uint8_t*>( data ) + (size_t)index * stride );
+
+    glm::vec3 v( 0 );
+    for ( uint32_t i = 0; i < numComponents; ++i )
+    {
+        v[i] = p[i];
+    }
+    return v;
+}
+
+// Map a unit vector onto the octahedron and unfold it onto the [-1..1] square.
+// See: "A Survey of Efficient Representations for Independent Unit Vectors" (Cigolle et al. 2014).
+static void OctahedralEncode( glm::vec3 v, int16_t encoded[2] )
+{
+    float l1Norm = glm::abs( v.x ) + glm::abs( v.y ) + glm::abs( v.z );
+    if ( l1Norm <= 0.0f )
+    {
+        // Degenerate vectors are encoded as +Z.
+        encoded[0] = encoded[1] = 0;
+        return;
+    }
+
+    glm::vec2 p = glm::vec2( v.x, v.y ) / l1Norm;
+    if ( v.z < 0.0f )
+    {
+        glm::vec2 signs( p.x >= 0.0f ? 1.0f : -1.0f, p.y >= 0.0f ? 1.0f : -1.0f );
+        p = ( 1.0f - glm::abs( glm::vec2( p.y, p.x ) ) ) * signs;
+    }
+
+    encoded[0] = static_cast<int16_t>( glm::packSnorm1x16( p.x ) );
+    encoded[1] = static_cast<int16_t>( glm::packSnorm1x16( p.y ) );
+}
+
+void QuantizeVertices( const SceneCache& sceneCache, const SceneCache::MeshRecord& mesh, std::vector<QuantizedVertex>& vertices )
+{
+    const SceneCache::StreamRecord* positions = nullptr;
+    const SceneCache::StreamRecord* normals = nullptr;
+    const SceneCache::StreamRecord* tangents = nullptr;
+    const SceneCache::StreamRecord* binormals = nullptr;
+    const SceneCache::StreamRecord* texCoords = nullptr;
+
+    for ( uint32_t i = 0; i < mesh.NumStreams; ++i )
+    {
+        const SceneCache::StreamRecord& stream = sceneCache.GetStream( mesh.FirstStream + i );
+        switch ( stream.Type )
+        {
+        case SceneCache::Semantic::Position:
+            positions = &stream;
+            break;
+        case SceneCache::Semantic::Normal:
+            normals = &stream;
+            break;
+        case SceneCache::Semantic::Tangent:
+            tangents = &stream;
+            break;
+        case SceneCache::Semantic::Binormal:
+            binormals = &stream;
+            break;
+        case SceneCache::Semantic::TexCoord:
+            if ( stream.SemanticIndex == 0 ) texCoords = &stream;
+            break;
+        }
+    }
+
+    vertices.resize( mesh.NumVertices );
+
+    glm::vec3 boundsSize = mesh.BoundsMax - mesh.BoundsMin;
+    // Flat meshes have a size of 0 along one of the axes.
+    glm::vec3 invBoundsSize( boundsSize.x > 0.0f ? 1.0f / boundsSize.x : 0.0f,
+                             boundsSize.y > 0.0f ? 1.0f / boundsSize.y : 0.0f,
+                             boundsSize.z > 0.0f ? 1.0f / boundsSize.z : 0.0f );
+
+    for ( uint32_t i = 0; i < mesh.NumVertices; ++i )
+    {
+        QuantizedVertex& vertex = vertices[i];
+
+        glm::vec3 position = positions ? ReadVector( sceneCache.GetVertices( *positions ), positions->Stride, i, 3 ) : glm::vec3( 0 );
+        glm::vec3 normal = normals ? ReadVector( sceneCache.GetVertices( *normals ), normals->Stride, i, 3 ) : glm::vec3( 0, 0, 1 );
+        glm::vec3 tangent = tangents ? ReadVector( sceneCache.GetVertices( *tangents ), tangents->Stride, i, 3 ) : glm::vec3( 1, 0, 0 );
+
+        glm::vec3 relativePosition = glm::clamp( ( position - mesh.BoundsMin ) * invBoundsSize, 0.0f, 1.0f );
+        vertex.Position[0] = glm::packUnorm1x16( relativePosition.x );
+        vertex.Position[1] = glm::packUnorm1x16( relativePosition.y );
+        vertex.Position[2] = glm::packUnorm1x16( relativePosition.z );
+
+        // The binormal is reconstructed in the vertex shader from the normal and the tangent.
+        // Only its handedness has to be stored.
+        bool flipBinormal = false;
+        if ( binormals )
+        {
+            glm::vec3 binormal = ReadVector( sceneCache.GetVertices( *binormals ), binormals->Stride, i, 3 );
+            flipBinormal = glm::dot( glm::cross( normal, tangent ), binormal ) < 0.0f;
+        }
+        vertex.Position[3] = flipBinormal ? 0 : 0xffff;
+
+        OctahedralEncode( normal, vertex.Normal );
+        OctahedralEncode( tangent, vertex.Tangent );
+
+        glm::vec3 texCoord = texCoords ? ReadVector( sceneCache.GetVertices( *texCoords ), texCoords->Stride, i, glm::min<uint32_t>( texCoords->Stride / sizeof( float ), 2 ) ) : glm::vec3( 0 );
+        vertex.TexCoord[0] = glm::packHalf1x16( texCoord.x );
+        vertex.TexCoord[1] = glm::packHalf1x16( texCoord.y );
+    }
+}
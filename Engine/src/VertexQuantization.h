@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * A compact vertex format for imported meshes.
+ * All vertex attributes are interleaved in a single vertex buffer (20 bytes per vertex
+ * instead of 56 or more bytes in separate float streams).
+ * The layout must match the AppData structure in CommonInclude.hlsl when
+ * the shaders are compiled with QUANTIZED_VERTICES.
+ */
+
+#include "SceneCache.h"
+
+struct QuantizedVertex
+{
+    // The xyz components store the position relative to the bounding box of the mesh (unorm16).
+    // The w component stores the sign of the binormal (0 for -1, 0xffff for +1).
+    uint16_t Position[4];
+    // Octahedral encoded unit vectors (snorm16).
+    int16_t Normal[2];
+    int16_t Tangent[2];
+    // Half precision texture coordinates.
+    uint16_t TexCoord[2];
+};
+
+static_assert( sizeof( QuantizedVertex ) == 20, "The size of QuantizedVertex must match the AppData structure in the shaders." );
+
+// Convert the vertex streams of a mesh in the scene cache to the quantized vertex format.
+// Only the attributes that are used by the shaders are kept (vertex colors and all but
+// the first texture coordinate set are discarded).
+void QuantizeVertices( const SceneCache& sceneCache, const SceneCache::MeshRecord& mesh, std::vector<QuantizedVertex>& vertices );
@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * A minimal test framework for the engine classes that don't need a render device.
+ *
+ * Tests and benchmarks register themselves with the TEST and BENCHMARK macros and are
+ * executed by the test runner (main.cpp). A failed CHECK throws a TestFailure, so a test
+ * stops at the first check that fails. Benchmarks print their measurements to std::cout
+ * and use CHECK to verify the results they measure.
+ */
+class TestFailure : public std::runtime_error
+{
+public:
+    TestFailure( const std::string& message )
+        : std::runtime_error( message )
+    {}
+};
+
+typedef void ( *TestFunction )();
+
+struct TestCase
+{
+    std::string Name;
+    TestFunction Function;
+    bool IsBenchmark;
+};
+typedef std::vector<TestCase> TestCaseList;
+
+// The registered tests and benchmarks (in the order they were registered).
+TestCaseList& GetTestCases();
+
+// Registers a test case when it is constructed (used by the TEST and BENCHMARK macros).
+struct TestRegistration
+{
+    TestRegistration( const char* name, TestFunction function, bool isBenchmark );
+};
+
+// Throw a TestFailure.
+void FailTest( const char* file, int line, const std::string& message );
+
+#define TEST( name ) \
+    static void name(); \
+    static TestRegistration name##Registration( #name, &name, false ); \
+    static void name()
+
+#define BENCHMARK( name ) \
+    static void name(); \
+    static TestRegistration name##Registration( #name, &name, true ); \
+    static void name()
+
+#define CHECK( expression ) \
+    do { if ( !( expression ) ) FailTest( __FILE__, __LINE__, "CHECK( " #expression " ) failed." ); } while ( false )
+
+#define CHECK_EQUAL( expected, actual ) \
+    do \
+    { \
+        if ( !( ( expected ) == ( actual ) ) ) \
+        { \
+            std::stringstream checkMessage; \
+            checkMessage << "CHECK_EQUAL( " #expected ", " #actual " ) failed: " << ( actual ) << " != " << ( expected ) << "."; \
+            FailTest( __FILE__, __LINE__, checkMessage.str() ); \
+        } \
+    } while ( false )
+
+/**
+ * Measures the wall clock time between construction (or the previous tick) and Tick.
+ * (The HighResolutionTimer of the engine is only available on Windows.)
+ */
+class BenchmarkTimer
+{
+public:
+    BenchmarkTimer();
+
+    void Tick();
+
+    double ElapsedMilliSeconds() const;
+
+private:
+    typedef std::chrono::high_resolution_clock Clock;
+    Clock::time_point m_Start;
+    double m_ElapsedMilliSeconds;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+// The engine tests only use the classes of the engine that don't need a window or a render device,
+// so they can also be built without the Windows SDK (see CMakeLists.txt).
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
+#include <windows.h>
+#endif
+
+// STL
+#include <cstdint>
+#include <limits>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <vector>
+#include <array>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <stdexcept>
+#include <cassert>
+
+// BOOST
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+
+// GLM
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtx/norm.hpp>
+
+#if !defined(_WIN32)
+// Debug output goes to the error stream.
+inline void OutputDebugStringA( const char* message )
+{
+    std::cerr << message;
+}
+#endif
+
+// Report an error to the debug output and throw an std::runtime_error.
+// Unlike the engine, the tests never show a message box (so they can run unattended).
+inline void ReportTestError( const std::string& file, int line, const std::string& message )
+{
+    std::stringstream ss;
+    ss << file << "(" << line << "): " << message << std::endl;
+    OutputDebugStringA( ss.str().c_str() );
+
+    throw std::runtime_error( message );
+}
+
+// Report an error message and throw an std::runtime_error.
+#define ReportError( msg ) ReportTestError( __FILE__, __LINE__, (msg) )
@@ -0,0 +1,128 @@
+#pragma once
+
+/**
+ * Helpers to render scenes that are built in code with the null render device
+ * (the null device can't import scene files in the headless build).
+ */
+
+#include <Scene.h>
+#include <SceneNode.h>
+#include <Mesh.h>
+#include <Material.h>
+#include <Camera.h>
+#include <Shader.h>
+#include <PipelineState.h>
+#include <BufferBinding.h>
+#include <Visitor.h>
+
+#include <Null/RenderDeviceNull.h>
+
+#include <RenderTechnique.h>
+
+// A scene that is built in code.
+class TestScene : public Scene
+{
+public:
+    TestScene()
+        : m_pRootNode( std::make_shared<SceneNode>() )
+    {}
+
+    virtual bool LoadFromFile( const std::wstring& fileName, bool streamTextures, bool quantizeVertices )
+    {
+        return false;
+    }
+
+    virtual bool LoadFromString( const std::string& scene, const std::string& format )
+    {
+        return false;
+    }
+
+    virtual void Render( RenderEventArgs& renderEventArgs )
+    {
+        m_pRootNode->Render( renderEventArgs );
+    }
+
+    virtual std::shared_ptr<SceneNode> GetRootNode() const
+    {
+        return m_pRootNode;
+    }
+
+    virtual void UpdateStreaming( const Camera& camera )
+    {}
+
+    virtual bool IsStreaming() const
+    {
+        return false;
+    }
+
+    virtual void Accept( Visitor& visitor )
+    {
+        visitor.Visit( *this );
+        m_pRootNode->Accept( visitor );
+    }
+
+    // Add a node with the mesh to the root of the scene.
+    void AddMesh( std::shared_ptr<Mesh> mesh, const glm::vec3& position )
+    {
+        std::shared_ptr<SceneNode> node = std::make_shared<SceneNode>( glm::translate( position ) );
+        node->AddMesh( mesh );
+        m_pRootNode->AddChild( node );
+    }
+
+private:
+    std::shared_ptr<SceneNode> m_pRootNode;
+};
+
+// The number of triangles of the box mesh.
+#define TEST_BOX_TRIANGLES 12
+
+// A unit box with the given material.
+inline std::shared_ptr<Mesh> CreateTestBox( RenderDevice& renderDevice, std::shared_ptr<Material> material )
+{
+    const float positions[] =
+    {
+        -0.5f, -0.5f, -0.5f,   0.5f, -0.5f, -0.5f,   0.5f,  0.5f, -0.5f,  -0.5f,  0.5f, -0.5f,
+        -0.5f, -0.5f,  0.5f,   0.5f, -0.5f,  0.5f,   0.5f,  0.5f,  0.5f,  -0.5f,  0.5f,  0.5f,
+    };
+    const unsigned int indices[] =
+    {
+        0, 2, 1, 0, 3, 2,   4, 5, 6, 4, 6, 7,   0, 1, 5, 0, 5, 4,
+        3, 6, 2, 3, 7, 6,   0, 4, 7, 0, 7, 3,   1, 2, 6, 1, 6, 5,
+    };
+
+    std::shared_ptr<Mesh> mesh = renderDevice.CreateMesh();
+    mesh->AddVertexBuffer( BufferBinding( "POSITION", 0 ), renderDevice.CreateFloatVertexBuffer( positions, 8, 3 * sizeof( float ) ) );
+    mesh->SetIndexBuffer( renderDevice.CreateUIntIndexBuffer( indices, TEST_BOX_TRIANGLES * 3 ) );
+    mesh->SetMaterial( material );
+
+    return mesh;
+}
+
+inline std::shared_ptr<PipelineState> CreateTestPipeline( RenderDevice& renderDevice )
+{
+    std::shared_ptr<Shader> vertexShader = renderDevice.CreateShader();
+    vertexShader->LoadShaderFromString( Shader::VertexShader, std::string(), L"TestVertexShader.hlsl", Shader::ShaderMacros(), "VS_main", "latest" );
+    std::shared_ptr<Shader> pixelShader = renderDevice.CreateShader();
+    pixelShader->LoadShaderFromString( Shader::PixelShader, std::string(), L"TestPixelShader.hlsl", Shader::ShaderMacros(), "PS_main", "latest" );
+
+    std::shared_ptr<PipelineState> pipeline = renderDevice.CreatePipelineState();
+    pipeline->SetShader( Shader::VertexShader, vertexShader );
+    pipeline->SetShader( Shader::PixelShader, pixelShader );
+
+    return pipeline;
+}
+
+// Render a single frame of the technique and return the calls that were made to the device.
+inline RenderCountersNull RenderTestFrame( RenderDeviceNull& renderDevice, RenderTechnique& technique )
+{
+    Camera camera;
+    camera.SetProjectionRH( 45.0f, 1.0f, 0.1f, 1000.0f );
+    camera.SetTranslate( glm::vec3( 0, 0, 100 ) );
+
+    RenderEventArgs renderEventArgs( technique, 0.0f, 0.0f, 0, &camera );
+
+    renderDevice.GetCounters().Reset();
+    technique.Render( renderEventArgs );
+
+    return renderDevice.GetCounters();
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+// Replaces the precompiled header of the engine when the engine sources that don't use
+// a graphics API are compiled into the tests without the Windows SDK (see CMakeLists.txt).
+#include <EngineTestPCH.h>
+
+#include <filesystem>
+#include <fstream>
+#include <queue>
+
+#include <unistd.h>
+
+// BOOST
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/signals2.hpp>
+#include <boost/any.hpp>
+
+// GLM
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/random.hpp>
+#include <glm/gtx/vector_angle.hpp>
+#include <glm/gtx/compatibility.hpp>
+#include <glm/gtx/matrix_operation.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/gtx/euler_angles.hpp>
+
+// The engine uses boost::filesystem, which is not header-only.
+// The standard library has the same path and query functions
+// and its file streams can be opened with a path.
+namespace fs
+{
+    using namespace std::filesystem;
+    using std::ifstream;
+    using std::ofstream;
+}
+
+// The error codes of the boost::filesystem functions (Boost.System is not header-only either).
+namespace boost
+{
+    namespace system
+    {
+        typedef std::error_code error_code;
+    }
+}
+
+// The number of elements of a static array (defined by the Microsoft C runtime).
+#define _countof( array ) ( sizeof( array ) / sizeof( ( array )[0] ) )
+
+// Aligned allocations of the Microsoft C runtime.
+inline void* _aligned_malloc( size_t size, size_t alignment )
+{
+    void* ptr = nullptr;
+    return ( posix_memalign( &ptr, alignment, size ) == 0 ) ? ptr : nullptr;
+}
+
+inline void _aligned_free( void* ptr )
+{
+    free( ptr );
+}
+
+// The process and thread ids of the Windows API (used to name temporary files).
+inline uint32_t GetCurrentProcessId()
+{
+    return static_cast<uint32_t>( getpid() );
+}
+
+inline uint32_t GetCurrentThreadId()
+{
+    return static_cast<uint32_t>( std::hash<std::thread::id>()( std::this_thread::get_id() ) );
+}
+
+// The texture formats of the DXGI headers (the Windows SDK) that the texture processing uses.
+// The values match dxgiformat.h, so DDS files are the same on every platform.
+enum DXGI_FORMAT
+{
+    DXGI_FORMAT_UNKNOWN = 0,
+    DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+    DXGI_FORMAT_R8_UNORM = 61,
+    DXGI_FORMAT_BC1_UNORM = 71,
+    DXGI_FORMAT_BC3_UNORM = 77,
+    DXGI_FORMAT_BC4_UNORM = 80,
+    DXGI_FORMAT_BC5_UNORM = 83,
+    DXGI_FORMAT_B8G8R8A8_UNORM = 87,
+};
+
+// Assimp and FreeImage are only distributed for Windows (see externals) so the engine
+// can't import scenes or read image files in this build (the null device reports an error instead).
+#define ENGINE_NO_IMPORTERS
@@ -0,0 +1,7 @@
+#pragma once
+
+// Replaces the precompiled header of the GraphicsTest project when its render passes
+// are compiled into the tests to run them on the null device (see CMakeLists.txt).
+#include <EnginePCH.h>
+
+#include <queue>
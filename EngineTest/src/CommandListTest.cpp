@@ -0,0 +1,119 @@
+#include <EngineTestPCH.h>
+
+// The opaque pass records its render queue into command lists of the null render device
+// (see RenderTechniqueTest.cpp).
+#include <GraphicsTestPCH.h>
+
+#include <JobSystem.h>
+
+#include <RenderTechnique.h>
+#include <OpaquePass.h>
+
+#include <EngineTest.h>
+#include <TestScene.h>
+
+// A scene with numMeshes meshes (each with its own material) that are all instanced numInstances times.
+static std::shared_ptr<TestScene> CreateCommandListScene( RenderDevice& renderDevice, uint32_t numMeshes, uint32_t numInstances )
+{
+    std::shared_ptr<TestScene> scene = std::make_shared<TestScene>();
+    for ( uint32_t i = 0; i < numMeshes; ++i )
+    {
+        std::shared_ptr<Mesh> mesh = CreateTestBox( renderDevice, renderDevice.CreateMaterial() );
+        for ( uint32_t j = 0; j < numInstances; ++j )
+        {
+            scene->AddMesh( mesh, glm::vec3( ( i % 64 ) * 2.0f, ( i / 64 ) * 2.0f, j * -2.0f ) );
+        }
+    }
+
+    return scene;
+}
+
+TEST( CommandListDrawOrderMatchesImmediateContext )
+{
+    RenderDeviceNull renderDevice;
+    std::shared_ptr<TestScene> scene = CreateCommandListScene( renderDevice, 64, 16 );
+    std::shared_ptr<PipelineState> pipeline = CreateTestPipeline( renderDevice );
+
+    std::shared_ptr<OpaquePass> immediatePass = std::make_shared<OpaquePass>( renderDevice, scene, pipeline );
+    RenderTechnique immediateTechnique;
+    immediateTechnique.AddPass( immediatePass );
+
+    RenderCountersNull immediateCounters = RenderTestFrame( renderDevice, immediateTechnique );
+    CHECK_EQUAL( 0u, immediatePass->GetNumCommandLists() );
+    CHECK_EQUAL( 64u, immediateCounters.DrawCalls );
+
+    // The 1024 items of the render queue are split into (at least) 64 items per command list.
+    JobSystem jobSystem( 3 );
+    std::shared_ptr<OpaquePass> commandListPass = std::make_shared<OpaquePass>( renderDevice, scene, pipeline );
+    commandListPass->SetJobSystem( &jobSystem, 64 );
+    RenderTechnique commandListTechnique;
+    commandListTechnique.AddPass( commandListPass );
+
+    RenderCountersNull commandListCounters = RenderTestFrame( renderDevice, commandListTechnique );
+    CHECK_EQUAL( 4u, commandListPass->GetNumCommandLists() );
+    CHECK_EQUAL( 4u, commandListCounters.CommandLists );
+
+    // The command lists draw exactly the same batches in the same order.
+    CHECK_EQUAL( immediateCounters.DrawCalls, commandListCounters.DrawCalls );
+    CHECK_EQUAL( immediateCounters.Triangles, commandListCounters.Triangles );
+    CHECK_EQUAL( immediateCounters.DrawOrderHash, commandListCounters.DrawOrderHash );
+    CHECK_EQUAL( immediatePass->GetNumDrawCalls(), commandListPass->GetNumDrawCalls() );
+    CHECK_EQUAL( immediatePass->GetNumTriangles(), commandListPass->GetNumTriangles() );
+
+    // Command lists are recorded again every frame.
+    RenderCountersNull nextCounters = RenderTestFrame( renderDevice, commandListTechnique );
+    CHECK_EQUAL( immediateCounters.DrawOrderHash, nextCounters.DrawOrderHash );
+}
+
+#define BENCHMARK_MAX_RECORDING_THREADS 32
+#define BENCHMARK_NUM_COMMAND_LIST_MESHES 8192
+#define BENCHMARK_COMMAND_LIST_INSTANCES 2
+#define BENCHMARK_NUM_COMMAND_LIST_FRAMES 10
+
+// Measure how recording the render queue of the opaque pass scales from 1 to BENCHMARK_MAX_RECORDING_THREADS threads.
+// With a single thread, the render queue is drawn on the calling thread without command lists.
+// Every thread count must draw the same batches in the same order (the same draw order hash).
+BENCHMARK( CommandListRecordingScaling )
+{
+    RenderDeviceNull renderDevice;
+    std::shared_ptr<TestScene> scene = CreateCommandListScene( renderDevice, BENCHMARK_NUM_COMMAND_LIST_MESHES, BENCHMARK_COMMAND_LIST_INSTANCES );
+
+    JobSystem jobSystem( BENCHMARK_MAX_RECORDING_THREADS - 1 );
+    std::shared_ptr<OpaquePass> pass = std::make_shared<OpaquePass>( renderDevice, scene, CreateTestPipeline( renderDevice ) );
+    pass->SetJobSystem( &jobSystem );
+    RenderTechnique technique;
+    technique.AddPass( pass );
+
+    std::cout << "Command list recording scaling (" << BENCHMARK_NUM_COMMAND_LIST_MESHES << " draw calls, "
+        << std::thread::hardware_concurrency() << " hardware threads):" << std::endl;
+
+    double singleThreadMilliSeconds = 0.0;
+    uint64_t expectedDrawOrderHash = 0;
+    for ( uint32_t numThreads = 1; numThreads <= BENCHMARK_MAX_RECORDING_THREADS; numThreads *= 2 )
+    {
+        jobSystem.SetNumThreads( numThreads );
+
+        // The first frame creates the command lists and grows the instance buffers.
+        RenderCountersNull counters = RenderTestFrame( renderDevice, technique );
+
+        BenchmarkTimer timer;
+        for ( uint32_t frame = 0; frame < BENCHMARK_NUM_COMMAND_LIST_FRAMES; ++frame )
+        {
+            counters = RenderTestFrame( renderDevice, technique );
+        }
+        timer.Tick();
+
+        double milliSeconds = timer.ElapsedMilliSeconds() / BENCHMARK_NUM_COMMAND_LIST_FRAMES;
+        if ( numThreads == 1 )
+        {
+            singleThreadMilliSeconds = milliSeconds;
+            expectedDrawOrderHash = counters.DrawOrderHash;
+        }
+        CHECK_EQUAL( (uint64_t)BENCHMARK_NUM_COMMAND_LIST_MESHES, counters.DrawCalls );
+        CHECK_EQUAL( expectedDrawOrderHash, counters.DrawOrderHash );
+
+        std::cout << numThreads << " threads: " << milliSeconds << " ms per frame, "
+            << singleThreadMilliSeconds / milliSeconds << "x speedup, "
+            << pass->GetNumCommandLists() << " command lists" << std::endl;
+    }
+}
@@ -0,0 +1,152 @@
+#include <EngineTestPCH.h>
+
+// The constant buffer ring of the null render device and the base pass
+// that allocates its per object data from the ring (see RenderTechniqueTest.cpp).
+#include <GraphicsTestPCH.h>
+
+#include <ShaderParameterID.h>
+#include <Null/ConstantBufferRingNull.h>
+
+#include <RenderTechnique.h>
+#include <BasePass.h>
+
+#include <EngineTest.h>
+#include <TestScene.h>
+
+// The number of blocks that are allocated per frame.
+#define TEST_BLOCKS_PER_FRAME 16
+
+// Counts the number of times the ring waits for the simulated GPU.
+class WaitCountingConstantBufferRingNull : public ConstantBufferRingNull
+{
+public:
+    typedef ConstantBufferRingNull base;
+
+    WaitCountingConstantBufferRingNull( RenderCountersNull& counters, uint32_t size )
+        : base( counters, size )
+        , NumWaits( 0 )
+    {}
+
+    uint32_t NumWaits;
+
+protected:
+    virtual void WaitForFence( uint64_t fence )
+    {
+        ++NumWaits;
+        base::WaitForFence( fence );
+    }
+};
+
+// Allocate the blocks of numFrames frames.
+static void AllocateFrames( ConstantBufferRing& ring, uint32_t numFrames )
+{
+    glm::mat4 data( 1.0f );
+    for ( uint32_t frame = 0; frame < numFrames; ++frame )
+    {
+        for ( uint32_t i = 0; i < TEST_BLOCKS_PER_FRAME; ++i )
+        {
+            ConstantBufferRing::Allocation allocation = ring.Allocate( data );
+            CHECK( allocation.IsValid() );
+        }
+        ring.EndFrame();
+    }
+}
+
+TEST( ConstantBufferRingNullCountsUpdatesAndBinds )
+{
+    RenderDeviceNull renderDevice;
+    std::shared_ptr<PipelineState> pipeline = CreateTestPipeline( renderDevice );
+    std::shared_ptr<Shader> vertexShader = pipeline->GetShader( Shader::VertexShader );
+
+    RenderCountersNull counters;
+    ConstantBufferRingNull ring( counters, TEST_BLOCKS_PER_FRAME * ConstantBufferRing::Alignment );
+
+    glm::mat4 data( 1.0f );
+    ConstantBufferRing::Allocation allocation = ring.Allocate( data );
+    CHECK_EQUAL( 0u, allocation.Offset % ConstantBufferRing::Alignment );
+    CHECK_EQUAL( ConstantBufferRing::Alignment, allocation.Size );
+    CHECK_EQUAL( 1u, counters.BufferUpdates );
+    CHECK_EQUAL( sizeof( data ), counters.BytesUploaded );
+
+    CHECK( ring.Bind( allocation, *vertexShader, ShaderParameterID( "PerObject" ) ) );
+    CHECK_EQUAL( 1u, counters.ConstantBufferBinds );
+
+    // An invalid allocation is not bound.
+    CHECK( !ring.Bind( ConstantBufferRing::Allocation(), *vertexShader, ShaderParameterID( "PerObject" ) ) );
+    CHECK_EQUAL( 1u, counters.ConstantBufferBinds );
+}
+
+TEST( ConstantBufferRingNullWaitsOnlyWhenFull )
+{
+    RenderCountersNull counters;
+
+    // The simulated GPU finishes a frame two frames after it has ended,
+    // so a ring that holds three frames never has to wait.
+    WaitCountingConstantBufferRingNull largeRing( counters, 3 * TEST_BLOCKS_PER_FRAME * ConstantBufferRing::Alignment );
+    AllocateFrames( largeRing, 20 );
+    CHECK_EQUAL( 0u, largeRing.NumWaits );
+
+    // A ring that holds one and a half frames waits in every frame after the first.
+    WaitCountingConstantBufferRingNull smallRing( counters, 3 * TEST_BLOCKS_PER_FRAME / 2 * ConstantBufferRing::Alignment );
+    AllocateFrames( smallRing, 20 );
+    CHECK( smallRing.NumWaits >= 19u );
+
+    CHECK_EQUAL( 40u * TEST_BLOCKS_PER_FRAME, counters.BufferUpdates );
+}
+
+#define BENCHMARK_NUM_RING_OBJECTS 100000
+#define BENCHMARK_NUM_RING_MESHES 100
+#define BENCHMARK_NUM_RING_OBJECT_FRAMES 10
+
+// Measure the CPU time of a base pass (without a render queue) that renders BENCHMARK_NUM_RING_OBJECTS objects
+// with the null render device, once with the per object data allocated from the constant buffer ring of
+// the device and once with the per object constant buffer updated for every draw call.
+BENCHMARK( ConstantBufferRingNullObjectsBenchmark )
+{
+    RenderDeviceNull renderDevice;
+
+    std::vector< std::shared_ptr<Mesh> > meshes;
+    for ( uint32_t i = 0; i < BENCHMARK_NUM_RING_MESHES; ++i )
+    {
+        meshes.push_back( CreateTestBox( renderDevice, renderDevice.CreateMaterial() ) );
+    }
+
+    std::shared_ptr<TestScene> scene = std::make_shared<TestScene>();
+    for ( uint32_t i = 0; i < BENCHMARK_NUM_RING_OBJECTS; ++i )
+    {
+        scene->AddMesh( meshes[i % BENCHMARK_NUM_RING_MESHES], glm::vec3( ( i % 100 ) * 2.0f, ( i / 100 % 100 ) * 2.0f, ( i / 10000 ) * -2.0f ) );
+    }
+
+    std::shared_ptr<BasePass> pass = std::make_shared<BasePass>( renderDevice, scene, CreateTestPipeline( renderDevice ) );
+    RenderTechnique technique;
+    technique.AddPass( pass );
+
+    std::cout << "Constant buffer ring objects benchmark (" << BENCHMARK_NUM_RING_OBJECTS << " objects, "
+        << BENCHMARK_NUM_RING_OBJECT_FRAMES << " frames):" << std::endl;
+
+    ConstantBufferRing* constantBufferRings[] = { renderDevice.GetConstantBufferRing(), nullptr };
+    for ( ConstantBufferRing* constantBufferRing : constantBufferRings )
+    {
+        pass->SetConstantBufferRing( constantBufferRing );
+
+        RenderCountersNull counters;
+        double milliSeconds = 0.0;
+        for ( uint32_t frame = 0; frame < BENCHMARK_NUM_RING_OBJECT_FRAMES; ++frame )
+        {
+            BenchmarkTimer timer;
+            RenderCountersNull frameCounters = RenderTestFrame( renderDevice, technique );
+            renderDevice.EndFrame();
+            timer.Tick();
+
+            milliSeconds += timer.ElapsedMilliSeconds();
+            counters.Add( frameCounters );
+        }
+        CHECK_EQUAL( (uint64_t)BENCHMARK_NUM_RING_OBJECTS * BENCHMARK_NUM_RING_OBJECT_FRAMES, counters.DrawCalls );
+
+        std::cout << ( constantBufferRing ? "Constant buffer ring: " : "Per object constant buffer: " )
+            << milliSeconds / BENCHMARK_NUM_RING_OBJECT_FRAMES << " ms per frame, "
+            << counters.BufferUpdates / BENCHMARK_NUM_RING_OBJECT_FRAMES << " buffer updates per frame, "
+            << counters.BytesUploaded / BENCHMARK_NUM_RING_OBJECT_FRAMES / 1024.0 << " KB per frame, "
+            << counters.ConstantBufferBinds / BENCHMARK_NUM_RING_OBJECT_FRAMES << " constant buffer binds per frame" << std::endl;
+    }
+}
@@ -0,0 +1,226 @@
+#include <EngineTestPCH.h>
+
+#include <ConstantBufferRing.h>
+
+#include <EngineTest.h>
+
+// A constant buffer ring without a device. The ring buffer is system memory
+// and the fences are completed by the test (or when the ring waits for them).
+class MockConstantBufferRing : public ConstantBufferRing
+{
+public:
+    typedef ConstantBufferRing base;
+
+    MockConstantBufferRing( uint32_t size )
+        : base( size )
+        , Data( GetSize(), 0 )
+        , NumCompletedFences( 0 )
+        , NumDiscards( 0 )
+        , NumPolls( 0 )
+    {}
+
+    virtual bool Bind( const Allocation& allocation, const Shader& shader, const ShaderParameterID& id )
+    {
+        return true;
+    }
+
+    // Complete all fences that have been inserted.
+    void CompleteFences()
+    {
+        NumCompletedFences = InsertedFences.size();
+    }
+
+    std::vector<uint8_t> Data;
+    // The fences that have been inserted (in order).
+    std::vector<uint64_t> InsertedFences;
+    // The fences the ring waited for (in order).
+    std::vector<uint64_t> WaitedFences;
+    // Fences lower than this value are complete.
+    uint64_t NumCompletedFences;
+    uint32_t NumDiscards;
+    uint32_t NumPolls;
+
+protected:
+    virtual void Write( uint32_t offset, const void* data, size_t size, bool discard )
+    {
+        if ( discard ) ++NumDiscards;
+        memcpy( &Data[offset], data, size );
+    }
+
+    virtual void InsertFence( uint64_t fence )
+    {
+        InsertedFences.push_back( fence );
+    }
+
+    virtual bool IsFenceComplete( uint64_t fence )
+    {
+        ++NumPolls;
+        return fence < NumCompletedFences;
+    }
+
+    virtual void WaitForFence( uint64_t fence )
+    {
+        WaitedFences.push_back( fence );
+        NumCompletedFences = std::max( NumCompletedFences, fence + 1 );
+    }
+};
+
+TEST( ConstantBufferRingAlignsAllocations )
+{
+    MockConstantBufferRing ring( 4096 );
+    const uint32_t a = 0x12345678;
+    uint8_t b[300];
+    std::iota( b, b + sizeof( b ), (uint8_t)0 );
+
+    ConstantBufferRing::Allocation allocationA = ring.Allocate( a );
+    CHECK_EQUAL( 0u, allocationA.Offset );
+    CHECK_EQUAL( ConstantBufferRing::Alignment, allocationA.Size );
+
+    ConstantBufferRing::Allocation allocationB = ring.Allocate( b, sizeof( b ) );
+    CHECK_EQUAL( ConstantBufferRing::Alignment, allocationB.Offset );
+    CHECK_EQUAL( 2 * ConstantBufferRing::Alignment, allocationB.Size );
+    CHECK_EQUAL( 3 * ConstantBufferRing::Alignment, ring.Allocate( a ).Offset );
+
+    CHECK( memcmp( &ring.Data[allocationA.Offset], &a, sizeof( a ) ) == 0 );
+    CHECK( memcmp( &ring.Data[allocationB.Offset], b, sizeof( b ) ) == 0 );
+
+    // The size of the ring is rounded down to the alignment.
+    CHECK_EQUAL( 4096u, MockConstantBufferRing( 4096 + 100 ).GetSize() );
+}
+
+TEST( ConstantBufferRingReusesCompletedFrames )
+{
+    MockConstantBufferRing ring( 4 * ConstantBufferRing::Alignment );
+    const uint8_t data[2 * ConstantBufferRing::Alignment] = {};
+
+    CHECK_EQUAL( 0u, ring.Allocate( data, sizeof( data ) ).Offset );
+    ring.EndFrame();
+    ring.CompleteFences();
+
+    CHECK_EQUAL( 2 * ConstantBufferRing::Alignment, ring.Allocate( data, sizeof( data ) ).Offset );
+    ring.EndFrame();
+
+    // The space of the first frame is reused without waiting for the GPU.
+    CHECK_EQUAL( 0u, ring.Allocate( data, sizeof( data ) ).Offset );
+    CHECK( ring.WaitedFences.empty() );
+    CHECK_EQUAL( 0u, ring.NumDiscards );
+}
+
+TEST( ConstantBufferRingWaitsForOldestFrameWhenFull )
+{
+    MockConstantBufferRing ring( 4 * ConstantBufferRing::Alignment );
+    const uint8_t data[2 * ConstantBufferRing::Alignment] = {};
+
+    ring.Allocate( data, sizeof( data ) );
+    ring.EndFrame();
+    ring.Allocate( data, ConstantBufferRing::Alignment );
+    ring.EndFrame();
+
+    // The allocation doesn't fit at the end of the ring buffer. The ring waits for the first frame only.
+    CHECK_EQUAL( 0u, ring.Allocate( data, sizeof( data ) ).Offset );
+    CHECK_EQUAL( 1u, ring.WaitedFences.size() );
+    CHECK_EQUAL( 0u, ring.WaitedFences[0] );
+    CHECK_EQUAL( 0u, ring.NumDiscards );
+}
+
+TEST( ConstantBufferRingDiscardsWhenFrameDoesntFit )
+{
+    MockConstantBufferRing ring( 4 * ConstantBufferRing::Alignment );
+    const uint8_t data[ConstantBufferRing::Alignment] = {};
+
+    for ( uint32_t i = 0; i < 4; ++i )
+    {
+        CHECK_EQUAL( i * ConstantBufferRing::Alignment, ring.Allocate( data, sizeof( data ) ).Offset );
+    }
+    CHECK_EQUAL( 0u, ring.NumDiscards );
+
+    // The current frame uses the whole ring buffer, so the buffer is renamed.
+    CHECK_EQUAL( 0u, ring.Allocate( data, sizeof( data ) ).Offset );
+    CHECK_EQUAL( 1u, ring.NumDiscards );
+    CHECK( ring.WaitedFences.empty() );
+    CHECK_EQUAL( ConstantBufferRing::Alignment, ring.Allocate( data, sizeof( data ) ).Offset );
+}
+
+TEST( ConstantBufferRingPollsFencesInEndFrame )
+{
+    MockConstantBufferRing ring( 64 * ConstantBufferRing::Alignment );
+    const uint8_t data[ConstantBufferRing::Alignment] = {};
+
+    ring.EndFrame();
+    for ( uint32_t i = 0; i < 16; ++i )
+    {
+        ring.Allocate( data, sizeof( data ) );
+    }
+    // Allocations never poll the fences.
+    CHECK_EQUAL( 0u, ring.NumPolls );
+
+    // Only the oldest fence is polled while it isn't complete.
+    ring.EndFrame();
+    CHECK_EQUAL( 1u, ring.NumPolls );
+    ring.EndFrame();
+    CHECK_EQUAL( 2u, ring.NumPolls );
+}
+
+TEST( ConstantBufferRingLimitsFramesInFlight )
+{
+    MockConstantBufferRing ring( 64 * ConstantBufferRing::Alignment );
+    const uint8_t data[ConstantBufferRing::Alignment] = {};
+
+    // The GPU doesn't finish any frames.
+    for ( uint32_t i = 0; i < 10; ++i )
+    {
+        ring.Allocate( data, sizeof( data ) );
+        ring.EndFrame();
+    }
+
+    // EndFrame never waits, the frames are retired with the fences that are in flight.
+    CHECK_EQUAL( ConstantBufferRing::MaxFramesInFlight, ring.InsertedFences.size() );
+    CHECK( ring.WaitedFences.empty() );
+
+    ring.CompleteFences();
+    ring.EndFrame();
+    CHECK_EQUAL( ConstantBufferRing::MaxFramesInFlight + 1, ring.InsertedFences.size() );
+    CHECK_EQUAL( (uint64_t)ConstantBufferRing::MaxFramesInFlight, ring.InsertedFences.back() );
+
+    // The space of the retired frames is reused (the last 7 frames are still in flight).
+    for ( uint32_t i = 0; i < 57; ++i )
+    {
+        ring.Allocate( data, sizeof( data ) );
+    }
+    CHECK( ring.WaitedFences.empty() );
+    CHECK_EQUAL( 0u, ring.NumDiscards );
+}
+
+#define BENCHMARK_NUM_RING_ALLOCATIONS 100000
+#define BENCHMARK_NUM_RING_FRAMES 100
+#define BENCHMARK_RING_GPU_LATENCY 1
+
+// Measure the CPU time to allocate the per object constant buffer data of BENCHMARK_NUM_RING_ALLOCATIONS draw calls
+// per frame from a ring that is large enough for MaxFramesInFlight frames. The GPU finishes a frame while the CPU
+// records the next BENCHMARK_RING_GPU_LATENCY frames, so the ring should never wait or rename the buffer.
+BENCHMARK( ConstantBufferRingBenchmark )
+{
+    MockConstantBufferRing ring( ConstantBufferRing::MaxFramesInFlight * BENCHMARK_NUM_RING_ALLOCATIONS * ConstantBufferRing::Alignment );
+    // The size of the PerObject constant buffer.
+    uint8_t data[160] = {};
+
+    BenchmarkTimer timer;
+    for ( uint32_t frame = 0; frame < BENCHMARK_NUM_RING_FRAMES; ++frame )
+    {
+        for ( uint32_t i = 0; i < BENCHMARK_NUM_RING_ALLOCATIONS; ++i )
+        {
+            data[0] = (uint8_t)i;
+            ring.Allocate( data, sizeof( data ) );
+        }
+        ring.NumCompletedFences = ring.InsertedFences.size() > BENCHMARK_RING_GPU_LATENCY ? ring.InsertedFences.size() - BENCHMARK_RING_GPU_LATENCY : 0;
+        ring.EndFrame();
+    }
+    timer.Tick();
+
+    std::cout << "Constant buffer ring benchmark (" << BENCHMARK_NUM_RING_FRAMES << " frames): "
+        << timer.ElapsedMilliSeconds() / BENCHMARK_NUM_RING_FRAMES << " ms per frame for " << BENCHMARK_NUM_RING_ALLOCATIONS << " allocations, "
+        << ring.NumPolls / (double)BENCHMARK_NUM_RING_FRAMES << " fence polls per frame, "
+        << ring.WaitedFences.size() << " waits, " << ring.NumDiscards << " discards" << std::endl;
+    CHECK( ring.WaitedFences.empty() );
+    CHECK_EQUAL( 0u, ring.NumDiscards );
+}
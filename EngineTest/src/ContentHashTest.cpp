@@ -0,0 +1,136 @@
+#include <EngineTestPCH.h>
+
+// The test files are written with the file system library of the engine (fs).
+#include <EnginePCH.h>
+
+#include <ContentHash.h>
+#include <JobSystem.h>
+#include <AssetCache.h>
+
+#include <EngineTest.h>
+
+// The chunk size of AssetCache::HashFile.
+#define TEST_HASH_CHUNK_SIZE ( 1024 * 1024 )
+
+TEST( ContentHashXXH64Vectors )
+{
+    // The reference values of XXH64 with a seed of 0.
+    CHECK_EQUAL( 0xef46db3751d8e999ull, ContentHash::Hash( "", 0 ) );
+    CHECK_EQUAL( 0x44bc2cf5ad770999ull, ContentHash::Hash( "abc", 3 ) );
+
+    ContentHash empty;
+    CHECK_EQUAL( 0xef46db3751d8e999ull, empty.GetHash() );
+
+    ContentHash abc;
+    abc.Update( "abc", 3 );
+    CHECK_EQUAL( 0x44bc2cf5ad770999ull, abc.GetHash() );
+
+    // A different seed produces a different hash.
+    CHECK( ContentHash::Hash( "abc", 3, 1 ) != ContentHash::Hash( "abc", 3 ) );
+}
+
+TEST( ContentHashChunkedUpdateMatchesSingleCall )
+{
+    std::vector<uint8_t> data( 1000 );
+    std::mt19937 random( 42 );
+    for ( uint8_t& byte : data )
+    {
+        byte = static_cast<uint8_t>( random() );
+    }
+
+    for ( uint64_t seed : { 0ull, 12345ull } )
+    {
+        const uint64_t expectedHash = ContentHash::Hash( data.data(), data.size(), seed );
+
+        // Chunks that are smaller than, equal to and larger than the 32 byte stripes.
+        for ( size_t chunkSize : { 1, 3, 7, 31, 32, 33, 64, 100, 999, 1000 } )
+        {
+            ContentHash contentHash( seed );
+            for ( size_t offset = 0; offset < data.size(); offset += chunkSize )
+            {
+                contentHash.Update( data.data() + offset, std::min( chunkSize, data.size() - offset ) );
+            }
+            CHECK_EQUAL( expectedHash, contentHash.GetHash() );
+        }
+
+        // The hash can be read in between updates.
+        ContentHash contentHash( seed );
+        contentHash.Update( data.data(), 500 );
+        CHECK_EQUAL( ContentHash::Hash( data.data(), 500, seed ), contentHash.GetHash() );
+        contentHash.Update( data.data() + 500, 500 );
+        CHECK_EQUAL( expectedHash, contentHash.GetHash() );
+    }
+}
+
+// Write a file with size bytes of pseudo random data (the last byte can be changed).
+static void WriteTestFile( const fs::path& fileName, size_t size, uint8_t lastByte = 0 )
+{
+    std::vector<char> data( size );
+    std::mt19937 random( 42 );
+    for ( char& byte : data )
+    {
+        byte = static_cast<char>( random() );
+    }
+    if ( size > 0 )
+    {
+        data.back() = static_cast<char>( lastByte );
+    }
+
+    fs::ofstream file( fileName, std::ios::binary | std::ios::trunc );
+    file.write( data.data(), static_cast<std::streamsize>( data.size() ) );
+}
+
+TEST( AssetCacheHashFilesMatchesHashFile )
+{
+    fs::path directory = fs::temp_directory_path() / "EngineTestAssetCache";
+    boost::system::error_code errorCode;
+    fs::remove_all( directory, errorCode );
+
+    JobSystem jobSystem( 3 );
+    AssetCache assetCache( directory.wstring(), jobSystem );
+
+    // An empty file, a file of exactly one chunk, a file with a single byte in its second chunk,
+    // the same file with a different last byte and a file that doesn't exist.
+    std::vector<std::wstring> fileNames;
+    fileNames.push_back( ( directory / "Empty.bin" ).wstring() );
+    fileNames.push_back( ( directory / "OneChunk.bin" ).wstring() );
+    fileNames.push_back( ( directory / "TwoChunks.bin" ).wstring() );
+    fileNames.push_back( ( directory / "TwoChunksModified.bin" ).wstring() );
+    fileNames.push_back( ( directory / "Missing.bin" ).wstring() );
+
+    WriteTestFile( fileNames[0], 0 );
+    WriteTestFile( fileNames[1], TEST_HASH_CHUNK_SIZE );
+    WriteTestFile( fileNames[2], TEST_HASH_CHUNK_SIZE + 1 );
+    WriteTestFile( fileNames[3], TEST_HASH_CHUNK_SIZE + 1, 1 );
+
+    std::vector<AssetCache::Key> hashes;
+    assetCache.HashFiles( fileNames, hashes );
+    CHECK_EQUAL( fileNames.size(), hashes.size() );
+
+    for ( size_t i = 0; i < 4; ++i )
+    {
+        AssetCache::Key hash = 0;
+        CHECK( AssetCache::HashFile( fileNames[i], hash ) );
+        CHECK_EQUAL( hash, hashes[i] );
+        CHECK( hash != 0 );
+
+        // Every file has a different hash.
+        for ( size_t j = 0; j < i; ++j )
+        {
+            CHECK( hashes[i] != hashes[j] );
+        }
+    }
+
+    // A file that can't be read has no hash.
+    AssetCache::Key missingHash = 0;
+    CHECK( !AssetCache::HashFile( fileNames[4], missingHash ) );
+    CHECK_EQUAL( 0ull, hashes[4] );
+
+    // The hashes don't depend on the number of threads.
+    jobSystem.SetNumThreads( 1 );
+    std::vector<AssetCache::Key> singleThreadHashes;
+    assetCache.HashFiles( fileNames, singleThreadHashes );
+    CHECK( singleThreadHashes == hashes );
+
+    fs::remove_all( directory, errorCode );
+}
@@ -0,0 +1,276 @@
+#include <EngineTestPCH.h>
+
+#include <BoundingBox.h>
+#include <DepthRasterizer.h>
+#include <Ray.h>
+#include <RaycastHit.h>
+
+#include <EngineTest.h>
+
+#define TEST_WIDTH 256
+#define TEST_HEIGHT 128
+// The rasterizer clips triangles at this distance from the camera (see DepthRasterizer.cpp).
+#define TEST_NEAR_CLIP_W 1e-3
+
+// The coverage and depth of one pixel of a reference rasterization.
+struct ReferenceSample
+{
+    bool Covered;
+    // The center of the pixel is too close to an edge of a covering triangle to decide if it is covered.
+    bool Ambiguous;
+    double Depth;
+};
+typedef std::vector<ReferenceSample> ReferenceSampleList;
+
+// Rasterize triangles exhaustively: every pixel center is tested against every triangle in homogeneous
+// clip space (without clipping or a perspective divide of the vertices). This is slow but independent
+// of the edge functions, the clipping and the depth interpolation of the DepthRasterizer.
+static void RasterizeReference( const glm::mat4& modelViewProjection, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, ReferenceSampleList& samples )
+{
+    for ( size_t t = 0; t + 2 < indices.size(); t += 3 )
+    {
+        glm::dvec4 v[3];
+        for ( int i = 0; i < 3; ++i )
+        {
+            v[i] = glm::dvec4( modelViewProjection * glm::vec4( positions[indices[t + i]], 1 ) );
+        }
+
+        for ( uint32_t y = 0; y < TEST_HEIGHT; ++y )
+        {
+            for ( uint32_t x = 0; x < TEST_WIDTH; ++x )
+            {
+                // The normalized device coordinates of the pixel center.
+                double nx = ( x + 0.5 ) / TEST_WIDTH * 2.0 - 1.0;
+                double ny = 1.0 - ( y + 0.5 ) / TEST_HEIGHT * 2.0;
+
+                // Solve for the barycentric coordinates (b0, b1, b2) of the point of the triangle
+                // that projects onto the pixel center: sum( b * ( v.x - nx * v.w ) ) = 0,
+                // sum( b * ( v.y - ny * v.w ) ) = 0 and sum( b ) = 1.
+                glm::dmat3 m( v[0].x - nx * v[0].w, v[0].y - ny * v[0].w, 1.0,
+                              v[1].x - nx * v[1].w, v[1].y - ny * v[1].w, 1.0,
+                              v[2].x - nx * v[2].w, v[2].y - ny * v[2].w, 1.0 );
+                double det = glm::determinant( m );
+                if ( glm::abs( det ) < 1e-12 ) continue;
+                glm::dvec3 b = glm::inverse( m ) * glm::dvec3( 0, 0, 1 );
+
+                glm::dvec4 p = b.x * v[0] + b.y * v[1] + b.z * v[2];
+                if ( p.w < TEST_NEAR_CLIP_W ) continue;
+
+                double minWeight = glm::min( b.x, glm::min( b.y, b.z ) );
+                ReferenceSample& sample = samples[y * TEST_WIDTH + x];
+                if ( glm::abs( minWeight ) < 1e-4 || glm::abs( p.w - TEST_NEAR_CLIP_W ) < 1e-4 )
+                {
+                    sample.Ambiguous = true;
+                }
+                else if ( minWeight > 0.0 )
+                {
+                    double depth = p.z / p.w;
+                    sample.Depth = sample.Covered ? glm::min( sample.Depth, depth ) : depth;
+                    sample.Covered = true;
+                }
+            }
+        }
+    }
+}
+
+// Append the 12 triangles of a box.
+static void AddBox( const BoundingBox& box, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices )
+{
+    uint32_t first = (uint32_t)positions.size();
+    for ( uint32_t i = 0; i < 8; ++i )
+    {
+        positions.push_back( box.GetCorner( i ) );
+    }
+    // The corners of each face (bit 0: x, bit 1: y, bit 2: z).
+    const uint32_t faces[6][4] = { { 0, 2, 6, 4 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 }, { 2, 3, 7, 6 }, { 0, 1, 3, 2 }, { 4, 5, 7, 6 } };
+    for ( const uint32_t* face : faces )
+    {
+        const uint32_t triangles[6] = { face[0], face[1], face[2], face[0], face[2], face[3] };
+        for ( uint32_t i : triangles )
+        {
+            indices.push_back( first + i );
+        }
+    }
+}
+
+static glm::mat4 GetTestViewProjection()
+{
+    // A camera at the origin that looks down the negative z axis.
+    return glm::perspective( glm::radians( 60.0f ), (float)TEST_WIDTH / TEST_HEIGHT, 0.1f, 100.0f );
+}
+
+TEST( DepthRasterizerMatchesReference )
+{
+    glm::mat4 viewProjection = GetTestViewProjection();
+
+    // Random triangles in front of the camera, partly outside of the view and partly behind the camera
+    // (so they are clipped against the near plane).
+    std::mt19937 random( 0 );
+    std::uniform_real_distribution<float> position( -10.0f, 10.0f );
+    std::uniform_real_distribution<float> depth( -30.0f, 2.0f );
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for ( uint32_t i = 0; i < 3 * 64; ++i )
+    {
+        positions.push_back( glm::vec3( position( random ), position( random ), depth( random ) ) );
+        indices.push_back( i );
+    }
+
+    DepthRasterizer rasterizer( TEST_WIDTH, TEST_HEIGHT );
+    rasterizer.RasterizeTriangles( viewProjection, positions.data(), indices.data(), (uint32_t)indices.size() );
+
+    ReferenceSampleList reference( TEST_WIDTH * TEST_HEIGHT, ReferenceSample() );
+    RasterizeReference( viewProjection, positions, indices, reference );
+
+    uint32_t numCompared = 0;
+    uint32_t numCovered = 0;
+    uint32_t numMismatches = 0;
+    for ( uint32_t y = 0; y < TEST_HEIGHT; ++y )
+    {
+        for ( uint32_t x = 0; x < TEST_WIDTH; ++x )
+        {
+            const ReferenceSample& sample = reference[y * TEST_WIDTH + x];
+            if ( sample.Ambiguous ) continue;
+
+            float rasterizedDepth = rasterizer.GetDepth( x, y );
+            bool covered = rasterizedDepth != std::numeric_limits<float>::max();
+            if ( covered != sample.Covered || ( covered && glm::abs( rasterizedDepth - sample.Depth ) > 1e-4 ) )
+            {
+                ++numMismatches;
+            }
+            ++numCompared;
+            if ( sample.Covered ) ++numCovered;
+        }
+    }
+
+    CHECK_EQUAL( 0u, numMismatches );
+    // Most pixels can be compared and the test covers a good part of the screen.
+    CHECK( numCompared > TEST_WIDTH * TEST_HEIGHT * 9 / 10 );
+    CHECK( numCovered > numCompared / 4 );
+}
+
+TEST( DepthRasterizerHierarchyIsConservative )
+{
+    DepthRasterizer rasterizer( TEST_WIDTH, TEST_HEIGHT );
+    glm::vec3 positions[] = { glm::vec3( -2, -2, -5 ), glm::vec3( 3, -1, -8 ), glm::vec3( 0, 4, -6 ) };
+    uint32_t indices[] = { 0, 1, 2 };
+    rasterizer.RasterizeTriangles( GetTestViewProjection(), positions, indices, 3 );
+    rasterizer.BuildHierarchy();
+
+    CHECK_EQUAL( 9u, rasterizer.GetNumLevels() );
+    // Every texel stores the farthest depth of the texels it covers in the level below.
+    for ( uint32_t level = 1; level < rasterizer.GetNumLevels(); ++level )
+    {
+        uint32_t width = std::max<uint32_t>( 1, TEST_WIDTH >> ( level - 1 ) );
+        uint32_t height = std::max<uint32_t>( 1, TEST_HEIGHT >> ( level - 1 ) );
+        for ( uint32_t y = 0; y < height; ++y )
+        {
+            for ( uint32_t x = 0; x < width; ++x )
+            {
+                CHECK( rasterizer.GetDepth( x / 2, y / 2, level ) >= rasterizer.GetDepth( x, y, level - 1 ) );
+            }
+        }
+    }
+}
+
+TEST( DepthRasterizerVisibilityMatchesReference )
+{
+    glm::mat4 viewProjection = GetTestViewProjection();
+
+    // The occluders are a wall in the middle of the view and a few random boxes.
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    AddBox( BoundingBox( glm::vec3( -4, -3, -10.5f ), glm::vec3( 4, 3, -10 ) ), positions, indices );
+
+    std::mt19937 random( 1 );
+    std::uniform_real_distribution<float> position( -8.0f, 8.0f );
+    std::uniform_real_distribution<float> depth( -25.0f, -2.0f );
+    std::uniform_real_distribution<float> size( 0.2f, 3.0f );
+    for ( uint32_t i = 0; i < 8; ++i )
+    {
+        glm::vec3 center( position( random ), position( random ), depth( random ) );
+        glm::vec3 extents( size( random ), size( random ), size( random ) );
+        AddBox( BoundingBox( center - extents, center + extents ), positions, indices );
+    }
+
+    DepthRasterizer rasterizer( TEST_WIDTH, TEST_HEIGHT );
+    rasterizer.RasterizeTriangles( viewProjection, positions.data(), indices.data(), (uint32_t)indices.size() );
+    rasterizer.BuildHierarchy();
+
+    // A box behind the wall is culled, a box in front of the wall is not.
+    CHECK( !rasterizer.IsVisible( viewProjection, BoundingBox( glm::vec3( -1, -1, -16 ), glm::vec3( 1, 1, -14 ) ) ) );
+    CHECK( rasterizer.IsVisible( viewProjection, BoundingBox( glm::vec3( -1, -1, -6 ), glm::vec3( 1, 1, -4 ) ) ) );
+    // A box behind the camera or outside of the view is not visible.
+    CHECK( !rasterizer.IsVisible( viewProjection, BoundingBox( glm::vec3( -1, -1, 4 ), glm::vec3( 1, 1, 6 ) ) ) );
+    CHECK( !rasterizer.IsVisible( viewProjection, BoundingBox( glm::vec3( 50, -1, -6 ), glm::vec3( 52, 1, -4 ) ) ) );
+    // A box that intersects the near plane is always visible.
+    CHECK( rasterizer.IsVisible( viewProjection, BoundingBox( glm::vec3( -1, -1, -1 ), glm::vec3( 1, 1, 1 ) ) ) );
+
+    // Test random boxes against an exhaustive rasterization of their faces: a box that has a pixel
+    // in front of the occluders must never be culled.
+    uint32_t numVisible = 0;
+    uint32_t numCulled = 0;
+    uint32_t numFalseNegatives = 0;
+    for ( uint32_t i = 0; i < 500; ++i )
+    {
+        glm::vec3 center( position( random ), position( random ), depth( random ) - 5.0f );
+        glm::vec3 extents = 0.25f * glm::vec3( size( random ), size( random ), size( random ) );
+        BoundingBox box( center - extents, center + extents );
+
+        std::vector<glm::vec3> boxPositions;
+        std::vector<uint32_t> boxIndices;
+        AddBox( box, boxPositions, boxIndices );
+        ReferenceSampleList reference( TEST_WIDTH * TEST_HEIGHT, ReferenceSample() );
+        RasterizeReference( viewProjection, boxPositions, boxIndices, reference );
+
+        bool visible = false;
+        for ( uint32_t y = 0; y < TEST_HEIGHT && !visible; ++y )
+        {
+            for ( uint32_t x = 0; x < TEST_WIDTH && !visible; ++x )
+            {
+                const ReferenceSample& sample = reference[y * TEST_WIDTH + x];
+                visible = sample.Covered && sample.Depth < rasterizer.GetDepth( x, y ) - 1e-5;
+            }
+        }
+
+        bool culled = !rasterizer.IsVisible( viewProjection, box );
+        if ( visible ) ++numVisible;
+        if ( culled ) ++numCulled;
+        if ( visible && culled ) ++numFalseNegatives;
+    }
+
+    CHECK_EQUAL( 0u, numFalseNegatives );
+    // The test must exercise both outcomes.
+    CHECK( numVisible > 50 );
+    CHECK( numCulled > 50 );
+}
+
+TEST( DepthRasterizerPointOcclusion )
+{
+    glm::mat4 viewProjection = GetTestViewProjection();
+
+    // A wall in the middle of the view.
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    AddBox( BoundingBox( glm::vec3( -4, -3, -10.5f ), glm::vec3( 4, 3, -10 ) ), positions, indices );
+
+    DepthRasterizer rasterizer( TEST_WIDTH, TEST_HEIGHT );
+    rasterizer.RasterizeTriangles( viewProjection, positions.data(), indices.data(), (uint32_t)indices.size() );
+    rasterizer.BuildHierarchy();
+
+    // Picking a light volume: the point where a ray from the camera enters the volume is tested against the wall.
+    // A volume behind the wall is occluded, a volume in front of the wall or a volume that reaches through the wall is not.
+    Ray ray( glm::vec3( 0 ), glm::vec3( 0, 0, -1 ) );
+    RaycastHit hit;
+    CHECK( ray.IntersectSphere( glm::vec3( 0, 0, -15 ), 1.0f, hit ) );
+    CHECK( rasterizer.IsPointOccluded( viewProjection, hit.Point ) );
+    CHECK( ray.IntersectSphere( glm::vec3( 0, 0, -5 ), 1.0f, hit ) );
+    CHECK( !rasterizer.IsPointOccluded( viewProjection, hit.Point ) );
+    CHECK( ray.IntersectSphere( glm::vec3( 0, 0, -10.8f ), 1.0f, hit ) );
+    CHECK( !rasterizer.IsPointOccluded( viewProjection, hit.Point ) );
+
+    // Points next to the wall, behind the camera or outside of the view are not occluded.
+    CHECK( !rasterizer.IsPointOccluded( viewProjection, glm::vec3( 8, 0, -15 ) ) );
+    CHECK( !rasterizer.IsPointOccluded( viewProjection, glm::vec3( 0, 0, 15 ) ) );
+    CHECK( !rasterizer.IsPointOccluded( viewProjection, glm::vec3( 50, 0, -15 ) ) );
+}
@@ -0,0 +1,242 @@
+#include <EngineTestPCH.h>
+
+#include <DescriptorAllocator.h>
+#include <TransientDescriptorRing.h>
+
+#include <EngineTest.h>
+
+// A descriptor heap without a device that remembers which descriptors are in use.
+class MockDescriptorPageHeap : public DescriptorPageHeap
+{
+public:
+    virtual void CreatePage( uint32_t numDescriptors )
+    {
+        Pages.push_back( std::vector<bool>( numDescriptors, false ) );
+    }
+
+    // Mark the descriptors of an allocation as used (or unused).
+    // Returns false if any of the descriptors already had that state.
+    bool SetUsed( const DescriptorAllocation& allocation, bool used )
+    {
+        bool valid = allocation.IsValid() && allocation.Page < Pages.size() && allocation.Offset + allocation.Count <= Pages[allocation.Page].size();
+        for ( uint32_t i = 0; valid && i < allocation.Count; ++i )
+        {
+            valid = ( Pages[allocation.Page][allocation.Offset + i] != used );
+            Pages[allocation.Page][allocation.Offset + i] = used;
+        }
+        return valid;
+    }
+
+    std::vector< std::vector<bool> > Pages;
+};
+
+TEST( DescriptorAllocatorAllocationsDontOverlap )
+{
+    MockDescriptorPageHeap heap;
+    DescriptorAllocator allocator( heap, 64 );
+
+    std::mt19937 random( 0 );
+    for ( int i = 0; i < 100; ++i )
+    {
+        CHECK( heap.SetUsed( allocator.Allocate( 1 + random() % 8 ), true ) );
+    }
+    CHECK_EQUAL( (uint32_t)heap.Pages.size(), allocator.GetNumPages() );
+}
+
+TEST( DescriptorAllocatorFreesAfterFence )
+{
+    MockDescriptorPageHeap heap;
+    DescriptorAllocator allocator( heap, 16 );
+
+    DescriptorAllocation allocation = allocator.Allocate( 16 );
+    CHECK_EQUAL( 0u, allocator.GetNumFreeDescriptors() );
+
+    // The descriptors can still be used by the GPU until fence 2 is completed.
+    allocator.Free( allocation, 2 );
+    CHECK_EQUAL( 16u, allocator.GetNumStaleDescriptors() );
+    allocator.ReleaseStaleDescriptors( 1 );
+    CHECK_EQUAL( 0u, allocator.GetNumFreeDescriptors() );
+
+    // A new page is created instead of reusing the stale descriptors.
+    DescriptorAllocation other = allocator.Allocate( 1 );
+    CHECK_EQUAL( 1u, other.Page );
+    CHECK_EQUAL( 2u, allocator.GetNumPages() );
+
+    allocator.ReleaseStaleDescriptors( 2 );
+    CHECK_EQUAL( 0u, allocator.GetNumStaleDescriptors() );
+    CHECK_EQUAL( 31u, allocator.GetNumFreeDescriptors() );
+}
+
+TEST( DescriptorAllocatorMergesFreeRanges )
+{
+    MockDescriptorPageHeap heap;
+    DescriptorAllocator allocator( heap, 16 );
+
+    std::vector<DescriptorAllocation> allocations;
+    for ( int i = 0; i < 4; ++i )
+    {
+        allocations.push_back( allocator.Allocate( 4 ) );
+    }
+
+    // Free the ranges out of order, they are merged into a single range of the whole page.
+    allocator.Free( allocations[1], 1 );
+    allocator.Free( allocations[3], 1 );
+    allocator.Free( allocations[0], 1 );
+    allocator.Free( allocations[2], 1 );
+    allocator.ReleaseStaleDescriptors( 1 );
+
+    DescriptorAllocation page = allocator.Allocate( 16 );
+    CHECK_EQUAL( 0u, page.Page );
+    CHECK_EQUAL( 0u, page.Offset );
+    CHECK_EQUAL( 1u, allocator.GetNumPages() );
+}
+
+TEST( DescriptorAllocatorUsesSmallestFreeRange )
+{
+    MockDescriptorPageHeap heap;
+    DescriptorAllocator allocator( heap, 16 );
+
+    // Leave a free range of 4 descriptors at offset 2 and a free range of 2 descriptors at offset 8.
+    DescriptorAllocation a = allocator.Allocate( 2 );
+    DescriptorAllocation b = allocator.Allocate( 4 );
+    DescriptorAllocation c = allocator.Allocate( 2 );
+    DescriptorAllocation d = allocator.Allocate( 2 );
+    DescriptorAllocation e = allocator.Allocate( 6 );
+    allocator.Free( b, 1 );
+    allocator.Free( d, 1 );
+    allocator.ReleaseStaleDescriptors( 1 );
+
+    DescriptorAllocation small = allocator.Allocate( 2 );
+    CHECK_EQUAL( d.Offset, small.Offset );
+    DescriptorAllocation large = allocator.Allocate( 3 );
+    CHECK_EQUAL( b.Offset, large.Offset );
+
+    CHECK( heap.SetUsed( a, true ) && heap.SetUsed( c, true ) && heap.SetUsed( e, true ) );
+    CHECK( heap.SetUsed( small, true ) && heap.SetUsed( large, true ) );
+}
+
+TEST( TransientDescriptorRingSkipsEndOfRing )
+{
+    MockDescriptorPageHeap heap;
+    TransientDescriptorRing ring( heap, 10 );
+    CHECK_EQUAL( 1u, (uint32_t)heap.Pages.size() );
+
+    CHECK_EQUAL( 0u, ring.Allocate( 4 ).Offset );
+    CHECK_EQUAL( 4u, ring.Allocate( 4 ).Offset );
+    ring.EndFrame( 1 );
+    ring.Retire( 1 );
+
+    // The range doesn't fit at the end of the ring, so the last 2 descriptors are skipped.
+    DescriptorAllocation wrapped = ring.Allocate( 4 );
+    CHECK( wrapped.IsValid() );
+    CHECK_EQUAL( 0u, wrapped.Offset );
+    CHECK_EQUAL( 6u, ring.GetNumUsedDescriptors() );
+}
+
+TEST( TransientDescriptorRingRetiresFrames )
+{
+    MockDescriptorPageHeap heap;
+    TransientDescriptorRing ring( heap, 8 );
+
+    CHECK( ring.Allocate( 6 ).IsValid() );
+    ring.EndFrame( 1 );
+    // The ring is full until the GPU has finished frame 1.
+    CHECK( !ring.Allocate( 4 ).IsValid() );
+    ring.Retire( 0 );
+    CHECK( !ring.Allocate( 4 ).IsValid() );
+
+    ring.Retire( 1 );
+    CHECK_EQUAL( 0u, ring.GetNumUsedDescriptors() );
+    CHECK( ring.Allocate( 4 ).IsValid() );
+    // A range larger than the ring never fits.
+    CHECK( !ring.Allocate( 9 ).IsValid() );
+}
+
+// The descriptor allocator benchmark keeps BENCHMARK_NUM_DESCRIPTOR_RANGES ranges of descriptors alive
+// and replaces 10% of them every frame. The GPU is BENCHMARK_FRAMES_IN_FLIGHT frames behind the CPU.
+#define BENCHMARK_NUM_DESCRIPTOR_RANGES 10000
+#define BENCHMARK_NUM_DESCRIPTOR_FRAMES 1000
+#define BENCHMARK_FRAMES_IN_FLIGHT 3
+
+// Measure the CPU time to allocate and free descriptors from the persistent descriptor allocator
+// and the transient descriptor ring. A mock heap checks that allocated descriptors never overlap.
+BENCHMARK( DescriptorAllocatorBenchmark )
+{
+    std::cout << "Descriptor allocator benchmark (" << BENCHMARK_NUM_DESCRIPTOR_FRAMES << " frames, " << BENCHMARK_FRAMES_IN_FLIGHT << " frames in flight):" << std::endl;
+
+    // Persistent descriptors: the same sequence is run with and without checking the mock heap.
+    for ( int validate = 1; validate >= 0; --validate )
+    {
+        MockDescriptorPageHeap heap;
+        DescriptorAllocator allocator( heap, 1024 );
+        std::vector<DescriptorAllocation> allocations;
+        allocations.reserve( BENCHMARK_NUM_DESCRIPTOR_RANGES );
+        std::mt19937 random( 0 );
+        uint32_t numErrors = 0;
+
+        BenchmarkTimer timer;
+        for ( uint64_t frame = 1; frame <= BENCHMARK_NUM_DESCRIPTOR_FRAMES; ++frame )
+        {
+            allocator.ReleaseStaleDescriptors( frame > BENCHMARK_FRAMES_IN_FLIGHT ? frame - BENCHMARK_FRAMES_IN_FLIGHT : 0 );
+
+            for ( uint32_t i = 0; i < BENCHMARK_NUM_DESCRIPTOR_RANGES / 10 && !allocations.empty(); ++i )
+            {
+                size_t index = random() % allocations.size();
+                if ( validate && !heap.SetUsed( allocations[index], false ) ) ++numErrors;
+                allocator.Free( allocations[index], frame );
+                allocations[index] = allocations.back();
+                allocations.pop_back();
+            }
+
+            while ( allocations.size() < BENCHMARK_NUM_DESCRIPTOR_RANGES )
+            {
+                // Descriptor tables of 1 to 8 descriptors.
+                DescriptorAllocation allocation = allocator.Allocate( 1 + random() % 8 );
+                if ( validate && !heap.SetUsed( allocation, true ) ) ++numErrors;
+                allocations.push_back( allocation );
+            }
+        }
+        timer.Tick();
+
+        if ( validate )
+        {
+            std::cout << "Persistent: " << allocator.GetNumPages() << " pages of " << allocator.GetDescriptorsPerPage() << " descriptors, "
+                << allocator.GetNumFreeDescriptors() << " free, " << allocator.GetNumStaleDescriptors() << " stale, "
+                << numErrors << " overlapping allocations" << std::endl;
+            CHECK_EQUAL( 0u, numErrors );
+        }
+        else
+        {
+            std::cout << "Persistent: " << timer.ElapsedMilliSeconds() / BENCHMARK_NUM_DESCRIPTOR_FRAMES << " ms per frame" << std::endl;
+        }
+    }
+
+    // Transient descriptors: every frame allocates descriptor tables for BENCHMARK_NUM_DESCRIPTOR_RANGES draw calls.
+    {
+        MockDescriptorPageHeap heap;
+        TransientDescriptorRing ring( heap, 4 * BENCHMARK_FRAMES_IN_FLIGHT * BENCHMARK_NUM_DESCRIPTOR_RANGES );
+        std::mt19937 random( 0 );
+        uint32_t numFailed = 0;
+        uint32_t maxUsed = 0;
+
+        BenchmarkTimer timer;
+        for ( uint64_t frame = 1; frame <= BENCHMARK_NUM_DESCRIPTOR_FRAMES; ++frame )
+        {
+            ring.Retire( frame > BENCHMARK_FRAMES_IN_FLIGHT ? frame - BENCHMARK_FRAMES_IN_FLIGHT : 0 );
+
+            for ( uint32_t i = 0; i < BENCHMARK_NUM_DESCRIPTOR_RANGES; ++i )
+            {
+                if ( !ring.Allocate( 1 + random() % 4 ).IsValid() ) ++numFailed;
+            }
+            maxUsed = std::max( maxUsed, ring.GetNumUsedDescriptors() );
+
+            ring.EndFrame( frame );
+        }
+        timer.Tick();
+
+        std::cout << "Transient: " << timer.ElapsedMilliSeconds() / BENCHMARK_NUM_DESCRIPTOR_FRAMES << " ms per frame, "
+            << maxUsed << " of " << ring.GetNumDescriptors() << " descriptors used, "
+            << numFailed << " failed allocations" << std::endl;
+        CHECK_EQUAL( 0u, numFailed );
+    }
+}
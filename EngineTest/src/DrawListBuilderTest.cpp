@@ -0,0 +1,209 @@
+#include <EngineTestPCH.h>
+
+// The draw list builder of the engine fills the render queues of test draw lists
+// with the meshes of scenes that are created with the null render device (see TestScene.h).
+#include <GraphicsTestPCH.h>
+
+#include <JobSystem.h>
+#include <ContentHash.h>
+#include <RenderQueue.h>
+#include <LodSelector.h>
+#include <DrawList.h>
+#include <DrawListBuilder.h>
+
+#include <EngineTest.h>
+#include <TestScene.h>
+
+// A draw list that only keeps the opaque or the transparent meshes.
+class TestDrawList : public DrawList
+{
+public:
+    TestDrawList( std::shared_ptr<PipelineState> pipeline, bool transparent )
+        : m_Pipeline( pipeline )
+        , m_RenderQueue( std::make_shared<RenderQueue>( transparent ? RenderQueue::SortOrder::BackToFront : RenderQueue::SortOrder::FrontToBack ) )
+        , m_Transparent( transparent )
+        , m_RenderQueueBuilt( false )
+    {}
+
+    virtual bool FilterMesh( Mesh& mesh, const glm::mat4& modelViewProjection )
+    {
+        return mesh.GetMaterial()->IsTransparent() == m_Transparent;
+    }
+
+    virtual std::shared_ptr<PipelineState> GetPipelineState() const
+    {
+        return m_Pipeline;
+    }
+
+    virtual std::shared_ptr<RenderQueue> GetRenderQueue() const
+    {
+        return m_RenderQueue;
+    }
+
+    virtual void SetRenderQueueBuilt( bool renderQueueBuilt )
+    {
+        m_RenderQueueBuilt = renderQueueBuilt;
+    }
+
+    bool IsRenderQueueBuilt() const
+    {
+        return m_RenderQueueBuilt;
+    }
+
+    // The hash of the sorted render items.
+    uint64_t GetRenderQueueHash() const
+    {
+        ContentHash hash;
+        for ( size_t i = 0; i < m_RenderQueue->GetSize(); ++i )
+        {
+            const RenderQueue::RenderItem& renderItem = m_RenderQueue->GetRenderItem( i );
+            hash.Update( &renderItem.Mesh, sizeof( renderItem.Mesh ) );
+            hash.Update( &renderItem.ModelViewProjection, sizeof( renderItem.ModelViewProjection ) );
+            hash.Update( &renderItem.Lod, sizeof( renderItem.Lod ) );
+        }
+        return hash.GetHash();
+    }
+
+private:
+    std::shared_ptr<PipelineState> m_Pipeline;
+    std::shared_ptr<RenderQueue> m_RenderQueue;
+    bool m_Transparent;
+    bool m_RenderQueueBuilt;
+};
+
+// A scene with numNodes nodes that alternate between numMeshes meshes.
+// Every fourth mesh is transparent.
+static std::shared_ptr<TestScene> CreateDrawListScene( RenderDevice& renderDevice, uint32_t numNodes, uint32_t numMeshes )
+{
+    std::shared_ptr<Material> transparentMaterial = renderDevice.CreateMaterial();
+    transparentMaterial->SetOpacity( 0.5f );
+
+    std::vector< std::shared_ptr<Mesh> > meshes;
+    for ( uint32_t i = 0; i < numMeshes; ++i )
+    {
+        meshes.push_back( CreateTestBox( renderDevice, ( i % 4 == 3 ) ? transparentMaterial : renderDevice.CreateMaterial() ) );
+    }
+
+    std::shared_ptr<TestScene> scene = std::make_shared<TestScene>();
+    for ( uint32_t i = 0; i < numNodes; ++i )
+    {
+        scene->AddMesh( meshes[i % numMeshes], glm::vec3( ( i % 100 ) * 2.0f, ( i / 100 % 100 ) * 2.0f, ( i / 10000 ) * -2.0f ) );
+    }
+
+    return scene;
+}
+
+// The same camera as RenderTestFrame.
+static void SetupDrawListCamera( Camera& camera )
+{
+    camera.SetProjectionRH( 45.0f, 1.0f, 0.1f, 1000.0f );
+    camera.SetTranslate( glm::vec3( 0, 0, 100 ) );
+}
+
+TEST( DrawListBuilderOutputDoesNotDependOnThreads )
+{
+    RenderDeviceNull renderDevice;
+    std::shared_ptr<TestScene> scene = CreateDrawListScene( renderDevice, 5000, 16 );
+    std::shared_ptr<PipelineState> pipeline = CreateTestPipeline( renderDevice );
+
+    std::shared_ptr<TestDrawList> opaqueDrawList = std::make_shared<TestDrawList>( pipeline, false );
+    std::shared_ptr<TestDrawList> transparentDrawList = std::make_shared<TestDrawList>( pipeline, true );
+
+    Camera camera;
+    SetupDrawListCamera( camera );
+    std::shared_ptr<LodSelector> lodSelector = std::make_shared<LodSelector>();
+    lodSelector->Update( camera );
+
+    JobSystem jobSystem( 3 );
+    DrawListBuilder drawListBuilder( scene, jobSystem );
+    drawListBuilder.AddDrawList( opaqueDrawList );
+    drawListBuilder.AddDrawList( transparentDrawList );
+    drawListBuilder.SetLodSelector( lodSelector );
+
+    uint64_t expectedOpaqueHash = 0;
+    uint64_t expectedTransparentHash = 0;
+    for ( uint32_t numThreads = 1; numThreads <= 4; ++numThreads )
+    {
+        jobSystem.SetNumThreads( numThreads );
+        drawListBuilder.Build( camera );
+
+        // The root node and one node per mesh.
+        CHECK_EQUAL( 5001u, drawListBuilder.GetNumNodes() );
+        CHECK( opaqueDrawList->IsRenderQueueBuilt() );
+        CHECK( transparentDrawList->IsRenderQueueBuilt() );
+        CHECK_EQUAL( (size_t)3750, opaqueDrawList->GetRenderQueue()->GetSize() );
+        CHECK_EQUAL( (size_t)1250, transparentDrawList->GetRenderQueue()->GetSize() );
+
+        if ( numThreads == 1 )
+        {
+            expectedOpaqueHash = opaqueDrawList->GetRenderQueueHash();
+            expectedTransparentHash = transparentDrawList->GetRenderQueueHash();
+        }
+        CHECK_EQUAL( expectedOpaqueHash, opaqueDrawList->GetRenderQueueHash() );
+        CHECK_EQUAL( expectedTransparentHash, transparentDrawList->GetRenderQueueHash() );
+    }
+}
+
+#define BENCHMARK_MAX_DRAW_LIST_THREADS 32
+#define BENCHMARK_NUM_DRAW_LIST_NODES 100000
+#define BENCHMARK_NUM_DRAW_LIST_MESHES 100
+#define BENCHMARK_NUM_DRAW_LIST_FRAMES 10
+
+// Measure how building the render queues of an opaque and a transparent draw list for
+// BENCHMARK_NUM_DRAW_LIST_NODES nodes scales from 1 to BENCHMARK_MAX_DRAW_LIST_THREADS threads.
+// Every thread count must produce the same sorted render queues.
+BENCHMARK( DrawListBuilderScaling )
+{
+    RenderDeviceNull renderDevice;
+    std::shared_ptr<TestScene> scene = CreateDrawListScene( renderDevice, BENCHMARK_NUM_DRAW_LIST_NODES, BENCHMARK_NUM_DRAW_LIST_MESHES );
+    std::shared_ptr<PipelineState> pipeline = CreateTestPipeline( renderDevice );
+
+    std::shared_ptr<TestDrawList> opaqueDrawList = std::make_shared<TestDrawList>( pipeline, false );
+    std::shared_ptr<TestDrawList> transparentDrawList = std::make_shared<TestDrawList>( pipeline, true );
+
+    Camera camera;
+    SetupDrawListCamera( camera );
+    std::shared_ptr<LodSelector> lodSelector = std::make_shared<LodSelector>();
+    lodSelector->Update( camera );
+
+    JobSystem jobSystem( BENCHMARK_MAX_DRAW_LIST_THREADS - 1 );
+    DrawListBuilder drawListBuilder( scene, jobSystem );
+    drawListBuilder.AddDrawList( opaqueDrawList );
+    drawListBuilder.AddDrawList( transparentDrawList );
+    drawListBuilder.SetLodSelector( lodSelector );
+
+    std::cout << "Draw list builder scaling (" << BENCHMARK_NUM_DRAW_LIST_NODES << " nodes, "
+        << std::thread::hardware_concurrency() << " hardware threads):" << std::endl;
+
+    double singleThreadMilliSeconds = 0.0;
+    uint64_t expectedOpaqueHash = 0;
+    uint64_t expectedTransparentHash = 0;
+    for ( uint32_t numThreads = 1; numThreads <= BENCHMARK_MAX_DRAW_LIST_THREADS; numThreads *= 2 )
+    {
+        jobSystem.SetNumThreads( numThreads );
+
+        // The first frame allocates the arenas and the render queues.
+        drawListBuilder.Build( camera );
+
+        BenchmarkTimer timer;
+        for ( uint32_t frame = 0; frame < BENCHMARK_NUM_DRAW_LIST_FRAMES; ++frame )
+        {
+            drawListBuilder.Build( camera );
+        }
+        timer.Tick();
+
+        double milliSeconds = timer.ElapsedMilliSeconds() / BENCHMARK_NUM_DRAW_LIST_FRAMES;
+        if ( numThreads == 1 )
+        {
+            singleThreadMilliSeconds = milliSeconds;
+            expectedOpaqueHash = opaqueDrawList->GetRenderQueueHash();
+            expectedTransparentHash = transparentDrawList->GetRenderQueueHash();
+        }
+        CHECK_EQUAL( (size_t)BENCHMARK_NUM_DRAW_LIST_NODES, opaqueDrawList->GetRenderQueue()->GetSize() + transparentDrawList->GetRenderQueue()->GetSize() );
+        CHECK_EQUAL( expectedOpaqueHash, opaqueDrawList->GetRenderQueueHash() );
+        CHECK_EQUAL( expectedTransparentHash, transparentDrawList->GetRenderQueueHash() );
+
+        std::cout << numThreads << " threads: " << milliSeconds << " ms per frame, "
+            << singleThreadMilliSeconds / milliSeconds << "x speedup" << std::endl;
+    }
+}
@@ -0,0 +1 @@
+#include <EngineTestPCH.h>
@@ -0,0 +1,198 @@
+#include <EngineTestPCH.h>
+
+#include <JobSystem.h>
+
+#include <EngineTest.h>
+
+// Check that every index of a loop is executed exactly once.
+static void CheckParallelFor( JobSystem& jobSystem, uint32_t count, uint32_t batchSize )
+{
+    std::vector< std::atomic<uint32_t> > numExecuted( count );
+    for ( std::atomic<uint32_t>& n : numExecuted ) n = 0;
+    std::atomic<uint32_t> numInvalidThreads( 0 );
+
+    jobSystem.ParallelFor( count, batchSize, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        if ( threadIndex >= jobSystem.GetMaxThreads() || end - begin > std::max( batchSize, 1u ) ) ++numInvalidThreads;
+        for ( uint32_t i = begin; i < end; ++i )
+        {
+            ++numExecuted[i];
+        }
+    } );
+
+    CHECK_EQUAL( 0u, numInvalidThreads.load() );
+    for ( uint32_t i = 0; i < count; ++i )
+    {
+        CHECK_EQUAL( 1u, numExecuted[i].load() );
+    }
+}
+
+TEST( JobSystemParallelForExecutesAllIndices )
+{
+    JobSystem jobSystem( 3 );
+    CHECK_EQUAL( 4u, jobSystem.GetMaxThreads() );
+
+    const uint32_t counts[] = { 0, 1, 7, 64, 1000, 4097 };
+    const uint32_t batchSizes[] = { 0, 1, 3, 64, 5000 };
+    for ( uint32_t count : counts )
+    {
+        for ( uint32_t batchSize : batchSizes )
+        {
+            CheckParallelFor( jobSystem, count, batchSize );
+        }
+    }
+}
+
+TEST( JobSystemSingleThread )
+{
+    JobSystem jobSystem( 3 );
+    jobSystem.SetNumThreads( 1 );
+    CHECK_EQUAL( 1u, jobSystem.GetNumThreads() );
+
+    // Only the calling thread executes the loop.
+    std::thread::id callingThread = std::this_thread::get_id();
+    bool otherThread = false;
+    jobSystem.ParallelFor( 100, 1, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        otherThread = otherThread || threadIndex != 0 || std::this_thread::get_id() != callingThread;
+    } );
+    CHECK( !otherThread );
+
+    // The number of threads is clamped.
+    jobSystem.SetNumThreads( 0 );
+    CHECK_EQUAL( 1u, jobSystem.GetNumThreads() );
+    jobSystem.SetNumThreads( 100 );
+    CHECK_EQUAL( jobSystem.GetMaxThreads(), jobSystem.GetNumThreads() );
+}
+
+TEST( JobSystemThreadIndicesAreUnique )
+{
+    JobSystem jobSystem( 7 );
+
+    // The thread index selects per-thread storage that is not synchronized.
+    // Threads that share an index would lose some of the increments.
+    for ( int repeat = 0; repeat < 10; ++repeat )
+    {
+        std::vector<uint64_t> sums( jobSystem.GetMaxThreads(), 0 );
+        jobSystem.ParallelFor( 100000, 16, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+        {
+            for ( uint32_t i = begin; i < end; ++i )
+            {
+                volatile uint64_t& sum = sums[threadIndex];
+                sum = sum + i;
+            }
+        } );
+        CHECK_EQUAL( 100000ull * 99999ull / 2, std::accumulate( sums.begin(), sums.end(), 0ull ) );
+    }
+}
+
+TEST( JobSystemNestedParallelFor )
+{
+    JobSystem jobSystem( 3 );
+
+    std::vector< std::atomic<uint32_t> > numExecuted( 64 * 64 );
+    for ( std::atomic<uint32_t>& n : numExecuted ) n = 0;
+    std::atomic<uint32_t> numIndexChanges( 0 );
+
+    // Every batch of the outer loop starts an inner loop. The loops must finish even when
+    // all of the worker threads are blocked in an inner loop.
+    jobSystem.ParallelFor( 64, 1, [&]( uint32_t begin, uint32_t end, uint32_t outerThreadIndex )
+    {
+        std::thread::id outerThread = std::this_thread::get_id();
+        jobSystem.ParallelFor( 64, 4, [&]( uint32_t innerBegin, uint32_t innerEnd, uint32_t threadIndex )
+        {
+            // The thread that started the inner loop keeps its index.
+            if ( std::this_thread::get_id() == outerThread && threadIndex != outerThreadIndex ) ++numIndexChanges;
+            for ( uint32_t i = innerBegin; i < innerEnd; ++i )
+            {
+                ++numExecuted[begin * 64 + i];
+            }
+        } );
+    } );
+
+    CHECK_EQUAL( 0u, numIndexChanges.load() );
+    for ( const std::atomic<uint32_t>& n : numExecuted )
+    {
+        CHECK_EQUAL( 1u, n.load() );
+    }
+}
+
+TEST( JobSystemConcurrentCallers )
+{
+    JobSystem jobSystem( 3 );
+
+    // Several threads that are not worker threads execute loops at the same time.
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> numFailed( 0 );
+    for ( uint32_t t = 0; t < 4; ++t )
+    {
+        threads.push_back( std::thread( [&]()
+        {
+            for ( int repeat = 0; repeat < 50; ++repeat )
+            {
+                std::atomic<uint32_t> sum( 0 );
+                jobSystem.ParallelFor( 1000, 10, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+                {
+                    for ( uint32_t i = begin; i < end; ++i ) sum += i;
+                } );
+                if ( sum != 1000 * 999 / 2 ) ++numFailed;
+            }
+        } ) );
+    }
+    for ( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    CHECK_EQUAL( 0u, numFailed.load() );
+}
+
+#define BENCHMARK_MAX_THREADS 32
+#define BENCHMARK_NUM_ITEMS 4096
+#define BENCHMARK_ITEM_ITERATIONS 20000
+
+// Measure how a compute bound parallel loop scales from 1 to BENCHMARK_MAX_THREADS threads.
+// The job system always creates BENCHMARK_MAX_THREADS - 1 worker threads and the number of threads
+// of the loop is limited with SetNumThreads (so the speedup is limited by the number of cores of the machine).
+BENCHMARK( JobSystemScaling )
+{
+    JobSystem jobSystem( BENCHMARK_MAX_THREADS - 1 );
+    std::vector<float> results( BENCHMARK_NUM_ITEMS );
+
+    std::cout << "Job system scaling (" << BENCHMARK_NUM_ITEMS << " items, " << std::thread::hardware_concurrency() << " hardware threads):" << std::endl;
+
+    double singleThreadMilliSeconds = 0.0;
+    float expected = 0.0f;
+    for ( uint32_t numThreads = 1; numThreads <= BENCHMARK_MAX_THREADS; numThreads *= 2 )
+    {
+        jobSystem.SetNumThreads( numThreads );
+        CHECK_EQUAL( numThreads, jobSystem.GetNumThreads() );
+
+        BenchmarkTimer timer;
+        jobSystem.ParallelFor( BENCHMARK_NUM_ITEMS, 16, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+        {
+            for ( uint32_t i = begin; i < end; ++i )
+            {
+                float x = (float)i;
+                for ( uint32_t j = 0; j < BENCHMARK_ITEM_ITERATIONS; ++j )
+                {
+                    x = x * 0.999f + 1.0f;
+                }
+                results[i] = x;
+            }
+        } );
+        timer.Tick();
+
+        // Every thread count must compute the same results.
+        float sum = std::accumulate( results.begin(), results.end(), 0.0f );
+        if ( numThreads == 1 )
+        {
+            singleThreadMilliSeconds = timer.ElapsedMilliSeconds();
+            expected = sum;
+        }
+        CHECK_EQUAL( expected, sum );
+
+        std::cout << numThreads << " threads: " << timer.ElapsedMilliSeconds() << " ms, "
+            << singleThreadMilliSeconds / timer.ElapsedMilliSeconds() << "x speedup" << std::endl;
+    }
+}
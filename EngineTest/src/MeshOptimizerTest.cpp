@@ -0,0 +1,529 @@
+#include <EngineTestPCH.h>
+
+#include <MeshOptimizer.h>
+
+#include <EngineTest.h>
+
+// A triangle with its indices rotated so that the smallest index comes first (the winding is preserved).
+typedef std::array<uint32_t, 3> Triangle;
+
+static Triangle MakeTriangle( const uint32_t* indices )
+{
+    uint32_t first = ( indices[1] < indices[0] && indices[1] < indices[2] ) ? 1 : ( indices[2] < indices[0] ? 2 : 0 );
+    Triangle triangle = { indices[first], indices[( first + 1 ) % 3], indices[( first + 2 ) % 3] };
+    return triangle;
+}
+
+// The sorted list of the triangles of an index buffer.
+static std::vector<Triangle> GetTriangles( const std::vector<uint32_t>& indices )
+{
+    std::vector<Triangle> triangles;
+    for ( size_t i = 0; i + 2 < indices.size(); i += 3 )
+    {
+        triangles.push_back( MakeTriangle( &indices[i] ) );
+    }
+    std::sort( triangles.begin(), triangles.end() );
+
+    return triangles;
+}
+
+// A grid of size x size quads in the xy plane (two triangles per quad, in row order).
+static void CreateGrid( uint32_t size, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices )
+{
+    positions.clear();
+    indices.clear();
+
+    for ( uint32_t y = 0; y <= size; ++y )
+    {
+        for ( uint32_t x = 0; x <= size; ++x )
+        {
+            positions.push_back( glm::vec3( (float)x, (float)y, 0.0f ) );
+        }
+    }
+
+    for ( uint32_t y = 0; y < size; ++y )
+    {
+        for ( uint32_t x = 0; x < size; ++x )
+        {
+            uint32_t i0 = y * ( size + 1 ) + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + size + 1;
+            uint32_t i3 = i2 + 1;
+
+            uint32_t quad[] = { i0, i1, i3, i0, i3, i2 };
+            indices.insert( indices.end(), quad, quad + 6 );
+        }
+    }
+}
+
+// A grid that is displaced along the z axis (a height field), so the triangles are not coplanar.
+// The triangles face the +z axis.
+static void CreateHeightField( uint32_t size, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices )
+{
+    CreateGrid( size, positions, indices );
+    for ( glm::vec3& position : positions )
+    {
+        position.z = 2.0f * sinf( position.x * 0.3f ) * cosf( position.y * 0.2f );
+    }
+}
+
+// A sphere with a radius of 1 around the origin (the triangles face outwards).
+static void CreateSphere( uint32_t stacks, uint32_t slices, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices )
+{
+    positions.clear();
+    indices.clear();
+
+    for ( uint32_t i = 0; i <= stacks; ++i )
+    {
+        float theta = glm::pi<float>() * i / stacks;
+        for ( uint32_t j = 0; j <= slices; ++j )
+        {
+            float phi = glm::two_pi<float>() * j / slices;
+            positions.push_back( glm::vec3( sinf( theta ) * cosf( phi ), cosf( theta ), sinf( theta ) * sinf( phi ) ) );
+        }
+    }
+
+    for ( uint32_t i = 0; i < stacks; ++i )
+    {
+        for ( uint32_t j = 0; j < slices; ++j )
+        {
+            uint32_t i0 = i * ( slices + 1 ) + j;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + slices + 1;
+            uint32_t i3 = i2 + 1;
+
+            // The triangles at the poles are degenerate.
+            uint32_t quad[] = { i0, i1, i3, i0, i3, i2 };
+            for ( int k = 0; k < 6; k += 3 )
+            {
+                glm::vec3 p0 = positions[quad[k]];
+                glm::vec3 normal = glm::cross( positions[quad[k + 1]] - p0, positions[quad[k + 2]] - p0 );
+                if ( glm::length( normal ) <= 1e-6f ) continue;
+                if ( glm::dot( normal, p0 + positions[quad[k + 1]] + positions[quad[k + 2]] ) < 0.0f )
+                {
+                    std::swap( quad[k + 1], quad[k + 2] );
+                }
+                indices.insert( indices.end(), quad + k, quad + k + 3 );
+            }
+        }
+    }
+}
+
+// Split the vertices of a grid along the column seamX (like a texture seam): the triangles
+// to the right of the seam use copies of the vertices on the seam (at the same positions).
+static void AddSeam( uint32_t seamX, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices )
+{
+    std::map<uint32_t, uint32_t> copies;
+    for ( size_t i = 0; i + 2 < indices.size(); i += 3 )
+    {
+        float minX = std::min( positions[indices[i]].x, std::min( positions[indices[i + 1]].x, positions[indices[i + 2]].x ) );
+        if ( minX < seamX ) continue;
+
+        for ( int k = 0; k < 3; ++k )
+        {
+            uint32_t& index = indices[i + k];
+            if ( positions[index].x != seamX ) continue;
+
+            if ( copies.find( index ) == copies.end() )
+            {
+                copies[index] = static_cast<uint32_t>( positions.size() );
+                positions.push_back( positions[index] );
+            }
+            index = copies[index];
+        }
+    }
+}
+
+// Shuffle the order of the triangles (with a fixed seed so the results are reproducible).
+static void ShuffleTriangles( std::vector<uint32_t>& indices, uint32_t seed = 42 )
+{
+    std::vector<Triangle> triangles;
+    for ( size_t i = 0; i + 2 < indices.size(); i += 3 )
+    {
+        Triangle triangle = { indices[i], indices[i + 1], indices[i + 2] };
+        triangles.push_back( triangle );
+    }
+
+    std::mt19937 random( seed );
+    std::shuffle( triangles.begin(), triangles.end(), random );
+
+    for ( size_t i = 0; i < triangles.size(); ++i )
+    {
+        std::copy( triangles[i].begin(), triangles[i].end(), indices.begin() + i * 3 );
+    }
+}
+
+TEST( MeshOptimizerAnalyzeVertexCacheBounds )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    CreateGrid( 32, positions, indices );
+    ShuffleTriangles( indices );
+
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+    const size_t numTriangles = indices.size() / 3;
+
+    for ( uint32_t cacheSize : { 3u, 16u, 32u } )
+    {
+        VertexCacheStatistics statistics = AnalyzeVertexCache( indices.data(), indices.size(), numVertices, cacheSize );
+
+        // Every vertex is transformed at least once and every index transforms at most one vertex.
+        CHECK( statistics.VerticesTransformed >= numVertices );
+        CHECK( statistics.VerticesTransformed <= indices.size() );
+        CHECK( statistics.ACMR >= (float)numVertices / numTriangles );
+        CHECK( statistics.ACMR <= 3.0f );
+        CHECK( statistics.ATVR >= 1.0f );
+        CHECK( statistics.ATVR <= (float)indices.size() / numVertices );
+    }
+
+    // A cache of 3 vertices only hits vertices of the previous triangle (the shuffled triangles rarely share them).
+    VertexCacheStatistics smallCache = AnalyzeVertexCache( indices.data(), indices.size(), numVertices, 3 );
+    VertexCacheStatistics largeCache = AnalyzeVertexCache( indices.data(), indices.size(), numVertices, 32 );
+    CHECK( smallCache.ACMR > 2.5f );
+    CHECK( largeCache.VerticesTransformed <= smallCache.VerticesTransformed );
+
+    // Without any shared vertices, every index is a cache miss.
+    std::vector<uint32_t> unshared( 30 );
+    std::iota( unshared.begin(), unshared.end(), 0 );
+    VertexCacheStatistics unsharedStatistics = AnalyzeVertexCache( unshared.data(), unshared.size(), 30 );
+    CHECK_EQUAL( 30u, unsharedStatistics.VerticesTransformed );
+    CHECK_EQUAL( 3.0f, unsharedStatistics.ACMR );
+    CHECK_EQUAL( 1.0f, unsharedStatistics.ATVR );
+}
+
+TEST( MeshOptimizerOptimizeVertexCachePreservesTriangles )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    CreateGrid( 32, positions, indices );
+    ShuffleTriangles( indices );
+
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+    std::vector<uint32_t> optimized = indices;
+    OptimizeVertexCache( optimized.data(), optimized.size(), numVertices );
+
+    // The same triangles (with the same winding) in a different order.
+    CHECK_EQUAL( indices.size(), optimized.size() );
+    CHECK( GetTriangles( indices ) == GetTriangles( optimized ) );
+
+    // A regular grid can be drawn with less than one transformed vertex per triangle.
+    VertexCacheStatistics before = AnalyzeVertexCache( indices.data(), indices.size(), numVertices );
+    VertexCacheStatistics after = AnalyzeVertexCache( optimized.data(), optimized.size(), numVertices );
+    CHECK( after.ACMR < before.ACMR );
+    CHECK( after.ACMR < 0.8f );
+    CHECK( after.ATVR < 1.6f );
+}
+
+TEST( MeshOptimizerOptimizeVertexFetchRemap )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    CreateGrid( 16, positions, indices );
+    ShuffleTriangles( indices );
+
+    // An extra vertex that is not referenced by any triangle.
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() ) + 1;
+
+    std::vector<uint32_t> rewritten = indices;
+    std::vector<uint32_t> remap;
+    OptimizeVertexFetch( rewritten.data(), rewritten.size(), numVertices, remap );
+
+    // The remap is a permutation of the vertices.
+    CHECK_EQUAL( (size_t)numVertices, remap.size() );
+    std::vector<uint32_t> sortedRemap = remap;
+    std::sort( sortedRemap.begin(), sortedRemap.end() );
+    for ( uint32_t i = 0; i < numVertices; ++i )
+    {
+        CHECK_EQUAL( i, sortedRemap[i] );
+    }
+
+    // The rewritten indices refer to the remapped vertices.
+    for ( size_t i = 0; i < indices.size(); ++i )
+    {
+        CHECK_EQUAL( remap[indices[i]], rewritten[i] );
+    }
+
+    // The vertices are numbered in the order they are first referenced and the unreferenced vertex is last.
+    uint32_t nextVertex = 0;
+    for ( uint32_t index : rewritten )
+    {
+        CHECK( index <= nextVertex );
+        if ( index == nextVertex ) ++nextVertex;
+    }
+    CHECK_EQUAL( numVertices - 1, nextVertex );
+    CHECK_EQUAL( numVertices - 1, remap[numVertices - 1] );
+}
+
+#define BENCHMARK_VERTEX_CACHE_SIZE 16
+
+// Print the ACMR and ATVR of grids of several sizes (in row order and shuffled) before and after
+// optimizing the vertex cache and the time it takes to optimize each mesh.
+BENCHMARK( MeshOptimizerVertexCacheBenchmark )
+{
+    std::cout << "Vertex cache optimization (" << BENCHMARK_VERTEX_CACHE_SIZE << " entry FIFO cache):" << std::endl;
+
+    for ( uint32_t size : { 16u, 64u, 256u } )
+    {
+        for ( int shuffled = 0; shuffled < 2; ++shuffled )
+        {
+            std::vector<glm::vec3> positions;
+            std::vector<uint32_t> indices;
+            CreateGrid( size, positions, indices );
+            if ( shuffled )
+            {
+                ShuffleTriangles( indices );
+            }
+
+            const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+            VertexCacheStatistics before = AnalyzeVertexCache( indices.data(), indices.size(), numVertices, BENCHMARK_VERTEX_CACHE_SIZE );
+
+            BenchmarkTimer timer;
+            OptimizeVertexCache( indices.data(), indices.size(), numVertices );
+            timer.Tick();
+
+            VertexCacheStatistics after = AnalyzeVertexCache( indices.data(), indices.size(), numVertices, BENCHMARK_VERTEX_CACHE_SIZE );
+            CHECK( after.ACMR <= before.ACMR );
+
+            std::cout << size << "x" << size << " grid" << ( shuffled ? " (shuffled)" : "" ) << ", " << indices.size() / 3 << " triangles: "
+                << "ACMR " << before.ACMR << " -> " << after.ACMR << ", "
+                << "ATVR " << before.ATVR << " -> " << after.ATVR << ", "
+                << timer.ElapsedMilliSeconds() << " ms" << std::endl;
+        }
+    }
+}
+
+TEST( MeshOptimizerSimplifyMeshReachesTargetIndexCount )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    CreateHeightField( 32, positions, indices );
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+
+    for ( size_t divisor : { 2, 4, 8 } )
+    {
+        size_t targetIndexCount = indices.size() / divisor / 3 * 3;
+        std::vector<uint32_t> simplified;
+        float error = SimplifyMesh( indices.data(), indices.size(), positions.data(), numVertices, targetIndexCount, simplified );
+
+        CHECK( simplified.size() <= targetIndexCount );
+        CHECK( simplified.size() > 0 );
+        CHECK_EQUAL( 0u, simplified.size() % 3 );
+        CHECK( error >= 0.0f );
+
+        // The simplified mesh uses the vertices of the original mesh.
+        for ( uint32_t index : simplified )
+        {
+            CHECK( index < numVertices );
+        }
+    }
+
+    // A mesh that is already below the target index count is not changed.
+    std::vector<uint32_t> unchanged;
+    CHECK_EQUAL( 0.0f, SimplifyMesh( indices.data(), indices.size(), positions.data(), numVertices, indices.size(), unchanged ) );
+    CHECK( unchanged == indices );
+}
+
+TEST( MeshOptimizerSimplifyMeshDoesNotFlipTriangles )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    CreateHeightField( 32, positions, indices );
+    ShuffleTriangles( indices );
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+
+    std::vector<uint32_t> simplified;
+    SimplifyMesh( indices.data(), indices.size(), positions.data(), numVertices, indices.size() / 8 / 3 * 3, simplified );
+
+    // Every triangle of a height field faces the +z axis, so the triangles of the simplified
+    // height field must not be clockwise when they are projected onto the xy plane.
+    // (A triangle whose vertices are on the same row or column of the grid projects onto a line.)
+    for ( size_t i = 0; i + 2 < simplified.size(); i += 3 )
+    {
+        glm::vec3 p0 = positions[simplified[i]];
+        glm::vec3 normal = glm::cross( positions[simplified[i + 1]] - p0, positions[simplified[i + 2]] - p0 );
+        CHECK( normal.z >= 0.0f );
+    }
+}
+
+TEST( MeshOptimizerSimplifyMeshKeepsBorderAndSeamVertices )
+{
+    const uint32_t size = 32;
+    const uint32_t seamX = size / 2;
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    CreateHeightField( size, positions, indices );
+    AddSeam( seamX, positions, indices );
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+    CHECK_EQUAL( ( size + 1 ) * ( size + 2 ), numVertices );
+
+    std::vector<uint32_t> simplified;
+    SimplifyMesh( indices.data(), indices.size(), positions.data(), numVertices, indices.size() / 8 / 3 * 3, simplified );
+
+    // The vertices can't move, so a vertex that is fixed must still be used by the simplified mesh.
+    std::vector<bool> used( numVertices, false );
+    for ( uint32_t index : simplified )
+    {
+        used[index] = true;
+    }
+
+    uint32_t numFixedVertices = 0;
+    for ( uint32_t v = 0; v < numVertices; ++v )
+    {
+        const glm::vec3& position = positions[v];
+        bool border = position.x == 0 || position.y == 0 || position.x == size || position.y == size;
+        bool seam = position.x == seamX;
+        if ( border || seam )
+        {
+            CHECK( used[v] );
+            ++numFixedVertices;
+        }
+    }
+    // The vertices on the border, the vertices on the seam inside the grid and the copies of the seam vertices.
+    CHECK_EQUAL( 4 * size + ( size - 1 ) + ( size + 1 ), numFixedVertices );
+
+    // The interior vertices are collapsed.
+    CHECK( std::count( used.begin(), used.end(), true ) < (ptrdiff_t)numVertices / 2 );
+}
+
+TEST( MeshOptimizerSimplifyMeshErrorIsMonotonic )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    CreateHeightField( 32, positions, indices );
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+
+    // Each level of detail has fewer triangles and at least the error of the previous level.
+    size_t previousIndexCount = indices.size();
+    float previousError = 0.0f;
+    for ( size_t targetIndexCount = indices.size() / 2 / 3 * 3; targetIndexCount >= 300; targetIndexCount = targetIndexCount / 2 / 3 * 3 )
+    {
+        std::vector<uint32_t> simplified;
+        float error = SimplifyMesh( indices.data(), indices.size(), positions.data(), numVertices, targetIndexCount, simplified );
+
+        CHECK( simplified.size() < previousIndexCount );
+        CHECK( error >= previousError );
+
+        previousIndexCount = simplified.size();
+        previousError = error;
+    }
+    CHECK( previousError > 0.0f );
+}
+
+#define BENCHMARK_SIMPLIFY_GRID_SIZE 256
+
+// Measure the time it takes to simplify a height field to levels of detail with 1/2, 1/4 ... 1/64 of its triangles.
+BENCHMARK( MeshOptimizerSimplifyBenchmark )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    CreateHeightField( BENCHMARK_SIMPLIFY_GRID_SIZE, positions, indices );
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+
+    std::cout << "Mesh simplification (" << indices.size() / 3 << " triangles):" << std::endl;
+
+    for ( size_t divisor = 2; divisor <= 64; divisor *= 2 )
+    {
+        size_t targetIndexCount = indices.size() / divisor / 3 * 3;
+        std::vector<uint32_t> simplified;
+
+        BenchmarkTimer timer;
+        float error = SimplifyMesh( indices.data(), indices.size(), positions.data(), numVertices, targetIndexCount, simplified );
+        timer.Tick();
+
+        CHECK( simplified.size() <= targetIndexCount );
+
+        std::cout << "1/" << divisor << ": " << simplified.size() / 3 << " triangles, error " << error << ", "
+            << timer.ElapsedMilliSeconds() << " ms" << std::endl;
+    }
+}
+
+// The limits of the meshlets that are used by the cluster culler.
+#define TEST_MESHLET_VERTICES 64
+#define TEST_MESHLET_TRIANGLES 124
+
+// Build the meshlets of a sphere (optimized for the vertex cache first).
+static void CreateSphereMeshlets( std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices, std::vector<MeshletInfo>& meshlets )
+{
+    CreateSphere( 32, 64, positions, indices );
+    const uint32_t numVertices = static_cast<uint32_t>( positions.size() );
+
+    OptimizeVertexCache( indices.data(), indices.size(), numVertices );
+    BuildMeshlets( indices.data(), indices.size(), positions.data(), numVertices, TEST_MESHLET_VERTICES, TEST_MESHLET_TRIANGLES, meshlets );
+}
+
+TEST( MeshOptimizerBuildMeshletsRespectsLimits )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    std::vector<MeshletInfo> meshlets;
+    CreateSphereMeshlets( positions, indices, meshlets );
+    CHECK( meshlets.size() > 1 );
+
+    // The meshlets cover the index buffer in order, every index exactly once.
+    uint32_t nextIndex = 0;
+    for ( const MeshletInfo& meshlet : meshlets )
+    {
+        CHECK_EQUAL( nextIndex, meshlet.FirstIndex );
+        CHECK( meshlet.NumIndices > 0 );
+        CHECK_EQUAL( 0u, meshlet.NumIndices % 3 );
+        CHECK( meshlet.NumIndices / 3 <= TEST_MESHLET_TRIANGLES );
+        nextIndex += meshlet.NumIndices;
+
+        std::vector<uint32_t> vertices( indices.begin() + meshlet.FirstIndex, indices.begin() + meshlet.FirstIndex + meshlet.NumIndices );
+        std::sort( vertices.begin(), vertices.end() );
+        uint32_t numUniqueVertices = static_cast<uint32_t>( std::unique( vertices.begin(), vertices.end() ) - vertices.begin() );
+        CHECK_EQUAL( numUniqueVertices, meshlet.NumVertices );
+        CHECK( meshlet.NumVertices <= TEST_MESHLET_VERTICES );
+    }
+    CHECK_EQUAL( indices.size(), (size_t)nextIndex );
+}
+
+TEST( MeshOptimizerBuildMeshletsBounds )
+{
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    std::vector<MeshletInfo> meshlets;
+    CreateSphereMeshlets( positions, indices, meshlets );
+
+    // The bounding sphere of each meshlet contains the vertices of its triangles.
+    for ( const MeshletInfo& meshlet : meshlets )
+    {
+        for ( uint32_t i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.NumIndices; ++i )
+        {
+            CHECK( glm::distance( meshlet.Center, positions[indices[i]] ) <= meshlet.Radius * 1.0001f );
+        }
+    }
+
+    // The cone test may only reject a meshlet from a view position if all of its triangles are back facing.
+    // The view positions surround the sphere so that every meshlet is rejected from some of them.
+    std::mt19937 random( 42 );
+    std::uniform_real_distribution<float> distribution( -1.0f, 1.0f );
+    uint32_t numRejected = 0;
+    uint32_t numTests = 0;
+    for ( int view = 0; view < 64; ++view )
+    {
+        glm::vec3 direction( distribution( random ), distribution( random ), distribution( random ) );
+        glm::vec3 viewPosition = glm::normalize( direction ) * ( 1.5f + view * 0.25f );
+
+        for ( const MeshletInfo& meshlet : meshlets )
+        {
+            glm::vec3 toCenter = meshlet.Center - viewPosition;
+            bool backFacing = glm::dot( toCenter, meshlet.ConeAxis ) >= meshlet.ConeCutoff * glm::length( toCenter ) + meshlet.Radius;
+            ++numTests;
+            if ( !backFacing ) continue;
+
+            ++numRejected;
+            for ( uint32_t i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.NumIndices; i += 3 )
+            {
+                const glm::vec3& p0 = positions[indices[i]];
+                glm::vec3 normal = glm::cross( positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0 );
+                CHECK( glm::dot( p0 - viewPosition, normal ) >= 0.0f );
+            }
+        }
+    }
+
+    // About half of the sphere faces away from each view position. The cone test is conservative
+    // (it also accounts for the bounding sphere), but it must still reject some of the back facing meshlets.
+    CHECK( numRejected > numTests / 10 );
+}
@@ -0,0 +1,213 @@
+#include <EngineTestPCH.h>
+
+#include <Light.h>
+#include <Ray.h>
+#include <RaycastHit.h>
+
+#include <EngineTest.h>
+
+// Intersect the ray with every light volume (without rejecting lights early).
+// This is how the lights were picked before Ray::IntersectLights.
+static bool IntersectLightsReference( const Ray& ray, const std::vector<Light>& lights, RaycastHit& hit )
+{
+    bool lightHit = false;
+    RaycastHit lightVolumeHit;
+
+    hit.Distance = std::numeric_limits<float>::max();
+
+    for ( uint32_t i = 0; i < (uint32_t)lights.size(); ++i )
+    {
+        const Light& light = lights[i];
+        glm::vec3 positionWS = glm::vec3( light.m_PositionWS );
+        glm::vec3 directionWS = glm::normalize( glm::vec3( light.m_DirectionWS ) );
+
+        bool volumeHit = false;
+        switch ( light.m_Type )
+        {
+        case Light::LightType::Point:
+            volumeHit = ray.IntersectSphere( positionWS, light.m_Range, lightVolumeHit );
+            break;
+        case Light::LightType::Spot:
+            volumeHit = ray.IntersectCone( positionWS, directionWS, light.m_Range, light.m_SpotlightAngle, lightVolumeHit );
+            break;
+        case Light::LightType::Directional:
+            volumeHit = ray.IntersectSphere( positionWS + directionWS * 0.5f, 0.5f, lightVolumeHit );
+            break;
+        }
+
+        if ( volumeHit && lightVolumeHit.Distance < hit.Distance )
+        {
+            hit = lightVolumeHit;
+            hit.Index = i;
+            lightHit = true;
+        }
+    }
+
+    return lightHit;
+}
+
+static Light MakeLight( Light::LightType type, const glm::vec3& position, const glm::vec3& direction, float range, float angle )
+{
+    Light light;
+    light.m_Type = type;
+    light.m_PositionWS = glm::vec4( position, 1 );
+    light.m_DirectionWS = glm::vec4( direction, 0 );
+    light.m_Range = range;
+    light.m_SpotlightAngle = angle;
+    return light;
+}
+
+// Random lights in a cube with the size of a large scene.
+static std::vector<Light> MakeRandomLights( uint32_t numLights, float sceneSize, std::mt19937& random )
+{
+    std::uniform_real_distribution<float> position( -sceneSize, sceneSize );
+    std::uniform_real_distribution<float> direction( -1.0f, 1.0f );
+    std::uniform_real_distribution<float> range( 0.5f, 5.0f );
+    std::uniform_real_distribution<float> angle( 5.0f, 75.0f );
+    std::uniform_int_distribution<uint32_t> type( 0, 2 );
+
+    std::vector<Light> lights;
+    for ( uint32_t i = 0; i < numLights; ++i )
+    {
+        glm::vec3 d( direction( random ), direction( random ), direction( random ) );
+        if ( glm::length2( d ) < 1e-4f ) d = glm::vec3( 0, 0, -1 );
+        lights.push_back( MakeLight( (Light::LightType)type( random ), glm::vec3( position( random ), position( random ), position( random ) ), d, range( random ), angle( random ) ) );
+    }
+    return lights;
+}
+
+static std::vector<glm::vec4> GetBoundingSpheres( const std::vector<Light>& lights )
+{
+    std::vector<glm::vec4> boundingSpheres;
+    for ( const Light& light : lights )
+    {
+        boundingSpheres.push_back( light.GetBoundingSphere() );
+    }
+    return boundingSpheres;
+}
+
+static Ray MakeRandomRay( float sceneSize, std::mt19937& random )
+{
+    std::uniform_real_distribution<float> position( -sceneSize, sceneSize );
+    std::uniform_real_distribution<float> direction( -1.0f, 1.0f );
+    glm::vec3 d( direction( random ), direction( random ), direction( random ) );
+    if ( glm::length2( d ) < 1e-4f ) d = glm::vec3( 0, 0, -1 );
+    return Ray( glm::vec3( position( random ), position( random ), position( random ) ), glm::normalize( d ) );
+}
+
+TEST( RayIntersectLightsFindsClosestLight )
+{
+    Ray ray( glm::vec3( 0, 0, 0 ), glm::vec3( 0, 0, -1 ) );
+
+    std::vector<Light> lights;
+    // A point light behind the camera, a point light that is missed and a point light at a distance of 9.
+    lights.push_back( MakeLight( Light::LightType::Point, glm::vec3( 0, 0, 5 ), glm::vec3( 0, 0, -1 ), 1.0f, 45.0f ) );
+    lights.push_back( MakeLight( Light::LightType::Point, glm::vec3( 3, 0, -5 ), glm::vec3( 0, 0, -1 ), 1.0f, 45.0f ) );
+    lights.push_back( MakeLight( Light::LightType::Point, glm::vec3( 0, 0, -10 ), glm::vec3( 0, 0, -1 ), 1.0f, 45.0f ) );
+
+    RaycastHit hit;
+    CHECK( ray.IntersectLights( lights.data(), GetBoundingSpheres( lights ).data(), (uint32_t)lights.size(), hit ) );
+    CHECK_EQUAL( 2u, hit.Index );
+    CHECK( glm::abs( hit.Distance - 9.0f ) < 1e-4f );
+
+    // A spot light that points at the camera. The ray hits the base of the cone at a distance of 6.
+    lights.push_back( MakeLight( Light::LightType::Spot, glm::vec3( 0, 0, -8 ), glm::vec3( 0, 0, 1 ), 2.0f, 30.0f ) );
+    CHECK( ray.IntersectLights( lights.data(), GetBoundingSpheres( lights ).data(), (uint32_t)lights.size(), hit ) );
+    CHECK_EQUAL( 3u, hit.Index );
+    CHECK( glm::abs( hit.Distance - 6.0f ) < 1e-4f );
+
+    // A directional light is picked with the bounding sphere of its arrow (at a distance of 3).
+    lights.push_back( MakeLight( Light::LightType::Directional, glm::vec3( 0, 0, -3 ), glm::vec3( 0, 0, -2 ), 100.0f, 45.0f ) );
+    CHECK( ray.IntersectLights( lights.data(), GetBoundingSpheres( lights ).data(), (uint32_t)lights.size(), hit ) );
+    CHECK_EQUAL( 4u, hit.Index );
+    CHECK( glm::abs( hit.Distance - 3.0f ) < 1e-4f );
+
+    // A wide spot light next to the ray is found although the ray misses the sphere with the range of the light.
+    lights.push_back( MakeLight( Light::LightType::Spot, glm::vec3( -2.5f, 0, -1.5f ), glm::vec3( 1, 0, 1.732f ), 2.0f, 60.0f ) );
+    CHECK( ray.IntersectLights( lights.data(), GetBoundingSpheres( lights ).data(), (uint32_t)lights.size(), hit ) );
+    CHECK_EQUAL( 5u, hit.Index );
+
+    CHECK( !Ray( glm::vec3( 0, 0, 0 ), glm::vec3( 0, 1, 0 ) ).IntersectLights( lights.data(), GetBoundingSpheres( lights ).data(), (uint32_t)lights.size(), hit ) );
+    CHECK( !ray.IntersectLights( nullptr, nullptr, 0, hit ) );
+}
+
+TEST( RayIntersectLightsMatchesReference )
+{
+    std::mt19937 random( 0 );
+    // Dense lights, so most rays start inside of (or hit) several light volumes.
+    std::vector<Light> lights = MakeRandomLights( 2000, 20.0f, random );
+    std::vector<glm::vec4> boundingSpheres = GetBoundingSpheres( lights );
+
+    uint32_t numHits = 0;
+    uint32_t numMismatches = 0;
+    for ( uint32_t i = 0; i < 2000; ++i )
+    {
+        Ray ray = MakeRandomRay( 25.0f, random );
+
+        RaycastHit hit;
+        RaycastHit referenceHit;
+        bool lightHit = ray.IntersectLights( lights.data(), boundingSpheres.data(), (uint32_t)lights.size(), hit );
+        bool referenceLightHit = IntersectLightsReference( ray, lights, referenceHit );
+        if ( lightHit != referenceLightHit || ( lightHit && ( hit.Index != referenceHit.Index || hit.Distance != referenceHit.Distance ) ) )
+        {
+            ++numMismatches;
+        }
+        if ( lightHit ) ++numHits;
+    }
+
+    CHECK_EQUAL( 0u, numMismatches );
+    // The test must exercise both outcomes.
+    CHECK( numHits > 200 );
+    CHECK( numHits < 1800 );
+}
+
+#define BENCHMARK_NUM_LIGHTS 100000
+#define BENCHMARK_NUM_PICKS 100
+#define BENCHMARK_MAX_PICK_MILLISECONDS 1.0
+
+// Measure the CPU time to pick a light (with a ray through the mouse cursor) from BENCHMARK_NUM_LIGHTS lights.
+// Picking happens on the main thread when the mouse button is released, so it must not take longer than a millisecond.
+// The bounding spheres of the lights are built by the first pick after the lights have changed.
+BENCHMARK( LightPickingBenchmark )
+{
+    std::mt19937 random( 0 );
+    std::vector<Light> lights = MakeRandomLights( BENCHMARK_NUM_LIGHTS, 500.0f, random );
+    std::vector<Ray> rays;
+    for ( uint32_t i = 0; i < BENCHMARK_NUM_PICKS; ++i )
+    {
+        rays.push_back( MakeRandomRay( 500.0f, random ) );
+    }
+
+    BenchmarkTimer boundingSpheresTimer;
+    std::vector<glm::vec4> boundingSpheres( lights.size() );
+    for ( size_t i = 0; i < lights.size(); ++i )
+    {
+        boundingSpheres[i] = lights[i].GetBoundingSphere();
+    }
+    boundingSpheresTimer.Tick();
+
+    uint32_t numHits = 0;
+    BenchmarkTimer timer;
+    for ( const Ray& ray : rays )
+    {
+        RaycastHit hit;
+        if ( ray.IntersectLights( lights.data(), boundingSpheres.data(), (uint32_t)lights.size(), hit ) ) ++numHits;
+    }
+    timer.Tick();
+    double pickMilliSeconds = timer.ElapsedMilliSeconds() / BENCHMARK_NUM_PICKS;
+
+    BenchmarkTimer referenceTimer;
+    for ( const Ray& ray : rays )
+    {
+        RaycastHit hit;
+        IntersectLightsReference( ray, lights, hit );
+    }
+    referenceTimer.Tick();
+
+    std::cout << "Light picking benchmark (" << BENCHMARK_NUM_LIGHTS << " lights): "
+        << pickMilliSeconds << " ms per pick (" << referenceTimer.ElapsedMilliSeconds() / BENCHMARK_NUM_PICKS
+        << " ms without the bounding sphere test, " << boundingSpheresTimer.ElapsedMilliSeconds()
+        << " ms to build the bounding spheres), " << numHits << " of " << BENCHMARK_NUM_PICKS << " picks hit a light" << std::endl;
+    CHECK( numHits > 0 );
+    CHECK( pickMilliSeconds < BENCHMARK_MAX_PICK_MILLISECONDS );
+}
@@ -0,0 +1,117 @@
+#include <EngineTestPCH.h>
+
+// The render graph and the copy passes of the GraphicsTest project are rendered with
+// the null render device (see RenderTechniqueTest.cpp).
+#include <GraphicsTestPCH.h>
+
+#include <StructuredBuffer.h>
+#include <Texture.h>
+
+#include <RenderGraph.h>
+#include <TransientTexturePool.h>
+#include <CopyBufferPass.h>
+#include <CopyTexturePass.h>
+
+#include <EngineTest.h>
+#include <TestScene.h>
+
+#define TEST_TEXTURE_SIZE 64
+#define TEST_BUFFER_ELEMENTS 1024
+
+static std::shared_ptr<StructuredBuffer> CreateTestBuffer( RenderDevice& renderDevice )
+{
+    std::vector<float> data( TEST_BUFFER_ELEMENTS, 0.0f );
+    return renderDevice.CreateStructuredBuffer( data, CPUAccess::Write );
+}
+
+// Render a frame of the render graph and end the frame,
+// so the counters include the uploads that were flushed at the end of the frame.
+static RenderCountersNull RenderGraphFrame( RenderDeviceNull& renderDevice, RenderGraph& renderGraph, std::shared_ptr<StructuredBuffer> uploadBuffer )
+{
+    RenderCountersNull counters = RenderTestFrame( renderDevice, renderGraph );
+    if ( uploadBuffer )
+    {
+        std::vector<float> data( TEST_BUFFER_ELEMENTS, 1.0f );
+        uploadBuffer->Set( data );
+    }
+
+    // RenderTestFrame resets the counters before the frame is rendered.
+    renderDevice.EndFrame();
+    return renderDevice.GetCounters();
+}
+
+TEST( RenderGraphCopyPassesDeclareResources )
+{
+    RenderDeviceNull renderDevice;
+    TransientTexturePool transientTexturePool( renderDevice, TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE );
+
+    std::shared_ptr<StructuredBuffer> sourceBuffer = CreateTestBuffer( renderDevice );
+    std::shared_ptr<StructuredBuffer> destinationBuffer = CreateTestBuffer( renderDevice );
+    std::shared_ptr<Texture> sourceTexture = renderDevice.CreateTexture2D( TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE );
+    std::shared_ptr<Texture> destinationTexture = renderDevice.CreateTexture2D( TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE );
+
+    // The source texture is copied to the destination through a transient texture.
+    // The copy to the unused transient texture is culled.
+    RenderGraph renderGraph;
+    RenderGraph::ResourceHandle scratch = renderGraph.CreateTexture( "Scratch", Texture::TextureFormat() );
+    RenderGraph::ResourceHandle unused = renderGraph.CreateTexture( "Unused", Texture::TextureFormat() );
+
+    renderGraph.AddPass( "CopyBuffer", std::make_shared<CopyBufferPass>( destinationBuffer, sourceBuffer ) );
+    renderGraph.AddPass( "CopyToScratch", [&]()
+    {
+        return std::make_shared<CopyTexturePass>( renderGraph.GetTexture( scratch ), sourceTexture );
+    } ).Write( scratch );
+    renderGraph.AddPass( "CopyToUnused", [&]()
+    {
+        return std::make_shared<CopyTexturePass>( renderGraph.GetTexture( unused ), sourceTexture );
+    } ).Write( unused );
+    renderGraph.AddPass( "CopyFromScratch", [&]()
+    {
+        return std::make_shared<CopyTexturePass>( destinationTexture, renderGraph.GetTexture( scratch ) );
+    } ).Read( scratch );
+
+    renderGraph.Compile( transientTexturePool );
+    renderGraph.CreatePasses();
+    CHECK( renderGraph.GetTexture( scratch ) != nullptr );
+    CHECK( renderGraph.GetTexture( unused ) == nullptr );
+
+    RenderCountersNull counters = RenderGraphFrame( renderDevice, renderGraph, nullptr );
+    CHECK_EQUAL( 3u, counters.Copies );
+    // Every resource is transitioned from the common state to the state of its copy
+    // and the scratch texture is transitioned from the destination to the source of a copy.
+    CHECK_EQUAL( 6u, counters.ResourceTransitions );
+    CHECK_EQUAL( 3u, counters.TransitionBatches );
+
+    // In the next frame, only the scratch texture changes its state (twice).
+    counters = RenderGraphFrame( renderDevice, renderGraph, nullptr );
+    CHECK_EQUAL( 3u, counters.Copies );
+    CHECK_EQUAL( 2u, counters.ResourceTransitions );
+    CHECK_EQUAL( 2u, counters.TransitionBatches );
+    CHECK( renderDevice.GetResourceStateTracker()->GetState( renderGraph.GetTexture( scratch ).get() ) == ResourceState::CopySource );
+    CHECK( renderDevice.GetResourceStateTracker()->GetState( destinationBuffer.get() ) == ResourceState::CopyDest );
+}
+
+TEST( RenderGraphCopyPassesUseStagingRing )
+{
+    RenderDeviceNull renderDevice;
+    TransientTexturePool transientTexturePool( renderDevice, TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE );
+
+    std::shared_ptr<StructuredBuffer> sourceBuffer = CreateTestBuffer( renderDevice );
+    std::shared_ptr<StructuredBuffer> destinationBuffer = CreateTestBuffer( renderDevice );
+
+    RenderGraph renderGraph;
+    renderGraph.AddPass( "CopyBuffer", std::make_shared<CopyBufferPass>( destinationBuffer, sourceBuffer ) );
+    renderGraph.Compile( transientTexturePool );
+    renderGraph.CreatePasses();
+
+    // The source buffer is updated every frame. Its data is staged
+    // in the upload queue and copied once at the end of the frame.
+    for ( int frame = 0; frame < 10; ++frame )
+    {
+        RenderCountersNull counters = RenderGraphFrame( renderDevice, renderGraph, sourceBuffer );
+        CHECK_EQUAL( 1u, counters.Copies );
+        CHECK_EQUAL( 1u, counters.StagingCopies );
+        CHECK_EQUAL( 0u, counters.StagingStalls );
+        CHECK_EQUAL( TEST_BUFFER_ELEMENTS * sizeof( float ), counters.BytesUploaded );
+    }
+}
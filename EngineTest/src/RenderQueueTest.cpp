@@ -0,0 +1,169 @@
+#include <EngineTestPCH.h>
+
+// The opaque pass of the GraphicsTest project with and without a render queue
+// is rendered with the null render device (see RenderTechniqueTest.cpp).
+#include <GraphicsTestPCH.h>
+
+#include <RenderQueue.h>
+#include <StateCacheStatistics.h>
+
+#include <RenderTechnique.h>
+#include <OpaquePass.h>
+
+#include <EngineTest.h>
+#include <TestScene.h>
+
+// A scene with numNodes nodes that alternate between numMeshes meshes
+// which share numMaterials materials (like the meshes of an imported scene).
+static std::shared_ptr<TestScene> CreateRenderQueueScene( RenderDevice& renderDevice, uint32_t numNodes, uint32_t numMeshes, uint32_t numMaterials )
+{
+    std::vector< std::shared_ptr<Material> > materials;
+    for ( uint32_t i = 0; i < numMaterials; ++i )
+    {
+        materials.push_back( renderDevice.CreateMaterial() );
+    }
+
+    std::vector< std::shared_ptr<Mesh> > meshes;
+    for ( uint32_t i = 0; i < numMeshes; ++i )
+    {
+        meshes.push_back( CreateTestBox( renderDevice, materials[i % numMaterials] ) );
+    }
+
+    std::shared_ptr<TestScene> scene = std::make_shared<TestScene>();
+    for ( uint32_t i = 0; i < numNodes; ++i )
+    {
+        scene->AddMesh( meshes[i % numMeshes], glm::vec3( ( i % 100 ) * 2.0f, ( i / 100 % 100 ) * 2.0f, ( i / 10000 ) * -2.0f ) );
+    }
+
+    return scene;
+}
+
+// Without a render queue, the pass draws each mesh as soon as it is visited.
+static std::shared_ptr<OpaquePass> CreateBaselinePass( RenderDevice& renderDevice, std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline )
+{
+    std::shared_ptr<OpaquePass> pass = std::make_shared<OpaquePass>( renderDevice, scene, pipeline );
+    pass->SetRenderQueue( nullptr );
+
+    return pass;
+}
+
+TEST( RenderQueueReducesDrawCallsAndStateChanges )
+{
+    RenderDeviceNull renderDevice;
+    std::shared_ptr<TestScene> scene = CreateRenderQueueScene( renderDevice, 100, 10, 5 );
+    std::shared_ptr<PipelineState> pipeline = CreateTestPipeline( renderDevice );
+
+    // The baseline binds the buffers and the material for every draw call.
+    std::shared_ptr<OpaquePass> baselinePass = CreateBaselinePass( renderDevice, scene, pipeline );
+    RenderTechnique baselineTechnique;
+    baselineTechnique.AddPass( baselinePass );
+
+    RenderCountersNull baselineCounters = RenderTestFrame( renderDevice, baselineTechnique );
+    CHECK_EQUAL( 100u, baselineCounters.DrawCalls );
+    CHECK_EQUAL( 100u, baselinePass->GetNumDrawCalls() );
+    CHECK_EQUAL( 200u, baselinePass->GetNumStateChanges() );
+
+    // The render queue draws each mesh once (instanced) and binds the buffers of each mesh
+    // and each of the materials once (the meshes are sorted by material).
+    std::shared_ptr<OpaquePass> pass = std::make_shared<OpaquePass>( renderDevice, scene, pipeline );
+    RenderTechnique technique;
+    technique.AddPass( pass );
+
+    RenderCountersNull counters = RenderTestFrame( renderDevice, technique );
+    CHECK_EQUAL( 10u, counters.DrawCalls );
+    CHECK_EQUAL( 10u, pass->GetNumDrawCalls() );
+    CHECK_EQUAL( 15u, pass->GetNumStateChanges() );
+    CHECK_EQUAL( baselineCounters.Triangles, counters.Triangles );
+}
+
+TEST( RenderQueueStateCacheStatisticsArePerFrame )
+{
+    RenderDeviceNull renderDevice;
+    std::shared_ptr<TestScene> scene = CreateRenderQueueScene( renderDevice, 100, 10, 5 );
+    std::shared_ptr<PipelineState> pipeline = CreateTestPipeline( renderDevice );
+
+    RenderTechnique baselineTechnique;
+    baselineTechnique.AddPass( CreateBaselinePass( renderDevice, scene, pipeline ) );
+    RenderTechnique technique;
+    technique.AddPass( std::make_shared<OpaquePass>( renderDevice, scene, pipeline ) );
+
+    // No frame has ended yet.
+    const StateCacheStatistics* pStatistics = renderDevice.GetStateCacheStatistics();
+    CHECK( pStatistics != nullptr );
+    CHECK_EQUAL( 0u, pStatistics->GetNumIssued() );
+    CHECK_EQUAL( 0u, pStatistics->GetNumSkipped() );
+
+    RenderTestFrame( renderDevice, baselineTechnique );
+    renderDevice.EndFrame();
+    const uint64_t baselineIssued = pStatistics->GetNumIssued();
+    const uint64_t baselineSkipped = pStatistics->GetNumSkipped();
+    CHECK_EQUAL( 1u, pStatistics->Frames );
+    // The baseline binds the buffers of every mesh it draws (the nodes alternate between the meshes).
+    CHECK( baselineIssued >= 200u );
+
+    // The counters are reset every frame, so the same frame counts the same state changes again.
+    RenderTestFrame( renderDevice, baselineTechnique );
+    renderDevice.EndFrame();
+    CHECK_EQUAL( baselineIssued, pStatistics->GetNumIssued() );
+    CHECK_EQUAL( baselineSkipped, pStatistics->GetNumSkipped() );
+
+    // The render queue issues fewer state changes than the baseline.
+    RenderTestFrame( renderDevice, technique );
+    renderDevice.EndFrame();
+    CHECK( pStatistics->GetNumIssued() < baselineIssued );
+}
+
+#define BENCHMARK_NUM_QUEUE_NODES 10000
+#define BENCHMARK_NUM_QUEUE_MESHES 400
+#define BENCHMARK_NUM_QUEUE_MATERIALS 25
+#define BENCHMARK_NUM_QUEUE_FRAMES 10
+
+// Compare the CPU time, the draw calls and the state changes of the opaque pass without a render queue
+// (the baseline), with an unsorted render queue (scene graph order) and with a sorted render queue.
+// The scene is synthetic: the scene files in Assets are Git LFS pointers and the headless build can't import them.
+BENCHMARK( RenderQueueBenchmark )
+{
+    RenderDeviceNull renderDevice;
+    std::shared_ptr<TestScene> scene = CreateRenderQueueScene( renderDevice, BENCHMARK_NUM_QUEUE_NODES, BENCHMARK_NUM_QUEUE_MESHES, BENCHMARK_NUM_QUEUE_MATERIALS );
+    std::shared_ptr<PipelineState> pipeline = CreateTestPipeline( renderDevice );
+
+    std::shared_ptr<OpaquePass> baselinePass = CreateBaselinePass( renderDevice, scene, pipeline );
+    std::shared_ptr<OpaquePass> pass = std::make_shared<OpaquePass>( renderDevice, scene, pipeline );
+
+    const char* names[] = { "No render queue: ", "Scene graph order: ", "Sorted: " };
+    std::shared_ptr<OpaquePass> passes[] = { baselinePass, pass, pass };
+
+    std::cout << "Render queue benchmark (" << BENCHMARK_NUM_QUEUE_NODES << " nodes, " << BENCHMARK_NUM_QUEUE_MESHES << " meshes, "
+        << BENCHMARK_NUM_QUEUE_MATERIALS << " materials):" << std::endl;
+
+    for ( size_t i = 0; i < _countof( passes ); ++i )
+    {
+        // Without sorting, the queued meshes are drawn in the order of the scene graph.
+        if ( passes[i]->GetRenderQueue() )
+        {
+            passes[i]->GetRenderQueue()->SetSortingEnabled( i == 2 );
+        }
+
+        RenderTechnique technique;
+        technique.AddPass( passes[i] );
+
+        // The first frame allocates the render queue and the instance buffers.
+        RenderTestFrame( renderDevice, technique );
+
+        RenderCountersNull counters;
+        passes[i]->ResetRenderStatistics();
+
+        BenchmarkTimer timer;
+        for ( uint32_t frame = 0; frame < BENCHMARK_NUM_QUEUE_FRAMES; ++frame )
+        {
+            counters = RenderTestFrame( renderDevice, technique );
+        }
+        timer.Tick();
+
+        CHECK_EQUAL( (uint64_t)BENCHMARK_NUM_QUEUE_NODES * TEST_BOX_TRIANGLES, counters.Triangles );
+
+        std::cout << names[i] << timer.ElapsedMilliSeconds() / BENCHMARK_NUM_QUEUE_FRAMES << " ms per frame, "
+            << counters.DrawCalls << " draw calls, "
+            << passes[i]->GetNumStateChanges() / BENCHMARK_NUM_QUEUE_FRAMES << " state changes per frame" << std::endl;
+    }
+}
@@ -0,0 +1,114 @@
+#include <EngineTestPCH.h>
+
+// The render passes of the GraphicsTest project are rendered with the null render device,
+// which counts the calls the passes make instead of submitting them to a GPU.
+// The null device and the passes are compiled into the tests by CMakeLists.txt
+// (on Windows, the passes are part of the GraphicsTest application).
+#include <GraphicsTestPCH.h>
+
+#include <Light.h>
+
+#include <RenderTechnique.h>
+#include <BasePass.h>
+#include <OpaquePass.h>
+#include <LightsPass.h>
+
+#include <EngineTest.h>
+#include <TestScene.h>
+
+TEST( RenderTechniqueBasePassDrawsEveryMesh )
+{
+    RenderDeviceNull renderDevice;
+
+    std::shared_ptr<Mesh> box = CreateTestBox( renderDevice, renderDevice.CreateMaterial() );
+    std::shared_ptr<TestScene> scene = std::make_shared<TestScene>();
+    for ( int i = 0; i < 10; ++i )
+    {
+        scene->AddMesh( box, glm::vec3( i * 2.0f, 0, 0 ) );
+    }
+
+    // A base pass doesn't have a render queue so every mesh is drawn as soon as it is visited.
+    std::shared_ptr<BasePass> pass = std::make_shared<BasePass>( renderDevice, scene, CreateTestPipeline( renderDevice ) );
+    RenderTechnique technique;
+    technique.AddPass( pass );
+
+    RenderCountersNull counters = RenderTestFrame( renderDevice, technique );
+
+    CHECK_EQUAL( 10u, counters.DrawCalls );
+    CHECK_EQUAL( 10u * TEST_BOX_TRIANGLES, counters.Triangles );
+    CHECK_EQUAL( 1u, counters.PipelineBinds );
+    CHECK_EQUAL( 10u, pass->GetNumDrawCalls() );
+    CHECK_EQUAL( 20u, pass->GetNumStateChanges() );
+    CHECK_EQUAL( 10u * TEST_BOX_TRIANGLES, pass->GetNumTriangles() );
+}
+
+TEST( RenderTechniqueOpaquePassInstancesQueuedMeshes )
+{
+    RenderDeviceNull renderDevice;
+
+    std::shared_ptr<Material> transparentMaterial = renderDevice.CreateMaterial();
+    transparentMaterial->SetOpacity( 0.5f );
+
+    std::shared_ptr<Mesh> opaqueBox = CreateTestBox( renderDevice, renderDevice.CreateMaterial() );
+    std::shared_ptr<Mesh> otherOpaqueBox = CreateTestBox( renderDevice, renderDevice.CreateMaterial() );
+    std::shared_ptr<Mesh> transparentBox = CreateTestBox( renderDevice, transparentMaterial );
+
+    // The meshes are added in an order that alternates between the meshes,
+    // so the render queue has to sort them to draw each mesh once.
+    std::shared_ptr<TestScene> scene = std::make_shared<TestScene>();
+    for ( int i = 0; i < 10; ++i )
+    {
+        scene->AddMesh( opaqueBox, glm::vec3( i * 2.0f, 0, 0 ) );
+        scene->AddMesh( otherOpaqueBox, glm::vec3( i * 2.0f, 2.0f, 0 ) );
+        scene->AddMesh( transparentBox, glm::vec3( i * 2.0f, 4.0f, 0 ) );
+    }
+
+    std::shared_ptr<OpaquePass> pass = std::make_shared<OpaquePass>( renderDevice, scene, CreateTestPipeline( renderDevice ) );
+    RenderTechnique technique;
+    technique.AddPass( pass );
+
+    RenderCountersNull counters = RenderTestFrame( renderDevice, technique );
+
+    // One instanced draw call for each opaque mesh (the transparent mesh is not rendered).
+    CHECK_EQUAL( 2u, counters.DrawCalls );
+    CHECK_EQUAL( 20u * TEST_BOX_TRIANGLES, counters.Triangles );
+    CHECK_EQUAL( 1u, counters.PipelineBinds );
+    CHECK_EQUAL( 2u, pass->GetNumDrawCalls() );
+    // The buffers and the material of each mesh are bound once.
+    CHECK_EQUAL( 4u, pass->GetNumStateChanges() );
+    CHECK_EQUAL( 20u * TEST_BOX_TRIANGLES, pass->GetNumTriangles() );
+
+    // The next frame makes the same calls.
+    RenderCountersNull nextCounters = RenderTestFrame( renderDevice, technique );
+    CHECK_EQUAL( counters.DrawCalls, nextCounters.DrawCalls );
+    CHECK_EQUAL( counters.DrawOrderHash, nextCounters.DrawOrderHash );
+}
+
+TEST( RenderTechniqueLightsPassDrawsEachLightTypeOnce )
+{
+    RenderDeviceNull renderDevice;
+
+    std::vector<Light> lights( 5 );
+    lights[3].m_Type = Light::LightType::Spot;
+    lights[4].m_Type = Light::LightType::Spot;
+
+    // Each light type is rendered with its own scene.
+    std::shared_ptr<TestScene> lightScenes[3];
+    for ( std::shared_ptr<TestScene>& lightScene : lightScenes )
+    {
+        lightScene = std::make_shared<TestScene>();
+        lightScene->AddMesh( CreateTestBox( renderDevice, renderDevice.CreateMaterial() ), glm::vec3( 0 ) );
+    }
+
+    std::shared_ptr<LightsPass> pass = std::make_shared<LightsPass>( renderDevice, lights, lightScenes[0], lightScenes[1], lightScenes[2], CreateTestPipeline( renderDevice ) );
+    RenderTechnique technique;
+    technique.AddPass( pass );
+
+    RenderCountersNull counters = RenderTestFrame( renderDevice, technique );
+
+    // All lights of the same type are drawn with a single instanced draw call
+    // (and there are no directional lights).
+    CHECK_EQUAL( 2u, counters.DrawCalls );
+    CHECK_EQUAL( 5u * TEST_BOX_TRIANGLES, counters.Triangles );
+    CHECK_EQUAL( 1u, counters.PipelineBinds );
+}
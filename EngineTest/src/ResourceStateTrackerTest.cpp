@@ -0,0 +1,322 @@
+#include <EngineTestPCH.h>
+
+#include <ResourceStateTracker.h>
+#include <StagingUploadRing.h>
+
+#include <EngineTest.h>
+
+TEST( ResourceStateTrackerSkipsRedundantTransitions )
+{
+    ResourceStateTracker stateTracker;
+    int texture = 0;
+
+    stateTracker.Write( &texture, ResourceState::RenderTarget );
+    CHECK_EQUAL( 1u, stateTracker.Flush().size() );
+    CHECK( stateTracker.GetState( &texture ) == ResourceState::RenderTarget );
+
+    // The texture is already a render target.
+    stateTracker.Write( &texture, ResourceState::RenderTarget );
+    CHECK_EQUAL( 0u, stateTracker.Flush().size() );
+    CHECK_EQUAL( 1u, stateTracker.GetNumSkippedTransitions() );
+    CHECK_EQUAL( 1u, stateTracker.GetNumTransitions() );
+}
+
+TEST( ResourceStateTrackerCombinesReadStates )
+{
+    ResourceStateTracker stateTracker;
+    int texture = 0;
+    stateTracker.SetState( &texture, ResourceState::RenderTarget );
+
+    // Reading in two states in the same pass needs a single transition.
+    stateTracker.Read( &texture, ResourceState::ShaderResource );
+    stateTracker.Read( &texture, ResourceState::CopySource );
+    const ResourceStateTracker::TransitionList& transitions = stateTracker.Flush();
+    CHECK_EQUAL( 1u, transitions.size() );
+    CHECK( transitions[0].StateBefore == ResourceState::RenderTarget );
+    CHECK( (uint32_t)transitions[0].StateAfter == ( (uint32_t)ResourceState::ShaderResource | (uint32_t)ResourceState::CopySource ) );
+
+    // The texture keeps both read states, so reading it in one of them doesn't need a transition.
+    stateTracker.Read( &texture, ResourceState::CopySource );
+    CHECK_EQUAL( 0u, stateTracker.Flush().size() );
+
+    // Reading it in another read state adds the state.
+    stateTracker.Read( &texture, ResourceState::DepthRead );
+    CHECK_EQUAL( 1u, stateTracker.Flush().size() );
+    CHECK( ( (uint32_t)stateTracker.GetState( &texture ) & (uint32_t)ResourceState::ShaderResource ) != 0 );
+}
+
+TEST( ResourceStateTrackerAddsUAVBarriers )
+{
+    ResourceStateTracker stateTracker;
+    int buffer = 0;
+
+    stateTracker.Write( &buffer, ResourceState::UnorderedAccess );
+    CHECK_EQUAL( 1u, stateTracker.Flush().size() );
+
+    // Consecutive passes that write the buffer need a UAV barrier (but not a transition).
+    stateTracker.Write( &buffer, ResourceState::UnorderedAccess );
+    const ResourceStateTracker::TransitionList& transitions = stateTracker.Flush();
+    CHECK_EQUAL( 1u, transitions.size() );
+    CHECK( transitions[0].IsUAVBarrier() );
+
+    // Reading the buffer transitions it to the read state.
+    stateTracker.Read( &buffer, ResourceState::ShaderResource );
+    CHECK_EQUAL( 1u, stateTracker.Flush().size() );
+    CHECK( stateTracker.GetState( &buffer ) == ResourceState::ShaderResource );
+}
+
+TEST( ResourceStateTrackerKeepsDeclarationOrder )
+{
+    ResourceStateTracker stateTracker;
+    int resources[3] = {};
+
+    stateTracker.Read( &resources[2], ResourceState::VertexBuffer );
+    stateTracker.Write( &resources[0], ResourceState::DepthWrite );
+    stateTracker.Read( &resources[1], ResourceState::IndexBuffer );
+    CHECK( stateTracker.IsDeclared( &resources[0] ) );
+    const ResourceStateTracker::TransitionList& transitions = stateTracker.Flush();
+    CHECK( !stateTracker.IsDeclared( &resources[0] ) );
+    CHECK_EQUAL( 3u, transitions.size() );
+    CHECK( transitions[0].Resource == &resources[2] );
+    CHECK( transitions[1].Resource == &resources[0] );
+    CHECK( transitions[2].Resource == &resources[1] );
+    CHECK_EQUAL( 3u, stateTracker.GetNumResources() );
+
+    stateTracker.RemoveResource( &resources[0] );
+    CHECK_EQUAL( 2u, stateTracker.GetNumResources() );
+    CHECK( stateTracker.GetState( &resources[0] ) == ResourceState::Common );
+
+    stateTracker.Clear();
+    CHECK_EQUAL( 0u, stateTracker.GetNumResources() );
+}
+
+TEST( StagingUploadRingMergesConsecutiveUploads )
+{
+    std::vector<uint8_t> memory( 256 );
+    StagingUploadRing ring( memory.data(), memory.size() );
+    int a = 0;
+    int b = 0;
+    const uint8_t data[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+    CHECK( ring.Upload( &a, 0, data, 8 ) );
+    CHECK( ring.Upload( &b, 0, data, 4 ) );
+    CHECK( ring.Upload( &a, 8, data + 8, 8 ) );
+    CHECK( ring.HasPendingUploads() );
+
+    // The uploads to a are not consecutive in the staging memory, so they are not merged.
+    const StagingUploadRing::CopyRegionList& regions = ring.Flush();
+    CHECK_EQUAL( 3u, regions.size() );
+    CHECK( !ring.HasPendingUploads() );
+
+    // The regions are grouped by destination and keep their order.
+    size_t firstA = ( regions[0].Destination == &a ) ? 0 : 1;
+    CHECK( regions[firstA].Destination == &a );
+    CHECK( regions[firstA + 1].Destination == &a );
+    CHECK_EQUAL( 0u, regions[firstA].DestinationOffset );
+    CHECK_EQUAL( 8u, regions[firstA + 1].DestinationOffset );
+    CHECK( memcmp( ring.GetData( regions[firstA + 1].SourceOffset ), data + 8, 8 ) == 0 );
+
+    // Consecutive uploads to consecutive ranges are merged into a single region.
+    CHECK( ring.Upload( &b, 0, data, 4 ) );
+    CHECK( ring.Upload( &b, 4, data + 4, 4 ) );
+    CHECK( ring.Upload( &b, 8, data + 8, 4 ) );
+    const StagingUploadRing::CopyRegionList& merged = ring.Flush();
+    CHECK_EQUAL( 1u, merged.size() );
+    CHECK_EQUAL( 12u, merged[0].Size );
+    CHECK( memcmp( ring.GetData( merged[0].SourceOffset ), data, 12 ) == 0 );
+}
+
+TEST( StagingUploadRingRetiresFrames )
+{
+    std::vector<uint8_t> memory( 64 );
+    StagingUploadRing ring( memory.data(), memory.size() );
+    int destination = 0;
+    uint8_t data[32] = {};
+
+    CHECK( ring.Upload( &destination, 0, data, 24 ) );
+    CHECK( ring.Upload( &destination, 0, data, 24 ) );
+    ring.Flush();
+    ring.EndFrame( 1 );
+
+    // The data doesn't fit at the end of the ring and the start of the ring is still in use.
+    CHECK( !ring.Upload( &destination, 0, data, 32 ) );
+    ring.Retire( 1 );
+    CHECK_EQUAL( 0u, ring.GetUsedSize() );
+
+    // An upload never wraps around the end of the ring.
+    CHECK( ring.Upload( &destination, 0, data, 32 ) );
+    const StagingUploadRing::CopyRegionList& regions = ring.Flush();
+    CHECK_EQUAL( 1u, regions.size() );
+    CHECK_EQUAL( 0u, regions[0].SourceOffset );
+    CHECK_EQUAL( 48u, ring.GetUsedSize() );
+
+    // Uploads are placed at a multiple of their alignment.
+    CHECK( ring.Upload( &destination, 0, data, 1 ) );
+    CHECK( ring.Upload( &destination, 0, data, 4, 8 ) );
+    CHECK_EQUAL( 40u, ring.Flush()[1].SourceOffset );
+}
+
+#define BENCHMARK_NUM_STATE_FRAMES 1000
+#define BENCHMARK_NUM_STATE_RESOURCES 256
+#define BENCHMARK_NUM_STATE_PASSES 64
+#define BENCHMARK_NUM_UPLOADS 10000
+#define BENCHMARK_UPLOAD_DESTINATION_SIZE 4096
+#define BENCHMARK_UPLOAD_FRAMES_IN_FLIGHT 3
+
+// Measure the CPU time to compute the transitions of the resources that are declared by the passes of a frame
+// and to batch many small uploads through the staging ring. Checks that the resources end up in their declared
+// states and that the batched copies produce the same data as updating the destinations directly.
+BENCHMARK( ResourceStateBenchmark )
+{
+    std::cout << "Resource state benchmark (" << BENCHMARK_NUM_STATE_FRAMES << " frames, " << BENCHMARK_UPLOAD_FRAMES_IN_FLIGHT << " frames in flight):" << std::endl;
+
+    // Resource states: every frame renders the same passes. Each pass writes 2 resources
+    // and reads 6 resources in 1 or 2 states. The same frames are run with and without checking
+    // that the transitions put the resources in the states they are declared in.
+    {
+        struct Access
+        {
+            uint32_t Resource;
+            ResourceState State;
+            bool Write;
+        };
+        const ResourceState readStates[] = { ResourceState::VertexBuffer, ResourceState::IndexBuffer, ResourceState::ConstantBuffer,
+                                             ResourceState::ShaderResource, ResourceState::CopySource, ResourceState::DepthRead };
+        const ResourceState writeStates[] = { ResourceState::RenderTarget, ResourceState::UnorderedAccess, ResourceState::DepthWrite, ResourceState::CopyDest };
+
+        std::vector<uint32_t> resources( BENCHMARK_NUM_STATE_RESOURCES );
+        std::vector< std::vector<Access> > passes( BENCHMARK_NUM_STATE_PASSES );
+        std::mt19937 random( 0 );
+        size_t numAccesses = 0;
+        for ( std::vector<Access>& pass : passes )
+        {
+            std::vector<uint32_t> indices( BENCHMARK_NUM_STATE_RESOURCES );
+            for ( uint32_t i = 0; i < BENCHMARK_NUM_STATE_RESOURCES; ++i )
+            {
+                indices[i] = i;
+            }
+            std::shuffle( indices.begin(), indices.end(), random );
+            for ( uint32_t i = 0; i < 8; ++i )
+            {
+                if ( i < 2 )
+                {
+                    pass.push_back( { indices[i], writeStates[random() % 4], true } );
+                }
+                else
+                {
+                    pass.push_back( { indices[i], readStates[random() % 6], false } );
+                    if ( random() % 2 ) pass.push_back( { indices[i], readStates[random() % 6], false } );
+                }
+            }
+            numAccesses += pass.size();
+        }
+
+        for ( int validate = 1; validate >= 0; --validate )
+        {
+            ResourceStateTracker stateTracker;
+            uint32_t numErrors = 0;
+
+            BenchmarkTimer timer;
+            for ( uint32_t frame = 0; frame < BENCHMARK_NUM_STATE_FRAMES; ++frame )
+            {
+                for ( const std::vector<Access>& pass : passes )
+                {
+                    for ( const Access& access : pass )
+                    {
+                        if ( access.Write )
+                        {
+                            stateTracker.Write( &resources[access.Resource], access.State );
+                        }
+                        else
+                        {
+                            stateTracker.Read( &resources[access.Resource], access.State );
+                        }
+                    }
+
+                    const ResourceStateTracker::TransitionList& transitions = stateTracker.Flush();
+
+                    if ( validate )
+                    {
+                        for ( const ResourceStateTracker::Transition& transition : transitions )
+                        {
+                            if ( stateTracker.GetState( transition.Resource ) != transition.StateAfter ) ++numErrors;
+                        }
+                        for ( const Access& access : pass )
+                        {
+                            uint32_t state = (uint32_t)stateTracker.GetState( &resources[access.Resource] );
+                            bool valid = access.Write ? ( state == (uint32_t)access.State ) : ( ( state & (uint32_t)access.State ) == (uint32_t)access.State );
+                            if ( !valid ) ++numErrors;
+                        }
+                    }
+                }
+            }
+            timer.Tick();
+
+            if ( validate )
+            {
+                uint64_t numPasses = (uint64_t)BENCHMARK_NUM_STATE_FRAMES * BENCHMARK_NUM_STATE_PASSES;
+                std::cout << "States: " << numAccesses << " declared accesses per frame, "
+                    << stateTracker.GetNumTransitions() / (double)BENCHMARK_NUM_STATE_FRAMES << " transitions per frame ("
+                    << stateTracker.GetNumSkippedTransitions() / (double)BENCHMARK_NUM_STATE_FRAMES << " skipped, "
+                    << stateTracker.GetNumTransitions() / (double)numPasses << " per pass), "
+                    << numErrors << " resources in the wrong state" << std::endl;
+                CHECK_EQUAL( 0u, numErrors );
+            }
+            else
+            {
+                std::cout << "States: " << timer.ElapsedMilliSeconds() / BENCHMARK_NUM_STATE_FRAMES << " ms per frame" << std::endl;
+            }
+        }
+    }
+
+    // Staging uploads: every frame updates runs of 1 to 16 consecutive 16 byte ranges of random destinations.
+    // The copy regions of a frame are applied to a copy of the destinations, which must be the same
+    // as the destinations that are updated directly.
+    {
+        std::vector< std::vector<uint8_t> > expected( BENCHMARK_NUM_STATE_RESOURCES, std::vector<uint8_t>( BENCHMARK_UPLOAD_DESTINATION_SIZE, 0 ) );
+        std::vector< std::vector<uint8_t> > uploaded( expected );
+        std::vector<uint8_t> memory( 2 * BENCHMARK_UPLOAD_FRAMES_IN_FLIGHT * BENCHMARK_NUM_UPLOADS * 16 );
+        StagingUploadRing ring( memory.data(), memory.size() );
+        std::mt19937 random( 0 );
+        uint32_t numFailed = 0;
+        uint64_t numCopies = 0;
+        size_t maxUsed = 0;
+
+        BenchmarkTimer timer;
+        for ( uint64_t frame = 1; frame <= BENCHMARK_NUM_STATE_FRAMES; ++frame )
+        {
+            ring.Retire( frame > BENCHMARK_UPLOAD_FRAMES_IN_FLIGHT ? frame - BENCHMARK_UPLOAD_FRAMES_IN_FLIGHT : 0 );
+
+            for ( uint32_t i = 0; i < BENCHMARK_NUM_UPLOADS; )
+            {
+                uint32_t destination = random() % BENCHMARK_NUM_STATE_RESOURCES;
+                uint32_t runLength = 1 + random() % 16;
+                size_t offset = ( random() % ( BENCHMARK_UPLOAD_DESTINATION_SIZE / 16 - runLength + 1 ) ) * 16;
+                for ( uint32_t j = 0; j < runLength; ++j, ++i, offset += 16 )
+                {
+                    uint8_t* data = &expected[destination][offset];
+                    std::fill( data, data + 16, (uint8_t)random() );
+                    if ( !ring.Upload( &uploaded[destination], offset, data, 16 ) ) ++numFailed;
+                }
+            }
+            maxUsed = std::max( maxUsed, ring.GetUsedSize() );
+
+            const StagingUploadRing::CopyRegionList& copyRegions = ring.Flush();
+            for ( const StagingUploadRing::CopyRegion& copyRegion : copyRegions )
+            {
+                std::vector<uint8_t>& destination = *(std::vector<uint8_t>*)copyRegion.Destination;
+                memcpy( &destination[copyRegion.DestinationOffset], ring.GetData( copyRegion.SourceOffset ), copyRegion.Size );
+            }
+            numCopies += copyRegions.size();
+
+            ring.EndFrame( frame );
+        }
+        timer.Tick();
+
+        std::cout << "Uploads: " << timer.ElapsedMilliSeconds() / BENCHMARK_NUM_STATE_FRAMES << " ms per frame, "
+            << BENCHMARK_NUM_UPLOADS << " uploads in " << numCopies / (double)BENCHMARK_NUM_STATE_FRAMES << " copies per frame, "
+            << maxUsed << " of " << ring.GetSize() << " bytes used, " << numFailed << " failed uploads" << std::endl;
+        CHECK_EQUAL( 0u, numFailed );
+        CHECK( uploaded == expected );
+    }
+}
@@ -0,0 +1,482 @@
+#include <EngineTestPCH.h>
+
+// The scene cache memory maps files with the Windows API and scenes are imported with Assimp,
+// so the scene cache is only tested on Windows (vs_2022/EngineTest.vcxproj).
+#if defined(_WIN32)
+
+#include <fstream>
+
+#include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include <SceneCache.h>
+
+#include <EngineTest.h>
+
+// The number of quads along each side of the grid mesh of the test scene.
+#define TEST_GRID_SIZE 16
+
+// Relative to the directory of the test executable (EngineTest/bin).
+#define BENCHMARK_SCENE_FILE_NAME L"..\\..\\GraphicsTest\\Assets\\models\\crytek-sponza\\sponza_nobanner.obj"
+#define BENCHMARK_NUM_LOADS 5
+
+static std::wstring GetExecutableDirectory()
+{
+    wchar_t fileName[MAX_PATH];
+    DWORD length = GetModuleFileNameW( NULL, fileName, MAX_PATH );
+    std::wstring path( fileName, length );
+    return path.substr( 0, path.find_last_of( L"\\/" ) + 1 );
+}
+
+static std::string ToString( const std::wstring& str )
+{
+    return std::string( str.begin(), str.end() );
+}
+
+// A file in the temporary directory.
+static std::wstring GetTestFileName( const std::wstring& name )
+{
+    wchar_t tempPath[MAX_PATH];
+    GetTempPathW( MAX_PATH, tempPath );
+    return std::wstring( tempPath ) + name;
+}
+
+static bool SaveBytes( const std::wstring& fileName, const std::vector<uint8_t>& bytes )
+{
+    std::ofstream file( fileName, std::ios::binary | std::ios::trunc );
+    file.write( reinterpret_cast<const char*>( bytes.data() ), (std::streamsize)bytes.size() );
+    return file.good();
+}
+
+// A wavy grid of TEST_GRID_SIZE x TEST_GRID_SIZE quads with normals and texture coordinates
+// (it has enough triangles to be split into meshlets and levels of detail).
+static aiMesh* CreateGridMesh()
+{
+    const uint32_t numVertices = ( TEST_GRID_SIZE + 1 ) * ( TEST_GRID_SIZE + 1 );
+
+    aiMesh* mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mMaterialIndex = 0;
+    mesh->mNumVertices = numVertices;
+    mesh->mVertices = new aiVector3D[numVertices];
+    mesh->mNormals = new aiVector3D[numVertices];
+    mesh->mTextureCoords[0] = new aiVector3D[numVertices];
+    mesh->mNumUVComponents[0] = 2;
+    for ( uint32_t y = 0; y <= TEST_GRID_SIZE; ++y )
+    {
+        for ( uint32_t x = 0; x <= TEST_GRID_SIZE; ++x )
+        {
+            uint32_t i = y * ( TEST_GRID_SIZE + 1 ) + x;
+            mesh->mVertices[i] = aiVector3D( (float)x, (float)y, 0.25f * sinf( x * 0.5f ) );
+            mesh->mNormals[i] = aiVector3D( 0, 0, 1 );
+            mesh->mTextureCoords[0][i] = aiVector3D( (float)x / TEST_GRID_SIZE, (float)y / TEST_GRID_SIZE, 0 );
+        }
+    }
+
+    mesh->mNumFaces = TEST_GRID_SIZE * TEST_GRID_SIZE * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for ( uint32_t y = 0; y < TEST_GRID_SIZE; ++y )
+    {
+        for ( uint32_t x = 0; x < TEST_GRID_SIZE; ++x )
+        {
+            uint32_t i0 = y * ( TEST_GRID_SIZE + 1 ) + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + TEST_GRID_SIZE + 1;
+            uint32_t i3 = i2 + 1;
+            const uint32_t triangles[2][3] = { { i0, i1, i3 }, { i0, i3, i2 } };
+            for ( uint32_t t = 0; t < 2; ++t )
+            {
+                aiFace& face = mesh->mFaces[( y * TEST_GRID_SIZE + x ) * 2 + t];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned int[3];
+                std::copy( triangles[t], triangles[t] + 3, face.mIndices );
+            }
+        }
+    }
+
+    return mesh;
+}
+
+// A scene with a material, a grid mesh and a root node with a (translated) child node that references the mesh.
+static std::unique_ptr<aiScene> CreateTestScene()
+{
+    std::unique_ptr<aiScene> scene( new aiScene() );
+
+    aiMaterial* material = new aiMaterial();
+    aiColor4D diffuseColor( 0.5f, 0.25f, 1.0f, 1.0f );
+    material->AddProperty( &diffuseColor, 1, AI_MATKEY_COLOR_DIFFUSE );
+    aiString diffuseTexture;
+    diffuseTexture.Set( "textures/diffuse.png" );
+    material->AddProperty( &diffuseTexture, AI_MATKEY_TEXTURE_DIFFUSE( 0 ) );
+    scene->mNumMaterials = 1;
+    scene->mMaterials = new aiMaterial*[1];
+    scene->mMaterials[0] = material;
+
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    scene->mMeshes[0] = CreateGridMesh();
+
+    aiNode* root = new aiNode();
+    root->mName.Set( "Root" );
+    aiNode* child = new aiNode();
+    child->mName.Set( "Grid" );
+    child->mParent = root;
+    aiMatrix4x4::Translation( aiVector3D( 1, 2, 3 ), child->mTransformation );
+    child->mNumMeshes = 1;
+    child->mMeshes = new unsigned int[1];
+    child->mMeshes[0] = 0;
+    root->mNumChildren = 1;
+    root->mChildren = new aiNode*[1];
+    root->mChildren[0] = child;
+    scene->mRootNode = root;
+
+    return scene;
+}
+
+// The positions of a triangle, starting with the smallest position (the winding order is kept).
+static std::array<float, 9> GetTriangle( const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2 )
+{
+    const glm::vec3 positions[3] = { p0, p1, p2 };
+    auto less = []( const glm::vec3& a, const glm::vec3& b )
+    {
+        return std::tie( a.x, a.y, a.z ) < std::tie( b.x, b.y, b.z );
+    };
+    uint32_t first = less( p1, p0 ) ? 1 : 0;
+    if ( less( p2, positions[first] ) ) first = 2;
+
+    std::array<float, 9> triangle;
+    for ( uint32_t i = 0; i < 3; ++i )
+    {
+        const glm::vec3& p = positions[( first + i ) % 3];
+        triangle[i * 3 + 0] = p.x;
+        triangle[i * 3 + 1] = p.y;
+        triangle[i * 3 + 2] = p.z;
+    }
+    return triangle;
+}
+
+TEST( SceneCacheBuildSaveLoadRoundTrip )
+{
+    std::unique_ptr<aiScene> scene = CreateTestScene();
+    SceneCache builtCache;
+    CHECK( builtCache.Build( *scene ) );
+
+    std::wstring fileName = GetTestFileName( L"EngineTest-roundtrip.scenecache" );
+    CHECK( builtCache.Save( fileName ) );
+
+    // The file is loaded exactly as it was built.
+    SceneCache sceneCache;
+    CHECK( sceneCache.Load( fileName ) );
+    const SceneCache::Header& header = sceneCache.GetHeader();
+    CHECK_EQUAL( builtCache.GetHeader().FileSize, header.FileSize );
+    CHECK( memcmp( &builtCache.GetHeader(), &header, (size_t)header.FileSize ) == 0 );
+
+    CHECK_EQUAL( 1u, header.NumMaterials );
+    const SceneCache::MaterialRecord& material = sceneCache.GetMaterial( 0 );
+    CHECK( ( material.Properties & SceneCache::DiffuseColor ) != 0 );
+    CHECK( material.DiffuseColor == glm::vec4( 0.5f, 0.25f, 1.0f, 1.0f ) );
+    // The diffuse texture slot (Material::TextureType::Diffuse).
+    CHECK( std::string( sceneCache.GetString( material.Textures[2] ) ) == "textures/diffuse.png" );
+    CHECK( sceneCache.GetString( material.Textures[SceneCache::HeightMapSlot] ) == nullptr );
+
+    // Parents are stored before their children.
+    CHECK_EQUAL( 2u, header.NumNodes );
+    const SceneCache::NodeRecord& root = sceneCache.GetNode( 0 );
+    const SceneCache::NodeRecord& child = sceneCache.GetNode( 1 );
+    CHECK_EQUAL( -1, root.Parent );
+    CHECK_EQUAL( 0, child.Parent );
+    CHECK( std::string( sceneCache.GetString( root.Name ) ) == "Root" );
+    CHECK( std::string( sceneCache.GetString( child.Name ) ) == "Grid" );
+    CHECK( child.LocalTransform[3] == glm::vec4( 1, 2, 3, 1 ) );
+    CHECK_EQUAL( 0u, root.NumMeshes );
+    CHECK_EQUAL( 1u, child.NumMeshes );
+    CHECK_EQUAL( 0u, sceneCache.GetNodeMeshes( child )[0] );
+
+    // The vertices and triangles are reordered, but the triangles have the same positions.
+    const aiMesh& sourceMesh = *scene->mMeshes[0];
+    CHECK_EQUAL( 1u, header.NumMeshes );
+    const SceneCache::MeshRecord& mesh = sceneCache.GetMesh( 0 );
+    CHECK_EQUAL( sourceMesh.mNumVertices, mesh.NumVertices );
+    CHECK_EQUAL( sourceMesh.mNumFaces * 3, mesh.NumIndices );
+    CHECK_EQUAL( (uint32_t)sizeof( uint16_t ), mesh.IndexSize );
+    CHECK_EQUAL( 3u, mesh.NumStreams );
+    CHECK( mesh.BoundsMin.x == 0.0f && mesh.BoundsMin.y == 0.0f && mesh.BoundsMin.z >= -0.25f );
+    CHECK( mesh.BoundsMax.x == (float)TEST_GRID_SIZE && mesh.BoundsMax.y == (float)TEST_GRID_SIZE && mesh.BoundsMax.z <= 0.25f );
+    CHECK( mesh.NumLods > 1 );
+    CHECK( mesh.NumMeshlets > 0 );
+
+    const SceneCache::StreamRecord& positionStream = sceneCache.GetStream( mesh.FirstStream );
+    CHECK( positionStream.Type == SceneCache::Semantic::Position );
+    const glm::vec3* positions = reinterpret_cast<const glm::vec3*>( sceneCache.GetVertices( positionStream ) );
+
+    std::vector< std::array<float, 9> > sourceTriangles;
+    for ( unsigned int i = 0; i < sourceMesh.mNumFaces; ++i )
+    {
+        const unsigned int* face = sourceMesh.mFaces[i].mIndices;
+        const aiVector3D* v = sourceMesh.mVertices;
+        sourceTriangles.push_back( GetTriangle( glm::vec3( v[face[0]].x, v[face[0]].y, v[face[0]].z ),
+                                                glm::vec3( v[face[1]].x, v[face[1]].y, v[face[1]].z ),
+                                                glm::vec3( v[face[2]].x, v[face[2]].y, v[face[2]].z ) ) );
+    }
+    std::vector< std::array<float, 9> > triangles;
+    for ( uint32_t i = 0; i < mesh.NumIndices; i += 3 )
+    {
+        triangles.push_back( GetTriangle( positions[sceneCache.GetIndex( mesh, i )], positions[sceneCache.GetIndex( mesh, i + 1 )], positions[sceneCache.GetIndex( mesh, i + 2 )] ) );
+    }
+    std::sort( sourceTriangles.begin(), sourceTriangles.end() );
+    std::sort( triangles.begin(), triangles.end() );
+    CHECK( triangles == sourceTriangles );
+
+    sceneCache.Close();
+    DeleteFileW( fileName.c_str() );
+}
+
+TEST( SceneCacheLoadRejectsTruncatedAndCorruptFiles )
+{
+    std::unique_ptr<aiScene> scene = CreateTestScene();
+    SceneCache builtCache;
+    CHECK( builtCache.Build( *scene ) );
+
+    const SceneCache::Header& header = builtCache.GetHeader();
+    const uint8_t* data = reinterpret_cast<const uint8_t*>( &header );
+    const std::vector<uint8_t> image( data, data + header.FileSize );
+    // The offset of a record in the image.
+    auto offsetOf = [&]( const void* record )
+    {
+        return static_cast<size_t>( static_cast<const uint8_t*>( record ) - data );
+    };
+
+    std::wstring fileName = GetTestFileName( L"EngineTest-corrupt.scenecache" );
+    SceneCache sceneCache;
+
+    CHECK( SaveBytes( fileName, image ) );
+    CHECK( sceneCache.Load( fileName ) );
+    sceneCache.Close();
+
+    // An empty file, a part of the header, the tables without the strings and the data, and a file that is one byte short.
+    const size_t truncatedSizes[] = { 0, sizeof( SceneCache::Header ) / 2, (size_t)header.StringTableOffset, image.size() - 1 };
+    for ( size_t size : truncatedSizes )
+    {
+        CHECK( SaveBytes( fileName, std::vector<uint8_t>( image.begin(), image.begin() + size ) ) );
+        CHECK( !sceneCache.Load( fileName ) );
+        CHECK( !sceneCache.IsValid() );
+    }
+
+    const SceneCache::MeshRecord& mesh = builtCache.GetMesh( 0 );
+    CHECK( mesh.NumLods > 1 && mesh.NumMeshlets > 0 );
+    const size_t meshOffset = offsetOf( &mesh );
+    const size_t lodOffset = meshOffset + offsetof( SceneCache::MeshRecord, Lods ) + sizeof( SceneCache::LodRecord );
+
+    // Each corruption overwrites a single value of the image.
+    struct Corruption
+    {
+        size_t Offset;
+        uint64_t Value;
+        size_t Size;
+    };
+    const Corruption corruptions[] =
+    {
+        // The magic number, the version and the size of the file.
+        { offsetof( SceneCache::Header, Magic ), 0, sizeof( uint32_t ) },
+        { offsetof( SceneCache::Header, Version ), header.Version + 1, sizeof( uint32_t ) },
+        { offsetof( SceneCache::Header, FileSize ), header.FileSize + 16, sizeof( uint64_t ) },
+        // A table that ends outside of the file.
+        { offsetof( SceneCache::Header, NumMeshes ), 0x10000000, sizeof( uint32_t ) },
+        // A texture name outside of the string table and a string table that isn't null terminated.
+        { offsetOf( &builtCache.GetMaterial( 0 ) ) + offsetof( SceneCache::MaterialRecord, Textures ) + 2 * sizeof( uint32_t ), header.StringTableSize, sizeof( uint32_t ) },
+        { (size_t)header.StringTableOffset + header.StringTableSize - 1, 'x', 1 },
+        // A mesh with an invalid material, an invalid index size and stream data outside of the file.
+        { meshOffset + offsetof( SceneCache::MeshRecord, MaterialIndex ), header.NumMaterials, sizeof( uint32_t ) },
+        { meshOffset + offsetof( SceneCache::MeshRecord, IndexSize ), 3, sizeof( uint32_t ) },
+        { offsetOf( &builtCache.GetStream( mesh.FirstStream ) ) + offsetof( SceneCache::StreamRecord, Offset ), header.FileSize, sizeof( uint64_t ) },
+        // An index of a vertex that doesn't exist, an empty level of detail and a meshlet outside of the indices of the mesh.
+        { (size_t)mesh.IndexOffset, mesh.NumVertices, sizeof( uint16_t ) },
+        { lodOffset + offsetof( SceneCache::LodRecord, NumIndices ), 0, sizeof( uint32_t ) },
+        { offsetOf( &builtCache.GetMeshlet( mesh.FirstMeshlet ) ) + offsetof( SceneCache::MeshletRecord, FirstIndex ), mesh.NumIndices, sizeof( uint32_t ) },
+        // A node that is its own parent (parents must be stored before their children) and a node with a mesh that doesn't exist.
+        { offsetOf( &builtCache.GetNode( 1 ) ) + offsetof( SceneCache::NodeRecord, Parent ), 1, sizeof( int32_t ) },
+        { offsetOf( builtCache.GetNodeMeshes( builtCache.GetNode( 1 ) ) ), header.NumMeshes, sizeof( uint32_t ) },
+    };
+
+    for ( const Corruption& corruption : corruptions )
+    {
+        std::vector<uint8_t> corrupt = image;
+        memcpy( &corrupt[corruption.Offset], &corruption.Value, corruption.Size );
+        CHECK( SaveBytes( fileName, corrupt ) );
+        CHECK( !sceneCache.Load( fileName ) );
+    }
+
+    DeleteFileW( fileName.c_str() );
+}
+
+// Remove a file from the system file cache, so the next read comes from the disk.
+// Opening a file without buffering flushes and purges its cached pages
+// (this only works if the file is not memory mapped at the same time).
+static void EvictFromFileCache( const std::wstring& fileName )
+{
+    HANDLE hFile = CreateFileW( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, NULL );
+    if ( hFile != INVALID_HANDLE_VALUE )
+    {
+        CloseHandle( hFile );
+    }
+}
+
+// Load an imported scene the way SceneBase did before the scene cache: read the .assbin file with Assimp
+// and repack the attributes of every mesh before they are copied into the vertex and index buffers.
+static uint64_t LoadAssbin( const std::wstring& fileName, std::vector<uint8_t>& uploadBuffer )
+{
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile( ToString( fileName ), 0 );
+    CHECK( scene != nullptr );
+
+    uint64_t numBytes = 0;
+    auto upload = [&]( const void* data, size_t size )
+    {
+        if ( uploadBuffer.size() < size ) uploadBuffer.resize( size );
+        memcpy( uploadBuffer.data(), data, size );
+        numBytes += size;
+    };
+
+    for ( unsigned int m = 0; m < scene->mNumMeshes; ++m )
+    {
+        const aiMesh& mesh = *scene->mMeshes[m];
+        upload( mesh.mVertices, mesh.mNumVertices * sizeof( aiVector3D ) );
+        if ( mesh.HasNormals() ) upload( mesh.mNormals, mesh.mNumVertices * sizeof( aiVector3D ) );
+        if ( mesh.HasTangentsAndBitangents() )
+        {
+            upload( mesh.mTangents, mesh.mNumVertices * sizeof( aiVector3D ) );
+            upload( mesh.mBitangents, mesh.mNumVertices * sizeof( aiVector3D ) );
+        }
+        for ( unsigned int i = 0; mesh.HasTextureCoords( i ); ++i )
+        {
+            std::vector<aiVector2D> texcoords2D( mesh.mNumVertices );
+            for ( unsigned int j = 0; j < mesh.mNumVertices; ++j )
+            {
+                texcoords2D[j] = aiVector2D( mesh.mTextureCoords[i][j].x, mesh.mTextureCoords[i][j].y );
+            }
+            upload( texcoords2D.data(), texcoords2D.size() * sizeof( aiVector2D ) );
+        }
+
+        std::vector<unsigned int> indices;
+        for ( unsigned int i = 0; i < mesh.mNumFaces; ++i )
+        {
+            const aiFace& face = mesh.mFaces[i];
+            if ( face.mNumIndices == 3 )
+            {
+                indices.insert( indices.end(), face.mIndices, face.mIndices + 3 );
+            }
+        }
+        upload( indices.data(), indices.size() * sizeof( unsigned int ) );
+    }
+
+    return numBytes;
+}
+
+// Load a scene cache the way SceneBase does: the vertex and index buffers are created from the mapped file.
+static uint64_t LoadSceneCache( const std::wstring& fileName, std::vector<uint8_t>& uploadBuffer )
+{
+    SceneCache sceneCache;
+    CHECK( sceneCache.Load( fileName ) );
+
+    uint64_t numBytes = 0;
+    auto upload = [&]( const void* data, size_t size )
+    {
+        if ( uploadBuffer.size() < size ) uploadBuffer.resize( size );
+        memcpy( uploadBuffer.data(), data, size );
+        numBytes += size;
+    };
+
+    const SceneCache::Header& header = sceneCache.GetHeader();
+    for ( uint32_t m = 0; m < header.NumMeshes; ++m )
+    {
+        const SceneCache::MeshRecord& mesh = sceneCache.GetMesh( m );
+        for ( uint32_t s = 0; s < mesh.NumStreams; ++s )
+        {
+            const SceneCache::StreamRecord& stream = sceneCache.GetStream( mesh.FirstStream + s );
+            upload( sceneCache.GetVertices( stream ), static_cast<size_t>( mesh.NumVertices ) * stream.Stride );
+        }
+        if ( mesh.NumIndices > 0 )
+        {
+            upload( sceneCache.GetIndexData( mesh ), static_cast<size_t>( sceneCache.GetIndexCount( mesh ) ) * mesh.IndexSize );
+        }
+    }
+
+    return numBytes;
+}
+
+typedef uint64_t ( *LoadFunction )( const std::wstring& fileName, std::vector<uint8_t>& uploadBuffer );
+
+// The average time to load a file (in milliseconds). A cold load reads the file from the disk.
+static double MeasureLoad( LoadFunction load, const std::wstring& fileName, bool cold, uint64_t& numBytes )
+{
+    std::vector<uint8_t> uploadBuffer;
+    double milliSeconds = 0.0;
+
+    // Load the file once, so the warm loads find it in the file cache.
+    load( fileName, uploadBuffer );
+
+    for ( uint32_t i = 0; i < BENCHMARK_NUM_LOADS; ++i )
+    {
+        if ( cold ) EvictFromFileCache( fileName );
+
+        BenchmarkTimer timer;
+        numBytes = load( fileName, uploadBuffer );
+        timer.Tick();
+        milliSeconds += timer.ElapsedMilliSeconds();
+    }
+
+    return milliSeconds / BENCHMARK_NUM_LOADS;
+}
+
+// Compare the cold and warm load times of Sponza from the scene cache with the .assbin files that were used before.
+// The CPU time to create the buffers is modeled by copying the vertex and index data into an upload buffer
+// (a render device copies the initial data of a buffer in the same way).
+// The Sponza model is stored with Git LFS, so the benchmark is skipped if it hasn't been fetched.
+BENCHMARK( SceneCacheLoadBenchmark )
+{
+    std::wstring sceneFileName = GetExecutableDirectory() + BENCHMARK_SCENE_FILE_NAME;
+    if ( GetFileAttributesW( sceneFileName.c_str() ) == INVALID_FILE_ATTRIBUTES )
+    {
+        std::cout << "Scene cache benchmark skipped: " << ToString( sceneFileName ) << " not found." << std::endl;
+        return;
+    }
+
+    // Import the scene with the same settings as SceneBase and write both formats.
+    Assimp::Importer importer;
+    importer.SetPropertyFloat( AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, IMPORT_SMOOTHING_ANGLE );
+    importer.SetPropertyInteger( AI_CONFIG_PP_SBP_REMOVE, IMPORT_REMOVE_PRIMITIVES );
+    const aiScene* scene = importer.ReadFile( ToString( sceneFileName ), IMPORT_PREPROCESS_FLAGS );
+    CHECK( scene != nullptr );
+
+    std::wstring assbinFileName = GetTestFileName( L"EngineTest-sponza.assbin" );
+    std::wstring sceneCacheFileName = GetTestFileName( L"EngineTest-sponza.scenecache" );
+
+    Assimp::Exporter exporter;
+    CHECK( exporter.Export( scene, "assbin", ToString( assbinFileName ) ) == aiReturn_SUCCESS );
+
+    SceneCache sceneCache;
+    CHECK( sceneCache.Build( *scene ) );
+    CHECK( sceneCache.Save( sceneCacheFileName ) );
+    sceneCache.Close();
+    importer.FreeScene();
+
+    uint64_t assbinBytes = 0;
+    uint64_t sceneCacheBytes = 0;
+    double assbinCold = MeasureLoad( &LoadAssbin, assbinFileName, true, assbinBytes );
+    double assbinWarm = MeasureLoad( &LoadAssbin, assbinFileName, false, assbinBytes );
+    double sceneCacheCold = MeasureLoad( &LoadSceneCache, sceneCacheFileName, true, sceneCacheBytes );
+    double sceneCacheWarm = MeasureLoad( &LoadSceneCache, sceneCacheFileName, false, sceneCacheBytes );
+
+    std::cout << "Scene cache benchmark (Sponza, " << BENCHMARK_NUM_LOADS << " loads):" << std::endl
+        << "  .assbin:     " << assbinCold << " ms cold, " << assbinWarm << " ms warm (" << assbinBytes / ( 1024 * 1024 ) << " MB of buffer data)" << std::endl
+        << "  .scenecache: " << sceneCacheCold << " ms cold, " << sceneCacheWarm << " ms warm (" << sceneCacheBytes / ( 1024 * 1024 ) << " MB of buffer data)" << std::endl;
+
+    DeleteFileW( assbinFileName.c_str() );
+    DeleteFileW( sceneCacheFileName.c_str() );
+
+    CHECK( sceneCacheWarm < assbinWarm );
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include <EngineTestPCH.h>
+
+#include <SlotMap.h>
+#include <ResourceRegistry.h>
+
+#include <EngineTest.h>
+
+TEST( SlotMapInsertAndGet )
+{
+    SlotMap<int> slotMap;
+    ResourceHandle a = slotMap.Insert( 1 );
+    ResourceHandle b = slotMap.Insert( 2 );
+
+    CHECK( a.IsValid() );
+    CHECK( b.IsValid() );
+    CHECK( a != b );
+    CHECK_EQUAL( 2u, slotMap.GetSize() );
+    CHECK_EQUAL( 1, *slotMap.Get( a ) );
+    CHECK_EQUAL( 2, *slotMap.Get( b ) );
+
+    // A default constructed handle never refers to an object.
+    CHECK( !ResourceHandle().IsValid() );
+    CHECK( slotMap.Get( ResourceHandle() ) == nullptr );
+}
+
+TEST( SlotMapRemovedHandlesAreStale )
+{
+    SlotMap<int> slotMap;
+    ResourceHandle a = slotMap.Insert( 1 );
+
+    CHECK( slotMap.Remove( a ) );
+    CHECK( !slotMap.Contains( a ) );
+    CHECK( slotMap.Get( a ) == nullptr );
+    CHECK_EQUAL( 0u, slotMap.GetSize() );
+    // Removing an object twice does nothing.
+    CHECK( !slotMap.Remove( a ) );
+
+    // The slot is reused for the next object, but the old handle stays stale.
+    ResourceHandle b = slotMap.Insert( 2 );
+    CHECK_EQUAL( a.Index, b.Index );
+    CHECK( a.Generation != b.Generation );
+    CHECK( slotMap.Get( a ) == nullptr );
+    CHECK_EQUAL( 2, *slotMap.Get( b ) );
+    CHECK_EQUAL( 1u, slotMap.GetCapacity() );
+}
+
+TEST( SlotMapReusesSlots )
+{
+    SlotMap<int> slotMap;
+    std::vector<ResourceHandle> handles;
+    for ( int i = 0; i < 100; ++i )
+    {
+        handles.push_back( slotMap.Insert( i ) );
+    }
+
+    // Remove every other object and insert the same number of objects again.
+    for ( size_t i = 0; i < handles.size(); i += 2 )
+    {
+        CHECK( slotMap.Remove( handles[i] ) );
+    }
+    for ( int i = 0; i < 50; ++i )
+    {
+        slotMap.Insert( 100 + i );
+    }
+
+    // The memory of the slot map is proportional to the maximum number of objects.
+    CHECK_EQUAL( 100u, slotMap.GetSize() );
+    CHECK_EQUAL( 100u, slotMap.GetCapacity() );
+    for ( size_t i = 0; i < handles.size(); ++i )
+    {
+        CHECK_EQUAL( i % 2 == 1, slotMap.Contains( handles[i] ) );
+    }
+}
+
+TEST( SlotMapClear )
+{
+    SlotMap<int> slotMap;
+    ResourceHandle a = slotMap.Insert( 1 );
+    ResourceHandle b = slotMap.Insert( 2 );
+
+    slotMap.Clear();
+    CHECK_EQUAL( 0u, slotMap.GetSize() );
+    CHECK( !slotMap.Contains( a ) );
+    CHECK( !slotMap.Contains( b ) );
+
+    // The slots are reused from the start of the slot list.
+    ResourceHandle c = slotMap.Insert( 3 );
+    CHECK_EQUAL( 0u, c.Index );
+    CHECK_EQUAL( 2u, slotMap.GetCapacity() );
+}
+
+TEST( ResourceRegistryAddAndRemove )
+{
+    ResourceRegistry<int> registry;
+    std::shared_ptr<int> resource = std::make_shared<int>( 1 );
+
+    ResourceHandle handle = registry.Add( resource );
+    CHECK( handle.IsValid() );
+    // Adding the same resource again returns its existing handle.
+    CHECK( registry.Add( resource ) == handle );
+    CHECK_EQUAL( 1u, registry.GetSize() );
+    CHECK( registry.Get( handle ) == resource );
+    CHECK( registry.GetHandle( resource ) == handle );
+
+    CHECK( registry.Remove( resource ) );
+    CHECK( !registry.Remove( resource ) );
+    CHECK( !registry.Remove( handle ) );
+    CHECK( registry.Get( handle ) == nullptr );
+    CHECK( !registry.GetHandle( resource ).IsValid() );
+    // The registry released its reference.
+    CHECK_EQUAL( 1, resource.use_count() );
+}
+
+TEST( ResourceRegistryRemoveByHandle )
+{
+    ResourceRegistry<int> registry;
+    std::shared_ptr<int> a = std::make_shared<int>( 1 );
+    std::shared_ptr<int> b = std::make_shared<int>( 2 );
+    ResourceHandle handleA = registry.Add( a );
+    ResourceHandle handleB = registry.Add( b );
+
+    CHECK( registry.Remove( handleA ) );
+    CHECK( !registry.GetHandle( a ).IsValid() );
+    CHECK( registry.Get( handleB ) == b );
+
+    // A new resource reuses the slot of a, the handle of a stays stale.
+    std::shared_ptr<int> c = std::make_shared<int>( 3 );
+    ResourceHandle handleC = registry.Add( c );
+    CHECK_EQUAL( handleA.Index, handleC.Index );
+    CHECK( registry.Get( handleA ) == nullptr );
+    CHECK( registry.Get( handleC ) == c );
+
+    registry.Clear();
+    CHECK_EQUAL( 0u, registry.GetSize() );
+    CHECK( registry.Get( handleB ) == nullptr );
+}
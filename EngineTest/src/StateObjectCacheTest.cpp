@@ -0,0 +1,125 @@
+#include <EngineTestPCH.h>
+
+#include <StateObjectCache.h>
+
+#include <EngineTest.h>
+
+// A state description (zero-initialized before it is filled in, see StateObjectCache.h).
+struct TestStateDesc
+{
+    uint32_t Mode;
+    float Bias;
+    uint8_t Enabled;
+};
+
+static TestStateDesc MakeTestStateDesc( uint32_t mode, float bias = 0.0f )
+{
+    TestStateDesc desc;
+    memset( &desc, 0, sizeof( desc ) );
+    desc.Mode = mode;
+    desc.Bias = bias;
+    desc.Enabled = 1;
+
+    return desc;
+}
+
+// The state objects are identified by the number of objects that were created before them.
+typedef std::shared_ptr<uint32_t> TestStateObject;
+
+TEST( StateObjectCacheDeduplicatesDescriptions )
+{
+    StateObjectCache<TestStateDesc, TestStateObject> cache;
+    uint32_t numCreated = 0;
+    auto create = [&]( const TestStateDesc& desc )
+    {
+        return std::make_shared<uint32_t>( numCreated++ );
+    };
+
+    const TestStateObject& first = cache.GetOrCreate( MakeTestStateDesc( 1 ), create );
+    const TestStateObject& second = cache.GetOrCreate( MakeTestStateDesc( 2 ), create );
+    const TestStateObject& otherBias = cache.GetOrCreate( MakeTestStateDesc( 1, 0.5f ), create );
+    CHECK_EQUAL( 3u, numCreated );
+    CHECK_EQUAL( (size_t)3, cache.GetNumObjects() );
+    CHECK_EQUAL( 0ull, cache.GetNumHits() );
+    CHECK_EQUAL( 3ull, cache.GetNumMisses() );
+
+    // The same description returns the same object (the same reference).
+    for ( int i = 0; i < 10; ++i )
+    {
+        CHECK( &cache.GetOrCreate( MakeTestStateDesc( 1 ), create ) == &first );
+        CHECK( &cache.GetOrCreate( MakeTestStateDesc( 2 ), create ) == &second );
+        CHECK( &cache.GetOrCreate( MakeTestStateDesc( 1, 0.5f ), create ) == &otherBias );
+    }
+    CHECK_EQUAL( 3u, numCreated );
+    CHECK_EQUAL( 0u, *first );
+    CHECK_EQUAL( 1u, *second );
+    CHECK_EQUAL( 2u, *otherBias );
+    CHECK_EQUAL( (size_t)3, cache.GetNumObjects() );
+    CHECK_EQUAL( 30ull, cache.GetNumHits() );
+    CHECK_EQUAL( 3ull, cache.GetNumMisses() );
+
+    // Clearing the cache releases the objects but keeps the counters.
+    cache.Clear();
+    CHECK_EQUAL( (size_t)0, cache.GetNumObjects() );
+    CHECK_EQUAL( 30ull, cache.GetNumHits() );
+
+    CHECK_EQUAL( 3u, *cache.GetOrCreate( MakeTestStateDesc( 1 ), create ) );
+    CHECK_EQUAL( 4u, numCreated );
+    CHECK_EQUAL( (size_t)1, cache.GetNumObjects() );
+    CHECK_EQUAL( 4ull, cache.GetNumMisses() );
+}
+
+#define TEST_NUM_CACHE_THREADS 4
+#define TEST_NUM_CACHE_DESCS 16
+#define TEST_NUM_CACHE_REQUESTS 10000
+
+TEST( StateObjectCacheConcurrentGetOrCreate )
+{
+    StateObjectCache<TestStateDesc, TestStateObject> cache;
+    std::atomic<uint32_t> numCreated( 0 );
+    auto create = [&]( const TestStateDesc& desc )
+    {
+        return std::make_shared<uint32_t>( numCreated++ );
+    };
+
+    // Every thread requests the same descriptions (in a different order)
+    // and remembers the objects it got for each description.
+    std::vector< std::vector<const TestStateObject*> > objects( TEST_NUM_CACHE_THREADS, std::vector<const TestStateObject*>( TEST_NUM_CACHE_DESCS, nullptr ) );
+    std::vector<uint32_t> numMismatches( TEST_NUM_CACHE_THREADS, 0 );
+
+    std::vector<std::thread> threads;
+    for ( uint32_t t = 0; t < TEST_NUM_CACHE_THREADS; ++t )
+    {
+        threads.push_back( std::thread( [&, t]()
+        {
+            for ( uint32_t i = 0; i < TEST_NUM_CACHE_REQUESTS; ++i )
+            {
+                uint32_t mode = ( i * ( 2 * t + 1 ) ) % TEST_NUM_CACHE_DESCS;
+                const TestStateObject* object = &cache.GetOrCreate( MakeTestStateDesc( mode ), create );
+                if ( objects[t][mode] == nullptr )
+                {
+                    objects[t][mode] = object;
+                }
+                else if ( objects[t][mode] != object )
+                {
+                    ++numMismatches[t];
+                }
+            }
+        } ) );
+    }
+    for ( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    // Each description is created once and all threads got the same objects.
+    CHECK_EQUAL( (uint32_t)TEST_NUM_CACHE_DESCS, numCreated.load() );
+    CHECK_EQUAL( (size_t)TEST_NUM_CACHE_DESCS, cache.GetNumObjects() );
+    CHECK_EQUAL( (uint64_t)TEST_NUM_CACHE_DESCS, cache.GetNumMisses() );
+    CHECK_EQUAL( (uint64_t)TEST_NUM_CACHE_THREADS * TEST_NUM_CACHE_REQUESTS - TEST_NUM_CACHE_DESCS, cache.GetNumHits() );
+    for ( uint32_t t = 0; t < TEST_NUM_CACHE_THREADS; ++t )
+    {
+        CHECK_EQUAL( 0u, numMismatches[t] );
+        CHECK( objects[t] == objects[0] );
+    }
+}
@@ -0,0 +1,433 @@
+#include <EngineTestPCH.h>
+
+// TextureProcessing.h uses the texture formats of DXGI (see linux/EnginePCH.h for the headless build).
+#include <EnginePCH.h>
+
+#include <TextureProcessing.h>
+
+#include <EngineTest.h>
+
+#define TEST_TEXTURE_SIZE 256
+// The alpha test reference value of the tests (lower than the usual 0.5 so the mip levels
+// of a sparse cutout texture would be covered almost completely without preserving the coverage).
+#define TEST_ALPHA_REFERENCE 0.1f
+
+// The fraction of the texels of a mip level that pass the alpha test.
+static float GetAlphaCoverage( const TextureImage& image, size_t levelIndex, uint32_t channel, uint32_t numChannels, float alphaReference )
+{
+    const TextureImage::Level& level = image.Levels[levelIndex];
+    uint32_t numCovered = 0;
+    for ( uint32_t y = 0; y < level.Height; ++y )
+    {
+        const uint8_t* row = &image.Data[level.Offset + (size_t)y * level.RowPitch];
+        for ( uint32_t x = 0; x < level.Width; ++x )
+        {
+            if ( row[x * numChannels + channel] / 255.0f >= alphaReference ) ++numCovered;
+        }
+    }
+
+    return (float)numCovered / ( level.Width * level.Height );
+}
+
+// A texel of an RGBA8 mip level.
+static const uint8_t* GetTexel( const TextureImage& image, size_t levelIndex, uint32_t x, uint32_t y )
+{
+    const TextureImage::Level& level = image.Levels[levelIndex];
+    return &image.Data[level.Offset + (size_t)y * level.RowPitch + x * 4];
+}
+
+TEST( TextureProcessingGenerateMipmapsPreservesAlphaCoverage )
+{
+    // A sparse cutout texture: a fifth of the texels are opaque, the others are transparent.
+    std::vector<uint8_t> pixels( TEST_TEXTURE_SIZE * TEST_TEXTURE_SIZE * 4, 255 );
+    std::mt19937 random( 42 );
+    for ( size_t i = 0; i < pixels.size(); i += 4 )
+    {
+        pixels[i + 3] = ( random() % 5 == 0 ) ? 255 : 0;
+    }
+
+    for ( MipFilter filter : { MipFilter::Box, MipFilter::Kaiser } )
+    {
+        TextureImage preserved;
+        GenerateMipmaps( pixels.data(), TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE * 4, DXGI_FORMAT_R8G8B8A8_UNORM, true,
+                         TextureUsage::Color, filter, TEST_ALPHA_REFERENCE, preserved );
+        // Without the alpha channel, the coverage is not preserved.
+        TextureImage filtered;
+        GenerateMipmaps( pixels.data(), TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE * 4, DXGI_FORMAT_R8G8B8A8_UNORM, false,
+                         TextureUsage::Color, filter, TEST_ALPHA_REFERENCE, filtered );
+
+        CHECK_EQUAL( (size_t)9, preserved.Levels.size() );
+        const float coverage = GetAlphaCoverage( preserved, 0, 3, 4, TEST_ALPHA_REFERENCE );
+        CHECK( coverage > 0.18f && coverage < 0.22f );
+
+        // The levels down to 8x8 texels keep the coverage of the first level
+        // (the coverage of a level can only change in steps of one texel).
+        for ( size_t i = 1; i < 6; ++i )
+        {
+            float levelCoverage = GetAlphaCoverage( preserved, i, 3, 4, TEST_ALPHA_REFERENCE );
+            CHECK( glm::abs( levelCoverage - coverage ) <= 0.02f );
+        }
+
+        // Filtering without preserving the coverage covers almost the whole level.
+        CHECK( GetAlphaCoverage( filtered, 3, 3, 4, TEST_ALPHA_REFERENCE ) > 0.9f );
+    }
+}
+
+TEST( TextureProcessingGenerateMipmapsFiltersColorsInLinearSpace )
+{
+    // A checkerboard of black and white texels (stored in sRGB).
+    std::vector<uint8_t> pixels( TEST_TEXTURE_SIZE * TEST_TEXTURE_SIZE * 4, 255 );
+    for ( uint32_t y = 0; y < TEST_TEXTURE_SIZE; ++y )
+    {
+        for ( uint32_t x = 0; x < TEST_TEXTURE_SIZE; ++x )
+        {
+            uint8_t* pixel = &pixels[( y * TEST_TEXTURE_SIZE + x ) * 4];
+            pixel[0] = pixel[1] = pixel[2] = ( ( x + y ) % 2 == 0 ) ? 255 : 0;
+        }
+    }
+
+    TextureImage color;
+    GenerateMipmaps( pixels.data(), TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE * 4, DXGI_FORMAT_R8G8B8A8_UNORM, false,
+                     TextureUsage::Color, MipFilter::Box, 0.5f, color );
+    TextureImage linear;
+    GenerateMipmaps( pixels.data(), TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE * 4, DXGI_FORMAT_R8G8B8A8_UNORM, false,
+                     TextureUsage::Linear, MipFilter::Box, 0.5f, linear );
+
+    // The average of linear 0 and 1 is linear 0.5, which is 188 in sRGB (the average of the sRGB values is 128).
+    // Linear data is averaged as it is stored. The alpha channel is always linear.
+    for ( size_t i = 1; i < color.Levels.size(); ++i )
+    {
+        for ( uint32_t y = 0; y < color.Levels[i].Height; ++y )
+        {
+            for ( uint32_t x = 0; x < color.Levels[i].Width; ++x )
+            {
+                const uint8_t* colorTexel = GetTexel( color, i, x, y );
+                const uint8_t* linearTexel = GetTexel( linear, i, x, y );
+                for ( int c = 0; c < 3; ++c )
+                {
+                    CHECK( colorTexel[c] >= 187 && colorTexel[c] <= 189 );
+                    CHECK( linearTexel[c] >= 127 && linearTexel[c] <= 128 );
+                }
+                CHECK_EQUAL( 255, colorTexel[3] );
+            }
+        }
+    }
+}
+
+TEST( TextureProcessingGenerateMipmapsRenormalizesNormals )
+{
+    // A checkerboard of two normals that are tilted in opposite directions: ( +-0.6, 0, 0.8 ).
+    // Their average ( 0, 0, 0.8 ) is shorter than a unit vector.
+    std::vector<uint8_t> pixels( TEST_TEXTURE_SIZE * TEST_TEXTURE_SIZE * 4, 255 );
+    for ( uint32_t y = 0; y < TEST_TEXTURE_SIZE; ++y )
+    {
+        for ( uint32_t x = 0; x < TEST_TEXTURE_SIZE; ++x )
+        {
+            glm::vec3 normal( ( ( x + y ) % 2 == 0 ) ? 0.6f : -0.6f, 0.0f, 0.8f );
+            uint8_t* pixel = &pixels[( y * TEST_TEXTURE_SIZE + x ) * 4];
+            for ( int c = 0; c < 3; ++c )
+            {
+                pixel[c] = static_cast<uint8_t>( ( normal[c] * 0.5f + 0.5f ) * 255.0f + 0.5f );
+            }
+        }
+    }
+
+    for ( MipFilter filter : { MipFilter::Box, MipFilter::Kaiser } )
+    {
+        TextureImage image;
+        GenerateMipmaps( pixels.data(), TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE * 4, DXGI_FORMAT_R8G8B8A8_UNORM, false,
+                         TextureUsage::NormalMap, filter, 0.5f, image );
+
+        // Every normal of the mip levels is a unit vector that points along the z axis
+        // (up to the quantization to 8 bits).
+        for ( size_t i = 1; i < image.Levels.size(); ++i )
+        {
+            for ( uint32_t y = 0; y < image.Levels[i].Height; ++y )
+            {
+                for ( uint32_t x = 0; x < image.Levels[i].Width; ++x )
+                {
+                    const uint8_t* texel = GetTexel( image, i, x, y );
+                    glm::vec3 normal = glm::vec3( texel[0], texel[1], texel[2] ) / 255.0f * 2.0f - 1.0f;
+                    CHECK( glm::abs( glm::length( normal ) - 1.0f ) < 0.01f );
+                    CHECK( normal.z > 0.99f );
+                }
+            }
+        }
+    }
+}
+
+// The color of an RGB565 end point of a BC1 block (the 5 and 6 bit values are expanded to 8 bits).
+static glm::vec3 DecodeColor565( uint16_t color )
+{
+    uint32_t r = ( color >> 11 ) & 31;
+    uint32_t g = ( color >> 5 ) & 63;
+    uint32_t b = color & 31;
+    return glm::vec3( ( r << 3 ) | ( r >> 2 ), ( g << 2 ) | ( g >> 4 ), ( b << 3 ) | ( b >> 2 ) );
+}
+
+// Decode the colors of a BC1 block (4 color mode if color0 > color1, 3 color and black mode otherwise).
+static void DecodeColorBlock( const uint8_t* block, glm::vec3 colors[16] )
+{
+    uint16_t color0, color1;
+    uint32_t indices;
+    memcpy( &color0, block, 2 );
+    memcpy( &color1, block + 2, 2 );
+    memcpy( &indices, block + 4, 4 );
+
+    glm::vec3 palette[4];
+    palette[0] = DecodeColor565( color0 );
+    palette[1] = DecodeColor565( color1 );
+    if ( color0 > color1 )
+    {
+        palette[2] = ( palette[0] * 2.0f + palette[1] ) / 3.0f;
+        palette[3] = ( palette[0] + palette[1] * 2.0f ) / 3.0f;
+    }
+    else
+    {
+        palette[2] = ( palette[0] + palette[1] ) / 2.0f;
+        palette[3] = glm::vec3( 0 );
+    }
+
+    for ( uint32_t i = 0; i < 16; ++i )
+    {
+        colors[i] = palette[( indices >> ( i * 2 ) ) & 3];
+    }
+}
+
+// Decode a channel of a BC4 block (8 value mode if value0 > value1, 6 values, 0 and 255 otherwise).
+static void DecodeChannelBlock( const uint8_t* block, float values[16] )
+{
+    float palette[8];
+    palette[0] = block[0];
+    palette[1] = block[1];
+    if ( block[0] > block[1] )
+    {
+        for ( uint32_t j = 0; j < 6; ++j )
+        {
+            palette[j + 2] = ( ( 6 - j ) * palette[0] + ( 1 + j ) * palette[1] ) / 7.0f;
+        }
+    }
+    else
+    {
+        for ( uint32_t j = 0; j < 4; ++j )
+        {
+            palette[j + 2] = ( ( 4 - j ) * palette[0] + ( 1 + j ) * palette[1] ) / 5.0f;
+        }
+        palette[6] = 0.0f;
+        palette[7] = 255.0f;
+    }
+
+    uint64_t indices = 0;
+    for ( uint32_t i = 0; i < 6; ++i )
+    {
+        indices |= (uint64_t)block[2 + i] << ( i * 8 );
+    }
+    for ( uint32_t i = 0; i < 16; ++i )
+    {
+        values[i] = palette[( indices >> ( i * 3 ) ) & 7];
+    }
+}
+
+// Decode a block compressed mip level to RGBA (the channels that are not stored in the format are 0, alpha is 255).
+static std::vector<glm::vec4> DecodeLevel( const TextureImage& image, size_t levelIndex )
+{
+    const TextureImage::Level& level = image.Levels[levelIndex];
+    const uint32_t blockSize = GetBitsPerPixel( image.Format ) * 2;
+    std::vector<glm::vec4> texels( level.Width * level.Height );
+
+    for ( uint32_t blockY = 0; blockY < ( level.Height + 3 ) / 4; ++blockY )
+    {
+        for ( uint32_t blockX = 0; blockX < ( level.Width + 3 ) / 4; ++blockX )
+        {
+            const uint8_t* block = &image.Data[level.Offset + (size_t)blockY * level.RowPitch + blockX * blockSize];
+            glm::vec3 colors[16];
+            float green[16], alpha[16];
+            std::fill( colors, colors + 16, glm::vec3( 0 ) );
+            std::fill( green, green + 16, 0.0f );
+            std::fill( alpha, alpha + 16, 255.0f );
+
+            switch ( image.Format )
+            {
+            case DXGI_FORMAT_BC1_UNORM:
+                DecodeColorBlock( block, colors );
+                break;
+            case DXGI_FORMAT_BC3_UNORM:
+                DecodeChannelBlock( block, alpha );
+                DecodeColorBlock( block + 8, colors );
+                break;
+            case DXGI_FORMAT_BC4_UNORM:
+            case DXGI_FORMAT_BC5_UNORM:
+            {
+                float red[16];
+                DecodeChannelBlock( block, red );
+                if ( image.Format == DXGI_FORMAT_BC5_UNORM )
+                {
+                    DecodeChannelBlock( block + 8, green );
+                }
+                for ( uint32_t i = 0; i < 16; ++i )
+                {
+                    colors[i] = glm::vec3( red[i], green[i], 0 );
+                }
+                break;
+            }
+            default:
+                break;
+            }
+
+            for ( uint32_t i = 0; i < 16; ++i )
+            {
+                uint32_t x = blockX * 4 + ( i & 3 );
+                uint32_t y = blockY * 4 + ( i >> 2 );
+                if ( x >= level.Width || y >= level.Height ) continue;
+
+                texels[y * level.Width + x] = glm::vec4( colors[i], alpha[i] );
+            }
+        }
+    }
+
+    return texels;
+}
+
+// A smooth gradient with noise in every channel (the alpha channel has its own gradient).
+static std::vector<uint8_t> CreateGradientPixels( uint32_t size, uint32_t noise )
+{
+    std::vector<uint8_t> pixels( size * size * 4 );
+    std::mt19937 random( 42 );
+    for ( uint32_t y = 0; y < size; ++y )
+    {
+        for ( uint32_t x = 0; x < size; ++x )
+        {
+            const uint32_t gradients[4] = { x * 255 / size, y * 255 / size, ( x + y ) * 127 / size, 255 - y * 255 / size };
+            uint8_t* pixel = &pixels[( y * size + x ) * 4];
+            for ( int c = 0; c < 4; ++c )
+            {
+                int value = (int)gradients[c] + (int)( random() % ( noise * 2 + 1 ) ) - (int)noise;
+                pixel[c] = static_cast<uint8_t>( glm::clamp( value, 0, 255 ) );
+            }
+        }
+    }
+
+    return pixels;
+}
+
+// The formats of the round trip test with the channels that are stored in the format,
+// the largest root mean square error of the decoded texels of all levels and
+// the largest absolute error of the texels of the first level (in 8-bit units).
+// The blocks of the small levels cover a large part of the gradients, which the
+// 4 colors of a BC1 block along a single line can't represent (only the RMS error is bounded).
+struct CompressionErrorBound
+{
+    DXGI_FORMAT Format;
+    uint32_t NumChannels;
+    float MaxRMSError;
+    float MaxError;
+};
+
+TEST( TextureProcessingCompressBlockRowsRoundTrip )
+{
+    // The end points of BC1 are quantized to RGB565 and every block has only 4 colors,
+    // BC4 stores 8 values per block at 8-bit precision.
+    static const CompressionErrorBound errorBounds[] =
+    {
+        { DXGI_FORMAT_BC1_UNORM, 3, 3.5f, 14.0f },
+        { DXGI_FORMAT_BC3_UNORM, 4, 3.5f, 14.0f },
+        { DXGI_FORMAT_BC4_UNORM, 1, 1.0f, 2.0f },
+        { DXGI_FORMAT_BC5_UNORM, 2, 1.0f, 2.0f },
+    };
+
+    std::vector<uint8_t> pixels = CreateGradientPixels( TEST_TEXTURE_SIZE, 4 );
+    TextureImage source;
+    GenerateMipmaps( pixels.data(), TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE, TEST_TEXTURE_SIZE * 4, DXGI_FORMAT_R8G8B8A8_UNORM, false,
+                     TextureUsage::Linear, MipFilter::Box, 0.5f, source );
+
+    for ( const CompressionErrorBound& errorBound : errorBounds )
+    {
+        TextureImage expected;
+        CompressTexture( source, errorBound.Format, expected );
+
+        // Compressing the block rows in ranges (that cross the mip levels) gives the same result as compressing them at once.
+        TextureImage compressed;
+        uint32_t numRows = PrepareCompression( source, errorBound.Format, compressed );
+        CHECK_EQUAL( 64u + 32u + 16u + 8u + 4u + 2u + 1u + 1u + 1u, numRows );
+        CHECK_EQUAL( source.Levels.size(), compressed.Levels.size() );
+        for ( uint32_t begin = 0; begin < numRows; begin += 7 )
+        {
+            CompressBlockRows( source, compressed, begin, std::min( begin + 7, numRows ) );
+        }
+        CHECK( compressed.Data == expected.Data );
+        // BC1 and BC4 store 4 bits per texel, BC3 and BC5 store 8 bits per texel.
+        CHECK_EQUAL( (size_t)TEST_TEXTURE_SIZE * TEST_TEXTURE_SIZE * GetBitsPerPixel( errorBound.Format ) / 8, compressed.Levels[0].Size );
+
+        // Decode the mip levels and compare them with the source.
+        double squaredError = 0.0;
+        float maxError = 0.0f;
+        size_t numValues = 0;
+        for ( size_t i = 0; i < compressed.Levels.size(); ++i )
+        {
+            std::vector<glm::vec4> texels = DecodeLevel( compressed, i );
+            for ( uint32_t y = 0; y < source.Levels[i].Height; ++y )
+            {
+                for ( uint32_t x = 0; x < source.Levels[i].Width; ++x )
+                {
+                    const uint8_t* sourceTexel = GetTexel( source, i, x, y );
+                    const glm::vec4& texel = texels[y * source.Levels[i].Width + x];
+                    for ( uint32_t c = 0; c < errorBound.NumChannels; ++c )
+                    {
+                        float error = glm::abs( texel[c] - sourceTexel[c] );
+                        squaredError += error * error;
+                        if ( i == 0 )
+                        {
+                            maxError = std::max( maxError, error );
+                        }
+                        ++numValues;
+                    }
+                }
+            }
+        }
+
+        float rmsError = (float)sqrt( squaredError / numValues );
+        CHECK( rmsError <= errorBound.MaxRMSError );
+        CHECK( maxError <= errorBound.MaxError );
+    }
+}
+
+#define BENCHMARK_TEXTURE_SIZE 2048
+#define BENCHMARK_NUM_COMPRESSIONS 3
+
+// Measure the throughput of the block compression of a BENCHMARK_TEXTURE_SIZE texture with its mip chain
+// (in MB of uncompressed texels per second on a single thread) and the memory that is saved by each format.
+BENCHMARK( TextureProcessingCompressionThroughput )
+{
+    std::vector<uint8_t> pixels = CreateGradientPixels( BENCHMARK_TEXTURE_SIZE, 16 );
+    TextureImage source;
+    GenerateMipmaps( pixels.data(), BENCHMARK_TEXTURE_SIZE, BENCHMARK_TEXTURE_SIZE, BENCHMARK_TEXTURE_SIZE * 4, DXGI_FORMAT_R8G8B8A8_UNORM, false,
+                     TextureUsage::Linear, MipFilter::Box, 0.5f, source );
+    const double uncompressedMB = GetUncompressedSize( source ) / ( 1024.0 * 1024.0 );
+
+    std::cout << "Texture compression throughput (" << BENCHMARK_TEXTURE_SIZE << "x" << BENCHMARK_TEXTURE_SIZE
+        << " with mipmaps, " << uncompressedMB << " MB uncompressed):" << std::endl;
+
+    const std::pair<DXGI_FORMAT, const char*> formats[] =
+    {
+        { DXGI_FORMAT_BC1_UNORM, "BC1" },
+        { DXGI_FORMAT_BC3_UNORM, "BC3" },
+        { DXGI_FORMAT_BC4_UNORM, "BC4" },
+        { DXGI_FORMAT_BC5_UNORM, "BC5" },
+    };
+    for ( const auto& format : formats )
+    {
+        TextureImage compressed;
+        BenchmarkTimer timer;
+        for ( uint32_t i = 0; i < BENCHMARK_NUM_COMPRESSIONS; ++i )
+        {
+            CompressTexture( source, format.first, compressed );
+        }
+        timer.Tick();
+
+        double milliSeconds = timer.ElapsedMilliSeconds() / BENCHMARK_NUM_COMPRESSIONS;
+        double compressedMB = compressed.Data.size() / ( 1024.0 * 1024.0 );
+        std::cout << format.second << ": " << milliSeconds << " ms, "
+            << uncompressedMB / ( milliSeconds / 1000.0 ) << " MB/s, "
+            << compressedMB << " MB (" << uncompressedMB - compressedMB << " MB saved)" << std::endl;
+    }
+}
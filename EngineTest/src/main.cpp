@@ -0,0 +1,97 @@
+#include <EngineTestPCH.h>
+
+#include <EngineTest.h>
+
+TestCaseList& GetTestCases()
+{
+    static TestCaseList testCases;
+    return testCases;
+}
+
+TestRegistration::TestRegistration( const char* name, TestFunction function, bool isBenchmark )
+{
+    TestCase testCase = { name, function, isBenchmark };
+    GetTestCases().push_back( testCase );
+}
+
+void FailTest( const char* file, int line, const std::string& message )
+{
+    std::stringstream ss;
+    ss << file << "(" << line << "): " << message;
+    throw TestFailure( ss.str() );
+}
+
+BenchmarkTimer::BenchmarkTimer()
+    : m_Start( Clock::now() )
+    , m_ElapsedMilliSeconds( 0.0 )
+{}
+
+void BenchmarkTimer::Tick()
+{
+    Clock::time_point now = Clock::now();
+    m_ElapsedMilliSeconds = std::chrono::duration<double, std::milli>( now - m_Start ).count();
+    m_Start = now;
+}
+
+double BenchmarkTimer::ElapsedMilliSeconds() const
+{
+    return m_ElapsedMilliSeconds;
+}
+
+// Usage: EngineTest [--benchmarks] [name ...]
+// Runs the tests (or the benchmarks with --benchmarks) whose names start with one of the names
+// (all of them if no names are given). Returns the number of tests that failed.
+int main( int argc, char* argv[] )
+{
+    bool runBenchmarks = false;
+    std::vector<std::string> filters;
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( strcmp( argv[i], "--benchmarks" ) == 0 )
+        {
+            runBenchmarks = true;
+        }
+        else
+        {
+            filters.push_back( argv[i] );
+        }
+    }
+
+    int numFailed = 0;
+    int numRun = 0;
+    for ( const TestCase& testCase : GetTestCases() )
+    {
+        if ( testCase.IsBenchmark != runBenchmarks ) continue;
+
+        bool selected = filters.empty();
+        for ( const std::string& filter : filters )
+        {
+            selected = selected || testCase.Name.compare( 0, filter.size(), filter ) == 0;
+        }
+        if ( !selected ) continue;
+
+        ++numRun;
+        std::cout << "[ RUN  ] " << testCase.Name << std::endl;
+        try
+        {
+            testCase.Function();
+            std::cout << "[  OK  ] " << testCase.Name << std::endl;
+        }
+        catch ( const std::exception& e )
+        {
+            std::cout << "[FAILED] " << testCase.Name << ": " << e.what() << std::endl;
+            ++numFailed;
+        }
+    }
+
+    // A filter that doesn't select anything is most likely a typo.
+    if ( numRun == 0 )
+    {
+        std::cout << "No " << ( runBenchmarks ? "benchmarks" : "tests" ) << " match the command line." << std::endl;
+        return 1;
+    }
+
+    std::cout << numRun - numFailed << " of " << numRun << ( runBenchmarks ? " benchmarks" : " tests" ) << " passed." << std::endl;
+
+    return numFailed;
+}
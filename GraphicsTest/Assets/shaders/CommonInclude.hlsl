@@ -138,6 +138,67 @@ struct Frustum
     Plane planes[4];   // left, right, top, bottom frustum planes.
 };
 
+// The vertex attributes after they have been decoded (see DecodeAppData).
+struct VertexAttributes
+{
+    float3 position;
+    float3 tangent;
+    float3 binormal;
+    float3 normal;
+    float2 texCoord;
+};
+
+#if QUANTIZED_VERTICES
+// The vertex attributes of imported meshes are quantized and interleaved
+// in a single vertex buffer (see QuantizedVertex in VertexQuantization.h).
+// The attributes are read as packed integers.
+struct AppData
+{
+    uint2 position  : POSITION;     // xyz: Position relative to the mesh bounds (unorm16), w: Binormal sign.
+    uint  normal    : NORMAL;       // Octahedral encoded normal (snorm16).
+    uint  tangent   : TANGENT;      // Octahedral encoded tangent (snorm16).
+    uint  texCoord  : TEXCOORD0;    // Half precision texture coordinate.
+};
+
+// The bounds that were used to quantize the vertex positions of the mesh.
+cbuffer QuantizedMesh : register( b1 )
+{
+    float3 BoundsMin;
+    float3 BoundsSize;
+}
+
+float2 UnpackSnorm2x16( uint packed )
+{
+    // Sign extend the 16-bit components.
+    int2 components = asint( uint2( packed << 16, packed ) ) >> 16;
+    return max( components / 32767.0f, -1.0f );
+}
+
+// Restore a unit vector from its octahedral encoding.
+float3 DecodeOctahedral( float2 e )
+{
+    float3 v = float3( e, 1.0f - abs( e.x ) - abs( e.y ) );
+    float t = saturate( -v.z );
+    v.xy += v.xy >= 0.0f ? -t : t;
+    return normalize( v );
+}
+
+VertexAttributes DecodeAppData( AppData IN )
+{
+    VertexAttributes OUT;
+
+    float3 position = float3( IN.position.x & 0xffff, IN.position.x >> 16, IN.position.y & 0xffff ) / 65535.0f;
+    float binormalSign = ( IN.position.y >> 16 ) ? 1.0f : -1.0f;
+
+    OUT.position = BoundsMin + position * BoundsSize;
+    OUT.normal = DecodeOctahedral( UnpackSnorm2x16( IN.normal ) );
+    OUT.tangent = DecodeOctahedral( UnpackSnorm2x16( IN.tangent ) );
+    OUT.binormal = cross( OUT.normal, OUT.tangent ) * binormalSign;
+    OUT.texCoord = f16tof32( uint2( IN.texCoord & 0xffff, IN.texCoord >> 16 ) );
+
+    return OUT;
+}
+#else
 struct AppData
 {
     float3 position : POSITION;
@@ -147,10 +208,27 @@ struct AppData
     float2 texCoord : TEXCOORD0;
 };
 
+VertexAttributes DecodeAppData( AppData IN )
+{
+    VertexAttributes OUT;
+
+    OUT.position = IN.position;
+    OUT.tangent = IN.tangent;
+    OUT.binormal = IN.binormal;
+    OUT.normal = IN.normal;
+    OUT.texCoord = IN.texCoord;
+
+    return OUT;
+}
+#endif
+
 cbuffer PerObject : register( b0 )
 {
     float4x4 ModelViewProjection;
     float4x4 ModelView;
+    // The index of the first instance of the draw call in the instance buffer
+    // (SV_InstanceID does not include the start instance location).
+    uint FirstInstance;
 }
 
 cbuffer Material : register( b2 )
@@ -176,6 +254,17 @@ Texture2D OpacityTexture        : register( t7 );
 
 StructuredBuffer<Light> Lights : register( t8 );
 
+// Per-instance data for instanced rendering.
+struct InstanceData
+{
+    float4x4 ModelViewProjection;
+    float4x4 ModelView;
+};
+
+StructuredBuffer<InstanceData> Instances : register( t11 );
+// The color of each instance (only used for rendering lights).
+StructuredBuffer<float4> LightColors : register( t12 );
+
 sampler LinearRepeatSampler     : register( s0 );
 sampler LinearClampSampler      : register( s1 );
 
@@ -323,8 +412,10 @@ struct LightingResult
 
 float4 DoNormalMapping( float3x3 TBN, Texture2D tex, sampler s, float2 uv )
 {
-    float3 normal = tex.Sample( s, uv ).xyz;
-    normal = ExpandNormal( normal );
+    // Normal maps may be compressed to two channels (BC5) so the Z component
+    // is reconstructed from the X and Y components.
+    float3 normal = ExpandNormal( float3( tex.Sample( s, uv ).xy, 0 ) );
+    normal.z = sqrt( saturate( 1.0f - dot( normal.xy, normal.xy ) ) );
 
     // Transform normal from tangent space to view space.
     normal = mul( normal, TBN );
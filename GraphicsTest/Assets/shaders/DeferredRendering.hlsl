@@ -227,12 +227,4 @@ float4 PS_DebugStencilTexture( VertexShaderOutput IN ) : SV_Target
     //return float4( IN.texCoord, 0, 1 );
     //return DebugTexture.SampleLevel( LinearRepeatSampler, IN.texCoord, 0 );
     return float4( 0, 1, 0, 1 );
-}
-
-uint PS_LightPicking( VertexShaderOutput IN ) : SV_Target
-{
-    // Only output the index of the light.
-    // The index is in the range 1...maxlights because 0 is the clear color
-    // and can't be used as a light index.
-    return LightIndex + 1;
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "CommonInclude.hlsl"
 
-VertexShaderOutput VS_main( AppData IN )
+VertexShaderOutput VS_main( AppData appData )
 {
+    VertexAttributes IN = DecodeAppData( appData );
     VertexShaderOutput OUT;
 
     OUT.position = mul( ModelViewProjection, float4( IN.position, 1.0f ) );
@@ -16,6 +17,48 @@ VertexShaderOutput VS_main( AppData IN )
     return OUT;
 }
 
+// Same as VS_main but the matrices are read from the instance buffer.
+VertexShaderOutput VS_instanced( AppData appData, uint instanceID : SV_InstanceID )
+{
+    VertexAttributes IN = DecodeAppData( appData );
+    VertexShaderOutput OUT;
+
+    InstanceData instance = Instances[FirstInstance + instanceID];
+
+    OUT.position = mul( instance.ModelViewProjection, float4( IN.position, 1.0f ) );
+
+    OUT.positionVS = mul( instance.ModelView, float4( IN.position, 1.0f ) ).xyz;
+    OUT.tangentVS = mul( ( float3x3 )instance.ModelView, IN.tangent );
+    OUT.binormalVS = mul( ( float3x3 )instance.ModelView, IN.binormal );
+    OUT.normalVS = mul( ( float3x3 )instance.ModelView, IN.normal );
+
+    OUT.texCoord = IN.texCoord;
+
+    return OUT;
+}
+
+struct LightVertexShaderOutput
+{
+    float3 normalVS     : NORMAL;       // View space normal.
+    float4 color        : COLOR;        // Light color and opacity.
+    float4 position     : SV_POSITION;  // Clip space position.
+};
+
+// Vertex shader for rendering lights (debug) using instancing.
+LightVertexShaderOutput VS_light_instanced( AppData appData, uint instanceID : SV_InstanceID )
+{
+    VertexAttributes IN = DecodeAppData( appData );
+    LightVertexShaderOutput OUT;
+
+    InstanceData instance = Instances[FirstInstance + instanceID];
+
+    OUT.position = mul( instance.ModelViewProjection, float4( IN.position, 1.0f ) );
+    OUT.normalVS = mul( ( float3x3 )instance.ModelView, IN.normal );
+    OUT.color = LightColors[FirstInstance + instanceID];
+
+    return OUT;
+}
+
 [earlydepthstencil]
 float4 PS_main( VertexShaderOutput IN ) : SV_TARGET
 {
@@ -145,6 +188,14 @@ float4 PS_light( VertexShaderOutput IN ) : SV_TARGET
     return float4( ( Mat.DiffuseColor * saturate(N.z) ).rgb, Mat.Opacity );
 }
 
+// Pixel shader for rendering lights (debug) using instancing.
+float4 PS_light_instanced( LightVertexShaderOutput IN ) : SV_TARGET
+{
+    float4 N = normalize( float4( IN.normalVS, 0 ) );
+
+    return float4( ( IN.color * saturate(N.z) ).rgb, IN.color.a );
+}
+
 // Used for rendering unlit materials.
 float4 PS_unlit( VertexShaderOutput IN ) : SV_Target
 {
@@ -167,7 +218,7 @@ float4 PS_unlit( VertexShaderOutput IN ) : SV_Target
     if ( Mat.HasOpacityTexture )
     {
         // If the material has an opacity texture, use that to override the diffuse alpha.
-        alpha = OpacityTexture.Sample( LinearRepeatSampler, IN.texCoord ).a;
+        alpha = OpacityTexture.Sample( LinearRepeatSampler, IN.texCoord ).r;
     }
 
     if ( alpha * Mat.Opacity < Mat.AlphaThreshold )
@@ -21,6 +21,9 @@ public:
     virtual void Render( RenderEventArgs& e ) = 0;
     virtual void PostRender( RenderEventArgs& e );
 
+    // Passes that don't declare any resources rely on the device to track the resources they access.
+    virtual void DeclareResources( ResourceStateTracker& stateTracker );
+
     // Inherited from Visitor
     virtual void Visit( Scene& scene );
     virtual void Visit( SceneNode& node );
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <DrawList.h>
+#include <RenderQueue.h>
+
 #include "AbstractPass.h"
 
 class RenderDevice;
@@ -9,15 +12,22 @@ class Camera;
 class Scene;
 class PipelineState;
 class Query;
+class StructuredBuffer;
+class LodSelector;
+class ClusterCuller;
+class ConstantBufferRing;
+class CommandList;
+class JobSystem;
 
 // Base pass provides implementations for functions used by most passes.
-class BasePass : public AbstractPass
+// A base pass with a render queue can be added to a DrawListBuilder which fills its render queue.
+class BasePass : public AbstractPass, public DrawList
 {
 public:
     typedef AbstractPass base;
 
-    BasePass();
-    BasePass( std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline );
+    BasePass( RenderDevice& renderDevice );
+    BasePass( RenderDevice& renderDevice, std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline );
     virtual ~BasePass();
 
     // Render the pass. This should only be called by the RenderTechnique.
@@ -30,13 +40,76 @@ public:
     virtual void Visit( SceneNode& node );
     virtual void Visit( Mesh& mesh );
 
+    // Returns true if the mesh should be rendered by this pass.
+    // This function may be called from multiple threads at the same time.
+    virtual bool FilterMesh( Mesh& mesh, const glm::mat4& modelViewProjection );
+
+    virtual std::shared_ptr<PipelineState> GetPipelineState() const;
+
+    // Use a render queue to sort the meshes that are rendered by this pass.
+    // Without a render queue (nullptr), each mesh is drawn as soon as it is visited.
+    void SetRenderQueue( std::shared_ptr<RenderQueue> renderQueue );
+    // If the pass has a render queue, meshes are sorted before they are drawn.
+    virtual std::shared_ptr<RenderQueue> GetRenderQueue() const;
+    // Set to true if the render queue has been filled for the current frame
+    // (for example, by the DrawListBuilder). The pass will not traverse the scene
+    // but only render the meshes in the render queue.
+    virtual void SetRenderQueueBuilt( bool renderQueueBuilt );
+
+    // Select the level of detail of the meshes that are rendered by this pass.
+    // Without a LOD selector, the full detail meshes are rendered.
+    void SetLodSelector( std::shared_ptr<LodSelector> lodSelector );
+    std::shared_ptr<LodSelector> GetLodSelector() const;
+
+    // Cull the meshlets of the meshes in the render queue before they are drawn.
+    // Only meshes that are drawn from the render queue are cluster culled.
+    void SetClusterCuller( std::shared_ptr<ClusterCuller> clusterCuller );
+    std::shared_ptr<ClusterCuller> GetClusterCuller() const;
+
+    // Record the meshes in the render queue into command lists on the worker threads
+    // of the job system. The render queue is split into one command list per thread
+    // (but at least minItemsPerCommandList items per command list) and the command lists
+    // are executed in the order of the render queue. Set the job system to nullptr
+    // (or use a render device without command lists) to draw on the calling thread.
+    void SetJobSystem( JobSystem* jobSystem, uint32_t minItemsPerCommandList = 256 );
+    JobSystem* GetJobSystem() const;
+    // The number of command lists that were executed for the last frame (0 if the meshes were drawn on the calling thread).
+    uint32_t GetNumCommandLists() const;
+
+    // Allocate the per object data from a constant buffer ring (by default the ring of the render device).
+    // Set to nullptr to update the per object constant buffer for every draw call.
+    void SetConstantBufferRing( ConstantBufferRing* constantBufferRing );
+    ConstantBufferRing* GetConstantBufferRing() const;
+
+    // The number of draw calls, state changes (material and mesh buffer bindings)
+    // and triangles since the last time the render statistics were reset.
+    uint32_t GetNumDrawCalls() const;
+    uint32_t GetNumStateChanges() const;
+    uint32_t GetNumTriangles() const;
+    void ResetRenderStatistics();
+
 protected:
     // PerObject constant buffer data.
-    __declspec( align( 16 ) ) struct PerObject
+    struct alignas( 16 ) PerObject
+    {
+        PerObject()
+            : FirstInstance( 0 )
+        {}
+
+        glm::mat4 ModelViewProjection;
+        glm::mat4 ModelView;
+        // The index of the first instance of an instanced draw call in the instance buffer.
+        uint32_t FirstInstance;
+    };
+
+    // Per instance data for instanced rendering.
+    // This must match the InstanceData struct in CommonInclude.hlsl
+    struct alignas( 16 ) InstanceData
     {
         glm::mat4 ModelViewProjection;
         glm::mat4 ModelView;
     };
+    typedef std::vector<InstanceData> InstanceDataList;
 
     void SetRenderEventArgs( RenderEventArgs& e );
     RenderEventArgs& GetRenderEventArgs() const;
@@ -44,14 +117,102 @@ protected:
     RenderDevice& GetRenderDevice() const;
 
     // Set and bind the constant buffer data.
+    // If the render device has a constant buffer ring, the data is allocated from the ring
+    // and bound to the vertex shader of the current pipeline state.
     void SetPerObjectConstantBufferData( PerObject& perObjectData );
+    // The per object data that was last set with SetPerObjectConstantBufferData.
+    const PerObject& GetPerObjectData() const;
     // Bind the constant to the shader.
     void BindPerObjectConstantBuffer( std::shared_ptr<Shader> shader );
 
+    // Render the mesh using the current per object data.
+    // If the pass has a render queue, the mesh is added to the queue and
+    // rendered after the scene has been traversed.
+    void SubmitMesh( Mesh& mesh, uint32_t lod = 0 );
+    // Draw all of the meshes in the render queue (in sorted order).
+    // Consecutive items that use the same mesh are drawn with a single instanced draw call.
+    void RenderQueuedMeshes( RenderEventArgs& e );
+
+    // Upload the per instance data and bind it to the "Instances" parameter
+    // of the vertex shader of the current pipeline state.
+    void BindInstanceData( const InstanceDataList& instanceData );
+
 private:
+    // Consecutive items of the render queue that use the same mesh (and level of detail)
+    // and are drawn with a single instanced draw call.
+    struct DrawGroup
+    {
+        size_t FirstItem;
+        // The index of the instance of the first item in the instance buffer of the pass (or chunk).
+        uint32_t FirstInstance;
+        uint32_t NumInstances;
+    };
+    typedef std::vector<DrawGroup> DrawGroupList;
+
+    // A range of the render queue that is recorded into a command list.
+    // Each command list has its own per object and instance buffers because
+    // the command lists are recorded at the same time.
+    struct CommandListChunk
+    {
+        std::shared_ptr< ::CommandList > CommandList;
+        std::shared_ptr<ConstantBuffer> PerObjectConstantBuffer;
+        std::shared_ptr<StructuredBuffer> InstanceBuffer;
+        InstanceDataList InstanceData;
+        DrawGroupList DrawGroups;
+
+        size_t FirstItem;
+        size_t LastItem;
+
+        uint32_t NumDrawCalls;
+        uint32_t NumStateChanges;
+        uint32_t NumTriangles;
+    };
+    typedef std::vector<CommandListChunk> CommandListChunkList;
+
+    // Draw the items [beginItem, endItem) of the render queue.
+    // The instances of all items are uploaded to the instance buffer at once and each group
+    // of instances reads its instances starting at the FirstInstance of its per object data.
+    // With a constant buffer ring, the per object data of all groups is written to the ring
+    // at once as well, so there is no map per draw call.
+    // If chunk is not nullptr, the buffers of the chunk are used to draw the items.
+    void DrawQueuedMeshes( RenderEventArgs& e, size_t beginItem, size_t endItem, bool clusterCulling, CommandListChunk* chunk );
+    // Split the render queue into chunks, record the chunks on the worker threads and execute them in order.
+    void RecordQueuedMeshes( RenderEventArgs& e, bool clusterCulling );
+    // Grow the instance buffer to the next power of 2 that fits numInstances instances.
+    // Instance buffers are only created on the thread that owns the render device.
+    void ReserveInstanceBuffer( std::shared_ptr<StructuredBuffer>& instanceBuffer, unsigned int numInstances );
+
 
     PerObject* m_PerObjectData;
     std::shared_ptr<ConstantBuffer> m_PerObjectConstantBuffer;
+    // Not owned by the pass (nullptr if the render device doesn't have one).
+    ConstantBufferRing* m_pConstantBufferRing;
+
+    // The instance buffer grows to fit the instances of the largest render queue.
+    std::shared_ptr<StructuredBuffer> m_InstanceBuffer;
+    // Scratch lists used to gather the instances and draw calls of the queued meshes.
+    InstanceDataList m_InstanceData;
+    DrawGroupList m_DrawGroups;
+    // The per object data of each draw group, one ConstantBufferRing::Alignment sized block per group.
+    std::vector<uint8_t> m_PerObjectBlocks;
+
+    std::shared_ptr<RenderQueue> m_RenderQueue;
+    bool m_RenderQueueBuilt;
+    uint32_t m_NumDrawCalls;
+    uint32_t m_NumStateChanges;
+    uint32_t m_NumTriangles;
+
+    JobSystem* m_pJobSystem;
+    uint32_t m_MinItemsPerCommandList;
+    CommandListChunkList m_CommandListChunks;
+    uint32_t m_NumCommandLists;
+
+    std::shared_ptr<LodSelector> m_LodSelector;
+    std::shared_ptr<ClusterCuller> m_ClusterCuller;
+    // The scene node that is currently being visited and the index
+    // of the next mesh of that node (used to select the level of detail).
+    SceneNode* m_pCurrentNode;
+    uint32_t m_CurrentMeshIndex;
 
     RenderEventArgs* m_pRenderEventArgs;
 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <RenderQueue.h>
+
+class Buffer;
+class Camera;
+class RenderDevice;
+
+// Cluster culling on the CPU.
+// The meshlets of the meshes in a render queue are tested against the view frustum
+// and their normal cones (to skip meshlets that are completely back facing).
+// The indices of the visible meshlets are copied into a single compacted index buffer
+// that is uploaded once per pass and drawn instead of the index buffers of the meshes.
+// Since the meshes in the render queue have already passed whole mesh culling,
+// the number of triangles before and after cluster culling shows how many
+// triangles are saved by culling at a finer granularity.
+// Each pass needs its own cluster culler because the compacted index buffer
+// is built from the render queue of the pass.
+class ClusterCuller
+{
+public:
+    ClusterCuller( RenderDevice& renderDevice );
+    virtual ~ClusterCuller();
+
+    void SetEnabled( bool enabled );
+    bool IsEnabled() const;
+
+    // Cull the meshlets of the render items in a sorted render queue and upload the indices of
+    // the visible meshlets to the compacted index buffer. Only render items that are drawn
+    // as a single instance of the full detail mesh are culled (instanced draw calls share
+    // the index buffer of the mesh).
+    // @param backfaceCulling Only cull back facing meshlets if back faces are culled by the pipeline.
+    void Cull( const RenderQueue& renderQueue, Camera& camera, bool backfaceCulling );
+
+    // The range of the compacted index buffer that should be drawn for a render item.
+    // Returns false if the render item was not culled (the mesh should be drawn as usual).
+    // @param renderItem The index of the render item in sorted order.
+    bool GetIndexRange( size_t renderItem, uint32_t& firstIndex, uint32_t& numIndices ) const;
+    std::shared_ptr<Buffer> GetIndexBuffer() const;
+
+    // Statistics for the last call to Cull.
+    // The number of triangles of the culled render items and the number of triangles of the visible meshlets.
+    uint32_t GetNumTrianglesTested() const;
+    uint32_t GetNumTrianglesVisible() const;
+    uint32_t GetNumMeshletsTested() const;
+    uint32_t GetNumMeshletsCulled() const;
+
+private:
+    struct IndexRange
+    {
+        uint32_t FirstIndex;
+        uint32_t NumIndices;
+    };
+    typedef std::vector<IndexRange> IndexRangeList;
+
+    bool m_Enabled;
+
+    // The index range of each render item in sorted order.
+    IndexRangeList m_IndexRanges;
+    // The indices of the visible meshlets of all render items.
+    std::vector<uint32_t> m_Indices;
+    // The compacted index buffer grows to fit the largest number of visible indices.
+    std::shared_ptr<Buffer> m_IndexBuffer;
+    // A copy of the indices in the compacted index buffer,
+    // so only the range of indices that changed since the last pass is uploaded.
+    std::vector<uint32_t> m_UploadedIndices;
+
+    uint32_t m_NumTrianglesTested;
+    uint32_t m_NumTrianglesVisible;
+    uint32_t m_NumMeshletsTested;
+    uint32_t m_NumMeshletsCulled;
+
+    RenderDevice& m_RenderDevice;
+};
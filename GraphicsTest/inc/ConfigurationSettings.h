@@ -19,6 +19,8 @@ public:
 
     std::string SceneFileName;
     float       SceneScaleFactor;
+    // Store the vertices of the scene in the compact quantized vertex format.
+    bool        QuantizeSceneVertices;
 
     glm::vec3   CameraPosition;
     glm::quat   CameraRotation;
@@ -66,4 +68,4 @@ private:
 
 #include "ConfigurationSettings.inl"
 
-BOOST_CLASS_VERSION( ConfigurationSettings, 6 );
+BOOST_CLASS_VERSION( ConfigurationSettings, 7 );
@@ -50,4 +50,8 @@ void ConfigurationSettings::serialize( Archive& ar, const unsigned int version )
     {
         ar & BOOST_SERIALIZATION_NVP( LightGenerationMethod );
     }
+    if ( version > 6 )
+    {
+        ar & BOOST_SERIALIZATION_NVP( QuantizeSceneVertices );
+    }
 }
\ No newline at end of file
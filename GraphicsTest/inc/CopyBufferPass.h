@@ -18,6 +18,9 @@ public:
 
     virtual void Render( RenderEventArgs& e );
 
+    // The source is read and the destination is written by a copy.
+    virtual void DeclareResources( ResourceStateTracker& stateTracker );
+
 private:
     std::shared_ptr<Buffer> m_SourceBuffer;
     std::shared_ptr<Buffer> m_DestinationBuffer;
@@ -17,6 +17,9 @@ public:
 
     virtual void Render( RenderEventArgs& e );
 
+    // The source is read and the destination is written by a copy.
+    virtual void DeclareResources( ResourceStateTracker& stateTracker );
+
 private:
     std::shared_ptr<Texture> m_SourceTexture;
     std::shared_ptr<Texture> m_DestinationTexture;
@@ -12,7 +12,8 @@ class DeferredLightingPass : public BasePass
 public:
     typedef BasePass base;
 
-    DeferredLightingPass( std::vector<Light>& lights,
+    DeferredLightingPass( RenderDevice& renderDevice,
+                          std::vector<Light>& lights,
                           std::shared_ptr<Scene> pointLight,
                           std::shared_ptr<Scene> spotLight,
                           std::shared_ptr<PipelineState> lightPipeline0,
@@ -14,12 +14,15 @@
 #include <streambuf>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <queue>
 #include <ctime>
 #include <algorithm>
 #include <random>
 #include <atomic>
 #include <mutex>
 #include <thread>
+#include <condition_variable>
 #include <functional>
 
 
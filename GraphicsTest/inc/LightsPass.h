@@ -10,7 +10,7 @@ class LightsPass : public BasePass
 public:
     typedef BasePass base;
 
-    LightsPass( std::vector<Light>& lights, std::shared_ptr<Scene> pointLight, std::shared_ptr<Scene> spotLight, std::shared_ptr<Scene> directionalLight, std::shared_ptr<PipelineState> pipeline );
+    LightsPass( RenderDevice& renderDevice, std::vector<Light>& lights, std::shared_ptr<Scene> pointLight, std::shared_ptr<Scene> spotLight, std::shared_ptr<Scene> directionalLight, std::shared_ptr<PipelineState> pipeline );
     virtual ~LightsPass();
 
     // Render the pass. This should only be called by the RenderTechnique.
@@ -22,15 +22,18 @@ public:
     virtual void Visit( SceneNode& node );
     virtual void Visit( Mesh& mesh );
 
-protected:
-    const Light* GetCurrentLight();
-    const uint32_t GetCurrentLightIndex();
-
 private:
     std::vector<Light>& m_Lights;
-    // The light we are currently rendering.
-    Light* m_pCurrentLight;
-    uint32_t m_uiLightIndex;
+
+    // The model matrices and colors of the lights of the type we are currently rendering.
+    // All lights of the same type are rendered with a single instanced draw call.
+    std::vector<glm::mat4> m_LightTransforms;
+    std::vector<glm::vec4> m_LightColors;
+    // The instance data for the current node.
+    InstanceDataList m_InstanceData;
+    // The colors of the instances are only used by the lights
+    // so they are stored in a separate buffer.
+    std::shared_ptr<StructuredBuffer> m_LightColorBuffer;
 
     RenderDevice& m_RenderDevice;
 
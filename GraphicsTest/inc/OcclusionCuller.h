@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Visitor.h>
+#include <DepthRasterizer.h>
+
+class Scene;
+class Camera;
+class BoundingBox;
+
+// Software occlusion culling.
+// The occluder geometry of the meshes in the scene is rasterized on the CPU into
+// a low resolution hierarchical depth buffer at the beginning of the frame.
+// Render passes can then test the bounding boxes of meshes against the depth
+// buffer to skip meshes that are hidden behind the occluders.
+class OcclusionCuller : public Visitor
+{
+public:
+    typedef Visitor base;
+
+    OcclusionCuller( std::shared_ptr<Scene> scene, uint32_t width = 256, uint32_t height = 128 );
+    virtual ~OcclusionCuller();
+
+    void SetEnabled( bool enabled );
+    bool IsEnabled() const;
+
+    // Rasterize the occluders in the scene from the point of view of the camera.
+    // This should be called once per frame before any passes test for visibility.
+    void Update( Camera& camera );
+
+    // Rasterize the occluders even if occlusion culling is disabled
+    // (for example, to test a point against the scene with IsPointOccluded).
+    void Rasterize( Camera& camera );
+
+    // Test if a bounding box is visible.
+    // Always returns true if occlusion culling is disabled.
+    // @param boundingBox The (object space) bounding box of the mesh.
+    // @param modelViewProjection The matrix that transforms the bounding box to clip space.
+    // @param updateStatistics Count the test in the statistics of the current frame.
+    bool IsVisible( const BoundingBox& boundingBox, const glm::mat4& modelViewProjection, bool updateStatistics = true );
+
+    // Test if a point (in world space) is hidden behind the occluders that were rasterized last.
+    bool IsPointOccluded( const glm::vec3& point ) const;
+
+    // Statistics for the current frame.
+    uint32_t GetNumOccluderTriangles() const;
+    uint32_t GetNumMeshesTested() const;
+    uint32_t GetNumMeshesCulled() const;
+
+    const DepthRasterizer& GetDepthRasterizer() const;
+
+    // Inherited from Visitor
+    virtual void Visit( Scene& scene );
+    virtual void Visit( SceneNode& node );
+    virtual void Visit( Mesh& mesh );
+
+private:
+    std::shared_ptr<Scene> m_Scene;
+    DepthRasterizer m_DepthRasterizer;
+
+    bool m_Enabled;
+
+    // The view projection matrix of the camera while rasterizing the occluders.
+    glm::mat4 m_ViewProjectionMatrix;
+    // The model view projection matrix of the scene node that is currently being visited.
+    glm::mat4 m_ModelViewProjectionMatrix;
+
+    // Visibility tests can be performed from multiple threads.
+    uint32_t m_NumOccluderTriangles;
+    std::atomic<uint32_t> m_NumMeshesTested;
+    std::atomic<uint32_t> m_NumMeshesCulled;
+};
@@ -2,18 +2,28 @@
 
 #include "BasePass.h"
 
+class OcclusionCuller;
+
 // A pass that renders the opaque geometry in the scene.
 class OpaquePass : public BasePass
 {
 public:
     typedef BasePass base;
 
-    OpaquePass( std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline );
+    OpaquePass( RenderDevice& renderDevice, std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline );
     virtual ~OpaquePass();
 
-    virtual void Visit( Mesh& mesh );
+    // Meshes that are occluded (according to the occlusion culler) are not rendered.
+    // A pass that tests the same meshes as a previous pass in the frame (for example the opaque
+    // pass after a depth prepass) should not update the statistics, so each mesh is counted once.
+    void SetOcclusionCuller( std::shared_ptr<OcclusionCuller> occlusionCuller, bool updateStatistics = true );
+
+    // Only opaque meshes that are not occluded are rendered.
+    virtual bool FilterMesh( Mesh& mesh, const glm::mat4& modelViewProjection );
 
 protected:
 
 private:
+    std::shared_ptr<OcclusionCuller> m_OcclusionCuller;
+    bool m_bUpdateOcclusionStatistics;
 };
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Texture.h>
+
+#include "RenderTechnique.h"
+
+class TransientTexturePool;
+class ResourceStateTracker;
+
+// A render technique whose passes declare the resources they read and write.
+// From the declared resources, the render graph:
+//  - Derives the dependencies between the passes and executes the passes in
+//    a topological order of these dependencies (passes without dependencies
+//    between them are executed in the order they were added).
+//  - Culls the passes whose outputs are not used. A pass is only rendered if it
+//    is enabled and it writes an imported resource or a transient texture that is
+//    read by a pass that is rendered. Passes that don't write any resources
+//    (for example queries) are never culled.
+//  - Allocates the transient textures from a pool of textures that is shared
+//    with other render graphs. Transient textures whose lifetimes don't overlap
+//    share the same texture.
+//  - Declares the transient textures that a pass reads (as shader resources) and writes
+//    (as render targets, depth/stencil buffers or unordered access views) to the
+//    resource state tracker of the device before the pass is rendered, unless
+//    the pass declares them in another state itself.
+// Passes that use transient textures are added with a factory function that
+// creates the pass once the textures of the render graph have been allocated.
+class RenderGraph : public RenderTechnique
+{
+public:
+    typedef RenderTechnique base;
+
+    typedef uint32_t ResourceHandle;
+    typedef std::function< std::shared_ptr<RenderPass>( void ) > PassFactory;
+
+    // Used to declare the resources that are accessed by a pass.
+    class PassBuilder
+    {
+    public:
+        PassBuilder& Read( ResourceHandle resource );
+        PassBuilder& Write( ResourceHandle resource );
+
+    private:
+        friend class RenderGraph;
+        PassBuilder( RenderGraph& renderGraph, uint32_t passIndex );
+
+        RenderGraph& m_RenderGraph;
+        uint32_t m_PassIndex;
+    };
+
+    RenderGraph();
+    virtual ~RenderGraph();
+
+    // Import a resource that is not owned by the render graph (for example the back buffer).
+    // Passes that write to an imported resource are not culled.
+    ResourceHandle ImportResource( const std::string& name );
+    // Create a window sized transient texture. Transient textures are only valid
+    // during the passes that access them.
+    ResourceHandle CreateTexture( const std::string& name, const Texture::TextureFormat& format, bool uav = false );
+
+    // Add a pass to the render graph.
+    PassBuilder AddPass( const std::string& name, std::shared_ptr<RenderPass> pass );
+    // Add a pass that is created by the factory function when the passes are created.
+    PassBuilder AddPass( const std::string& name, PassFactory factory );
+
+    // Inherited from RenderTechnique
+    // Add a pass that does not access any resources.
+    virtual unsigned int AddPass( std::shared_ptr<RenderPass> pass );
+    virtual std::shared_ptr<RenderPass> GetPass( unsigned int ID ) const;
+
+    // Order the passes, cull the passes that are never used and acquire the transient textures from the pool.
+    // All render graphs that share a pool should be compiled before the passes of any render graph are created.
+    void Compile( TransientTexturePool& transientTexturePool );
+    // Create the passes that were added with a factory function.
+    void CreatePasses();
+
+    // Get the texture of a transient resource (only valid after the render graph has been compiled).
+    std::shared_ptr<Texture> GetTexture( ResourceHandle resource ) const;
+
+    // Write the passes and the transient memory of the render graph to the debug output.
+    void Report( const std::string& name ) const;
+
+    // Inherited from RenderTechnique
+    virtual void Render( RenderEventArgs& renderEventArgs );
+
+private:
+    struct Resource
+    {
+        std::string Name;
+        bool Imported;
+        Texture::TextureFormat Format;
+        bool UAV;
+        // The range of passes in the schedule that access the resource.
+        uint32_t FirstPass;
+        uint32_t LastPass;
+        // The index of the texture in the transient texture pool.
+        uint32_t PoolIndex;
+    };
+    typedef std::vector<Resource> ResourceList;
+    typedef std::vector<ResourceHandle> ResourceHandleList;
+
+    struct PassNode
+    {
+        std::string Name;
+        std::shared_ptr<RenderPass> Pass;
+        PassFactory Factory;
+        ResourceHandleList Reads;
+        ResourceHandleList Writes;
+        // The passes that must be executed before this pass.
+        std::vector<uint32_t> Dependencies;
+    };
+    typedef std::vector<PassNode> PassNodeList;
+
+    // Determine which of the passes in the schedule are culled.
+    // If onlyEnabled is true, disabled passes are also culled.
+    void CullPasses( bool onlyEnabled, std::vector<bool>& culled ) const;
+
+    // Declare the transient textures that are accessed by a pass
+    // (the pass declares the other resources it accesses itself).
+    // Transient textures that the pass has already declared (for example
+    // the destination of a copy) keep the state the pass declared.
+    void DeclareResources( const PassNode& passNode, ResourceStateTracker& stateTracker ) const;
+
+    ResourceList m_Resources;
+    PassNodeList m_Passes;
+
+    // The indices of the passes in the order they are executed.
+    std::vector<uint32_t> m_Schedule;
+    std::vector<bool> m_Culled;
+
+    TransientTexturePool* m_pTransientTexturePool;
+    bool m_bCompiled;
+};
@@ -6,6 +6,7 @@ class RenderEventArgs;
 class Scene;
 class SceneNode;
 class Mesh;
+class ResourceStateTracker;
 
 // A render pass describes a single pass to render a scene.
 // This could include opaque pass, transparent pass,
@@ -26,6 +27,11 @@ public:
     virtual void Render( RenderEventArgs& e ) = 0;
     virtual void PostRender( RenderEventArgs& e ) = 0;
 
+    // Declare the resources that are read and written by the pass.
+    // The technique declares the resources before the pass is rendered
+    // (only if the render device transitions resources between states).
+    virtual void DeclareResources( ResourceStateTracker& stateTracker ) = 0;
+
     // Inherited from Visitor
     virtual void Visit( Scene& scene ) = 0;
     virtual void Visit( SceneNode& node ) = 0;
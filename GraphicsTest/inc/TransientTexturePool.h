@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Texture.h>
+
+class RenderDevice;
+
+// A pool of window sized textures for the transient resources of render graphs.
+// A texture is shared by transient resources with the same format whose lifetimes
+// (the range of passes that use the resource) do not overlap.
+// The lifetimes of different owners never overlap because only one render graph is
+// rendered per frame, so an owner can always reuse the textures of another owner.
+// The textures are only created when they are first requested. If all owners acquire
+// their textures before any texture is requested, a texture that is shared with a
+// resource that requires unordered access is created with unordered access.
+class TransientTexturePool
+{
+public:
+    TransientTexturePool( RenderDevice& renderDevice, uint16_t width, uint16_t height );
+    virtual ~TransientTexturePool();
+
+    // Acquire a texture that is used by the passes [firstPass .. lastPass] of the owner.
+    // Returns the index of the texture in the pool.
+    uint32_t Acquire( const void* owner, const Texture::TextureFormat& format, bool uav, uint32_t firstPass, uint32_t lastPass );
+    // Release the textures that have been acquired by the owner.
+    // The textures are kept in the pool so they can be acquired again.
+    void Release( const void* owner );
+
+    // Get a texture from the pool (the texture is created if it does not exist yet).
+    std::shared_ptr<Texture> GetTexture( uint32_t index );
+
+    // Resize all of the textures in the pool.
+    void Resize( uint16_t width, uint16_t height );
+
+    // The size (in bytes) of a texture with the given format.
+    size_t GetTextureSize( const Texture::TextureFormat& format ) const;
+    // The total size (in bytes) of the textures in the pool.
+    size_t GetAllocatedSize() const;
+    uint32_t GetNumTextures() const;
+
+    // The device that creates the textures of the pool.
+    RenderDevice& GetRenderDevice() const;
+
+private:
+    struct Lifetime
+    {
+        const void* Owner;
+        uint32_t FirstPass;
+        uint32_t LastPass;
+    };
+    typedef std::vector<Lifetime> LifetimeList;
+
+    struct PooledTexture
+    {
+        Texture::TextureFormat Format;
+        bool UAV;
+        std::shared_ptr<Texture> pTexture;
+        LifetimeList Lifetimes;
+    };
+    typedef std::vector<PooledTexture> TextureList;
+
+    RenderDevice& m_RenderDevice;
+    uint16_t m_Width;
+    uint16_t m_Height;
+
+    TextureList m_Textures;
+};
@@ -7,10 +7,11 @@ class TransparentPass : public BasePass
 public:
     typedef BasePass base;
 
-    TransparentPass( std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline );
+    TransparentPass( RenderDevice& renderDevice, std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline );
     virtual ~TransparentPass();
 
-    virtual void Visit( Mesh& mesh );
+    // Only transparent meshes are rendered.
+    virtual bool FilterMesh( Mesh& mesh, const glm::mat4& modelViewProjection );
 
 protected:
 
@@ -32,6 +32,9 @@ void AbstractPass::Render( RenderEventArgs& e )
 void AbstractPass::PostRender( RenderEventArgs& e )
 {}
 
+void AbstractPass::DeclareResources( ResourceStateTracker& stateTracker )
+{}
+
 // Inherited from Visitor
 void AbstractPass::Visit( Scene& scene )
 {}
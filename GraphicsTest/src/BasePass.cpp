@@ -1,6 +1,5 @@
 #include <GraphicsTestPCH.h>
 
-#include <Application.h>
 #include <RenderDevice.h>
 #include <Scene.h>
 #include <SceneNode.h>
@@ -11,43 +10,111 @@
 #include <ShaderParameter.h>
 #include <Camera.h>
 #include <ConstantBuffer.h>
+#include <StructuredBuffer.h>
+#include <ConstantBufferRing.h>
+#include <RasterizerState.h>
+#include <CommandList.h>
+#include <JobSystem.h>
 
+#include <LodSelector.h>
+#include <ClusterCuller.h>
 #include <BasePass.h>
 
-BasePass::BasePass()
+// The minimum number of instances the instance buffer can hold.
+#define MIN_INSTANCE_BUFFER_SIZE 64
+// The maximum number of draw groups whose per object data is written to the constant buffer ring at once.
+#define MAX_GROUPS_PER_RING_ALLOCATION 4096
+
+static const ShaderParameterID gs_PerObjectID( "PerObject" );
+static const ShaderParameterID gs_InstancesID( "Instances" );
+
+BasePass::BasePass( RenderDevice& renderDevice )
     : m_pRenderEventArgs( nullptr )
-    , m_RenderDevice( Application::Get().GetRenderDevice() )
+    , m_RenderQueueBuilt( false )
+    , m_NumDrawCalls( 0 )
+    , m_NumStateChanges( 0 )
+    , m_NumTriangles( 0 )
+    , m_pJobSystem( nullptr )
+    , m_MinItemsPerCommandList( 256 )
+    , m_NumCommandLists( 0 )
+    , m_pCurrentNode( nullptr )
+    , m_CurrentMeshIndex( 0 )
+    , m_RenderDevice( renderDevice )
 {
     m_PerObjectData = (PerObject*)_aligned_malloc( sizeof( PerObject ), 16 );
     m_PerObjectConstantBuffer = m_RenderDevice.CreateConstantBuffer( PerObject() );
+    m_pConstantBufferRing = m_RenderDevice.GetConstantBufferRing();
 }
 
-BasePass::BasePass( std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline )
+BasePass::BasePass( RenderDevice& renderDevice, std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline )
     : m_pRenderEventArgs( nullptr )
+    , m_RenderQueueBuilt( false )
+    , m_NumDrawCalls( 0 )
+    , m_NumStateChanges( 0 )
+    , m_NumTriangles( 0 )
+    , m_pJobSystem( nullptr )
+    , m_MinItemsPerCommandList( 256 )
+    , m_NumCommandLists( 0 )
+    , m_pCurrentNode( nullptr )
+    , m_CurrentMeshIndex( 0 )
     , m_Scene( scene )
     , m_Pipeline( pipeline )
-    , m_RenderDevice( Application::Get().GetRenderDevice() )
+    , m_RenderDevice( renderDevice )
 {
     m_PerObjectData = (PerObject*)_aligned_malloc( sizeof( PerObject ), 16 );
     m_PerObjectConstantBuffer = m_RenderDevice.CreateConstantBuffer( PerObject() );
+    m_pConstantBufferRing = m_RenderDevice.GetConstantBufferRing();
 }
 
 BasePass::~BasePass()
 {
     _aligned_free( m_PerObjectData );
     m_RenderDevice.DestroyConstantBuffer( m_PerObjectConstantBuffer );
+    if ( m_InstanceBuffer )
+    {
+        m_RenderDevice.DestroyStructuredBuffer( m_InstanceBuffer );
+    }
+    for ( CommandListChunk& chunk : m_CommandListChunks )
+    {
+        m_RenderDevice.DestroyCommandList( chunk.CommandList );
+        m_RenderDevice.DestroyConstantBuffer( chunk.PerObjectConstantBuffer );
+        if ( chunk.InstanceBuffer )
+        {
+            m_RenderDevice.DestroyStructuredBuffer( chunk.InstanceBuffer );
+        }
+    }
 }
 
 void BasePass::SetPerObjectConstantBufferData( PerObject& perObjectData )
 {
+    *m_PerObjectData = perObjectData;
+
+    PipelineState* pipeline = m_pRenderEventArgs ? m_pRenderEventArgs->PipelineState : nullptr;
+    std::shared_ptr<Shader> vertexShader = pipeline ? pipeline->GetShader( Shader::VertexShader ) : nullptr;
+    if ( m_pConstantBufferRing && vertexShader )
+    {
+        // Nothing is uploaded for shaders that don't use the per object data.
+        if ( vertexShader->GetShaderParameter( gs_PerObjectID ).IsValid() )
+        {
+            ConstantBufferRing::Allocation allocation = m_pConstantBufferRing->Allocate( perObjectData );
+            m_pConstantBufferRing->Bind( allocation, *vertexShader, gs_PerObjectID );
+        }
+        return;
+    }
+
     m_PerObjectConstantBuffer->Set( perObjectData );
 }
 
+const BasePass::PerObject& BasePass::GetPerObjectData() const
+{
+    return *m_PerObjectData;
+}
+
 void BasePass::BindPerObjectConstantBuffer( std::shared_ptr<Shader> shader )
 {
     if ( shader )
     {
-        shader->GetShaderParameterByName( "PerObject" ).Set( m_PerObjectConstantBuffer );
+        shader->GetShaderParameter( gs_PerObjectID ).Set( m_PerObjectConstantBuffer );
     }
 }
 
@@ -66,10 +133,29 @@ void BasePass::PreRender( RenderEventArgs& e )
 
 void BasePass::Render( RenderEventArgs& e )
 {
+    if ( m_RenderQueue && m_RenderQueueBuilt )
+    {
+        // The render queue is already sorted.
+        RenderQueuedMeshes( e );
+        m_RenderQueueBuilt = false;
+        return;
+    }
+
+    if ( m_RenderQueue )
+    {
+        m_RenderQueue->Clear();
+    }
+
     if ( m_Scene )
     {
         m_Scene->Accept( *this );
     }
+
+    if ( m_RenderQueue )
+    {
+        m_RenderQueue->Sort();
+        RenderQueuedMeshes( e );
+    }
 }
 
 void BasePass::PostRender( RenderEventArgs& e )
@@ -88,6 +174,9 @@ void BasePass::Visit( Scene& scene )
 
 void BasePass::Visit( SceneNode& node )
 {
+    m_pCurrentNode = &node;
+    m_CurrentMeshIndex = 0;
+
     Camera* camera = GetRenderEventArgs().Camera;
     if ( camera )
     {
@@ -97,18 +186,467 @@ void BasePass::Visit( SceneNode& node )
         perObjectData.ModelView = viewMatrix * node.GetWorldTransfom();
         perObjectData.ModelViewProjection = camera->GetProjectionMatrix() * perObjectData.ModelView;
 
-        // Update the constant buffer data
-        SetPerObjectConstantBufferData( perObjectData );
+        if ( m_RenderQueue )
+        {
+            // The constant buffer is updated when the queued meshes are rendered.
+            *m_PerObjectData = perObjectData;
+        }
+        else
+        {
+            // Update the constant buffer data
+            SetPerObjectConstantBufferData( perObjectData );
+        }
     }
 }
 
 void BasePass::Visit( Mesh& mesh )
 {
-    std::shared_ptr<Material> pMaterial = mesh.GetMaterial();
-    if ( pMaterial && m_pRenderEventArgs )
+    // Meshes are visited directly after the node they belong to.
+    uint32_t lod = 0;
+    if ( m_LodSelector && m_pCurrentNode )
+    {
+        lod = m_LodSelector->SelectLod( mesh, m_PerObjectData->ModelView, m_pCurrentNode->GetMeshLod( m_CurrentMeshIndex ) );
+        m_pCurrentNode->SetMeshLod( m_CurrentMeshIndex, lod );
+    }
+    ++m_CurrentMeshIndex;
+
+    if ( m_pRenderEventArgs && FilterMesh( mesh, m_PerObjectData->ModelViewProjection ) )
+    {
+        SubmitMesh( mesh, lod );
+    }
+}
+
+bool BasePass::FilterMesh( Mesh& mesh, const glm::mat4& modelViewProjection )
+{
+    return mesh.GetMaterial() != nullptr;
+}
+
+std::shared_ptr<PipelineState> BasePass::GetPipelineState() const
+{
+    return m_Pipeline;
+}
+
+void BasePass::SetRenderQueue( std::shared_ptr<RenderQueue> renderQueue )
+{
+    m_RenderQueue = renderQueue;
+}
+
+std::shared_ptr<RenderQueue> BasePass::GetRenderQueue() const
+{
+    return m_RenderQueue;
+}
+
+void BasePass::SetRenderQueueBuilt( bool renderQueueBuilt )
+{
+    m_RenderQueueBuilt = renderQueueBuilt;
+}
+
+void BasePass::SetLodSelector( std::shared_ptr<LodSelector> lodSelector )
+{
+    m_LodSelector = lodSelector;
+}
+
+std::shared_ptr<LodSelector> BasePass::GetLodSelector() const
+{
+    return m_LodSelector;
+}
+
+void BasePass::SetClusterCuller( std::shared_ptr<ClusterCuller> clusterCuller )
+{
+    m_ClusterCuller = clusterCuller;
+}
+
+std::shared_ptr<ClusterCuller> BasePass::GetClusterCuller() const
+{
+    return m_ClusterCuller;
+}
+
+void BasePass::SetJobSystem( JobSystem* jobSystem, uint32_t minItemsPerCommandList )
+{
+    m_pJobSystem = jobSystem;
+    m_MinItemsPerCommandList = std::max<uint32_t>( minItemsPerCommandList, 1 );
+}
+
+JobSystem* BasePass::GetJobSystem() const
+{
+    return m_pJobSystem;
+}
+
+uint32_t BasePass::GetNumCommandLists() const
+{
+    return m_NumCommandLists;
+}
+
+void BasePass::SetConstantBufferRing( ConstantBufferRing* constantBufferRing )
+{
+    m_pConstantBufferRing = constantBufferRing;
+}
+
+ConstantBufferRing* BasePass::GetConstantBufferRing() const
+{
+    return m_pConstantBufferRing;
+}
+
+void BasePass::SubmitMesh( Mesh& mesh, uint32_t lod )
+{
+    RenderEventArgs& e = GetRenderEventArgs();
+    if ( m_RenderQueue )
+    {
+        m_RenderQueue->Push( e.PipelineState, mesh, m_PerObjectData->ModelViewProjection, m_PerObjectData->ModelView, lod );
+    }
+    else
+    {
+        mesh.BindBuffers( e );
+        mesh.BindMaterial( e );
+        mesh.Draw( e, 1, lod );
+        // Without a render queue, the buffers and the material are bound for every mesh.
+        m_NumDrawCalls += 1;
+        m_NumStateChanges += 2;
+        m_NumTriangles += mesh.GetNumTriangles( lod );
+    }
+}
+
+void BasePass::RenderQueuedMeshes( RenderEventArgs& e )
+{
+    // The compacted index buffer of the visible meshlets is uploaded before anything is drawn.
+    bool clusterCulling = m_ClusterCuller && e.Camera && e.PipelineState;
+    if ( clusterCulling )
+    {
+        bool backfaceCulling = e.PipelineState->GetRasterizerState().GetCullMode() == RasterizerState::CullMode::Back;
+        m_ClusterCuller->Cull( *m_RenderQueue, *e.Camera, backfaceCulling );
+    }
+
+    m_NumCommandLists = 0;
+
+    size_t numItems = m_RenderQueue->GetSize();
+    if ( m_pJobSystem && m_Pipeline && numItems >= 2 * m_MinItemsPerCommandList )
     {
-        mesh.Render( *m_pRenderEventArgs );
+        RecordQueuedMeshes( e, clusterCulling );
     }
+
+    // Draw on the calling thread if the render device doesn't support command lists.
+    if ( m_NumCommandLists == 0 )
+    {
+        DrawQueuedMeshes( e, 0, numItems, clusterCulling, nullptr );
+    }
+}
+
+void BasePass::RecordQueuedMeshes( RenderEventArgs& e, bool clusterCulling )
+{
+    size_t numItems = m_RenderQueue->GetSize();
+    size_t numChunks = std::min<size_t>( m_pJobSystem->GetNumThreads(), numItems / m_MinItemsPerCommandList );
+    if ( numChunks < 2 ) return;
+
+    while ( m_CommandListChunks.size() < numChunks )
+    {
+        CommandListChunk chunk;
+        chunk.CommandList = m_RenderDevice.CreateCommandList();
+        if ( !chunk.CommandList ) return;
+
+        chunk.PerObjectConstantBuffer = m_RenderDevice.CreateConstantBuffer( PerObject() );
+        m_CommandListChunks.push_back( chunk );
+    }
+
+    // Split the render queue into chunks of (about) the same size.
+    // A chunk never ends in the middle of a group of instances
+    // so the command lists draw exactly the same batches as a single thread.
+    size_t firstItem = 0;
+    for ( size_t c = 0; c < numChunks; ++c )
+    {
+        CommandListChunk& chunk = m_CommandListChunks[c];
+        size_t lastItem = ( c + 1 == numChunks ) ? numItems : std::max( firstItem, ( numItems * ( c + 1 ) ) / numChunks );
+        while ( lastItem > firstItem && lastItem < numItems &&
+                m_RenderQueue->GetRenderItem( lastItem ).Mesh == m_RenderQueue->GetRenderItem( lastItem - 1 ).Mesh &&
+                m_RenderQueue->GetRenderItem( lastItem ).Lod == m_RenderQueue->GetRenderItem( lastItem - 1 ).Lod )
+        {
+            ++lastItem;
+        }
+
+        chunk.FirstItem = firstItem;
+        chunk.LastItem = lastItem;
+        chunk.NumDrawCalls = 0;
+        chunk.NumStateChanges = 0;
+        chunk.NumTriangles = 0;
+
+        // Resources are only created and materials are only updated on this thread.
+        // The instance buffer of the chunk holds the instances of all of its items.
+        Material* pPreviousMaterial = nullptr;
+        for ( size_t i = firstItem; i < lastItem; ++i )
+        {
+            Material* pMaterial = m_RenderQueue->GetRenderItem( i ).Mesh->GetMaterial().get();
+            if ( pMaterial && pMaterial != pPreviousMaterial )
+            {
+                pMaterial->Update();
+                pPreviousMaterial = pMaterial;
+            }
+        }
+        if ( lastItem > firstItem )
+        {
+            ReserveInstanceBuffer( chunk.InstanceBuffer, (unsigned int)( lastItem - firstItem ) );
+        }
+
+        firstItem = lastItem;
+    }
+
+    std::shared_ptr<Shader> vertexShader = m_Pipeline->GetShader( Shader::VertexShader );
+
+    m_pJobSystem->ParallelFor( (uint32_t)numChunks, 1, [&]( uint32_t begin, uint32_t end, uint32_t threadIndex )
+    {
+        for ( uint32_t c = begin; c < end; ++c )
+        {
+            CommandListChunk& chunk = m_CommandListChunks[c];
+
+            chunk.CommandList->Begin();
+
+            // A command list starts from the default state.
+            // PreRender bound the pipeline on this thread first, so its state objects are
+            // already looked up and the worker threads only bind them.
+            m_Pipeline->Bind();
+            if ( vertexShader )
+            {
+                ShaderParameter& perObject = vertexShader->GetShaderParameter( gs_PerObjectID );
+                if ( perObject.IsValid() )
+                {
+                    perObject.BindResource<ConstantBuffer>( chunk.PerObjectConstantBuffer );
+                }
+            }
+
+            DrawQueuedMeshes( e, chunk.FirstItem, chunk.LastItem, clusterCulling, &chunk );
+
+            chunk.CommandList->End();
+        }
+    } );
+
+    // The command lists are executed in the order of the render queue.
+    for ( size_t c = 0; c < numChunks; ++c )
+    {
+        CommandListChunk& chunk = m_CommandListChunks[c];
+        chunk.CommandList->Execute();
+
+        m_NumDrawCalls += chunk.NumDrawCalls;
+        m_NumStateChanges += chunk.NumStateChanges;
+        m_NumTriangles += chunk.NumTriangles;
+    }
+
+    // Executing a command list clears the state of the device.
+    m_Pipeline->Bind();
+
+    m_NumCommandLists = (uint32_t)numChunks;
+}
+
+void BasePass::DrawQueuedMeshes( RenderEventArgs& e, size_t beginItem, size_t endItem, bool clusterCulling, CommandListChunk* chunk )
+{
+    Mesh* pPreviousMesh = nullptr;
+    Material* pPreviousMaterial = nullptr;
+
+    InstanceDataList& instanceDataList = chunk ? chunk->InstanceData : m_InstanceData;
+    DrawGroupList& drawGroups = chunk ? chunk->DrawGroups : m_DrawGroups;
+    uint32_t& numDrawCalls = chunk ? chunk->NumDrawCalls : m_NumDrawCalls;
+    uint32_t& numStateChanges = chunk ? chunk->NumStateChanges : m_NumStateChanges;
+    uint32_t& numTriangles = chunk ? chunk->NumTriangles : m_NumTriangles;
+
+    std::shared_ptr<Shader> vertexShader = e.PipelineState ? e.PipelineState->GetShader( Shader::VertexShader ) : nullptr;
+
+    // Gather the instances of all items. Consecutive items that use the same mesh (and level of detail)
+    // are drawn with a single instanced draw call. The sort key puts items with the same mesh next to each other
+    // (unless they are sorted back to front).
+    instanceDataList.clear();
+    drawGroups.clear();
+    for ( size_t i = beginItem; i < endItem; ++i )
+    {
+        const RenderQueue::RenderItem& renderItem = m_RenderQueue->GetRenderItem( i );
+        if ( drawGroups.empty() || renderItem.Mesh != m_RenderQueue->GetRenderItem( i - 1 ).Mesh || renderItem.Lod != m_RenderQueue->GetRenderItem( i - 1 ).Lod )
+        {
+            DrawGroup drawGroup = { i, (uint32_t)instanceDataList.size(), 0 };
+            drawGroups.push_back( drawGroup );
+        }
+        ++drawGroups.back().NumInstances;
+
+        InstanceData instanceData;
+        instanceData.ModelViewProjection = renderItem.ModelViewProjection;
+        instanceData.ModelView = renderItem.ModelView;
+        instanceDataList.push_back( instanceData );
+    }
+
+    if ( drawGroups.empty() ) return;
+
+    // Upload the instances of all groups with a single update of the instance buffer.
+    if ( chunk )
+    {
+        // The buffers of the chunk are bound to the vertex shader without modifying its parameters.
+        chunk->InstanceBuffer->Set( instanceDataList );
+        if ( vertexShader )
+        {
+            ShaderParameter& instances = vertexShader->GetShaderParameter( gs_InstancesID );
+            if ( instances.IsValid() )
+            {
+                instances.BindResource<StructuredBuffer>( chunk->InstanceBuffer );
+            }
+        }
+    }
+    else
+    {
+        BindInstanceData( instanceDataList );
+    }
+
+    // Shaders that are not instanced use the transform of the last instance of the group.
+    // Instanced shaders read the instances of the group starting at FirstInstance
+    // (SV_InstanceID does not include the start instance location of the draw call).
+    auto getPerObjectData = [&]( const DrawGroup& drawGroup )
+    {
+        const InstanceData& instanceData = instanceDataList[drawGroup.FirstInstance + drawGroup.NumInstances - 1];
+        PerObject perObjectData;
+        perObjectData.ModelViewProjection = instanceData.ModelViewProjection;
+        perObjectData.ModelView = instanceData.ModelView;
+        perObjectData.FirstInstance = drawGroup.FirstInstance;
+        return perObjectData;
+    };
+
+    // The per object data of all groups is written to the constant buffer ring with a few large allocations
+    // (the command lists can't use the ring and update the per object constant buffer of their chunk instead).
+    bool useRing = !chunk && m_pConstantBufferRing && vertexShader && vertexShader->GetShaderParameter( gs_PerObjectID ).IsValid();
+    ConstantBufferRing::Allocation ringAllocation;
+    if ( useRing )
+    {
+        m_PerObjectBlocks.resize( drawGroups.size() * ConstantBufferRing::Alignment );
+    }
+
+    for ( size_t g = 0; g < drawGroups.size(); ++g )
+    {
+        const DrawGroup& drawGroup = drawGroups[g];
+        Mesh* pMesh = m_RenderQueue->GetRenderItem( drawGroup.FirstItem ).Mesh;
+        uint32_t lod = m_RenderQueue->GetRenderItem( drawGroup.FirstItem ).Lod;
+        Material* pMaterial = pMesh->GetMaterial().get();
+
+        size_t firstGroup = g - g % MAX_GROUPS_PER_RING_ALLOCATION;
+        if ( useRing && g == firstGroup )
+        {
+            // Write the per object data of the next groups to the ring.
+            size_t numGroups = std::min<size_t>( MAX_GROUPS_PER_RING_ALLOCATION, drawGroups.size() - firstGroup );
+            for ( size_t i = 0; i < numGroups; ++i )
+            {
+                PerObject perObjectData = getPerObjectData( drawGroups[firstGroup + i] );
+                memcpy( &m_PerObjectBlocks[( firstGroup + i ) * ConstantBufferRing::Alignment], &perObjectData, sizeof( PerObject ) );
+            }
+            ringAllocation = m_pConstantBufferRing->Allocate( &m_PerObjectBlocks[firstGroup * ConstantBufferRing::Alignment], numGroups * ConstantBufferRing::Alignment );
+        }
+
+        uint32_t firstIndex = 0;
+        uint32_t numIndices = 0;
+        bool culled = clusterCulling && m_ClusterCuller->GetIndexRange( drawGroup.FirstItem, firstIndex, numIndices );
+        // All of the meshlets of the mesh are outside the view frustum or back facing.
+        if ( culled && numIndices == 0 ) continue;
+
+        if ( chunk )
+        {
+            chunk->PerObjectConstantBuffer->Set( getPerObjectData( drawGroup ) );
+        }
+        else if ( useRing )
+        {
+            // Bind the block of the group in the allocation of its batch.
+            ConstantBufferRing::Allocation groupAllocation;
+            groupAllocation.Offset = ringAllocation.Offset + (uint32_t)( g - firstGroup ) * ConstantBufferRing::Alignment;
+            groupAllocation.Size = ConstantBufferRing::Alignment;
+            m_pConstantBufferRing->Bind( groupAllocation, *vertexShader, gs_PerObjectID );
+        }
+        else
+        {
+            PerObject perObjectData = getPerObjectData( drawGroup );
+            SetPerObjectConstantBufferData( perObjectData );
+        }
+
+        // Only rebind the buffers and the material if they change.
+        if ( pMesh != pPreviousMesh )
+        {
+            pMesh->BindBuffers( e );
+            pPreviousMesh = pMesh;
+            numStateChanges += 1;
+        }
+        if ( pMaterial != pPreviousMaterial )
+        {
+            pMesh->BindMaterial( e );
+            pPreviousMaterial = pMaterial;
+            numStateChanges += 1;
+        }
+
+        if ( culled )
+        {
+            // Draw the visible meshlets from the compacted index buffer.
+            m_ClusterCuller->GetIndexBuffer()->Bind( 0, Shader::VertexShader, ShaderParameter::Type::Buffer );
+            pMesh->DrawIndexRange( e, firstIndex, numIndices );
+            // The index buffer of the mesh has to be bound again for the next item.
+            pPreviousMesh = nullptr;
+            numStateChanges += 1;
+            numTriangles += numIndices / 3;
+        }
+        else
+        {
+            pMesh->Draw( e, drawGroup.NumInstances, lod );
+            numTriangles += pMesh->GetNumTriangles( lod ) * drawGroup.NumInstances;
+        }
+        numDrawCalls += 1;
+    }
+}
+
+void BasePass::BindInstanceData( const InstanceDataList& instanceData )
+{
+    if ( instanceData.empty() ) return;
+
+    ReserveInstanceBuffer( m_InstanceBuffer, (unsigned int)instanceData.size() );
+    m_InstanceBuffer->Set( instanceData );
+
+    PipelineState* pipeline = GetRenderEventArgs().PipelineState;
+    std::shared_ptr<Shader> vertexShader = pipeline ? pipeline->GetShader( Shader::VertexShader ) : nullptr;
+    if ( vertexShader )
+    {
+        ShaderParameter& instances = vertexShader->GetShaderParameter( gs_InstancesID );
+        if ( instances.IsValid() )
+        {
+            instances.Set<StructuredBuffer>( m_InstanceBuffer );
+            instances.Bind();
+        }
+    }
+}
+
+void BasePass::ReserveInstanceBuffer( std::shared_ptr<StructuredBuffer>& instanceBuffer, unsigned int numInstances )
+{
+    // Grow the instance buffer to the next power of 2 that fits all of the instances.
+    if ( !instanceBuffer || instanceBuffer->GetElementCount() < numInstances )
+    {
+        unsigned int bufferSize = MIN_INSTANCE_BUFFER_SIZE;
+        while ( bufferSize < numInstances )
+        {
+            bufferSize *= 2;
+        }
+
+        if ( instanceBuffer )
+        {
+            m_RenderDevice.DestroyStructuredBuffer( instanceBuffer );
+        }
+        instanceBuffer = m_RenderDevice.CreateStructuredBuffer( InstanceDataList( bufferSize ), CPUAccess::Write );
+    }
+}
+
+uint32_t BasePass::GetNumDrawCalls() const
+{
+    return m_NumDrawCalls;
+}
+
+uint32_t BasePass::GetNumStateChanges() const
+{
+    return m_NumStateChanges;
+}
+
+uint32_t BasePass::GetNumTriangles() const
+{
+    return m_NumTriangles;
+}
+
+void BasePass::ResetRenderStatistics()
+{
+    m_NumDrawCalls = 0;
+    m_NumStateChanges = 0;
+    m_NumTriangles = 0;
 }
 
 void BasePass::SetRenderEventArgs( RenderEventArgs& e )
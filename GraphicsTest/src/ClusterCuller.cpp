@@ -0,0 +1,228 @@
+#include <GraphicsTestPCH.h>
+
+#include <RenderDevice.h>
+#include <Buffer.h>
+#include <Mesh.h>
+#include <Camera.h>
+
+#include <ClusterCuller.h>
+
+// The minimum number of indices the compacted index buffer can hold.
+#define MIN_CLUSTER_INDEX_BUFFER_SIZE 65536
+
+// Used for render items that are not culled.
+static const uint32_t INVALID_INDEX = 0xffffffff;
+
+ClusterCuller::ClusterCuller( RenderDevice& renderDevice )
+    : m_Enabled( true )
+    , m_NumTrianglesTested( 0 )
+    , m_NumTrianglesVisible( 0 )
+    , m_NumMeshletsTested( 0 )
+    , m_NumMeshletsCulled( 0 )
+    , m_RenderDevice( renderDevice )
+{}
+
+ClusterCuller::~ClusterCuller()
+{
+    if ( m_IndexBuffer )
+    {
+        m_RenderDevice.DestroyIndexBuffer( m_IndexBuffer );
+    }
+}
+
+void ClusterCuller::SetEnabled( bool enabled )
+{
+    m_Enabled = enabled;
+}
+
+bool ClusterCuller::IsEnabled() const
+{
+    return m_Enabled;
+}
+
+void ClusterCuller::Cull( const RenderQueue& renderQueue, Camera& camera, bool backfaceCulling )
+{
+    m_NumTrianglesTested = 0;
+    m_NumTrianglesVisible = 0;
+    m_NumMeshletsTested = 0;
+    m_NumMeshletsCulled = 0;
+
+    size_t numItems = renderQueue.GetSize();
+    m_IndexRanges.assign( numItems, { 0, INVALID_INDEX } );
+    m_Indices.clear();
+
+    if ( !m_Enabled ) return;
+
+    // The planes of the view frustum in view space (Gribb and Hartmann).
+    // The near plane is taken from the OpenGL clip space (-w <= z) which is also
+    // conservative for the Direct3D clip space (0 <= z).
+    // The columns of the transposed projection matrix are the rows of the projection matrix.
+    glm::mat4 rows = glm::transpose( camera.GetProjectionMatrix() );
+    glm::vec4 planes[6] =
+    {
+        rows[3] + rows[0],
+        rows[3] - rows[0],
+        rows[3] + rows[1],
+        rows[3] - rows[1],
+        rows[3] + rows[2],
+        rows[3] - rows[2],
+    };
+    for ( glm::vec4& plane : planes )
+    {
+        plane /= glm::length( glm::vec3( plane ) );
+    }
+
+    for ( size_t i = 0; i < numItems; ++i )
+    {
+        const RenderQueue::RenderItem& renderItem = renderQueue.GetRenderItem( i );
+        Mesh* pMesh = renderItem.Mesh;
+
+        // Items with the same mesh next to each other are drawn with a single instanced draw call.
+        auto sameMesh = [&]( size_t j )
+        {
+            const RenderQueue::RenderItem& other = renderQueue.GetRenderItem( j );
+            return other.Mesh == pMesh && other.Lod == renderItem.Lod;
+        };
+        if ( ( i > 0 && sameMesh( i - 1 ) ) || ( i + 1 < numItems && sameMesh( i + 1 ) ) ) continue;
+        if ( renderItem.Lod != 0 ) continue;
+
+        std::shared_ptr<const MeshletGeometry> pMeshletGeometry = pMesh->GetMeshletGeometry();
+        if ( !pMeshletGeometry ) continue;
+
+        // Transform the meshlets to view space. The camera is at the origin.
+        // The bounding spheres are scaled by the largest axis scale, so they still contain
+        // the meshlets if the model is scaled non-uniformly.
+        const glm::mat4& modelView = renderItem.ModelView;
+        glm::mat3 linear( modelView );
+        glm::vec3 axisScales( glm::length( linear[0] ), glm::length( linear[1] ), glm::length( linear[2] ) );
+        float scale = glm::max( axisScales.x, glm::max( axisScales.y, axisScales.z ) );
+        float minScale = glm::min( axisScales.x, glm::min( axisScales.y, axisScales.z ) );
+
+        // The face normals (and cone axes) are transformed with the cofactor matrix (the inverse transpose
+        // multiplied by the determinant), which keeps them facing away from the front faces of mirrored models.
+        // A non-uniform scale changes the angles between the normals, so the normal cone would no longer
+        // bound them and the cone test is skipped.
+        float determinant = glm::determinant( linear );
+        bool testCones = backfaceCulling && minScale > 0.0f && scale - minScale <= 1e-3f * scale;
+        glm::mat3 normalMatrix = testCones ? glm::transpose( glm::inverse( linear ) ) * determinant : glm::mat3( 1 );
+
+        IndexRange& indexRange = m_IndexRanges[i];
+        indexRange.FirstIndex = static_cast<uint32_t>( m_Indices.size() );
+
+        for ( const Meshlet& meshlet : pMeshletGeometry->Meshlets )
+        {
+            glm::vec3 center = glm::vec3( modelView * glm::vec4( meshlet.Center, 1 ) );
+            float radius = meshlet.Radius * scale;
+
+            bool visible = true;
+            for ( const glm::vec4& plane : planes )
+            {
+                if ( glm::dot( glm::vec3( plane ), center ) + plane.w < -radius )
+                {
+                    visible = false;
+                    break;
+                }
+            }
+
+            if ( visible && testCones && meshlet.ConeCutoff < 1.0f )
+            {
+                glm::vec3 coneAxis = glm::normalize( normalMatrix * meshlet.ConeAxis );
+                visible = glm::dot( center, coneAxis ) < meshlet.ConeCutoff * glm::length( center ) + radius;
+            }
+
+            if ( visible )
+            {
+                const uint32_t* indices = pMeshletGeometry->Indices.data() + meshlet.FirstIndex;
+                m_Indices.insert( m_Indices.end(), indices, indices + meshlet.NumIndices );
+            }
+            else
+            {
+                ++m_NumMeshletsCulled;
+            }
+        }
+
+        indexRange.NumIndices = static_cast<uint32_t>( m_Indices.size() ) - indexRange.FirstIndex;
+
+        m_NumMeshletsTested += static_cast<uint32_t>( pMeshletGeometry->Meshlets.size() );
+        m_NumTrianglesTested += static_cast<uint32_t>( pMeshletGeometry->Indices.size() / 3 );
+        m_NumTrianglesVisible += indexRange.NumIndices / 3;
+    }
+
+    if ( m_Indices.empty() ) return;
+
+    // Grow the index buffer to the next power of 2 that fits all of the indices.
+    if ( !m_IndexBuffer || m_IndexBuffer->GetElementCount() < m_Indices.size() )
+    {
+        size_t bufferSize = MIN_CLUSTER_INDEX_BUFFER_SIZE;
+        while ( bufferSize < m_Indices.size() )
+        {
+            bufferSize *= 2;
+        }
+
+        if ( m_IndexBuffer )
+        {
+            m_RenderDevice.DestroyIndexBuffer( m_IndexBuffer );
+        }
+        m_IndexBuffer = m_RenderDevice.CreateIndexBuffer( std::vector<unsigned int>( bufferSize, 0 ) );
+        m_UploadedIndices.clear();
+    }
+
+    // Only upload the indices between the first and the last index that changed since the last pass.
+    // The indices past the end of m_Indices are not drawn, so they don't need to be cleared.
+    size_t numIndices = m_Indices.size();
+    size_t numCompared = std::min( numIndices, m_UploadedIndices.size() );
+    size_t first = std::mismatch( m_Indices.begin(), m_Indices.begin() + numCompared, m_UploadedIndices.begin() ).first - m_Indices.begin();
+    size_t last = numIndices;
+    if ( numIndices <= m_UploadedIndices.size() )
+    {
+        while ( last > first && m_Indices[last - 1] == m_UploadedIndices[last - 1] )
+        {
+            --last;
+        }
+    }
+
+    if ( first < last )
+    {
+        m_IndexBuffer->SetElements( m_Indices.data() + first, first, last - first );
+
+        if ( m_UploadedIndices.size() < last )
+        {
+            m_UploadedIndices.resize( last );
+        }
+        std::copy( m_Indices.begin() + first, m_Indices.begin() + last, m_UploadedIndices.begin() + first );
+    }
+}
+
+bool ClusterCuller::GetIndexRange( size_t renderItem, uint32_t& firstIndex, uint32_t& numIndices ) const
+{
+    if ( renderItem >= m_IndexRanges.size() || m_IndexRanges[renderItem].NumIndices == INVALID_INDEX ) return false;
+
+    firstIndex = m_IndexRanges[renderItem].FirstIndex;
+    numIndices = m_IndexRanges[renderItem].NumIndices;
+    return true;
+}
+
+std::shared_ptr<Buffer> ClusterCuller::GetIndexBuffer() const
+{
+    return m_IndexBuffer;
+}
+
+uint32_t ClusterCuller::GetNumTrianglesTested() const
+{
+    return m_NumTrianglesTested;
+}
+
+uint32_t ClusterCuller::GetNumTrianglesVisible() const
+{
+    return m_NumTrianglesVisible;
+}
+
+uint32_t ClusterCuller::GetNumMeshletsTested() const
+{
+    return m_NumMeshletsTested;
+}
+
+uint32_t ClusterCuller::GetNumMeshletsCulled() const
+{
+    return m_NumMeshletsCulled;
+}
@@ -10,6 +10,7 @@ ConfigurationSettings::ConfigurationSettings()
     , FullScreen(false)
     , SceneFileName("")
     , SceneScaleFactor(1.0f)
+    , QuantizeSceneVertices(true)
     , CameraPosition(0.0f)
     , CameraRotation()
     , NormalCameraSpeed( 1.0f )
@@ -1,6 +1,7 @@
 #include <GraphicsTestPCH.h>
 
 #include <Buffer.h>
+#include <ResourceStateTracker.h>
 #include <CopyBufferPass.h>
 
 CopyBufferPass::CopyBufferPass( std::shared_ptr<Buffer> destinationBuffer, std::shared_ptr<Buffer> sourceBuffer )
@@ -18,3 +19,12 @@ void CopyBufferPass::Render( RenderEventArgs& e )
         m_DestinationBuffer->Copy( m_SourceBuffer );
     }
 }
+
+void CopyBufferPass::DeclareResources( ResourceStateTracker& stateTracker )
+{
+    if ( m_DestinationBuffer && m_SourceBuffer )
+    {
+        stateTracker.Read( m_SourceBuffer.get(), ResourceState::CopySource );
+        stateTracker.Write( m_DestinationBuffer.get(), ResourceState::CopyDest );
+    }
+}
@@ -1,6 +1,7 @@
 #include <GraphicsTestPCH.h>
 
 #include <Texture.h>
+#include <ResourceStateTracker.h>
 
 #include <CopyTexturePass.h>
 
@@ -19,3 +20,12 @@ void CopyTexturePass::Render( RenderEventArgs& e )
         m_DestinationTexture->Copy( m_SourceTexture );
     }
 }
+
+void CopyTexturePass::DeclareResources( ResourceStateTracker& stateTracker )
+{
+    if ( m_DestinationTexture && m_SourceTexture )
+    {
+        stateTracker.Read( m_SourceTexture.get(), ResourceState::CopySource );
+        stateTracker.Write( m_DestinationTexture.get(), ResourceState::CopyDest );
+    }
+}
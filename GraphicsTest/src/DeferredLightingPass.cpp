@@ -1,6 +1,5 @@
 #include <GraphicsTestPCH.h>
 
-#include <Application.h>
 #include <RenderDevice.h>
 #include <ConstantBuffer.h>
 #include <PipelineState.h>
@@ -14,7 +13,11 @@
 
 #include <DeferredLightingPass.h>
 
-DeferredLightingPass::DeferredLightingPass( std::vector<Light>& lights, 
+static const ShaderParameterID gs_LightIndexBufferID( "LightIndexBuffer" );
+static const ShaderParameterID gs_ScreenToViewParamsID( "ScreenToViewParams" );
+
+DeferredLightingPass::DeferredLightingPass( RenderDevice& renderDevice,
+                                            std::vector<Light>& lights, 
                                             std::shared_ptr<Scene> pointLight,  
                                             std::shared_ptr<Scene> spotLight, 
                                             std::shared_ptr<PipelineState> lightPipeline0,
@@ -25,9 +28,10 @@ DeferredLightingPass::DeferredLightingPass( std::vector<Light>& lights,
                                             std::shared_ptr<Texture> normalTexture,
                                             std::shared_ptr<Texture> depthTexture
                                           )
-    : m_Lights( lights )
+    : base( renderDevice )
+    , m_Lights( lights )
     , m_pCurrentLight( nullptr )
-    , m_RenderDevice( Application::Get().GetRenderDevice() )
+    , m_RenderDevice( renderDevice )
     , m_LightPipeline0( lightPipeline0 )
     , m_LightPipeline1( lightPipeline1 )
     , m_DirectionalLightPipeline( directionalLightPipeline )
@@ -112,8 +116,8 @@ void DeferredLightingPass::Render( RenderEventArgs& e )
         if ( pixelShader )
         {
             // Bind the per-light & deferred lighting properties constant buffers to the pixel shader.
-            pixelShader->GetShaderParameterByName( "LightIndexBuffer" ).Set( m_LightParamsCB );
-            pixelShader->GetShaderParameterByName( "ScreenToViewParams" ).Set( m_ScreenToViewParamsCB );
+            pixelShader->GetShaderParameter( gs_LightIndexBufferID ).Set( m_LightParamsCB );
+            pixelShader->GetShaderParameter( gs_ScreenToViewParamsID ).Set( m_ScreenToViewParamsCB );
         }
     }
 
@@ -1,6 +1,5 @@
 #include <GraphicsTestPCH.h>
 
-#include <Application.h>
 #include <RenderDevice.h>
 #include <PipelineState.h>
 #include <Events.h>
@@ -9,15 +8,18 @@
 #include <Camera.h>
 #include <Material.h>
 #include <Mesh.h>
+#include <Shader.h>
+#include <ShaderParameter.h>
+#include <StructuredBuffer.h>
 
 #include <LightsPass.h>
 
-LightsPass::LightsPass( std::vector<Light>& lights, std::shared_ptr<Scene> pointLight, std::shared_ptr<Scene> spotLight, std::shared_ptr<Scene> directionalLight, std::shared_ptr<PipelineState> pipeline )
-    : base( std::shared_ptr<Scene>(), pipeline )
+static const ShaderParameterID gs_LightColorsID( "LightColors" );
+
+LightsPass::LightsPass( RenderDevice& renderDevice, std::vector<Light>& lights, std::shared_ptr<Scene> pointLight, std::shared_ptr<Scene> spotLight, std::shared_ptr<Scene> directionalLight, std::shared_ptr<PipelineState> pipeline )
+    : base( renderDevice, std::shared_ptr<Scene>(), pipeline )
     , m_Lights( lights )
-    , m_pCurrentLight( nullptr )
-    , m_uiLightIndex( (uint32_t)-1 )
-    , m_RenderDevice( Application::Get().GetRenderDevice() )
+    , m_RenderDevice( renderDevice )
     , m_Pipeline( pipeline )
     , m_PointLightScene( pointLight )
     , m_pSpotLightScene( spotLight )
@@ -28,7 +30,10 @@ LightsPass::LightsPass( std::vector<Light>& lights, std::shared_ptr<Scene> point
 
 LightsPass::~LightsPass()
 {
-
+    if ( m_LightColorBuffer )
+    {
+        m_RenderDevice.DestroyStructuredBuffer( m_LightColorBuffer );
+    }
 }
 
 //void LightsPass::PreRender( RenderEventArgs& e )
@@ -47,21 +52,47 @@ LightsPass::~LightsPass()
 // Render the pass. This should only be called by the RenderTechnique.
 void LightsPass::Render( RenderEventArgs& e )
 {
-    m_uiLightIndex = 0;
+    const Light::LightType lightTypes[] = { Light::LightType::Point, Light::LightType::Spot, Light::LightType::Directional };
 
-    for ( Light& light : m_Lights )
+    for ( Light::LightType lightType : lightTypes )
     {
-        m_pCurrentLight = &light;
+        m_LightTransforms.clear();
+        m_LightColors.clear();
 
-        // Disabled lights should appear dimmer than enabled ones.
-        float alpha = light.m_Enabled ? 0.5f : 0.1f;
-        // Selected lights should appear more opaque.
-        alpha = light.m_Selected ? 0.9f : alpha;
+        for ( const Light& light : m_Lights )
+        {
+            if ( light.m_Type != lightType ) continue;
+
+            // Create a model matrix from the light properties.
+            glm::mat4 translation = glm::translate( glm::vec3( light.m_PositionWS ) );
+            // Create a rotation matrix that rotates the model towards the direction of the light.
+            glm::mat4 rotation = glm::toMat4( glm::quat( glm::vec3( 0, 0, 1 ), glm::normalize( glm::vec3( light.m_DirectionWS ) ) ) );
+
+            // Compute the scale depending on the light type.
+            float scaleX, scaleY, scaleZ;
+            // For directional lights, we don't want any scaling applied.
+            // For point lights, we want to scale the geometry by the range of the light.
+            scaleX = scaleY = scaleZ = ( light.m_Type == Light::LightType::Directional ) ? 1.0f : light.m_Range;
+            if ( light.m_Type == Light::LightType::Spot )
+            {
+                // For spotlights, we want to scale the base of the cone by the spotlight angle.
+                scaleX = scaleY = glm::tan( glm::radians( light.m_SpotlightAngle ) ) * light.m_Range;
+            }
+
+            glm::mat4 scale = glm::scale( glm::vec3( scaleX, scaleY, scaleZ ) );
+
+            // Disabled lights should appear dimmer than enabled ones.
+            float alpha = light.m_Enabled ? 0.5f : 0.1f;
+            // Selected lights should appear more opaque.
+            alpha = light.m_Selected ? 0.9f : alpha;
+
+            m_LightTransforms.push_back( translation * rotation * scale );
+            m_LightColors.push_back( glm::vec4( glm::vec3( light.m_Color ), alpha ) );
+        }
 
-        m_LightMaterial->SetDiffuseColor( light.m_Color );
-        m_LightMaterial->SetOpacity( alpha );
+        if ( m_LightTransforms.empty() ) continue;
 
-        switch ( light.m_Type )
+        switch ( lightType )
         {
         case Light::LightType::Point:
             // Render point lights as spheres.
@@ -76,8 +107,6 @@ void LightsPass::Render( RenderEventArgs& e )
             m_pDirectionalLightScene->Accept( *this );
             break;
         }
-
-        ++m_uiLightIndex;
     }
 }
 
@@ -91,57 +120,63 @@ void LightsPass::Visit( SceneNode& node )
 {
     Camera* camera = GetRenderEventArgs().Camera;
 
-    PerObject perObjectData;
-
     glm::mat4 nodeTransform = node.GetWorldTransfom();
+    glm::mat4 viewMatrix = camera->GetViewMatrix();
+    glm::mat4 projectionMatrix = camera->GetProjectionMatrix();
 
-    // Setup constant buffer for node.
-    // Create a model matrix from the light properties.
-    glm::mat4 translation = glm::translate( glm::vec3( m_pCurrentLight->m_PositionWS ) );
-    // Create a rotation matrix that rotates the model towards the direction of the light.
-    glm::mat4 rotation = glm::toMat4( glm::quat( glm::vec3( 0, 0, 1 ), glm::normalize( glm::vec3( m_pCurrentLight->m_DirectionWS ) ) ) );
-
-    // Compute the scale depending on the light type.
-    float scaleX, scaleY, scaleZ;
-    // For directional lights, we don't want any scaling applied.
-    // For point lights, we want to scale the geometry by the range of the light.
-    scaleX = scaleY = scaleZ = ( m_pCurrentLight->m_Type == Light::LightType::Directional ) ? 1.0f : m_pCurrentLight->m_Range;
-    if ( m_pCurrentLight->m_Type == Light::LightType::Spot )
+    // Setup the instance data for the node (one instance for each light).
+    m_InstanceData.resize( m_LightTransforms.size() );
+    for ( size_t i = 0; i < m_LightTransforms.size(); ++i )
     {
-        // For spotlights, we want to scale the base of the cone by the spotlight angle.
-        scaleX = scaleY = glm::tan( glm::radians( m_pCurrentLight->m_SpotlightAngle ) ) * m_pCurrentLight->m_Range;
+        InstanceData& instanceData = m_InstanceData[i];
+        instanceData.ModelView = viewMatrix * m_LightTransforms[i] * nodeTransform;
+        instanceData.ModelViewProjection = projectionMatrix * instanceData.ModelView;
     }
 
-    glm::mat4 scale = glm::scale( glm::vec3( scaleX, scaleY, scaleZ ) );
-
-    perObjectData.ModelView = camera->GetViewMatrix() * translation * rotation * scale * nodeTransform;
-    perObjectData.ModelViewProjection = camera->GetProjectionMatrix() * perObjectData.ModelView;
-
+    // Shaders that are not instanced use the per object data of the first light.
+    PerObject perObjectData;
+    perObjectData.ModelView = m_InstanceData[0].ModelView;
+    perObjectData.ModelViewProjection = m_InstanceData[0].ModelViewProjection;
     SetPerObjectConstantBufferData( perObjectData );
-
 }
 
 void LightsPass::Visit( Mesh& mesh )
 {
+    RenderEventArgs& e = GetRenderEventArgs();
     std::shared_ptr<Material> tempMaterial = mesh.GetMaterial();
 
     // Temporarily replace the material of the mesh
     // for rendering the mesh as a light object.
     mesh.SetMaterial( m_LightMaterial );
 
-    mesh.Render( GetRenderEventArgs() );
+    BindInstanceData( m_InstanceData );
 
-    // Restore the mesh's original material.
-    mesh.SetMaterial( tempMaterial );
-}
+    // Grow the color buffer if there are more lights than it can hold.
+    if ( !m_LightColorBuffer || m_LightColorBuffer->GetElementCount() < m_LightColors.size() )
+    {
+        if ( m_LightColorBuffer )
+        {
+            m_RenderDevice.DestroyStructuredBuffer( m_LightColorBuffer );
+        }
+        m_LightColorBuffer = m_RenderDevice.CreateStructuredBuffer( m_LightColors, CPUAccess::Write );
+    }
+    m_LightColorBuffer->Set( m_LightColors );
 
+    std::shared_ptr<Shader> vertexShader = m_Pipeline ? m_Pipeline->GetShader( Shader::VertexShader ) : nullptr;
+    if ( vertexShader )
+    {
+        ShaderParameter& lightColors = vertexShader->GetShaderParameter( gs_LightColorsID );
+        if ( lightColors.IsValid() )
+        {
+            lightColors.Set<StructuredBuffer>( m_LightColorBuffer );
+            lightColors.Bind();
+        }
+    }
 
-const Light* LightsPass::GetCurrentLight()
-{
-    return m_pCurrentLight;
-}
+    mesh.BindBuffers( e );
+    mesh.BindMaterial( e );
+    mesh.Draw( e, (uint32_t)m_InstanceData.size() );
 
-const uint32_t LightsPass::GetCurrentLightIndex()
-{
-    return m_uiLightIndex;
+    // Restore the mesh's original material.
+    mesh.SetMaterial( tempMaterial );
 }
@@ -0,0 +1,117 @@
+#include <GraphicsTestPCH.h>
+
+#include <Scene.h>
+#include <SceneNode.h>
+#include <Mesh.h>
+#include <Camera.h>
+#include <BoundingBox.h>
+
+#include <OcclusionCuller.h>
+
+OcclusionCuller::OcclusionCuller( std::shared_ptr<Scene> scene, uint32_t width, uint32_t height )
+    : m_Scene( scene )
+    , m_DepthRasterizer( width, height )
+    , m_Enabled( true )
+    , m_ViewProjectionMatrix( 1 )
+    , m_ModelViewProjectionMatrix( 1 )
+    , m_NumOccluderTriangles( 0 )
+    , m_NumMeshesTested( 0 )
+    , m_NumMeshesCulled( 0 )
+{}
+
+OcclusionCuller::~OcclusionCuller()
+{}
+
+void OcclusionCuller::SetEnabled( bool enabled )
+{
+    m_Enabled = enabled;
+}
+
+bool OcclusionCuller::IsEnabled() const
+{
+    return m_Enabled;
+}
+
+void OcclusionCuller::Update( Camera& camera )
+{
+    m_NumOccluderTriangles = 0;
+    m_NumMeshesTested = 0;
+    m_NumMeshesCulled = 0;
+
+    if ( !m_Enabled ) return;
+
+    Rasterize( camera );
+}
+
+void OcclusionCuller::Rasterize( Camera& camera )
+{
+    m_NumOccluderTriangles = 0;
+    m_ViewProjectionMatrix = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+
+    m_DepthRasterizer.Clear();
+    if ( m_Scene )
+    {
+        m_Scene->Accept( *this );
+    }
+    m_DepthRasterizer.BuildHierarchy();
+}
+
+bool OcclusionCuller::IsVisible( const BoundingBox& boundingBox, const glm::mat4& modelViewProjection, bool updateStatistics )
+{
+    if ( !m_Enabled ) return true;
+
+    bool isVisible = m_DepthRasterizer.IsVisible( modelViewProjection, boundingBox );
+    if ( updateStatistics )
+    {
+        ++m_NumMeshesTested;
+        if ( !isVisible )
+        {
+            ++m_NumMeshesCulled;
+        }
+    }
+
+    return isVisible;
+}
+
+bool OcclusionCuller::IsPointOccluded( const glm::vec3& point ) const
+{
+    return m_DepthRasterizer.IsPointOccluded( m_ViewProjectionMatrix, point );
+}
+
+uint32_t OcclusionCuller::GetNumOccluderTriangles() const
+{
+    return m_NumOccluderTriangles;
+}
+
+uint32_t OcclusionCuller::GetNumMeshesTested() const
+{
+    return m_NumMeshesTested;
+}
+
+uint32_t OcclusionCuller::GetNumMeshesCulled() const
+{
+    return m_NumMeshesCulled;
+}
+
+const DepthRasterizer& OcclusionCuller::GetDepthRasterizer() const
+{
+    return m_DepthRasterizer;
+}
+
+void OcclusionCuller::Visit( Scene& scene )
+{}
+
+void OcclusionCuller::Visit( SceneNode& node )
+{
+    m_ModelViewProjectionMatrix = m_ViewProjectionMatrix * node.GetWorldTransfom();
+}
+
+void OcclusionCuller::Visit( Mesh& mesh )
+{
+    std::shared_ptr<const OccluderGeometry> pOccluderGeometry = mesh.GetOccluderGeometry();
+    if ( pOccluderGeometry && !pOccluderGeometry->Indices.empty() )
+    {
+        m_DepthRasterizer.RasterizeTriangles( m_ModelViewProjectionMatrix, pOccluderGeometry->Positions.data(), pOccluderGeometry->Indices.data(), static_cast<uint32_t>( pOccluderGeometry->Indices.size() ) );
+        m_NumOccluderTriangles += static_cast<uint32_t>( pOccluderGeometry->Indices.size() / 3 );
+    }
+}
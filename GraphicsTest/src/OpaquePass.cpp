@@ -4,22 +4,34 @@
 #include <Material.h>
 #include <RenderDevice.h>
 #include <Query.h>
+#include <OcclusionCuller.h>
 
 #include <OpaquePass.h>
 
-OpaquePass::OpaquePass( std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline )
-    : base( scene, pipeline )
+OpaquePass::OpaquePass( RenderDevice& renderDevice, std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline )
+    : base( renderDevice, scene, pipeline )
+    , m_bUpdateOcclusionStatistics( true )
 {
+    // Opaque meshes are sorted by state and then front-to-back.
+    SetRenderQueue( std::make_shared<RenderQueue>( RenderQueue::SortOrder::FrontToBack ) );
 }
 
 OpaquePass::~OpaquePass()
 {}
 
-void OpaquePass::Visit( Mesh& mesh )
+void OpaquePass::SetOcclusionCuller( std::shared_ptr<OcclusionCuller> occlusionCuller, bool updateStatistics )
+{
+    m_OcclusionCuller = occlusionCuller;
+    m_bUpdateOcclusionStatistics = updateStatistics;
+}
+
+bool OpaquePass::FilterMesh( Mesh& mesh, const glm::mat4& modelViewProjection )
 {
     std::shared_ptr<Material> pMaterial = mesh.GetMaterial();
     if ( pMaterial && !pMaterial->IsTransparent() )
     {
-        mesh.Render( GetRenderEventArgs() );
+        return !m_OcclusionCuller || m_OcclusionCuller->IsVisible( mesh.GetBoundingBox(), modelViewProjection, m_bUpdateOcclusionStatistics );
     }
+
+    return false;
 }
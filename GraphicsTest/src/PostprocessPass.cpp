@@ -4,8 +4,8 @@
 
 #include <PostprocessPass.h>
 
-PostprocessPass::PostprocessPass( std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline, const glm::mat4& projectionMatrix, std::shared_ptr<Texture> texture )
-    : base( scene, pipeline )
+PostprocessPass::PostprocessPass( RenderDevice& renderDevice, std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline, const glm::mat4& projectionMatrix, std::shared_ptr<Texture> texture )
+    : base( renderDevice, scene, pipeline )
     , m_ProjectionMatrix( projectionMatrix)
     , m_Texture( texture )
 {}
@@ -0,0 +1,451 @@
+#include <GraphicsTestPCH.h>
+
+#include <RenderDevice.h>
+#include <ResourceStateTracker.h>
+#include <TransientTexturePool.h>
+#include <RenderGraph.h>
+
+#define INVALID_INDEX ( (uint32_t)-1 )
+
+RenderGraph::PassBuilder::PassBuilder( RenderGraph& renderGraph, uint32_t passIndex )
+    : m_RenderGraph( renderGraph )
+    , m_PassIndex( passIndex )
+{}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read( ResourceHandle resource )
+{
+    assert( resource < m_RenderGraph.m_Resources.size() );
+    m_RenderGraph.m_Passes[m_PassIndex].Reads.push_back( resource );
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write( ResourceHandle resource )
+{
+    assert( resource < m_RenderGraph.m_Resources.size() );
+    m_RenderGraph.m_Passes[m_PassIndex].Writes.push_back( resource );
+    return *this;
+}
+
+RenderGraph::RenderGraph()
+    : m_pTransientTexturePool( nullptr )
+    , m_bCompiled( false )
+{}
+
+RenderGraph::~RenderGraph()
+{
+    if ( m_pTransientTexturePool )
+    {
+        m_pTransientTexturePool->Release( this );
+    }
+}
+
+RenderGraph::ResourceHandle RenderGraph::ImportResource( const std::string& name )
+{
+    Resource resource;
+    resource.Name = name;
+    resource.Imported = true;
+    resource.UAV = false;
+    resource.FirstPass = INVALID_INDEX;
+    resource.LastPass = INVALID_INDEX;
+    resource.PoolIndex = INVALID_INDEX;
+
+    m_Resources.push_back( resource );
+    return static_cast<ResourceHandle>( m_Resources.size() ) - 1;
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateTexture( const std::string& name, const Texture::TextureFormat& format, bool uav )
+{
+    Resource resource;
+    resource.Name = name;
+    resource.Imported = false;
+    resource.Format = format;
+    resource.UAV = uav;
+    resource.FirstPass = INVALID_INDEX;
+    resource.LastPass = INVALID_INDEX;
+    resource.PoolIndex = INVALID_INDEX;
+
+    m_Resources.push_back( resource );
+    return static_cast<ResourceHandle>( m_Resources.size() ) - 1;
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass( const std::string& name, std::shared_ptr<RenderPass> pass )
+{
+    PassNode passNode;
+    passNode.Name = name;
+    passNode.Pass = pass;
+
+    m_Passes.push_back( passNode );
+    m_bCompiled = false;
+
+    return PassBuilder( *this, static_cast<uint32_t>( m_Passes.size() ) - 1 );
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass( const std::string& name, PassFactory factory )
+{
+    PassNode passNode;
+    passNode.Name = name;
+    passNode.Factory = factory;
+
+    m_Passes.push_back( passNode );
+    m_bCompiled = false;
+
+    return PassBuilder( *this, static_cast<uint32_t>( m_Passes.size() ) - 1 );
+}
+
+unsigned int RenderGraph::AddPass( std::shared_ptr<RenderPass> pass )
+{
+    AddPass( std::string(), pass );
+    return static_cast<unsigned int>( m_Passes.size() ) - 1;
+}
+
+std::shared_ptr<RenderPass> RenderGraph::GetPass( unsigned int ID ) const
+{
+    if ( ID < m_Passes.size() )
+    {
+        return m_Passes[ID].Pass;
+    }
+
+    return std::shared_ptr<RenderPass>();
+}
+
+void RenderGraph::Compile( TransientTexturePool& transientTexturePool )
+{
+    const uint32_t numPasses = static_cast<uint32_t>( m_Passes.size() );
+    const uint32_t numResources = static_cast<uint32_t>( m_Resources.size() );
+
+    // Derive the dependencies from the order in which the passes access the resources.
+    // A pass depends on the last pass that wrote a resource it accesses and a pass that
+    // writes a resource also depends on the passes that read the previous contents of the resource.
+    std::vector<uint32_t> lastWriter( numResources, INVALID_INDEX );
+    std::vector< std::vector<uint32_t> > readers( numResources );
+
+    for ( uint32_t i = 0; i < numPasses; ++i )
+    {
+        PassNode& passNode = m_Passes[i];
+        std::vector<uint32_t>& dependencies = passNode.Dependencies;
+        dependencies.clear();
+
+        for ( ResourceHandle resource : passNode.Reads )
+        {
+            if ( lastWriter[resource] != INVALID_INDEX )
+            {
+                dependencies.push_back( lastWriter[resource] );
+            }
+        }
+        for ( ResourceHandle resource : passNode.Writes )
+        {
+            if ( lastWriter[resource] != INVALID_INDEX )
+            {
+                dependencies.push_back( lastWriter[resource] );
+            }
+            dependencies.insert( dependencies.end(), readers[resource].begin(), readers[resource].end() );
+        }
+
+        std::sort( dependencies.begin(), dependencies.end() );
+        dependencies.erase( std::unique( dependencies.begin(), dependencies.end() ), dependencies.end() );
+        dependencies.erase( std::remove( dependencies.begin(), dependencies.end(), i ), dependencies.end() );
+
+        for ( ResourceHandle resource : passNode.Reads )
+        {
+            readers[resource].push_back( i );
+        }
+        for ( ResourceHandle resource : passNode.Writes )
+        {
+            lastWriter[resource] = i;
+            readers[resource].clear();
+        }
+    }
+
+    // Sort the passes topologically. If several passes are ready to be executed,
+    // the pass that was added first is executed first.
+    std::vector<uint32_t> numDependencies( numPasses );
+    std::vector< std::vector<uint32_t> > dependents( numPasses );
+    std::priority_queue< uint32_t, std::vector<uint32_t>, std::greater<uint32_t> > readyPasses;
+
+    for ( uint32_t i = 0; i < numPasses; ++i )
+    {
+        numDependencies[i] = static_cast<uint32_t>( m_Passes[i].Dependencies.size() );
+        for ( uint32_t dependency : m_Passes[i].Dependencies )
+        {
+            dependents[dependency].push_back( i );
+        }
+        if ( numDependencies[i] == 0 )
+        {
+            readyPasses.push( i );
+        }
+    }
+
+    m_Schedule.clear();
+    while ( !readyPasses.empty() )
+    {
+        uint32_t passIndex = readyPasses.top();
+        readyPasses.pop();
+
+        m_Schedule.push_back( passIndex );
+        for ( uint32_t dependent : dependents[passIndex] )
+        {
+            if ( --numDependencies[dependent] == 0 )
+            {
+                readyPasses.push( dependent );
+            }
+        }
+    }
+    assert( m_Schedule.size() == numPasses );
+
+    // Remove the passes whose outputs are never used (even if all of the passes are enabled).
+    std::vector<bool> culled;
+    CullPasses( false, culled );
+
+    std::vector<uint32_t> schedule;
+    for ( uint32_t i = 0; i < m_Schedule.size(); ++i )
+    {
+        if ( !culled[i] )
+        {
+            schedule.push_back( m_Schedule[i] );
+        }
+    }
+    m_Schedule.swap( schedule );
+
+    // The lifetime of a transient texture is the range of passes in the schedule that access it.
+    for ( Resource& resource : m_Resources )
+    {
+        resource.FirstPass = INVALID_INDEX;
+        resource.LastPass = INVALID_INDEX;
+    }
+
+    for ( uint32_t i = 0; i < m_Schedule.size(); ++i )
+    {
+        const PassNode& passNode = m_Passes[m_Schedule[i]];
+
+        for ( ResourceHandle resource : passNode.Reads )
+        {
+            if ( !m_Resources[resource].Imported && m_Resources[resource].FirstPass == INVALID_INDEX )
+            {
+                ReportError( "Transient texture \"" + m_Resources[resource].Name + "\" is read by \"" + passNode.Name + "\" before it is written." );
+            }
+            m_Resources[resource].LastPass = i;
+        }
+        for ( ResourceHandle resource : passNode.Writes )
+        {
+            if ( m_Resources[resource].FirstPass == INVALID_INDEX )
+            {
+                m_Resources[resource].FirstPass = i;
+            }
+            m_Resources[resource].LastPass = i;
+        }
+    }
+
+    // Acquire the transient textures from the pool.
+    if ( m_pTransientTexturePool )
+    {
+        m_pTransientTexturePool->Release( this );
+    }
+    m_pTransientTexturePool = &transientTexturePool;
+
+    for ( Resource& resource : m_Resources )
+    {
+        resource.PoolIndex = INVALID_INDEX;
+
+        if ( !resource.Imported && resource.FirstPass != INVALID_INDEX )
+        {
+            resource.PoolIndex = m_pTransientTexturePool->Acquire( this, resource.Format, resource.UAV, resource.FirstPass, resource.LastPass );
+        }
+    }
+
+    m_bCompiled = true;
+}
+
+void RenderGraph::CreatePasses()
+{
+    assert( m_bCompiled );
+
+    for ( PassNode& passNode : m_Passes )
+    {
+        if ( !passNode.Pass && passNode.Factory )
+        {
+            passNode.Pass = passNode.Factory();
+        }
+    }
+}
+
+std::shared_ptr<Texture> RenderGraph::GetTexture( ResourceHandle resource ) const
+{
+    assert( m_bCompiled && resource < m_Resources.size() );
+
+    uint32_t poolIndex = m_Resources[resource].PoolIndex;
+    if ( poolIndex == INVALID_INDEX )
+    {
+        return std::shared_ptr<Texture>();
+    }
+
+    return m_pTransientTexturePool->GetTexture( poolIndex );
+}
+
+void RenderGraph::CullPasses( bool onlyEnabled, std::vector<bool>& culled ) const
+{
+    culled.assign( m_Schedule.size(), false );
+
+    // Walk the schedule backwards to find the transient textures that are read by passes that are not culled.
+    std::vector<bool> used( m_Resources.size(), false );
+
+    for ( size_t i = m_Schedule.size(); i-- > 0; )
+    {
+        const PassNode& passNode = m_Passes[m_Schedule[i]];
+
+        bool render = passNode.Writes.empty();
+        for ( ResourceHandle resource : passNode.Writes )
+        {
+            render = render || m_Resources[resource].Imported || used[resource];
+        }
+
+        if ( onlyEnabled && !( passNode.Pass && passNode.Pass->IsEnabled() ) )
+        {
+            render = false;
+        }
+
+        if ( render )
+        {
+            for ( ResourceHandle resource : passNode.Reads )
+            {
+                used[resource] = true;
+            }
+        }
+
+        culled[i] = !render;
+    }
+}
+
+void RenderGraph::DeclareResources( const PassNode& passNode, ResourceStateTracker& stateTracker ) const
+{
+    for ( ResourceHandle resource : passNode.Reads )
+    {
+        std::shared_ptr<Texture> texture = GetTexture( resource );
+        if ( texture && !stateTracker.IsDeclared( texture.get() ) )
+        {
+            Texture::Components components = m_Resources[resource].Format.Components;
+            if ( components == Texture::Components::Depth || components == Texture::Components::DepthStencil )
+            {
+                // A depth/stencil texture that is read can be used for depth testing and sampled in a shader.
+                stateTracker.Read( texture.get(), ResourceState::DepthRead );
+            }
+            stateTracker.Read( texture.get(), ResourceState::ShaderResource );
+        }
+    }
+
+    for ( ResourceHandle resource : passNode.Writes )
+    {
+        std::shared_ptr<Texture> texture = GetTexture( resource );
+        if ( texture && !stateTracker.IsDeclared( texture.get() ) )
+        {
+            const Resource& transientResource = m_Resources[resource];
+            Texture::Components components = transientResource.Format.Components;
+            if ( transientResource.UAV )
+            {
+                stateTracker.Write( texture.get(), ResourceState::UnorderedAccess );
+            }
+            else if ( components == Texture::Components::Depth || components == Texture::Components::DepthStencil )
+            {
+                stateTracker.Write( texture.get(), ResourceState::DepthWrite );
+            }
+            else
+            {
+                stateTracker.Write( texture.get(), ResourceState::RenderTarget );
+            }
+        }
+    }
+}
+
+void RenderGraph::Report( const std::string& name ) const
+{
+    if ( !m_bCompiled )
+    {
+        return;
+    }
+
+    uint32_t numTransientTextures = 0;
+    size_t unaliasedSize = 0;
+
+    // The format and the range of passes of each texture of the pool.
+    struct PoolTexture
+    {
+        Texture::TextureFormat Format;
+        uint32_t FirstPass;
+        uint32_t LastPass;
+    };
+    std::map<uint32_t, PoolTexture> poolTextures;
+
+    for ( const Resource& resource : m_Resources )
+    {
+        if ( resource.PoolIndex == INVALID_INDEX )
+        {
+            continue;
+        }
+
+        ++numTransientTextures;
+        unaliasedSize += m_pTransientTexturePool->GetTextureSize( resource.Format );
+
+        auto iter = poolTextures.find( resource.PoolIndex );
+        if ( iter == poolTextures.end() )
+        {
+            poolTextures[resource.PoolIndex] = { resource.Format, resource.FirstPass, resource.LastPass };
+        }
+        else
+        {
+            iter->second.FirstPass = glm::min( iter->second.FirstPass, resource.FirstPass );
+            iter->second.LastPass = glm::max( iter->second.LastPass, resource.LastPass );
+        }
+    }
+
+    // The transient memory that is used during each pass of the schedule.
+    std::vector<size_t> passSize( m_Schedule.size(), 0 );
+    for ( auto poolTexture : poolTextures )
+    {
+        size_t textureSize = m_pTransientTexturePool->GetTextureSize( poolTexture.second.Format );
+        for ( uint32_t i = poolTexture.second.FirstPass; i <= poolTexture.second.LastPass; ++i )
+        {
+            passSize[i] += textureSize;
+        }
+    }
+
+    size_t peakSize = passSize.empty() ? 0 : *std::max_element( passSize.begin(), passSize.end() );
+
+    std::stringstream ss;
+    ss << "Render graph " << name << ": " << m_Schedule.size() << " passes (" << m_Passes.size() - m_Schedule.size() << " culled)" << std::endl;
+    ss << "  Transient textures: " << numTransientTextures << " (in " << poolTextures.size() << " pool textures)" << std::endl;
+    ss << "  Peak transient memory: " << peakSize / ( 1024.0 * 1024.0 ) << " MB" << std::endl;
+    ss << "  Without aliasing:      " << unaliasedSize / ( 1024.0 * 1024.0 ) << " MB" << std::endl;
+    ss << "  Pool allocation:       " << m_pTransientTexturePool->GetAllocatedSize() / ( 1024.0 * 1024.0 ) << " MB (" << m_pTransientTexturePool->GetNumTextures() << " textures)" << std::endl;
+
+    OutputDebugStringA( ss.str().c_str() );
+}
+
+// Render the passes in the order of the schedule, skipping the passes that are culled.
+void RenderGraph::Render( RenderEventArgs& renderEventArgs )
+{
+    assert( m_bCompiled );
+
+    RenderDevice& renderDevice = m_pTransientTexturePool->GetRenderDevice();
+    ResourceStateTracker* pStateTracker = renderDevice.GetResourceStateTracker();
+
+    CullPasses( true, m_Culled );
+
+    for ( uint32_t i = 0; i < m_Schedule.size(); ++i )
+    {
+        if ( !m_Culled[i] )
+        {
+            const PassNode& passNode = m_Passes[m_Schedule[i]];
+            std::shared_ptr<RenderPass> pass = passNode.Pass;
+
+            if ( pStateTracker )
+            {
+                pass->DeclareResources( *pStateTracker );
+                DeclareResources( passNode, *pStateTracker );
+                renderDevice.FlushResourceTransitions();
+            }
+
+            pass->PreRender( renderEventArgs );
+            pass->Render( renderEventArgs );
+            pass->PostRender( renderEventArgs );
+        }
+    }
+}
@@ -26,6 +26,7 @@ std::shared_ptr<RenderPass> RenderTechnique::GetPass( unsigned int ID ) const
 }
 
 // Render the scene using the passes that have been configured.
+// The passes of a plain technique don't declare their resources (see RenderGraph).
 void RenderTechnique::Render( RenderEventArgs& renderEventArgs )
 {
     for ( auto pass : m_Passes )
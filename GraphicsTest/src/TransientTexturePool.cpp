@@ -0,0 +1,143 @@
+#include <GraphicsTestPCH.h>
+
+#include <RenderDevice.h>
+#include <CPUAccess.h>
+
+#include <TransientTexturePool.h>
+
+static bool IsSameFormat( const Texture::TextureFormat& a, const Texture::TextureFormat& b )
+{
+    return a.Components == b.Components &&
+        a.Type == b.Type &&
+        a.NumSamples == b.NumSamples &&
+        a.RedBits == b.RedBits &&
+        a.GreenBits == b.GreenBits &&
+        a.BlueBits == b.BlueBits &&
+        a.AlphaBits == b.AlphaBits &&
+        a.DepthBits == b.DepthBits &&
+        a.StencilBits == b.StencilBits;
+}
+
+TransientTexturePool::TransientTexturePool( RenderDevice& renderDevice, uint16_t width, uint16_t height )
+    : m_RenderDevice( renderDevice )
+    , m_Width( width )
+    , m_Height( height )
+{}
+
+TransientTexturePool::~TransientTexturePool()
+{
+    for ( PooledTexture& pooledTexture : m_Textures )
+    {
+        if ( pooledTexture.pTexture )
+        {
+            m_RenderDevice.DestroyTexture( pooledTexture.pTexture );
+        }
+    }
+}
+
+uint32_t TransientTexturePool::Acquire( const void* owner, const Texture::TextureFormat& format, bool uav, uint32_t firstPass, uint32_t lastPass )
+{
+    assert( firstPass <= lastPass );
+
+    for ( uint32_t i = 0; i < m_Textures.size(); ++i )
+    {
+        PooledTexture& pooledTexture = m_Textures[i];
+
+        // Textures that have already been created can't get unordered access anymore.
+        if ( !IsSameFormat( pooledTexture.Format, format ) || ( uav && !pooledTexture.UAV && pooledTexture.pTexture ) )
+        {
+            continue;
+        }
+
+        bool overlaps = false;
+        for ( const Lifetime& lifetime : pooledTexture.Lifetimes )
+        {
+            if ( lifetime.Owner == owner && firstPass <= lifetime.LastPass && lifetime.FirstPass <= lastPass )
+            {
+                overlaps = true;
+                break;
+            }
+        }
+
+        if ( !overlaps )
+        {
+            pooledTexture.UAV = pooledTexture.UAV || uav;
+            pooledTexture.Lifetimes.push_back( { owner, firstPass, lastPass } );
+            return i;
+        }
+    }
+
+    PooledTexture pooledTexture;
+    pooledTexture.Format = format;
+    pooledTexture.UAV = uav;
+    pooledTexture.Lifetimes.push_back( { owner, firstPass, lastPass } );
+    m_Textures.push_back( pooledTexture );
+
+    return static_cast<uint32_t>( m_Textures.size() ) - 1;
+}
+
+void TransientTexturePool::Release( const void* owner )
+{
+    for ( PooledTexture& pooledTexture : m_Textures )
+    {
+        LifetimeList& lifetimes = pooledTexture.Lifetimes;
+        lifetimes.erase( std::remove_if( lifetimes.begin(), lifetimes.end(), [=]( const Lifetime& lifetime )
+        {
+            return lifetime.Owner == owner;
+        } ), lifetimes.end() );
+    }
+}
+
+std::shared_ptr<Texture> TransientTexturePool::GetTexture( uint32_t index )
+{
+    assert( index < m_Textures.size() );
+
+    PooledTexture& pooledTexture = m_Textures[index];
+    if ( !pooledTexture.pTexture )
+    {
+        pooledTexture.pTexture = m_RenderDevice.CreateTexture2D( m_Width, m_Height, 1, pooledTexture.Format, CPUAccess::None, pooledTexture.UAV );
+    }
+
+    return pooledTexture.pTexture;
+}
+
+void TransientTexturePool::Resize( uint16_t width, uint16_t height )
+{
+    m_Width = width;
+    m_Height = height;
+
+    for ( PooledTexture& pooledTexture : m_Textures )
+    {
+        if ( pooledTexture.pTexture )
+        {
+            pooledTexture.pTexture->Resize( m_Width, m_Height );
+        }
+    }
+}
+
+size_t TransientTexturePool::GetTextureSize( const Texture::TextureFormat& format ) const
+{
+    size_t bitsPerPixel = format.RedBits + format.GreenBits + format.BlueBits + format.AlphaBits + format.DepthBits + format.StencilBits;
+    return (size_t)m_Width * m_Height * glm::max<uint8_t>( format.NumSamples, 1 ) * bitsPerPixel / 8;
+}
+
+size_t TransientTexturePool::GetAllocatedSize() const
+{
+    size_t size = 0;
+    for ( const PooledTexture& pooledTexture : m_Textures )
+    {
+        size += GetTextureSize( pooledTexture.Format );
+    }
+
+    return size;
+}
+
+uint32_t TransientTexturePool::GetNumTextures() const
+{
+    return static_cast<uint32_t>( m_Textures.size() );
+}
+
+RenderDevice& TransientTexturePool::GetRenderDevice() const
+{
+    return m_RenderDevice;
+}
@@ -5,18 +5,18 @@
 
 #include <TransparentPass.h>
 
-TransparentPass::TransparentPass( std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline )
-    : base( scene, pipeline )
-{}
+TransparentPass::TransparentPass( RenderDevice& renderDevice, std::shared_ptr<Scene> scene, std::shared_ptr<PipelineState> pipeline )
+    : base( renderDevice, scene, pipeline )
+{
+    // Transparent meshes must be rendered back-to-front to blend correctly.
+    SetRenderQueue( std::make_shared<RenderQueue>( RenderQueue::SortOrder::BackToFront ) );
+}
 
 TransparentPass::~TransparentPass()
 {}
 
-void TransparentPass::Visit( Mesh& mesh )
+bool TransparentPass::FilterMesh( Mesh& mesh, const glm::mat4& modelViewProjection )
 {
     std::shared_ptr<Material> pMaterial = mesh.GetMaterial();
-    if ( pMaterial && pMaterial->IsTransparent() )
-    {
-        mesh.Render( GetRenderEventArgs() );
-    }
+    return pMaterial && pMaterial->IsTransparent();
 }
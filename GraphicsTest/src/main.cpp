@@ -2,6 +2,7 @@
 #include <Application.h>
 
 #include <RenderDevice.h>
+#include <StateCacheStatistics.h>
 #include <RenderWindow.h>
 #include <ProgressWindow.h>
 #include <PipelineState.h>
@@ -17,12 +18,18 @@
 #include <ConstantBuffer.h>
 #include <StructuredBuffer.h>
 #include <Camera.h>
+#include <Ray.h>
+#include <RaycastHit.h>
 #include <HighResolutionTimer.h>
+#include <JobSystem.h>
+#include <LodSelector.h>
+#include <DrawListBuilder.h>
 #include <Query.h>
 
 #include <ConfigurationSettings.h>
 
-#include <RenderTechnique.h>
+#include <RenderGraph.h>
+#include <TransientTexturePool.h>
 #include <ClearRenderTargetPass.h>
 #include <CopyBufferPass.h>
 #include <CopyTexturePass.h>
@@ -30,14 +37,18 @@
 #include <OpaquePass.h>
 #include <TransparentPass.h>
 #include <LightsPass.h>
-#include <LightPickingPass.h>
 #include <PostprocessPass.h>
 #include <DeferredLightingPass.h>
 #include <BeginQueryPass.h>
 #include <EndQueryPass.h>
 #include <DispatchPass.h>
 #include <InvokeFunctionPass.h>
+#include <OcclusionCuller.h>
+#include <ClusterCuller.h>
 #include <Statistic.h>
+#include <ShaderParameterID.h>
+#include <BindGroup.h>
+#include <ConstantBufferRing.h>
 
 enum class RenderingTechnique
 {
@@ -80,11 +91,15 @@ std::shared_ptr<Scene> g_FullScreenQuad = nullptr;
 
 // Shaders that are used in this demo.
 std::shared_ptr<Shader> g_pVertexShader;
+// Vertex shader that reads the per object data from the instance buffer.
+std::shared_ptr<Shader> g_pInstancedVertexShader;
+// Same as the instanced vertex shader but compiled for the vertex format of the scene
+// (quantized vertices if QuantizeSceneVertices is enabled).
+std::shared_ptr<Shader> g_pSceneVertexShader;
 std::shared_ptr<Shader> g_pPixelShader;
-// Pixel shader for rendering the lights as geometry in the scene.
+// Vertex and pixel shader for rendering the lights as geometry in the scene.
+std::shared_ptr<Shader> g_pLightVertexShader;
 std::shared_ptr<Shader> g_pLightPixelShader;
-// Pixel shader for rendering the picking texture.
-std::shared_ptr<Shader> g_pLightPickingPixelShader;
 // Render materials that should be unlit.
 std::shared_ptr<Shader> g_pUnlitPixelShader;
 // For debugging textures
@@ -119,8 +134,6 @@ std::shared_ptr<PipelineState> g_pTransparentPipeline;
 // Pipeline state for rendering the lights as geometry in the scene.
 std::shared_ptr<PipelineState> g_pLightsPipelineBack;
 std::shared_ptr<PipelineState> g_pLightsPipelineFront;
-// Pipeline state for generating the picking texture for the lights.
-std::shared_ptr<PipelineState> g_pLightPickingPipeline;
 
 // Pipeline for rendering unlit objects.
 std::shared_ptr<PipelineState> g_pUnlitPipeline;
@@ -148,24 +161,21 @@ std::shared_ptr<PipelineState> g_pDepthPrepassPipeline;
 std::shared_ptr<PipelineState> g_pForwardPlusOpaquePipeline;
 std::shared_ptr<PipelineState> g_pForwardPlusTransparentPipeline;
 
-// Staging texture for light picking.
-std::shared_ptr<Texture> g_LightPickingTexture;
-
 // Render target for GBuffer
 std::shared_ptr<RenderTarget> g_pGBufferRenderTarget;
 // A render target that has only a depth target (useful if only the depth/stencil buffer needs to be updated)
 std::shared_ptr<RenderTarget> g_pDepthOnlyRenderTarget;
 // A render target that has only a color target (useful if you don't need to perform depth/stencil testing)
 std::shared_ptr<RenderTarget> g_pColorOnlyRenderTarget;
-// A render target for generating the light picking texture
-std::shared_ptr<RenderTarget> g_pLightPickingRenderTarget;
 
 // A render technique for forward rendering.
-RenderTechnique g_ForwardTechnique;
+RenderGraph g_ForwardTechnique;
 // A render technique for deferred rendering.
-RenderTechnique g_DeferredTechnique;
+RenderGraph g_DeferredTechnique;
 // A render technique for forward plus rendering.
-RenderTechnique g_ForwardPlusTechnique;
+RenderGraph g_ForwardPlusTechnique;
+// The transient textures of the render techniques (G-buffer, light culling debug texture).
+std::shared_ptr<TransientTexturePool> g_pTransientTexturePool;
 
 // Constant buffer to store the number of groups executed in a dispatch.
 __declspec( align( 16 ) ) struct DispatchParams
@@ -217,15 +227,9 @@ const uint32_t AVERAGE_OVERLAPPING_LIGHTS_PER_TILE = 200u;
 std::shared_ptr<Texture> g_pLightGridOpaque;
 std::shared_ptr<Texture> g_pLightGridTransparent;
 
-
-// For debugging of the light culling shader.
-std::shared_ptr<Texture> g_pLightCullingDebugTexture;
 // Heatmap texture for light culling debug.
 std::shared_ptr<Texture> g_pLightCullingHeatMap;
 
-// A render technique for generating the picking texture.
-RenderTechnique g_LightPickingTechnique;
-
 // Timer query for entire frame.
 std::shared_ptr<Query> g_pFrameQuery;
 Statistic g_FrameStatistic;
@@ -266,11 +270,56 @@ Statistic g_ForwardPlusOpaqueStatistic;
 std::shared_ptr<Query> g_pForwardPlusTransparentQuery;
 Statistic g_ForwardPlusTransparentStatistic;
 
+// CPU time (in milliseconds) to pick a light with the mouse.
+Statistic g_LightPickingStatistic;
+
+// CPU time (in milliseconds) to rasterize the occluders for software occlusion culling.
+Statistic g_OcclusionCullingStatistic;
+// The number of meshes that were culled by the software occlusion culler.
+Statistic g_OccludedMeshesStatistic;
+
+// The number of draw calls and state changes (material and mesh buffer bindings)
+// of the scene passes per frame.
+Statistic g_DrawCallsStatistic;
+Statistic g_StateChangesStatistic;
+Statistic g_TrianglesStatistic;
+// The state changes of the last frame that the state cache of the render device
+// issued to the graphics API or skipped because the state was already bound.
+Statistic g_StateChangesIssuedStatistic;
+Statistic g_StateChangesSkippedStatistic;
+// The percentage of the triangles (of the meshes that passed whole mesh culling)
+// that were removed by cluster culling.
+Statistic g_ClusterCulledTrianglesStatistic;
+
+// CPU time (in milliseconds) to build the draw lists of the scene passes.
+Statistic g_DrawListStatistic;
+
+// CPU time (in milliseconds) to assign the per-frame shader parameters.
+Statistic g_ShaderParameterStatistic;
+
 double g_FrameTime = 0.0;
 
 double g_RunningTime = 0.0;
 uint32_t g_FrameCount = 0;
 
+// Measure the time from application startup until the first frame is presented
+// and until all of the scene textures have been streamed in.
+HighResolutionTimer g_FirstFrameTimer;
+HighResolutionTimer g_TexturesLoadedTimer;
+bool g_bFirstFramePresented = false;
+bool g_bStreamingTextures = false;
+// Stream the scene textures in the background (disabled with --no-texture-streaming).
+bool g_bStreamSceneTextures = true;
+
+// Run the constant buffer benchmark instead of the demo (--constant-buffer-benchmark).
+bool g_bConstantBufferBenchmark = false;
+// Run the command list benchmark instead of the demo (--command-list-benchmark).
+bool g_bCommandListBenchmark = false;
+// Run the resource churn benchmark instead of the demo (--resource-churn-benchmark).
+bool g_bResourceChurnBenchmark = false;
+// Run the render queue benchmark instead of the demo (--render-queue-benchmark).
+bool g_bRenderQueueBenchmark = false;
+
 Camera g_Camera;
 
 struct CameraMovement
@@ -309,6 +358,9 @@ Light* g_pCurrentLight = nullptr;
 // The index of the currently selected light in the
 // lights array.
 uint32_t g_uiCurrentLightIndex = 0;
+// The bounding spheres of the light volumes (used for light picking).
+// Cleared when the lights are animated, added, removed or generated and rebuilt by the next pick.
+std::vector<glm::vec4> g_LightBoundingSpheres;
 // If true, the position of the currently 
 // selected light will track the pivot point of the camera.
 bool g_bLightTracksCamera = false;
@@ -324,6 +376,22 @@ unsigned int g_WindowHeight;
 bool g_Animate = false;
 // For forward rendering, whether to render the lights in the scene as geometry or not.
 bool g_RenderLights = false;
+// Set to true to skip rendering of opaque meshes that are hidden behind the occluders in the scene.
+bool g_OcclusionCulling = true;
+// Set to true to sort the draw calls of the scene passes using render queues.
+// If false, meshes are drawn in the order they are visited in the scene graph.
+bool g_SortDrawCalls = true;
+// Set to true to build the draw lists of the scene passes in parallel.
+// If false, each pass traverses the scene on the main thread.
+bool g_ParallelDrawLists = true;
+// The number of threads used to build the draw lists.
+uint32_t g_NumDrawListThreads = 1;
+// Set to true to render distant meshes with simplified levels of detail.
+bool g_MeshLods = true;
+// The maximum error (in pixels) of the selected levels of detail.
+float g_LodErrorThreshold = 1.0f;
+// Set to true to cull the meshlets of the meshes in the scene passes.
+bool g_ClusterCulling = true;
 
 // Set to true when the render targets and textures need to be resized (because the application window was resized)
 bool g_bResizePending = false;
@@ -336,6 +404,18 @@ std::shared_ptr<LightsPass> g_LightsPassBack;
 std::shared_ptr<OpaquePass> g_PivotPointPass;
 // Pass for rendering transparent geometry.
 std::shared_ptr<TransparentPass> g_TransparentPass;
+// Software occlusion culling for the opaque passes.
+std::shared_ptr<OcclusionCuller> g_pOcclusionCuller;
+std::shared_ptr<LodSelector> g_pLodSelector;
+// Cluster culling for the scene passes (one per pass).
+std::vector< std::shared_ptr<ClusterCuller> > g_ClusterCullers;
+// Scene passes that sort their draw calls using a render queue.
+std::vector< std::shared_ptr<BasePass> > g_SortedPasses;
+
+// Build the render queues of the scene passes of each technique in parallel.
+std::shared_ptr<DrawListBuilder> g_pForwardDrawListBuilder;
+std::shared_ptr<DrawListBuilder> g_pDeferredDrawListBuilder;
+std::shared_ptr<DrawListBuilder> g_pForwardPlusDrawListBuilder;
 // Passes for debugging various textures of the g-buffer pass
 std::shared_ptr<PostprocessPass> g_DebugTexture0Pass;
 std::shared_ptr<PostprocessPass> g_DebugTexture1Pass;
@@ -407,10 +487,29 @@ void OnFileChanged( FileChangeEventArgs& e );
 // Set the index of the currently selected light.
 void SetCurrentLight( uint32_t newIndex );
 
+// Cast a ray against the light volumes and return the closest light that was hit.
+bool RaycastLights( const Ray& ray, RaycastHit& hit );
+
 // Resize render targets and textures. Should not be called too often,
 // so resizing is delayed until the beginning of the render function.
 void ResizeBuffers( unsigned int width, unsigned int height );
 
+// Compare the CPU time to upload the per object data of many objects
+// with a single constant buffer and with the constant buffer ring.
+void RunConstantBufferBenchmark( RenderDevice& renderDevice );
+
+// Compare the CPU time to draw a large render queue on the calling thread
+// and to record it into command lists on an increasing number of threads.
+void RunCommandListBenchmark( RenderDevice& renderDevice );
+
+// Measure the CPU time to create and destroy many transient resources
+// and check that the handles of destroyed resources are stale.
+void RunResourceChurnBenchmark( RenderDevice& renderDevice );
+
+// Count the draw calls and state changes of the opaque pass of the scene
+// with and without sorting the render queue.
+void RunRenderQueueBenchmark( RenderDevice& renderDevice );
+
 int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine, int iCmdShow )
 {
     // Make sure our current directory is set to the running application's working directory.
@@ -438,6 +537,26 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
         {
             configFileName = commandLineArguments[++i];
         }
+        else if ( wcscmp( commandLineArguments[i], L"--constant-buffer-benchmark" ) == 0 )
+        {
+            g_bConstantBufferBenchmark = true;
+        }
+        else if ( wcscmp( commandLineArguments[i], L"--command-list-benchmark" ) == 0 )
+        {
+            g_bCommandListBenchmark = true;
+        }
+        else if ( wcscmp( commandLineArguments[i], L"--resource-churn-benchmark" ) == 0 )
+        {
+            g_bResourceChurnBenchmark = true;
+        }
+        else if ( wcscmp( commandLineArguments[i], L"--render-queue-benchmark" ) == 0 )
+        {
+            g_bRenderQueueBenchmark = true;
+        }
+        else if ( wcscmp( commandLineArguments[i], L"--no-texture-streaming" ) == 0 )
+        {
+            g_bStreamSceneTextures = false;
+        }
     }
 
     if ( !g_Config.Load( configFileName ) )
@@ -519,27 +638,43 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     g_Camera.SetViewport( Viewport( 0, 0, g_Config.WindowWidth, g_Config.WindowHeight ) );
     g_Camera.SetProjectionRH( 45.0f, g_Config.WindowWidth / (float)g_Config.WindowHeight, 0.1f, 1000.0f );
     
-    // Load a scene
-    g_pScene = renderDevice.CreateScene();
-
-    fs::path configFilePath( configFileName );
-    fs::path sceneFilePath( g_Config.SceneFileName );
+    if ( g_bConstantBufferBenchmark || g_bCommandListBenchmark || g_bResourceChurnBenchmark )
+    {
+        // The benchmarks measure the CPU cost of the draw calls and resources, not the scene.
+        // Draw a sphere, a cube and a cone (so consecutive draw calls use different meshes) instead of loading the scene file.
+        g_Config.QuantizeSceneVertices = false;
+        g_pScene = renderDevice.CreateSphere( 1.0f );
+        g_pScene->GetRootNode()->AddChild( renderDevice.CreateCube( 1.0f )->GetRootNode() );
+        g_pScene->GetRootNode()->AddChild( renderDevice.CreateCylinder( 0.0f, 1.0f, 1.0f )->GetRootNode() );
+    }
+    else
+    {
+        // Load a scene
+        g_pScene = renderDevice.CreateScene();
 
+        fs::path configFilePath( configFileName );
+        fs::path sceneFilePath( g_Config.SceneFileName );
 
-    // Scene file is described relative to the configuration file.
-    if ( !g_pScene->LoadFromFile( ( configFilePath.parent_path() / sceneFilePath ).wstring() ) )
-    {
-        ReportError( "Unable to load scene file from " + sceneFilePath.string() );
+        // Scene file is described relative to the configuration file.
+        // The textures are streamed in the background so we don't have to wait for all of them before the first frame.
+        // With --no-texture-streaming, all textures are decoded and compressed in parallel before the first frame.
+        if ( !g_pScene->LoadFromFile( ( configFilePath.parent_path() / sceneFilePath ).wstring(), g_bStreamSceneTextures, g_Config.QuantizeSceneVertices ) )
+        {
+            ReportError( "Unable to load scene file from " + sceneFilePath.string() );
+        }
     }
+    g_bStreamingTextures = g_pScene->IsStreaming();
 
     // Scale the scene to fit the view.
     g_pScene->GetRootNode()->SetLocalTransform( glm::scale( glm::vec3( g_Config.SceneScaleFactor ) ) );
 
     // Load some shaders
     g_pVertexShader = renderDevice.CreateShader();
+    g_pInstancedVertexShader = renderDevice.CreateShader();
+    g_pSceneVertexShader = renderDevice.CreateShader();
     g_pPixelShader = renderDevice.CreateShader();
+    g_pLightVertexShader = renderDevice.CreateShader();
     g_pLightPixelShader = renderDevice.CreateShader();
-    g_pLightPickingPixelShader = renderDevice.CreateShader();
     g_pUnlitPixelShader = renderDevice.CreateShader();
     g_pGeometryPixelShader = renderDevice.CreateShader();
     g_pDebugTexturePixelShader = renderDevice.CreateShader();
@@ -551,9 +686,16 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     g_pForwardPlusPixelShader = renderDevice.CreateShader();
     
     g_pVertexShader->LoadShaderFromFile( Shader::VertexShader, L"../Assets/shaders/ForwardRendering.hlsl", Shader::ShaderMacros(), "VS_main", "latest" );
+    g_pInstancedVertexShader->LoadShaderFromFile( Shader::VertexShader, L"../Assets/shaders/ForwardRendering.hlsl", Shader::ShaderMacros(), "VS_instanced", "latest" );
+    Shader::ShaderMacros sceneVertexMacros;
+    if ( g_Config.QuantizeSceneVertices )
+    {
+        sceneVertexMacros["QUANTIZED_VERTICES"] = "1";
+    }
+    g_pSceneVertexShader->LoadShaderFromFile( Shader::VertexShader, L"../Assets/shaders/ForwardRendering.hlsl", sceneVertexMacros, "VS_instanced", "latest" );
     g_pPixelShader->LoadShaderFromFile( Shader::PixelShader, L"../Assets/shaders/ForwardRendering.hlsl", Shader::ShaderMacros(), "PS_main", "latest" );
-    g_pLightPixelShader->LoadShaderFromFile( Shader::PixelShader, L"../Assets/shaders/ForwardRendering.hlsl", Shader::ShaderMacros(), "PS_light", "latest" );
-    g_pLightPickingPixelShader->LoadShaderFromFile( Shader::PixelShader, L"../Assets/shaders/DeferredRendering.hlsl", Shader::ShaderMacros(), "PS_LightPicking", "latest" );
+    g_pLightVertexShader->LoadShaderFromFile( Shader::VertexShader, L"../Assets/shaders/ForwardRendering.hlsl", Shader::ShaderMacros(), "VS_light_instanced", "latest" );
+    g_pLightPixelShader->LoadShaderFromFile( Shader::PixelShader, L"../Assets/shaders/ForwardRendering.hlsl", Shader::ShaderMacros(), "PS_light_instanced", "latest" );
     g_pUnlitPixelShader->LoadShaderFromFile( Shader::PixelShader, L"../Assets/shaders/ForwardRendering.hlsl", Shader::ShaderMacros(), "PS_unlit", "latest" );
     g_pGeometryPixelShader->LoadShaderFromFile( Shader::PixelShader, L"../Assets/shaders/DeferredRendering.hlsl", Shader::ShaderMacros(), "PS_Geometry", "latest" );
     g_pDebugTexturePixelShader->LoadShaderFromFile( Shader::PixelShader, L"../Assets/shaders/DeferredRendering.hlsl", Shader::ShaderMacros(), "PS_DebugTexture", "latest" );
@@ -564,29 +706,6 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     g_pComputeFrustumsComputeShader->LoadShaderFromFile( Shader::ComputeShader, L"../Assets/shaders/ForwardPlusRendering.hlsl", Shader::ShaderMacros(), "CS_ComputeFrustums", "cs_5_0" );
     g_pForwardPlusPixelShader->LoadShaderFromFile( Shader::PixelShader, L"../Assets/shaders/ForwardPlusRendering.hlsl", Shader::ShaderMacros(), "PS_main", "latest" );
 
-    // Create a staging texture for light picking.
-    Texture::TextureFormat lightPickingTextureFormat(
-        Texture::Components::R,
-        Texture::Type::UnsignedInteger,
-        1,
-        16, 0, 0, 0, 0, 0 );
-    g_LightPickingTexture = renderDevice.CreateTexture2D( g_Config.WindowWidth, g_Config.WindowHeight, 1, lightPickingTextureFormat, CPUAccess::Read );
-    // Create a texture for light picking.
-    std::shared_ptr<Texture> lightPickingTexure = renderDevice.CreateTexture2D( g_Config.WindowWidth, g_Config.WindowHeight, 1, lightPickingTextureFormat );
-
-    // Depth/stencil buffer for light picking
-    Texture::TextureFormat lightPickingDepthStencilTextureFormat(
-        Texture::Components::DepthStencil,
-        Texture::Type::UnsignedNormalized,
-        1,
-        0, 0, 0, 0, 24, 8 );
-    std::shared_ptr<Texture> lightPickingDepthStencilTexture = renderDevice.CreateTexture2D( g_Config.WindowWidth, g_Config.WindowHeight, 1, lightPickingDepthStencilTextureFormat );
-
-    // Create a render target for the light picking texture
-    g_pLightPickingRenderTarget = renderDevice.CreateRenderTarget();
-    g_pLightPickingRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color0, lightPickingTexure );
-    g_pLightPickingRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::DepthStencil, lightPickingDepthStencilTexture );
-
     // Number of samples for multi sample textures.
     uint8_t numSamples = 1;
 
@@ -598,7 +717,6 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
         Texture::Type::UnsignedNormalized,
         numSamples,
         0, 0, 0, 0, 24, 8 );
-    std::shared_ptr<Texture> depthStencilTexture = renderDevice.CreateTexture2D( g_Config.WindowWidth, g_Config.WindowHeight, 1, depthStencilTextureFormat );
 
     // Diffuse albedo buffer (Color1) 
     Texture::TextureFormat diffuseTextureFormat(
@@ -606,7 +724,6 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
         Texture::Type::UnsignedNormalized,
         numSamples,
         8, 8, 8, 8, 0, 0 );
-    std::shared_ptr<Texture> diffuseTexture = renderDevice.CreateTexture2D( g_Config.WindowWidth, g_Config.WindowHeight, 1, diffuseTextureFormat );
 
     // Specular buffer (Color2)
     Texture::TextureFormat specularTextureFormat(
@@ -614,7 +731,6 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
         Texture::Type::UnsignedNormalized,
         numSamples,
         8, 8, 8, 8, 0, 0 );
-    std::shared_ptr<Texture> specularTexture = renderDevice.CreateTexture2D( g_Config.WindowWidth, g_Config.WindowHeight, 1, specularTextureFormat );
 
     // Normal buffer (Color3)
     Texture::TextureFormat normalTextureFormat(
@@ -622,16 +738,15 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
         Texture::Type::Float,
         numSamples,
         32, 32, 32, 32, 0, 0 );
-    std::shared_ptr<Texture> normalTexture = renderDevice.CreateTexture2D( g_Config.WindowWidth, g_Config.WindowHeight, 1, normalTextureFormat );
+
+    // The G-buffer textures are transient textures of the deferred technique.
+    // They are attached to the G-buffer render target when the passes of the technique are created.
+    g_pTransientTexturePool = std::make_shared<TransientTexturePool>( renderDevice, g_Config.WindowWidth, g_Config.WindowHeight );
 
     // Create a render target for the geometry pass.
     g_pGBufferRenderTarget = renderDevice.CreateRenderTarget();
     // Use the render window's color attachment point for the "light accumulation" texture (no reason to have an additional buffer for this, that I'm aware of..)
     g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color0, renderWindow.GetRenderTarget()->GetTexture(RenderTarget::AttachmentPoint::Color0) );
-    g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color1, diffuseTexture );
-    g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color2, specularTexture );
-    g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color3, normalTexture );
-    g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::DepthStencil, depthStencilTexture );
 
     // Create a render target with only a depth buffer.
     // This is used for the first (sub) pass of the lighting pass for deferred rendering
@@ -647,7 +762,7 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     // Setup rendering pipelines
     // Pipeline for rendering opaque geometry.
     g_pOpaquePipeline = renderDevice.CreatePipelineState();
-    g_pOpaquePipeline->SetShader( Shader::VertexShader, g_pVertexShader );
+    g_pOpaquePipeline->SetShader( Shader::VertexShader, g_pSceneVertexShader );
     g_pOpaquePipeline->SetShader( Shader::PixelShader, g_pPixelShader );
     g_pOpaquePipeline->SetRenderTarget( renderWindow.GetRenderTarget() );
 
@@ -667,7 +782,7 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
 
     // Pipeline for rendering transparent geometry.
     g_pTransparentPipeline = renderDevice.CreatePipelineState();
-    g_pTransparentPipeline->SetShader( Shader::VertexShader, g_pVertexShader );
+    g_pTransparentPipeline->SetShader( Shader::VertexShader, g_pSceneVertexShader );
     g_pTransparentPipeline->SetShader( Shader::PixelShader, g_pPixelShader );
     g_pTransparentPipeline->GetBlendState().SetBlendMode( alphaBlending );
     g_pTransparentPipeline->GetDepthStencilState().SetDepthMode( disableDepthWrites );
@@ -676,7 +791,7 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
 
     // Pipeline for rendering back faces of light geometry.
     g_pLightsPipelineBack = renderDevice.CreatePipelineState();
-    g_pLightsPipelineBack->SetShader( Shader::VertexShader, g_pVertexShader );
+    g_pLightsPipelineBack->SetShader( Shader::VertexShader, g_pLightVertexShader );
     g_pLightsPipelineBack->SetShader( Shader::PixelShader, g_pLightPixelShader );
     g_pLightsPipelineBack->SetRenderTarget( renderWindow.GetRenderTarget() );
     g_pLightsPipelineBack->GetRasterizerState().SetCullMode( RasterizerState::CullMode::Front );
@@ -685,29 +800,22 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
 
     // Pipeline for rendering front faces of light geometry.
     g_pLightsPipelineFront = renderDevice.CreatePipelineState();
-    g_pLightsPipelineFront->SetShader( Shader::VertexShader, g_pVertexShader );
+    g_pLightsPipelineFront->SetShader( Shader::VertexShader, g_pLightVertexShader );
     g_pLightsPipelineFront->SetShader( Shader::PixelShader, g_pLightPixelShader );
     g_pLightsPipelineFront->SetRenderTarget( renderWindow.GetRenderTarget() );
     g_pLightsPipelineFront->GetRasterizerState().SetCullMode( RasterizerState::CullMode::Back );
     g_pLightsPipelineFront->GetDepthStencilState().SetDepthMode( disableDepthWrites );
     g_pLightsPipelineFront->GetBlendState().SetBlendMode( alphaBlending );
 
-    // Pipeline for rendering picking texture
-    g_pLightPickingPipeline = renderDevice.CreatePipelineState();
-    g_pLightPickingPipeline->SetShader( Shader::VertexShader, g_pVertexShader );
-    g_pLightPickingPipeline->SetShader( Shader::PixelShader, g_pLightPickingPixelShader );
-    g_pLightPickingPipeline->SetRenderTarget( g_pLightPickingRenderTarget );
-    g_pLightPickingPipeline->GetRasterizerState().SetCullMode( RasterizerState::CullMode::None );
-
     // Pipeline for rendering unlit geometry.
     g_pUnlitPipeline = renderDevice.CreatePipelineState();
-    g_pUnlitPipeline->SetShader( Shader::VertexShader, g_pVertexShader );
+    g_pUnlitPipeline->SetShader( Shader::VertexShader, g_pInstancedVertexShader );
     g_pUnlitPipeline->SetShader( Shader::PixelShader, g_pUnlitPixelShader );
     g_pUnlitPipeline->SetRenderTarget( renderWindow.GetRenderTarget() );
 
     // Pipeline for G-buffer pass.
     g_pGeometryPipeline = renderDevice.CreatePipelineState();
-    g_pGeometryPipeline->SetShader( Shader::VertexShader, g_pVertexShader );
+    g_pGeometryPipeline->SetShader( Shader::VertexShader, g_pSceneVertexShader );
     g_pGeometryPipeline->SetShader( Shader::PixelShader, g_pGeometryPixelShader );
     g_pGeometryPipeline->SetRenderTarget( g_pGBufferRenderTarget );
 
@@ -808,7 +916,7 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
 
     // Pipeline for depth pre-pass for forward+ rendering technique.
     g_pDepthPrepassPipeline = renderDevice.CreatePipelineState();
-    g_pDepthPrepassPipeline->SetShader( Shader::VertexShader, g_pVertexShader );
+    g_pDepthPrepassPipeline->SetShader( Shader::VertexShader, g_pSceneVertexShader );
     // no fragment shader necessary.
     g_pDepthPrepassPipeline->SetRenderTarget( g_pDepthOnlyRenderTarget );
 
@@ -816,7 +924,7 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     {
         // Opaque pipeline
         g_pForwardPlusOpaquePipeline = renderDevice.CreatePipelineState();
-        g_pForwardPlusOpaquePipeline->SetShader( Shader::VertexShader, g_pVertexShader );
+        g_pForwardPlusOpaquePipeline->SetShader( Shader::VertexShader, g_pSceneVertexShader );
         g_pForwardPlusOpaquePipeline->SetShader( Shader::PixelShader, g_pForwardPlusPixelShader );
         g_pForwardPlusOpaquePipeline->SetRenderTarget( renderWindow.GetRenderTarget() );
         DepthStencilState::DepthMode depthMode;
@@ -826,7 +934,7 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     {
         // Transparent pipeline.
         g_pForwardPlusTransparentPipeline = renderDevice.CreatePipelineState();
-        g_pForwardPlusTransparentPipeline->SetShader( Shader::VertexShader, g_pVertexShader );
+        g_pForwardPlusTransparentPipeline->SetShader( Shader::VertexShader, g_pSceneVertexShader );
         g_pForwardPlusTransparentPipeline->SetShader( Shader::PixelShader, g_pForwardPlusPixelShader );
         g_pForwardPlusTransparentPipeline->SetRenderTarget( renderWindow.GetRenderTarget() );
         DepthStencilState::DepthMode depthMode( true, DepthStencilState::DepthWrite::Disable );
@@ -849,81 +957,167 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     // Used to represent the pivot point of the camera in the scene.
     g_Axis = renderDevice.CreateAxis( 0.01f, 0.1f );
 
+    // Occluders are rasterized on the CPU at the beginning of each frame.
+    // The opaque passes use the occlusion culler to skip meshes that are hidden behind the occluders.
+    g_pOcclusionCuller = std::make_shared<OcclusionCuller>( g_pScene );
+
+    // The levels of detail are selected once per frame and shared by all scene passes.
+    g_pLodSelector = std::make_shared<LodSelector>( g_LodErrorThreshold );
+
+    // The draw lists of the scene passes are built in parallel before the technique is rendered.
+    // All parallel work (texture import, draw lists and command lists) shares the worker threads of the application.
+    JobSystem& jobSystem = g_Application.GetJobSystem();
+    g_NumDrawListThreads = jobSystem.GetMaxThreads();
+    g_pForwardDrawListBuilder = std::make_shared<DrawListBuilder>( g_pScene, jobSystem );
+    g_pDeferredDrawListBuilder = std::make_shared<DrawListBuilder>( g_pScene, jobSystem );
+    g_pForwardPlusDrawListBuilder = std::make_shared<DrawListBuilder>( g_pScene, jobSystem );
+    g_pForwardDrawListBuilder->SetLodSelector( g_pLodSelector );
+    g_pDeferredDrawListBuilder->SetLodSelector( g_pLodSelector );
+    g_pForwardPlusDrawListBuilder->SetLodSelector( g_pLodSelector );
+
     // Setup forward rendering technique
+    // The color and depth/stencil buffers of the render window are imported into each of the techniques.
+    RenderGraph::ResourceHandle forwardColor = g_ForwardTechnique.ImportResource( "Color" );
+    RenderGraph::ResourceHandle forwardDepthStencil = g_ForwardTechnique.ImportResource( "DepthStencil" );
 
     // Add a pass to render opaque geometry.
-    g_ForwardTechnique.AddPass( std::make_shared<ClearRenderTargetPass>( renderWindow.GetRenderTarget(), ClearFlags::All, g_ClearColor, 1.0f, 0 ) );
+    g_ForwardTechnique.AddPass( "Clear", std::make_shared<ClearRenderTargetPass>( renderWindow.GetRenderTarget(), ClearFlags::All, g_ClearColor, 1.0f, 0 ) )
+        .Write( forwardColor ).Write( forwardDepthStencil );
     g_ForwardTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pForwardOpaqueQuery ) );
-    g_ForwardTechnique.AddPass( std::make_shared<OpaquePass>( g_pScene, g_pOpaquePipeline ) );
+    std::shared_ptr<OpaquePass> forwardOpaquePass = std::make_shared<OpaquePass>( renderDevice, g_pScene, g_pOpaquePipeline );
+    forwardOpaquePass->SetOcclusionCuller( g_pOcclusionCuller );
+    g_ForwardTechnique.AddPass( "Opaque", forwardOpaquePass ).Write( forwardColor ).Write( forwardDepthStencil );
+    g_SortedPasses.push_back( forwardOpaquePass );
+    g_pForwardDrawListBuilder->AddDrawList( forwardOpaquePass );
     g_ForwardTechnique.AddPass( std::make_shared<EndQueryPass>( g_pForwardOpaqueQuery ) );
     // Add a pass to render a 6-point axis in the scene to visualize the camera's pivot point.
-    g_PivotPointPass = std::make_shared<OpaquePass>( g_Axis, g_pUnlitPipeline );
-    g_ForwardTechnique.AddPass( g_PivotPointPass );
+    g_PivotPointPass = std::make_shared<OpaquePass>( renderDevice, g_Axis, g_pUnlitPipeline );
+    g_ForwardTechnique.AddPass( "Pivot Point", g_PivotPointPass ).Write( forwardColor ).Write( forwardDepthStencil );
 
     // Add a pass for rendering transparent geometry
     g_ForwardTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pForwardTransparentQuery ) );
-    g_TransparentPass = std::make_shared<TransparentPass>( g_pScene, g_pTransparentPipeline );
-    g_ForwardTechnique.AddPass( g_TransparentPass ); 
+    g_TransparentPass = std::make_shared<TransparentPass>( renderDevice, g_pScene, g_pTransparentPipeline );
+    g_ForwardTechnique.AddPass( "Transparent", g_TransparentPass ).Write( forwardColor ).Read( forwardDepthStencil );
+    g_SortedPasses.push_back( g_TransparentPass );
+    g_pForwardDrawListBuilder->AddDrawList( g_TransparentPass );
     g_ForwardTechnique.AddPass( std::make_shared<EndQueryPass>( g_pForwardTransparentQuery ) );
 
     // Add a pass to render the lights in the scene as opaque geometry. Can be toggled with 'l' key.
-    g_LightsPassFront = std::make_shared<LightsPass>( g_Config.Lights, g_Sphere, g_Cone, g_Arrow, g_pLightsPipelineFront );
-    g_LightsPassBack = std::make_shared<LightsPass>( g_Config.Lights, g_Sphere, g_Cone, g_Arrow, g_pLightsPipelineBack );
-    g_ForwardTechnique.AddPass( g_LightsPassBack );
-    g_ForwardTechnique.AddPass( g_LightsPassFront );
+    g_LightsPassFront = std::make_shared<LightsPass>( renderDevice, g_Config.Lights, g_Sphere, g_Cone, g_Arrow, g_pLightsPipelineFront );
+    g_LightsPassBack = std::make_shared<LightsPass>( renderDevice, g_Config.Lights, g_Sphere, g_Cone, g_Arrow, g_pLightsPipelineBack );
+    g_ForwardTechnique.AddPass( "Lights Back", g_LightsPassBack ).Write( forwardColor ).Write( forwardDepthStencil );
+    g_ForwardTechnique.AddPass( "Lights Front", g_LightsPassFront ).Write( forwardColor ).Write( forwardDepthStencil );
 
     // Setup deferred rendering technique.
-    g_DeferredTechnique.AddPass( std::make_shared<ClearRenderTargetPass>( g_pGBufferRenderTarget, ClearFlags::All, g_ClearColor, 1.0f, 0 ) );
+    std::shared_ptr<Texture> depthStencilBuffer = renderWindow.GetRenderTarget()->GetTexture( RenderTarget::AttachmentPoint::DepthStencil );
+
+    RenderGraph::ResourceHandle deferredColor = g_DeferredTechnique.ImportResource( "Color" );
+    RenderGraph::ResourceHandle deferredDepthStencil = g_DeferredTechnique.ImportResource( "DepthStencil" );
+    RenderGraph::ResourceHandle diffuseTexture = g_DeferredTechnique.CreateTexture( "Diffuse", diffuseTextureFormat );
+    RenderGraph::ResourceHandle specularTexture = g_DeferredTechnique.CreateTexture( "Specular", specularTextureFormat );
+    RenderGraph::ResourceHandle normalTexture = g_DeferredTechnique.CreateTexture( "Normal", normalTextureFormat );
+    RenderGraph::ResourceHandle depthStencilTexture = g_DeferredTechnique.CreateTexture( "G-Buffer DepthStencil", depthStencilTextureFormat );
+
+    g_DeferredTechnique.AddPass( "Clear G-Buffer", [=]()
+    {
+        g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color1, g_DeferredTechnique.GetTexture( diffuseTexture ) );
+        g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color2, g_DeferredTechnique.GetTexture( specularTexture ) );
+        g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::Color3, g_DeferredTechnique.GetTexture( normalTexture ) );
+        g_pGBufferRenderTarget->AttachTexture( RenderTarget::AttachmentPoint::DepthStencil, g_DeferredTechnique.GetTexture( depthStencilTexture ) );
+
+        return std::make_shared<ClearRenderTargetPass>( g_pGBufferRenderTarget, ClearFlags::All, g_ClearColor, 1.0f, 0 );
+    }
+    ).Write( deferredColor ).Write( diffuseTexture ).Write( specularTexture ).Write( normalTexture ).Write( depthStencilTexture );
     g_DeferredTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pDeferredGeometryQuery ) );
-    g_DeferredTechnique.AddPass( std::make_shared<OpaquePass>( g_pScene, g_pGeometryPipeline ) );
+    std::shared_ptr<OpaquePass> deferredGeometryPass = std::make_shared<OpaquePass>( renderDevice, g_pScene, g_pGeometryPipeline );
+    deferredGeometryPass->SetOcclusionCuller( g_pOcclusionCuller );
+    g_DeferredTechnique.AddPass( "Geometry", deferredGeometryPass )
+        .Write( deferredColor ).Write( diffuseTexture ).Write( specularTexture ).Write( normalTexture ).Write( depthStencilTexture );
+    g_SortedPasses.push_back( deferredGeometryPass );
+    g_pDeferredDrawListBuilder->AddDrawList( deferredGeometryPass );
 //    g_DeferredTechnique.AddPass( std::make_shared<GenerateMipMapPass>( g_pGBufferRenderTarget ) );
     g_DeferredTechnique.AddPass( std::make_shared<EndQueryPass>( g_pDeferredGeometryQuery ) );
 
-    std::shared_ptr<Texture> depthStencilBuffer = renderWindow.GetRenderTarget()->GetTexture( RenderTarget::AttachmentPoint::DepthStencil );
-    g_DeferredTechnique.AddPass( std::make_shared<CopyTexturePass>( depthStencilBuffer, depthStencilTexture ) );
+    g_DeferredTechnique.AddPass( "Copy DepthStencil", [=]()
+    {
+        return std::make_shared<CopyTexturePass>( depthStencilBuffer, g_DeferredTechnique.GetTexture( depthStencilTexture ) );
+    }
+    ).Read( depthStencilTexture ).Write( deferredDepthStencil );
     g_DeferredTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pDeferredLightingQuery ) );
-    g_DeferredTechnique.AddPass( std::make_shared<DeferredLightingPass>( g_Config.Lights, g_Sphere, g_Cone, g_pDeferredLightingPipeline1, g_pDeferredLightingPipeline2, g_pDirectionalLightsPipeline, diffuseTexture, specularTexture, normalTexture, depthStencilTexture ) );
+    g_DeferredTechnique.AddPass( "Lighting", [=, &renderDevice]()
+    {
+        return std::make_shared<DeferredLightingPass>( renderDevice, g_Config.Lights, g_Sphere, g_Cone, g_pDeferredLightingPipeline1, g_pDeferredLightingPipeline2, g_pDirectionalLightsPipeline,
+                                                       g_DeferredTechnique.GetTexture( diffuseTexture ), g_DeferredTechnique.GetTexture( specularTexture ),
+                                                       g_DeferredTechnique.GetTexture( normalTexture ), g_DeferredTechnique.GetTexture( depthStencilTexture ) );
+    }
+    ).Read( diffuseTexture ).Read( specularTexture ).Read( normalTexture ).Read( depthStencilTexture ).Write( deferredColor ).Write( deferredDepthStencil );
     g_DeferredTechnique.AddPass( std::make_shared<EndQueryPass>( g_pDeferredLightingQuery ) );
 
-    g_DeferredTechnique.AddPass( g_PivotPointPass );
+    g_DeferredTechnique.AddPass( "Pivot Point", g_PivotPointPass ).Write( deferredColor ).Write( deferredDepthStencil );
     g_DeferredTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pDeferredTransparentQuery ) );
-    g_DeferredTechnique.AddPass( g_TransparentPass );
+    g_DeferredTechnique.AddPass( "Transparent", g_TransparentPass ).Write( deferredColor ).Read( deferredDepthStencil );
     g_DeferredTechnique.AddPass( std::make_shared<EndQueryPass>( g_pDeferredTransparentQuery ) );
 
-    g_DeferredTechnique.AddPass( g_LightsPassBack );
-    g_DeferredTechnique.AddPass( g_LightsPassFront );
+    g_DeferredTechnique.AddPass( "Lights Back", g_LightsPassBack ).Write( deferredColor ).Write( deferredDepthStencil );
+    g_DeferredTechnique.AddPass( "Lights Front", g_LightsPassFront ).Write( deferredColor ).Write( deferredDepthStencil );
 
     // Add passes for rendering G buffer textures to the screen
     // Orthographic projection matrix for a 1920x1080 screen resolution (Full HD).
     glm::mat4 orthographicProjection = glm::ortho<float>( 0, 1920, 1080, 0 );
 
     std::shared_ptr<Scene> debugTextureScene = renderDevice.CreateScreenQuad( 20, 475, 1060, 815 );
-    g_DebugTexture0Pass = std::make_shared<PostprocessPass>( debugTextureScene, g_pDebugTexturePipeline, orthographicProjection, diffuseTexture );
-    g_DebugTexture0Pass->SetEnabled( false ); // Initially disabled. Enabled with the F1 key.
-    g_DeferredTechnique.AddPass( g_DebugTexture0Pass );
+    g_DeferredTechnique.AddPass( "Debug Diffuse", [=, &renderDevice]()
+    {
+        g_DebugTexture0Pass = std::make_shared<PostprocessPass>( renderDevice, debugTextureScene, g_pDebugTexturePipeline, orthographicProjection, g_DeferredTechnique.GetTexture( diffuseTexture ) );
+        g_DebugTexture0Pass->SetEnabled( false ); // Initially disabled. Enabled with the F1 key.
+        return g_DebugTexture0Pass;
+    }
+    ).Read( diffuseTexture ).Write( deferredColor );
 
     debugTextureScene = renderDevice.CreateScreenQuad( 495, 950, 1060, 815 );
-    g_DebugTexture1Pass = std::make_shared<PostprocessPass>( debugTextureScene, g_pDebugTexturePipeline, orthographicProjection, specularTexture );
-    g_DebugTexture1Pass->SetEnabled( false ); // Initial disabled. Enabled with the F2 key.
-    g_DeferredTechnique.AddPass( g_DebugTexture1Pass );
+    g_DeferredTechnique.AddPass( "Debug Specular", [=, &renderDevice]()
+    {
+        g_DebugTexture1Pass = std::make_shared<PostprocessPass>( renderDevice, debugTextureScene, g_pDebugTexturePipeline, orthographicProjection, g_DeferredTechnique.GetTexture( specularTexture ) );
+        g_DebugTexture1Pass->SetEnabled( false ); // Initial disabled. Enabled with the F2 key.
+        return g_DebugTexture1Pass;
+    }
+    ).Read( specularTexture ).Write( deferredColor );
 
     debugTextureScene = renderDevice.CreateScreenQuad( 970, 1425, 1060, 815 );
-    g_DebugTexture2Pass = std::make_shared<PostprocessPass>( debugTextureScene, g_pDebugTexturePipeline, orthographicProjection, normalTexture );
-    g_DebugTexture2Pass->SetEnabled( false ); // Initially disabled. Enabled with the F3 key.
-    g_DeferredTechnique.AddPass( g_DebugTexture2Pass );
+    g_DeferredTechnique.AddPass( "Debug Normal", [=, &renderDevice]()
+    {
+        g_DebugTexture2Pass = std::make_shared<PostprocessPass>( renderDevice, debugTextureScene, g_pDebugTexturePipeline, orthographicProjection, g_DeferredTechnique.GetTexture( normalTexture ) );
+        g_DebugTexture2Pass->SetEnabled( false ); // Initially disabled. Enabled with the F3 key.
+        return g_DebugTexture2Pass;
+    }
+    ).Read( normalTexture ).Write( deferredColor );
 
     debugTextureScene = renderDevice.CreateScreenQuad( 1445, 1900, 1060, 815 );
-    g_DebugTexture3Pass = std::make_shared<PostprocessPass>( debugTextureScene, g_pDebugDepthTexturePipeline, orthographicProjection, depthStencilTexture );
-    g_DebugTexture3Pass->SetEnabled( false ); // Initially disabled. Enabled with the F4 key.
-    g_DeferredTechnique.AddPass( g_DebugTexture3Pass );
+    g_DeferredTechnique.AddPass( "Debug Depth", [=, &renderDevice]()
+    {
+        g_DebugTexture3Pass = std::make_shared<PostprocessPass>( renderDevice, debugTextureScene, g_pDebugDepthTexturePipeline, orthographicProjection, g_DeferredTechnique.GetTexture( depthStencilTexture ) );
+        g_DebugTexture3Pass->SetEnabled( false ); // Initially disabled. Enabled with the F4 key.
+        return g_DebugTexture3Pass;
+    }
+    ).Read( depthStencilTexture ).Write( deferredColor );
 
     // Setup Forward+ rendering technique.
+    RenderGraph::ResourceHandle forwardPlusColor = g_ForwardPlusTechnique.ImportResource( "Color" );
+    RenderGraph::ResourceHandle forwardPlusDepthStencil = g_ForwardPlusTechnique.ImportResource( "DepthStencil" );
+    RenderGraph::ResourceHandle lightIndexCounters = g_ForwardPlusTechnique.ImportResource( "LightIndexCounters" );
+    // The light index lists and the light grids.
+    RenderGraph::ResourceHandle lightLists = g_ForwardPlusTechnique.ImportResource( "LightLists" );
 
     // Clear the render target.
-    g_ForwardPlusTechnique.AddPass( std::make_shared<ClearRenderTargetPass>( renderWindow.GetRenderTarget(), ClearFlags::All, g_ClearColor, 1.0f, 0 ) );
+    g_ForwardPlusTechnique.AddPass( "Clear", std::make_shared<ClearRenderTargetPass>( renderWindow.GetRenderTarget(), ClearFlags::All, g_ClearColor, 1.0f, 0 ) )
+        .Write( forwardPlusColor ).Write( forwardPlusDepthStencil );
     // Depth pre-pass.
     g_ForwardPlusTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pForwardPlusDepthPrepassQuery ) );
-    g_ForwardPlusTechnique.AddPass( std::make_shared<OpaquePass>( g_pScene, g_pDepthPrepassPipeline ) );
+    std::shared_ptr<OpaquePass> forwardPlusDepthPrepass = std::make_shared<OpaquePass>( renderDevice, g_pScene, g_pDepthPrepassPipeline );
+    forwardPlusDepthPrepass->SetOcclusionCuller( g_pOcclusionCuller );
+    g_ForwardPlusTechnique.AddPass( "Depth Prepass", forwardPlusDepthPrepass ).Write( forwardPlusDepthStencil );
+    g_SortedPasses.push_back( forwardPlusDepthPrepass );
+    g_pForwardPlusDrawListBuilder->AddDrawList( forwardPlusDepthPrepass );
     g_ForwardPlusTechnique.AddPass( std::make_shared<EndQueryPass>( g_pForwardPlusDepthPrepassQuery ) );
 
     g_pLightCullingComputeShader->GetShaderParameterByName( "DepthTextureVS" ).Set( depthStencilBuffer );
@@ -931,8 +1125,8 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
                                                            Texture::Type::Float,
                                                            1,
                                                            32, 32, 32, 32, 0, 0 );
-    g_pLightCullingDebugTexture = renderDevice.CreateTexture2D( g_Config.WindowWidth, g_Config.WindowHeight, 1, lightCullingDebugTextureFormat, CPUAccess::None, true );
-    g_pLightCullingComputeShader->GetShaderParameterByName( "DebugTexture" ).Set( g_pLightCullingDebugTexture );
+    // For debugging of the light culling shader.
+    RenderGraph::ResourceHandle lightCullingDebugTexture = g_ForwardPlusTechnique.CreateTexture( "Light Culling Debug", lightCullingDebugTextureFormat, true );
     g_pLightCullingHeatMap = renderDevice.CreateTexture( L"../Assets/textures/LightCountHeatMap.psd" );
     g_pLightCullingComputeShader->GetShaderParameterByName( "LightCountHeatMap" ).Set( g_pLightCullingHeatMap );
     
@@ -956,11 +1150,19 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
 
     // Reset the light list index counters back to 0.
     g_ForwardPlusTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pForwardPlusLightCullingQuery ) );
-    g_ForwardPlusTechnique.AddPass( std::make_shared<CopyBufferPass>( g_pLightListIndexCounterOpaque, lightListIndexCounterInitialBuffer ) );
-    g_ForwardPlusTechnique.AddPass( std::make_shared<CopyBufferPass>( g_pLightListIndexCounterTransparent, lightListIndexCounterInitialBuffer ) );
+    g_ForwardPlusTechnique.AddPass( "Reset Opaque Light Index Counter", std::make_shared<CopyBufferPass>( g_pLightListIndexCounterOpaque, lightListIndexCounterInitialBuffer ) )
+        .Write( lightIndexCounters );
+    g_ForwardPlusTechnique.AddPass( "Reset Transparent Light Index Counter", std::make_shared<CopyBufferPass>( g_pLightListIndexCounterTransparent, lightListIndexCounterInitialBuffer ) )
+        .Write( lightIndexCounters );
 
-    g_LightCullingDispatchPass = std::make_shared<DispatchPass>( g_pLightCullingComputeShader, glm::ceil( glm::vec3( g_WindowWidth / (float)g_LightCullingBlockSize, g_WindowHeight / (float)g_LightCullingBlockSize, 1 ) ) );
-    g_ForwardPlusTechnique.AddPass( g_LightCullingDispatchPass );
+    g_ForwardPlusTechnique.AddPass( "Light Culling", [=]()
+    {
+        g_pLightCullingComputeShader->GetShaderParameterByName( "DebugTexture" ).Set( g_ForwardPlusTechnique.GetTexture( lightCullingDebugTexture ) );
+
+        g_LightCullingDispatchPass = std::make_shared<DispatchPass>( g_pLightCullingComputeShader, glm::ceil( glm::vec3( g_WindowWidth / (float)g_LightCullingBlockSize, g_WindowHeight / (float)g_LightCullingBlockSize, 1 ) ) );
+        return g_LightCullingDispatchPass;
+    }
+    ).Read( forwardPlusDepthStencil ).Write( lightIndexCounters ).Write( lightLists ).Write( lightCullingDebugTexture );
     g_ForwardPlusTechnique.AddPass( std::make_shared<EndQueryPass>( g_pForwardPlusLightCullingQuery ) );
 
     // Forward+ opaque pass.
@@ -972,9 +1174,14 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     }
     ) );
     g_ForwardPlusTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pForwardPlusOpaqueQuery ) );
-    g_ForwardPlusTechnique.AddPass( std::make_shared<OpaquePass>( g_pScene, g_pForwardPlusOpaquePipeline ) );
+    std::shared_ptr<OpaquePass> forwardPlusOpaquePass = std::make_shared<OpaquePass>( renderDevice, g_pScene, g_pForwardPlusOpaquePipeline );
+    // The meshes were already tested (and counted) by the depth prepass.
+    forwardPlusOpaquePass->SetOcclusionCuller( g_pOcclusionCuller, false );
+    g_ForwardPlusTechnique.AddPass( "Opaque", forwardPlusOpaquePass ).Read( lightLists ).Write( forwardPlusColor ).Write( forwardPlusDepthStencil );
+    g_SortedPasses.push_back( forwardPlusOpaquePass );
+    g_pForwardPlusDrawListBuilder->AddDrawList( forwardPlusOpaquePass );
     g_ForwardPlusTechnique.AddPass( std::make_shared<EndQueryPass>( g_pForwardPlusOpaqueQuery ) );
-    g_ForwardPlusTechnique.AddPass( g_PivotPointPass );
+    g_ForwardPlusTechnique.AddPass( "Pivot Point", g_PivotPointPass ).Write( forwardPlusColor ).Write( forwardPlusDepthStencil );
 
     // Forward+ transparent pass.
     g_ForwardPlusTechnique.AddPass( std::make_shared<InvokeFunctionPass>( [=] ()
@@ -985,27 +1192,49 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     }
     ) );
     g_ForwardPlusTechnique.AddPass( std::make_shared<BeginQueryPass>( g_pForwardPlusTransparentQuery ) );
-    g_ForwardPlusTechnique.AddPass( std::make_shared<TransparentPass>( g_pScene, g_pForwardPlusTransparentPipeline ) );
+    std::shared_ptr<TransparentPass> forwardPlusTransparentPass = std::make_shared<TransparentPass>( renderDevice, g_pScene, g_pForwardPlusTransparentPipeline );
+    g_ForwardPlusTechnique.AddPass( "Transparent", forwardPlusTransparentPass ).Read( lightLists ).Write( forwardPlusColor ).Read( forwardPlusDepthStencil );
+    g_SortedPasses.push_back( forwardPlusTransparentPass );
+    g_pForwardPlusDrawListBuilder->AddDrawList( forwardPlusTransparentPass );
     g_ForwardPlusTechnique.AddPass( std::make_shared<EndQueryPass>( g_pForwardPlusTransparentQuery ) );
 
-    g_ForwardPlusTechnique.AddPass( g_LightsPassBack );
-    g_ForwardPlusTechnique.AddPass( g_LightsPassFront );
+    g_ForwardPlusTechnique.AddPass( "Lights Back", g_LightsPassBack ).Write( forwardPlusColor ).Write( forwardPlusDepthStencil );
+    g_ForwardPlusTechnique.AddPass( "Lights Front", g_LightsPassFront ).Write( forwardPlusColor ).Write( forwardPlusDepthStencil );
 
     // Show the depth buffer after light culling compute shader (for debugging)
     debugTextureScene = renderDevice.CreateScreenQuad( 0, 1920, 1080, 0 );
-    g_ForwardPlusDebugPass = std::make_shared<PostprocessPass>( debugTextureScene, g_pDebugTextureWithBlendingPipeline, orthographicProjection, g_pLightCullingDebugTexture );
-    g_ForwardPlusDebugPass->SetEnabled( false );
-    g_ForwardPlusTechnique.AddPass( g_ForwardPlusDebugPass );
-
-    // Setup light picking technique
-    g_LightPickingTechnique.AddPass( std::make_shared<ClearRenderTargetPass>( lightPickingTexure, ClearFlags::Color, glm::vec4( 0 ) ) );
-    // Copy the depth/stencil values from the render window depth/stencil buffer to the light picking depth stencil buffer.
-    // I don't want to be able to pick lights through geometry, but I also need to update the depth buffer so that I will always pick the
-    // closest light.  In order to avoid writing to the default depth buffer for light picking, just copy the texture.
-    g_LightPickingTechnique.AddPass( std::make_shared<CopyTexturePass>( lightPickingDepthStencilTexture, renderWindow.GetRenderTarget()->GetTexture( RenderTarget::AttachmentPoint::DepthStencil ) ) );
-    g_LightPickingTechnique.AddPass( std::make_shared<LightPickingPass>( g_Config.Lights, g_Sphere, g_Cone, g_Arrow, g_pLightPickingPipeline ) );
-    // Now copy the resulting texture to the light picking staging texture so it can be read on the CPU.
-    g_LightPickingTechnique.AddPass( std::make_shared<CopyTexturePass>( g_LightPickingTexture, lightPickingTexure ) );
+    g_ForwardPlusTechnique.AddPass( "Debug Light Culling", [=, &renderDevice]()
+    {
+        g_ForwardPlusDebugPass = std::make_shared<PostprocessPass>( renderDevice, debugTextureScene, g_pDebugTextureWithBlendingPipeline, orthographicProjection, g_ForwardPlusTechnique.GetTexture( lightCullingDebugTexture ) );
+        g_ForwardPlusDebugPass->SetEnabled( false );
+        return g_ForwardPlusDebugPass;
+    }
+    ).Read( lightCullingDebugTexture ).Write( forwardPlusColor );
+
+    // Compile all of the techniques before the passes are created so the transient
+    // textures can be shared between the techniques (only one technique is rendered per frame).
+    g_ForwardTechnique.Compile( *g_pTransientTexturePool );
+    g_DeferredTechnique.Compile( *g_pTransientTexturePool );
+    g_ForwardPlusTechnique.Compile( *g_pTransientTexturePool );
+    g_ForwardTechnique.CreatePasses();
+    g_DeferredTechnique.CreatePasses();
+    g_ForwardPlusTechnique.CreatePasses();
+
+    g_ForwardTechnique.Report( "Forward" );
+    g_DeferredTechnique.Report( "Deferred" );
+    g_ForwardPlusTechnique.Report( "Forward+" );
+
+    for ( auto pass : g_SortedPasses )
+    {
+        pass->SetLodSelector( g_pLodSelector );
+        // Large render queues are recorded into command lists on the worker threads.
+        pass->SetJobSystem( &jobSystem );
+
+        // Each pass builds its own compacted index buffer from its render queue.
+        std::shared_ptr<ClusterCuller> clusterCuller = std::make_shared<ClusterCuller>( renderDevice );
+        pass->SetClusterCuller( clusterCuller );
+        g_ClusterCullers.push_back( clusterCuller );
+    }
 
     // Create samplers
     g_LinearRepeatSampler = renderDevice.CreateSamplerState();
@@ -1024,6 +1253,34 @@ int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR szCmdLine
     g_pCurrentLight = &g_Config.Lights[0];
     g_pCurrentLight->m_Selected = true;
 
+    if ( g_bConstantBufferBenchmark )
+    {
+        RunConstantBufferBenchmark( renderDevice );
+        loadingWindow.CloseWindow();
+        return 0;
+    }
+
+    if ( g_bCommandListBenchmark )
+    {
+        RunCommandListBenchmark( renderDevice );
+        loadingWindow.CloseWindow();
+        return 0;
+    }
+
+    if ( g_bResourceChurnBenchmark )
+    {
+        RunResourceChurnBenchmark( renderDevice );
+        loadingWindow.CloseWindow();
+        return 0;
+    }
+
+    if ( g_bRenderQueueBenchmark )
+    {
+        RunRenderQueueBenchmark( renderDevice );
+        loadingWindow.CloseWindow();
+        return 0;
+    }
+
     // Register callbacks
     g_Application.FileChanged += &OnFileChanged;
     renderWindow.Update += &OnUpdate;
@@ -1145,6 +1402,47 @@ void SetCurrentLight( uint32_t newIndex )
     }
 }
 
+bool RaycastLights( const Ray& ray, RaycastHit& hit )
+{
+    // The lights were animated, added, removed or generated since the last pick.
+    if ( g_LightBoundingSpheres.empty() )
+    {
+        g_LightBoundingSpheres.resize( g_Config.Lights.size() );
+        for ( size_t i = 0; i < g_Config.Lights.size(); ++i )
+        {
+            g_LightBoundingSpheres[i] = g_Config.Lights[i].GetBoundingSphere();
+        }
+    }
+    // The current light may have been edited or moved with the camera since the last pick.
+    if ( g_pCurrentLight )
+    {
+        g_LightBoundingSpheres[g_uiCurrentLightIndex] = g_pCurrentLight->GetBoundingSphere();
+    }
+
+    // Test against the same volumes that are used to render the lights (see LightsPass).
+    if ( !ray.IntersectLights( g_Config.Lights.data(), g_LightBoundingSpheres.data(), (uint32_t)g_Config.Lights.size(), hit ) )
+    {
+        return false;
+    }
+
+    // Lights behind the scene geometry can't be picked. The point where the ray enters the closest light volume
+    // is tested against the occluders of the scene (the depth buffer of the occlusion culler was rasterized from
+    // the camera of the frame that was clicked on). If the scene is closer, the scene is hit instead of the light.
+    if ( g_pOcclusionCuller )
+    {
+        if ( !g_OcclusionCulling )
+        {
+            g_pOcclusionCuller->Rasterize( g_Camera );
+        }
+        if ( g_pOcclusionCuller->IsPointOccluded( hit.Point ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void SelectNextLight()
 {
     g_bLightTracksCamera = false;
@@ -1183,12 +1481,30 @@ void ResetStatistics()
     g_ForwardPlusLightCullingStatistic.Reset();
     g_ForwardPlusOpaqueStatistic.Reset();
     g_ForwardPlusTransparentStatistic.Reset();
+
+    g_LightPickingStatistic.Reset();
+
+    g_OcclusionCullingStatistic.Reset();
+    g_OccludedMeshesStatistic.Reset();
+
+    g_DrawCallsStatistic.Reset();
+    g_StateChangesStatistic.Reset();
+    g_TrianglesStatistic.Reset();
+    g_StateChangesIssuedStatistic.Reset();
+    g_StateChangesSkippedStatistic.Reset();
+    g_ClusterCulledTrianglesStatistic.Reset();
+
+    g_DrawListStatistic.Reset();
+    g_ShaderParameterStatistic.Reset();
 }
 
 void UpdateNumLights()
 {
     size_t numLights = g_Config.Lights.size();
 
+    // The bounding spheres of the lights are rebuilt by the next pick.
+    g_LightBoundingSpheres.clear();
+
     RenderDevice& renderDevice = g_Application.GetRenderDevice();
 
     // Destroy the old constant buffer
@@ -1471,6 +1787,7 @@ void OnUpdate( UpdateEventArgs& e )
             light.m_PositionWS = rot * light.m_PositionWS;
             light.m_DirectionWS = rot * light.m_DirectionWS;
         }
+        g_LightBoundingSpheres.clear();
     }
 
     // Move the currently selected light with the camera.
@@ -1482,6 +1799,18 @@ void OnUpdate( UpdateEventArgs& e )
     }
 
     UpdateLights();
+
+    // Assign the textures that have been loaded in the background.
+    g_pScene->UpdateStreaming( g_Camera );
+    if ( g_bStreamingTextures && !g_pScene->IsStreaming() )
+    {
+        g_TexturesLoadedTimer.Tick();
+        g_bStreamingTextures = false;
+
+        std::stringstream ss;
+        ss << "All scene textures loaded after " << g_TexturesLoadedTimer.ElapsedMilliSeconds() << " ms" << std::endl;
+        OutputDebugStringA( ss.str().c_str() );
+    }
 }
 
 void OnPreRender( RenderEventArgs& e )
@@ -1494,30 +1823,45 @@ void OnPreRender( RenderEventArgs& e )
 
     g_pFrameQuery->Begin( e.FrameCounter );
 
-    // Bind the lights constant buffer to the constant buffer slot in the pixel/compute shaders.
-    g_pPixelShader->GetShaderParameterByName( "Lights" ).Set( g_pLightsStructuredBuffer );
-    g_pDeferredLightingPixelShader->GetShaderParameterByName( "Lights" ).Set( g_pLightsStructuredBuffer );
-    g_pForwardPlusPixelShader->GetShaderParameterByName( "Lights" ).Set( g_pLightsStructuredBuffer );
-    g_pLightCullingComputeShader->GetShaderParameterByName( "Lights" ).Set( g_pLightsStructuredBuffer );
-    g_pLightCullingComputeShader->GetShaderParameterByName( "ScreenToViewParams" ).Set( g_pScreenToViewParamsConstantBuffer );
+    HighResolutionTimer timer;
+
+    // The per-frame parameters are grouped so each shader gets all of them with a single call.
+    static const ShaderParameterID gs_LightsID( "Lights" );
+    static const ShaderParameterID gs_ScreenToViewParamsID( "ScreenToViewParams" );
+    static const ShaderParameterID gs_LinearRepeatSamplerID( "LinearRepeatSampler" );
+    static const ShaderParameterID gs_LinearClampSamplerID( "LinearClampSampler" );
+
+    static BindGroup gs_SamplersBindGroup;
+    static BindGroup gs_LightsBindGroup;
+    static BindGroup gs_LightCullingBindGroup;
+
+    // The resources may have been recreated (for example when the number of lights changes).
+    gs_SamplersBindGroup.Set( gs_LinearRepeatSamplerID, g_LinearRepeatSampler );
+    gs_SamplersBindGroup.Set( gs_LinearClampSamplerID, g_LinearClampSampler );
+
+    gs_LightsBindGroup.Set( gs_LightsID, g_pLightsStructuredBuffer );
+
+    gs_LightCullingBindGroup.Set( gs_LightsID, g_pLightsStructuredBuffer );
+    gs_LightCullingBindGroup.Set( gs_ScreenToViewParamsID, g_pScreenToViewParamsConstantBuffer );
+
+    // Bind the lights structured buffer to the pixel/compute shaders.
+    gs_LightsBindGroup.Apply( *g_pPixelShader );
+    gs_LightsBindGroup.Apply( *g_pDeferredLightingPixelShader );
+    gs_LightsBindGroup.Apply( *g_pForwardPlusPixelShader );
+    gs_LightCullingBindGroup.Apply( *g_pLightCullingComputeShader );
 
     // Bind sampler states to shaders.
-    g_pPixelShader->GetShaderParameterByName( "LinearRepeatSampler" ).Set( g_LinearRepeatSampler );
-    g_pPixelShader->GetShaderParameterByName( "LinearClampSampler" ).Set( g_LinearClampSampler );
-    g_pUnlitPixelShader->GetShaderParameterByName( "LinearRepeatSampler" ).Set( g_LinearRepeatSampler );
-    g_pUnlitPixelShader->GetShaderParameterByName( "LinearClampSampler" ).Set( g_LinearClampSampler );
-    g_pGeometryPixelShader->GetShaderParameterByName( "LinearRepeatSampler" ).Set( g_LinearRepeatSampler );
-    g_pGeometryPixelShader->GetShaderParameterByName( "LinearClampSampler" ).Set( g_LinearClampSampler );
-    g_pDebugTexturePixelShader->GetShaderParameterByName( "LinearRepeatSampler" ).Set( g_LinearRepeatSampler );
-    g_pDebugTexturePixelShader->GetShaderParameterByName( "LinearClampSampler" ).Set( g_LinearClampSampler );
-    g_pDebugDepthTexturePixelShader->GetShaderParameterByName( "LinearRepeatSampler" ).Set( g_LinearRepeatSampler );
-    g_pDebugDepthTexturePixelShader->GetShaderParameterByName( "LinearClampSampler" ).Set( g_LinearClampSampler );
-    g_pDeferredLightingPixelShader->GetShaderParameterByName( "LinearRepeatSampler" ).Set( g_LinearRepeatSampler );
-    g_pDeferredLightingPixelShader->GetShaderParameterByName( "LinearClampSampler" ).Set( g_LinearClampSampler );
-    g_pLightCullingComputeShader->GetShaderParameterByName( "LinearRepeatSampler" ).Set( g_LinearRepeatSampler );
-    g_pLightCullingComputeShader->GetShaderParameterByName( "LinearClampSampler" ).Set( g_LinearClampSampler );
-    g_pForwardPlusPixelShader->GetShaderParameterByName( "LinearRepeatSampler" ).Set( g_LinearRepeatSampler );
-    g_pForwardPlusPixelShader->GetShaderParameterByName( "LinearClampSampler" ).Set( g_LinearClampSampler );
+    gs_SamplersBindGroup.Apply( *g_pPixelShader );
+    gs_SamplersBindGroup.Apply( *g_pUnlitPixelShader );
+    gs_SamplersBindGroup.Apply( *g_pGeometryPixelShader );
+    gs_SamplersBindGroup.Apply( *g_pDebugTexturePixelShader );
+    gs_SamplersBindGroup.Apply( *g_pDebugDepthTexturePixelShader );
+    gs_SamplersBindGroup.Apply( *g_pDeferredLightingPixelShader );
+    gs_SamplersBindGroup.Apply( *g_pLightCullingComputeShader );
+    gs_SamplersBindGroup.Apply( *g_pForwardPlusPixelShader );
+
+    timer.Tick();
+    g_ShaderParameterStatistic.Sample( timer.ElapsedMilliSeconds() );
 }
 
 void OnRender( RenderEventArgs& e )
@@ -1532,6 +1876,55 @@ void OnRender( RenderEventArgs& e )
     g_PivotPointPass->SetEnabled( g_Camera.GetPivotDistance() > 0.0f );
     g_LightsPassFront->SetEnabled( g_RenderLights );
     g_LightsPassBack->SetEnabled( g_RenderLights );
+    g_pOcclusionCuller->SetEnabled( g_OcclusionCulling );
+    g_pLodSelector->SetEnabled( g_MeshLods );
+    g_pLodSelector->SetErrorThreshold( g_LodErrorThreshold );
+    g_pLodSelector->Update( g_Camera );
+    for ( auto clusterCuller : g_ClusterCullers )
+    {
+        clusterCuller->SetEnabled( g_ClusterCulling );
+    }
+
+    for ( auto pass : g_SortedPasses )
+    {
+        pass->GetRenderQueue()->SetSortingEnabled( g_SortDrawCalls );
+        pass->ResetRenderStatistics();
+        pass->SetRenderQueueBuilt( false );
+    }
+
+    // Rasterize the occluders before any of the opaque passes are rendered.
+    if ( g_OcclusionCulling )
+    {
+        HighResolutionTimer timer;
+        g_pOcclusionCuller->Update( g_Camera );
+        timer.Tick();
+        g_OcclusionCullingStatistic.Sample( timer.ElapsedMilliSeconds() );
+    }
+
+    // Build the draw lists of the scene passes (after the occluders have been rasterized).
+    if ( g_ParallelDrawLists )
+    {
+        std::shared_ptr<DrawListBuilder> drawListBuilder;
+        switch ( g_RenderingTechnique )
+        {
+        case RenderingTechnique::Forward:
+            drawListBuilder = g_pForwardDrawListBuilder;
+            break;
+        case RenderingTechnique::Deferred:
+            drawListBuilder = g_pDeferredDrawListBuilder;
+            break;
+        case RenderingTechnique::ForwardPlus:
+            drawListBuilder = g_pForwardPlusDrawListBuilder;
+            break;
+        }
+
+        g_Application.GetJobSystem().SetNumThreads( g_NumDrawListThreads );
+
+        HighResolutionTimer timer;
+        drawListBuilder->Build( g_Camera );
+        timer.Tick();
+        g_DrawListStatistic.Sample( timer.ElapsedMilliSeconds() );
+    }
 
     switch ( g_RenderingTechnique )
     {
@@ -1545,12 +1938,45 @@ void OnRender( RenderEventArgs& e )
         g_ForwardPlusTechnique.Render( e );
         break;
     }
-    
 
-    // Generate light picking texture
-    // This is only done when the mouse is clicked.
-    // @see: OnMouseButtonReleased
-    //g_LightPickingTechnique.Render( e );
+    if ( g_OcclusionCulling )
+    {
+        g_OccludedMeshesStatistic.Sample( g_pOcclusionCuller->GetNumMeshesCulled() );
+    }
+
+    uint32_t numDrawCalls = 0;
+    uint32_t numStateChanges = 0;
+    uint32_t numTriangles = 0;
+    for ( auto pass : g_SortedPasses )
+    {
+        numDrawCalls += pass->GetNumDrawCalls();
+        numStateChanges += pass->GetNumStateChanges();
+        numTriangles += pass->GetNumTriangles();
+    }
+    g_DrawCallsStatistic.Sample( numDrawCalls );
+    g_StateChangesStatistic.Sample( numStateChanges );
+    g_TrianglesStatistic.Sample( numTriangles );
+
+    if ( const StateCacheStatistics* pStateCacheStatistics = g_Application.GetRenderDevice().GetStateCacheStatistics() )
+    {
+        g_StateChangesIssuedStatistic.Sample( (double)pStateCacheStatistics->GetNumIssued() );
+        g_StateChangesSkippedStatistic.Sample( (double)pStateCacheStatistics->GetNumSkipped() );
+    }
+
+    if ( g_ClusterCulling )
+    {
+        uint32_t numTrianglesTested = 0;
+        uint32_t numTrianglesVisible = 0;
+        for ( auto clusterCuller : g_ClusterCullers )
+        {
+            numTrianglesTested += clusterCuller->GetNumTrianglesTested();
+            numTrianglesVisible += clusterCuller->GetNumTrianglesVisible();
+        }
+        if ( numTrianglesTested > 0 )
+        {
+            g_ClusterCulledTrianglesStatistic.Sample( 100.0 * ( numTrianglesTested - numTrianglesVisible ) / numTrianglesTested );
+        }
+    }
 }
 
 void OnPostRender( RenderEventArgs& e )
@@ -1561,6 +1987,16 @@ void OnPostRender( RenderEventArgs& e )
     RenderWindow& renderWindow = dynamic_cast<RenderWindow&>( const_cast<Object&>( e.Caller ) );
     renderWindow.Present();
 
+    if ( !g_bFirstFramePresented )
+    {
+        g_FirstFrameTimer.Tick();
+        g_bFirstFramePresented = true;
+
+        std::stringstream ss;
+        ss << "Time to first frame: " << g_FirstFrameTimer.ElapsedMilliSeconds() << " ms" << std::endl;
+        OutputDebugStringA( ss.str().c_str() );
+    }
+
     // Retrieve GPU timer results.
     // Don't retrieve the immediate query result, but from the previous frame.
     // Checking previous frame counters will alleviate GPU stalls.
@@ -1641,6 +2077,270 @@ void OnPostRender( RenderEventArgs& e )
 
 }
 
+// The number of draw calls that are recorded per frame by the constant buffer and command list benchmarks.
+#define BENCHMARK_NUM_DRAWS 100000
+#define BENCHMARK_NUM_FRAMES 10
+
+// Collects the meshes of a scene.
+class MeshCollector : public Visitor
+{
+public:
+    virtual void Visit( Scene& scene ) {}
+    virtual void Visit( SceneNode& node ) {}
+    virtual void Visit( Mesh& mesh )
+    {
+        Meshes.push_back( &mesh );
+    }
+
+    std::vector<Mesh*> Meshes;
+};
+
+// Create an opaque pass that draws the meshes of the scene in turn (without sorting)
+// so that every render item is a separate draw call.
+std::shared_ptr<OpaquePass> CreateBenchmarkPass( RenderDevice& renderDevice, const std::vector<Mesh*>& meshes )
+{
+    std::shared_ptr<OpaquePass> pass = std::make_shared<OpaquePass>( renderDevice, g_pScene, g_pOpaquePipeline );
+    std::shared_ptr<RenderQueue> renderQueue = pass->GetRenderQueue();
+    renderQueue->SetSortingEnabled( false );
+    renderQueue->Reserve( BENCHMARK_NUM_DRAWS );
+    for ( uint32_t i = 0; i < BENCHMARK_NUM_DRAWS; ++i )
+    {
+        glm::mat4 modelView = g_Camera.GetViewMatrix() * glm::translate( glm::vec3( (float)( i % 100 ), 0.0f, (float)( i / 100 ) ) );
+        renderQueue->Push( g_pOpaquePipeline.get(), *meshes[i % meshes.size()], g_Camera.GetProjectionMatrix() * modelView, modelView );
+    }
+    renderQueue->Sort();
+
+    return pass;
+}
+
+void RunConstantBufferBenchmark( RenderDevice& renderDevice )
+{
+    MeshCollector meshCollector;
+    g_pScene->Accept( meshCollector );
+    if ( meshCollector.Meshes.empty() )
+    {
+        OutputDebugStringA( "Constant buffer benchmark: the scene doesn't contain any meshes.\n" );
+        return;
+    }
+
+    // The per object data of the scene pipeline (the instanced vertex shader) is updated for every draw call.
+    std::shared_ptr<OpaquePass> pass = CreateBenchmarkPass( renderDevice, meshCollector.Meshes );
+    ConstantBufferRing* pConstantBufferRing = renderDevice.GetConstantBufferRing();
+
+    std::stringstream ss;
+    ss << "Constant buffer benchmark (" << BENCHMARK_NUM_DRAWS << " draws, " << BENCHMARK_NUM_FRAMES << " frames, " << renderDevice.GetDeviceName() << "):" << std::endl;
+
+    for ( int useRing = 0; useRing < 2; ++useRing )
+    {
+        if ( useRing && !pConstantBufferRing )
+        {
+            ss << "Constant buffer ring: not supported by " << renderDevice.GetDeviceName() << std::endl;
+            break;
+        }
+
+        // Without the ring, the per object constant buffer is mapped with WRITE_DISCARD for every draw call.
+        pass->SetConstantBufferRing( useRing ? pConstantBufferRing : nullptr );
+
+        HighResolutionTimer timer;
+        for ( uint32_t frame = 0; frame < BENCHMARK_NUM_FRAMES; ++frame )
+        {
+            RenderEventArgs renderEventArgs( *pass, 0.0f, 0.0f, frame, &g_Camera );
+            pass->ResetRenderStatistics();
+            pass->SetRenderQueueBuilt( true );
+            pass->PreRender( renderEventArgs );
+            pass->Render( renderEventArgs );
+            pass->PostRender( renderEventArgs );
+            if ( pConstantBufferRing )
+            {
+                pConstantBufferRing->EndFrame();
+            }
+        }
+        timer.Tick();
+
+        ss << ( useRing ? "Constant buffer ring: " : "Constant buffer: " ) << timer.ElapsedMilliSeconds() / BENCHMARK_NUM_FRAMES << " ms per frame, "
+            << pass->GetNumDrawCalls() << " draw calls" << std::endl;
+    }
+
+    OutputDebugStringA( ss.str().c_str() );
+}
+
+void RunCommandListBenchmark( RenderDevice& renderDevice )
+{
+    MeshCollector meshCollector;
+    g_pScene->Accept( meshCollector );
+    if ( meshCollector.Meshes.empty() )
+    {
+        OutputDebugStringA( "Command list benchmark: the scene doesn't contain any meshes.\n" );
+        return;
+    }
+
+    std::shared_ptr<OpaquePass> pass = CreateBenchmarkPass( renderDevice, meshCollector.Meshes );
+
+    std::stringstream ss;
+    ss << "Command list benchmark (" << BENCHMARK_NUM_DRAWS << " draws, " << BENCHMARK_NUM_FRAMES << " frames, " << renderDevice.GetDeviceName() << "):" << std::endl;
+
+    JobSystem& jobSystem = g_Application.GetJobSystem();
+    uint32_t numThreads = jobSystem.GetNumThreads();
+    uint32_t serialDrawCalls = 0;
+    uint32_t serialTriangles = 0;
+
+    // A single thread draws on the calling thread.
+    for ( uint32_t threads = 1; threads <= jobSystem.GetMaxThreads(); ++threads )
+    {
+        jobSystem.SetNumThreads( threads );
+        pass->SetJobSystem( threads > 1 ? &jobSystem : nullptr );
+
+        HighResolutionTimer timer;
+        for ( uint32_t frame = 0; frame < BENCHMARK_NUM_FRAMES; ++frame )
+        {
+            RenderEventArgs renderEventArgs( *pass, 0.0f, 0.0f, frame, &g_Camera );
+            pass->ResetRenderStatistics();
+            pass->SetRenderQueueBuilt( true );
+            pass->PreRender( renderEventArgs );
+            pass->Render( renderEventArgs );
+            pass->PostRender( renderEventArgs );
+        }
+        timer.Tick();
+
+        if ( threads == 1 )
+        {
+            serialDrawCalls = pass->GetNumDrawCalls();
+            serialTriangles = pass->GetNumTriangles();
+        }
+
+        ss << threads << " thread(s), " << pass->GetNumCommandLists() << " command list(s): "
+            << timer.ElapsedMilliSeconds() / BENCHMARK_NUM_FRAMES << " ms per frame, "
+            << pass->GetNumDrawCalls() << " draw calls, " << pass->GetNumTriangles() << " triangles";
+        // The command lists must draw exactly the same batches as the calling thread.
+        if ( pass->GetNumDrawCalls() != serialDrawCalls || pass->GetNumTriangles() != serialTriangles )
+        {
+            ss << " (MISMATCH)";
+        }
+        ss << std::endl;
+    }
+
+    jobSystem.SetNumThreads( numThreads );
+
+    OutputDebugStringA( ss.str().c_str() );
+}
+
+// The number of transient resources that are created and destroyed by the resource churn benchmark.
+#define BENCHMARK_NUM_RESOURCES 100000
+
+void RunResourceChurnBenchmark( RenderDevice& renderDevice )
+{
+    std::vector< std::shared_ptr<ConstantBuffer> > buffers( BENCHMARK_NUM_RESOURCES );
+    std::vector<ResourceHandle> handles( BENCHMARK_NUM_RESOURCES );
+
+    std::stringstream ss;
+    ss << "Resource churn benchmark (" << BENCHMARK_NUM_RESOURCES << " constant buffers, " << renderDevice.GetDeviceName() << "):" << std::endl;
+
+    HighResolutionTimer createTimer;
+    for ( uint32_t i = 0; i < BENCHMARK_NUM_RESOURCES; ++i )
+    {
+        buffers[i] = renderDevice.CreateConstantBuffer( glm::vec4( (float)i ) );
+        handles[i] = renderDevice.GetBufferHandle( buffers[i] );
+    }
+    createTimer.Tick();
+
+    // Destroy the buffers in random order (half of them with their handle).
+    std::vector<uint32_t> order( BENCHMARK_NUM_RESOURCES );
+    for ( uint32_t i = 0; i < BENCHMARK_NUM_RESOURCES; ++i )
+    {
+        order[i] = i;
+    }
+    std::shuffle( order.begin(), order.end(), std::mt19937( 0 ) );
+
+    HighResolutionTimer destroyTimer;
+    for ( uint32_t i : order )
+    {
+        if ( i % 2 == 0 )
+        {
+            renderDevice.DestroyConstantBuffer( buffers[i] );
+        }
+        else
+        {
+            renderDevice.DestroyBuffer( handles[i] );
+        }
+        buffers[i].reset();
+    }
+    destroyTimer.Tick();
+
+    // The new buffers reuse the slots of the destroyed buffers but the old handles must stay stale.
+    HighResolutionTimer recreateTimer;
+    for ( uint32_t i = 0; i < BENCHMARK_NUM_RESOURCES; ++i )
+    {
+        buffers[i] = renderDevice.CreateConstantBuffer( glm::vec4( (float)i ) );
+    }
+    recreateTimer.Tick();
+
+    uint32_t numStaleHandles = 0;
+    for ( const ResourceHandle& handle : handles )
+    {
+        if ( !renderDevice.GetBuffer( handle ) )
+        {
+            ++numStaleHandles;
+        }
+    }
+
+    for ( std::shared_ptr<ConstantBuffer>& buffer : buffers )
+    {
+        renderDevice.DestroyConstantBuffer( buffer );
+    }
+
+    ss << "Create: " << createTimer.ElapsedMilliSeconds() << " ms" << std::endl;
+    ss << "Destroy (random order): " << destroyTimer.ElapsedMilliSeconds() << " ms" << std::endl;
+    ss << "Create (reused slots): " << recreateTimer.ElapsedMilliSeconds() << " ms" << std::endl;
+    ss << "Stale handles: " << numStaleHandles << " of " << BENCHMARK_NUM_RESOURCES;
+    if ( numStaleHandles != BENCHMARK_NUM_RESOURCES )
+    {
+        ss << " (MISMATCH)";
+    }
+    ss << std::endl;
+
+    OutputDebugStringA( ss.str().c_str() );
+}
+
+void RunRenderQueueBenchmark( RenderDevice& renderDevice )
+{
+    // The opaque pass of the scene (from the camera position in the configuration).
+    // Without a render queue, the pass submits every mesh as soon as it is visited
+    // (the buffers and the material are bound for every draw call). This is the baseline.
+    std::shared_ptr<OpaquePass> baselinePass = std::make_shared<OpaquePass>( renderDevice, g_pScene, g_pOpaquePipeline );
+    baselinePass->SetRenderQueue( nullptr );
+    std::shared_ptr<OpaquePass> pass = std::make_shared<OpaquePass>( renderDevice, g_pScene, g_pOpaquePipeline );
+
+    const char* names[] = { "No render queue: ", "Scene graph order: ", "Sorted: " };
+    std::shared_ptr<OpaquePass> passes[] = { baselinePass, pass, pass };
+
+    std::stringstream ss;
+    ss << "Render queue benchmark (" << renderDevice.GetDeviceName() << "):" << std::endl;
+
+    for ( size_t i = 0; i < _countof( passes ); ++i )
+    {
+        // Without sorting, the queued meshes are drawn in the order of the scene graph.
+        if ( passes[i]->GetRenderQueue() )
+        {
+            passes[i]->GetRenderQueue()->SetSortingEnabled( i == 2 );
+        }
+
+        RenderEventArgs renderEventArgs( *passes[i], 0.0f, 0.0f, 0, &g_Camera );
+        passes[i]->ResetRenderStatistics();
+
+        HighResolutionTimer timer;
+        passes[i]->PreRender( renderEventArgs );
+        passes[i]->Render( renderEventArgs );
+        passes[i]->PostRender( renderEventArgs );
+        timer.Tick();
+
+        ss << names[i] << passes[i]->GetNumDrawCalls() << " draw calls, "
+            << passes[i]->GetNumStateChanges() << " state changes, "
+            << timer.ElapsedMilliSeconds() << " ms (CPU)" << std::endl;
+    }
+
+    OutputDebugStringA( ss.str().c_str() );
+}
+
 void ResizeBuffers( unsigned int width, unsigned int height )
 {
     g_Camera.SetProjectionRH( 45.0f, width / (float)height, 0.1f, 1000.0f );
@@ -1661,7 +2361,6 @@ void ResizeBuffers( unsigned int width, unsigned int height )
     // Update all the pipeline states with the new viewport dimensions.
     g_pLightsPipelineFront->GetRasterizerState().SetViewport( viewport );
     g_pLightsPipelineBack->GetRasterizerState().SetViewport( viewport );
-    g_pLightPickingPipeline->GetRasterizerState().SetViewport( viewport );
     g_pOpaquePipeline->GetRasterizerState().SetViewport( viewport );
     g_pTransparentPipeline->GetRasterizerState().SetViewport( viewport );
     g_pUnlitPipeline->GetRasterizerState().SetViewport( viewport );
@@ -1680,10 +2379,8 @@ void ResizeBuffers( unsigned int width, unsigned int height )
     g_pGBufferRenderTarget->Resize( width, height);
     g_pDepthOnlyRenderTarget->Resize( width, height );
     g_pColorOnlyRenderTarget->Resize( width, height );
-    g_pLightPickingRenderTarget->Resize( width, height);
-    g_LightPickingTexture->Resize( width, height );
 
-    g_pLightCullingDebugTexture->Resize( width, height );
+    g_pTransientTexturePool->Resize( width, height );
 
     // Update the thread group block size based on the new screen resolution.
     SetThreadGroupBlockSize( g_LightCullingBlockSize );
@@ -1975,18 +2672,19 @@ void OnMouseButtonReleased( MouseButtonEventArgs& e )
     // If the mouse moved less than 3 pixels
     if ( offset < 3.0f )
     {
-        RenderEventArgs renderEventArgs( e.Caller, 0, 0, 0, &g_Camera, g_pLightPickingPipeline.get() );
-        g_LightPickingTechnique.Render( renderEventArgs );
+        HighResolutionTimer timer;
+
+        // Cast a ray from the camera through the mouse cursor and find the closest light volume.
+        Ray ray = g_Camera.ScreenPointToRay( currentMousePosition );
+        RaycastHit hit;
+        bool lightHit = RaycastLights( ray, hit );
 
-        // Now read the light index under the mouse cursor.
-        uint16_t index = g_LightPickingTexture->FetchPixel<uint16_t>( currentMousePosition );
+        timer.Tick();
+        g_LightPickingStatistic.Sample( timer.ElapsedMilliSeconds() );
 
-        if ( index > 0 )
+        if ( lightHit )
         {
-            // The index stored in the picking texture is 1-based index.
-            // So before we select the light, we need to convert it to the 0-based index 
-            // expected by this function..
-            SetCurrentLight( index - 1 );
+            SetCurrentLight( hit.Index );
         }
     }
 }
@@ -2391,6 +3089,24 @@ void CreateAntTweakBar()
     TwAddVarCB( g_pRenderingTechniqueTweakBar, "Forward Plus Light Culling", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_ForwardPlusLightCullingStatistic, "group='Forward Plus' label='Light Culling'" );
     TwAddVarCB( g_pRenderingTechniqueTweakBar, "Forward Plus Opaque Pass", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_ForwardPlusOpaqueStatistic, "group='Forward Plus' label='Opaque Pass'" );
     TwAddVarCB( g_pRenderingTechniqueTweakBar, "Forward Plus Transparent Pass", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_ForwardPlusTransparentStatistic, "group='Forward Plus' label='Transparent Pass'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "Light Picking", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_LightPickingStatistic, "group='CPU' label='Light Picking' help='Average CPU time in milliseconds to pick a light with the mouse.'" );
+    TwAddVarRW( g_pRenderingTechniqueTweakBar, "OcclusionCulling", TW_TYPE_BOOLCPP, &g_OcclusionCulling, "group='CPU' label='Occlusion Culling' help='Enable software occlusion culling of opaque meshes.'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "Occlusion Culling Time", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_OcclusionCullingStatistic, "group='CPU' label='Occluder Rasterization' help='Average CPU time in milliseconds to rasterize the occluders.'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "Occluded Meshes", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_OccludedMeshesStatistic, "group='CPU' label='Occluded Meshes' help='Average number of meshes culled by the occlusion culler per frame.'" );
+    TwAddVarRW( g_pRenderingTechniqueTweakBar, "SortDrawCalls", TW_TYPE_BOOLCPP, &g_SortDrawCalls, "group='CPU' label='Sort Draw Calls' help='Sort the draw calls of the scene passes to minimize state changes.'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "Draw Calls", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_DrawCallsStatistic, "group='CPU' label='Draw Calls' help='Average number of draw calls of the scene passes per frame.'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "State Changes", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_StateChangesStatistic, "group='CPU' label='State Changes' help='Average number of material and mesh buffer bindings of the scene passes per frame.'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "State Changes Issued", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_StateChangesIssuedStatistic, "group='CPU' label='State Changes Issued' help='Average number of state changes per frame that the state cache of the render device issued to the graphics API (all passes).'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "State Changes Skipped", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_StateChangesSkippedStatistic, "group='CPU' label='State Changes Skipped' help='Average number of redundant state changes per frame that the state cache of the render device skipped (all passes).'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "Triangles", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_TrianglesStatistic, "group='CPU' label='Triangles' help='Average number of triangles drawn by the scene passes per frame.'" );
+    TwAddVarRW( g_pRenderingTechniqueTweakBar, "ClusterCulling", TW_TYPE_BOOLCPP, &g_ClusterCulling, "group='CPU' label='Cluster Culling' help='Cull the meshlets of the meshes against the view frustum and their normal cones.'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "Cluster Culled Triangles", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_ClusterCulledTrianglesStatistic, "group='CPU' label='Cluster Culled Triangles (%)' help='Average percentage of the triangles of the visible meshes that were removed by cluster culling.'" );
+    TwAddVarRW( g_pRenderingTechniqueTweakBar, "MeshLods", TW_TYPE_BOOLCPP, &g_MeshLods, "group='CPU' label='Mesh LODs' help='Render distant meshes with simplified levels of detail.'" );
+    TwAddVarRW( g_pRenderingTechniqueTweakBar, "LodErrorThreshold", TW_TYPE_FLOAT, &g_LodErrorThreshold, "group='CPU' label='LOD Error Threshold' min=0.1 max=16 step=0.1 help='Maximum screen space error of the selected level of detail in pixels.'" );
+    TwAddVarRW( g_pRenderingTechniqueTweakBar, "ParallelDrawLists", TW_TYPE_BOOLCPP, &g_ParallelDrawLists, "group='CPU' label='Parallel Draw Lists' help='Build the draw lists of the scene passes on multiple threads.'" );
+    TwAddVarRW( g_pRenderingTechniqueTweakBar, "DrawListThreads", TW_TYPE_UINT32, &g_NumDrawListThreads, "group='CPU' label='Draw List Threads' min=1 max=64 help='Number of threads used by the parallel loops of the application, including the draw lists (limited to the number of hardware threads).'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "Draw List Time", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_DrawListStatistic, "group='CPU' label='Draw List Build' help='Average CPU time in milliseconds to build the draw lists.'" );
+    TwAddVarCB( g_pRenderingTechniqueTweakBar, "Shader Parameter Time", TW_TYPE_DOUBLE, nullptr, &GetAverageStatistic, &g_ShaderParameterStatistic, "group='CPU' label='Shader Parameters' help='Average CPU time in milliseconds to assign the per-frame shader parameters.'" );
     TwAddButton( g_pRenderingTechniqueTweakBar, "Reset Statistics", &ResetStatisticsCB, nullptr, "label='Reset Statistics' help='Reset statistics to 0'" );
 
     // Generate lights tweak bar.